@@ -34,6 +34,19 @@ H5_HLDLL herr_t H5DOwrite_chunk(hid_t dset_id,
          		size_t data_size, 
 			const void *buf);
 
+/*-------------------------------------------------------------------------
+ *
+ * Direct chunk read function
+ *
+ *-------------------------------------------------------------------------
+ */
+
+H5_HLDLL herr_t H5DOread_chunk(hid_t dset_id,
+			hid_t dxpl_id,
+			const hsize_t *offset,
+			uint32_t *filters,
+			void *buf);
+
 #ifdef __cplusplus
 }
 #endif
@@ -35,6 +35,8 @@
 #define DATASETNAME4        "data_conv"
 #define DATASETNAME5        "contiguous_dset"
 #define DATASETNAME6        "invalid_argue"
+#define DATASETNAME7        "direct_read"
+#define DATASETNAME8        "direct_read_copy"
 #define RANK         2
 #define NX     16
 #define NY     16
@@ -1090,6 +1092,208 @@ error:
     return 1;
 }
 
+/*-------------------------------------------------------------------------
+ * Function:	test_direct_chunk_read
+ *
+ * Purpose:	Test the basic functionality of H5DOread_chunk, with
+ *              H5Dget_chunk_storage_size and H5Dget_chunk_info_by_coord,
+ *              by copying a filtered dataset chunk by chunk without
+ *              running the filters
+ *
+ * Return:	Success:	0
+ *
+ *		Failure:	1
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+test_direct_chunk_read(hid_t file)
+{
+    hid_t       dataspace = -1, dataset = -1, dataset2 = -1;
+    hid_t       cparms = -1, dxpl = -1;
+    hsize_t     dims[2]  = {NX, NY};
+    hsize_t     chunk_dims[2] ={CHUNK_NX, CHUNK_NY};
+    int         data[NX][NY];
+    int         check_data[NX][NY];
+    int         i, j, n;
+
+    uint32_t    filter_mask;
+    unsigned    info_filter_mask;
+    haddr_t     addr;
+    hsize_t     chunk_nbytes, size;
+    int         direct_buf[CHUNK_NX][CHUNK_NY];
+    hsize_t     offset[2] = {0, 0};
+    size_t      buf_size = CHUNK_NX*CHUNK_NY*sizeof(int);
+
+    TESTING("basic functionality of H5DOread_chunk");
+
+    if((dataspace = H5Screate_simple(RANK, dims, NULL)) < 0)
+        goto error;
+
+    /*
+     * Modify dataset creation properties, i.e. enable chunking and the
+     * first bogus filter
+     */
+    if((cparms = H5Pcreate(H5P_DATASET_CREATE)) < 0)
+        goto error;
+
+    if(H5Pset_chunk(cparms, RANK, chunk_dims) < 0)
+        goto error;
+
+    if(H5Zregister(H5Z_BOGUS1) < 0)
+	goto error;
+
+    if(H5Pset_filter(cparms, H5Z_FILTER_BOGUS1, 0, (size_t)0, NULL) < 0)
+	goto error;
+
+    if((dataset = H5Dcreate2(file, DATASETNAME7, H5T_NATIVE_INT, dataspace, H5P_DEFAULT,
+			cparms, H5P_DEFAULT)) < 0)
+        goto error;
+    if((dataset2 = H5Dcreate2(file, DATASETNAME8, H5T_NATIVE_INT, dataspace, H5P_DEFAULT,
+			cparms, H5P_DEFAULT)) < 0)
+        goto error;
+
+    if((dxpl = H5Pcreate(H5P_DATASET_XFER)) < 0)
+        goto error;
+
+    /* No chunk has been written yet */
+    if(H5Dget_chunk_storage_size(dataset, offset, &chunk_nbytes) < 0)
+        goto error;
+    if(chunk_nbytes != 0)
+        goto error;
+    if(H5Dget_chunk_info_by_coord(dataset, offset, &info_filter_mask, &addr, &size) < 0)
+        goto error;
+    if(addr != HADDR_UNDEF || size != 0)
+        goto error;
+    H5E_BEGIN_TRY {
+        if(H5DOread_chunk(dataset, dxpl, offset, &filter_mask, direct_buf) != FAIL)
+            goto error;
+    } H5E_END_TRY;
+
+    /* Write the data for the dataset.  It stays in the chunk cache, and is
+     * flushed when the chunks are read directly. */
+    for(i = n = 0; i < NX; i++)
+        for(j = 0; j < NY; j++)
+	    data[i][j] = n++;
+
+    if(H5Dwrite(dataset, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, dxpl, data) < 0)
+        goto error;
+
+    /* Copy the chunks to the second dataset as they are stored, and check
+     * they went through the filter */
+    for(offset[0] = 0; offset[0] < NX; offset[0] += CHUNK_NX)
+        for(offset[1] = 0; offset[1] < NY; offset[1] += CHUNK_NY) {
+            if(H5Dget_chunk_storage_size(dataset, offset, &chunk_nbytes) < 0)
+                goto error;
+            if(chunk_nbytes != buf_size)
+                goto error;
+            if(H5Dget_chunk_info_by_coord(dataset, offset, &info_filter_mask, &addr, &size) < 0)
+                goto error;
+            if(info_filter_mask != 0 || addr == HADDR_UNDEF || size != buf_size)
+                goto error;
+
+            filter_mask = 1;
+            if(H5DOread_chunk(dataset, dxpl, offset, &filter_mask, direct_buf) < 0)
+                goto error;
+            if(filter_mask != 0)
+                goto error;
+            for(i = 0; i < CHUNK_NX; i++)
+                for(j = 0; j < CHUNK_NY; j++)
+                    if(direct_buf[i][j] != data[offset[0] + (hsize_t)i][offset[1] + (hsize_t)j] + ADD_ON) {
+                        printf("    1. Read different values than stored.");
+                        printf("    At index %d,%d\n", i, j);
+                        goto error;
+                    }
+
+            if(H5DOwrite_chunk(dataset2, dxpl, filter_mask, offset, (size_t)chunk_nbytes, direct_buf) < 0)
+                goto error;
+        }
+
+    /* The copy should read back normally */
+    if(H5Dread(dataset2, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, check_data) < 0)
+        goto error;
+    for(i = 0; i < NX; i++)
+        for(j = 0; j < NY; j++)
+            if(data[i][j] != check_data[i][j]) {
+                printf("    2. Read different values than written.");
+                printf("    At index %d,%d\n", i, j);
+                goto error;
+            }
+
+    /* A chunk written with the filter skipped reads back with its mask */
+    for(i = n = 0; i < CHUNK_NX; i++)
+        for(j = 0; j < CHUNK_NY; j++)
+	    direct_buf[i][j] = n++;
+    offset[0] = CHUNK_NX;
+    offset[1] = 0;
+    if(H5DOwrite_chunk(dataset2, dxpl, (uint32_t)1, offset, buf_size, direct_buf) < 0)
+        goto error;
+    HDmemset(direct_buf, 0, sizeof(direct_buf));
+    if(H5DOread_chunk(dataset2, H5P_DEFAULT, offset, &filter_mask, direct_buf) < 0)
+        goto error;
+    if(filter_mask != 1)
+        goto error;
+    if(H5Dget_chunk_info_by_coord(dataset2, offset, &info_filter_mask, NULL, NULL) < 0)
+        goto error;
+    if(info_filter_mask != 1)
+        goto error;
+    for(i = n = 0; i < CHUNK_NX; i++)
+        for(j = 0; j < CHUNK_NY; j++)
+            if(direct_buf[i][j] != n++)
+                goto error;
+
+    /* Check that the DXPL can still be used for normal reads */
+    if(H5Dread(dataset, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, dxpl, check_data) < 0)
+        goto error;
+    if(data[NX - 1][NY - 1] != check_data[NX - 1][NY - 1])
+        goto error;
+
+    /* Check invalid offsets */
+    offset[0] = NX;
+    offset[1] = 0;
+    H5E_BEGIN_TRY {
+        if(H5DOread_chunk(dataset, dxpl, offset, &filter_mask, direct_buf) != FAIL)
+            goto error;
+        if(H5Dget_chunk_storage_size(dataset, offset, &chunk_nbytes) != FAIL)
+            goto error;
+    } H5E_END_TRY;
+    offset[0] = CHUNK_NX;
+    offset[1] = CHUNK_NY + 1;
+    H5E_BEGIN_TRY {
+        if(H5DOread_chunk(dataset, dxpl, offset, &filter_mask, direct_buf) != FAIL)
+            goto error;
+        if(H5Dget_chunk_info_by_coord(dataset, offset, NULL, &addr, NULL) != FAIL)
+            goto error;
+        if(H5DOread_chunk(dataset, dxpl, NULL, &filter_mask, direct_buf) != FAIL)
+            goto error;
+        if(H5DOread_chunk(dataset, dxpl, offset, &filter_mask, NULL) != FAIL)
+            goto error;
+    } H5E_END_TRY;
+
+    /*
+     * Close/release resources.
+     */
+    H5Dclose(dataset);
+    H5Dclose(dataset2);
+    H5Sclose(dataspace);
+    H5Pclose(cparms);
+    H5Pclose(dxpl);
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Dclose(dataset);
+        H5Dclose(dataset2);
+        H5Sclose(dataspace);
+        H5Pclose(cparms);
+        H5Pclose(dxpl);
+    } H5E_END_TRY;
+
+    return 1;
+}
+
 /*-------------------------------------------------------------------------
  * Function:	Main function
  *
@@ -1123,6 +1327,7 @@ int main( void )
     nerrors += test_skip_compress_write2(file_id);
     nerrors += test_data_conv(file_id);
     nerrors += test_invalid_parameters(file_id);
+    nerrors += test_direct_chunk_read(file_id);
 
     if(H5Fclose(file_id) < 0)
         goto error;
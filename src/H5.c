@@ -551,6 +551,82 @@ done:
     FUNC_LEAVE_API(ret_value)
 }   /* end H5set_free_list_limits() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5get_free_list_sizes
+ *
+ * Purpose:	Gets the current size of the different kinds of free lists that
+ *      the library uses to manage memory.  The free list sizes can be set with
+ *      H5set_free_list_limits and garbage collected with H5garbage_collect.
+ *      These lists are global for the entire library.
+ *
+ * Parameters:
+ *  size_t *reg_size;    OUT: The current size of all "regular" free list memory used
+ *  size_t *arr_size;    OUT: The current size of all "array" free list memory used
+ *  size_t *blk_size;    OUT: The current size of all "block" free list memory used
+ *  size_t *fac_size;    OUT: The current size of all "factory" free list memory used
+ *
+ * Return:	Success:	non-negative
+ *		Failure:	negative
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5get_free_list_sizes(size_t *reg_size, size_t *arr_size, size_t *blk_size,
+    size_t *fac_size)
+{
+    herr_t                  ret_value = SUCCEED;
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE4("e", "*z*z*z*z", reg_size, arr_size, blk_size, fac_size);
+
+    /* Call the free list function to actually get the sizes */
+    if(H5FL_get_free_list_sizes(reg_size, arr_size, blk_size, fac_size) < 0)
+        HGOTO_ERROR(H5E_RESOURCE, H5E_CANTGET, FAIL, "can't get garbage collection sizes")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+}   /* end H5get_free_list_sizes() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5iterate_free_lists
+ *
+ * Purpose:	Calls OP with the memory use of each free list in the library:
+ *      the number and total size of the blocks it has allocated, the most
+ *      memory it has had allocated at once, and how much of its memory is
+ *      on the free list, waiting to be reused.  Together with
+ *      H5set_free_list_limits, this lets long-running applications bound and
+ *      measure the memory the library keeps for reuse.
+ *
+ *      OP should return zero to continue with the next list, a positive
+ *      value to stop the iteration early or a negative value to fail.
+ *
+ * Return:	Success:	The last value returned by OP
+ *		Failure:	negative
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5iterate_free_lists(H5_free_list_operator_t op, void *op_data)
+{
+    herr_t                  ret_value;
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "x*x", op, op_data);
+
+    /* Check args */
+    if(!op)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "no operator specified")
+
+    /* Iterate over the free lists */
+    if((ret_value = H5FL_iterate(op, op_data)) < 0)
+        HGOTO_ERROR(H5E_RESOURCE, H5E_BADITER, FAIL, "iteration over free lists failed")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+}   /* end H5iterate_free_lists() */
+
 
 /*-------------------------------------------------------------------------
  * Function:    H5_debug_mask
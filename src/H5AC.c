@@ -2390,6 +2390,67 @@ H5AC_retag_copied_metadata(const H5F_t *f, haddr_t metadata_tag)
     FUNC_LEAVE_NOAPI(SUCCEED)
 } /* H5AC_retag_copied_metadata */
 
+
+/*------------------------------------------------------------------------------
+ * Function:    H5AC_flush_tagged_metadata()
+ *
+ * Purpose:     Flushes all dirty metadata entries with the specified tag,
+ *              i.e. the metadata belonging to a single object.
+ *
+ * Return:      SUCCEED on success, FAIL otherwise.
+ *
+ *------------------------------------------------------------------------------
+ */
+herr_t
+H5AC_flush_tagged_metadata(H5F_t *f, haddr_t metadata_tag, hid_t dxpl_id)
+{
+    herr_t ret_value = SUCCEED;
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    /* Sanity checks */
+    HDassert(f);
+    HDassert(f->shared);
+
+    /* Call cache level function to flush metadata entries with specified tag */
+    if(H5C_flush_tagged_entries(f, dxpl_id, metadata_tag) < 0)
+        HGOTO_ERROR(H5E_CACHE, H5E_CANTFLUSH, FAIL, "Cannot flush metadata")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5AC_flush_tagged_metadata */
+
+
+/*------------------------------------------------------------------------------
+ * Function:    H5AC_evict_tagged_metadata()
+ *
+ * Purpose:     Evicts all unpinned, unprotected metadata entries with the
+ *              specified tag from the cache, so that they are re-read from
+ *              the file on next access.
+ *
+ * Return:      SUCCEED on success, FAIL otherwise.
+ *
+ *------------------------------------------------------------------------------
+ */
+herr_t
+H5AC_evict_tagged_metadata(H5F_t *f, haddr_t metadata_tag, hid_t dxpl_id)
+{
+    herr_t ret_value = SUCCEED;
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    /* Sanity checks */
+    HDassert(f);
+    HDassert(f->shared);
+
+    /* Call cache level function to evict metadata entries with specified tag */
+    if(H5C_evict_tagged_entries(f, dxpl_id, metadata_tag) < 0)
+        HGOTO_ERROR(H5E_CACHE, H5E_CANTEXPUNGE, FAIL, "Cannot evict metadata")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5AC_evict_tagged_metadata */
+
 
 /*-------------------------------------------------------------------------
  * Function:    H5AC_get_entry_ring
@@ -2426,6 +2487,118 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* H5AC_get_entry_ring() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:    H5AC_get_cache_image
+ *
+ * Purpose:     Wrapper function for H5C_get_cache_image().
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5AC_get_cache_image(const H5F_t *f, void **image_ptr, size_t *image_len_ptr)
+{
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    /* Sanity checks */
+    HDassert(f);
+    HDassert(image_ptr);
+    HDassert(image_len_ptr);
+
+    if(H5C_get_cache_image(f, image_ptr, image_len_ptr) < 0)
+        HGOTO_ERROR(H5E_CACHE, H5E_CANTGET, FAIL, "can't construct cache image")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5AC_get_cache_image() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5AC_load_cache_image
+ *
+ * Purpose:     Wrapper function for H5C_load_cache_image().
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5AC_load_cache_image(H5F_t *f, hid_t dxpl_id, haddr_t addr, size_t len)
+{
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    /* Sanity checks */
+    HDassert(f);
+    HDassert(H5F_addr_defined(addr));
+
+    if(H5C_load_cache_image(f, dxpl_id, addr, len) < 0)
+        HGOTO_ERROR(H5E_CACHE, H5E_CANTLOAD, FAIL, "can't load cache image")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5AC_load_cache_image() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5AC_invalidate_cache_image
+ *
+ * Purpose:     Wrapper function for H5C_invalidate_cache_image().
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5AC_invalidate_cache_image(H5AC_t *cache_ptr, haddr_t addr, size_t size)
+{
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    /* Sanity check */
+    HDassert(cache_ptr);
+
+    if(H5C_invalidate_cache_image((H5C_t *)cache_ptr, addr, size) < 0)
+        HGOTO_ERROR(H5E_CACHE, H5E_CANTREMOVE, FAIL, "can't invalidate cache image")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5AC_invalidate_cache_image() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5AC_get_cache_image_stats
+ *
+ * Purpose:     Wrapper function for H5C_get_cache_image_stats().
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5AC_get_cache_image_stats(const H5AC_t *cache_ptr, unsigned *nentries_ptr,
+    unsigned *nhits_ptr)
+{
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    /* Sanity check */
+    HDassert(cache_ptr);
+
+    if(H5C_get_cache_image_stats((const H5C_t *)cache_ptr, nentries_ptr, nhits_ptr) < 0)
+        HGOTO_ERROR(H5E_CACHE, H5E_CANTGET, FAIL, "can't get cache image statistics")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5AC_get_cache_image_stats() */
+
 
 /*-------------------------------------------------------------------------
  * Function:       H5AC_set_ring
@@ -357,8 +357,18 @@ H5_DLL herr_t H5AC_open_trace_file(H5AC_t *cache_ptr, const char *trace_file_nam
 /* Tag & Ring routines */
 H5_DLL herr_t H5AC_tag(hid_t dxpl_id, haddr_t metadata_tag, haddr_t *prev_tag);
 H5_DLL herr_t H5AC_retag_copied_metadata(const H5F_t *f, haddr_t metadata_tag);
+H5_DLL herr_t H5AC_flush_tagged_metadata(H5F_t *f, haddr_t metadata_tag, hid_t dxpl_id);
+H5_DLL herr_t H5AC_evict_tagged_metadata(H5F_t *f, haddr_t metadata_tag, hid_t dxpl_id);
 H5_DLL herr_t H5AC_ignore_tags(const H5F_t *f);
 H5_DLL herr_t H5AC_get_entry_ring(const H5F_t *f, haddr_t addr, H5AC_ring_t *ring);
+H5_DLL herr_t H5AC_get_cache_image(const H5F_t *f, void **image_ptr,
+    size_t *image_len_ptr);
+H5_DLL herr_t H5AC_load_cache_image(H5F_t *f, hid_t dxpl_id, haddr_t addr,
+    size_t len);
+H5_DLL herr_t H5AC_invalidate_cache_image(H5AC_t *cache_ptr, haddr_t addr,
+    size_t size);
+H5_DLL herr_t H5AC_get_cache_image_stats(const H5AC_t *cache_ptr,
+    unsigned *nentries_ptr, unsigned *nhits_ptr);
 H5_DLL herr_t H5AC_set_ring(hid_t dxpl_id, H5AC_ring_t ring, H5P_genplist_t **dxpl,
     H5AC_ring_t *orig_ring);
 H5_DLL herr_t H5AC_reset_ring(H5P_genplist_t *dxpl, H5AC_ring_t orig_ring);
@@ -502,6 +502,47 @@ typedef struct H5AC_cache_config_t
 } H5AC_cache_config_t;
 
 
+/****************************************************************************
+ *
+ * structure H5AC_cache_image_config_t
+ *
+ * H5AC_cache_image_config_t is a public structure intended for use in public
+ * APIs.  At least in its initial incarnation, it is a copy of the fields
+ * of the metadata cache's cache image configuration that may be set by
+ * the user.
+ *
+ * The fields of the structure are discussed individually below:
+ *
+ * version: Integer field containing the version number of this version
+ *	of the H5AC_cache_image_config_t structure.  Any instance of
+ *	H5AC_cache_image_config_t passed to the cache must have a known
+ *	version number, or an error will be flagged.
+ *
+ * generate_image: Boolean flag indicating whether a cache image should
+ *	be created on file close.  When set, the clean contents of the
+ *	metadata cache are written to a single contiguous block in the
+ *	file when it is closed, and a message pointing to the block is
+ *	added to the superblock extension.  The next open of the file
+ *	reads the block with one I/O request and satisfies metadata
+ *	cache misses from it, instead of reading each entry separately.
+ *
+ *	A cache image is only written for files with a superblock
+ *	extension (i.e. superblock version 2 or later) that are opened
+ *	for writing, and is not supported in parallel or with file
+ *	drivers that store driver information in the file (e.g. the
+ *	multi, split and family drivers).
+ *
+ ****************************************************************************/
+
+#define H5AC__CURR_CACHE_IMAGE_CONFIG_VERSION 	1
+
+typedef struct H5AC_cache_image_config_t
+{
+    int                      version;
+    hbool_t                  generate_image;
+} H5AC_cache_image_config_t;
+
+
 #ifdef __cplusplus
 }
 #endif
@@ -170,11 +170,6 @@ static herr_t H5C_tag_entry(H5C_t * cache_ptr,
                             H5C_cache_entry_t * entry_ptr,
                             hid_t dxpl_id);
 
-static herr_t H5C_flush_tagged_entries(H5F_t * f, 
-                                       hid_t dxpl_id, 
-                                       H5C_t * cache_ptr, 
-                                       haddr_t tag);
-
 static herr_t H5C_mark_tagged_entries(H5C_t * cache_ptr, 
                                       haddr_t tag);
 
@@ -184,6 +179,13 @@ static herr_t H5C_flush_marked_entries(H5F_t * f,
 static herr_t H5C__generate_image(const H5F_t *f, H5C_t * cache_ptr, H5C_cache_entry_t *entry_ptr, 
                                   hid_t dxpl_id, int64_t *entry_size_change_ptr);
 
+static herr_t H5C__queue_flush_write(const H5F_t *f, hid_t dxpl_id,
+    const H5C_cache_entry_t *entry_ptr, size_t image_size);
+
+static herr_t H5C__write_flush_list(const H5F_t *f, hid_t dxpl_id);
+
+static herr_t H5C__flush_write_free(void *_item, void *key, void *op_data);
+
 #if H5C_DO_TAGGING_SANITY_CHECKS
 static herr_t H5C_verify_tag(int id, haddr_t tag);
 #endif
@@ -224,6 +226,9 @@ hbool_t H5_PKG_INIT_VAR = FALSE;
 /* Declare a free list to manage the H5C_t struct */
 H5FL_DEFINE_STATIC(H5C_t);
 
+/* Declare a free list to manage the H5C_flush_write_t struct */
+H5FL_DEFINE_STATIC(H5C_flush_write_t);
+
 /* Declare extern free list to manage the H5C_collective_write_t struct */
 H5FL_EXTERN(H5C_collective_write_t);
 
@@ -480,6 +485,14 @@ H5C_create(size_t		      max_cache_size,
         HGOTO_ERROR(H5E_CACHE, H5E_CANTCREATE, NULL, "can't create skip list.")
     }
 
+    if ( NULL == (cache_ptr->index = (H5C_cache_entry_t **)
+                  H5MM_calloc(sizeof(H5C_cache_entry_t *) *
+                              ((size_t)1 << H5C__HASH_TABLE_MIN_BITS))) ) {
+
+	HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, NULL, \
+                    "can't allocate cache index")
+    }
+
     /* If we get this far, we should succeed.  Go ahead and initialize all
      * the fields.
      */
@@ -535,8 +548,17 @@ H5C_create(size_t		      max_cache_size,
     cache_ptr->slist_size_increase		= 0;
 #endif /* H5C_DO_SANITY_CHECKS */
 
-    for(i = 0; i < H5C__HASH_TABLE_LEN; i++)
-        (cache_ptr->index)[i] = NULL;
+    cache_ptr->flush_write_list			= NULL;
+    cache_ptr->flush_write_list_size		= (size_t)0;
+
+    cache_ptr->index_nbuckets			= (size_t)1 << H5C__HASH_TABLE_MIN_BITS;
+    cache_ptr->index_nbits			= H5C__HASH_TABLE_MIN_BITS;
+    cache_ptr->old_index			= NULL;
+    cache_ptr->old_index_nbuckets		= 0;
+    cache_ptr->old_index_nbits			= 0;
+    cache_ptr->index_rehash_pos			= 0;
+    cache_ptr->il_head				= NULL;
+    cache_ptr->il_tail				= NULL;
 
     cache_ptr->entries_removed_counter		= 0;
     cache_ptr->last_entry_removed_ptr		= NULL;
@@ -637,6 +659,11 @@ H5C_create(size_t		      max_cache_size,
 
     H5C_stats__reset(cache_ptr);
 
+    cache_ptr->image_slist_ptr			= NULL;
+    cache_ptr->image_buf			= NULL;
+    cache_ptr->image_entries			= 0;
+    cache_ptr->image_hits			= 0;
+
     cache_ptr->prefix[0]			= '\0';  /* empty string */
 
 #ifndef NDEBUG
@@ -655,6 +682,8 @@ done:
             if ( cache_ptr->slist_ptr != NULL )
                 H5SL_close(cache_ptr->slist_ptr);
 
+            cache_ptr->index = (H5C_cache_entry_t **)H5MM_xfree(cache_ptr->index);
+
             cache_ptr->magic = 0;
             cache_ptr = H5FL_FREE(H5C_t, cache_ptr);
 
@@ -897,6 +926,16 @@ H5C_dest(H5F_t * f, hid_t dxpl_id)
         H5SL_close(cache_ptr->slist_ptr);
         cache_ptr->slist_ptr = NULL;
     } /* end if */
+    HDassert(cache_ptr->flush_write_list == NULL);
+
+    /* Discard the remains of the cache image, if any */
+    if(H5C__image_dest(cache_ptr) < 0)
+        HGOTO_ERROR(H5E_CACHE, H5E_CANTFREE, FAIL, "can't discard cache image")
+
+    /* Free the hash table(s) of the (now empty) index */
+    HDassert(cache_ptr->index_len == 0);
+    cache_ptr->index = (H5C_cache_entry_t **)H5MM_xfree(cache_ptr->index);
+    cache_ptr->old_index = (H5C_cache_entry_t **)H5MM_xfree(cache_ptr->old_index);
 
     /* Only display count of number of calls to H5C_get_entry_ptr_from_add()
      * if NDEBUG is undefined, and H5C_DO_SANITY_CHECKS is defined.  Need 
@@ -1908,6 +1947,8 @@ H5C_insert_entry(H5F_t *             f,
 
     entry_ptr->ht_next = NULL;
     entry_ptr->ht_prev = NULL;
+    entry_ptr->il_next = NULL;
+    entry_ptr->il_prev = NULL;
 
     entry_ptr->next = NULL;
     entry_ptr->prev = NULL;
@@ -3543,6 +3584,9 @@ done:
  *		Added code displaying the new slist_scan_restarts,
  *		LRU_scan_restarts, and hash_bucket_scan_restarts fields;
  *
+ *		Added code displaying the index_resizes field, and the
+ *		per type hash table search statistics.
+ *
  *-------------------------------------------------------------------------
  */
 herr_t
@@ -3702,6 +3746,12 @@ H5C_stats(H5C_t * cache_ptr,
               average_successful_search_depth,
               average_failed_search_depth);
 
+    HDfprintf(stdout,
+              "%s  HT buckets / resizes               = %ld / %ld\n",
+              cache_ptr->prefix,
+              (long)(cache_ptr->index_nbuckets),
+              (long)(cache_ptr->index_resizes));
+
     HDfprintf(stdout,
              "%s  current (max) index size / length  = %ld (%ld) / %ld (%ld)\n",
               cache_ptr->prefix,
@@ -3857,11 +3907,17 @@ H5C_stats(H5C_t * cache_ptr,
                             cache_ptr->entries_scanned_to_make_space));
 
     HDfprintf(stdout, 
-              "%s  slist/LRU/hash bkt scan restarts   = %lld / %lld / %lld.\n",
+              "%s  slist/LRU/index scan restarts      = %lld / %lld / %lld.\n",
               cache_ptr->prefix, 
               (long long)(cache_ptr->slist_scan_restarts),
               (long long)(cache_ptr->LRU_scan_restarts),
-              (long long)(cache_ptr->hash_bucket_scan_restarts));
+              (long long)(cache_ptr->index_scan_restarts));
+
+    HDfprintf(stdout,
+              "%s  flushed images / writes            = %lld / %lld\n",
+              cache_ptr->prefix,
+              (long long)(cache_ptr->flush_write_images),
+              (long long)(cache_ptr->flush_writes));
 
 #if H5C_COLLECT_CACHE_ENTRY_STATS
 
@@ -3965,6 +4021,16 @@ H5C_stats(H5C_t * cache_ptr,
                       (long)(cache_ptr->dirty_pins[i]),
                       (long)(cache_ptr->pinned_flushes[i]));
 
+            HDfprintf(stdout,
+                      "%s    HT searches / av. (max) depth  = %ld / %f (%d)\n",
+                      cache_ptr->prefix,
+                      (long)(cache_ptr->successful_ht_searches_by_type[i]),
+                      (cache_ptr->successful_ht_searches_by_type[i] > 0 ?
+                          ((double)(cache_ptr->total_ht_search_depth_by_type[i])) /
+                          ((double)(cache_ptr->successful_ht_searches_by_type[i])) :
+                          0.0f),
+                      (int)(cache_ptr->max_ht_search_depth_by_type[i]));
+
 #if H5C_COLLECT_CACHE_ENTRY_STATS
 
             HDfprintf(stdout,
@@ -4025,6 +4091,9 @@ done:
  *		LRU_scan_restarts, hash_bucket_scan_restarts, and 
  *		take_ownerships fields.
  *
+ *		Added code to initialize the index_resizes field and the
+ *		per type hash table search statistics.
+ *
  *-------------------------------------------------------------------------
  */
 void
@@ -4071,6 +4140,9 @@ H5C_stats__reset(H5C_t H5_ATTR_UNUSED * cache_ptr)
         cache_ptr->size_decreases[i] 		= 0;
 	cache_ptr->entry_flush_size_changes[i]	= 0;
 	cache_ptr->cache_flush_size_changes[i]	= 0;
+        cache_ptr->successful_ht_searches_by_type[i] = 0;
+        cache_ptr->total_ht_search_depth_by_type[i] = 0;
+        cache_ptr->max_ht_search_depth_by_type[i] = 0;
     }
 
     cache_ptr->total_ht_insertions		= 0;
@@ -4079,6 +4151,7 @@ H5C_stats__reset(H5C_t H5_ATTR_UNUSED * cache_ptr)
     cache_ptr->total_successful_ht_search_depth	= 0;
     cache_ptr->failed_ht_searches		= 0;
     cache_ptr->total_failed_ht_search_depth	= 0;
+    cache_ptr->index_resizes			= 0;
 
     cache_ptr->max_index_len			= 0;
     cache_ptr->max_index_size			= (size_t)0;
@@ -4103,7 +4176,10 @@ H5C_stats__reset(H5C_t H5_ATTR_UNUSED * cache_ptr)
 
     cache_ptr->slist_scan_restarts		= 0;
     cache_ptr->LRU_scan_restarts		= 0;
-    cache_ptr->hash_bucket_scan_restarts	= 0;
+    cache_ptr->index_scan_restarts		= 0;
+
+    cache_ptr->flush_write_images		= 0;
+    cache_ptr->flush_writes			= 0;
 
 #if H5C_COLLECT_CACHE_ENTRY_STATS
 
@@ -4166,22 +4242,19 @@ H5C_dump_cache(H5C_t * cache_ptr,
      * Do this, as we want to display cache entries in increasing address
      * order.
      */
-    for ( i = 0; i < H5C__HASH_TABLE_LEN; i++ ) {
-
-        entry_ptr = cache_ptr->index[i];
+    entry_ptr = cache_ptr->il_head;
 
-        while ( entry_ptr != NULL ) {
-
-            HDassert( entry_ptr->magic == H5C__H5C_CACHE_ENTRY_T_MAGIC );
+    while ( entry_ptr != NULL ) {
 
-            if ( H5SL_insert(slist_ptr, entry_ptr, &(entry_ptr->addr)) < 0 ) {
+        HDassert( entry_ptr->magic == H5C__H5C_CACHE_ENTRY_T_MAGIC );
 
-                HGOTO_ERROR(H5E_CACHE, H5E_BADVALUE, FAIL, \
-                            "Can't insert entry in skip list")
-            }
+        if ( H5SL_insert(slist_ptr, entry_ptr, &(entry_ptr->addr)) < 0 ) {
 
-            entry_ptr = entry_ptr->ht_next;
+            HGOTO_ERROR(H5E_CACHE, H5E_BADVALUE, FAIL, \
+                        "Can't insert entry in skip list")
         }
+
+        entry_ptr = entry_ptr->il_next;
     }
 
     /* If we get this far, all entries in the cache are listed in the
@@ -7072,7 +7145,7 @@ H5C_flush_invalidate_ring(const H5F_t * f, hid_t dxpl_id, H5C_ring_t ring,
 #endif /* H5C_DO_SANITY_CHECKS */
 
             /* Since we are doing a destroy, we must make a pass through
-             * the hash table and try to flush - destroy all entries that
+             * the index and try to flush - destroy all entries that
              * remain.
              *
              * It used to be that all entries remaining in the cache at
@@ -7082,116 +7155,112 @@ H5C_flush_invalidate_ring(const H5F_t * f, hid_t dxpl_id, H5C_ring_t ring,
              *
              * Writes to disk are possible here.
              */
-            for(i = 0; i < H5C__HASH_TABLE_LEN; i++) {
-                next_entry_ptr = cache_ptr->index[i];
+            next_entry_ptr = cache_ptr->il_head;
 
-                while(next_entry_ptr != NULL) {
-                    entry_ptr = next_entry_ptr;
-                    HDassert(entry_ptr->magic == H5C__H5C_CACHE_ENTRY_T_MAGIC);
-                    HDassert(entry_ptr->ring >= ring);
+            while(next_entry_ptr != NULL) {
+                entry_ptr = next_entry_ptr;
+                HDassert(entry_ptr->magic == H5C__H5C_CACHE_ENTRY_T_MAGIC);
+                HDassert(entry_ptr->ring >= ring);
 
-                    next_entry_ptr = entry_ptr->ht_next;
-                    HDassert((next_entry_ptr == NULL) ||
-                            (next_entry_ptr->magic == H5C__H5C_CACHE_ENTRY_T_MAGIC));
+                next_entry_ptr = entry_ptr->il_next;
+                HDassert((next_entry_ptr == NULL) ||
+                        (next_entry_ptr->magic == H5C__H5C_CACHE_ENTRY_T_MAGIC));
 
-                    if(((!entry_ptr->flush_me_last) ||
-                           ((entry_ptr->flush_me_last) &&
-                                (cache_ptr->num_last_entries >= cache_ptr->slist_len))) &&
-                           (entry_ptr->ring == ring)) {
+                if(((!entry_ptr->flush_me_last) ||
+                       ((entry_ptr->flush_me_last) &&
+                            (cache_ptr->num_last_entries >= cache_ptr->slist_len))) &&
+                       (entry_ptr->ring == ring)) {
 
-                        if(entry_ptr->is_protected) {
-                            /* we have major problems -- but lets flush and 
-                             * destroy everything we can before we flag an 
-                             * error.
-                             */
-                            protected_entries++;
-                            if(!entry_ptr->in_slist)
-                                HDassert(!(entry_ptr->is_dirty));
-                        } else if(!(entry_ptr->is_pinned)) {
+                    if(entry_ptr->is_protected) {
+                        /* we have major problems -- but lets flush and 
+                         * destroy everything we can before we flag an 
+                         * error.
+                         */
+                        protected_entries++;
+                        if(!entry_ptr->in_slist)
+                            HDassert(!(entry_ptr->is_dirty));
+                    } else if(!(entry_ptr->is_pinned)) {
 
-                            /* Test to see if we are can flush the entry now.
-                             * If we can, go ahead and flush.
+                        /* Test to see if we are can flush the entry now.
+                         * If we can, go ahead and flush.
+                         */
+                        if(entry_ptr->flush_dep_height == curr_flush_dep_height) {
+			    /* if *entry_ptr is dirty, it is possible 
+                             * that one or more other entries may be 
+                             * either removed from the cache, loaded 
+                             * into the cache, or moved to a new location
+                             * in the file as a side effect of the flush.
+                             *
+                             * If this happens, and one of the target 
+                             * entries happens to be the next entry in 
+                             * the index list, we could find ourselves 
+                             * either scanning a non-existant entry,
+                             * or skipping entries.
+                             *
+                             * Neither of these are good, so restart the 
+                             * the scan at the head of the index list
+                             * after the flush if *entry_ptr was dirty,
+                             * on the off chance that the next entry was
+                             * a target.  Do the same if the eviction of
+                             * *entry_ptr removed other entries, and the
+                             * next entry may have been one of them.
                              */
-                            if(entry_ptr->flush_dep_height == curr_flush_dep_height) {
-				/* if *entry_ptr is dirty, it is possible 
-                                 * that one or more other entries may be 
-                                 * either removed from the cache, loaded 
-                                 * into the cache, or moved to a new location
-                                 * in the file as a side effect of the flush.
-                                 *
-                                 * If this happens, and one of the target 
-                                 * entries happens to be the next entry in 
-                                 * the hash bucket, we could find ourselves 
-				 * either find ourselves either scanning a 
-                                 * non-existant entry, scanning through a 
-                                 * different bucket, or skipping an entry.
-                                 *
-                                 * Neither of these are good, so restart the 
-                                 * the scan at the head of the hash bucket 
-                                 * after the flush if *entry_ptr was dirty,
-                                 * on the off chance that the next entry was
-                                 * a target.
-                                 *
-                                 * This is not as inefficient at it might seem,
-                                 * as hash buckets typically have at most two
-                                 * or three entries.
-                                 */
-                                hbool_t entry_was_dirty;
+                            hbool_t entry_was_dirty;
 
-                                entry_was_dirty = entry_ptr->is_dirty;
+                            entry_was_dirty = entry_ptr->is_dirty;
 
-                                if(H5C__flush_single_entry(f, dxpl_id, entry_ptr, 
-                                        (cooked_flags | H5C__FLUSH_INVALIDATE_FLAG | H5C__DEL_FROM_SLIST_ON_DESTROY_FLAG), 
-                                        NULL, NULL) < 0)
-                                    HGOTO_ERROR(H5E_CACHE, H5E_CANTFLUSH, FAIL, "Entry flush destroy failed.")
-
-				if(entry_was_dirty) {
-                                    /* update stats for hash bucket scan
-                                     * restart here.
-                                     *                   -- JRM 
-                                     */
-                                    next_entry_ptr = cache_ptr->index[i];
-				    H5C__UPDATE_STATS_FOR_HASH_BUCKET_SCAN_RESTART(cache_ptr)
-                                } /* end if */
-
-                                flushed_during_dep_loop = TRUE;
+                            cache_ptr->entries_removed_counter = 0;
+                            cache_ptr->last_entry_removed_ptr  = NULL;
+
+                            if(H5C__flush_single_entry(f, dxpl_id, entry_ptr, 
+                                    (cooked_flags | H5C__FLUSH_INVALIDATE_FLAG | H5C__DEL_FROM_SLIST_ON_DESTROY_FLAG), 
+                                    NULL, NULL) < 0)
+                                HGOTO_ERROR(H5E_CACHE, H5E_CANTFLUSH, FAIL, "Entry flush destroy failed.")
+
+			    if(entry_was_dirty ||
+                                    (cache_ptr->entries_removed_counter > 1) ||
+                                    (cache_ptr->last_entry_removed_ptr == next_entry_ptr)) {
+                                next_entry_ptr = cache_ptr->il_head;
+			        H5C__UPDATE_STATS_FOR_INDEX_SCAN_RESTART(cache_ptr)
                             } /* end if */
-                            else if(entry_ptr->flush_dep_height < curr_flush_dep_height)
-                                /* This shouldn't happen -- if it does, just scream and die.  */
-                                HGOTO_ERROR(H5E_CACHE, H5E_CANTFLUSH, FAIL, "dirty entry below current flush dep. height.")
+
+                            flushed_during_dep_loop = TRUE;
                         } /* end if */
+                        else if(entry_ptr->flush_dep_height < curr_flush_dep_height)
+                            /* This shouldn't happen -- if it does, just scream and die.  */
+                            HGOTO_ERROR(H5E_CACHE, H5E_CANTFLUSH, FAIL, "dirty entry below current flush dep. height.")
                     } /* end if */
-                    /* We can't do anything if the entry is pinned.  The
-                     * hope is that the entry will be unpinned as the
-                     * result of destroys of entries that reference it.
-                     *
-                     * We detect this by noting the change in the number
-                     * of pinned entries from pass to pass.  If it stops
-                     * shrinking before it hits zero, we scream and die.
-                     */
-                    /* if the serialize function on the entry we last evicted
-                     * loaded an entry into cache (as Quincey has promised me
-                     * it never will), and if the cache was full, it is
-                     * possible that *next_entry_ptr was flushed or evicted.
-                     *
-                     * Test to see if this happened here.  Note that if this
-                     * test is triggred, we are accessing a deallocated piece
-                     * of dynamically allocated memory, so we just scream and
-                     * die.
-                     *
-                     * Update: The code to restart the scan after flushes
-                     *         of dirty entries should make it impossible 
-                     *         to satisfy the following test.  Leave it in
-                     *         in case I am wrong.
-                     *                                    -- JRM
+                } /* end if */
+                /* We can't do anything if the entry is pinned.  The
+                 * hope is that the entry will be unpinned as the
+                 * result of destroys of entries that reference it.
+                 *
+                 * We detect this by noting the change in the number
+                 * of pinned entries from pass to pass.  If it stops
+                 * shrinking before it hits zero, we scream and die.
+                 */
+                /* if the serialize function on the entry we last evicted
+                 * loaded an entry into cache (as Quincey has promised me
+                 * it never will), and if the cache was full, it is
+                 * possible that *next_entry_ptr was flushed or evicted.
+                 *
+                 * Test to see if this happened here.  Note that if this
+                 * test is triggred, we are accessing a deallocated piece
+                 * of dynamically allocated memory, so we just scream and
+                 * die.
+                 *
+                 * Update: The code to restart the scan after flushes
+                 *         of dirty entries should make it impossible 
+                 *         to satisfy the following test.  Leave it in
+                 *         in case I am wrong.
+                 *                                    -- JRM
+                 */
+                if((next_entry_ptr != NULL) && (next_entry_ptr->magic != H5C__H5C_CACHE_ENTRY_T_MAGIC))
+                    /* Something horrible has happened to
+                     * *next_entry_ptr -- scream and die.
                      */
-                    if((next_entry_ptr != NULL) && (next_entry_ptr->magic != H5C__H5C_CACHE_ENTRY_T_MAGIC))
-                        /* Something horrible has happened to
-                         * *next_entry_ptr -- scream and die.
-                         */
-                        HGOTO_ERROR(H5E_CACHE, H5E_SYSTEM, FAIL, "next_entry_ptr->magic is invalid?!?!?.")
-                } /* end while loop scanning hash table bin */
-            } /* end for loop scanning hash table */
+                    HGOTO_ERROR(H5E_CACHE, H5E_SYSTEM, FAIL, "next_entry_ptr->magic is invalid?!?!?.")
+            } /* end while loop scanning index list */
 
             /* Check for incrementing flush dependency height */
             if(flushed_during_dep_loop) {
@@ -7294,6 +7363,7 @@ H5C_flush_ring(H5F_t *f, hid_t dxpl_id, H5C_ring_t ring,  unsigned flags)
     hbool_t		ignore_protected;
     hbool_t		tried_to_flush_protected_entry = FALSE;
     hbool_t		restart_slist_scan;
+    hbool_t		queue_writes = FALSE;
     int32_t		passes = 0;
     int32_t		protected_entries = 0;
     H5SL_node_t * 	node_ptr = NULL;
@@ -7356,6 +7426,25 @@ H5C_flush_ring(H5F_t *f, hid_t dxpl_id, H5C_ring_t ring,  unsigned flags)
     cache_ptr->slist_change_in_pre_serialize = FALSE;
     cache_ptr->slist_change_in_serialize = FALSE;
 
+    /* Queue the images of the entries flushed below, and write them in
+     * address order at the end of each pass through the slist, combining
+     * images that are adjacent in the file.
+     *
+     * A SWMR writer keeps writing each image as soon as its entry is
+     * flushed, as flush dependencies may be taken down by the entries'
+     * notify callbacks, letting a parent be flushed in the same pass as
+     * its children.
+     */
+    if(NULL == cache_ptr->flush_write_list && !(H5F_INTENT(f) & H5F_ACC_SWMR_WRITE)
+#ifdef H5_HAVE_PARALLEL
+            && NULL == cache_ptr->aux_ptr
+#endif /* H5_HAVE_PARALLEL */
+            ) {
+        if(NULL == (cache_ptr->flush_write_list = H5SL_create(H5SL_TYPE_HADDR, NULL)))
+            HGOTO_ERROR(H5E_CACHE, H5E_CANTCREATE, FAIL, "can't create flush write list")
+        queue_writes = TRUE;
+    } /* end if */
+
     while((passes < H5C__MAX_PASSES_ON_FLUSH) &&
             (cache_ptr->slist_ring_len[ring] > 0) &&
 	    (protected_entries == 0)  &&
@@ -7422,6 +7511,13 @@ H5C_flush_ring(H5F_t *f, hid_t dxpl_id, H5C_ring_t ring,  unsigned flags)
                 if(restart_slist_scan) {
                     restart_slist_scan = FALSE;
 
+                    /* The callbacks that forced the restart may have
+                     * reused file space whose images are still queued,
+                     * so write those images out first.
+                     */
+                    if(queue_writes && H5C__write_flush_list(f, dxpl_id) < 0)
+                        HGOTO_ERROR(H5E_CACHE, H5E_CANTFLUSH, FAIL, "can't write queued entry images")
+
                     /* Start at beginning of skip list */
                     node_ptr = H5SL_first(cache_ptr->slist_ptr);
 
@@ -7593,6 +7689,12 @@ H5C_flush_ring(H5F_t *f, hid_t dxpl_id, H5C_ring_t ring,  unsigned flags)
                 } /* end if */
             } /* while ( ( restart_slist_scan ) || ( node_ptr != NULL ) ) */
 
+            /* Write the images of this pass before any entry that
+             * depends on them can be flushed.
+             */
+            if(queue_writes && H5C__write_flush_list(f, dxpl_id) < 0)
+                HGOTO_ERROR(H5E_CACHE, H5E_CANTFLUSH, FAIL, "can't write queued entry images")
+
             /* Check for incrementing flush dependency height */
             if(flushed_during_dep_loop) {
 
@@ -7639,6 +7741,18 @@ H5C_flush_ring(H5F_t *f, hid_t dxpl_id, H5C_ring_t ring,  unsigned flags)
 #endif /* H5C_DO_SANITY_CHECKS */
 
 done:
+    if(queue_writes) {
+        /* Entries whose images are still queued after an error have
+         * already been marked clean, so try to write the images anyway.
+         */
+        if(H5C__write_flush_list(f, dxpl_id) < 0)
+            HDONE_ERROR(H5E_CACHE, H5E_CANTFLUSH, FAIL, "can't write queued entry images")
+        if(H5SL_destroy(cache_ptr->flush_write_list, H5C__flush_write_free, NULL) < 0)
+            HDONE_ERROR(H5E_CACHE, H5E_CANTFREE, FAIL, "can't destroy flush write list")
+        cache_ptr->flush_write_list = NULL;
+        cache_ptr->flush_write_list_size = 0;
+    } /* end if */
+
     FUNC_LEAVE_NOAPI(ret_value)
 } /* H5C_flush_ring() */
 
@@ -7890,7 +8004,11 @@ H5C__flush_single_entry(const H5F_t *f, hid_t dxpl_id, H5C_cache_entry_t *entry_
             } /* end if */
             else
 #endif /* H5_HAVE_PARALLEL */
-            if(H5F_block_write(f, entry_ptr->type->mem_type, entry_ptr->addr,
+            if(cache_ptr->flush_write_list) {
+                if(H5C__queue_flush_write(f, dxpl_id, entry_ptr, image_size) < 0)
+                    HGOTO_ERROR(H5E_CACHE, H5E_CANTFLUSH, FAIL, "Can't queue image for writing.")
+            } /* end if */
+            else if(H5F_block_write(f, entry_ptr->type->mem_type, entry_ptr->addr,
                     image_size, dxpl_id, entry_ptr->image_ptr) < 0)
                 HGOTO_ERROR(H5E_CACHE, H5E_CANTFLUSH, FAIL, "Can't write image to file.")
         }
@@ -8067,7 +8185,7 @@ H5C__flush_single_entry(const H5F_t *f, hid_t dxpl_id, H5C_cache_entry_t *entry_
          * or take ownership at present), so that they can re-start
          * their scans if necessary.
          */
-        cache_ptr->last_entry_removed_ptr++;
+        cache_ptr->entries_removed_counter++;
         cache_ptr->last_entry_removed_ptr = entry_ptr;
 
         /* Check for actually destroying the entry in memory */
@@ -8124,6 +8242,195 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* H5C__flush_single_entry() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:    H5C__queue_flush_write
+ *
+ * Purpose:     Queue a copy of the image of an entry that has just been
+ *		flushed on the cache's flush_write_list, replacing any
+ *		image already queued at the same address.  The queue is
+ *		written out once it holds more than
+ *		H5C__FLUSH_WRITE_LIST_MAX_SIZE bytes.
+ *
+ *		The image is copied, as the entry may be resized or
+ *		evicted before the queue is written.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5C__queue_flush_write(const H5F_t *f, hid_t dxpl_id,
+    const H5C_cache_entry_t *entry_ptr, size_t image_size)
+{
+    H5C_t *cache_ptr = f->shared->cache;    /* Cache for file */
+    H5C_flush_write_t *item;                /* Queued image */
+    void *buf = NULL;                       /* Copy of the entry's image */
+    herr_t ret_value = SUCCEED;             /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Sanity checks */
+    HDassert(cache_ptr);
+    HDassert(cache_ptr->flush_write_list);
+    HDassert(entry_ptr);
+    HDassert(entry_ptr->image_ptr);
+    HDassert(image_size > 0);
+
+    if(NULL == (buf = H5MM_malloc(image_size)))
+        HGOTO_ERROR(H5E_CACHE, H5E_CANTALLOC, FAIL, "memory allocation failed for queued image")
+    HDmemcpy(buf, entry_ptr->image_ptr, image_size);
+
+    /* Replace an older image at the same address, or queue a new one */
+    if(NULL != (item = (H5C_flush_write_t *)H5SL_search(cache_ptr->flush_write_list, &entry_ptr->addr))) {
+        HDassert(cache_ptr->flush_write_list_size >= item->size);
+        cache_ptr->flush_write_list_size -= item->size;
+        item->buf = H5MM_xfree(item->buf);
+    } /* end if */
+    else {
+        if(NULL == (item = H5FL_MALLOC(H5C_flush_write_t)))
+            HGOTO_ERROR(H5E_CACHE, H5E_CANTALLOC, FAIL, "memory allocation failed for flush write list item")
+        item->addr = entry_ptr->addr;
+        item->buf = NULL;
+        if(H5SL_insert(cache_ptr->flush_write_list, item, &item->addr) < 0) {
+            item = H5FL_FREE(H5C_flush_write_t, item);
+            HGOTO_ERROR(H5E_CACHE, H5E_CANTINSERT, FAIL, "can't insert image in flush write list")
+        } /* end if */
+    } /* end else */
+    item->size = image_size;
+    item->mem_type = entry_ptr->type->mem_type;
+    item->buf = buf;
+    buf = NULL;
+    cache_ptr->flush_write_list_size += image_size;
+
+    /* Bound the memory held by the queue */
+    if(cache_ptr->flush_write_list_size > H5C__FLUSH_WRITE_LIST_MAX_SIZE)
+        if(H5C__write_flush_list(f, dxpl_id) < 0)
+            HGOTO_ERROR(H5E_CACHE, H5E_WRITEERROR, FAIL, "can't write queued entry images")
+
+done:
+    if(buf)
+        buf = H5MM_xfree(buf);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5C__queue_flush_write() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5C__write_flush_list
+ *
+ * Purpose:     Write the entry images queued on the cache's
+ *		flush_write_list in address order and empty the list.
+ *		Images of the same file memory type that are adjacent in
+ *		the file are combined into a single write.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5C__write_flush_list(const H5F_t *f, hid_t dxpl_id)
+{
+    H5C_t *cache_ptr = f->shared->cache;    /* Cache for file */
+    H5SL_node_t *node;                      /* First image of a run */
+    uint8_t *run_buf = NULL;                /* Buffer to combine a run in */
+    size_t run_buf_size = 0;                /* Size of run_buf */
+    herr_t ret_value = SUCCEED;             /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Sanity checks */
+    HDassert(cache_ptr);
+    HDassert(cache_ptr->flush_write_list);
+
+    node = H5SL_first(cache_ptr->flush_write_list);
+    while(node) {
+        H5C_flush_write_t *first = (H5C_flush_write_t *)H5SL_item(node);
+        H5SL_node_t *next = H5SL_next(node);
+        size_t run_size = first->size;
+        unsigned nimages = 1;
+
+        /* Extend the run over the images that follow it in the file */
+        while(next) {
+            H5C_flush_write_t *item = (H5C_flush_write_t *)H5SL_item(next);
+
+            if(item->mem_type != first->mem_type ||
+                    !H5F_addr_eq(first->addr + run_size, item->addr))
+                break;
+            run_size += item->size;
+            nimages++;
+            next = H5SL_next(next);
+        } /* end while */
+
+        if(nimages == 1) {
+            if(H5F_block_write(f, first->mem_type, first->addr, first->size, dxpl_id, first->buf) < 0)
+                HGOTO_ERROR(H5E_CACHE, H5E_CANTFLUSH, FAIL, "Can't write image to file.")
+        } /* end if */
+        else {
+            size_t offset = 0;
+
+            if(run_size > run_buf_size) {
+                run_buf = (uint8_t *)H5MM_xfree(run_buf);
+                if(NULL == (run_buf = (uint8_t *)H5MM_malloc(run_size)))
+                    HGOTO_ERROR(H5E_CACHE, H5E_CANTALLOC, FAIL, "memory allocation failed for combined images")
+                run_buf_size = run_size;
+            } /* end if */
+
+            while(node != next) {
+                H5C_flush_write_t *item = (H5C_flush_write_t *)H5SL_item(node);
+
+                HDmemcpy(run_buf + offset, item->buf, item->size);
+                offset += item->size;
+                node = H5SL_next(node);
+            } /* end while */
+            HDassert(offset == run_size);
+
+            if(H5F_block_write(f, first->mem_type, first->addr, run_size, dxpl_id, run_buf) < 0)
+                HGOTO_ERROR(H5E_CACHE, H5E_CANTFLUSH, FAIL, "Can't write images to file.")
+        } /* end else */
+
+        H5C__UPDATE_STATS_FOR_FLUSH_WRITE(cache_ptr, nimages)
+
+        node = next;
+    } /* end while */
+
+    /* Release the images */
+    if(H5SL_free(cache_ptr->flush_write_list, H5C__flush_write_free, NULL) < 0)
+        HGOTO_ERROR(H5E_CACHE, H5E_CANTFREE, FAIL, "can't release queued entry images")
+    cache_ptr->flush_write_list_size = 0;
+
+done:
+    run_buf = (uint8_t *)H5MM_xfree(run_buf);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5C__write_flush_list() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5C__flush_write_free
+ *
+ * Purpose:     Release an image queued on the flush_write_list.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5C__flush_write_free(void *_item, void H5_ATTR_UNUSED *key, void H5_ATTR_UNUSED *op_data)
+{
+    H5C_flush_write_t *item = (H5C_flush_write_t *)_item;
+
+    FUNC_ENTER_STATIC_NOERR
+
+    /* Sanity check */
+    HDassert(item);
+
+    item->buf = H5MM_xfree(item->buf);
+    item = H5FL_FREE(H5C_flush_write_t, item);
+
+    FUNC_LEAVE_NOAPI(SUCCEED)
+} /* H5C__flush_write_free() */
+
 
 /*-------------------------------------------------------------------------
  *
@@ -8166,6 +8473,8 @@ H5C_load_entry(H5F_t *             f,
     void *		thing = NULL;   /* Pointer to thing loaded */
     H5C_cache_entry_t *	entry;          /* Alias for thing loaded, as cache entry */
     size_t              len;            /* Size of image in file */
+    unsigned            attempt = 0;    /* # of read attempts made */
+    unsigned            max_attempts;   /* Max. # of read attempts */
     unsigned            u;              /* Local index variable */
 #ifdef H5_HAVE_PARALLEL
     int                 mpi_rank = 0;   /* MPI process rank */
@@ -8200,6 +8509,13 @@ H5C_load_entry(H5F_t *             f,
     HDassert(type->get_load_size);
     HDassert(type->deserialize);
 
+    /* A flush in progress may have queued images that are not in the
+     * file yet -- write them before reading from the file.
+     */
+    if(f->shared->cache->flush_write_list &&
+            H5C__write_flush_list(f, dxpl_id) < 0)
+        HGOTO_ERROR(H5E_CACHE, H5E_CANTFLUSH, NULL, "can't write queued entry images")
+
     /* Call the get_load_size callback, to retrieve the initial 
      * size of image 
      */
@@ -8325,32 +8641,45 @@ H5C_load_entry(H5F_t *             f,
     } /* end if */
 #endif /* H5_HAVE_PARALLEL */
 
-    /* Get the on-disk entry image */
-    if(0 == (type->flags & H5C__CLASS_SKIP_READS)) {
+    /* Get the on-disk entry image and deserialize it.  A SWMR reader may
+     * see an image that the writer is in the middle of updating, which
+     * fails its checksum; in that case the read is retried, up to the
+     * file's number of metadata read attempts.
+     */
+    max_attempts = H5F_GET_READ_ATTEMPTS(f);
+    do {
+        attempt++;
+
+        /* Get the on-disk entry image */
+        if(0 == (type->flags & H5C__CLASS_SKIP_READS)) {
 #ifdef H5_HAVE_PARALLEL
-        if(!coll_access || 0 == mpi_rank) {
+            if(!coll_access || 0 == mpi_rank) {
 #endif /* H5_HAVE_PARALLEL */
-            if(H5F_block_read(f, type->mem_type, addr, len, dxpl_id, image) < 0)
-                HGOTO_ERROR(H5E_CACHE, H5E_READERROR, NULL, "Can't read image*")
+                if(H5C__image_read(f, dxpl_id, type, addr, len, image) < 0)
+                    HGOTO_ERROR(H5E_CACHE, H5E_READERROR, NULL, "Can't read image*")
 
 #ifdef H5_HAVE_PARALLEL
+            } /* end if */
+            /* if the collective metadata read optimization is turned on,
+               bcast the metadata read from process 0 to all ranks in the file
+               communicator */
+            if(coll_access) {
+                int buf_size;
+
+                H5_CHECKED_ASSIGN(buf_size, int, len, size_t);
+                if(MPI_SUCCESS != (mpi_code = MPI_Bcast(image, buf_size, MPI_BYTE, 0, comm)))
+                    HMPI_GOTO_ERROR(NULL, "MPI_Bcast failed", mpi_code)
+            } /* end if */
+#endif /* H5_HAVE_PARALLEL */
         } /* end if */
-        /* if the collective metadata read optimization is turned on,
-           bcast the metadata read from process 0 to all ranks in the file
-           communicator */
-        if(coll_access) {
-            int buf_size;
 
-            H5_CHECKED_ASSIGN(buf_size, int, len, size_t);
-            if(MPI_SUCCESS != (mpi_code = MPI_Bcast(image, buf_size, MPI_BYTE, 0, comm)))
-                HMPI_GOTO_ERROR(NULL, "MPI_Bcast failed", mpi_code)
+        /* Deserialize the on-disk image into the native memory form */
+        if(NULL == (thing = type->deserialize(image, len, udata, &dirty))) {
+            if(attempt >= max_attempts)
+                HGOTO_ERROR(H5E_CACHE, H5E_CANTLOAD, NULL, "Can't deserialize image")
+            H5E_clear_stack(NULL);
         } /* end if */
-#endif /* H5_HAVE_PARALLEL */
-    } /* end if */
-
-    /* Deserialize the on-disk image into the native memory form */
-    if(NULL == (thing = type->deserialize(image, len, udata, &dirty)))
-        HGOTO_ERROR(H5E_CACHE, H5E_CANTLOAD, NULL, "Can't deserialize image")
+    } while(NULL == thing);
 
     /* If the client's cache has an image_len callback, check it */
     if(type->image_len) {
@@ -8453,8 +8782,8 @@ H5C_load_entry(H5F_t *             f,
                     if(!coll_access || 0 == mpi_rank) {
 #endif /* H5_HAVE_PARALLEL */
                     /* Go get the on-disk image again */
-                    if(H5F_block_read(f, type->mem_type, addr, 
-                                      new_len, dxpl_id, image) < 0)
+                    if(H5C__image_read(f, dxpl_id, type, addr, 
+                                      new_len, image) < 0)
                         HGOTO_ERROR(H5E_CACHE, H5E_CANTLOAD, NULL, "Can't read image")
 
 #ifdef H5_HAVE_PARALLEL
@@ -8573,6 +8902,8 @@ H5C_load_entry(H5F_t *             f,
     entry->flush_dep_height = 0;
     entry->ht_next              = NULL;
     entry->ht_prev              = NULL;
+    entry->il_next              = NULL;
+    entry->il_prev              = NULL;
 
     entry->next                 = NULL;
     entry->prev                 = NULL;
@@ -8587,6 +8918,11 @@ H5C_load_entry(H5F_t *             f,
 
     H5C__RESET_CACHE_ENTRY_STATS(entry);
 
+    /* The entry is in memory now, so drop it from the cache image */
+    if(f->shared->cache->image_slist_ptr)
+        if(H5C__image_entry_loaded(f->shared->cache, addr) < 0)
+            HGOTO_ERROR(H5E_CACHE, H5E_CANTREMOVE, NULL, "can't remove entry from cache image")
+
     ret_value = thing;
 
 done:
@@ -9699,10 +10035,6 @@ done:
  *
  * Function:    H5C_flush_tagged_entries
  *
- * WARNING:     Not yet tested or used anywhere. (written awhile ago,
- *              will keep it around in anticipation of being used in
- *              subsequent changes to support flushing individual objects).
- *
  * Purpose:     Flushes all entries with the specified tag to disk.
  *
  * Return:      FAIL if error is detected, SUCCEED otherwise.
@@ -9712,15 +10044,18 @@ done:
  *
  *-------------------------------------------------------------------------
  */
-static herr_t
-H5C_flush_tagged_entries(H5F_t * f, hid_t dxpl_id, H5C_t * cache_ptr, haddr_t tag)
+herr_t
+H5C_flush_tagged_entries(H5F_t * f, hid_t dxpl_id, haddr_t tag)
 {
+    H5C_t      *cache_ptr;
     herr_t      ret_value = SUCCEED;
 
     FUNC_ENTER_NOAPI(FAIL)
 
     /* Assertions */
-    HDassert(0); /* This function is not yet used. We shouldn't be in here yet. */
+    HDassert(f);
+    HDassert(f->shared);
+    cache_ptr = f->shared->cache;
     HDassert(cache_ptr != NULL);
     HDassert(cache_ptr->magic == H5C__H5C_T_MAGIC);
 
@@ -9741,12 +10076,9 @@ done:
  *
  * Function:    H5C_mark_tagged_entries
  *
- * WARNING:     Not yet tested or used anywhere. (written awhile ago,
- *              will keep it around in anticipation of being used in
- *              subsequent changes to support flushing individual objects).
- *
- * Purpose:     Set the flush marker on entries in the cache that have
- *              the specified tag.
+ * Purpose:     Set the flush marker on dirty entries in the cache that
+ *              have the specified tag.  (Clean entries are not in the
+ *              skip list and must not be marked.)
  *
  * Return:      FAIL if error is detected, SUCCEED otherwise.
  *
@@ -9759,26 +10091,21 @@ static herr_t
 H5C_mark_tagged_entries(H5C_t * cache_ptr, haddr_t tag) 
 {
     H5C_cache_entry_t *next_entry_ptr;  /* entry pointer */
-    unsigned u;                         /* Local index variable */
 
     FUNC_ENTER_NOAPI_NOINIT_NOERR
 
     /* Assertions */
-    HDassert(0); /* This function is not yet used. We shouldn't be in here yet. */
     HDassert(cache_ptr != NULL);
     HDassert(cache_ptr->magic == H5C__H5C_T_MAGIC);
 
     /* Iterate through entries, marking those with specified tag. */
-    for(u = 0; u < H5C__HASH_TABLE_LEN; u++) {
-
-        next_entry_ptr = cache_ptr->index[u];
-        while(next_entry_ptr != NULL) {
-            if(next_entry_ptr->tag == tag)
-                next_entry_ptr->flush_marker = TRUE;
+    next_entry_ptr = cache_ptr->il_head;
+    while(next_entry_ptr != NULL) {
+        if(next_entry_ptr->tag == tag && next_entry_ptr->is_dirty)
+            next_entry_ptr->flush_marker = TRUE;
 
-            next_entry_ptr = next_entry_ptr->ht_next;
-        } /* end while */
-    } /* for */
+        next_entry_ptr = next_entry_ptr->il_next;
+    } /* end while */
 
     FUNC_LEAVE_NOAPI(SUCCEED)
 } /* H5C_mark_tagged_entries */
@@ -9788,10 +10115,6 @@ H5C_mark_tagged_entries(H5C_t * cache_ptr, haddr_t tag)
  *
  * Function:    H5C_flush_marked_entries
  *
- * WARNING:     Not yet tested or used anywhere. (written awhile ago,
- *              will keep it around in anticipation of being used in
- *              subsequent changes to support flushing individual objects).
- *
  * Purpose:     Flushes all marked entries in the cache.
  *
  * Return:      FAIL if error is detected, SUCCEED otherwise.
@@ -9809,7 +10132,6 @@ H5C_flush_marked_entries(H5F_t * f, hid_t dxpl_id)
     FUNC_ENTER_NOAPI_NOINIT
 
     /* Assertions */
-    HDassert(0); /* This function is not yet used. We shouldn't be in here yet. */
     HDassert(f != NULL);
 
     /* Flush all marked entries */
@@ -9820,6 +10142,82 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* H5C_flush_marked_entries */
 
+
+/*-------------------------------------------------------------------------
+ *
+ * Function:    H5C_evict_tagged_entries
+ *
+ * Purpose:     Evicts all entries with the specified tag from the cache,
+ *              so that they are re-read from the file the next time they
+ *              are protected.  Dirty entries are written first.
+ *
+ *              Entries that are protected, pinned or are the parent in a
+ *              flush dependency are left alone.  Since evicting a child
+ *              removes its flush dependency, the index is scanned until
+ *              a pass evicts nothing.
+ *
+ * Return:      FAIL if error is detected, SUCCEED otherwise.
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5C_evict_tagged_entries(H5F_t * f, hid_t dxpl_id, haddr_t tag)
+{
+    H5C_t      *cache_ptr;
+    hbool_t     evicted_entries_last_pass;
+    herr_t      ret_value = SUCCEED;
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    /* Assertions */
+    HDassert(f);
+    HDassert(f->shared);
+    cache_ptr = f->shared->cache;
+    HDassert(cache_ptr != NULL);
+    HDassert(cache_ptr->magic == H5C__H5C_T_MAGIC);
+
+    do {
+        H5C_cache_entry_t *entry_ptr;
+        H5C_cache_entry_t *next_entry_ptr;
+
+        evicted_entries_last_pass = FALSE;
+
+        next_entry_ptr = cache_ptr->il_head;
+        while(next_entry_ptr != NULL) {
+            entry_ptr = next_entry_ptr;
+            next_entry_ptr = entry_ptr->il_next;
+
+            if(entry_ptr->tag == tag && !entry_ptr->is_protected
+                    && !entry_ptr->is_pinned
+                    && entry_ptr->flush_dep_height == 0) {
+                hbool_t entry_was_dirty = entry_ptr->is_dirty;
+
+                cache_ptr->entries_removed_counter = 0;
+                cache_ptr->last_entry_removed_ptr  = NULL;
+
+                if(H5C__flush_single_entry(f, dxpl_id, entry_ptr, H5C__FLUSH_INVALIDATE_FLAG | H5C__DEL_FROM_SLIST_ON_DESTROY_FLAG, NULL, NULL) < 0)
+                    HGOTO_ERROR(H5E_CACHE, H5E_CANTEXPUNGE, FAIL, "can't evict tagged entry")
+
+                evicted_entries_last_pass = TRUE;
+
+                /* Evicting an entry may evict others through its notify
+                 * callback, and flushing a dirty one may load or move
+                 * others, so restart the scan if the next entry may have
+                 * been affected.
+                 */
+                if(entry_was_dirty || (cache_ptr->entries_removed_counter > 1) ||
+                        (cache_ptr->last_entry_removed_ptr == next_entry_ptr)) {
+                    next_entry_ptr = cache_ptr->il_head;
+                    H5C__UPDATE_STATS_FOR_INDEX_SCAN_RESTART(cache_ptr)
+                } /* end if */
+            } /* end if */
+        } /* end while */
+    } while(evicted_entries_last_pass);
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5C_evict_tagged_entries */
+
 #if H5C_DO_TAGGING_SANITY_CHECKS
 
 /*-------------------------------------------------------------------------
@@ -9916,25 +10314,20 @@ done:
 void
 H5C_retag_copied_metadata(H5C_t * cache_ptr, haddr_t metadata_tag) 
 {
-    unsigned u;         /* Local index variable */
+    H5C_cache_entry_t *next_entry_ptr;      /* entry pointer */
 
     FUNC_ENTER_NOAPI_NOINIT_NOERR
 
     HDassert(cache_ptr);
 
     /* Iterate through entries, retagging those with the H5AC__COPIED_TAG tag */
-    for(u = 0; u < H5C__HASH_TABLE_LEN; u++) {
-        H5C_cache_entry_t *next_entry_ptr;      /* entry pointer */
-
-        next_entry_ptr = cache_ptr->index[u];
-        while(next_entry_ptr != NULL) {
-            if(cache_ptr->index[u] != NULL)
-                if((cache_ptr->index[u])->tag == H5AC__COPIED_TAG)
-                    (cache_ptr->index[u])->tag = metadata_tag;
+    next_entry_ptr = cache_ptr->il_head;
+    while(next_entry_ptr != NULL) {
+        if(next_entry_ptr->tag == H5AC__COPIED_TAG)
+            next_entry_ptr->tag = metadata_tag;
 
-            next_entry_ptr = next_entry_ptr->ht_next;
-        } /* end while */
-    } /* end for */
+        next_entry_ptr = next_entry_ptr->il_next;
+    } /* end while */
 
     FUNC_LEAVE_NOAPI_VOID
 } /* H5C_retag_copied_metadata */
@@ -10225,3 +10618,94 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* H5C__generate_image */
 
+
+
+/*-------------------------------------------------------------------------
+ *
+ * Function:    H5C__index_rehash
+ *
+ * Purpose:     Make progress on growing the cache index.
+ *
+ *              If the index is not being resized, start doing so by
+ *              allocating a hash table with twice as many buckets and
+ *              making the current table the old one.  Then move the
+ *              entries of the next H5C__HASH_REHASH_STEP buckets of the
+ *              old table to the new one, and free the old table once it
+ *              is empty.
+ *
+ *              Spreading the move over many index insertions and
+ *              deletions keeps the cost of each one bounded, so that
+ *              growing a large index causes no visible pause.
+ *
+ *              If the new table can't be allocated, the current one is
+ *              kept.  The index still works, with longer bucket lists.
+ *
+ * Return:      void
+ *
+ *-------------------------------------------------------------------------
+ */
+void
+H5C__index_rehash(H5C_t *cache_ptr)
+{
+    FUNC_ENTER_PACKAGE_NOERR
+
+    /* Sanity checks */
+    HDassert(cache_ptr);
+    HDassert(cache_ptr->magic == H5C__H5C_T_MAGIC);
+    HDassert(cache_ptr->index);
+
+    /* Start growing the index, if it needs to */
+    if(NULL == cache_ptr->old_index && H5C__INDEX_NEEDS_GROW(cache_ptr)) {
+        H5C_cache_entry_t **new_index;
+
+        if(NULL != (new_index = (H5C_cache_entry_t **)H5MM_calloc(sizeof(H5C_cache_entry_t *) * cache_ptr->index_nbuckets * 2))) {
+            cache_ptr->old_index = cache_ptr->index;
+            cache_ptr->old_index_nbuckets = cache_ptr->index_nbuckets;
+            cache_ptr->old_index_nbits = cache_ptr->index_nbits;
+            cache_ptr->index_rehash_pos = 0;
+
+            cache_ptr->index = new_index;
+            cache_ptr->index_nbuckets *= 2;
+            cache_ptr->index_nbits++;
+
+            H5C__UPDATE_STATS_FOR_INDEX_RESIZE(cache_ptr)
+        } /* end if */
+    } /* end if */
+
+    /* Move some buckets of the old table to the new one */
+    if(cache_ptr->old_index) {
+        unsigned u;
+
+        for(u = 0; u < H5C__HASH_REHASH_STEP && cache_ptr->index_rehash_pos < cache_ptr->old_index_nbuckets; u++) {
+            H5C_cache_entry_t *entry_ptr;
+
+            entry_ptr = cache_ptr->old_index[cache_ptr->index_rehash_pos];
+            cache_ptr->old_index[cache_ptr->index_rehash_pos] = NULL;
+            cache_ptr->index_rehash_pos++;
+
+            while(entry_ptr) {
+                H5C_cache_entry_t *next_entry_ptr = entry_ptr->ht_next;
+                H5C_cache_entry_t **bucket;
+
+                bucket = &(cache_ptr->index[H5C__HASH_FCN(entry_ptr->addr, cache_ptr->index_nbits)]);
+                entry_ptr->ht_prev = NULL;
+                entry_ptr->ht_next = *bucket;
+                if(*bucket)
+                    (*bucket)->ht_prev = entry_ptr;
+                *bucket = entry_ptr;
+
+                entry_ptr = next_entry_ptr;
+            } /* end while */
+        } /* end for */
+
+        /* Free the old table, once all its buckets have been moved */
+        if(cache_ptr->index_rehash_pos == cache_ptr->old_index_nbuckets) {
+            cache_ptr->old_index = (H5C_cache_entry_t **)H5MM_xfree(cache_ptr->old_index);
+            cache_ptr->old_index_nbuckets = 0;
+            cache_ptr->old_index_nbits = 0;
+            cache_ptr->index_rehash_pos = 0;
+        } /* end if */
+    } /* end if */
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* H5C__index_rehash() */
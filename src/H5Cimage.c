@@ -0,0 +1,594 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * Copyright by the Board of Trustees of the University of Illinois.         *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of HDF5.  The full HDF5 copyright notice, including     *
+ * terms governing use, modification, and redistribution, is contained in    *
+ * the files COPYING and Copyright.html.  COPYING can be found at the root   *
+ * of the source code distribution tree; Copyright.html can be found at the  *
+ * root level of an installed copy of the electronic HDF5 document set and   *
+ * is linked from the top-level documents page.  It can also be found at     *
+ * http://hdfgroup.org/HDF5/doc/Copyright.html.  If you do not have          *
+ * access to either file, you may request a copy from help@hdfgroup.org.     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/*-------------------------------------------------------------------------
+ *
+ * Created:     H5Cimage.c
+ *
+ * Purpose:     Functions in this file implement the metadata cache image:
+ *		a single block, written when a file is closed, that holds
+ *		the on-disk images of the clean entries in the metadata
+ *		cache.  When the file is reopened the block is read with
+ *		one I/O operation, and entries are then loaded from it
+ *		instead of being read individually from the file.
+ *
+ *		The image is laid out as follows:
+ *
+ *		    signature ("MDCI"), version (1 byte),
+ *		    number of entries (4 bytes),
+ *		    for each entry: client type ID (1 byte), address,
+ *			size (4 bytes), on-disk image of the entry,
+ *		    checksum (4 bytes)
+ *
+ *-------------------------------------------------------------------------
+ */
+
+/****************/
+/* Module Setup */
+/****************/
+
+#include "H5Cmodule.h"          /* This source code file is part of the H5C module */
+#define H5F_FRIEND		/*suppress error about including H5Fpkg	  */
+
+
+/***********/
+/* Headers */
+/***********/
+#include "H5private.h"		/* Generic Functions			*/
+#include "H5ACprivate.h"        /* Metadata cache                       */
+#include "H5Cpkg.h"		/* Cache				*/
+#include "H5Eprivate.h"		/* Error handling		  	*/
+#include "H5Fpkg.h"		/* Files				*/
+#include "H5FLprivate.h"	/* Free Lists                           */
+#include "H5MMprivate.h"	/* Memory management			*/
+
+
+/****************/
+/* Local Macros */
+/****************/
+
+/* Cache image signature */
+#define H5C__IMAGE_MAGIC		"MDCI"
+#define H5C__IMAGE_MAGIC_LEN		4
+
+/* Cache image version */
+#define H5C__IMAGE_VERSION_0		0
+
+/* Size of the cache image header and checksum */
+#define H5C__IMAGE_HDR_SIZE		((size_t)(H5C__IMAGE_MAGIC_LEN + 1 + 4))
+#define H5C__IMAGE_CHKSUM_SIZE		((size_t)4)
+
+/* Size of an entry's header in the cache image */
+#define H5C__IMAGE_ENTRY_HDR_SIZE(f)	((size_t)(1 + H5F_SIZEOF_ADDR(f) + 4))
+
+/* Whether a cache entry may be stored in the cache image */
+#define H5C__IMAGE_ENTRY_ELIGIBLE(entry_ptr)                            \
+    ((entry_ptr)->ring == H5C_RING_USER &&                              \
+     !(entry_ptr)->is_dirty && !(entry_ptr)->compressed &&              \
+     (entry_ptr)->image_up_to_date && (entry_ptr)->image_ptr != NULL && \
+     (entry_ptr)->type->id < H5C__MAX_NUM_TYPE_IDS &&                    \
+     (entry_ptr)->size <= H5C_MAX_ENTRY_SIZE &&                         \
+     ((entry_ptr)->type->flags & (H5C__CLASS_COMPRESSED_FLAG |          \
+        H5C__CLASS_NO_IO_FLAG | H5C__CLASS_SKIP_READS |                 \
+        H5C__CLASS_SKIP_WRITES)) == 0)
+
+
+/******************/
+/* Local Typedefs */
+/******************/
+
+
+/********************/
+/* Local Prototypes */
+/********************/
+static size_t H5C__image_encode_list(const H5F_t *f,
+    const H5C_cache_entry_t *head_ptr, uint8_t **pp);
+static herr_t H5C__image_entry_free(void *_item, void *key, void *op_data);
+
+
+/*********************/
+/* Package Variables */
+/*********************/
+
+
+/*****************************/
+/* Library Private Variables */
+/*****************************/
+
+
+/*******************/
+/* Local Variables */
+/*******************/
+
+/* Declare a free list to manage the H5C_image_entry_t struct */
+H5FL_DEFINE_STATIC(H5C_image_entry_t);
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5C__image_encode_list
+ *
+ * Purpose:     Walk a list of cache entries (linked through their next
+ *		pointers), starting at head_ptr, and encode the entries
+ *		that may be stored in the cache image into *pp.
+ *
+ *		If pp is NULL, nothing is encoded and the routine only
+ *		computes the space the entries need.
+ *
+ * Return:      Number of entries encoded (or that would be encoded)
+ *
+ *-------------------------------------------------------------------------
+ */
+static size_t
+H5C__image_encode_list(const H5F_t *f, const H5C_cache_entry_t *head_ptr,
+    uint8_t **pp)
+{
+    const H5C_cache_entry_t *entry_ptr;
+    size_t nentries = 0;
+
+    FUNC_ENTER_STATIC_NOERR
+
+    for(entry_ptr = head_ptr; entry_ptr != NULL; entry_ptr = entry_ptr->next)
+        if(H5C__IMAGE_ENTRY_ELIGIBLE(entry_ptr)) {
+            if(pp) {
+                *(*pp)++ = (uint8_t)entry_ptr->type->id;
+                H5F_addr_encode(f, pp, entry_ptr->addr);
+                UINT32ENCODE(*pp, entry_ptr->size);
+                HDmemcpy(*pp, entry_ptr->image_ptr, entry_ptr->size);
+                *pp += entry_ptr->size;
+            } /* end if */
+
+            nentries++;
+        } /* end if */
+
+    FUNC_LEAVE_NOAPI(nentries)
+} /* H5C__image_encode_list() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5C_get_cache_image
+ *
+ * Purpose:     Construct the cache image for the file's metadata cache,
+ *		from the clean entries in the user ring that have an up to
+ *		date on-disk image.  Pinned entries are stored first,
+ *		followed by the LRU list in most to least recently used
+ *		order.
+ *
+ *		On success, *image_ptr points to a buffer allocated with
+ *		H5MM_malloc() that the caller must free, and *image_len_ptr
+ *		holds its size.  If no entry can be stored, *image_ptr is
+ *		set to NULL and *image_len_ptr to zero.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5C_get_cache_image(const H5F_t *f, void **image_ptr, size_t *image_len_ptr)
+{
+    H5C_t *cache_ptr;                   /* Pointer to cache */
+    const H5C_cache_entry_t *entry_ptr; /* Pointer to cache entry */
+    uint8_t *image = NULL;              /* Cache image buffer */
+    uint8_t *p;                         /* Pointer into cache image */
+    size_t image_len;                   /* Size of cache image */
+    size_t nentries;                    /* Number of entries in cache image */
+    uint32_t chksum;                    /* Checksum of cache image */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    /* Sanity checks */
+    HDassert(f);
+    HDassert(f->shared);
+    cache_ptr = f->shared->cache;
+    HDassert(cache_ptr);
+    HDassert(cache_ptr->magic == H5C__H5C_T_MAGIC);
+    HDassert(image_ptr);
+    HDassert(image_len_ptr);
+
+    *image_ptr = NULL;
+    *image_len_ptr = 0;
+
+    /* Compute the size of the image */
+    nentries = H5C__image_encode_list(f, cache_ptr->pel_head_ptr, NULL)
+            + H5C__image_encode_list(f, cache_ptr->LRU_head_ptr, NULL);
+    if(nentries == 0)
+        HGOTO_DONE(SUCCEED)
+    if(nentries > (size_t)UINT32_MAX)
+        HGOTO_ERROR(H5E_CACHE, H5E_BADVALUE, FAIL, "too many entries for cache image")
+
+    image_len = H5C__IMAGE_HDR_SIZE + H5C__IMAGE_CHKSUM_SIZE
+            + (nentries * H5C__IMAGE_ENTRY_HDR_SIZE(f));
+    for(entry_ptr = cache_ptr->pel_head_ptr; entry_ptr != NULL; entry_ptr = entry_ptr->next)
+        if(H5C__IMAGE_ENTRY_ELIGIBLE(entry_ptr))
+            image_len += entry_ptr->size;
+    for(entry_ptr = cache_ptr->LRU_head_ptr; entry_ptr != NULL; entry_ptr = entry_ptr->next)
+        if(H5C__IMAGE_ENTRY_ELIGIBLE(entry_ptr))
+            image_len += entry_ptr->size;
+
+    if(NULL == (image = (uint8_t *)H5MM_malloc(image_len)))
+        HGOTO_ERROR(H5E_CACHE, H5E_CANTALLOC, FAIL, "memory allocation failed for cache image")
+
+    /* Encode the header */
+    p = image;
+    HDmemcpy(p, H5C__IMAGE_MAGIC, (size_t)H5C__IMAGE_MAGIC_LEN);
+    p += H5C__IMAGE_MAGIC_LEN;
+    *p++ = H5C__IMAGE_VERSION_0;
+    UINT32ENCODE(p, nentries);
+
+    /* Encode the entries */
+    H5C__image_encode_list(f, cache_ptr->pel_head_ptr, &p);
+    H5C__image_encode_list(f, cache_ptr->LRU_head_ptr, &p);
+
+    /* Compute and encode the checksum */
+    chksum = H5_checksum_metadata(image, (size_t)(p - image), 0);
+    UINT32ENCODE(p, chksum);
+    HDassert((size_t)(p - image) == image_len);
+
+    /* Set the return values */
+    *image_ptr = image;
+    *image_len_ptr = image_len;
+    image = NULL;
+
+done:
+    if(image)
+        image = (uint8_t *)H5MM_xfree(image);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5C_get_cache_image() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5C_load_cache_image
+ *
+ * Purpose:     Read the cache image of len bytes at addr in the file and
+ *		index its entries by address, so that H5C_load_entry()
+ *		can load them from the image instead of from the file.
+ *
+ *		The entries are not inserted in the cache at this point.
+ *		Each entry is taken out of the image when it is first
+ *		loaded, and the image is discarded once all of its entries
+ *		have been loaded or invalidated.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5C_load_cache_image(H5F_t *f, hid_t dxpl_id, haddr_t addr, size_t len)
+{
+    H5C_t *cache_ptr;                   /* Pointer to cache */
+    H5C_image_entry_t *ent = NULL;      /* Cache image entry */
+    const uint8_t *p;                   /* Pointer into cache image */
+    const uint8_t *p_end;               /* End of the entries in the cache image */
+    uint8_t *image = NULL;              /* Cache image buffer */
+    uint32_t nentries;                  /* Number of entries in cache image */
+    uint32_t stored_chksum;             /* Stored checksum of cache image */
+    uint32_t computed_chksum;           /* Computed checksum of cache image */
+    uint32_t u;                         /* Local index variable */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    /* Sanity checks */
+    HDassert(f);
+    HDassert(f->shared);
+    cache_ptr = f->shared->cache;
+    HDassert(cache_ptr);
+    HDassert(cache_ptr->magic == H5C__H5C_T_MAGIC);
+    HDassert(cache_ptr->image_slist_ptr == NULL);
+    HDassert(H5F_addr_defined(addr));
+
+    if(len < H5C__IMAGE_HDR_SIZE + H5C__IMAGE_CHKSUM_SIZE)
+        HGOTO_ERROR(H5E_CACHE, H5E_BADVALUE, FAIL, "cache image is too small")
+
+    /* Read the image */
+    if(NULL == (image = (uint8_t *)H5MM_malloc(len)))
+        HGOTO_ERROR(H5E_CACHE, H5E_CANTALLOC, FAIL, "memory allocation failed for cache image")
+    if(H5F_block_read(f, H5FD_MEM_SUPER, addr, len, dxpl_id, image) < 0)
+        HGOTO_ERROR(H5E_CACHE, H5E_READERROR, FAIL, "can't read cache image")
+
+    /* Verify the header and checksum */
+    p = image;
+    if(HDmemcmp(p, H5C__IMAGE_MAGIC, (size_t)H5C__IMAGE_MAGIC_LEN))
+        HGOTO_ERROR(H5E_CACHE, H5E_BADVALUE, FAIL, "bad cache image signature")
+    p += H5C__IMAGE_MAGIC_LEN;
+    if(*p++ != H5C__IMAGE_VERSION_0)
+        HGOTO_ERROR(H5E_CACHE, H5E_BADVALUE, FAIL, "bad cache image version")
+    UINT32DECODE(p, nentries);
+
+    p_end = image + len - H5C__IMAGE_CHKSUM_SIZE;
+    computed_chksum = H5_checksum_metadata(image, (size_t)(p_end - image), 0);
+    UINT32DECODE(p_end, stored_chksum);
+    if(stored_chksum != computed_chksum)
+        HGOTO_ERROR(H5E_CACHE, H5E_BADVALUE, FAIL, "incorrect metadata checksum for cache image")
+    p_end = image + len - H5C__IMAGE_CHKSUM_SIZE;
+
+    /* Index the entries */
+    cache_ptr->image_buf = image;
+    image = NULL;
+    if(NULL == (cache_ptr->image_slist_ptr = H5SL_create(H5SL_TYPE_HADDR, NULL)))
+        HGOTO_ERROR(H5E_CACHE, H5E_CANTCREATE, FAIL, "can't create skip list for cache image")
+
+    for(u = 0; u < nentries; u++) {
+        uint32_t size;
+
+        if((size_t)(p_end - p) < H5C__IMAGE_ENTRY_HDR_SIZE(f))
+            HGOTO_ERROR(H5E_CACHE, H5E_CANTDECODE, FAIL, "cache image is truncated")
+
+        if(NULL == (ent = H5FL_MALLOC(H5C_image_entry_t)))
+            HGOTO_ERROR(H5E_CACHE, H5E_CANTALLOC, FAIL, "memory allocation failed for cache image entry")
+        ent->type_id = (int32_t)*p++;
+        H5F_addr_decode(f, &p, &ent->addr);
+        UINT32DECODE(p, size);
+        ent->size = (size_t)size;
+        ent->image_ptr = p;
+        ent->used = FALSE;
+
+        if(!H5F_addr_defined(ent->addr) || ent->size == 0 || (size_t)(p_end - p) < ent->size)
+            HGOTO_ERROR(H5E_CACHE, H5E_CANTDECODE, FAIL, "bad entry in cache image")
+        p += ent->size;
+
+        if(H5SL_insert(cache_ptr->image_slist_ptr, ent, &ent->addr) < 0)
+            HGOTO_ERROR(H5E_CACHE, H5E_CANTINSERT, FAIL, "can't insert entry in cache image skip list")
+        ent = NULL;
+    } /* end for */
+
+    cache_ptr->image_entries = (unsigned)nentries;
+    cache_ptr->image_hits = 0;
+
+done:
+    if(ent)
+        ent = H5FL_FREE(H5C_image_entry_t, ent);
+    if(image)
+        image = (uint8_t *)H5MM_xfree(image);
+    if(ret_value < 0 && cache_ptr)
+        if(H5C__image_dest(cache_ptr) < 0)
+            HDONE_ERROR(H5E_CACHE, H5E_CANTFREE, FAIL, "can't discard cache image")
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5C_load_cache_image() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5C__image_read
+ *
+ * Purpose:     Read the on-disk image of an entry, of len bytes at addr,
+ *		into the supplied buffer.  The image is copied from the
+ *		cache image when it holds an entry of the same type at
+ *		that address, and read from the file otherwise.
+ *
+ *		Speculative loads may ask for more than the size of the
+ *		entry; the bytes past the end of the entry are zeroed.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5C__image_read(const H5F_t *f, hid_t dxpl_id, const H5C_class_t *type,
+    haddr_t addr, size_t len, void *image)
+{
+    H5C_t *cache_ptr;                   /* Pointer to cache */
+    H5C_image_entry_t *ent = NULL;      /* Cache image entry */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    /* Sanity checks */
+    HDassert(f);
+    HDassert(f->shared);
+    cache_ptr = f->shared->cache;
+    HDassert(cache_ptr);
+    HDassert(type);
+    HDassert(image);
+
+    if(cache_ptr->image_slist_ptr)
+        ent = (H5C_image_entry_t *)H5SL_search(cache_ptr->image_slist_ptr, &addr);
+
+    if(ent && ent->type_id == type->id &&
+            (len <= ent->size || (type->flags & H5C__CLASS_SPECULATIVE_LOAD_FLAG))) {
+        size_t copy_len = MIN(len, ent->size);
+
+        HDmemcpy(image, ent->image_ptr, copy_len);
+        if(copy_len < len)
+            HDmemset((uint8_t *)image + copy_len, 0, len - copy_len);
+        ent->used = TRUE;
+    } /* end if */
+    else
+        if(H5F_block_read(f, type->mem_type, addr, len, dxpl_id, image) < 0)
+            HGOTO_ERROR(H5E_CACHE, H5E_READERROR, FAIL, "can't read entry image")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5C__image_read() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5C__image_entry_loaded
+ *
+ * Purpose:     Take the entry at addr, which has just been loaded into
+ *		the cache, out of the cache image.  The cache image is
+ *		discarded once it has no entries left.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5C__image_entry_loaded(H5C_t *cache_ptr, haddr_t addr)
+{
+    H5C_image_entry_t *ent;             /* Cache image entry */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    /* Sanity checks */
+    HDassert(cache_ptr);
+    HDassert(cache_ptr->image_slist_ptr);
+
+    if(NULL != (ent = (H5C_image_entry_t *)H5SL_remove(cache_ptr->image_slist_ptr, &addr))) {
+        if(ent->used)
+            cache_ptr->image_hits++;
+        ent = H5FL_FREE(H5C_image_entry_t, ent);
+
+        if(H5SL_count(cache_ptr->image_slist_ptr) == 0)
+            if(H5C__image_dest(cache_ptr) < 0)
+                HGOTO_ERROR(H5E_CACHE, H5E_CANTFREE, FAIL, "can't discard cache image")
+    } /* end if */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5C__image_entry_loaded() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5C_invalidate_cache_image
+ *
+ * Purpose:     Remove the entries of the cache image that overlap the
+ *		size bytes at addr, which are about to be overwritten in
+ *		the file.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5C_invalidate_cache_image(H5C_t *cache_ptr, haddr_t addr, size_t size)
+{
+    H5SL_node_t *node;                  /* Skip list node */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    /* Sanity checks */
+    HDassert(cache_ptr);
+    HDassert(cache_ptr->magic == H5C__H5C_T_MAGIC);
+
+    if(NULL == cache_ptr->image_slist_ptr)
+        HGOTO_DONE(SUCCEED)
+
+    /* Start from the last entry at or before addr, which may overlap it */
+    if(NULL == (node = H5SL_below(cache_ptr->image_slist_ptr, &addr)))
+        node = H5SL_first(cache_ptr->image_slist_ptr);
+
+    while(node) {
+        H5C_image_entry_t *ent = (H5C_image_entry_t *)H5SL_item(node);
+
+        if(H5F_addr_ge(ent->addr, addr + size))
+            break;
+        node = H5SL_next(node);
+
+        if(H5F_addr_gt(ent->addr + ent->size, addr)) {
+            if(NULL == H5SL_remove(cache_ptr->image_slist_ptr, &ent->addr))
+                HGOTO_ERROR(H5E_CACHE, H5E_CANTREMOVE, FAIL, "can't remove entry from cache image")
+            ent = H5FL_FREE(H5C_image_entry_t, ent);
+        } /* end if */
+    } /* end while */
+
+    if(H5SL_count(cache_ptr->image_slist_ptr) == 0)
+        if(H5C__image_dest(cache_ptr) < 0)
+            HGOTO_ERROR(H5E_CACHE, H5E_CANTFREE, FAIL, "can't discard cache image")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5C_invalidate_cache_image() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5C_get_cache_image_stats
+ *
+ * Purpose:     Retrieve the number of entries in the cache image that was
+ *		loaded when the file was opened, and the number of them
+ *		that have been loaded into the cache from the image.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5C_get_cache_image_stats(const H5C_t *cache_ptr, unsigned *nentries_ptr,
+    unsigned *nhits_ptr)
+{
+    FUNC_ENTER_NOAPI_NOERR
+
+    /* Sanity checks */
+    HDassert(cache_ptr);
+    HDassert(cache_ptr->magic == H5C__H5C_T_MAGIC);
+
+    if(nentries_ptr)
+        *nentries_ptr = cache_ptr->image_entries;
+    if(nhits_ptr)
+        *nhits_ptr = cache_ptr->image_hits;
+
+    FUNC_LEAVE_NOAPI(SUCCEED)
+} /* H5C_get_cache_image_stats() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5C__image_entry_free
+ *
+ * Purpose:     Skip list callback to free a cache image entry.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5C__image_entry_free(void *_item, void H5_ATTR_UNUSED *key, void H5_ATTR_UNUSED *op_data)
+{
+    H5C_image_entry_t *ent = (H5C_image_entry_t *)_item;
+
+    FUNC_ENTER_STATIC_NOERR
+
+    /* Sanity check */
+    HDassert(ent);
+
+    ent = H5FL_FREE(H5C_image_entry_t, ent);
+
+    FUNC_LEAVE_NOAPI(SUCCEED)
+} /* H5C__image_entry_free() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5C__image_dest
+ *
+ * Purpose:     Discard the cache image, if any.  The statistics on its
+ *		use are kept.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5C__image_dest(H5C_t *cache_ptr)
+{
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    /* Sanity check */
+    HDassert(cache_ptr);
+
+    if(cache_ptr->image_slist_ptr) {
+        if(H5SL_destroy(cache_ptr->image_slist_ptr, H5C__image_entry_free, NULL) < 0)
+            HGOTO_ERROR(H5E_CACHE, H5E_CANTCLOSEOBJ, FAIL, "can't destroy cache image skip list")
+        cache_ptr->image_slist_ptr = NULL;
+    } /* end if */
+    cache_ptr->image_buf = H5MM_xfree(cache_ptr->image_buf);
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5C__image_dest() */
@@ -58,7 +58,13 @@
 #define H5C__MAX_PASSES_ON_FLUSH	4
 
 /* Cache configuration settings */
-#define H5C__HASH_TABLE_LEN     (64 * 1024) /* must be a power of 2 */
+#define H5C__HASH_TABLE_MIN_BITS 10     /* log2 of initial # of hash buckets */
+#define H5C__HASH_TABLE_MAX_BITS 40     /* log2 of max # of hash buckets */
+#define H5C__HASH_REHASH_STEP   16      /* # of buckets moved per index insert
+                                         * or delete while the index grows */
+#define H5C__FLUSH_WRITE_LIST_MAX_SIZE (4 * 1024 * 1024)
+                                        /* max bytes of entry images queued
+                                         * by a flush before they are written */
 #define H5C__H5C_T_MAGIC	0x005CAC0E
 
 /****************************************************************************
@@ -559,15 +565,30 @@ if ( ( (entry_ptr) == NULL ) ||                                                \
 #define H5C__UPDATE_STATS_FOR_HT_DELETION(cache_ptr) \
 	(cache_ptr)->total_ht_deletions++;
 
-#define H5C__UPDATE_STATS_FOR_HT_SEARCH(cache_ptr, success, depth)  \
-	if ( success ) {                                            \
-	    (cache_ptr)->successful_ht_searches++;                  \
-	    (cache_ptr)->total_successful_ht_search_depth += depth; \
-	} else {                                                    \
-	    (cache_ptr)->failed_ht_searches++;                      \
-	    (cache_ptr)->total_failed_ht_search_depth += depth;     \
+#define H5C__UPDATE_STATS_FOR_HT_SEARCH(cache_ptr, entry_ptr, depth)     \
+	if ( entry_ptr ) {                                               \
+	    (cache_ptr)->successful_ht_searches++;                       \
+	    (cache_ptr)->total_successful_ht_search_depth += depth;      \
+	    ((cache_ptr)->successful_ht_searches_by_type                 \
+	     [(entry_ptr)->type->id])++;                                 \
+	    ((cache_ptr)->total_ht_search_depth_by_type                  \
+	     [(entry_ptr)->type->id]) += depth;                          \
+	    if ( (depth) > ((cache_ptr)->max_ht_search_depth_by_type     \
+	                    [(entry_ptr)->type->id]) )                   \
+	        ((cache_ptr)->max_ht_search_depth_by_type                \
+	         [(entry_ptr)->type->id]) = (depth);                     \
+	} else {                                                         \
+	    (cache_ptr)->failed_ht_searches++;                           \
+	    (cache_ptr)->total_failed_ht_search_depth += depth;          \
 	}
 
+#define H5C__UPDATE_STATS_FOR_INDEX_RESIZE(cache_ptr) \
+	((cache_ptr)->index_resizes)++;
+
+#define H5C__UPDATE_STATS_FOR_FLUSH_WRITE(cache_ptr, nimages) \
+	(cache_ptr)->flush_write_images += (int64_t)(nimages);  \
+	((cache_ptr)->flush_writes)++;
+
 #define H5C__UPDATE_STATS_FOR_UNPIN(cache_ptr, entry_ptr) \
 	((cache_ptr)->unpins)[(entry_ptr)->type->id]++;
 
@@ -577,8 +598,8 @@ if ( ( (entry_ptr) == NULL ) ||                                                \
 #define H5C__UPDATE_STATS_FOR_LRU_SCAN_RESTART(cache_ptr) \
 	((cache_ptr)->LRU_scan_restarts)++;
 
-#define H5C__UPDATE_STATS_FOR_HASH_BUCKET_SCAN_RESTART(cache_ptr) \
-	((cache_ptr)->hash_bucket_scan_restarts)++;
+#define H5C__UPDATE_STATS_FOR_INDEX_SCAN_RESTART(cache_ptr) \
+	((cache_ptr)->index_scan_restarts)++;
 
 #if H5C_COLLECT_CACHE_ENTRY_STATS
 
@@ -791,7 +812,9 @@ if ( ( (entry_ptr) == NULL ) ||                                                \
 #define H5C__UPDATE_STATS_FOR_ENTRY_SIZE_CHANGE(cache_ptr, entry_ptr, new_size)
 #define H5C__UPDATE_STATS_FOR_HT_INSERTION(cache_ptr)
 #define H5C__UPDATE_STATS_FOR_HT_DELETION(cache_ptr)
-#define H5C__UPDATE_STATS_FOR_HT_SEARCH(cache_ptr, success, depth)
+#define H5C__UPDATE_STATS_FOR_HT_SEARCH(cache_ptr, entry_ptr, depth)
+#define H5C__UPDATE_STATS_FOR_INDEX_RESIZE(cache_ptr)
+#define H5C__UPDATE_STATS_FOR_FLUSH_WRITE(cache_ptr, nimages)
 #define H5C__UPDATE_STATS_FOR_INSERTION(cache_ptr, entry_ptr)
 #define H5C__UPDATE_STATS_FOR_CLEAR(cache_ptr, entry_ptr)
 #define H5C__UPDATE_STATS_FOR_FLUSH(cache_ptr, entry_ptr)
@@ -801,7 +824,7 @@ if ( ( (entry_ptr) == NULL ) ||                                                \
 #define H5C__UPDATE_STATS_FOR_UNPIN(cache_ptr, entry_ptr)
 #define H5C__UPDATE_STATS_FOR_SLIST_SCAN_RESTART(cache_ptr)
 #define H5C__UPDATE_STATS_FOR_LRU_SCAN_RESTART(cache_ptr)
-#define H5C__UPDATE_STATS_FOR_HASH_BUCKET_SCAN_RESTART(cache_ptr)
+#define H5C__UPDATE_STATS_FOR_INDEX_SCAN_RESTART(cache_ptr)
 
 #endif /* H5C_COLLECT_CACHE_STATS */
 
@@ -832,11 +855,37 @@ if ( ( (entry_ptr) == NULL ) ||                                                \
  *
  ***********************************************************************/
 
-/* H5C__HASH_TABLE_LEN is defined in H5Cpkg.h.  It mut be a power of two. */
+/* The hash function multiplies the address by 2^64 divided by the golden
+ * ratio and keeps the top nbits bits of the product (Fibonacci hashing), so
+ * that every bit of the address contributes to the bucket index.  Addresses
+ * that only differ in their high bits, or that share their low bits, are
+ * spread over the whole table.
+ */
+#define H5C__HASH_MULT		((((uint64_t)0x9E3779B9) << 32) |         \
+                                 (uint64_t)0x7F4A7C15)
 
-#define H5C__HASH_MASK		((size_t)(H5C__HASH_TABLE_LEN - 1) << 3)
+#define H5C__HASH_FCN(x, nbits)	                                          \
+    ((size_t)(((uint64_t)(x) * H5C__HASH_MULT) >> (64 - (nbits))))
 
-#define H5C__HASH_FCN(x)	(int)((unsigned)((x) & H5C__HASH_MASK) >> 3)
+/* While the index is being resized, the buckets of the old hash table
+ * below index_rehash_pos have already been moved to the new table.
+ * H5C__INDEX_BUCKET() returns a pointer to the head of the bucket that
+ * holds (or would hold) the entry at Addr, in whichever table that is.
+ */
+#define H5C__INDEX_BUCKET(cache_ptr, Addr)                                \
+    ( ( ( (cache_ptr)->old_index != NULL ) &&                             \
+        ( H5C__HASH_FCN((Addr), (cache_ptr)->old_index_nbits) >=          \
+          (cache_ptr)->index_rehash_pos ) ) ?                             \
+      &(((cache_ptr)->old_index)[H5C__HASH_FCN((Addr),                    \
+                                      (cache_ptr)->old_index_nbits)]) :   \
+      &(((cache_ptr)->index)[H5C__HASH_FCN((Addr),                        \
+                                      (cache_ptr)->index_nbits)]) )
+
+/* Grow the index when it holds more entries than it has buckets */
+#define H5C__INDEX_NEEDS_GROW(cache_ptr)                                  \
+    ( ( (cache_ptr)->old_index == NULL ) &&                               \
+      ( (size_t)((cache_ptr)->index_len) > (cache_ptr)->index_nbuckets ) && \
+      ( (cache_ptr)->index_nbits < H5C__HASH_TABLE_MAX_BITS ) )
 
 #if H5C_DO_SANITY_CHECKS
 
@@ -847,9 +896,10 @@ if ( ( (cache_ptr) == NULL ) ||                                         \
      ( ! H5F_addr_defined((entry_ptr)->addr) ) ||                       \
      ( (entry_ptr)->ht_next != NULL ) ||                                \
      ( (entry_ptr)->ht_prev != NULL ) ||                                \
+     ( (entry_ptr)->il_next != NULL ) ||                                \
+     ( (entry_ptr)->il_prev != NULL ) ||                                \
      ( (entry_ptr)->size <= 0 ) ||                                      \
-     ( H5C__HASH_FCN((entry_ptr)->addr) < 0 ) ||                        \
-     ( H5C__HASH_FCN((entry_ptr)->addr) >= H5C__HASH_TABLE_LEN ) ||     \
+     ( (cache_ptr)->index == NULL ) ||                                  \
      ( (cache_ptr)->index_size !=                                       \
        ((cache_ptr)->clean_index_size +                                 \
 	(cache_ptr)->dirty_index_size) ) ||                             \
@@ -898,16 +948,17 @@ if ( ( (cache_ptr) == NULL ) ||                                         \
      ( (cache_ptr)->index_size < (entry_ptr)->size ) ||                 \
      ( ! H5F_addr_defined((entry_ptr)->addr) ) ||                       \
      ( (entry_ptr)->size <= 0 ) ||                                      \
-     ( H5C__HASH_FCN((entry_ptr)->addr) < 0 ) ||                        \
-     ( H5C__HASH_FCN((entry_ptr)->addr) >= H5C__HASH_TABLE_LEN ) ||     \
-     ( ((cache_ptr)->index)[(H5C__HASH_FCN((entry_ptr)->addr))]         \
-       == NULL ) ||                                                     \
-     ( ( ((cache_ptr)->index)[(H5C__HASH_FCN((entry_ptr)->addr))]       \
+     ( *H5C__INDEX_BUCKET(cache_ptr, (entry_ptr)->addr) == NULL ) ||    \
+     ( ( *H5C__INDEX_BUCKET(cache_ptr, (entry_ptr)->addr)               \
        != (entry_ptr) ) &&                                              \
        ( (entry_ptr)->ht_prev == NULL ) ) ||                            \
-     ( ( ((cache_ptr)->index)[(H5C__HASH_FCN((entry_ptr)->addr))] ==    \
+     ( ( *H5C__INDEX_BUCKET(cache_ptr, (entry_ptr)->addr) ==            \
          (entry_ptr) ) &&                                               \
        ( (entry_ptr)->ht_prev != NULL ) ) ||                            \
+     ( ( (entry_ptr)->il_prev == NULL ) &&                              \
+       ( (cache_ptr)->il_head != (entry_ptr) ) ) ||                     \
+     ( ( (entry_ptr)->il_next == NULL ) &&                              \
+       ( (cache_ptr)->il_tail != (entry_ptr) ) ) ||                     \
      ( (cache_ptr)->index_size !=                                       \
        ((cache_ptr)->clean_index_size +                                 \
 	(cache_ptr)->dirty_index_size) ) ||                             \
@@ -935,8 +986,10 @@ if ( ( (cache_ptr) == NULL ) ||                                          \
      ( (entry_ptr) == NULL ) ||                                          \
      ( ! H5F_addr_defined((entry_ptr)->addr) ) ||                        \
      ( (entry_ptr)->size <= 0 ) ||                                       \
+     ( (entry_ptr)->ht_next != NULL ) ||                                 \
      ( (entry_ptr)->ht_prev != NULL ) ||                                 \
-     ( (entry_ptr)->ht_prev != NULL ) ||                                 \
+     ( (entry_ptr)->il_next != NULL ) ||                                 \
+     ( (entry_ptr)->il_prev != NULL ) ||                                 \
      ( (cache_ptr)->index_size !=                                        \
        ((cache_ptr)->clean_index_size +                                  \
 	(cache_ptr)->dirty_index_size) ) ||                              \
@@ -959,14 +1012,13 @@ if ( ( (cache_ptr) == NULL ) ||                                             \
      ( (cache_ptr)->magic != H5C__H5C_T_MAGIC ) ||                          \
      ( (cache_ptr)->index_size !=                                           \
        ((cache_ptr)->clean_index_size + (cache_ptr)->dirty_index_size) ) || \
-     ( ! H5F_addr_defined(Addr) ) ||                                        \
-     ( H5C__HASH_FCN(Addr) < 0 ) ||                                         \
-     ( H5C__HASH_FCN(Addr) >= H5C__HASH_TABLE_LEN ) ) {                     \
+     ( (cache_ptr)->index == NULL ) ||                                      \
+     ( ! H5F_addr_defined(Addr) ) ) {                                       \
     HGOTO_ERROR(H5E_CACHE, H5E_SYSTEM, fail_val, "Pre HT search SC failed") \
 }
 
 /* (Keep in sync w/H5C_TEST__POST_SUC_HT_SEARCH_SC macro in test/cache_common.h -QAK) */
-#define H5C__POST_SUC_HT_SEARCH_SC(cache_ptr, entry_ptr, Addr, k, fail_val) \
+#define H5C__POST_SUC_HT_SEARCH_SC(cache_ptr, entry_ptr, Addr, bucket, fail_val) \
 if ( ( (cache_ptr) == NULL ) ||                                             \
      ( (cache_ptr)->magic != H5C__H5C_T_MAGIC ) ||                          \
      ( (cache_ptr)->index_len < 1 ) ||                                      \
@@ -976,10 +1028,10 @@ if ( ( (cache_ptr) == NULL ) ||                                             \
        ((cache_ptr)->clean_index_size + (cache_ptr)->dirty_index_size) ) || \
      ( H5F_addr_ne((entry_ptr)->addr, (Addr)) ) ||                          \
      ( (entry_ptr)->size <= 0 ) ||                                          \
-     ( ((cache_ptr)->index)[k] == NULL ) ||                                 \
-     ( ( ((cache_ptr)->index)[k] != (entry_ptr) ) &&                        \
+     ( *(bucket) == NULL ) ||                                               \
+     ( ( *(bucket) != (entry_ptr) ) &&                                      \
        ( (entry_ptr)->ht_prev == NULL ) ) ||                                \
-     ( ( ((cache_ptr)->index)[k] == (entry_ptr) ) &&                        \
+     ( ( *(bucket) == (entry_ptr) ) &&                                      \
        ( (entry_ptr)->ht_prev != NULL ) ) ||                                \
      ( ( (entry_ptr)->ht_prev != NULL ) &&                                  \
        ( (entry_ptr)->ht_prev->ht_next != (entry_ptr) ) ) ||                \
@@ -990,9 +1042,9 @@ if ( ( (cache_ptr) == NULL ) ||                                             \
 }
 
 /* (Keep in sync w/H5C_TEST__POST_HT_SHIFT_TO_FRONT macro in test/cache_common.h -QAK) */
-#define H5C__POST_HT_SHIFT_TO_FRONT(cache_ptr, entry_ptr, k, fail_val) \
+#define H5C__POST_HT_SHIFT_TO_FRONT(cache_ptr, entry_ptr, bucket, fail_val) \
 if ( ( (cache_ptr) == NULL ) ||                                        \
-     ( ((cache_ptr)->index)[k] != (entry_ptr) ) ||                     \
+     ( *(bucket) != (entry_ptr) ) ||                                   \
      ( (entry_ptr)->ht_prev != NULL ) ) {                              \
     HGOTO_ERROR(H5E_CACHE, H5E_SYSTEM, fail_val,                       \
                 "Post HT shift to front SC failed")                    \
@@ -1159,8 +1211,8 @@ if ( ( (cache_ptr)->index_size !=                                           \
 #define H5C__PRE_HT_REMOVE_SC(cache_ptr, entry_ptr)
 #define H5C__POST_HT_REMOVE_SC(cache_ptr, entry_ptr)
 #define H5C__PRE_HT_SEARCH_SC(cache_ptr, Addr, fail_val)
-#define H5C__POST_SUC_HT_SEARCH_SC(cache_ptr, entry_ptr, Addr, k, fail_val)
-#define H5C__POST_HT_SHIFT_TO_FRONT(cache_ptr, entry_ptr, k, fail_val)
+#define H5C__POST_SUC_HT_SEARCH_SC(cache_ptr, entry_ptr, Addr, bucket, fail_val)
+#define H5C__POST_HT_SHIFT_TO_FRONT(cache_ptr, entry_ptr, bucket, fail_val)
 #define H5C__PRE_HT_UPDATE_FOR_ENTRY_CLEAN_SC(cache_ptr, entry_ptr)
 #define H5C__PRE_HT_UPDATE_FOR_ENTRY_DIRTY_SC(cache_ptr, entry_ptr)
 #define H5C__PRE_HT_ENTRY_SIZE_CHANGE_SC(cache_ptr, old_size, new_size, \
@@ -1173,18 +1225,52 @@ if ( ( (cache_ptr)->index_size !=                                           \
 #endif /* H5C_DO_SANITY_CHECKS */
 
 
+/* The index list (il) is a doubly linked list of all entries in the index,
+ * threaded through the il_next and il_prev fields, in insertion order.
+ * Scans of the whole cache walk it instead of the hash buckets.
+ */
+#define H5C__IL_DLL_APPEND(entry_ptr, head_ptr, tail_ptr)    \
+{                                                            \
+    if ( (head_ptr) == NULL ) {                              \
+       (head_ptr) = (entry_ptr);                             \
+       (tail_ptr) = (entry_ptr);                             \
+    } else {                                                 \
+       (tail_ptr)->il_next = (entry_ptr);                    \
+       (entry_ptr)->il_prev = (tail_ptr);                    \
+       (tail_ptr) = (entry_ptr);                             \
+    }                                                        \
+} /* H5C__IL_DLL_APPEND() */
+
+#define H5C__IL_DLL_REMOVE(entry_ptr, head_ptr, tail_ptr)    \
+{                                                            \
+    if ( (head_ptr) == (entry_ptr) ) {                       \
+       (head_ptr) = (entry_ptr)->il_next;                    \
+       if ( (head_ptr) != NULL )                             \
+          (head_ptr)->il_prev = NULL;                        \
+    } else                                                   \
+       (entry_ptr)->il_prev->il_next = (entry_ptr)->il_next; \
+    if ( (tail_ptr) == (entry_ptr) ) {                       \
+       (tail_ptr) = (entry_ptr)->il_prev;                    \
+       if ( (tail_ptr) != NULL )                             \
+          (tail_ptr)->il_next = NULL;                        \
+    } else                                                   \
+       (entry_ptr)->il_next->il_prev = (entry_ptr)->il_prev; \
+    (entry_ptr)->il_next = NULL;                             \
+    (entry_ptr)->il_prev = NULL;                             \
+} /* H5C__IL_DLL_REMOVE() */
+
 #define H5C__INSERT_IN_INDEX(cache_ptr, entry_ptr, fail_val)  \
 {                                                             \
-    int k;                                                    \
+    H5C_cache_entry_t **bucket;                               \
     H5C__PRE_HT_INSERT_SC(cache_ptr, entry_ptr, fail_val)     \
-    k = H5C__HASH_FCN((entry_ptr)->addr);                     \
-    if ( ((cache_ptr)->index)[k] == NULL )                    \
-        ((cache_ptr)->index)[k] = (entry_ptr);                \
-    else {                                                    \
-        (entry_ptr)->ht_next = ((cache_ptr)->index)[k];       \
+    bucket = H5C__INDEX_BUCKET(cache_ptr, (entry_ptr)->addr); \
+    if ( *bucket != NULL ) {                                  \
+        (entry_ptr)->ht_next = *bucket;                       \
         (entry_ptr)->ht_next->ht_prev = (entry_ptr);          \
-        ((cache_ptr)->index)[k] = (entry_ptr);                \
     }                                                         \
+    *bucket = (entry_ptr);                                    \
+    H5C__IL_DLL_APPEND((entry_ptr), (cache_ptr)->il_head,     \
+                       (cache_ptr)->il_tail)                  \
     (cache_ptr)->index_len++;                                 \
     (cache_ptr)->index_size += (entry_ptr)->size;             \
     ((cache_ptr)->index_ring_len[entry_ptr->ring])++;         \
@@ -1205,21 +1291,26 @@ if ( ( (cache_ptr)->index_size !=                                           \
     }                                                         \
     H5C__UPDATE_STATS_FOR_HT_INSERTION(cache_ptr)             \
     H5C__POST_HT_INSERT_SC(cache_ptr, fail_val)               \
+    if ( ( (cache_ptr)->old_index != NULL ) ||                \
+         ( H5C__INDEX_NEEDS_GROW(cache_ptr) ) )               \
+        H5C__index_rehash(cache_ptr);                         \
 }
 
 #define H5C__DELETE_FROM_INDEX(cache_ptr, entry_ptr)          \
 {                                                             \
-    int k;                                                    \
+    H5C_cache_entry_t **bucket;                               \
     H5C__PRE_HT_REMOVE_SC(cache_ptr, entry_ptr)               \
-    k = H5C__HASH_FCN((entry_ptr)->addr);                     \
+    bucket = H5C__INDEX_BUCKET(cache_ptr, (entry_ptr)->addr); \
     if ( (entry_ptr)->ht_next )                               \
         (entry_ptr)->ht_next->ht_prev = (entry_ptr)->ht_prev; \
     if ( (entry_ptr)->ht_prev )                               \
         (entry_ptr)->ht_prev->ht_next = (entry_ptr)->ht_next; \
-    if ( ((cache_ptr)->index)[k] == (entry_ptr) )             \
-        ((cache_ptr)->index)[k] = (entry_ptr)->ht_next;       \
+    if ( *bucket == (entry_ptr) )                             \
+        *bucket = (entry_ptr)->ht_next;                       \
     (entry_ptr)->ht_next = NULL;                              \
     (entry_ptr)->ht_prev = NULL;                              \
+    H5C__IL_DLL_REMOVE((entry_ptr), (cache_ptr)->il_head,     \
+                       (cache_ptr)->il_tail)                  \
     (cache_ptr)->index_len--;                                 \
     (cache_ptr)->index_size -= (entry_ptr)->size;             \
     ((cache_ptr)->index_ring_len[entry_ptr->ring])--;         \
@@ -1240,61 +1331,60 @@ if ( ( (cache_ptr)->index_size !=                                           \
     }                                                         \
     H5C__UPDATE_STATS_FOR_HT_DELETION(cache_ptr)              \
     H5C__POST_HT_REMOVE_SC(cache_ptr, entry_ptr)              \
+    if ( (cache_ptr)->old_index != NULL )                     \
+        H5C__index_rehash(cache_ptr);                         \
 }
 
-#define H5C__SEARCH_INDEX(cache_ptr, Addr, entry_ptr, fail_val)             \
-{                                                                           \
-    int k;                                                                  \
-    int depth = 0;                                                          \
-    H5C__PRE_HT_SEARCH_SC(cache_ptr, Addr, fail_val)                        \
-    k = H5C__HASH_FCN(Addr);                                                \
-    entry_ptr = ((cache_ptr)->index)[k];                                    \
-    while ( ( entry_ptr ) && ( H5F_addr_ne(Addr, (entry_ptr)->addr) ) ) {   \
-        (entry_ptr) = (entry_ptr)->ht_next;                                 \
-        (depth)++;                                                          \
-    }                                                                       \
-    if ( entry_ptr ) {                                                      \
-        H5C__POST_SUC_HT_SEARCH_SC(cache_ptr, entry_ptr, Addr, k, fail_val) \
-        if ( entry_ptr != ((cache_ptr)->index)[k] ) {                       \
-            if ( (entry_ptr)->ht_next )                                     \
-                (entry_ptr)->ht_next->ht_prev = (entry_ptr)->ht_prev;       \
-            HDassert( (entry_ptr)->ht_prev != NULL );                       \
-            (entry_ptr)->ht_prev->ht_next = (entry_ptr)->ht_next;           \
-            ((cache_ptr)->index)[k]->ht_prev = (entry_ptr);                 \
-            (entry_ptr)->ht_next = ((cache_ptr)->index)[k];                 \
-            (entry_ptr)->ht_prev = NULL;                                    \
-            ((cache_ptr)->index)[k] = (entry_ptr);                          \
-            H5C__POST_HT_SHIFT_TO_FRONT(cache_ptr, entry_ptr, k, fail_val)  \
-        }                                                                   \
-    }                                                                       \
-    H5C__UPDATE_STATS_FOR_HT_SEARCH(cache_ptr, (entry_ptr != NULL), depth)  \
+#define H5C__SEARCH_INDEX(cache_ptr, Addr, entry_ptr, fail_val)                  \
+{                                                                                \
+    H5C_cache_entry_t **bucket;                                                  \
+    int depth = 0;                                                               \
+    H5C__PRE_HT_SEARCH_SC(cache_ptr, Addr, fail_val)                             \
+    bucket = H5C__INDEX_BUCKET(cache_ptr, Addr);                                 \
+    entry_ptr = *bucket;                                                         \
+    while ( ( entry_ptr ) && ( H5F_addr_ne(Addr, (entry_ptr)->addr) ) ) {        \
+        (entry_ptr) = (entry_ptr)->ht_next;                                      \
+        (depth)++;                                                               \
+    }                                                                            \
+    if ( entry_ptr ) {                                                           \
+        H5C__POST_SUC_HT_SEARCH_SC(cache_ptr, entry_ptr, Addr, bucket, fail_val) \
+        if ( entry_ptr != *bucket ) {                                            \
+            if ( (entry_ptr)->ht_next )                                          \
+                (entry_ptr)->ht_next->ht_prev = (entry_ptr)->ht_prev;            \
+            HDassert( (entry_ptr)->ht_prev != NULL );                            \
+            (entry_ptr)->ht_prev->ht_next = (entry_ptr)->ht_next;                \
+            (*bucket)->ht_prev = (entry_ptr);                                    \
+            (entry_ptr)->ht_next = *bucket;                                      \
+            (entry_ptr)->ht_prev = NULL;                                         \
+            *bucket = (entry_ptr);                                               \
+            H5C__POST_HT_SHIFT_TO_FRONT(cache_ptr, entry_ptr, bucket, fail_val)  \
+        }                                                                        \
+    }                                                                            \
+    H5C__UPDATE_STATS_FOR_HT_SEARCH(cache_ptr, entry_ptr, depth)                 \
 }
 
-#define H5C__SEARCH_INDEX_NO_STATS(cache_ptr, Addr, entry_ptr, fail_val)    \
-{                                                                           \
-    int k;                                                                  \
-    int depth = 0;                                                          \
-    H5C__PRE_HT_SEARCH_SC(cache_ptr, Addr, fail_val)                        \
-    k = H5C__HASH_FCN(Addr);                                                \
-    entry_ptr = ((cache_ptr)->index)[k];                                    \
-    while ( ( entry_ptr ) && ( H5F_addr_ne(Addr, (entry_ptr)->addr) ) ) {   \
-        (entry_ptr) = (entry_ptr)->ht_next;                                 \
-        (depth)++;                                                          \
-    }                                                                       \
-    if ( entry_ptr ) {                                                      \
-        H5C__POST_SUC_HT_SEARCH_SC(cache_ptr, entry_ptr, Addr, k, fail_val) \
-        if ( entry_ptr != ((cache_ptr)->index)[k] ) {                       \
-            if ( (entry_ptr)->ht_next )                                     \
-                (entry_ptr)->ht_next->ht_prev = (entry_ptr)->ht_prev;       \
-            HDassert( (entry_ptr)->ht_prev != NULL );                       \
-            (entry_ptr)->ht_prev->ht_next = (entry_ptr)->ht_next;           \
-            ((cache_ptr)->index)[k]->ht_prev = (entry_ptr);                 \
-            (entry_ptr)->ht_next = ((cache_ptr)->index)[k];                 \
-            (entry_ptr)->ht_prev = NULL;                                    \
-            ((cache_ptr)->index)[k] = (entry_ptr);                          \
-            H5C__POST_HT_SHIFT_TO_FRONT(cache_ptr, entry_ptr, k, fail_val)  \
-        }                                                                   \
-    }                                                                       \
+#define H5C__SEARCH_INDEX_NO_STATS(cache_ptr, Addr, entry_ptr, fail_val)         \
+{                                                                                \
+    H5C_cache_entry_t **bucket;                                                  \
+    H5C__PRE_HT_SEARCH_SC(cache_ptr, Addr, fail_val)                             \
+    bucket = H5C__INDEX_BUCKET(cache_ptr, Addr);                                 \
+    entry_ptr = *bucket;                                                         \
+    while ( ( entry_ptr ) && ( H5F_addr_ne(Addr, (entry_ptr)->addr) ) )          \
+        (entry_ptr) = (entry_ptr)->ht_next;                                      \
+    if ( entry_ptr ) {                                                           \
+        H5C__POST_SUC_HT_SEARCH_SC(cache_ptr, entry_ptr, Addr, bucket, fail_val) \
+        if ( entry_ptr != *bucket ) {                                            \
+            if ( (entry_ptr)->ht_next )                                          \
+                (entry_ptr)->ht_next->ht_prev = (entry_ptr)->ht_prev;            \
+            HDassert( (entry_ptr)->ht_prev != NULL );                            \
+            (entry_ptr)->ht_prev->ht_next = (entry_ptr)->ht_next;                \
+            (*bucket)->ht_prev = (entry_ptr);                                    \
+            (entry_ptr)->ht_next = *bucket;                                      \
+            (entry_ptr)->ht_prev = NULL;                                         \
+            *bucket = (entry_ptr);                                               \
+            H5C__POST_HT_SHIFT_TO_FRONT(cache_ptr, entry_ptr, bucket, fail_val)  \
+        }                                                                        \
+    }                                                                            \
 }
 
 #define H5C__UPDATE_INDEX_FOR_ENTRY_CLEAN(cache_ptr, entry_ptr)   \
@@ -3337,20 +3427,47 @@ if ( ( (entry_ptr) == NULL ) ||                                                \
  *		index by ring.  Note that the sum of all cells in this array 
  *		must equal the value stored in dirty_index_size above.
  *
- * index:	Array of pointer to H5C_cache_entry_t of size
- *		H5C__HASH_TABLE_LEN.  At present, this value is a power
- *		of two, not the usual prime number.
+ * index:	Dynamically allocated array of index_nbuckets pointers to
+ *		H5C_cache_entry_t, used as the buckets of the hash table.
+ *		Entries that hash to the same bucket are kept in a doubly
+ *		linked list through their ht_next and ht_prev fields.
+ *
+ *		The table starts with 2^H5C__HASH_TABLE_MIN_BITS buckets,
+ *		and doubles in size whenever the index holds more entries
+ *		than it has buckets, so that the average bucket holds at
+ *		most one entry however large the cache gets.  See
+ *		H5C__HASH_FCN for the hash function.
+ *
+ * index_nbuckets: Number of buckets in index.  Always a power of two.
+ *
+ * index_nbits: Base 2 log of index_nbuckets.
+ *
+ * To avoid a visible pause when a large index grows, its entries are
+ * moved to the larger table incrementally: each insertion into and
+ * deletion from the index moves the entries of H5C__HASH_REHASH_STEP
+ * buckets of the old table, until it is empty and can be freed.  The
+ * following fields support this.
  *
- *		I hope that the variable size of cache elements, the large
- *		hash table size, and the way in which HDF5 allocates space
- *		will combine to avoid problems with periodicity.  If so, we
- *		can use a trivial hash function (a bit-and and a 3 bit left
- *		shift) with some small savings.
+ * old_index:	Array of pointers to H5C_cache_entry_t holding the buckets
+ *		of the hash table before it was grown, or NULL if the index
+ *		is not being resized.
  *
- *		If not, it will become evident in the statistics. Changing
- *		to the usual prime number length hash table will require
- *		changing the H5C__HASH_FCN macro and the deletion of the
- *		H5C__HASH_MASK #define.  No other changes should be required.
+ * old_index_nbuckets: Number of buckets in old_index.
+ *
+ * old_index_nbits: Base 2 log of old_index_nbuckets.
+ *
+ * index_rehash_pos: Index of the next bucket of old_index to be moved to
+ *		index.  The buckets of old_index below this position are
+ *		empty, so entries whose old bucket is below it are looked
+ *		up in index, and all others in old_index.
+ *
+ * il_head:	Pointer to the head of the index list, a doubly linked list
+ *		of all entries in the index, in the order in which they
+ *		were inserted.  The list is threaded through the il_next
+ *		and il_prev fields of H5C_cache_entry_t, and is used for
+ *		scans of the whole cache.
+ *
+ * il_tail:	Pointer to the tail of the index list.
  *
  * With the addition of the take ownership flag, it is possible that 
  * an entry may be removed from the cache as the result of the flush of 
@@ -3476,6 +3593,25 @@ if ( ( (entry_ptr) == NULL ) ||                                                \
  * 		to the slist since the last time this field was set to
  * 		zero.  Note that this value can be negative.
  *
+ * When H5C_flush_ring() flushes the entries of a ring, the images of the
+ * flushed entries are not written one at a time.  Instead, a copy of each
+ * image is queued in a skip list sorted by address, and the queue is
+ * written at the end of each pass through the slist, with images that are
+ * adjacent in the file combined into a single write.  Entries flushed in
+ * the same pass have the same flush dependency height, so no entry is
+ * written ahead of one it depends on.  The queue is also written when the
+ * scan of the slist is restarted, and before any entry is read from the
+ * file.  SWMR writers and parallel caches do not queue images.
+ *
+ * flush_write_list: Pointer to the skip list of H5C_flush_write_t holding
+ *		the images waiting to be written, keyed on their file
+ *		address, or NULL when images are written as soon as the
+ *		entries are flushed.
+ *
+ * flush_write_list_size: Total size of the images in flush_write_list.
+ *		The queue is written early if this grows past
+ *		H5C__FLUSH_WRITE_LIST_MAX_SIZE.
+ *
  *
  * When a cache entry is protected, it must be removed from the LRU
  * list(s) as it cannot be either flushed or evicted until it is unprotected.
@@ -3939,6 +4075,30 @@ if ( ( (entry_ptr) == NULL ) ||                                                \
  *              entries examined in unsuccessful searches of the hash
  *		table in the current epoch.
  *
+ * successful_ht_searches_by_type: Array of int64 of length
+ *		H5C__MAX_NUM_TYPE_IDS + 1.  The cells are used to record
+ *		the number of successful searches of the hash table for
+ *		entries with type id equal to the array index in the
+ *		current epoch.
+ *
+ * total_ht_search_depth_by_type: Array of int64 of length
+ *		H5C__MAX_NUM_TYPE_IDS + 1.  The cells are used to record
+ *		the total number of entries other than the targets
+ *		examined in successful searches of the hash table for
+ *		entries with type id equal to the array index in the
+ *		current epoch.  Together with the above, this gives the
+ *		mean cost of a lookup of each type of entry.
+ *
+ * max_ht_search_depth_by_type: Array of int32 of length
+ *		H5C__MAX_NUM_TYPE_IDS + 1.  The cells are used to record
+ *		the largest number of entries other than the target
+ *		examined in any one successful search of the hash table
+ *		for an entry with type id equal to the array index in the
+ *		current epoch.
+ *
+ * index_resizes: Number of times the hash table has been grown in the
+ *		current epoch.
+ *
  * max_index_len:  Largest value attained by the index_len field in the
  *              current epoch.
  *
@@ -4007,11 +4167,18 @@ if ( ( (entry_ptr) == NULL ) ||                                                \
  *              avoid potential issues with change of status of the next 
  *              entry in the scan.
  *
- * hash_bucket_scan_restarts: Number of times a scan of a hash bucket list
+ * index_scan_restarts: Number of times a scan of the index list
  *		(that contains calls to H5C_flush_single_entry()) has been 
  *		restarted to avoid potential issues with change of status 
  *		of the next entry in the scan.
  *
+ * flush_write_images: Number of entry images written from the
+ *		flush_write_list.
+ *
+ * flush_writes: Number of writes issued to write those images.  The
+ *		ratio of the two is the average number of entries combined
+ *		into each write.
+ *
  * The remaining stats are collected only when both H5C_COLLECT_CACHE_STATS
  * and H5C_COLLECT_CACHE_ENTRY_STATS are true.
  *
@@ -4046,6 +4213,31 @@ if ( ( (entry_ptr) == NULL ) ||                                                \
  *              marked as pinned in the cache in the current epoch.
  *
  *
+ * Fields supporting the metadata cache image:
+ *
+ * When a file is opened with a metadata cache image, the image is read
+ * with a single I/O request and its entries are kept in a skip list
+ * until they are loaded, so that cache misses on them are satisfied from
+ * memory instead of the file.  Entries are dropped from the skip list as
+ * they are loaded, or when the file space they occupy is written to, and
+ * the image is discarded once it is empty.
+ *
+ * image_slist_ptr: Pointer to the skip list of H5C_image_entry_t for the
+ *		entries of the cache image that have not been loaded yet,
+ *		keyed on their file address.  NULL when there is no cache
+ *		image.
+ *
+ * image_buf:	Pointer to the buffer holding the cache image.  The
+ *		image_ptr fields of the entries in image_slist_ptr point
+ *		into this buffer.
+ *
+ * image_entries: Number of entries in the cache image that was loaded
+ *		when the file was opened.
+ *
+ * image_hits:	Number of entries that were loaded from the cache image
+ *		instead of the file.
+ *
+ *
  * Fields supporting testing:
  *
  * prefix	Array of char used to prefix debugging output.  The
@@ -4081,7 +4273,15 @@ struct H5C_t {
     size_t			clean_index_ring_size[H5C_RING_NTYPES];
     size_t			dirty_index_size;
     size_t			dirty_index_ring_size[H5C_RING_NTYPES];
-    H5C_cache_entry_t *		(index[H5C__HASH_TABLE_LEN]);
+    H5C_cache_entry_t **	index;
+    size_t			index_nbuckets;
+    unsigned			index_nbits;
+    H5C_cache_entry_t **	old_index;
+    size_t			old_index_nbuckets;
+    unsigned			old_index_nbits;
+    size_t			index_rehash_pos;
+    H5C_cache_entry_t *		il_head;
+    H5C_cache_entry_t *		il_tail;
 
     /* Fields to detect entries removed during scans */
     int64_t			entries_removed_counter;
@@ -4105,6 +4305,10 @@ struct H5C_t {
     int64_t			slist_size_increase;
 #endif /* H5C_DO_SANITY_CHECKS */
 
+    /* Fields for queueing the images of flushed entries */
+    H5SL_t *                    flush_write_list;
+    size_t                      flush_write_list_size;
+
     /* Fields for tracking protected entries */
     int32_t                     pl_len;
     size_t                      pl_size;
@@ -4198,6 +4402,10 @@ struct H5C_t {
     int64_t			total_successful_ht_search_depth;
     int64_t			failed_ht_searches;
     int64_t			total_failed_ht_search_depth;
+    int64_t                     successful_ht_searches_by_type[H5C__MAX_NUM_TYPE_IDS + 1];
+    int64_t                     total_ht_search_depth_by_type[H5C__MAX_NUM_TYPE_IDS + 1];
+    int32_t                     max_ht_search_depth_by_type[H5C__MAX_NUM_TYPE_IDS + 1];
+    int64_t                     index_resizes;
     int32_t                     max_index_len;
     size_t                      max_index_size;
     size_t                      max_clean_index_size;
@@ -4226,7 +4434,11 @@ struct H5C_t {
     /* Fields for tracking skip list scan restarts */
     int64_t			slist_scan_restarts;
     int64_t			LRU_scan_restarts;
-    int64_t			hash_bucket_scan_restarts;
+    int64_t			index_scan_restarts;
+
+    /* Fields for tracking queued writes of flushed entries */
+    int64_t			flush_write_images;
+    int64_t			flush_writes;
 
 #if H5C_COLLECT_CACHE_ENTRY_STATS
     int32_t                     max_accesses[H5C__MAX_NUM_TYPE_IDS + 1];
@@ -4238,6 +4450,12 @@ struct H5C_t {
 #endif /* H5C_COLLECT_CACHE_ENTRY_STATS */
 #endif /* H5C_COLLECT_CACHE_STATS */
 
+    /* Fields for the metadata cache image */
+    H5SL_t *                    image_slist_ptr;
+    void *                      image_buf;
+    unsigned                    image_entries;
+    unsigned                    image_hits;
+
     char			prefix[H5C__PREFIX_LEN];
 
 #ifndef NDEBUG
@@ -4245,6 +4463,23 @@ struct H5C_t {
 #endif /* NDEBUG */
 };
 
+/* Entry of a metadata cache image, not loaded into the cache yet */
+typedef struct H5C_image_entry_t {
+    haddr_t addr;               /* File address of the entry */
+    size_t size;                /* Size of the entry's on-disk image */
+    int32_t type_id;            /* ID of the entry's client class */
+    const uint8_t *image_ptr;   /* Entry's image, in the cache image buffer */
+    hbool_t used;               /* Whether the entry was read from the image */
+} H5C_image_entry_t;
+
+/* Image of a flushed entry, queued to be written in address order */
+typedef struct H5C_flush_write_t {
+    haddr_t addr;               /* File address of the image */
+    size_t size;                /* Size of the image */
+    H5FD_mem_t mem_type;        /* File memory type of the entry */
+    void *buf;                  /* Copy of the entry's image */
+} H5C_flush_write_t;
+
 #ifdef H5_HAVE_PARALLEL
 typedef struct H5C_collective_write_t {
     size_t length;
@@ -4263,8 +4498,13 @@ typedef struct H5C_collective_write_t {
 /******************************/
 /* Package Private Prototypes */
 /******************************/
+H5_DLL void H5C__index_rehash(H5C_t *cache_ptr);
 H5_DLL herr_t H5C__flush_single_entry(const H5F_t *f, hid_t dxpl_id,
     H5C_cache_entry_t *entry_ptr, unsigned flags, int64_t *entry_size_change_ptr, H5SL_t *collective_write_list);
+H5_DLL herr_t H5C__image_read(const H5F_t *f, hid_t dxpl_id,
+    const H5C_class_t *type, haddr_t addr, size_t len, void *image);
+H5_DLL herr_t H5C__image_entry_loaded(H5C_t *cache_ptr, haddr_t addr);
+H5_DLL herr_t H5C__image_dest(H5C_t *cache_ptr);
 
 #endif /* _H5Cpkg_H */
 
@@ -83,10 +83,8 @@
 /* Upper and lower limits on cache size.  These limits are picked
  * out of a hat -- you should be able to change them as necessary.
  *
- * However, if you need a very big cache, you should also increase the
- * size of the hash table (H5C__HASH_TABLE_LEN in H5Cpkg.h).  The current
- * upper bound on cache size is rather large for the current hash table
- * size.
+ * The hash table used to index the cache grows with the number of
+ * entries in it, so these limits don't depend on its size.
  */
 #define H5C__MAX_MAX_CACHE_SIZE		((size_t)(128 * 1024 * 1024))
 #define H5C__MIN_MAX_CACHE_SIZE		((size_t)(1024))
@@ -1493,6 +1491,14 @@ typedef int H5C_ring_t;
  *              previous entry in the doubly linked list of entries in
  *		the hash bin, or NULL if there is no previuos entry.
  *
+ * il_next:	Next pointer used to maintain the index list, a doubly
+ *		linked list of all entries in the index, in the order in
+ *		which they were inserted.  It allows scans of the whole
+ *		cache without visiting the (mostly empty) hash buckets,
+ *		and is unaffected by resizes of the hash table.
+ *
+ * il_prev:	Prev pointer used to maintain the index list.
+ *
  *
  * Fields supporting replacement policies:
  *
@@ -1626,6 +1632,8 @@ typedef struct H5C_cache_entry_t {
     /* fields supporting the hash table: */
     struct H5C_cache_entry_t  *	ht_next;
     struct H5C_cache_entry_t  *	ht_prev;
+    struct H5C_cache_entry_t  *	il_next;
+    struct H5C_cache_entry_t  *	il_prev;
 
     /* fields supporting replacement policies: */
     struct H5C_cache_entry_t  *	next;
@@ -1952,6 +1960,8 @@ H5_DLL herr_t H5C_expunge_entry(H5F_t *f, hid_t dxpl_id,
     const H5C_class_t *type, haddr_t addr, unsigned flags);
 H5_DLL herr_t H5C_flush_cache(H5F_t *f, hid_t dxpl_id, unsigned flags);
 H5_DLL herr_t H5C_flush_to_min_clean(H5F_t *f, hid_t dxpl_id);
+H5_DLL herr_t H5C_flush_tagged_entries(H5F_t *f, hid_t dxpl_id, haddr_t tag);
+H5_DLL herr_t H5C_evict_tagged_entries(H5F_t *f, hid_t dxpl_id, haddr_t tag);
 H5_DLL herr_t H5C_get_cache_auto_resize_config(const H5C_t *cache_ptr,
     H5C_auto_size_ctl_t *config_ptr);
 H5_DLL herr_t H5C_get_cache_size(H5C_t *cache_ptr, size_t *max_size_ptr,
@@ -1994,6 +2004,14 @@ H5_DLL herr_t H5C_validate_resize_config(H5C_auto_size_ctl_t *config_ptr,
 H5_DLL herr_t H5C_ignore_tags(H5C_t *cache_ptr);
 H5_DLL void H5C_retag_copied_metadata(H5C_t *cache_ptr, haddr_t metadata_tag);
 H5_DLL herr_t H5C_get_entry_ring(const H5F_t *f, haddr_t addr, H5C_ring_t *ring);
+H5_DLL herr_t H5C_get_cache_image(const H5F_t *f, void **image_ptr,
+    size_t *image_len_ptr);
+H5_DLL herr_t H5C_load_cache_image(H5F_t *f, hid_t dxpl_id, haddr_t addr,
+    size_t len);
+H5_DLL herr_t H5C_invalidate_cache_image(H5C_t *cache_ptr, haddr_t addr,
+    size_t size);
+H5_DLL herr_t H5C_get_cache_image_stats(const H5C_t *cache_ptr,
+    unsigned *nentries_ptr, unsigned *nhits_ptr);
 
 #ifdef H5_HAVE_PARALLEL
 H5_DLL herr_t H5C_apply_candidate_list(H5F_t *f, hid_t dxpl_id,
@@ -917,3 +917,222 @@ done:
         FUNC_LEAVE_API(ret_value)
 } /* end H5Dset_extent() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Dflush
+ *
+ * Purpose:	Writes a dataset's cached raw data and metadata to the
+ *		file.  In a file opened with H5F_ACC_SWMR_WRITE this makes
+ *		the data written so far visible to concurrent readers.
+ *
+ * Return:	Non-negative on success, negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Dflush(hid_t dset_id)
+{
+    H5D_t *dset;                /* Dataset for this operation */
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE1("e", "i", dset_id);
+
+    /* Check args */
+    if(NULL == (dset = (H5D_t *)H5I_object_verify(dset_id, H5I_DATASET)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a dataset")
+
+    /* Private function */
+    if(H5D__flush(dset, H5AC_ind_read_dxpl_id) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTFLUSH, FAIL, "unable to flush dataset")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Dflush() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Drefresh
+ *
+ * Purpose:	Discards the dataset's state cached in memory and re-reads
+ *		it from the file.  A reader of a file opened with
+ *		H5F_ACC_SWMR_READ calls this to see the dimensions and data
+ *		flushed by the writer since the dataset was opened.
+ *
+ * Return:	Non-negative on success, negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Drefresh(hid_t dset_id)
+{
+    H5D_t *dset;                /* Dataset for this operation */
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE1("e", "i", dset_id);
+
+    /* Check args */
+    if(NULL == (dset = (H5D_t *)H5I_object_verify(dset_id, H5I_DATASET)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a dataset")
+
+    /* Private function */
+    if(H5D__refresh(dset, H5AC_ind_read_dxpl_id) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTLOAD, FAIL, "unable to refresh dataset")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Drefresh() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Dget_chunk_cache_stats
+ *
+ * Purpose:	Retrieves the raw data chunk cache statistics for a chunked
+ *		dataset, along with the usage of the memory pool its chunks
+ *		are cached in (which is shared with the other datasets in
+ *		the file if H5Pset_shared_chunk_cache() was used).
+ *
+ * Return:	Non-negative on success, negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Dget_chunk_cache_stats(hid_t dset_id, H5D_chunk_cache_stats_t *stats/*out*/)
+{
+    H5D_t *dset;                /* Dataset for this operation */
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "ix", dset_id, stats);
+
+    /* Check args */
+    if(NULL == (dset = (H5D_t *)H5I_object_verify(dset_id, H5I_DATASET)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a dataset")
+    if(H5D_CHUNKED != dset->shared->layout.type)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a chunked dataset")
+    if(!stats)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "no statistics buffer specified")
+
+    /* Private function */
+    if(H5D__chunk_cache_get_stats(dset, stats) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "unable to get chunk cache statistics")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Dget_chunk_cache_stats() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Dreset_chunk_cache_stats
+ *
+ * Purpose:	Resets the raw data chunk cache counters for a chunked
+ *		dataset to zero.
+ *
+ * Return:	Non-negative on success, negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Dreset_chunk_cache_stats(hid_t dset_id)
+{
+    H5D_t *dset;                /* Dataset for this operation */
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE1("e", "i", dset_id);
+
+    /* Check args */
+    if(NULL == (dset = (H5D_t *)H5I_object_verify(dset_id, H5I_DATASET)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a dataset")
+    if(H5D_CHUNKED != dset->shared->layout.type)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a chunked dataset")
+
+    /* Private function */
+    if(H5D__chunk_cache_reset_stats(dset) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTSET, FAIL, "unable to reset chunk cache statistics")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Dreset_chunk_cache_stats() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Dget_chunk_storage_size
+ *
+ * Purpose:	Returns the size in bytes that the chunk at logical OFFSET
+ *		occupies in the file, after the filter pipeline.  The size
+ *		is zero if the chunk hasn't been allocated.
+ *
+ *		Use this to size the buffer for H5DOread_chunk().
+ *
+ * Return:	Non-negative on success, negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Dget_chunk_storage_size(hid_t dset_id, const hsize_t *offset, hsize_t *chunk_nbytes)
+{
+    H5D_t *dset;                /* Dataset for this operation */
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE3("e", "i*h*h", dset_id, offset, chunk_nbytes);
+
+    /* Check args */
+    if(NULL == (dset = (H5D_t *)H5I_object_verify(dset_id, H5I_DATASET)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a dataset")
+    if(H5D_CHUNKED != dset->shared->layout.type)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a chunked dataset")
+    if(!offset)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "no chunk offset specified")
+    if(!chunk_nbytes)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "no chunk size buffer specified")
+
+    /* Private function */
+    if(H5D__chunk_get_info_by_coord(dset, H5AC_ind_read_dxpl_id, offset, NULL, NULL, chunk_nbytes) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't get chunk storage size")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Dget_chunk_storage_size() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Dget_chunk_info_by_coord
+ *
+ * Purpose:	Returns the filter mask, file address and stored size in
+ *		bytes of the chunk at logical OFFSET.  For a chunk that
+ *		hasn't been allocated, the address is HADDR_UNDEF and the
+ *		size is zero.  Any of the output pointers may be NULL.
+ *
+ * Return:	Non-negative on success, negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Dget_chunk_info_by_coord(hid_t dset_id, const hsize_t *offset,
+    unsigned *filter_mask, haddr_t *addr, hsize_t *size)
+{
+    H5D_t *dset;                /* Dataset for this operation */
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE5("e", "i*h*Iu*a*h", dset_id, offset, filter_mask, addr, size);
+
+    /* Check args */
+    if(NULL == (dset = (H5D_t *)H5I_object_verify(dset_id, H5I_DATASET)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a dataset")
+    if(H5D_CHUNKED != dset->shared->layout.type)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a chunked dataset")
+    if(!offset)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "no chunk offset specified")
+
+    /* Private function */
+    if(H5D__chunk_get_info_by_coord(dset, H5AC_ind_read_dxpl_id, offset, filter_mask, addr, size) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't get chunk info")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Dget_chunk_info_by_coord() */
@@ -585,6 +585,13 @@ H5D__btree_insert(H5F_t *f, hid_t H5_ATTR_UNUSED dxpl_id, haddr_t addr, void *_l
             lt_key->filter_mask = udata->filter_mask;
             *lt_key_changed = TRUE;
             ret_value = H5B_INS_CHANGE;
+        } else if(lt_key->filter_mask != udata->filter_mask) {
+	    /* Same storage, but the chunk was written with other filters */
+	    HDassert(H5F_addr_defined(udata->chunk_block.offset));
+            *new_node_p = udata->chunk_block.offset;
+            lt_key->filter_mask = udata->filter_mask;
+            *lt_key_changed = TRUE;
+            ret_value = H5B_INS_CHANGE;
         } else {
 	    /* Already have address in udata, from main chunk routines */
 	    HDassert(H5F_addr_defined(udata->chunk_block.offset));
@@ -74,8 +74,11 @@
 #define H5D_CHUNK_GET_NEXT_NODE(map, node)  (map->use_single ? (H5SL_node_t *)NULL : H5SL_next(node))
 
 /* Sanity check on chunk index types: commonly used by a lot of routines in this file */
-#define H5D_CHUNK_STORAGE_INDEX_CHK(storage)                                                    \
-    HDassert((H5D_CHUNK_IDX_BTREE == storage->idx_type && H5D_COPS_BTREE == storage->ops));
+#define H5D_CHUNK_STORAGE_INDEX_CHK(storage)                                                        \
+    HDassert((H5D_CHUNK_IDX_EARRAY == (storage)->idx_type && H5D_COPS_EARRAY == (storage)->ops) ||  \
+        (H5D_CHUNK_IDX_FARRAY == (storage)->idx_type && H5D_COPS_FARRAY == (storage)->ops) ||       \
+        (H5D_CHUNK_IDX_SINGLE == (storage)->idx_type && H5D_COPS_SINGLE == (storage)->ops) ||       \
+        (H5D_CHUNK_IDX_BTREE == (storage)->idx_type && H5D_COPS_BTREE == (storage)->ops));
 
 /*
  * Feature: If this constant is defined then every cache preemption and load
@@ -103,6 +106,23 @@
 
 /*#define H5D_CHUNK_DEBUG */
 
+/* # of chunks per thread in each batch when running the filter pipeline
+ * on many chunks in parallel (see H5Pset_filter_nthreads)
+ */
+#define H5D_CHUNK_FILTER_BATCH_FACTOR   4
+
+/* # of chunks accessed with a constant stride before reading ahead */
+#define H5D_CHUNK_PREFETCH_MIN_RUN      3
+
+/* Index of a chunk read ahead that has been used */
+#define H5D_CHUNK_PREFETCH_USED         ((hsize_t)(hssize_t)(-1))
+
+/* Size of a chunk cache entry, or of the chunk it's a ghost of */
+#define H5D_RDCC_ENT_SIZE(E)    ((size_t)(E)->shared->layout.u.chunk.size)
+
+/* Whether a chunk cache entry holds a chunk (instead of being a ghost) */
+#define H5D_RDCC_ENT_CACHED(E)  (H5D_RDCC_T1 == (E)->list || H5D_RDCC_T2 == (E)->list)
+
 
 /******************/
 /* Local Typedefs */
@@ -118,12 +138,15 @@ typedef struct H5D_rdcc_ent_t {
     uint32_t	wr_count;	/*bytes remaining to be written		*/
     H5F_block_t chunk_block;    /*offset/length of chunk in file        */
     hsize_t     chunk_idx;  	/*index of chunk in dataset             */
-    uint8_t	*chunk;		/*the unfiltered chunk data		*/
+    uint8_t	*chunk;		/*the unfiltered chunk data (NULL for a ghost) */
     unsigned	idx;		/*index in hash table			*/
-    struct H5D_rdcc_ent_t *next;/*next item in doubly-linked list	*/
-    struct H5D_rdcc_ent_t *prev;/*previous item in doubly-linked list	*/
-    struct H5D_rdcc_ent_t *tmp_next;/*next item in temporary doubly-linked list */
-    struct H5D_rdcc_ent_t *tmp_prev;/*previous item in temporary doubly-linked list */
+    H5D_shared_t *shared;       /*dataset the chunk belongs to		*/
+    H5D_rdcc_list_t list;       /*replacement policy list entry is on	*/
+    struct H5D_rdcc_ent_t *hash_next;/*next item in hash table bucket	*/
+    struct H5D_rdcc_ent_t *next;/*next item in dataset's doubly-linked list */
+    struct H5D_rdcc_ent_t *prev;/*previous item in dataset's doubly-linked list */
+    struct H5D_rdcc_ent_t *lru_next;/*next item in pool's replacement list */
+    struct H5D_rdcc_ent_t *lru_prev;/*previous item in pool's replacement list */
 } H5D_rdcc_ent_t;
 typedef H5D_rdcc_ent_t *H5D_rdcc_ent_ptr_t; /* For free lists */
 
@@ -202,6 +225,25 @@ typedef struct H5D_chunk_file_iter_ud_t {
 #endif /* H5_HAVE_PARALLEL */
 } H5D_chunk_file_iter_ud_t;
 
+/* Chunk to read in a batch for the parallel filter pipeline */
+typedef struct H5D_chunk_filt_read_t {
+    haddr_t addr;               /* Address of chunk in file */
+    size_t idx;                 /* Index of chunk in batch */
+} H5D_chunk_filt_read_t;
+
+/* Batch of chunks for the parallel filter pipeline */
+typedef struct H5D_chunk_filt_batch_t {
+    size_t max_chunks;          /* Max. # of chunks in a batch */
+    size_t nchunks;             /* # of chunks in current batch */
+    size_t curr;                /* Index of current chunk in batch */
+    H5Z_pipeline_job_t *jobs;   /* Filter pipeline job for each chunk in batch */
+    H5D_chunk_filt_read_t *reads; /* Chunks to read from the file (reading) */
+    H5D_rdcc_ent_t *ents;       /* Chunks not in the cache to flush (writing) */
+    size_t nents;               /* # of uncached chunks to flush (writing) */
+    const hsize_t **full;       /* Cached chunks overwritten entirely (writing) */
+    size_t nfull;               /* # of entirely overwritten cached chunks (writing) */
+} H5D_chunk_filt_batch_t;
+
 #ifdef H5_HAVE_PARALLEL
 /* information to construct a collective I/O operation for filling chunks */
 typedef struct H5D_chunk_coll_info_t {
@@ -261,17 +303,69 @@ static herr_t H5D__chunk_mem_cb(void *elem, const H5T_t *type, unsigned ndims,
     const hsize_t *coords, void *fm);
 static unsigned H5D__chunk_hash_val(const H5D_shared_t *shared, const hsize_t *scaled);
 static herr_t H5D__chunk_flush_entry(const H5D_t *dset, hid_t dxpl_id,
-    const H5D_dxpl_cache_t *dxpl_cache, H5D_rdcc_ent_t *ent, hbool_t reset);
+    const H5D_dxpl_cache_t *dxpl_cache, H5D_rdcc_ent_t *ent, hbool_t reset,
+    H5Z_pipeline_job_t *filt);
+static herr_t H5D__chunk_flush_entries(const H5D_t *dset, hid_t dxpl_id,
+    const H5D_dxpl_cache_t *dxpl_cache, H5D_rdcc_ent_t **ents, size_t nents);
 static herr_t H5D__chunk_cache_evict(const H5D_t *dset, hid_t dxpl_id,
     const H5D_dxpl_cache_t *dxpl_cache, H5D_rdcc_ent_t *ent, hbool_t flush);
 static void *H5D__chunk_lock(const H5D_io_info_t *io_info,
-    H5D_chunk_ud_t *udata, hbool_t relax);
+    H5D_chunk_ud_t *udata, hbool_t relax, H5Z_pipeline_job_t *filt);
 static herr_t H5D__chunk_unlock(const H5D_io_info_t *io_info,
     const H5D_chunk_ud_t *udata, hbool_t dirty, void *chunk,
     uint32_t naccessed);
+static H5D_rdcc_ent_t *H5D__chunk_cache_find(const H5D_shared_t *shared,
+    const hsize_t *scaled);
+static herr_t H5D__chunk_cache_resize(H5D_shared_t *shared, size_t nbuckets);
+static herr_t H5D__chunk_cache_hash_insert(H5D_shared_t *shared,
+    H5D_rdcc_ent_t *ent);
+static void H5D__chunk_cache_hash_remove(H5D_shared_t *shared,
+    H5D_rdcc_ent_t *ent);
+static void H5D__chunk_cache_list_append(H5D_rdcc_pool_t *pool,
+    H5D_rdcc_ent_t *ent, H5D_rdcc_list_t list);
+static void H5D__chunk_cache_list_remove(H5D_rdcc_pool_t *pool,
+    H5D_rdcc_ent_t *ent);
+static void H5D__chunk_cache_drop_ghost(H5D_rdcc_pool_t *pool,
+    H5D_rdcc_ent_t *ent);
+static void H5D__chunk_cache_trim_ghosts(H5D_rdcc_pool_t *pool);
+static H5D_rdcc_ent_t *H5D__chunk_cache_victim(const H5D_t *dset,
+    const H5D_rdcc_pool_t *pool, H5D_rdcc_list_t list);
+static herr_t H5D__chunk_cache_preempt(const H5D_t *dset, hid_t dxpl_id,
+    const H5D_dxpl_cache_t *dxpl_cache, H5D_rdcc_ent_t *ent);
 static herr_t H5D__chunk_cache_prune(const H5D_t *dset, hid_t dxpl_id,
-    const H5D_dxpl_cache_t *dxpl_cache, size_t size);
+    const H5D_dxpl_cache_t *dxpl_cache, size_t size, hbool_t b2_hit);
 static herr_t H5D__chunk_prune_fill(H5D_chunk_it_ud1_t *udata);
+static herr_t H5D__chunk_filt_batch_init(const H5D_io_info_t *io_info,
+    H5D_chunk_filt_batch_t *batch, hbool_t write_op);
+static herr_t H5D__chunk_filt_batch_term(const H5D_io_info_t *io_info,
+    H5D_chunk_filt_batch_t *batch);
+static int H5D__chunk_filt_read_cmp(const void *_read1, const void *_read2);
+static herr_t H5D__chunk_filt_batch_read(const H5D_io_info_t *io_info,
+    const H5D_chunk_map_t *fm, H5SL_node_t *chunk_node,
+    H5D_chunk_filt_batch_t *batch);
+static herr_t H5D__chunk_filt_batch_write(const H5D_io_info_t *io_info,
+    H5D_chunk_filt_batch_t *batch);
+static herr_t H5D__chunk_prefetch_drop(const H5D_t *dset);
+static herr_t H5D__chunk_prefetch_wait(const H5D_t *dset);
+static size_t H5D__chunk_prefetch_find(const H5D_rdcc_t *rdcc, hsize_t idx);
+static htri_t H5D__chunk_prefetch_take(const H5D_t *dset, hsize_t idx,
+    H5Z_pipeline_job_t *job);
+static herr_t H5D__chunk_prefetch(const H5D_io_info_t *io_info,
+    const H5D_chunk_map_t *fm, hbool_t skip_sel, hsize_t idx);
+static herr_t H5D__chunk_write_behind_finish(const H5D_t *dset, hid_t dxpl_id,
+    const H5D_dxpl_cache_t *dxpl_cache);
+static herr_t H5D__chunk_write_behind_start(const H5D_t *dset, hid_t dxpl_id,
+    const H5D_dxpl_cache_t *dxpl_cache);
+static htri_t H5D__chunk_write_behind_add(const H5D_t *dset, hid_t dxpl_id,
+    const H5D_dxpl_cache_t *dxpl_cache, H5D_rdcc_ent_t *ent);
+static herr_t H5D__chunk_write_behind_drain(const H5D_t *dset, hid_t dxpl_id,
+    const H5D_dxpl_cache_t *dxpl_cache);
+static herr_t H5D__chunk_stored_info(const H5D_t *dset, hid_t dxpl_id,
+    const hsize_t *offset, H5D_chunk_ud_t *udata);
+static hbool_t H5D__chunk_write_behind_has(const H5D_shared_t *shared,
+    const hsize_t *scaled);
+static void H5D__chunk_write_behind_begin(const H5D_io_info_t *io_info);
+static herr_t H5D__chunk_write_behind_flush(const H5D_io_info_t *io_info);
 static herr_t H5D__chunk_file_alloc(const H5D_chk_idx_info_t *idx_info,
     const H5F_block_t *old_chunk, H5F_block_t *new_chunk, hbool_t *need_insert,
     hsize_t scaled[]);
@@ -333,6 +427,9 @@ H5FL_SEQ_DEFINE_STATIC(H5D_rdcc_ent_ptr_t);
 /* Declare a free list to manage H5D_rdcc_ent_t objects */
 H5FL_DEFINE_STATIC(H5D_rdcc_ent_t);
 
+/* Declare a free list to manage the H5D_rdcc_pool_t struct */
+H5FL_DEFINE_STATIC(H5D_rdcc_pool_t);
+
 /* Declare a free list to manage the H5D_chunk_info_t struct */
 H5FL_DEFINE(H5D_chunk_info_t);
 
@@ -373,6 +470,10 @@ H5D__chunk_direct_write(const H5D_t *dset, hid_t dxpl_id, uint32_t filters,
     io_info.raw_dxpl_id = dxpl_id;
     io_info.md_dxpl_id = dxpl_id;
 
+    /* Chunks read ahead may be overwritten */
+    if(H5D__chunk_prefetch_reset(dset) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTFREE, FAIL, "can't release chunks read ahead")
+
     /* set the dxpl IO type for sanity checking at the FD layer */
 #ifdef H5_DEBUG_BUILD
     if(H5D_set_io_info_dxpls(&io_info, dxpl_id) < 0)
@@ -429,16 +530,15 @@ H5D__chunk_direct_write(const H5D_t *dset, hid_t dxpl_id, uint32_t filters,
 
     /* Evict the (old) entry from the cache if present, but do not flush
      * it to disk */
-    if(UINT_MAX != udata.idx_hint) {
+    if(udata.ent) {
         H5D_dxpl_cache_t _dxpl_cache;       /* Data transfer property cache buffer */
         H5D_dxpl_cache_t *dxpl_cache = &_dxpl_cache;   /* Data transfer property cache */
-        const H5D_rdcc_t *rdcc = &(dset->shared->cache.chunk);	/*raw data chunk cache */
 
         /* Fill the DXPL cache values for later use */
         if(H5D__get_dxpl_cache(io_info.raw_dxpl_id, &dxpl_cache) < 0)
             HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't fill dxpl cache")
 
-        if(H5D__chunk_cache_evict(dset, io_info.md_dxpl_id, dxpl_cache, rdcc->slot[udata.idx_hint], FALSE) < 0)
+        if(H5D__chunk_cache_evict(dset, io_info.md_dxpl_id, dxpl_cache, udata.ent, FALSE) < 0)
 	    HGOTO_ERROR(H5E_DATASET, H5E_CANTREMOVE, FAIL, "unable to evict chunk")
     } /* end if */
 
@@ -446,12 +546,13 @@ H5D__chunk_direct_write(const H5D_t *dset, hid_t dxpl_id, uint32_t filters,
     if(H5F_block_write(dset->oloc.file, H5FD_MEM_DRAW, udata.chunk_block.offset, data_size, io_info.raw_dxpl_id, buf) < 0)
         HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "unable to write raw data to file")
 
-    /* Insert the chunk record into the index */
-    if(need_insert && layout->storage.u.chunk.ops->insert) {
+    /* Insert the chunk record into the index.  An existing chunk's record
+     * is updated too, as its filter mask may have changed. */
+    if((need_insert || H5F_addr_defined(old_chunk.offset)) && layout->storage.u.chunk.ops->insert) {
         /* Set the chunk's filter mask to the new settings */
         udata.filter_mask = filters;
 
-        if((layout->storage.u.chunk.ops->insert)(&idx_info, &udata, NULL) < 0)
+        if((layout->storage.u.chunk.ops->insert)(&idx_info, &udata, dset) < 0)
             HGOTO_ERROR(H5E_DATASET, H5E_CANTINSERT, FAIL, "unable to insert chunk addr into index")
     } /* end if */
 
@@ -463,6 +564,192 @@ done:
     FUNC_LEAVE_NOAPI_TAG(ret_value, FAIL)
 } /* end H5D__chunk_direct_write() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_stored_info
+ *
+ * Purpose:	Look up where the chunk at logical OFFSET is stored in the
+ *		file, as written by H5DOwrite_chunk() or the filter
+ *		pipeline.  A dirty copy of the chunk in the chunk cache is
+ *		flushed first, so that the file holds the current data.
+ *
+ *		OFFSET must be the logical position of the first element of
+ *		the chunk, within the dataset's current dimensions.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_stored_info(const H5D_t *dset, hid_t dxpl_id, const hsize_t *offset,
+    H5D_chunk_ud_t *udata)
+{
+    const H5O_layout_t *layout = &(dset->shared->layout);       /* Dataset layout */
+    hsize_t scaled[H5O_LAYOUT_NDIMS];   /* Scaled coordinates for this chunk */
+    unsigned u;                         /* Local index variable */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    HDassert(dset);
+    HDassert(H5D_CHUNKED == layout->type);
+    HDassert(offset);
+    HDassert(udata);
+
+    /* Check the offset & compute the chunk's scaled coordinates */
+    for(u = 0; u < dset->shared->ndims; u++) {
+        if(offset[u] >= dset->shared->curr_dims[u])
+            HGOTO_ERROR(H5E_DATASPACE, H5E_BADRANGE, FAIL, "offset exceeds dimensions of dataset")
+        if(offset[u] % layout->u.chunk.dim[u])
+            HGOTO_ERROR(H5E_DATASPACE, H5E_BADVALUE, FAIL, "offset doesn't fall on chunks's boundary")
+        scaled[u] = offset[u] / layout->u.chunk.dim[u];
+    } /* end for */
+    scaled[dset->shared->ndims] = 0;
+
+    /* No chunk is in the file if the index hasn't been created yet */
+    if(!(*layout->ops->is_space_alloc)(&layout->storage)) {
+        udata->ent = NULL;
+        udata->chunk_block.offset = HADDR_UNDEF;
+        udata->chunk_block.length = 0;
+        udata->filter_mask = 0;
+        HGOTO_DONE(SUCCEED)
+    } /* end if */
+
+    /* Find out the file address of the chunk (if any) */
+    if(H5D__chunk_lookup(dset, dxpl_id, scaled, udata) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "error looking up chunk address")
+
+    /* A cached chunk may not be in the file yet, and the lookup doesn't
+     * return its filter mask, so query the index for it */
+    if(udata->ent) {
+        H5D_chk_idx_info_t idx_info;    /* Chunked index info */
+
+        if(udata->ent->dirty) {
+            H5D_dxpl_cache_t _dxpl_cache;       /* Data transfer property cache buffer */
+            H5D_dxpl_cache_t *dxpl_cache = &_dxpl_cache;   /* Data transfer property cache */
+
+            /* Fill the DXPL cache values for later use */
+            if(H5D__get_dxpl_cache(dxpl_id, &dxpl_cache) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't fill dxpl cache")
+
+            if(H5D__chunk_flush_entry(dset, dxpl_id, dxpl_cache, udata->ent, FALSE, NULL) < 0)
+                HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "cannot flush indexed storage buffer")
+        } /* end if */
+
+        /* Compose chunked index info struct */
+        idx_info.f = dset->oloc.file;
+        idx_info.dxpl_id = dxpl_id;
+        idx_info.pline = &dset->shared->dcpl_cache.pline;
+        idx_info.layout = &dset->shared->layout.u.chunk;
+        idx_info.storage = &dset->shared->layout.storage.u.chunk;
+
+        udata->chunk_block.offset = HADDR_UNDEF;
+        udata->chunk_block.length = 0;
+        udata->filter_mask = 0;
+        if((layout->storage.u.chunk.ops->get_addr)(&idx_info, udata) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't query chunk address")
+    } /* end if */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_stored_info() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_direct_read
+ *
+ * Purpose:	Internal routine to read a chunk as it is stored in the
+ *		file, without running it through the filter pipeline.  The
+ *		chunk's filter mask is returned in FILTERS.
+ *
+ *		The buffer must be large enough for the stored chunk, as
+ *		returned by H5Dget_chunk_storage_size().
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5D__chunk_direct_read(const H5D_t *dset, hid_t dxpl_id, const hsize_t *offset,
+    uint32_t *filters, void *buf)
+{
+    H5D_chunk_ud_t udata;               /* User data for querying chunk info */
+    H5D_io_info_t io_info;              /* to hold the dset and two dxpls (meta and raw data) */
+    hbool_t md_dxpl_generated = FALSE;  /* bool to indicate whether we should free the md_dxpl_id at exit */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_PACKAGE_TAG(dxpl_id, dset->oloc.addr, FAIL)
+
+    HDassert(filters);
+    HDassert(buf);
+
+    io_info.dset = dset;
+    io_info.raw_dxpl_id = dxpl_id;
+    io_info.md_dxpl_id = dxpl_id;
+
+    /* set the dxpl IO type for sanity checking at the FD layer */
+#ifdef H5_DEBUG_BUILD
+    if(H5D_set_io_info_dxpls(&io_info, dxpl_id) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTCOPY, FAIL, "can't set metadata and raw data dxpls")
+    md_dxpl_generated = TRUE;
+#endif /* H5_DEBUG_BUILD */
+
+    /* Find the chunk in the file */
+    if(H5D__chunk_stored_info(dset, io_info.md_dxpl_id, offset, &udata) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't locate chunk")
+    if(!H5F_addr_defined(udata.chunk_block.offset))
+        HGOTO_ERROR(H5E_DATASET, H5E_BADVALUE, FAIL, "chunk storage is not allocated")
+
+    /* Read the chunk */
+    H5_CHECK_OVERFLOW(udata.chunk_block.length, hsize_t, size_t);
+    if(H5F_block_read_private(dset->oloc.file, udata.chunk_block.offset, (size_t)udata.chunk_block.length, io_info.raw_dxpl_id, buf) < 0)
+        HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "unable to read raw data chunk")
+    *filters = udata.filter_mask;
+
+done:
+#ifdef H5_DEBUG_BUILD
+    if(md_dxpl_generated && H5I_dec_ref(io_info.md_dxpl_id) < 0)
+        HDONE_ERROR(H5E_DATASET, H5E_CANTDEC, FAIL, "can't close metadata dxpl")
+#endif /* H5_DEBUG_BUILD */
+    FUNC_LEAVE_NOAPI_TAG(ret_value, FAIL)
+} /* end H5D__chunk_direct_read() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_get_info_by_coord
+ *
+ * Purpose:	Internal routine to get the filter mask, file address and
+ *		stored size of the chunk at logical OFFSET.  A chunk that
+ *		hasn't been allocated has an undefined address and a size
+ *		of zero.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5D__chunk_get_info_by_coord(const H5D_t *dset, hid_t dxpl_id, const hsize_t *offset,
+    unsigned *filter_mask, haddr_t *addr, hsize_t *size)
+{
+    H5D_chunk_ud_t udata;               /* User data for querying chunk info */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_PACKAGE_TAG(dxpl_id, dset->oloc.addr, FAIL)
+
+    if(H5D__chunk_stored_info(dset, dxpl_id, offset, &udata) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't locate chunk")
+
+    if(filter_mask)
+        *filter_mask = udata.filter_mask;
+    if(addr)
+        *addr = udata.chunk_block.offset;
+    if(size)
+        *size = udata.chunk_block.length;
+
+done:
+    FUNC_LEAVE_NOAPI_TAG(ret_value, FAIL)
+} /* end H5D__chunk_get_info_by_coord() */
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5D__chunk_set_info_real
@@ -494,7 +781,10 @@ H5D__chunk_set_info_real(H5O_layout_chunk_t *layout, unsigned ndims,
     for(u = 0, layout->nchunks = 1, layout->max_nchunks = 1; u < ndims; u++) {
         /* Round up to the next integer # of chunks, to accomodate partial chunks */
 	layout->chunks[u] = ((curr_dims[u] + layout->dim[u]) - 1) / layout->dim[u];
-	layout->max_chunks[u] = ((max_dims[u] + layout->dim[u]) - 1) / layout->dim[u];
+        if(H5S_UNLIMITED == max_dims[u])
+            layout->max_chunks[u] = H5S_UNLIMITED;
+        else
+            layout->max_chunks[u] = ((max_dims[u] + layout->dim[u]) - 1) / layout->dim[u];
 
         /* Accumulate the # of chunks */
 	layout->nchunks *= layout->chunks[u];
@@ -620,6 +910,15 @@ H5D__chunk_construct(H5F_t H5_ATTR_UNUSED *f, H5D_t *dset)
     /* Retain computed chunk size */
     H5_CHECKED_ASSIGN(dset->shared->layout.u.chunk.size, uint32_t, chunk_size, uint64_t);
 
+    /* Make certain the encoded chunk dimensions can hold the datatype size also */
+    {
+        unsigned enc_bytes_per_dim;     /* Number of bytes required to encode the datatype size */
+
+        enc_bytes_per_dim = (H5VM_log2_gen((uint64_t)dset->shared->layout.u.chunk.dim[dset->shared->layout.u.chunk.ndims - 1]) + 8) / 8;
+        if(enc_bytes_per_dim > dset->shared->layout.u.chunk.enc_bytes_per_dim)
+            dset->shared->layout.u.chunk.enc_bytes_per_dim = enc_bytes_per_dim;
+    } /* end block */
+
     /* Reset address and pointer of the array struct for the chunked storage index */
     if(H5D_chunk_idx_reset(&dset->shared->layout.storage.u.chunk, TRUE) < 0)
         HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "unable to reset chunked storage index")
@@ -681,9 +980,60 @@ H5D__chunk_init(H5F_t *f, hid_t dxpl_id, const H5D_t *dset, hid_t dapl_id)
     if(!rdcc->nbytes_max || !rdcc->nslots)
         rdcc->nbytes_max = rdcc->nslots = 0;
     else {
+        /* The hash table starts with nslots buckets, and grows with the
+         *      number of entries (ghosts included).  A dataset's own pool
+         *      holds at most nslots chunks. */
         rdcc->slot = H5FL_SEQ_CALLOC(H5D_rdcc_ent_ptr_t, rdcc->nslots);
         if(NULL == rdcc->slot)
             HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed")
+        rdcc->nbuckets = rdcc->nslots;
+
+        /* Use the file's shared memory pool for chunks, if it has one (not
+         *      with parallel I/O, where other processes could be using
+         *      the chunks), otherwise the dataset's own pool.
+         */
+        if(H5F_RDCC_SHARED_NBYTES(f) > 0 && !H5F_HAS_FEATURE(f, H5FD_FEAT_HAS_MPI)) {
+            if(NULL == (rdcc->pool = H5F_RDCC_POOL(f))) {
+                if(NULL == (rdcc->pool = H5FL_CALLOC(H5D_rdcc_pool_t)))
+                    HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for shared chunk cache")
+                rdcc->pool->nbytes_max = H5F_RDCC_SHARED_NBYTES(f);
+                rdcc->pool->shared = TRUE;
+                if(H5F_SET_RDCC_POOL(f, rdcc->pool) < 0)
+                    HGOTO_ERROR(H5E_DATASET, H5E_CANTSET, FAIL, "can't set shared chunk cache")
+            } /* end if */
+        } /* end if */
+        else {
+            rdcc->pool = &rdcc->local_pool;
+            rdcc->pool->nbytes_max = rdcc->nbytes_max;
+            rdcc->pool->nents_max = rdcc->nslots;
+        } /* end else */
+        rdcc->pool->ndsets++;
+        rdcc->owner = dset;
+
+        /* Set up reading chunks ahead & writing them behind (not with
+         *      parallel I/O, where chunks are read & written collectively)
+         */
+        if(!H5F_HAS_FEATURE(f, H5FD_FEAT_HAS_MPI)) {
+            if(H5P_get(dapl, H5D_ACS_CHUNK_PREFETCH_NAME, &rdcc->prefetch.nchunks) < 0)
+                HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get # of chunks to read ahead")
+            if(rdcc->prefetch.nchunks > 0) {
+                if(NULL == (rdcc->prefetch.idx = (hsize_t *)H5MM_malloc(rdcc->prefetch.nchunks * sizeof(hsize_t))))
+                    HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for chunk read-ahead")
+                if(NULL == (rdcc->prefetch.jobs = (H5Z_pipeline_job_t *)H5MM_calloc(rdcc->prefetch.nchunks * sizeof(H5Z_pipeline_job_t))))
+                    HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for chunk read-ahead")
+            } /* end if */
+
+            if(H5P_get(dapl, H5D_ACS_CHUNK_WRITE_BEHIND_NAME, &rdcc->write_behind.nchunks) < 0)
+                HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get # of chunks to write behind")
+            if(rdcc->write_behind.nchunks > 0) {
+                if(NULL == (rdcc->write_behind.ents = (H5D_rdcc_ent_t *)H5MM_malloc(rdcc->write_behind.nchunks * sizeof(H5D_rdcc_ent_t))))
+                    HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for chunk write-behind")
+                if(NULL == (rdcc->write_behind.pending = (H5D_rdcc_ent_t *)H5MM_malloc(rdcc->write_behind.nchunks * sizeof(H5D_rdcc_ent_t))))
+                    HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for chunk write-behind")
+                if(NULL == (rdcc->write_behind.jobs = (H5Z_pipeline_job_t *)H5MM_calloc(rdcc->write_behind.nchunks * sizeof(H5Z_pipeline_job_t))))
+                    HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for chunk write-behind")
+            } /* end if */
+        } /* end if */
 
         /* Reset any cached chunk info for this dataset */
         H5D__chunk_cinfo_cache_reset(&(rdcc->last));
@@ -1813,7 +2163,8 @@ H5D__chunk_cacheable(const H5D_io_info_t *io_info, haddr_t caddr, hbool_t write_
              * cache, just write the data to it directly.
              */
             H5_CHECK_OVERFLOW(dataset->shared->layout.u.chunk.size, uint32_t, size_t);
-            if((size_t)dataset->shared->layout.u.chunk.size > dataset->shared->cache.chunk.nbytes_max) {
+            if(NULL == dataset->shared->cache.chunk.pool
+                    || (size_t)dataset->shared->layout.u.chunk.size > dataset->shared->cache.chunk.pool->nbytes_max) {
                 if(write_op && !H5F_addr_defined(caddr)) {
                     const H5O_fill_t *fill = &(dataset->shared->dcpl_cache.fill); /* Fill value info */
                     H5D_fill_value_t fill_status;    /* Fill value status */
@@ -1871,6 +2222,7 @@ H5D__chunk_read(H5D_io_info_t *io_info, const H5D_type_info_t *type_info,
     hbool_t     cpt_dirty;              /* Temporary placeholder for compact storage "dirty" flag */
     uint32_t    src_accessed_bytes = 0; /* Total accessed size in a chunk */
     hbool_t     skip_missing_chunks = FALSE;    /* Whether to skip missing chunks */
+    H5D_chunk_filt_batch_t batch;       /* Batch of chunks for parallel filter pipeline */
     herr_t	ret_value = SUCCEED;	/*return value		*/
 
     FUNC_ENTER_STATIC
@@ -1901,6 +2253,13 @@ H5D__chunk_read(H5D_io_info_t *io_info, const H5D_type_info_t *type_info,
     /* Initialize temporary compact storage info */
     cpt_store.compact.dirty = &cpt_dirty;
 
+    /* Set up batches of chunks for the parallel filter pipeline, if requested */
+    if(H5D__chunk_filt_batch_init(io_info, &batch, FALSE) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "can't initialize parallel filter pipeline")
+
+    /* Write chunks evicted from the cache behind, if requested */
+    H5D__chunk_write_behind_begin(io_info);
+
     {
         const H5O_fill_t *fill = &(io_info->dset->shared->dcpl_cache.fill);    /* Fill value info */
         H5D_fill_value_t fill_status;       /* Fill value status */
@@ -1924,9 +2283,16 @@ H5D__chunk_read(H5D_io_info_t *io_info, const H5D_type_info_t *type_info,
     while(chunk_node) {
         H5D_chunk_info_t *chunk_info;   /* Chunk information */
         H5D_chunk_ud_t udata;		/* Chunk index pass-through	*/
+        H5Z_pipeline_job_t pf_job;      /* Chunk read ahead */
 
         /* Get the actual chunk information from the skip list node */
         chunk_info = H5D_CHUNK_GET_NODE_INFO(fm, chunk_node);
+        HDmemset(&pf_job, 0, sizeof(pf_job));
+
+        /* Read & filter the next batch of chunks in parallel, when needed */
+        if(batch.jobs && batch.curr == batch.nchunks)
+            if(H5D__chunk_filt_batch_read(io_info, fm, chunk_node, &batch) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "unable to read batch of chunks")
 
         /* Get the info for the chunk in the file */
         if(H5D__chunk_lookup(io_info->dset, io_info->md_dxpl_id, chunk_info->scaled, &udata) < 0)
@@ -1936,8 +2302,14 @@ H5D__chunk_read(H5D_io_info_t *io_info, const H5D_type_info_t *type_info,
         HDassert((H5F_addr_defined(udata.chunk_block.offset) && udata.chunk_block.length > 0) || 
                 (!H5F_addr_defined(udata.chunk_block.offset) && udata.chunk_block.length == 0));
 
+        /* Pick up the chunk if it was read ahead, then read further ahead */
+        if(NULL == udata.ent && H5D__chunk_prefetch_take(io_info->dset, chunk_info->index, &pf_job) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "unable to get chunk read ahead")
+        if(H5D__chunk_prefetch(io_info, fm, (hbool_t)(batch.jobs != NULL), chunk_info->index) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "unable to read chunks ahead")
+
         /* Check for non-existant chunk & skip it if appropriate */
-        if(H5F_addr_defined(udata.chunk_block.offset) || UINT_MAX != udata.idx_hint
+        if(H5F_addr_defined(udata.chunk_block.offset) || NULL != udata.ent
                 || !skip_missing_chunks) {
             H5D_io_info_t *chk_io_info;     /* Pointer to I/O info object for this chunk */
             void *chunk = NULL;             /* Pointer to locked chunk buffer */
@@ -1957,7 +2329,8 @@ H5D__chunk_read(H5D_io_info_t *io_info, const H5D_type_info_t *type_info,
                 src_accessed_bytes = chunk_info->chunk_points * (uint32_t)type_info->src_type_size;
 
                 /* Lock the chunk into the cache */
-                if(NULL == (chunk = H5D__chunk_lock(io_info, &udata, FALSE)))
+                if(NULL == (chunk = H5D__chunk_lock(io_info, &udata, FALSE,
+                        (pf_job.buf ? &pf_job : (batch.jobs ? &batch.jobs[batch.curr] : NULL)))))
                     HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "unable to read raw data chunk")
 
                 /* Set up the storage buffer information for this chunk */
@@ -1988,11 +2361,29 @@ H5D__chunk_read(H5D_io_info_t *io_info, const H5D_type_info_t *type_info,
                 HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "unable to unlock raw data chunk")
         } /* end if */
 
+        /* Release the chunk read ahead, if it wasn't cached */
+        if(pf_job.buf)
+            pf_job.buf = H5D__chunk_mem_xfree(pf_job.buf, &(io_info->dset->shared->dcpl_cache.pline));
+
+        /* Advance to next chunk in batch */
+        if(batch.jobs)
+            batch.curr++;
+
         /* Advance to next chunk in list */
         chunk_node = H5D_CHUNK_GET_NEXT_NODE(fm, chunk_node);
     } /* end while */
 
 done:
+    /* Release the parallel filter pipeline info */
+    if(H5D__chunk_filt_batch_term(io_info, &batch) < 0)
+        HDONE_ERROR(H5E_DATASET, H5E_CANTFREE, FAIL, "can't release parallel filter pipeline info")
+
+    /* Finish the chunks read ahead & written behind */
+    if(H5D__chunk_prefetch_wait(io_info->dset) < 0)
+        HDONE_ERROR(H5E_DATASET, H5E_CANTFILTER, FAIL, "can't wait for chunks read ahead")
+    if(H5D__chunk_write_behind_flush(io_info) < 0)
+        HDONE_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "unable to write behind raw data chunks")
+
     FUNC_LEAVE_NOAPI(ret_value)
 } /* H5D__chunk_read() */
 
@@ -2021,6 +2412,7 @@ H5D__chunk_write(H5D_io_info_t *io_info, const H5D_type_info_t *type_info,
     H5D_storage_t cpt_store;            /* Chunk storage information as compact dataset */
     hbool_t     cpt_dirty;              /* Temporary placeholder for compact storage "dirty" flag */
     uint32_t    dst_accessed_bytes = 0; /* Total accessed size in a chunk */
+    H5D_chunk_filt_batch_t batch;       /* Batch of chunks for parallel filter pipeline */
     herr_t	ret_value = SUCCEED;	/* Return value		*/
 
     FUNC_ENTER_STATIC
@@ -2031,6 +2423,10 @@ H5D__chunk_write(H5D_io_info_t *io_info, const H5D_type_info_t *type_info,
     HDassert(type_info);
     HDassert(fm);
 
+    /* Chunks read ahead may be overwritten */
+    if(H5D__chunk_prefetch_reset(io_info->dset) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTFREE, FAIL, "can't release chunks read ahead")
+
     /* Set up contiguous I/O info object */
     HDmemcpy(&ctg_io_info, io_info, sizeof(ctg_io_info));
     ctg_io_info.store = &ctg_store;
@@ -2047,6 +2443,13 @@ H5D__chunk_write(H5D_io_info_t *io_info, const H5D_type_info_t *type_info,
     /* Initialize temporary compact storage info */
     cpt_store.compact.dirty = &cpt_dirty;
 
+    /* Set up batches of chunks for the parallel filter pipeline, if requested */
+    if(H5D__chunk_filt_batch_init(io_info, &batch, TRUE) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "can't initialize parallel filter pipeline")
+
+    /* Write chunks evicted from the cache behind, if requested */
+    H5D__chunk_write_behind_begin(io_info);
+
     /* Iterate through nodes in chunk skip list */
     chunk_node = H5D_CHUNK_GET_FIRST_NODE(fm);
     while(chunk_node) {
@@ -2091,9 +2494,15 @@ H5D__chunk_write(H5D_io_info_t *io_info, const H5D_type_info_t *type_info,
                 entire_chunk = FALSE;
 
             /* Lock the chunk into the cache */
-            if(NULL == (chunk = H5D__chunk_lock(io_info, &udata, entire_chunk)))
+            if(NULL == (chunk = H5D__chunk_lock(io_info, &udata, entire_chunk, NULL)))
                 HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "unable to read raw data chunk")
 
+            /* Remember cached chunks that are entirely overwritten, so
+             * they can be filtered & flushed along with the rest of the
+             * batch */
+            if(batch.jobs && entire_chunk && udata.ent)
+                batch.full[batch.nfull++] = chunk_info->scaled;
+
             /* Set up the storage buffer information for this chunk */
             cpt_store.compact.buf = chunk;
 
@@ -2142,171 +2551,1223 @@ H5D__chunk_write(H5D_io_info_t *io_info, const H5D_type_info_t *type_info,
 
 	/* Release the cache lock on the chunk, or insert chunk into index. */
 	if(chunk) {
-	    if(H5D__chunk_unlock(io_info, &udata, TRUE, chunk, dst_accessed_bytes) < 0)
-		HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "unable to unlock raw data chunk")
+            if(batch.jobs && NULL == udata.ent) {
+                H5D_rdcc_ent_t *fake_ent = &batch.ents[batch.nents++]; /* "fake" chunk cache entry */
+
+                /* Defer flushing the uncached chunk until the batch is full */
+                HDmemset(fake_ent, 0, sizeof(*fake_ent));
+                fake_ent->dirty = TRUE;
+                HDmemcpy(fake_ent->scaled, udata.common.scaled, sizeof(hsize_t) * io_info->dset->shared->layout.u.chunk.ndims);
+                fake_ent->chunk_idx = udata.chunk_idx;
+                fake_ent->chunk_block.offset = udata.chunk_block.offset;
+                fake_ent->chunk_block.length = udata.chunk_block.length;
+                fake_ent->chunk = (uint8_t *)chunk;
+            } /* end if */
+            else
+                if(H5D__chunk_unlock(io_info, &udata, TRUE, chunk, dst_accessed_bytes) < 0)
+                    HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "unable to unlock raw data chunk")
 	} /* end if */
 	else {
             if(need_insert && io_info->dset->shared->layout.storage.u.chunk.ops->insert)
-                if((io_info->dset->shared->layout.storage.u.chunk.ops->insert)(&idx_info, &udata, NULL) < 0)
+                if((io_info->dset->shared->layout.storage.u.chunk.ops->insert)(&idx_info, &udata, io_info->dset) < 0)
                     HGOTO_ERROR(H5E_DATASET, H5E_CANTINSERT, FAIL, "unable to insert chunk addr into index")
 	} /* end else */
 
+        /* Filter & flush the batch of chunks in parallel, when it's full */
+        if(batch.jobs && (batch.nents + batch.nfull) == batch.max_chunks)
+            if(H5D__chunk_filt_batch_write(io_info, &batch) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "unable to write batch of chunks")
+
         /* Advance to next chunk in list */
         chunk_node = H5D_CHUNK_GET_NEXT_NODE(fm, chunk_node);
     } /* end while */
 
+    /* Filter & flush the final batch of chunks */
+    if(batch.jobs && (batch.nents + batch.nfull) > 0)
+        if(H5D__chunk_filt_batch_write(io_info, &batch) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "unable to write batch of chunks")
+
 done:
+    /* Release the parallel filter pipeline info */
+    if(H5D__chunk_filt_batch_term(io_info, &batch) < 0)
+        HDONE_ERROR(H5E_DATASET, H5E_CANTFREE, FAIL, "can't release parallel filter pipeline info")
+
+    /* Finish the chunks written behind */
+    if(H5D__chunk_write_behind_flush(io_info) < 0)
+        HDONE_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "unable to write behind raw data chunks")
+
     FUNC_LEAVE_NOAPI(ret_value)
 } /* H5D__chunk_write() */
 
-
+
 /*-------------------------------------------------------------------------
- * Function:	H5D__chunk_flush
+ * Function:	H5D__chunk_filt_batch_init
  *
- * Purpose:	Writes all dirty chunks to disk and optionally preempts them
- *		from the cache.
+ * Purpose:	Set up the information for running the filter pipeline on
+ *		batches of chunks in parallel, when the dataset has filters
+ *		and the DXPL asks for more than one filter thread.
+ *		Otherwise, the batch is left empty (with a NULL 'jobs'
+ *		field) and chunks are filtered one at a time.
  *
  * Return:	Non-negative on success/Negative on failure
  *
- * Programmer:	Robb Matzke
- *              Thursday, May 21, 1998
- *
  *-------------------------------------------------------------------------
  */
 static herr_t
-H5D__chunk_flush(H5D_t *dset, hid_t dxpl_id)
+H5D__chunk_filt_batch_init(const H5D_io_info_t *io_info,
+    H5D_chunk_filt_batch_t *batch, hbool_t write_op)
 {
-    H5D_dxpl_cache_t _dxpl_cache;       /* Data transfer property cache buffer */
-    H5D_dxpl_cache_t *dxpl_cache = &_dxpl_cache;   /* Data transfer property cache */
-    H5D_rdcc_t *rdcc = &(dset->shared->cache.chunk);
-    H5D_rdcc_ent_t	*ent, *next;
-    unsigned		nerrors = 0;    /* Count of any errors encountered when flushing chunks */
     herr_t ret_value = SUCCEED;         /* Return value */
 
     FUNC_ENTER_STATIC
 
-    /* Sanity check */
-    HDassert(dset);
-
-    /* Fill the DXPL cache values for later use */
-    if(H5D__get_dxpl_cache(dxpl_id, &dxpl_cache) < 0)
-        HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't fill dxpl cache")
-
-    /* Loop over all entries in the chunk cache */
-    for(ent = rdcc->head; ent; ent = next) {
-	next = ent->next;
-        if(H5D__chunk_flush_entry(dset, dxpl_id, dxpl_cache, ent, FALSE) < 0)
-            nerrors++;
-    } /* end for */
-    if(nerrors)
-	HGOTO_ERROR(H5E_DATASET, H5E_CANTFLUSH, FAIL, "unable to flush one or more raw data chunks")
+    HDassert(io_info);
+    HDassert(batch);
+
+    HDmemset(batch, 0, sizeof(*batch));
+
+    /* Check if the filters should be run in parallel */
+    if(io_info->dxpl_cache->filter_nthreads > 1 &&
+            io_info->dset->shared->dcpl_cache.pline.nused > 0) {
+        batch->max_chunks = (size_t)io_info->dxpl_cache->filter_nthreads * H5D_CHUNK_FILTER_BATCH_FACTOR;
+
+        if(NULL == (batch->jobs = (H5Z_pipeline_job_t *)H5MM_calloc(batch->max_chunks * sizeof(H5Z_pipeline_job_t))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for filter jobs")
+        if(write_op) {
+            if(NULL == (batch->ents = (H5D_rdcc_ent_t *)H5MM_malloc(batch->max_chunks * sizeof(H5D_rdcc_ent_t))))
+                HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for chunk entries")
+            if(NULL == (batch->full = (const hsize_t **)H5MM_malloc(batch->max_chunks * sizeof(hsize_t *))))
+                HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for chunk list")
+        } /* end if */
+        else
+            if(NULL == (batch->reads = (H5D_chunk_filt_read_t *)H5MM_malloc(batch->max_chunks * sizeof(H5D_chunk_filt_read_t))))
+                HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for chunk reads")
+    } /* end if */
 
 done:
+    if(ret_value < 0)
+        H5D__chunk_filt_batch_term(io_info, batch);
+
     FUNC_LEAVE_NOAPI(ret_value)
-} /* end H5D__chunk_flush() */
+} /* end H5D__chunk_filt_batch_init() */
+
 
-
 /*-------------------------------------------------------------------------
- * Function:	H5D__chunk_io_term
+ * Function:	H5D__chunk_filt_batch_term
  *
- * Purpose:	Destroy I/O operation information.
+ * Purpose:	Release the information for running the filter pipeline on
+ *		batches of chunks, including any chunk buffers that haven't
+ *		been consumed (which only happens when an error occurred).
  *
  * Return:	Non-negative on success/Negative on failure
  *
- * Programmer:	Quincey Koziol
- *		Saturday, May 17, 2003
- *
  *-------------------------------------------------------------------------
  */
 static herr_t
-H5D__chunk_io_term(const H5D_chunk_map_t *fm)
+H5D__chunk_filt_batch_term(const H5D_io_info_t *io_info,
+    H5D_chunk_filt_batch_t *batch)
 {
-    herr_t	ret_value = SUCCEED;	/*return value		*/
+    const H5O_pline_t *pline = &(io_info->dset->shared->dcpl_cache.pline);
+    size_t u;                           /* Local index variable */
 
-    FUNC_ENTER_STATIC
+    FUNC_ENTER_STATIC_NOERR
 
-    /* Single element I/O vs. multiple element I/O cleanup */
-    if(fm->use_single) {
-        /* Sanity checks */
-        HDassert(fm->sel_chunks == NULL);
-        HDassert(fm->single_chunk_info);
-        HDassert(fm->single_chunk_info->fspace_shared);
-        HDassert(fm->single_chunk_info->mspace_shared);
+    HDassert(batch);
 
-        /* Reset the selection for the single element I/O */
-        H5S_select_all(fm->single_space, TRUE);
+    if(batch->jobs) {
+        for(u = 0; u < batch->max_chunks; u++)
+            if(batch->jobs[u].buf)
+                batch->jobs[u].buf = H5D__chunk_mem_xfree(batch->jobs[u].buf, pline);
+        batch->jobs = (H5Z_pipeline_job_t *)H5MM_xfree(batch->jobs);
     } /* end if */
-    else {
-        /* Release the nodes on the list of selected chunks */
-        if(fm->sel_chunks)
-            if(H5SL_free(fm->sel_chunks, H5D__free_chunk_info, NULL) < 0)
-                HGOTO_ERROR(H5E_PLIST, H5E_CANTNEXT, FAIL, "can't iterate over chunks")
-    } /* end else */
+    if(batch->ents) {
+        for(u = 0; u < batch->nents; u++)
+            if(batch->ents[u].chunk)
+                batch->ents[u].chunk = (uint8_t *)H5D__chunk_mem_xfree(batch->ents[u].chunk, pline);
+        batch->ents = (H5D_rdcc_ent_t *)H5MM_xfree(batch->ents);
+    } /* end if */
+    batch->full = (const hsize_t **)H5MM_xfree(batch->full);
+    batch->reads = (H5D_chunk_filt_read_t *)H5MM_xfree(batch->reads);
 
-    /* Free the memory chunk dataspace template */
-    if(fm->mchunk_tmpl)
-        if(H5S_close(fm->mchunk_tmpl) < 0)
-            HGOTO_ERROR(H5E_DATASPACE, H5E_CANTRELEASE, FAIL, "can't release memory chunk dataspace template")
-#ifdef H5_HAVE_PARALLEL
-    if(fm->select_chunk)
-        H5MM_xfree(fm->select_chunk);
-#endif /* H5_HAVE_PARALLEL */
+    FUNC_LEAVE_NOAPI(SUCCEED)
+} /* end H5D__chunk_filt_batch_term() */
 
-done:
-    FUNC_LEAVE_NOAPI(ret_value)
-} /* end H5D__chunk_io_term() */
 
-
 /*-------------------------------------------------------------------------
- * Function:	H5D__chunk_dest
- *
- * Purpose:	Destroy the entire chunk cache by flushing dirty entries,
- *		preempting all entries, and freeing the cache itself.
+ * Function:	H5D__chunk_filt_read_cmp
  *
- * Return:	Non-negative on success/Negative on failure
+ * Purpose:	Compare two chunks to read by their address in the file,
+ *		for sorting with HDqsort().
  *
- * Programmer:	Robb Matzke
- *              Thursday, May 21, 1998
+ * Return:	-1, 0, 1 (like strcmp)
  *
  *-------------------------------------------------------------------------
  */
-static herr_t
-H5D__chunk_dest(H5D_t *dset, hid_t dxpl_id)
+static int
+H5D__chunk_filt_read_cmp(const void *_read1, const void *_read2)
 {
-    H5D_chk_idx_info_t idx_info;        /* Chunked index info */
-    H5D_dxpl_cache_t _dxpl_cache;       /* Data transfer property cache buffer */
-    H5D_dxpl_cache_t *dxpl_cache = &_dxpl_cache;   /* Data transfer property cache */
-    H5D_rdcc_t	*rdcc = &(dset->shared->cache.chunk);   /* Dataset's chunk cache */
-    H5D_rdcc_ent_t	*ent = NULL, *next = NULL;      /* Pointer to current & next cache entries */
-    int		nerrors = 0;            /* Accumulated count of errors */
-    H5O_storage_chunk_t *sc = &(dset->shared->layout.storage.u.chunk);
-    herr_t      ret_value = SUCCEED;       /* Return value */
+    const H5D_chunk_filt_read_t *read1 = (const H5D_chunk_filt_read_t *)_read1;
+    const H5D_chunk_filt_read_t *read2 = (const H5D_chunk_filt_read_t *)_read2;
 
-    FUNC_ENTER_STATIC_TAG(dxpl_id, dset->oloc.addr, FAIL)
+    FUNC_ENTER_STATIC_NOERR
 
-    /* Sanity checks */
-    HDassert(dset);
-    H5D_CHUNK_STORAGE_INDEX_CHK(sc);
+    FUNC_LEAVE_NOAPI(H5F_addr_cmp(read1->addr, read2->addr))
+} /* end H5D__chunk_filt_read_cmp() */
 
-    /* Fill the DXPL cache values for later use */
-    if(H5D__get_dxpl_cache(dxpl_id, &dxpl_cache) < 0)
-        nerrors++;
 
-    /* Flush all the cached chunks */
-    for(ent = rdcc->head; ent; ent = next) {
-	next = ent->next;
-	if(H5D__chunk_cache_evict(dset, dxpl_id, dxpl_cache, ent, TRUE) < 0)
-	    nerrors++;
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_filt_batch_read
+ *
+ * Purpose:	Read the next batch of chunks, starting at CHUNK_NODE,
+ *		and run them through the filter pipeline in parallel.
+ *
+ *		Only chunks that exist in the file and aren't already in
+ *		the chunk cache are read.  The chunks are read in file
+ *		address order on the calling thread, then filtered by the
+ *		worker threads.  The unfiltered chunks are left in the
+ *		batch's jobs (one per selected chunk, in the same order as
+ *		the chunk map) for H5D__chunk_lock() to pick up.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_filt_batch_read(const H5D_io_info_t *io_info,
+    const H5D_chunk_map_t *fm, H5SL_node_t *chunk_node,
+    H5D_chunk_filt_batch_t *batch)
+{
+    const H5D_t *dset = io_info->dset;  /* Local pointer to the dataset info */
+    const H5O_pline_t *pline = &(dset->shared->dcpl_cache.pline);    /* I/O pipeline info */
+    size_t nreads = 0;                  /* # of chunks to read */
+    size_t u;                           /* Local index variable */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    HDassert(io_info);
+    HDassert(fm);
+    HDassert(batch);
+    HDassert(batch->jobs);
+    HDassert(batch->reads);
+
+    /* Release any chunks left over from the previous batch */
+    for(u = 0; u < batch->nchunks; u++)
+        if(batch->jobs[u].buf)
+            batch->jobs[u].buf = H5D__chunk_mem_xfree(batch->jobs[u].buf, pline);
+    batch->nchunks = 0;
+    batch->curr = 0;
+
+    /* Find the chunks in the batch that must come from the file */
+    while(chunk_node && batch->nchunks < batch->max_chunks) {
+        H5D_chunk_info_t *chunk_info;   /* Chunk information */
+        H5D_chunk_ud_t udata;		/* Chunk index pass-through	*/
+        H5Z_pipeline_job_t *job = &batch->jobs[batch->nchunks];
+
+        /* Get the actual chunk information from the skip list node */
+        chunk_info = H5D_CHUNK_GET_NODE_INFO(fm, chunk_node);
+
+        /* Get the info for the chunk in the file */
+        if(H5D__chunk_lookup(dset, io_info->md_dxpl_id, chunk_info->scaled, &udata) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "error looking up chunk address")
+
+        HDmemset(job, 0, sizeof(*job));
+        if(NULL == udata.ent && H5F_addr_defined(udata.chunk_block.offset)
+                && H5D__chunk_prefetch_find(&(dset->shared->cache.chunk), chunk_info->index) == dset->shared->cache.chunk.prefetch.nents) {
+            H5_CHECKED_ASSIGN(job->nbytes, size_t, udata.chunk_block.length, hsize_t);
+            job->buf_size = job->nbytes;
+            job->filter_mask = udata.filter_mask;
+            if(NULL == (job->buf = H5D__chunk_mem_alloc(job->nbytes, pline)))
+                HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for raw data chunk")
+
+            batch->reads[nreads].addr = udata.chunk_block.offset;
+            batch->reads[nreads].idx = batch->nchunks;
+            nreads++;
+        } /* end if */
+
+        batch->nchunks++;
+        chunk_node = H5D_CHUNK_GET_NEXT_NODE(fm, chunk_node);
+    } /* end while */
+
+    /* Read the raw chunks, in file order */
+    if(nreads > 1)
+        HDqsort(batch->reads, nreads, sizeof(H5D_chunk_filt_read_t), H5D__chunk_filt_read_cmp);
+    for(u = 0; u < nreads; u++) {
+        H5Z_pipeline_job_t *job = &batch->jobs[batch->reads[u].idx];
+
+        if(H5F_block_read(dset->oloc.file, H5FD_MEM_DRAW, batch->reads[u].addr, job->nbytes, io_info->raw_dxpl_id, job->buf) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "unable to read raw data chunk")
+    } /* end for */
+
+    /* Run the chunks through the pipeline */
+    if(nreads > 0)
+        if(H5Z_pipeline_multi(pline, H5Z_FLAG_REVERSE, io_info->dxpl_cache->err_detect,
+                io_info->dxpl_cache->filter_cb, io_info->dxpl_cache->filter_nthreads,
+                batch->nchunks, batch->jobs) < 0)
+            HGOTO_ERROR(H5E_PLINE, H5E_CANTFILTER, FAIL, "data pipeline read failed")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_filt_batch_read() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_filt_batch_write
+ *
+ * Purpose:	Flush the current batch of written chunks to the file,
+ *		running them through the filter pipeline in parallel.
+ *
+ *		The batch holds chunks that were too large for the chunk
+ *		cache (which would otherwise be flushed as soon as they were
+ *		unlocked), and chunks in the cache that were overwritten
+ *		entirely (which are flushed, but remain in the cache).
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_filt_batch_write(const H5D_io_info_t *io_info,
+    H5D_chunk_filt_batch_t *batch)
+{
+    const H5D_t *dset = io_info->dset;  /* Local pointer to the dataset info */
+    H5D_rdcc_ent_t **ents = NULL;       /* Entries to flush */
+    size_t nents = 0;                   /* # of entries to flush */
+    size_t u;                           /* Local index variable */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    HDassert(io_info);
+    HDassert(batch);
+    HDassert(batch->ents);
+    HDassert(batch->full);
+
+    if(NULL == (ents = (H5D_rdcc_ent_t **)H5MM_malloc((batch->nents + batch->nfull) * sizeof(H5D_rdcc_ent_t *))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for chunk entry list")
+
+    /* Gather the uncached chunks */
+    for(u = 0; u < batch->nents; u++)
+        ents[nents++] = &batch->ents[u];
+
+    /* Gather the overwritten chunks that are still dirty in the cache */
+    for(u = 0; u < batch->nfull; u++) {
+        H5D_chunk_ud_t udata;		/* Chunk index pass-through	*/
+
+        if(H5D__chunk_lookup(dset, io_info->md_dxpl_id, batch->full[u], &udata) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "error looking up chunk address")
+        if(udata.ent && udata.ent->dirty && !udata.ent->locked)
+            ents[nents++] = udata.ent;
+    } /* end for */
+    batch->nfull = 0;
+
+    /* Filter & write the chunks */
+    if(H5D__chunk_flush_entries(dset, io_info->md_dxpl_id, io_info->dxpl_cache, ents, nents) < 0)
+        HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "cannot flush batch of chunks")
+
+done:
+    /* Release the uncached chunks, which are written now (or lost) */
+    for(u = 0; u < batch->nents; u++)
+        if(batch->ents[u].chunk)
+            batch->ents[u].chunk = (uint8_t *)H5D__chunk_mem_xfree(batch->ents[u].chunk, &(dset->shared->dcpl_cache.pline));
+    batch->nents = 0;
+
+    H5MM_xfree(ents);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_filt_batch_write() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_prefetch_drop
+ *
+ * Purpose:	Release the chunks read ahead for a dataset.  Any chunks
+ *		being filtered in the background are waited for first.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_prefetch_drop(const H5D_t *dset)
+{
+    H5D_rdcc_t *rdcc = &(dset->shared->cache.chunk);    /* Raw data chunk cache */
+    size_t u;                           /* Local index variable */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    HDassert(dset);
+
+    /* Wait for the chunks being filtered, ignoring any failure */
+    if(rdcc->prefetch.multi) {
+        if(H5Z_pipeline_multi_wait(rdcc->prefetch.multi) < 0)
+            if(H5E_clear_stack(NULL) < 0)
+                HDONE_ERROR(H5E_DATASET, H5E_CANTRESET, FAIL, "can't clear error stack")
+        rdcc->prefetch.multi = NULL;
+    } /* end if */
+
+    for(u = 0; u < rdcc->prefetch.nents; u++)
+        if(rdcc->prefetch.jobs[u].buf)
+            rdcc->prefetch.jobs[u].buf = H5D__chunk_mem_xfree(rdcc->prefetch.jobs[u].buf, &(dset->shared->dcpl_cache.pline));
+    rdcc->prefetch.nents = 0;
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_prefetch_drop() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_prefetch_reset
+ *
+ * Purpose:	Release the chunks read ahead for a dataset, and forget its
+ *		access pattern.  Called whenever the chunks in the file may
+ *		change, so that stale data isn't returned later.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5D__chunk_prefetch_reset(const H5D_t *dset)
+{
+    H5D_rdcc_t *rdcc = &(dset->shared->cache.chunk);    /* Raw data chunk cache */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    HDassert(dset);
+
+    if(H5D__chunk_prefetch_drop(dset) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTFREE, FAIL, "can't release chunks read ahead")
+    rdcc->prefetch.run = 0;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_prefetch_reset() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_prefetch_wait
+ *
+ * Purpose:	Wait for the chunks read ahead for a dataset to be filtered
+ *		in the background.  If the filter pipeline failed, the
+ *		chunks are dropped, so that they're read again (and the
+ *		failure is reported) when they're accessed.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_prefetch_wait(const H5D_t *dset)
+{
+    H5D_rdcc_t *rdcc = &(dset->shared->cache.chunk);    /* Raw data chunk cache */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    HDassert(dset);
+
+    if(rdcc->prefetch.multi) {
+        herr_t status = H5Z_pipeline_multi_wait(rdcc->prefetch.multi);
+
+        rdcc->prefetch.multi = NULL;
+        if(status < 0) {
+            if(H5E_clear_stack(NULL) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTRESET, FAIL, "can't clear error stack")
+            if(H5D__chunk_prefetch_drop(dset) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTFREE, FAIL, "can't release chunks read ahead")
+        } /* end if */
+    } /* end if */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_prefetch_wait() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_prefetch_find
+ *
+ * Purpose:	Look for the chunk with index IDX among the chunks read
+ *		ahead for a dataset.
+ *
+ * Return:	Position of the chunk, or the number of chunks read ahead
+ *		if it's not one of them
+ *
+ *-------------------------------------------------------------------------
+ */
+static size_t
+H5D__chunk_prefetch_find(const H5D_rdcc_t *rdcc, hsize_t idx)
+{
+    size_t u;                           /* Local index variable */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    HDassert(rdcc);
+
+    for(u = 0; u < rdcc->prefetch.nents; u++)
+        if(rdcc->prefetch.idx[u] == idx)
+            break;
+
+    FUNC_LEAVE_NOAPI(u)
+} /* end H5D__chunk_prefetch_find() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_prefetch_take
+ *
+ * Purpose:	Take the chunk with index IDX from the chunks read ahead
+ *		for a dataset, if it's one of them, waiting for it to be
+ *		filtered if necessary.  The unfiltered chunk is moved into
+ *		JOB, for H5D__chunk_lock() to pick up.
+ *
+ * Return:	TRUE if the chunk was taken, FALSE if it wasn't read
+ *		ahead/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static htri_t
+H5D__chunk_prefetch_take(const H5D_t *dset, hsize_t idx, H5Z_pipeline_job_t *job)
+{
+    H5D_rdcc_t *rdcc = &(dset->shared->cache.chunk);    /* Raw data chunk cache */
+    size_t u;                           /* Position of chunk */
+    htri_t ret_value = FALSE;           /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    HDassert(dset);
+    HDassert(job);
+    HDassert(NULL == job->buf);
+
+    if(H5D__chunk_prefetch_find(rdcc, idx) < rdcc->prefetch.nents) {
+        /* Wait for the chunk to be filtered */
+        if(H5D__chunk_prefetch_wait(dset) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTFILTER, FAIL, "can't wait for chunks read ahead")
+
+        /* Take the chunk, unless it was dropped */
+        if((u = H5D__chunk_prefetch_find(rdcc, idx)) < rdcc->prefetch.nents) {
+            *job = rdcc->prefetch.jobs[u];
+            rdcc->prefetch.jobs[u].buf = NULL;
+            rdcc->prefetch.idx[u] = H5D_CHUNK_PREFETCH_USED;
+            rdcc->stats.nprefetch_hits++;
+            ret_value = TRUE;
+        } /* end if */
+    } /* end if */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_prefetch_take() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_prefetch
+ *
+ * Purpose:	Track the pattern of accesses to a dataset's chunks, given
+ *		the index IDX of the chunk accessed now, and read chunks
+ *		ahead when they are accessed sequentially.
+ *
+ *		Once H5D_CHUNK_PREFETCH_MIN_RUN chunks have been accessed
+ *		with a constant stride through the chunk indices and the
+ *		chunks read ahead before are used up, the next chunks along
+ *		the stride that exist in the file and aren't in the cache
+ *		are read, in file address order.  They're then run through
+ *		the filter pipeline by worker threads in the background,
+ *		while the calling thread carries on with the I/O operation.
+ *		The I/O operation waits for them before returning, with
+ *		H5D__chunk_prefetch_wait().
+ *
+ *		When SKIP_SEL is set, chunks selected in FM for the current
+ *		I/O operation aren't read ahead.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_prefetch(const H5D_io_info_t *io_info, const H5D_chunk_map_t *fm,
+    hbool_t skip_sel, hsize_t idx)
+{
+    const H5D_t *dset = io_info->dset;  /* Local pointer to the dataset info */
+    const H5O_pline_t *pline = &(dset->shared->dcpl_cache.pline);    /* I/O pipeline info */
+    const H5O_layout_chunk_t *layout = &(dset->shared->layout.u.chunk);  /* Chunk layout */
+    H5D_rdcc_t *rdcc = &(dset->shared->cache.chunk);    /* Raw data chunk cache */
+    H5D_chunk_filt_read_t *reads = NULL; /* Chunks to read from the file */
+    size_t nreads = 0;                  /* # of chunks to read */
+    hssize_t stride;                    /* Difference from last chunk index */
+    hsize_t target;                     /* Index of chunk to read ahead */
+    size_t u;                           /* Local index variable */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    HDassert(io_info);
+    HDassert(fm);
+
+    if(0 == rdcc->prefetch.nchunks)
+        HGOTO_DONE(SUCCEED)
+
+    /* Track the access pattern, ignoring repeated accesses to a chunk */
+    if(rdcc->prefetch.run > 0 && idx == rdcc->prefetch.last)
+        HGOTO_DONE(SUCCEED)
+    stride = (hssize_t)idx - (hssize_t)rdcc->prefetch.last;
+    if(0 == rdcc->prefetch.run)
+        rdcc->prefetch.run = 1;
+    else if(rdcc->prefetch.run > 1 && stride == rdcc->prefetch.stride)
+        rdcc->prefetch.run++;
+    else {
+        rdcc->prefetch.stride = stride;
+        rdcc->prefetch.run = 2;
+    } /* end else */
+    rdcc->prefetch.last = idx;
+    if(rdcc->prefetch.run < H5D_CHUNK_PREFETCH_MIN_RUN || rdcc->prefetch.multi)
+        HGOTO_DONE(SUCCEED)
+    stride = rdcc->prefetch.stride;
+
+    /* Wait until the chunks still ahead of the access pattern are used */
+    for(u = 0; u < rdcc->prefetch.nents; u++)
+        if(rdcc->prefetch.idx[u] != H5D_CHUNK_PREFETCH_USED) {
+            hssize_t dist = (hssize_t)rdcc->prefetch.idx[u] - (hssize_t)idx;
+
+            if(0 == (dist % stride) && (dist / stride) > 0)
+                HGOTO_DONE(SUCCEED)
+        } /* end if */
+    if(H5D__chunk_prefetch_drop(dset) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTFREE, FAIL, "can't release chunks read ahead")
+
+    if(NULL == (reads = (H5D_chunk_filt_read_t *)H5MM_malloc(rdcc->prefetch.nchunks * sizeof(H5D_chunk_filt_read_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for chunk reads")
+
+    /* Find the chunks to read */
+    target = idx;
+    for(u = 0; u < rdcc->prefetch.nchunks; u++) {
+        hsize_t scaled[H5O_LAYOUT_NDIMS];       /* Scaled coordinates of chunk */
+        H5D_chunk_ud_t udata;                   /* Chunk index pass-through */
+        H5Z_pipeline_job_t *job;                /* Chunk to read */
+
+        /* Stop at the edge of the dataset */
+        if(stride < 0 ? target < (hsize_t)(-stride) : (target + (hsize_t)stride) >= layout->nchunks)
+            break;
+        target = (hsize_t)((hssize_t)target + stride);
+
+        /* Skip chunks that the current I/O operation reads anyway */
+        if(skip_sel && !fm->use_single && NULL != H5SL_search(fm->sel_chunks, &target))
+            continue;
+
+        /* Get the info for the chunk in the file */
+        if(H5VM_array_calc_pre(target, layout->ndims - 1, layout->down_chunks, scaled) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't compute chunk coordinates")
+        scaled[layout->ndims - 1] = 0;
+        if(H5D__chunk_lookup(dset, io_info->md_dxpl_id, scaled, &udata) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "error looking up chunk address")
+        if(udata.ent || !H5F_addr_defined(udata.chunk_block.offset))
+            continue;
+
+        job = &rdcc->prefetch.jobs[rdcc->prefetch.nents];
+        HDmemset(job, 0, sizeof(*job));
+        H5_CHECKED_ASSIGN(job->nbytes, size_t, udata.chunk_block.length, hsize_t);
+        job->buf_size = job->nbytes;
+        job->filter_mask = udata.filter_mask;
+        if(NULL == (job->buf = H5D__chunk_mem_alloc(job->nbytes, pline)))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for raw data chunk")
+        rdcc->prefetch.idx[rdcc->prefetch.nents] = target;
+
+        reads[nreads].addr = udata.chunk_block.offset;
+        reads[nreads].idx = rdcc->prefetch.nents;
+        nreads++;
+        rdcc->prefetch.nents++;
+    } /* end for */
+
+    /* Read the raw chunks, in file order */
+    if(nreads > 1)
+        HDqsort(reads, nreads, sizeof(H5D_chunk_filt_read_t), H5D__chunk_filt_read_cmp);
+    for(u = 0; u < nreads; u++) {
+        H5Z_pipeline_job_t *job = &rdcc->prefetch.jobs[reads[u].idx];
+
+        if(H5F_block_read(dset->oloc.file, H5FD_MEM_DRAW, reads[u].addr, job->nbytes, io_info->raw_dxpl_id, job->buf) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "unable to read raw data chunk")
+    } /* end for */
+    rdcc->stats.nprefetches += nreads;
+
+    /* Start running the chunks through the pipeline */
+    if(nreads > 0 && pline->nused)
+        if(NULL == (rdcc->prefetch.multi = H5Z_pipeline_multi_start(pline, H5Z_FLAG_REVERSE,
+                io_info->dxpl_cache->err_detect, io_info->dxpl_cache->filter_cb,
+                MAX(io_info->dxpl_cache->filter_nthreads, 1), rdcc->prefetch.nents,
+                rdcc->prefetch.jobs)))
+            HGOTO_ERROR(H5E_PLINE, H5E_CANTFILTER, FAIL, "can't start filtering chunks read ahead")
+
+done:
+    if(ret_value < 0)
+        if(H5D__chunk_prefetch_drop(dset) < 0)
+            HDONE_ERROR(H5E_DATASET, H5E_CANTFREE, FAIL, "can't release chunks read ahead")
+    H5MM_xfree(reads);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_prefetch() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_write_behind_finish
+ *
+ * Purpose:	Wait for the chunks pending write-behind to be filtered in
+ *		the background, then write them to the file.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_write_behind_finish(const H5D_t *dset, hid_t dxpl_id,
+    const H5D_dxpl_cache_t *dxpl_cache)
+{
+    H5D_rdcc_t *rdcc = &(dset->shared->cache.chunk);    /* Raw data chunk cache */
+    unsigned nerrors = 0;               /* Count of chunks that couldn't be written */
+    size_t u;                           /* Local index variable */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    HDassert(dset);
+    HDassert(dxpl_cache);
+
+    if(rdcc->write_behind.multi) {
+        /* Failures are counted for each chunk below */
+        if(H5Z_pipeline_multi_wait(rdcc->write_behind.multi) < 0)
+            if(H5E_clear_stack(NULL) < 0)
+                HDONE_ERROR(H5E_DATASET, H5E_CANTRESET, FAIL, "can't clear error stack")
+        rdcc->write_behind.multi = NULL;
+    } /* end if */
+
+    for(u = 0; u < rdcc->write_behind.npending; u++) {
+        H5Z_pipeline_job_t *job = &rdcc->write_behind.jobs[u];
+
+        /* A chunk that couldn't be filtered is lost */
+        if(job->status < 0)
+            nerrors++;
+        else if(H5D__chunk_flush_entry(dset, dxpl_id, dxpl_cache, &rdcc->write_behind.pending[u], TRUE, job) < 0)
+            nerrors++;
+        else
+            rdcc->stats.nwrite_behinds++;
+        job->buf = H5MM_xfree(job->buf);
+    } /* end for */
+    rdcc->write_behind.npending = 0;
+
+    if(nerrors)
+        HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "unable to write behind one or more raw data chunks")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_write_behind_finish() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_write_behind_start
+ *
+ * Purpose:	Write the chunks pending write-behind, then start filtering
+ *		the chunks collected since in the background.  If the
+ *		filtering can't be started, the chunks are filtered when
+ *		they're written.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_write_behind_start(const H5D_t *dset, hid_t dxpl_id,
+    const H5D_dxpl_cache_t *dxpl_cache)
+{
+    H5D_rdcc_t *rdcc = &(dset->shared->cache.chunk);    /* Raw data chunk cache */
+    H5D_rdcc_ent_t *tmp;                /* Temporary pointer for swapping lists */
+    size_t chunk_size;                  /* Size of a chunk */
+    size_t u;                           /* Local index variable */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    HDassert(dset);
+    HDassert(dxpl_cache);
+
+    if(0 == rdcc->write_behind.nents)
+        HGOTO_DONE(SUCCEED)
+
+    /* Write the chunks filtered before (the collected chunks become
+     *  pending even if that fails, so they aren't lost) */
+    if(H5D__chunk_write_behind_finish(dset, dxpl_id, dxpl_cache) < 0)
+        HDONE_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "unable to write behind raw data chunks")
+
+    /* The collected chunks are pending now */
+    tmp = rdcc->write_behind.pending;
+    rdcc->write_behind.pending = rdcc->write_behind.ents;
+    rdcc->write_behind.ents = tmp;
+    rdcc->write_behind.npending = rdcc->write_behind.nents;
+    rdcc->write_behind.nents = 0;
+
+    /* Set up a filter job for each chunk */
+    H5_CHECKED_ASSIGN(chunk_size, size_t, dset->shared->layout.u.chunk.size, uint32_t);
+    for(u = 0; u < rdcc->write_behind.npending; u++) {
+        H5Z_pipeline_job_t *job = &rdcc->write_behind.jobs[u];
+
+        HDmemset(job, 0, sizeof(*job));
+        job->buf = rdcc->write_behind.pending[u].chunk;
+        job->nbytes = job->buf_size = chunk_size;
+        rdcc->write_behind.pending[u].chunk = NULL;
+    } /* end for */
+
+    /* Start filtering the chunks */
+    if(NULL == (rdcc->write_behind.multi = H5Z_pipeline_multi_start(&(dset->shared->dcpl_cache.pline),
+            0, dxpl_cache->err_detect, dxpl_cache->filter_cb,
+            MAX(dxpl_cache->filter_nthreads, 1), rdcc->write_behind.npending,
+            rdcc->write_behind.jobs))) {
+        if(H5E_clear_stack(NULL) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTRESET, FAIL, "can't clear error stack")
+
+        /* Leave the chunks for H5D__chunk_flush_entry() to filter */
+        for(u = 0; u < rdcc->write_behind.npending; u++) {
+            rdcc->write_behind.pending[u].chunk = (uint8_t *)rdcc->write_behind.jobs[u].buf;
+            rdcc->write_behind.jobs[u].buf = NULL;
+        } /* end for */
+    } /* end if */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_write_behind_start() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_write_behind_add
+ *
+ * Purpose:	Collect a dirty chunk being evicted from the cache, to be
+ *		written behind, when write-behind is active for the
+ *		dataset.  The chunk's buffer is taken from ENT, which is
+ *		marked clean.  Once enough chunks have been collected,
+ *		they're filtered in the background.
+ *
+ * Return:	TRUE if the chunk was collected, FALSE if it must be
+ *		written now/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static htri_t
+H5D__chunk_write_behind_add(const H5D_t *dset, hid_t dxpl_id,
+    const H5D_dxpl_cache_t *dxpl_cache, H5D_rdcc_ent_t *ent)
+{
+    H5D_rdcc_t *rdcc = &(dset->shared->cache.chunk);    /* Raw data chunk cache */
+    htri_t ret_value = FALSE;           /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    HDassert(dset);
+    HDassert(ent);
+    HDassert(!ent->locked);
+
+    if(!rdcc->write_behind.active || !ent->dirty || ent->shared != dset->shared)
+        HGOTO_DONE(FALSE)
+    HDassert(rdcc->write_behind.nents < rdcc->write_behind.nchunks);
+
+    /* Take the chunk */
+    rdcc->write_behind.ents[rdcc->write_behind.nents++] = *ent;
+    ent->chunk = NULL;
+    ent->dirty = FALSE;
+    ret_value = TRUE;
+
+    /* Start filtering the chunks collected */
+    if(rdcc->write_behind.nents == rdcc->write_behind.nchunks)
+        if(H5D__chunk_write_behind_start(dset, dxpl_id, dxpl_cache) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "unable to write behind raw data chunks")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_write_behind_add() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_write_behind_drain
+ *
+ * Purpose:	Write all the chunks collected for write-behind or pending
+ *		write-behind to the file.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_write_behind_drain(const H5D_t *dset, hid_t dxpl_id,
+    const H5D_dxpl_cache_t *dxpl_cache)
+{
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    HDassert(dset);
+    HDassert(dxpl_cache);
+
+    /* Move the collected chunks along, then write everything */
+    if(H5D__chunk_write_behind_start(dset, dxpl_id, dxpl_cache) < 0)
+        HDONE_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "unable to write behind raw data chunks")
+    if(H5D__chunk_write_behind_finish(dset, dxpl_id, dxpl_cache) < 0)
+        HDONE_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "unable to write behind raw data chunks")
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_write_behind_drain() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_write_behind_has
+ *
+ * Purpose:	Check if a chunk is collected for write-behind or pending
+ *		write-behind, so that it's not in the file yet.
+ *
+ * Return:	TRUE/FALSE
+ *
+ *-------------------------------------------------------------------------
+ */
+static hbool_t
+H5D__chunk_write_behind_has(const H5D_shared_t *shared, const hsize_t *scaled)
+{
+    const H5D_rdcc_t *rdcc = &(shared->cache.chunk);    /* Raw data chunk cache */
+    unsigned ndims = shared->layout.u.chunk.ndims - 1;  /* # of chunk dimensions */
+    size_t u;                           /* Local index variable */
+    hbool_t ret_value = FALSE;          /* Return value */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    for(u = 0; u < rdcc->write_behind.nents && !ret_value; u++)
+        if(0 == HDmemcmp(rdcc->write_behind.ents[u].scaled, scaled, ndims * sizeof(hsize_t)))
+            ret_value = TRUE;
+    for(u = 0; u < rdcc->write_behind.npending && !ret_value; u++)
+        if(0 == HDmemcmp(rdcc->write_behind.pending[u].scaled, scaled, ndims * sizeof(hsize_t)))
+            ret_value = TRUE;
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_write_behind_has() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_write_behind_begin
+ *
+ * Purpose:	Start collecting chunks evicted from the cache during an
+ *		I/O operation, to be written behind, if that's enabled for
+ *		the dataset and it has filters to run in the background.
+ *
+ * Return:	void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5D__chunk_write_behind_begin(const H5D_io_info_t *io_info)
+{
+    H5D_rdcc_t *rdcc = &(io_info->dset->shared->cache.chunk);   /* Raw data chunk cache */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    HDassert(0 == rdcc->write_behind.nents && 0 == rdcc->write_behind.npending);
+
+    if(rdcc->write_behind.nchunks > 0 && io_info->dset->shared->dcpl_cache.pline.nused > 0) {
+        rdcc->write_behind.active = TRUE;
+        rdcc->write_behind.dxpl_id = io_info->md_dxpl_id;
+        rdcc->write_behind.dxpl_cache = io_info->dxpl_cache;
+    } /* end if */
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5D__chunk_write_behind_begin() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_write_behind_flush
+ *
+ * Purpose:	Stop collecting chunks evicted from the cache at the end of
+ *		an I/O operation, and write all the chunks collected.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_write_behind_flush(const H5D_io_info_t *io_info)
+{
+    H5D_rdcc_t *rdcc = &(io_info->dset->shared->cache.chunk);   /* Raw data chunk cache */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    if(rdcc->write_behind.active) {
+        rdcc->write_behind.active = FALSE;
+        if(H5D__chunk_write_behind_drain(io_info->dset, rdcc->write_behind.dxpl_id, rdcc->write_behind.dxpl_cache) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "unable to write behind raw data chunks")
+        rdcc->write_behind.dxpl_cache = NULL;
+    } /* end if */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_write_behind_flush() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_flush
+ *
+ * Purpose:	Writes all dirty chunks to disk and optionally preempts them
+ *		from the cache.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ * Programmer:	Robb Matzke
+ *              Thursday, May 21, 1998
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_flush(H5D_t *dset, hid_t dxpl_id)
+{
+    H5D_dxpl_cache_t _dxpl_cache;       /* Data transfer property cache buffer */
+    H5D_dxpl_cache_t *dxpl_cache = &_dxpl_cache;   /* Data transfer property cache */
+    H5D_rdcc_t *rdcc = &(dset->shared->cache.chunk);
+    H5D_rdcc_ent_t	*ent, *next;
+    H5D_rdcc_ent_t	**ents = NULL;  /* Entries to flush in parallel */
+    unsigned		nerrors = 0;    /* Count of any errors encountered when flushing chunks */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Sanity check */
+    HDassert(dset);
+
+    /* Fill the DXPL cache values for later use */
+    if(H5D__get_dxpl_cache(dxpl_id, &dxpl_cache) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't fill dxpl cache")
+
+    /* Check for running the filter pipeline on the chunks in parallel */
+    if(dxpl_cache->filter_nthreads > 1 && dset->shared->dcpl_cache.pline.nused > 0
+            && rdcc->nused > 0) {
+        size_t nents = 0;               /* # of entries to flush */
+
+        /* Gather the entries in the chunk cache */
+        if(NULL == (ents = (H5D_rdcc_ent_t **)H5MM_malloc(rdcc->nused * sizeof(H5D_rdcc_ent_t *))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for chunk entry list")
+        for(ent = rdcc->head; ent; ent = ent->next)
+            ents[nents++] = ent;
+
+        if(H5D__chunk_flush_entries(dset, dxpl_id, dxpl_cache, ents, nents) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTFLUSH, FAIL, "unable to flush one or more raw data chunks")
+    } /* end if */
+    else {
+        /* Loop over all entries in the chunk cache */
+        for(ent = rdcc->head; ent; ent = next) {
+            next = ent->next;
+            if(H5D__chunk_flush_entry(dset, dxpl_id, dxpl_cache, ent, FALSE, NULL) < 0)
+                nerrors++;
+        } /* end for */
+        if(nerrors)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTFLUSH, FAIL, "unable to flush one or more raw data chunks")
+    } /* end else */
+
+done:
+    H5MM_xfree(ents);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_flush() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_io_term
+ *
+ * Purpose:	Destroy I/O operation information.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ * Programmer:	Quincey Koziol
+ *		Saturday, May 17, 2003
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_io_term(const H5D_chunk_map_t *fm)
+{
+    herr_t	ret_value = SUCCEED;	/*return value		*/
+
+    FUNC_ENTER_STATIC
+
+    /* Single element I/O vs. multiple element I/O cleanup */
+    if(fm->use_single) {
+        /* Sanity checks */
+        HDassert(fm->sel_chunks == NULL);
+        HDassert(fm->single_chunk_info);
+        HDassert(fm->single_chunk_info->fspace_shared);
+        HDassert(fm->single_chunk_info->mspace_shared);
+
+        /* Reset the selection for the single element I/O */
+        H5S_select_all(fm->single_space, TRUE);
+    } /* end if */
+    else {
+        /* Release the nodes on the list of selected chunks */
+        if(fm->sel_chunks)
+            if(H5SL_free(fm->sel_chunks, H5D__free_chunk_info, NULL) < 0)
+                HGOTO_ERROR(H5E_PLIST, H5E_CANTNEXT, FAIL, "can't iterate over chunks")
+    } /* end else */
+
+    /* Free the memory chunk dataspace template */
+    if(fm->mchunk_tmpl)
+        if(H5S_close(fm->mchunk_tmpl) < 0)
+            HGOTO_ERROR(H5E_DATASPACE, H5E_CANTRELEASE, FAIL, "can't release memory chunk dataspace template")
+#ifdef H5_HAVE_PARALLEL
+    if(fm->select_chunk)
+        H5MM_xfree(fm->select_chunk);
+#endif /* H5_HAVE_PARALLEL */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_io_term() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_dest
+ *
+ * Purpose:	Destroy the entire chunk cache by flushing dirty entries,
+ *		preempting all entries, and freeing the cache itself.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ * Programmer:	Robb Matzke
+ *              Thursday, May 21, 1998
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_dest(H5D_t *dset, hid_t dxpl_id)
+{
+    H5D_chk_idx_info_t idx_info;        /* Chunked index info */
+    H5D_dxpl_cache_t _dxpl_cache;       /* Data transfer property cache buffer */
+    H5D_dxpl_cache_t *dxpl_cache = &_dxpl_cache;   /* Data transfer property cache */
+    H5D_rdcc_t	*rdcc = &(dset->shared->cache.chunk);   /* Dataset's chunk cache */
+    H5D_rdcc_ent_t	*ent = NULL, *next = NULL;      /* Pointer to current & next cache entries */
+    int		nerrors = 0;            /* Accumulated count of errors */
+    H5O_storage_chunk_t *sc = &(dset->shared->layout.storage.u.chunk);
+    herr_t      ret_value = SUCCEED;       /* Return value */
+
+    FUNC_ENTER_STATIC_TAG(dxpl_id, dset->oloc.addr, FAIL)
+
+    /* Sanity checks */
+    HDassert(dset);
+    H5D_CHUNK_STORAGE_INDEX_CHK(sc);
+
+    /* Fill the DXPL cache values for later use */
+    if(H5D__get_dxpl_cache(dxpl_id, &dxpl_cache) < 0)
+        nerrors++;
+
+    /* Flush all the cached chunks */
+    for(ent = rdcc->head; ent; ent = next) {
+	next = ent->next;
+	if(H5D__chunk_cache_evict(dset, dxpl_id, dxpl_cache, ent, TRUE) < 0)
+	    nerrors++;
+    } /* end for */
+    
+    /* Continue even if there are failures. */
+    if(nerrors)
+	HDONE_ERROR(H5E_IO, H5E_CANTFLUSH, FAIL, "unable to flush one or more raw data chunks")
+
+    /* Release the chunks read ahead & the write-behind buffers */
+    if(H5D__chunk_prefetch_reset(dset) < 0)
+        HDONE_ERROR(H5E_DATASET, H5E_CANTFREE, FAIL, "can't release chunks read ahead")
+    rdcc->prefetch.idx = (hsize_t *)H5MM_xfree(rdcc->prefetch.idx);
+    rdcc->prefetch.jobs = (H5Z_pipeline_job_t *)H5MM_xfree(rdcc->prefetch.jobs);
+    HDassert(0 == rdcc->write_behind.nents && 0 == rdcc->write_behind.npending);
+    rdcc->write_behind.ents = (H5D_rdcc_ent_t *)H5MM_xfree(rdcc->write_behind.ents);
+    rdcc->write_behind.pending = (H5D_rdcc_ent_t *)H5MM_xfree(rdcc->write_behind.pending);
+    rdcc->write_behind.jobs = (H5Z_pipeline_job_t *)H5MM_xfree(rdcc->write_behind.jobs);
+
+    /* Release cache structures, along with the ghosts of evicted chunks
+     *  still in the hash table */
+    if(rdcc->slot) {
+        size_t u;                       /* Local index variable */
+
+        for(u = 0; u < rdcc->nbuckets; u++)
+            while(rdcc->slot[u])
+                H5D__chunk_cache_drop_ghost(rdcc->pool, rdcc->slot[u]);
+        rdcc->slot = H5FL_SEQ_FREE(H5D_rdcc_ent_ptr_t, rdcc->slot);
+    } /* end if */
+
+    /* Stop using the memory pool, releasing a file's shared pool with the
+     *  last dataset using it */
+    if(rdcc->pool) {
+        HDassert(rdcc->pool->ndsets > 0);
+        if(0 == --rdcc->pool->ndsets && rdcc->pool->shared) {
+            HDassert(0 == rdcc->pool->nbytes_used);
+            if(H5F_SET_RDCC_POOL(dset->oloc.file, NULL) < 0)
+                HDONE_ERROR(H5E_DATASET, H5E_CANTSET, FAIL, "can't reset shared chunk cache")
+            rdcc->pool = H5FL_FREE(H5D_rdcc_pool_t, rdcc->pool);
+        } /* end if */
+    } /* end if */
+    HDmemset(rdcc, 0, sizeof(H5D_rdcc_t));
+
+    /* Compose chunked index info struct */
+    idx_info.f = dset->oloc.file;
+    idx_info.dxpl_id = dxpl_id;
+    idx_info.pline = &dset->shared->dcpl_cache.pline;
+    idx_info.layout = &dset->shared->layout.u.chunk;
+    idx_info.storage = &dset->shared->layout.storage.u.chunk;
+
+    /* Free any index structures */
+    if(dset->shared->layout.storage.u.chunk.ops->dest &&
+            (dset->shared->layout.storage.u.chunk.ops->dest)(&idx_info) < 0)
+	HGOTO_ERROR(H5E_DATASET, H5E_CANTFREE, FAIL, "unable to release chunk index info")
+
+done:
+    FUNC_LEAVE_NOAPI_TAG(ret_value, FAIL)
+} /* end H5D__chunk_dest() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_release
+ *
+ * Purpose:	Release the raw data chunks, the history of evicted chunks
+ *		and the chunk index structures cached for a dataset, so
+ *		that a SWMR reader sees chunks the writer has since added.
+ *		Unlike H5D__chunk_dest(), the chunk cache itself stays set
+ *		up; H5D__chunk_refresh() re-initializes the index.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5D__chunk_release(H5D_t *dset, hid_t dxpl_id)
+{
+    H5D_chk_idx_info_t idx_info;        /* Chunked index info */
+    H5D_dxpl_cache_t _dxpl_cache;       /* Data transfer property cache buffer */
+    H5D_dxpl_cache_t *dxpl_cache = &_dxpl_cache;   /* Data transfer property cache */
+    H5D_rdcc_t	*rdcc = &(dset->shared->cache.chunk);   /* Dataset's chunk cache */
+    H5D_rdcc_ent_t	*ent, *next;    /* Pointer to current & next cache entries */
+    herr_t      ret_value = SUCCEED;       /* Return value */
+
+    FUNC_ENTER_PACKAGE_TAG(dxpl_id, dset->oloc.addr, FAIL)
+
+    /* Sanity checks */
+    HDassert(dset);
+    H5D_CHUNK_STORAGE_INDEX_CHK(&(dset->shared->layout.storage.u.chunk));
+
+    /* Fill the DXPL cache values for later use */
+    if(H5D__get_dxpl_cache(dxpl_id, &dxpl_cache) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't fill dxpl cache")
+
+    /* Release the chunks read ahead */
+    if(H5D__chunk_prefetch_reset(dset) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTFREE, FAIL, "can't release chunks read ahead")
+
+    /* Evict all the cached chunks */
+    for(ent = rdcc->head; ent; ent = next) {
+	next = ent->next;
+	if(H5D__chunk_cache_evict(dset, dxpl_id, dxpl_cache, ent, TRUE) < 0)
+	    HGOTO_ERROR(H5E_IO, H5E_CANTFLUSH, FAIL, "unable to flush one or more raw data chunks")
     } /* end for */
-    
-    /* Continue even if there are failures. */
-    if(nerrors)
-	HDONE_ERROR(H5E_IO, H5E_CANTFLUSH, FAIL, "unable to flush one or more raw data chunks")
 
-    /* Release cache structures */
-    if(rdcc->slot)
-        rdcc->slot = H5FL_SEQ_FREE(H5D_rdcc_ent_ptr_t, rdcc->slot);
-    HDmemset(rdcc, 0, sizeof(H5D_rdcc_t));
+    /* Forget the evicted chunks, their addresses may be out of date */
+    if(rdcc->slot) {
+        size_t u;                       /* Local index variable */
+
+        for(u = 0; u < rdcc->nbuckets; u++)
+            while(rdcc->slot[u])
+                H5D__chunk_cache_drop_ghost(rdcc->pool, rdcc->slot[u]);
+    } /* end if */
+    H5D__chunk_cinfo_cache_reset(&(rdcc->last));
 
     /* Compose chunked index info struct */
     idx_info.f = dset->oloc.file;
@@ -2322,7 +3783,62 @@ H5D__chunk_dest(H5D_t *dset, hid_t dxpl_id)
 
 done:
     FUNC_LEAVE_NOAPI_TAG(ret_value, FAIL)
-} /* end H5D__chunk_dest() */
+} /* end H5D__chunk_release() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_refresh
+ *
+ * Purpose:	Re-initialize the chunk index and the scaled dimension
+ *		info of a dataset released with H5D__chunk_release(),
+ *		after its dataspace and layout have been re-read.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5D__chunk_refresh(H5D_t *dset, hid_t dxpl_id)
+{
+    H5D_chk_idx_info_t idx_info;        /* Chunked index info */
+    H5D_rdcc_t	*rdcc = &(dset->shared->cache.chunk);   /* Dataset's chunk cache */
+    herr_t      ret_value = SUCCEED;       /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    /* Sanity checks */
+    HDassert(dset);
+    HDassert(NULL == rdcc->head);
+
+    /* Compute scaled dimension info, if dataset dims > 1 */
+    if(dset->shared->ndims > 1) {
+        unsigned u;                         /* Local index value */
+
+        for(u = 0; u < dset->shared->ndims; u++) {
+            rdcc->scaled_dims[u] = dset->shared->curr_dims[u] / dset->shared->layout.u.chunk.dim[u];
+            rdcc->scaled_power2up[u] = H5VM_power2up(rdcc->scaled_dims[u]);
+            rdcc->scaled_encode_bits[u] = H5VM_log2_gen(rdcc->scaled_power2up[u]);
+        } /* end for */
+    } /* end if */
+
+    /* Compose chunked index info struct */
+    idx_info.f = dset->oloc.file;
+    idx_info.dxpl_id = dxpl_id;
+    idx_info.pline = &dset->shared->dcpl_cache.pline;
+    idx_info.layout = &dset->shared->layout.u.chunk;
+    idx_info.storage = &dset->shared->layout.storage.u.chunk;
+
+    /* Allocate any indexing structures */
+    if(dset->shared->layout.storage.u.chunk.ops->init && (dset->shared->layout.storage.u.chunk.ops->init)(&idx_info, dset->shared->space, dset->oloc.addr) < 0)
+	HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "can't initialize indexing information")
+
+    /* Set the number of chunks in dataset, etc. */
+    if(H5D__chunk_set_info(dset) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "unable to set # of chunks for dataset")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_refresh() */
 
 
 /*-------------------------------------------------------------------------
@@ -2554,7 +4070,7 @@ H5D__chunk_hash_val(const H5D_shared_t *shared, const hsize_t *scaled)
     /* If the fastest changing dimension doesn't have enough entropy, use
      *  other dimensions too
      */
-    if(ndims > 1 && shared->cache.chunk.scaled_dims[ndims - 1] <= shared->cache.chunk.nslots) {
+    if(ndims > 1 && shared->cache.chunk.scaled_dims[ndims - 1] <= shared->cache.chunk.nbuckets) {
         unsigned u;          /* Local index variable */
 
         val = scaled[0];
@@ -2566,12 +4082,326 @@ H5D__chunk_hash_val(const H5D_shared_t *shared, const hsize_t *scaled)
     else
         val = scaled[ndims - 1];
 
-    /* Modulo value against the number of array slots */
-    ret = (unsigned)(val % shared->cache.chunk.nslots);
+    /* Modulo value against the number of hash table buckets */
+    ret = (unsigned)(val % shared->cache.chunk.nbuckets);
 
     FUNC_LEAVE_NOAPI(ret)
 } /* H5D__chunk_hash_val() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_cache_find
+ *
+ * Purpose:	Look up a chunk in a dataset's chunk cache hash table.  The
+ *		entry found may be a ghost of a chunk evicted recently.
+ *
+ * Return:	Success:	Pointer to the chunk's cache entry
+ *		Failure:	NULL, if the chunk isn't in the hash table
+ *
+ *-------------------------------------------------------------------------
+ */
+static H5D_rdcc_ent_t *
+H5D__chunk_cache_find(const H5D_shared_t *shared, const hsize_t *scaled)
+{
+    H5D_rdcc_ent_t *ent;                /* Cache entry */
+    H5D_rdcc_ent_t *ret_value = NULL;   /* Return value */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    /* Sanity check */
+    HDassert(shared);
+    HDassert(scaled);
+
+    /* Check for a chunk cache */
+    if(0 == shared->cache.chunk.nbuckets)
+        HGOTO_DONE(NULL)
+
+    /* Search the chain of entries in the chunk's bucket */
+    for(ent = shared->cache.chunk.slot[H5D__chunk_hash_val(shared, scaled)]; ent; ent = ent->hash_next) {
+        unsigned u;                     /* Local index variable */
+
+        for(u = 0; u < shared->ndims; u++)
+            if(scaled[u] != ent->scaled[u])
+                break;
+        if(u == shared->ndims)
+            HGOTO_DONE(ent)
+    } /* end for */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5D__chunk_cache_find() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_cache_resize
+ *
+ * Purpose:	Change the number of buckets in a dataset's chunk cache hash
+ *		table, and move the entries to their new buckets.  This is
+ *		also used to update the entries' buckets when the hash
+ *		function changes, without changing the number of buckets.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_cache_resize(H5D_shared_t *shared, size_t nbuckets)
+{
+    H5D_rdcc_t *rdcc = &(shared->cache.chunk);  /* Raw data chunk cache */
+    H5D_rdcc_ent_t **old_slot = rdcc->slot;     /* Previous hash table */
+    size_t old_nbuckets = rdcc->nbuckets;       /* Previous # of buckets */
+    size_t u;                           /* Local index variable */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Sanity check */
+    HDassert(old_slot);
+    HDassert(nbuckets > 0);
+
+    /* Allocate the new hash table */
+    if(NULL == (rdcc->slot = H5FL_SEQ_CALLOC(H5D_rdcc_ent_ptr_t, nbuckets))) {
+        rdcc->slot = old_slot;
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for chunk cache hash table")
+    } /* end if */
+    rdcc->nbuckets = nbuckets;
+
+    /* Move the entries (chunks & ghosts) to their new buckets */
+    for(u = 0; u < old_nbuckets; u++) {
+        H5D_rdcc_ent_t *ent, *next;     /* Cache entries */
+
+        for(ent = old_slot[u]; ent; ent = next) {
+            next = ent->hash_next;
+            ent->idx = H5D__chunk_hash_val(shared, ent->scaled);
+            ent->hash_next = rdcc->slot[ent->idx];
+            rdcc->slot[ent->idx] = ent;
+        } /* end for */
+    } /* end for */
+
+    old_slot = H5FL_SEQ_FREE(H5D_rdcc_ent_ptr_t, old_slot);
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5D__chunk_cache_resize() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_cache_hash_insert
+ *
+ * Purpose:	Add an entry to a dataset's chunk cache hash table, doubling
+ *		the number of buckets when there are as many entries as
+ *		buckets.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_cache_hash_insert(H5D_shared_t *shared, H5D_rdcc_ent_t *ent)
+{
+    H5D_rdcc_t *rdcc = &(shared->cache.chunk);  /* Raw data chunk cache */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Sanity check */
+    HDassert(ent);
+    HDassert(ent->shared == shared);
+    HDassert(rdcc->nbuckets > 0);
+
+    /* Grow the hash table, to keep the chains short */
+    if(rdcc->nentries >= rdcc->nbuckets)
+        if(H5D__chunk_cache_resize(shared, 2 * rdcc->nbuckets) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTRESIZE, FAIL, "unable to grow chunk cache hash table")
+
+    /* Add the entry to the head of its bucket's chain */
+    ent->idx = H5D__chunk_hash_val(shared, ent->scaled);
+    ent->hash_next = rdcc->slot[ent->idx];
+    rdcc->slot[ent->idx] = ent;
+    rdcc->nentries++;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5D__chunk_cache_hash_insert() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_cache_hash_remove
+ *
+ * Purpose:	Remove an entry from a dataset's chunk cache hash table.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5D__chunk_cache_hash_remove(H5D_shared_t *shared, H5D_rdcc_ent_t *ent)
+{
+    H5D_rdcc_t *rdcc = &(shared->cache.chunk);  /* Raw data chunk cache */
+    H5D_rdcc_ent_t **link;              /* Link to the entry in its chain */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    /* Sanity check */
+    HDassert(ent);
+    HDassert(ent->shared == shared);
+    HDassert(ent->idx < rdcc->nbuckets);
+    HDassert(rdcc->nentries > 0);
+
+    /* Unlink the entry from its bucket's chain */
+    for(link = &rdcc->slot[ent->idx]; *link != ent; link = &(*link)->hash_next)
+        HDassert(*link);
+    *link = ent->hash_next;
+    ent->hash_next = NULL;
+    rdcc->nentries--;
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* H5D__chunk_cache_hash_remove() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_cache_list_append
+ *
+ * Purpose:	Add an entry to the most recently used end of one of the
+ *		replacement policy lists of a chunk cache memory pool.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5D__chunk_cache_list_append(H5D_rdcc_pool_t *pool, H5D_rdcc_ent_t *ent,
+    H5D_rdcc_list_t list)
+{
+    size_t size = H5D_RDCC_ENT_SIZE(ent);       /* Size of chunk */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    /* Sanity check */
+    HDassert(pool);
+    HDassert(list < H5D_RDCC_NLISTS);
+    HDassert(!ent->lru_next && !ent->lru_prev);
+
+    ent->list = list;
+    ent->lru_prev = pool->list[list].tail;
+    if(pool->list[list].tail)
+        pool->list[list].tail->lru_next = ent;
+    else
+        pool->list[list].head = ent;
+    pool->list[list].tail = ent;
+    pool->list[list].nbytes += size;
+    pool->list[list].nents++;
+
+    /* Entries on the T1 & T2 lists hold chunks */
+    if(H5D_RDCC_ENT_CACHED(ent))
+        pool->nbytes_used += size;
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* H5D__chunk_cache_list_append() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_cache_list_remove
+ *
+ * Purpose:	Remove an entry from the replacement policy list of a chunk
+ *		cache memory pool that it's on.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5D__chunk_cache_list_remove(H5D_rdcc_pool_t *pool, H5D_rdcc_ent_t *ent)
+{
+    size_t size = H5D_RDCC_ENT_SIZE(ent);       /* Size of chunk */
+    H5D_rdcc_list_t list = ent->list;   /* List entry is on */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    /* Sanity check */
+    HDassert(pool);
+    HDassert(list < H5D_RDCC_NLISTS);
+    HDassert(pool->list[list].nents > 0);
+    HDassert(pool->list[list].nbytes >= size);
+
+    if(ent->lru_prev)
+        ent->lru_prev->lru_next = ent->lru_next;
+    else
+        pool->list[list].head = ent->lru_next;
+    if(ent->lru_next)
+        ent->lru_next->lru_prev = ent->lru_prev;
+    else
+        pool->list[list].tail = ent->lru_prev;
+    ent->lru_prev = ent->lru_next = NULL;
+    pool->list[list].nbytes -= size;
+    pool->list[list].nents--;
+
+    if(H5D_RDCC_ENT_CACHED(ent))
+        pool->nbytes_used -= size;
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* H5D__chunk_cache_list_remove() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_cache_drop_ghost
+ *
+ * Purpose:	Forget about a chunk evicted from the cache, removing its
+ *		ghost from the memory pool and its dataset's hash table.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5D__chunk_cache_drop_ghost(H5D_rdcc_pool_t *pool, H5D_rdcc_ent_t *ent)
+{
+    FUNC_ENTER_STATIC_NOERR
+
+    /* Sanity check */
+    HDassert(ent);
+    HDassert(!H5D_RDCC_ENT_CACHED(ent));
+    HDassert(NULL == ent->chunk);
+
+    H5D__chunk_cache_list_remove(pool, ent);
+    H5D__chunk_cache_hash_remove(ent->shared, ent);
+    ent = H5FL_FREE(H5D_rdcc_ent_t, ent);
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* H5D__chunk_cache_drop_ghost() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_cache_trim_ghosts
+ *
+ * Purpose:	Limit the history of evicted chunks kept by a chunk cache
+ *		memory pool: the chunks on T1 and the ghosts on B1 are
+ *		kept no larger than the pool, and all the lists no larger
+ *		than twice the pool.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5D__chunk_cache_trim_ghosts(H5D_rdcc_pool_t *pool)
+{
+    FUNC_ENTER_STATIC_NOERR
+
+    /* Sanity check */
+    HDassert(pool);
+
+    while(pool->list[H5D_RDCC_B1].head &&
+            (pool->list[H5D_RDCC_T1].nbytes + pool->list[H5D_RDCC_B1].nbytes) > pool->nbytes_max)
+        H5D__chunk_cache_drop_ghost(pool, pool->list[H5D_RDCC_B1].head);
+    while((pool->list[H5D_RDCC_B1].head || pool->list[H5D_RDCC_B2].head) &&
+            (pool->nbytes_used + pool->list[H5D_RDCC_B1].nbytes + pool->list[H5D_RDCC_B2].nbytes) > 2 * pool->nbytes_max)
+        H5D__chunk_cache_drop_ghost(pool, pool->list[H5D_RDCC_B2].head ?
+                pool->list[H5D_RDCC_B2].head : pool->list[H5D_RDCC_B1].head);
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* H5D__chunk_cache_trim_ghosts() */
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5D__chunk_lookup
@@ -2592,8 +4422,6 @@ H5D__chunk_lookup(const H5D_t *dset, hid_t dxpl_id, const hsize_t *scaled,
 {
     H5D_rdcc_ent_t  *ent = NULL;        /* Cache entry */
     H5O_storage_chunk_t *sc = &(dset->shared->layout.storage.u.chunk);
-    unsigned idx;                       /* Index of chunk in cache, if present */
-    hbool_t found = FALSE;              /* In cache? */
     herr_t ret_value = SUCCEED;	        /* Return value */
 
     FUNC_ENTER_PACKAGE
@@ -2615,38 +4443,25 @@ H5D__chunk_lookup(const H5D_t *dset, hid_t dxpl_id, const hsize_t *scaled,
     udata->chunk_block.length = 0;
     udata->filter_mask = 0;
 
-    /* Check for chunk in cache */
-    if(dset->shared->cache.chunk.nslots > 0) {
-        /* Determine the chunk's location in the hash table */
-	idx = H5D__chunk_hash_val(dset->shared, scaled);
-
-        /* Get the chunk cache entry for that location */
-        ent = dset->shared->cache.chunk.slot[idx];
-        if(ent) {
-            unsigned u;                  /* Counter */
+    /* Write the chunk first, if it's waiting to be written behind */
+    if(H5D__chunk_write_behind_has(dset->shared, scaled))
+        if(H5D__chunk_write_behind_drain(dset, dset->shared->cache.chunk.write_behind.dxpl_id,
+                dset->shared->cache.chunk.write_behind.dxpl_cache) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "unable to write behind raw data chunks")
 
-            /* Speculatively set the 'found' flag */
-            found = TRUE;
-
-            /* Verify that the cache entry is the correct chunk */
-            for(u = 0; u < dset->shared->ndims; u++)
-                if(scaled[u] != ent->scaled[u]) {
-                    found = FALSE;
-                    break;
-                } /* end if */
-        } /* end if */
-    } /* end if */
+    /* Check for chunk in cache (a ghost of an evicted chunk doesn't count) */
+    ent = H5D__chunk_cache_find(dset->shared, scaled);
 
     /* Retrieve chunk addr */
-    if(found) {
-        udata->idx_hint = idx;
+    if(ent && H5D_RDCC_ENT_CACHED(ent)) {
+        udata->ent = ent;
         udata->chunk_block.offset = ent->chunk_block.offset;
         udata->chunk_block.length = ent->chunk_block.length;;
 	udata->chunk_idx = ent->chunk_idx;
     } /* end if */
     else {
-        /* Invalidate idx_hint, to signal that the chunk is not in cache */
-        udata->idx_hint = UINT_MAX;
+        /* Reset the entry, to signal that the chunk is not in cache */
+        udata->ent = NULL;
 
         /* Check for cached information */
         if(!H5D__chunk_cinfo_cache_found(&dset->shared->cache.chunk.last, udata)) {
@@ -2700,6 +4515,10 @@ done:
  *		the RESET flag is turned on because it results in one fewer
  *		memory copy.
  *
+ *		If FILT is non-NULL and has a buffer, it holds the chunk's
+ *		data already run through the filter pipeline, and the
+ *		buffer is consumed instead of filtering the chunk again.
+ *
  * Return:	Non-negative on success/Negative on failure
  *
  * Programmer:	Robb Matzke
@@ -2709,7 +4528,7 @@ done:
  */
 static herr_t
 H5D__chunk_flush_entry(const H5D_t *dset, hid_t dxpl_id, const H5D_dxpl_cache_t *dxpl_cache,
-    H5D_rdcc_ent_t *ent, hbool_t reset)
+    H5D_rdcc_ent_t *ent, hbool_t reset, H5Z_pipeline_job_t *filt)
 {
     void	*buf = NULL;	        /* Temporary buffer		*/
     hbool_t	point_of_no_return = FALSE;
@@ -2746,31 +4565,40 @@ H5D__chunk_flush_entry(const H5D_t *dset, hid_t dxpl_id, const H5D_dxpl_cache_t
             size_t alloc = udata.chunk_block.length;        /* Bytes allocated for BUF	*/
             size_t nbytes;                      /* Chunk size (in bytes) */
 
-            if(!reset) {
-                /*
-                 * Copy the chunk to a new buffer before running it through
-                 * the pipeline because we'll want to save the original buffer
-                 * for later.
-                 */
-                if(NULL == (buf = H5MM_malloc(alloc)))
-                    HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for pipeline")
-                HDmemcpy(buf, ent->chunk, alloc);
+            if(filt && filt->buf) {
+                /* The chunk has already been through the pipeline */
+                buf = filt->buf;
+                filt->buf = NULL;
+                nbytes = filt->nbytes;
+                udata.filter_mask = filt->filter_mask;
             } /* end if */
             else {
-                /*
-                 * If we are reseting and something goes wrong after this
-                 * point then it's too late to recover because we may have
-                 * destroyed the original data by calling H5Z_pipeline().
-                 * The only safe option is to continue with the reset
-                 * even if we can't write the data to disk.
-                 */
-                point_of_no_return = TRUE;
-                ent->chunk = NULL;
+                if(!reset) {
+                    /*
+                     * Copy the chunk to a new buffer before running it through
+                     * the pipeline because we'll want to save the original buffer
+                     * for later.
+                     */
+                    if(NULL == (buf = H5MM_malloc(alloc)))
+                        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for pipeline")
+                    HDmemcpy(buf, ent->chunk, alloc);
+                } /* end if */
+                else {
+                    /*
+                     * If we are reseting and something goes wrong after this
+                     * point then it's too late to recover because we may have
+                     * destroyed the original data by calling H5Z_pipeline().
+                     * The only safe option is to continue with the reset
+                     * even if we can't write the data to disk.
+                     */
+                    point_of_no_return = TRUE;
+                    ent->chunk = NULL;
+                } /* end else */
+                H5_CHECKED_ASSIGN(nbytes, size_t, udata.chunk_block.length, hsize_t);
+                if(H5Z_pipeline(&(dset->shared->dcpl_cache.pline), 0, &(udata.filter_mask), dxpl_cache->err_detect,
+                         dxpl_cache->filter_cb, &nbytes, &alloc, &buf) < 0)
+                    HGOTO_ERROR(H5E_PLINE, H5E_CANTFILTER, FAIL, "output pipeline failed")
             } /* end else */
-            H5_CHECKED_ASSIGN(nbytes, size_t, udata.chunk_block.length, hsize_t);
-            if(H5Z_pipeline(&(dset->shared->dcpl_cache.pline), 0, &(udata.filter_mask), dxpl_cache->err_detect,
-                     dxpl_cache->filter_cb, &nbytes, &alloc, &buf) < 0)
-                HGOTO_ERROR(H5E_PLINE, H5E_CANTFILTER, FAIL, "output pipeline failed")
 #if H5_SIZEOF_SIZE_T > 4
             /* Check for the chunk expanding too much to encode in a 32-bit value */
             if(nbytes > ((size_t)0xffffffff))
@@ -2852,15 +4680,87 @@ done:
         if(ent->chunk)
             ent->chunk = (uint8_t *)H5D__chunk_mem_xfree(ent->chunk, &(dset->shared->dcpl_cache.pline));
 
-    FUNC_LEAVE_NOAPI_TAG(ret_value, FAIL)
-} /* end H5D__chunk_flush_entry() */
+    FUNC_LEAVE_NOAPI_TAG(ret_value, FAIL)
+} /* end H5D__chunk_flush_entry() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_flush_entries
+ *
+ * Purpose:	Writes several chunks to disk, without resetting them.  The
+ *		dirty chunks are run through the filter pipeline in
+ *		parallel, using the number of threads from the DXPL, then
+ *		written out one at a time in the order given.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_flush_entries(const H5D_t *dset, hid_t dxpl_id, const H5D_dxpl_cache_t *dxpl_cache,
+    H5D_rdcc_ent_t **ents, size_t nents)
+{
+    const H5O_pline_t *pline = &(dset->shared->dcpl_cache.pline);    /* I/O pipeline info */
+    H5Z_pipeline_job_t *jobs = NULL;    /* Filter pipeline jobs */
+    size_t      chunk_size;             /* Size of a chunk */
+    unsigned	nerrors = 0;            /* Count of any errors encountered when flushing chunks */
+    size_t	u;                      /* Local index variable */
+    herr_t	ret_value = SUCCEED;	/* Return value */
+
+    FUNC_ENTER_STATIC
+
+    HDassert(dset);
+    HDassert(dxpl_cache);
+    HDassert(ents || 0 == nents);
+
+    if(0 == nents)
+        HGOTO_DONE(SUCCEED)
+
+    /* Run the dirty chunks through the pipeline */
+    if(pline->nused) {
+        H5_CHECKED_ASSIGN(chunk_size, size_t, dset->shared->layout.u.chunk.size, uint32_t);
+
+        if(NULL == (jobs = (H5Z_pipeline_job_t *)H5MM_calloc(nents * sizeof(H5Z_pipeline_job_t))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for filter jobs")
+
+        /* Filter copies of the chunks, so the cached data is preserved */
+        for(u = 0; u < nents; u++)
+            if(ents[u]->dirty) {
+                if(NULL == (jobs[u].buf = H5MM_malloc(chunk_size)))
+                    HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for pipeline")
+                HDmemcpy(jobs[u].buf, ents[u]->chunk, chunk_size);
+                jobs[u].nbytes = jobs[u].buf_size = chunk_size;
+            } /* end if */
+
+        if(H5Z_pipeline_multi(pline, 0, dxpl_cache->err_detect, dxpl_cache->filter_cb,
+                dxpl_cache->filter_nthreads, nents, jobs) < 0)
+            HGOTO_ERROR(H5E_PLINE, H5E_CANTFILTER, FAIL, "output pipeline failed")
+    } /* end if */
+
+    /* Write the chunks */
+    for(u = 0; u < nents; u++)
+        if(H5D__chunk_flush_entry(dset, dxpl_id, dxpl_cache, ents[u], FALSE, (jobs ? &jobs[u] : NULL)) < 0)
+            nerrors++;
+    if(nerrors)
+	HGOTO_ERROR(H5E_DATASET, H5E_CANTFLUSH, FAIL, "unable to flush one or more raw data chunks")
+
+done:
+    if(jobs) {
+        for(u = 0; u < nents; u++)
+            H5MM_xfree(jobs[u].buf);
+        H5MM_xfree(jobs);
+    } /* end if */
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_flush_entries() */
 
 
 /*-------------------------------------------------------------------------
  * Function:    H5D__chunk_cache_evict
  *
  * Purpose:     Preempts the specified entry from the cache, flushing it to
- *              disk if necessary.
+ *              disk if necessary.  The entry is removed entirely, without
+ *              keeping a ghost of the chunk.
  *
  * Return:      Non-negative on success/Negative on failure
  *
@@ -2882,11 +4782,12 @@ H5D__chunk_cache_evict(const H5D_t *dset, hid_t dxpl_id, const H5D_dxpl_cache_t
     HDassert(dxpl_cache);
     HDassert(ent);
     HDassert(!ent->locked);
-    HDassert(ent->idx < rdcc->nslots);
+    HDassert(ent->shared == dset->shared);
+    HDassert(H5D_RDCC_ENT_CACHED(ent));
 
     if(flush) {
 	/* Flush */
-	if(H5D__chunk_flush_entry(dset, dxpl_id, dxpl_cache, ent, TRUE) < 0)
+	if(H5D__chunk_flush_entry(dset, dxpl_id, dxpl_cache, ent, TRUE, NULL) < 0)
 	    HDONE_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "cannot flush indexed storage buffer")
     } /* end if */
     else {
@@ -2906,24 +4807,9 @@ H5D__chunk_cache_evict(const H5D_t *dset, hid_t dxpl_id, const H5D_dxpl_cache_t
 	rdcc->tail = ent->prev;
     ent->prev = ent->next = NULL;
 
-    /* Unlink from temporary list */
-    if(ent->tmp_prev) {
-        HDassert(rdcc->tmp_head->tmp_next);
-        ent->tmp_prev->tmp_next = ent->tmp_next;
-        if(ent->tmp_next) {
-            ent->tmp_next->tmp_prev = ent->tmp_prev;
-            ent->tmp_next = NULL;
-        } /* end if */
-        ent->tmp_prev = NULL;
-    } /* end if */
-    else
-        /* Only clear hash table slot if the chunk was not on the temporary list
-         */
-        rdcc->slot[ent->idx] = NULL;
-
     /* Remove from cache */
-    HDassert(rdcc->slot[ent->idx] != ent);
-    ent->idx = UINT_MAX;
+    H5D__chunk_cache_list_remove(rdcc->pool, ent);
+    H5D__chunk_cache_hash_remove(dset->shared, ent);
     rdcc->nbytes_used -= dset->shared->layout.u.chunk.size;
     --rdcc->nused;
 
@@ -2933,13 +4819,165 @@ H5D__chunk_cache_evict(const H5D_t *dset, hid_t dxpl_id, const H5D_dxpl_cache_t
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5D__chunk_cache_evict() */
 
-
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__chunk_cache_preempt
+ *
+ * Purpose:     Evicts a chunk from its memory pool to make room for
+ *              another chunk, flushing it to disk if necessary.  The
+ *              chunk may belong to another dataset sharing the pool, in
+ *              which case it's written through the object that last used
+ *              that dataset's chunk cache.
+ *
+ *              The entry is kept as a ghost of the chunk, on the B1 or B2
+ *              list, so the replacement policy can adapt if the chunk is
+ *              accessed again soon.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_cache_preempt(const H5D_t *dset, hid_t dxpl_id, const H5D_dxpl_cache_t *dxpl_cache,
+    H5D_rdcc_ent_t *ent)
+{
+    H5D_rdcc_t *rdcc = &(ent->shared->cache.chunk);     /* Chunk's dataset's cache */
+    const H5D_t *ent_dset;              /* Dataset to write the chunk through */
+    H5D_rdcc_list_t ghost_list;         /* List to keep the chunk's ghost on */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    HDassert(dset);
+    HDassert(dxpl_cache);
+    HDassert(ent);
+    HDassert(!ent->locked);
+    HDassert(H5D_RDCC_ENT_CACHED(ent));
+
+    /* Flush the chunk, or just free it when it's clean */
+    ent_dset = (ent->shared == dset->shared) ? dset : rdcc->owner;
+    if(ent_dset) {
+        htri_t behind;                  /* Whether the chunk is written behind */
+
+        /* Leave the chunk to be written behind, when possible */
+        if((behind = H5D__chunk_write_behind_add(ent_dset, dxpl_id, dxpl_cache, ent)) < 0)
+	    HDONE_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "cannot write behind indexed storage buffer")
+	if(!behind && H5D__chunk_flush_entry(ent_dset, dxpl_id, dxpl_cache, ent, TRUE, NULL) < 0)
+	    HDONE_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "cannot flush indexed storage buffer")
+    } /* end if */
+    else
+        HDassert(!ent->dirty);
+    if(ent->chunk != NULL)
+        ent->chunk = (uint8_t *)H5D__chunk_mem_xfree(ent->chunk, &(ent->shared->dcpl_cache.pline));
+    ent->dirty = FALSE;
+
+    /* Unlink from the dataset's list of cached chunks */
+    if(ent->prev)
+	ent->prev->next = ent->next;
+    else
+	rdcc->head = ent->next;
+    if(ent->next)
+	ent->next->prev = ent->prev;
+    else
+	rdcc->tail = ent->prev;
+    ent->prev = ent->next = NULL;
+    rdcc->nbytes_used -= ent->shared->layout.u.chunk.size;
+    --rdcc->nused;
+
+    /* Keep a ghost of the chunk, remembering which list it was on */
+    ghost_list = (H5D_RDCC_T1 == ent->list) ? H5D_RDCC_B1 : H5D_RDCC_B2;
+    H5D__chunk_cache_list_remove(rdcc->pool, ent);
+    H5D__chunk_cache_list_append(rdcc->pool, ent, ghost_list);
+
+    /* Increment # of evictions */
+    rdcc->stats.nevictions++;
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_cache_preempt() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_cache_victim
+ *
+ * Purpose:	Choose a chunk to evict from one of the T1 or T2 lists of a
+ *		memory pool.  Entries are considered in least recently used
+ *		order, skipping locked entries and dirty chunks that can't
+ *		be written back (because no object is open for their
+ *		dataset).
+ *
+ *		Among the first W0 (the DSET's preemption policy) fraction
+ *		of the entries on the list, chunks that have been completely
+ *		read or written are chosen first.  Otherwise, the least
+ *		recently used chunk is chosen.
+ *
+ * Return:	Success:	Pointer to the chunk's entry
+ *		Failure:	NULL, if there's nothing to evict
+ *
+ *-------------------------------------------------------------------------
+ */
+static H5D_rdcc_ent_t *
+H5D__chunk_cache_victim(const H5D_t *dset, const H5D_rdcc_pool_t *pool,
+    H5D_rdcc_list_t list)
+{
+    size_t nfavor;                      /* # of entries to favor fully accessed chunks in */
+    H5D_rdcc_ent_t *ent;                /* Cache entry */
+    size_t u;                           /* Position on list */
+    H5D_rdcc_ent_t *ret_value = NULL;   /* Return value */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    /* Sanity check */
+    HDassert(dset);
+    HDassert(pool);
+    HDassert(H5D_RDCC_T1 == list || H5D_RDCC_T2 == list);
+
+    nfavor = (size_t)((double)pool->list[list].nents * dset->shared->cache.chunk.w0);
+    for(ent = pool->list[list].head, u = 0; ent; ent = ent->lru_next, u++) {
+        uint32_t size = ent->shared->layout.u.chunk.size;       /* Size of chunk */
+
+        /* Skip chunks that can't be evicted */
+        if(ent->locked || (ent->dirty && ent->shared != dset->shared
+                && NULL == ent->shared->cache.chunk.owner))
+            continue;
+
+        /* Past the favored entries, take the least recently used chunk */
+        if(u >= nfavor) {
+            if(NULL == ret_value)
+                ret_value = ent;
+            break;
+        } /* end if */
+
+        /* Take a chunk that has been completely written and/or completely
+         * read, but not one partially written or partially read */
+        if((0 == ent->rd_count && 0 == ent->wr_count) ||
+                (0 == ent->rd_count && size == ent->wr_count) ||
+                (size == ent->rd_count && 0 == ent->wr_count)) {
+            ret_value = ent;
+            break;
+        } /* end if */
+
+        /* Remember the least recently used chunk, as a last resort */
+        if(NULL == ret_value)
+            ret_value = ent;
+    } /* end for */
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5D__chunk_cache_victim() */
+
+
 /*-------------------------------------------------------------------------
  * Function:	H5D__chunk_cache_prune
  *
- * Purpose:	Prune the cache by preempting some things until the cache has
- *		room for something which is SIZE bytes.  Only unlocked
- *		entries are considered for preemption.
+ * Purpose:	Prune the memory pool of a dataset's cache by preempting
+ *		some things until the pool has room for something which is
+ *		SIZE bytes, and for one more chunk if the number of chunks
+ *		is limited.  Only unlocked entries are considered for
+ *		preemption.
+ *
+ *		Chunks are taken from the T1 list while it's over its
+ *		target size, or from the T2 list otherwise (see the ARC
+ *		replacement policy described in H5Dpkg.h).  B2_HIT is set
+ *		when the chunk to make room for has a ghost on the B2 list.
  *
  * Return:	Non-negative on success/Negative on failure
  *
@@ -2950,88 +4988,34 @@ H5D__chunk_cache_evict(const H5D_t *dset, hid_t dxpl_id, const H5D_dxpl_cache_t
  */
 static herr_t
 H5D__chunk_cache_prune(const H5D_t *dset, hid_t dxpl_id,
-    const H5D_dxpl_cache_t *dxpl_cache, size_t size)
+    const H5D_dxpl_cache_t *dxpl_cache, size_t size, hbool_t b2_hit)
 {
-    const H5D_rdcc_t	*rdcc = &(dset->shared->cache.chunk);
-    size_t		total = rdcc->nbytes_max;
-    const int		nmeth = 2;	/*number of methods		*/
-    int		        w[1];		/*weighting as an interval	*/
-    H5D_rdcc_ent_t	*p[2], *cur;	/*list pointers			*/
-    H5D_rdcc_ent_t	*n[2];		/*list next pointers		*/
+    H5D_rdcc_pool_t	*pool = dset->shared->cache.chunk.pool;
     int		nerrors = 0;            /* Accumulated error count during preemptions */
     herr_t      ret_value = SUCCEED;       /* Return value */
 
     FUNC_ENTER_STATIC
 
-    /*
-     * Preemption is accomplished by having multiple pointers (currently two)
-     * slide down the list beginning at the head. Pointer p(N+1) will start
-     * traversing the list when pointer pN reaches wN percent of the original
-     * list.  In other words, preemption method N gets to consider entries in
-     * approximate least recently used order w0 percent before method N+1
-     * where 100% means tha method N will run to completion before method N+1
-     * begins.  The pointers participating in the list traversal are each
-     * given a chance at preemption before any of the pointers are advanced.
-     */
-    w[0] = (int)(rdcc->nused * rdcc->w0);
-    p[0] = rdcc->head;
-    p[1] = NULL;
-
-    while((p[0] || p[1]) && (rdcc->nbytes_used + size) > total) {
-        int i;          /* Local index variable */
-
-	/* Introduce new pointers */
-	for(i = 0; i < nmeth - 1; i++)
-            if(0 == w[i])
-                p[i + 1] = rdcc->head;
-
-	/* Compute next value for each pointer */
-	for(i = 0; i < nmeth; i++)
-            n[i] = p[i] ? p[i]->next : NULL;
-
-	/* Give each method a chance */
-	for(i = 0; i < nmeth && (rdcc->nbytes_used + size) > total; i++) {
-	    if(0 == i && p[0] && !p[0]->locked &&
-                    ((0 == p[0]->rd_count && 0 == p[0]->wr_count) ||
-                     (0 == p[0]->rd_count && dset->shared->layout.u.chunk.size == p[0]->wr_count) ||
-                     (dset->shared->layout.u.chunk.size == p[0]->rd_count && 0 == p[0]->wr_count))) {
-		/*
-		 * Method 0: Preempt entries that have been completely written
-		 * and/or completely read but not entries that are partially
-		 * written or partially read.
-		 */
-		cur = p[0];
-	    } else if(1 == i && p[1] && !p[1]->locked) {
-		/*
-		 * Method 1: Preempt the entry without regard to
-		 * considerations other than being locked.  This is the last
-		 * resort preemption.
-		 */
-		cur = p[1];
-	    } else {
-		/* Nothing to preempt at this point */
-		cur = NULL;
-	    }
-
-	    if(cur) {
-                int j;          /* Local index variable */
-
-		for(j = 0; j < nmeth; j++) {
-		    if(p[j] == cur)
-                        p[j] = NULL;
-		    if(n[j] == cur)
-                        n[j] = cur->next;
-		} /* end for */
-		if(H5D__chunk_cache_evict(dset, dxpl_id, dxpl_cache, cur, TRUE) < 0)
-                    nerrors++;
-	    } /* end if */
-	} /* end for */
+    HDassert(pool);
+
+    while((pool->nbytes_used + size) > pool->nbytes_max || (pool->nents_max > 0 &&
+            (pool->list[H5D_RDCC_T1].nents + pool->list[H5D_RDCC_T2].nents) >= pool->nents_max)) {
+        size_t t1_nbytes = pool->list[H5D_RDCC_T1].nbytes;     /* Size of T1 */
+        H5D_rdcc_ent_t *cur = NULL;     /* Entry to preempt */
 
-	/* Advance pointers */
-	for(i = 0; i < nmeth; i++)
-            p[i] = n[i];
-	for(i = 0; i < nmeth - 1; i++)
-            w[i] -= 1;
+        if(t1_nbytes > 0 && (t1_nbytes > pool->p || (b2_hit && t1_nbytes == pool->p)))
+            cur = H5D__chunk_cache_victim(dset, pool, H5D_RDCC_T1);
+        if(NULL == cur)
+            cur = H5D__chunk_cache_victim(dset, pool, H5D_RDCC_T2);
+        if(NULL == cur)
+            cur = H5D__chunk_cache_victim(dset, pool, H5D_RDCC_T1);
+
+        /* Nothing to preempt */
+        if(NULL == cur)
+            break;
+
+        if(H5D__chunk_cache_preempt(dset, dxpl_id, dxpl_cache, cur) < 0)
+            nerrors++;
     } /* end while */
 
     if(nerrors)
@@ -3041,18 +5025,16 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5D__chunk_cache_prune() */
 
-
+
 /*-------------------------------------------------------------------------
  * Function:	H5D__chunk_lock
  *
  * Purpose:	Return a pointer to a dataset chunk.  The pointer points
  *		directly into the chunk cache and should not be freed
  *		by the caller but will be valid until it is unlocked.  The
- *		input value IDX_HINT is used to speed up cache lookups and
- *		it's output value should be given to H5D__chunk_unlock().
- *		IDX_HINT is ignored if it is out of range, and if it points
- *		to the wrong entry then we fall back to the normal search
- *		method.
+ *		chunk's cache entry in UDATA (from H5D__chunk_lookup()) is
+ *		used to find a cached chunk, and its output value should be
+ *		given to H5D__chunk_unlock().
  *
  *		If RELAX is non-zero and the chunk isn't in the cache then
  *		don't try to read it from the file, but just allocate an
@@ -3060,6 +5042,11 @@ done:
  *		for output functions that are about to overwrite the entire
  *		chunk.
  *
+ *		If FILT is non-NULL and has a buffer, the chunk isn't in the
+ *		cache, and it has already been read from the file and run
+ *		through the filter pipeline into that buffer, which is used
+ *		for the chunk (and removed from FILT).
+ *
  * Return:	Success:	Ptr to a file chunk.
  *
  *		Failure:	NULL
@@ -3071,7 +5058,7 @@ done:
  */
 static void *
 H5D__chunk_lock(const H5D_io_info_t *io_info, H5D_chunk_ud_t *udata,
-    hbool_t relax)
+    hbool_t relax, H5Z_pipeline_job_t *filt)
 {
     const H5D_t         *dset = io_info->dset;  /* Local pointer to the dataset info */
     const H5O_pline_t   *pline = &(dset->shared->dcpl_cache.pline); /* I/O pipeline info - always equal to the pline passed to H5D__chunk_mem_alloc */
@@ -3094,20 +5081,17 @@ H5D__chunk_lock(const H5D_io_info_t *io_info, H5D_chunk_ud_t *udata,
     HDassert(dset);
     HDassert(TRUE == H5P_isa_class(io_info->md_dxpl_id, H5P_DATASET_XFER));
     HDassert(TRUE == H5P_isa_class(io_info->raw_dxpl_id, H5P_DATASET_XFER));
-    HDassert(!rdcc->tmp_head);
 
     /* Get the chunk's size */
     HDassert(layout->u.chunk.size > 0);
     H5_CHECKED_ASSIGN(chunk_size, size_t, layout->u.chunk.size, uint32_t);
 
     /* Check if the chunk is in the cache */
-    if(UINT_MAX != udata->idx_hint) {
-        /* Sanity check */
-        HDassert(udata->idx_hint < rdcc->nslots);
-        HDassert(rdcc->slot[udata->idx_hint]);
-
+    if(udata->ent) {
         /* Get the entry */
-        ent = rdcc->slot[udata->idx_hint];
+        ent = udata->ent;
+        HDassert(ent->shared == dset->shared);
+        HDassert(H5D_RDCC_ENT_CACHED(ent));
 
 #ifndef NDEBUG
 {
@@ -3125,24 +5109,11 @@ H5D__chunk_lock(const H5D_io_info_t *io_info, H5D_chunk_ud_t *udata,
         rdcc->stats.nhits++;
 
         /*
-         * If the chunk is not at the beginning of the cache; move it backward
-         * by one slot.  This is how we implement the LRU preemption
-         * algorithm.
+         * A chunk accessed again moves to the most recently used end of
+         * the T2 list.
          */
-        if(ent->next) {
-            if(ent->next->next)
-                ent->next->next->prev = ent;
-            else
-                rdcc->tail = ent;
-            ent->next->prev = ent->prev;
-            if(ent->prev)
-                ent->prev->next = ent->next;
-            else
-                rdcc->head = ent->next;
-            ent->prev = ent->next;
-            ent->next = ent->next->next;
-            ent->prev->next = ent;
-        } /* end if */
+        H5D__chunk_cache_list_remove(rdcc->pool, ent);
+        H5D__chunk_cache_list_append(rdcc->pool, ent, H5D_RDCC_T2);
     } /* end if */
     else {
         haddr_t             chunk_addr;         /* Address of chunk on disk */
@@ -3174,8 +5145,20 @@ H5D__chunk_lock(const H5D_io_info_t *io_info, H5D_chunk_ud_t *udata,
              *      or an init if it isn't.
              */
 
+            /* Check if the chunk has already been read and filtered */
+            if(filt && filt->buf) {
+                HDassert(H5F_addr_defined(chunk_addr));
+
+                /* Take ownership of the unfiltered chunk */
+                chunk = filt->buf;
+                filt->buf = NULL;
+                udata->filter_mask = filt->filter_mask;
+
+                /* Increment # of cache misses */
+                rdcc->stats.nmisses++;
+            } /* end if */
             /* Check if the chunk exists on disk */
-            if(H5F_addr_defined(chunk_addr)) {
+            else if(H5F_addr_defined(chunk_addr)) {
                 size_t my_chunk_alloc = chunk_alloc;	/* Allocated buffer size */
                 size_t buf_alloc = chunk_alloc;	        /* [Re-]allocated buffer size */
 
@@ -3240,57 +5223,83 @@ H5D__chunk_lock(const H5D_io_info_t *io_info, H5D_chunk_ud_t *udata,
         } /* end else */
 
         /* See if the chunk can be cached */
-        if(rdcc->nslots > 0 && chunk_size <= rdcc->nbytes_max) {
-            /* Calculate the index */
-            udata->idx_hint = H5D__chunk_hash_val(io_info->dset->shared, udata->common.scaled);
+        if(rdcc->pool && chunk_size <= rdcc->pool->nbytes_max) {
+            H5D_rdcc_pool_t *pool = rdcc->pool;         /* Memory pool for chunks */
+            H5D_rdcc_list_t list;       /* List to add the chunk to */
+
+            /* Check for a ghost of the chunk, evicted recently */
+            if(NULL != (ent = H5D__chunk_cache_find(dset->shared, udata->common.scaled))) {
+                size_t b1_nbytes = pool->list[H5D_RDCC_B1].nbytes;      /* Size of B1 */
+                size_t b2_nbytes = pool->list[H5D_RDCC_B2].nbytes;      /* Size of B2 */
+                size_t delta;           /* Change in target size of T1 */
+                hbool_t b2_hit = (hbool_t)(H5D_RDCC_B2 == ent->list);
+
+                HDassert(!H5D_RDCC_ENT_CACHED(ent));
+
+                /* A chunk evicted from T1 too soon means T1 should be
+                 * larger, and from T2 that T2 should be larger */
+                if(b2_hit) {
+                    delta = (b1_nbytes > b2_nbytes) ? chunk_size * (b1_nbytes / b2_nbytes) : chunk_size;
+                    pool->p = (pool->p > delta) ? pool->p - delta : 0;
+                } /* end if */
+                else {
+                    delta = (b2_nbytes > b1_nbytes) ? chunk_size * (b2_nbytes / b1_nbytes) : chunk_size;
+                    pool->p = MIN(pool->p + delta, pool->nbytes_max);
+                } /* end else */
+                rdcc->stats.nghost_hits++;
 
-            /* Add the chunk to the cache only if the slot is not already locked */
-            ent = rdcc->slot[udata->idx_hint];
-            if(!ent || !ent->locked) {
                 /* Preempt enough things from the cache to make room */
-                if(ent) {
-                    if(H5D__chunk_cache_evict(io_info->dset, io_info->md_dxpl_id, io_info->dxpl_cache, ent, TRUE) < 0)
-                        HGOTO_ERROR(H5E_IO, H5E_CANTINIT, NULL, "unable to preempt chunk from cache")
-                } /* end if */
-                if(H5D__chunk_cache_prune(io_info->dset, io_info->md_dxpl_id, io_info->dxpl_cache, chunk_size) < 0)
+                if(H5D__chunk_cache_prune(dset, io_info->md_dxpl_id, io_info->dxpl_cache, chunk_size, b2_hit) < 0)
+                    HGOTO_ERROR(H5E_IO, H5E_CANTINIT, NULL, "unable to preempt chunk(s) from cache")
+
+                /* Bring the chunk back, on the T2 list */
+                H5D__chunk_cache_list_remove(pool, ent);
+                list = H5D_RDCC_T2;
+            } /* end if */
+            else {
+                /* Preempt enough things from the cache to make room */
+                if(H5D__chunk_cache_prune(dset, io_info->md_dxpl_id, io_info->dxpl_cache, chunk_size, FALSE) < 0)
                     HGOTO_ERROR(H5E_IO, H5E_CANTINIT, NULL, "unable to preempt chunk(s) from cache")
 
                 /* Create a new entry */
                 if(NULL == (ent = H5FL_CALLOC(H5D_rdcc_ent_t)))
                     HGOTO_ERROR(H5E_DATASET, H5E_CANTALLOC, NULL, "can't allocate raw data chunk entry")
-
-                /* Initialize the new entry */
-                ent->chunk_block.offset = chunk_addr;
-                ent->chunk_block.length = chunk_alloc;
-		ent->chunk_idx = udata->chunk_idx;
+                ent->shared = dset->shared;
                 HDmemcpy(ent->scaled, udata->common.scaled, sizeof(hsize_t) * layout->u.chunk.ndims);
-                H5_CHECKED_ASSIGN(ent->rd_count, uint32_t, chunk_size, size_t);
-                H5_CHECKED_ASSIGN(ent->wr_count, uint32_t, chunk_size, size_t);
-                ent->chunk = (uint8_t *)chunk;
-
-                /* Add it to the cache */
-                HDassert(NULL == rdcc->slot[udata->idx_hint]);
-                rdcc->slot[udata->idx_hint] = ent;
-                ent->idx = udata->idx_hint;
-                rdcc->nbytes_used += chunk_size;
-                rdcc->nused++;
-
-                /* Add it to the linked list */
-                if(rdcc->tail) {
-                    rdcc->tail->next = ent;
-                    ent->prev = rdcc->tail;
-                    rdcc->tail = ent;
+
+                /* Add it to the hash table */
+                if(H5D__chunk_cache_hash_insert(dset->shared, ent) < 0) {
+                    ent = H5FL_FREE(H5D_rdcc_ent_t, ent);
+                    HGOTO_ERROR(H5E_DATASET, H5E_CANTINSERT, NULL, "can't insert raw data chunk entry")
                 } /* end if */
-                else
-                    rdcc->head = rdcc->tail = ent;
-		ent->tmp_next = NULL;
-		ent->tmp_prev = NULL;
+                list = H5D_RDCC_T1;
+            } /* end else */
 
+            /* Initialize the entry */
+            ent->chunk_block.offset = chunk_addr;
+            ent->chunk_block.length = chunk_alloc;
+            ent->chunk_idx = udata->chunk_idx;
+            H5_CHECKED_ASSIGN(ent->rd_count, uint32_t, chunk_size, size_t);
+            H5_CHECKED_ASSIGN(ent->wr_count, uint32_t, chunk_size, size_t);
+            ent->chunk = (uint8_t *)chunk;
+
+            /* Add it to the cache */
+            H5D__chunk_cache_list_append(pool, ent, list);
+            rdcc->nbytes_used += chunk_size;
+            rdcc->nused++;
+
+            /* Add it to the linked list */
+            if(rdcc->tail) {
+                rdcc->tail->next = ent;
+                ent->prev = rdcc->tail;
+                rdcc->tail = ent;
             } /* end if */
             else
-                /* We did not add the chunk to cache */
-                ent = NULL;
-        } /* end else */
+                rdcc->head = rdcc->tail = ent;
+
+            /* Forget about chunks evicted long ago */
+            H5D__chunk_cache_trim_ghosts(pool);
+        } /* end if */
         else /* No cache set up, or chunk is too large: chunk is uncacheable */
             ent = NULL;
     } /* end else */
@@ -3300,14 +5309,18 @@ H5D__chunk_lock(const H5D_io_info_t *io_info, H5D_chunk_ud_t *udata,
         HDassert(!ent->locked);
         ent->locked = TRUE;
         chunk = ent->chunk;
+
+        /* Chunks evicted for other datasets sharing the memory pool are
+         * written back through this object */
+        rdcc->owner = dset;
     } /* end if */
-    else
-        /*
-         * The chunk cannot be placed in cache so we don't cache it. This is the
-         * reason all those arguments have to be repeated for the unlock
-         * function.
-         */
-        udata->idx_hint = UINT_MAX;
+
+    /*
+     * If the chunk cannot be placed in cache we don't cache it. This is the
+     * reason all those arguments have to be repeated for the unlock
+     * function.
+     */
+    udata->ent = ent;
 
     /* Set return value */
     ret_value = chunk;
@@ -3332,8 +5345,8 @@ done:
  * Purpose:	Unlocks a previously locked chunk. The LAYOUT, COMP, and
  *		OFFSET arguments should be the same as for H5D__chunk_lock().
  *		The DIRTY argument should be set to non-zero if the chunk has
- *		been modified since it was locked. The IDX_HINT argument is
- *		the returned index hint from the lock operation and BUF is
+ *		been modified since it was locked. The cache entry in UDATA
+ *		is the one returned from the lock operation and CHUNK is
  *		the return value from the lock.
  *
  *		The NACCESSED argument should be the number of bytes accessed
@@ -3353,7 +5366,6 @@ H5D__chunk_unlock(const H5D_io_info_t *io_info, const H5D_chunk_ud_t *udata,
     hbool_t dirty, void *chunk, uint32_t naccessed)
 {
     const H5O_layout_t *layout = &(io_info->dset->shared->layout); /* Dataset layout */
-    const H5D_rdcc_t	*rdcc = &(io_info->dset->shared->cache.chunk);
     herr_t              ret_value = SUCCEED;      /* Return value */
 
     FUNC_ENTER_STATIC
@@ -3362,7 +5374,7 @@ H5D__chunk_unlock(const H5D_io_info_t *io_info, const H5D_chunk_ud_t *udata,
     HDassert(io_info);
     HDassert(udata);
 
-    if(UINT_MAX == udata->idx_hint) {
+    if(NULL == udata->ent) {
         /*
          * It's not in the cache, probably because it's too big.  If it's
          * dirty then flush it to disk.  In any case, free the chunk.
@@ -3380,7 +5392,7 @@ H5D__chunk_unlock(const H5D_io_info_t *io_info, const H5D_chunk_ud_t *udata,
             fake_ent.chunk_block.length = udata->chunk_block.length;
             fake_ent.chunk = (uint8_t *)chunk;
 
-            if(H5D__chunk_flush_entry(io_info->dset, io_info->md_dxpl_id, io_info->dxpl_cache, &fake_ent, TRUE) < 0)
+            if(H5D__chunk_flush_entry(io_info->dset, io_info->md_dxpl_id, io_info->dxpl_cache, &fake_ent, TRUE, NULL) < 0)
                 HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "cannot flush indexed storage buffer")
         } /* end if */
         else {
@@ -3392,14 +5404,12 @@ H5D__chunk_unlock(const H5D_io_info_t *io_info, const H5D_chunk_ud_t *udata,
         H5D_rdcc_ent_t	*ent;   /* Chunk's entry in the cache */
 
         /* Sanity check */
-	HDassert(udata->idx_hint < rdcc->nslots);
-	HDassert(rdcc->slot[udata->idx_hint]);
-	HDassert(rdcc->slot[udata->idx_hint]->chunk == chunk);
+	HDassert(udata->ent->chunk == chunk);
 
         /*
          * It's in the cache so unlock it.
          */
-        ent = rdcc->slot[udata->idx_hint];
+        ent = udata->ent;
         HDassert(ent->locked);
         if(dirty) {
             ent->dirty = TRUE;
@@ -3480,7 +5490,7 @@ H5D__chunk_allocated(H5D_t *dset, hid_t dxpl_id, hsize_t *nbytes)
     /* Search for cached chunks that haven't been written out */
     for(ent = rdcc->head; ent; ent = ent->next) {
         /* Flush the chunk out to disk, to make certain the size is correct later */
-        if(H5D__chunk_flush_entry(dset, dxpl_id, dxpl_cache, ent, FALSE) < 0)
+        if(H5D__chunk_flush_entry(dset, dxpl_id, dxpl_cache, ent, FALSE, NULL) < 0)
             HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "cannot flush indexed storage buffer")
     } /* end for */
 
@@ -4059,7 +6069,7 @@ H5D__chunk_prune_fill(H5D_chunk_it_ud1_t *udata)
         HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "error looking up chunk address")
 
     /* If this chunk does not exist in cache or on disk, no need to do anything */
-    if(!H5F_addr_defined(chk_udata.chunk_block.offset) && UINT_MAX == chk_udata.idx_hint)
+    if(!H5F_addr_defined(chk_udata.chunk_block.offset) && NULL == chk_udata.ent)
         HGOTO_DONE(SUCCEED)
 
     /* Initialize the fill value buffer, if necessary */
@@ -4088,7 +6098,7 @@ H5D__chunk_prune_fill(H5D_chunk_it_ud1_t *udata)
         HGOTO_ERROR(H5E_DATASET, H5E_CANTSELECT, FAIL, "unable to select hyperslab")
 
     /* Lock the chunk into the cache, to get a pointer to the chunk buffer */
-    if(NULL == (chunk = (void *)H5D__chunk_lock(io_info, &chk_udata, FALSE)))
+    if(NULL == (chunk = (void *)H5D__chunk_lock(io_info, &chk_udata, FALSE, NULL)))
         HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "unable to lock raw data chunk")
 
 
@@ -4248,7 +6258,6 @@ H5D__chunk_prune_by_extent(H5D_t *dset, hid_t dxpl_id, const hsize_t *old_dim)
     H5D_dxpl_cache_t        _dxpl_cache;        /* Data transfer property cache buffer */
     H5D_dxpl_cache_t       *dxpl_cache = &_dxpl_cache;   /* Data transfer property cache */
     const H5O_layout_t     *layout = &(dset->shared->layout);   /* Dataset's layout */
-    const H5D_rdcc_t       *rdcc = &(dset->shared->cache.chunk);	/*raw data chunk cache */
     unsigned                space_ndims;        /* Dataset's space rank */
     const hsize_t          *space_dim;          /* Current dataspace dimensions */
     unsigned                op_dim;             /* Current operating dimension */
@@ -4443,8 +6452,8 @@ H5D__chunk_prune_by_extent(H5D_t *dset, hid_t dxpl_id, const hsize_t *old_dim)
 
                 /* Evict the entry from the cache if present, but do not flush
                  * it to disk */
-                if(UINT_MAX != chk_udata.idx_hint)
-                    if(H5D__chunk_cache_evict(dset, dxpl_id, dxpl_cache, rdcc->slot[chk_udata.idx_hint], FALSE) < 0)
+                if(chk_udata.ent)
+                    if(H5D__chunk_cache_evict(dset, dxpl_id, dxpl_cache, chk_udata.ent, FALSE) < 0)
                         HGOTO_ERROR(H5E_DATASET, H5E_CANTREMOVE, FAIL, "unable to evict chunk")
 
                 /* Remove the chunk from disk, if present */
@@ -4602,6 +6611,86 @@ H5D__chunk_addrmap(const H5D_io_info_t *io_info, haddr_t chunk_addr[])
 done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5D__chunk_addrmap() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_update_block
+ *
+ * Purpose:     Update a chunk's location in the file after it was filtered
+ *              during a collective write.  The chunk is reallocated if its
+ *              size changed, and the chunk index is updated with the new
+ *              location & filter mask.  A copy of the chunk in the chunk
+ *              cache is out of date, so it is evicted, without flushing it.
+ *
+ *              UDATA holds the chunk information returned by
+ *              H5D__chunk_lookup() on input, and the chunk's new location
+ *              on output.
+ *
+ *              All processes must make the same calls, in the same order,
+ *              to keep the file's metadata consistent.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5D__chunk_update_block(const H5D_io_info_t *io_info, H5D_chunk_ud_t *udata,
+    hsize_t nbytes, unsigned filter_mask)
+{
+    const H5D_t *dset = io_info->dset;  /* Local pointer to dataset info */
+    H5D_rdcc_t *rdcc = &(dset->shared->cache.chunk);   /* Raw data chunk cache */
+    H5D_chk_idx_info_t idx_info;        /* Chunked index info */
+    H5F_block_t old_block;              /* Previous location of chunk */
+    hbool_t need_insert = FALSE;        /* Whether the chunk needs to be inserted into the index */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    HDassert(io_info);
+    HDassert(udata);
+    HDassert(dset->shared->dcpl_cache.pline.nused > 0);
+
+    /* Evict any cached copy of the chunk */
+    if(udata->ent) {
+        HDassert(!udata->ent->locked);
+
+        if(H5D__chunk_cache_evict(dset, io_info->md_dxpl_id, io_info->dxpl_cache, udata->ent, FALSE) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_CANTFLUSH, FAIL, "unable to preempt chunk from cache")
+        udata->ent = NULL;
+    } /* end if */
+
+    /* Compose chunked index info struct */
+    idx_info.f = dset->oloc.file;
+    idx_info.dxpl_id = io_info->md_dxpl_id;
+    idx_info.pline = &dset->shared->dcpl_cache.pline;
+    idx_info.layout = &dset->shared->layout.u.chunk;
+    idx_info.storage = &dset->shared->layout.storage.u.chunk;
+
+    /* Create the chunk if it doesn't exist, or reallocate the chunk if
+     *  its size changed.
+     */
+    if(nbytes > ((hsize_t)0xffffffff))
+        HGOTO_ERROR(H5E_DATASET, H5E_BADRANGE, FAIL, "chunk too large for 32-bit length")
+    old_block = udata->chunk_block;
+    udata->chunk_block.offset = HADDR_UNDEF;
+    H5_CHECKED_ASSIGN(udata->chunk_block.length, uint32_t, nbytes, hsize_t);
+    /*OKAY: CAST DISCARDS CONST QUALIFIER*/
+    if(H5D__chunk_file_alloc(&idx_info, &old_block, &udata->chunk_block, &need_insert, (hsize_t *)udata->common.scaled) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTINSERT, FAIL, "unable to insert/resize chunk on chunk level")
+
+    /* Insert the chunk record into the index, if it moved or its filters changed */
+    if((need_insert || filter_mask != udata->filter_mask) && dset->shared->layout.storage.u.chunk.ops->insert) {
+        udata->filter_mask = filter_mask;
+        if((dset->shared->layout.storage.u.chunk.ops->insert)(&idx_info, udata, dset) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTINSERT, FAIL, "unable to insert chunk addr into index")
+    } /* end if */
+
+    /* Cache the chunk's new info */
+    H5D__chunk_cinfo_cache_update(&rdcc->last, udata);
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_update_block() */
 #endif /* H5_HAVE_PARALLEL */
 
 
@@ -4699,14 +6788,9 @@ done:
  *-------------------------------------------------------------------------
  */
 herr_t
-H5D__chunk_update_cache(H5D_t *dset, hid_t dxpl_id)
+H5D__chunk_update_cache(H5D_t *dset, hid_t H5_ATTR_UNUSED dxpl_id)
 {
     H5D_rdcc_t         *rdcc = &(dset->shared->cache.chunk);	/*raw data chunk cache */
-    H5D_rdcc_ent_t     *ent, *next;	/*cache entry  */
-    H5D_rdcc_ent_t     tmp_head;        /* Sentinel entry for temporary entry list */
-    H5D_rdcc_ent_t     *tmp_tail;       /* Tail pointer for temporary entry list */
-    H5D_dxpl_cache_t _dxpl_cache;       /* Data transfer property cache buffer */
-    H5D_dxpl_cache_t *dxpl_cache = &_dxpl_cache;   /* Data transfer property cache */
     herr_t              ret_value = SUCCEED;      /* Return value */
 
     FUNC_ENTER_PACKAGE
@@ -4718,91 +6802,135 @@ H5D__chunk_update_cache(H5D_t *dset, hid_t dxpl_id)
     /* Check the rank */
     HDassert((dset->shared->layout.u.chunk.ndims - 1) > 1);
 
+    /* Recompute the index for each cached chunk (and ghost) that is in
+     * the dataset.  (The hash table's buckets hold any number of entries,
+     * so no chunks need to be evicted.) */
+    if(rdcc->nbuckets > 0)
+        if(H5D__chunk_cache_resize(dset->shared, rdcc->nbuckets) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTRESIZE, FAIL, "unable to update chunk cache hash table")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_update_cache() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_cache_disown
+ *
+ * Purpose:	Writes the dirty chunks cached for a dataset to disk, when
+ *		the dataset object that other datasets sharing the memory
+ *		pool would use to evict them is closed (while the dataset
+ *		stays open through other objects).
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5D__chunk_cache_disown(const H5D_t *dset, hid_t dxpl_id)
+{
+    H5D_dxpl_cache_t _dxpl_cache;       /* Data transfer property cache buffer */
+    H5D_dxpl_cache_t *dxpl_cache = &_dxpl_cache;   /* Data transfer property cache */
+    H5D_rdcc_t *rdcc = &(dset->shared->cache.chunk);    /* Raw data chunk cache */
+    H5D_rdcc_ent_t *ent;                /* Cache entry */
+    unsigned nerrors = 0;               /* Count of any errors encountered when flushing chunks */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    /* Sanity check */
+    HDassert(dset);
+    HDassert(rdcc->owner == dset);
+
+    /* No object to write chunks through, until the cache is used again */
+    rdcc->owner = NULL;
+
     /* Fill the DXPL cache values for later use */
     if(H5D__get_dxpl_cache(dxpl_id, &dxpl_cache) < 0)
         HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't fill dxpl cache")
 
-    /* Add temporary entry list to rdcc */
-    (void)HDmemset(&tmp_head, 0, sizeof(tmp_head));
-    rdcc->tmp_head = &tmp_head;
-    tmp_tail = &tmp_head;
+    /* Flush the dirty chunks, keeping them in the cache */
+    for(ent = rdcc->head; ent; ent = ent->next)
+        if(ent->dirty && H5D__chunk_flush_entry(dset, dxpl_id, dxpl_cache, ent, FALSE, NULL) < 0)
+            nerrors++;
+    if(nerrors)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTFLUSH, FAIL, "unable to flush one or more raw data chunks")
 
-    /* Recompute the index for each cached chunk that is in a dataset */
-    for(ent = rdcc->head; ent; ent = next) {
-        unsigned	    old_idx;	/* Previous index number	*/
-
-        /* Get the pointer to the next cache entry */
-        next = ent->next;
-
-        /* Compute the index for the chunk entry */
-        old_idx = ent->idx;   /* Save for later */
-        ent->idx = H5D__chunk_hash_val(dset->shared, ent->scaled);
-
-        if(old_idx != ent->idx) {
-            H5D_rdcc_ent_t     *old_ent;	/* Old cache entry  */
-
-            /* Check if there is already a chunk at this chunk's new location */
-            old_ent = rdcc->slot[ent->idx];
-            if(old_ent != NULL) {
-                HDassert(old_ent->locked == FALSE);
-                HDassert(old_ent->deleted == FALSE);
-
-                /* Insert the old entry into the temporary list, but do not
-                 * evict (yet).  Make sure we do not make any calls to the index
-                 * until all chunks have updated indices! */
-                HDassert(!old_ent->tmp_next);
-                HDassert(!old_ent->tmp_prev);
-                tmp_tail->tmp_next = old_ent;
-                old_ent->tmp_prev = tmp_tail;
-                tmp_tail = old_ent;
-            } /* end if */
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_cache_disown() */
 
-            /* Insert this chunk into correct location in hash table */
-            rdcc->slot[ent->idx] = ent;
 
-            /* If this chunk was previously on the temporary list and therefore
-             * not in the hash table, remove it from the temporary list.
-             * Otherwise clear the old hash table slot. */
-            if(ent->tmp_prev) {
-                HDassert(tmp_head.tmp_next);
-                HDassert(tmp_tail != &tmp_head);
-                ent->tmp_prev->tmp_next = ent->tmp_next;
-                if(ent->tmp_next) {
-                    ent->tmp_next->tmp_prev = ent->tmp_prev;
-                    ent->tmp_next = NULL;
-                } /* end if */
-                else {
-                    HDassert(tmp_tail == ent);
-                    tmp_tail = ent->tmp_prev;
-                } /* end else */
-                ent->tmp_prev = NULL;
-            } /* end if */
-            else
-                rdcc->slot[old_idx] = NULL;
-        } /* end if */
-    } /* end for */
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_cache_get_stats
+ *
+ * Purpose:	Retrieve the statistics of a dataset's chunk cache, and the
+ *		usage of its memory pool.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5D__chunk_cache_get_stats(const H5D_t *dset, H5D_chunk_cache_stats_t *stats)
+{
+    const H5D_rdcc_t *rdcc = &(dset->shared->cache.chunk);  /* Raw data chunk cache */
 
-    /* tmp_tail is no longer needed, and will be invalidated by
-     * H5D_chunk_cache_evict anyways. */
-    tmp_tail = NULL;
+    FUNC_ENTER_PACKAGE_NOERR
 
-    /* Evict chunks that are still on the temporary list */
-    while(tmp_head.tmp_next) {
-        ent = tmp_head.tmp_next;
+    /* Sanity check */
+    HDassert(dset);
+    HDassert(stats);
+
+    stats->nhits = rdcc->stats.nhits;
+    stats->nmisses = rdcc->stats.nmisses;
+    stats->ninits = rdcc->stats.ninits;
+    stats->nevictions = rdcc->stats.nevictions;
+    stats->nflushes = rdcc->stats.nflushes;
+    stats->nghost_hits = rdcc->stats.nghost_hits;
+    stats->nprefetches = rdcc->stats.nprefetches;
+    stats->nprefetch_hits = rdcc->stats.nprefetch_hits;
+    stats->nwrite_behinds = rdcc->stats.nwrite_behinds;
+    stats->nbytes_used = rdcc->nbytes_used;
+    H5_CHECKED_ASSIGN(stats->nused, size_t, rdcc->nused, int);
+    if(rdcc->pool) {
+        stats->pool_nbytes_used = rdcc->pool->nbytes_used;
+        stats->pool_nbytes_max = rdcc->pool->nbytes_max;
+        stats->pool_shared = rdcc->pool->shared;
+    } /* end if */
+    else {
+        stats->pool_nbytes_used = 0;
+        stats->pool_nbytes_max = 0;
+        stats->pool_shared = FALSE;
+    } /* end else */
 
-        /* Remove the old entry from the cache */
-        if(H5D__chunk_cache_evict(dset, dxpl_id, dxpl_cache, ent, TRUE) < 0)
-            HGOTO_ERROR(H5E_IO, H5E_CANTFLUSH, FAIL, "unable to flush one or more raw data chunks")
-    } /* end while */
+    FUNC_LEAVE_NOAPI(SUCCEED)
+} /* end H5D__chunk_cache_get_stats() */
 
-done:
-    /* Remove temporary list from rdcc */
-    rdcc->tmp_head = NULL;
 
-    FUNC_LEAVE_NOAPI(ret_value)
-} /* end H5D__chunk_update_cache() */
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_cache_reset_stats
+ *
+ * Purpose:	Reset the statistics of a dataset's chunk cache.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5D__chunk_cache_reset_stats(H5D_t *dset)
+{
+    FUNC_ENTER_PACKAGE_NOERR
+
+    /* Sanity check */
+    HDassert(dset);
+
+    HDmemset(&dset->shared->cache.chunk.stats, 0, sizeof(dset->shared->cache.chunk.stats));
+
+    FUNC_LEAVE_NOAPI(SUCCEED)
+} /* end H5D__chunk_cache_reset_stats() */
+
 
-
 /*-------------------------------------------------------------------------
  * Function:    H5D__chunk_copy_cb
  *
@@ -5475,9 +7603,9 @@ H5D__chunk_stats(const H5D_t *dset, hbool_t headers)
 #endif
 
     if (headers) {
-        if (rdcc->nhits>0 || rdcc->nmisses>0) {
-            miss_rate = 100.0 * rdcc->nmisses /
-                    (rdcc->nhits + rdcc->nmisses);
+        if (rdcc->stats.nhits>0 || rdcc->stats.nmisses>0) {
+            miss_rate = 100.0 * (double)rdcc->stats.nmisses /
+                    (double)(rdcc->stats.nhits + rdcc->stats.nmisses);
         } else {
             miss_rate = 0.0;
         }
@@ -5487,9 +7615,9 @@ H5D__chunk_stats(const H5D_t *dset, hbool_t headers)
             sprintf(ascii, "%7.2f%%", miss_rate);
         }
 
-        fprintf(H5DEBUG(AC), "   %-18s %8u %8u %7s %8d+%-9ld\n",
-            "raw data chunks", rdcc->nhits, rdcc->nmisses, ascii,
-            rdcc->ninits, (long)(rdcc->nflushes)-(long)(rdcc->ninits));
+        HDfprintf(H5DEBUG(AC), "   %-18s %8Hu %8Hu %7s %8Hu+%-9ld\n",
+            "raw data chunks", rdcc->stats.nhits, rdcc->stats.nmisses, ascii,
+            rdcc->stats.ninits, (long)(rdcc->stats.nflushes)-(long)(rdcc->stats.ninits));
     }
 
 done:
@@ -5631,7 +7759,7 @@ H5D__chunk_file_alloc(const H5D_chk_idx_info_t *idx_info, const H5F_block_t *old
     HDassert(idx_info->pline);
     HDassert(idx_info->layout);
     HDassert(idx_info->storage);
-    HDassert(H5F_addr_defined(idx_info->storage->idx_addr));
+    HDassert(H5D_CHUNK_IDX_SINGLE == idx_info->storage->idx_type || H5F_addr_defined(idx_info->storage->idx_addr));
     HDassert(new_chunk);
     HDassert(need_insert);
 
@@ -5690,6 +7818,9 @@ H5D__chunk_file_alloc(const H5D_chk_idx_info_t *idx_info, const H5F_block_t *old
     /* Actually allocate space for the chunk in the file */
     if(alloc_chunk) {
 	switch(idx_info->storage->idx_type) {
+	    case H5D_CHUNK_IDX_SINGLE:
+	    case H5D_CHUNK_IDX_FARRAY:
+	    case H5D_CHUNK_IDX_EARRAY:
 	    case H5D_CHUNK_IDX_BTREE:
                 HDassert(new_chunk->length > 0);
 		H5_CHECK_OVERFLOW(new_chunk->length, /*From: */uint32_t, /*To: */hsize_t);
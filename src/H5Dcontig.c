@@ -41,6 +41,7 @@
 #include "H5FLprivate.h"	/* Free Lists                           */
 #include "H5Iprivate.h"		/* IDs			  		*/
 #include "H5MFprivate.h"	/* File memory management		*/
+#include "H5MMprivate.h"	/* Memory management			*/
 #include "H5Oprivate.h"		/* Object headers		  	*/
 #include "H5Pprivate.h"		/* Property lists			*/
 #include "H5VMprivate.h"		/* Vector and array functions		*/
@@ -64,14 +65,6 @@ typedef struct H5D_contig_readvv_sieve_ud_t {
     hid_t dxpl_id;              /* DXPL for operation */
 } H5D_contig_readvv_sieve_ud_t;
 
-/* Callback info for [plain] readvv operation */
-typedef struct H5D_contig_readvv_ud_t {
-    H5F_t *file;                /* File for dataset */
-    haddr_t dset_addr;          /* Address of dataset */
-    unsigned char *rbuf;        /* Pointer to buffer to fill */
-    hid_t dxpl_id;              /* DXPL for operation */
-} H5D_contig_readvv_ud_t;
-
 /* Callback info for sieve buffer writevv operation */
 typedef struct H5D_contig_writevv_sieve_ud_t {
     H5F_t *file;                /* File for dataset */
@@ -81,13 +74,20 @@ typedef struct H5D_contig_writevv_sieve_ud_t {
     hid_t dxpl_id;              /* DXPL for operation */
 } H5D_contig_writevv_sieve_ud_t;
 
-/* Callback info for [plain] writevv operation */
-typedef struct H5D_contig_writevv_ud_t {
+/* Callback info for vector readvv/writevv operations, which gather the
+ * sequences into lists for H5F_block_readv()/H5F_block_writev() */
+typedef struct H5D_contig_vector_ud_t {
     H5F_t *file;                /* File for dataset */
     haddr_t dset_addr;          /* Address of dataset */
-    const unsigned char *wbuf;  /* Pointer to buffer to write */
+    unsigned char *buf;         /* Pointer to buffer to fill or write */
     hid_t dxpl_id;              /* DXPL for operation */
-} H5D_contig_writevv_ud_t;
+    hbool_t do_write;           /* Whether the operation is a write */
+    size_t nused;               /* # of blocks gathered */
+    size_t nalloc;              /* # of blocks the lists can hold */
+    haddr_t *addrs;             /* File addresses of the blocks */
+    size_t *sizes;              /* Sizes of the blocks */
+    void **bufs;                /* Memory buffers of the blocks */
+} H5D_contig_vector_ud_t;
 
 
 /********************/
@@ -112,6 +112,12 @@ static herr_t H5D__contig_flush(H5D_t *dset, hid_t dxpl_id);
 /* Helper routines */
 static herr_t H5D__contig_write_one(H5D_io_info_t *io_info, hsize_t offset,
     size_t size);
+static hbool_t H5D__contig_use_vector(const H5D_io_info_t *io_info,
+    size_t dset_max_nseq, size_t dset_curr_seq, const size_t dset_len_arr[],
+    const hsize_t dset_off_arr[]);
+static ssize_t H5D__contig_vector_io(const H5D_io_info_t *io_info, hbool_t do_write,
+    size_t dset_max_nseq, size_t *dset_curr_seq, size_t dset_len_arr[], hsize_t dset_off_arr[],
+    size_t mem_max_nseq, size_t *mem_curr_seq, size_t mem_len_arr[], hsize_t mem_off_arr[]);
 
 
 /*********************/
@@ -735,7 +741,7 @@ H5D__contig_readvv_sieve_cb(hsize_t dst_off, hsize_t src_off, size_t len,
     if(NULL == dset_contig->sieve_buf) {
         /* Check if we can actually hold the I/O request in the sieve buffer */
         if(len > dset_contig->sieve_buf_size) {
-            if(H5F_block_read(file, H5FD_MEM_DRAW, addr, len, udata->dxpl_id, buf) < 0)
+            if(H5F_block_read_private(file, addr, len, udata->dxpl_id, buf) < 0)
                 HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "block read failed")
         } /* end if */
         else {
@@ -803,7 +809,7 @@ H5D__contig_readvv_sieve_cb(hsize_t dst_off, hsize_t src_off, size_t len,
                 } /* end if */
 
                 /* Read directly into the user's buffer */
-                if(H5F_block_read(file, H5FD_MEM_DRAW, addr, len, udata->dxpl_id, buf) < 0)
+                if(H5F_block_read_private(file, addr, len, udata->dxpl_id, buf) < 0)
                     HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "block read failed")
             } /* end if */
             /* Element size fits within the buffer size */
@@ -858,36 +864,203 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 }   /* end H5D__contig_readvv_sieve_cb() */
 
-
+
 /*-------------------------------------------------------------------------
- * Function:	H5D__contig_readvv_cb
+ * Function:	H5D__contig_use_vector
+ *
+ * Purpose:	Decide whether a list of file sequences should bypass the
+ *		data sieve buffer and go to the file driver as one vector
+ *		request.  That's the case when no two neighboring sequences
+ *		fit into one sieve buffer, since the sieve buffer would then
+ *		be refilled (or bypassed) for every sequence anyway.
  *
- * Purpose:	Callback operator for H5D__contig_readvv() without sieve buffer.
+ * Return:	TRUE/FALSE
+ *
+ *-------------------------------------------------------------------------
+ */
+static hbool_t
+H5D__contig_use_vector(const H5D_io_info_t *io_info, size_t dset_max_nseq,
+    size_t dset_curr_seq, const size_t dset_len_arr[], const hsize_t dset_off_arr[])
+{
+    size_t sieve_buf_size = io_info->dset->shared->cache.contig.sieve_buf_size;
+    size_t u;                   /* Local index variable */
+    hbool_t ret_value = TRUE;   /* Return value */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    /* A single sequence gains nothing from a vector request */
+    if((dset_max_nseq - dset_curr_seq) < 2)
+        HGOTO_DONE(FALSE)
+
+    for(u = dset_curr_seq; u < (dset_max_nseq - 1); u++)
+        if((dset_off_arr[u + 1] + dset_len_arr[u + 1] - dset_off_arr[u]) <= sieve_buf_size)
+            HGOTO_DONE(FALSE)
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+}   /* end H5D__contig_use_vector() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__contig_vector_flush
+ *
+ * Purpose:	Hand the blocks gathered by H5D__contig_vector_cb() to the
+ *		file as one vector request.
  *
  * Return:	Non-negative on success/Negative on failure
  *
- * Programmer:	Quincey Koziol
- *              Thursday, Sept 30, 2010
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__contig_vector_flush(H5D_contig_vector_ud_t *udata)
+{
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    if(udata->nused > 0) {
+        if(udata->do_write) {
+            if(H5F_block_writev(udata->file, H5FD_MEM_DRAW, udata->nused, udata->addrs, udata->sizes, udata->dxpl_id, (const void **)udata->bufs) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "block write failed")
+        } /* end if */
+        else
+            if(H5F_block_readv(udata->file, H5FD_MEM_DRAW, udata->nused, udata->addrs, udata->sizes, udata->dxpl_id, udata->bufs) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "block read failed")
+        udata->nused = 0;
+    } /* end if */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+}   /* end H5D__contig_vector_flush() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__contig_vector_cb
+ *
+ * Purpose:	Callback operator for H5D__contig_vector_io().  Appends a
+ *		block to the vector lists, merging it into the previous
+ *		block when both are adjacent in the file and in memory.
+ *
+ * Return:	Non-negative on success/Negative on failure
  *
  *-------------------------------------------------------------------------
  */
 static herr_t
-H5D__contig_readvv_cb(hsize_t dst_off, hsize_t src_off, size_t len, void *_udata)
+H5D__contig_vector_cb(hsize_t dst_off, hsize_t src_off, size_t len, void *_udata)
 {
-    H5D_contig_readvv_ud_t *udata = (H5D_contig_readvv_ud_t *)_udata; /* User data for H5VM_opvv() operator */
+    H5D_contig_vector_ud_t *udata = (H5D_contig_vector_ud_t *)_udata; /* User data for H5VM_opvv() operator */
+    haddr_t addr = udata->dset_addr + dst_off;  /* Address of block in file */
+    unsigned char *buf = udata->buf + src_off;  /* Address of block in memory */
     herr_t ret_value = SUCCEED;         /* Return value */
 
     FUNC_ENTER_STATIC
 
-    /* Write data */
-    if(H5F_block_read(udata->file, H5FD_MEM_DRAW, (udata->dset_addr + dst_off),
-            len, udata->dxpl_id, (udata->rbuf + src_off)) < 0)
-        HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "block write failed")
+    /* Extend the previous block, if possible */
+    if(udata->nused > 0
+            && (udata->addrs[udata->nused - 1] + udata->sizes[udata->nused - 1]) == addr
+            && ((unsigned char *)udata->bufs[udata->nused - 1] + udata->sizes[udata->nused - 1]) == buf)
+        udata->sizes[udata->nused - 1] += len;
+    else {
+        /* Make room for a new block */
+        if(udata->nused == udata->nalloc)
+            if(H5D__contig_vector_flush(udata) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTFLUSH, FAIL, "can't flush vector I/O request")
+
+        udata->addrs[udata->nused] = addr;
+        udata->sizes[udata->nused] = len;
+        udata->bufs[udata->nused] = buf;
+        udata->nused++;
+    } /* end else */
 
 done:
     FUNC_LEAVE_NOAPI(ret_value)
-}   /* end H5D__contig_readvv_cb() */
+}   /* end H5D__contig_vector_cb() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__contig_vector_io
+ *
+ * Purpose:	Reads or writes some data vectors with as few requests to
+ *		the file driver as possible, by gathering the sequences
+ *		into address/size/buffer lists for H5F_block_readv() or
+ *		H5F_block_writev().
+ *
+ *		If the dataset's sieve buffer covers any of the data it is
+ *		flushed first, and for writes it is also discarded, so the
+ *		sieve buffer never holds stale data.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static ssize_t
+H5D__contig_vector_io(const H5D_io_info_t *io_info, hbool_t do_write,
+    size_t dset_max_nseq, size_t *dset_curr_seq, size_t dset_len_arr[], hsize_t dset_off_arr[],
+    size_t mem_max_nseq, size_t *mem_curr_seq, size_t mem_len_arr[], hsize_t mem_off_arr[])
+{
+    H5D_rdcdc_t *dset_contig = &(io_info->dset->shared->cache.contig); /* Cached information about contiguous data */
+    H5D_contig_vector_ud_t udata;       /* User data for H5VM_opvv() operator */
+    ssize_t ret_value = -1;             /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Set up user data for H5VM_opvv() */
+    udata.file = io_info->dset->oloc.file;
+    udata.dset_addr = io_info->store->contig.dset_addr;
+    udata.buf = do_write ? (unsigned char *)io_info->u.wbuf : (unsigned char *)io_info->u.rbuf;
+    udata.dxpl_id = io_info->raw_dxpl_id;
+    udata.do_write = do_write;
+    udata.nused = 0;
+    udata.nalloc = MAX((dset_max_nseq - *dset_curr_seq) + (mem_max_nseq - *mem_curr_seq), 1);
+    udata.addrs = NULL;
+    udata.sizes = NULL;
+    udata.bufs = NULL;
+
+    /* Keep the sieve buffer coherent with the vector request */
+    if(dset_contig->sieve_buf && dset_contig->sieve_size > 0 && *dset_curr_seq < dset_max_nseq) {
+        haddr_t start = udata.dset_addr + dset_off_arr[*dset_curr_seq];
+        haddr_t end = udata.dset_addr + dset_off_arr[dset_max_nseq - 1] + dset_len_arr[dset_max_nseq - 1];
+
+        if(H5F_addr_overlap(start, (hsize_t)(end - start), dset_contig->sieve_loc, (hsize_t)dset_contig->sieve_size)) {
+            if(dset_contig->sieve_dirty) {
+                if(H5F_block_write(udata.file, H5FD_MEM_DRAW, dset_contig->sieve_loc, dset_contig->sieve_size, udata.dxpl_id, dset_contig->sieve_buf) < 0)
+                    HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "block write failed")
+                dset_contig->sieve_dirty = FALSE;
+            } /* end if */
+
+            /* Force the sieve buffer to be re-read the next time */
+            if(do_write) {
+                dset_contig->sieve_loc = HADDR_UNDEF;
+                dset_contig->sieve_size = 0;
+            } /* end if */
+        } /* end if */
+    } /* end if */
+
+    /* Allocate the vector lists */
+    if(NULL == (udata.addrs = (haddr_t *)H5MM_malloc(udata.nalloc * sizeof(haddr_t))))
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTALLOC, FAIL, "memory allocation failed for address list")
+    if(NULL == (udata.sizes = (size_t *)H5MM_malloc(udata.nalloc * sizeof(size_t))))
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTALLOC, FAIL, "memory allocation failed for size list")
+    if(NULL == (udata.bufs = (void **)H5MM_malloc(udata.nalloc * sizeof(void *))))
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTALLOC, FAIL, "memory allocation failed for buffer list")
+
+    /* Gather the blocks */
+    if((ret_value = H5VM_opvv(dset_max_nseq, dset_curr_seq, dset_len_arr, dset_off_arr,
+            mem_max_nseq, mem_curr_seq, mem_len_arr, mem_off_arr,
+            H5D__contig_vector_cb, &udata)) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTOPERATE, FAIL, "can't gather vector I/O request")
+
+    /* Issue the request */
+    if(H5D__contig_vector_flush(&udata) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTFLUSH, FAIL, "can't flush vector I/O request")
+
+done:
+    udata.addrs = (haddr_t *)H5MM_xfree(udata.addrs);
+    udata.sizes = (size_t *)H5MM_xfree(udata.sizes);
+    udata.bufs = (void **)H5MM_xfree(udata.bufs);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+}   /* end H5D__contig_vector_io() */
 
 /*-------------------------------------------------------------------------
  * Function:	H5D__contig_readvv
@@ -925,8 +1098,9 @@ H5D__contig_readvv(const H5D_io_info_t *io_info,
     HDassert(mem_len_arr);
     HDassert(mem_off_arr);
 
-    /* Check if data sieving is enabled */
-    if(H5F_HAS_FEATURE(io_info->dset->oloc.file, H5FD_FEAT_DATA_SIEVE)) {
+    /* Check if data sieving is enabled and worthwhile for these sequences */
+    if(H5F_HAS_FEATURE(io_info->dset->oloc.file, H5FD_FEAT_DATA_SIEVE)
+            && !H5D__contig_use_vector(io_info, dset_max_nseq, *dset_curr_seq, dset_len_arr, dset_off_arr)) {
         H5D_contig_readvv_sieve_ud_t udata;     /* User data for H5VM_opvv() operator */
 
         /* Set up user data for H5VM_opvv() */
@@ -943,18 +1117,10 @@ H5D__contig_readvv(const H5D_io_info_t *io_info,
             HGOTO_ERROR(H5E_DATASET, H5E_CANTOPERATE, FAIL, "can't perform vectorized sieve buffer read")
     } /* end if */
     else {
-        H5D_contig_readvv_ud_t udata;     /* User data for H5VM_opvv() operator */
-
-        /* Set up user data for H5VM_opvv() */
-        udata.file = io_info->dset->oloc.file;
-        udata.dset_addr = io_info->store->contig.dset_addr;
-        udata.rbuf = (unsigned char *)io_info->u.rbuf;
-        udata.dxpl_id = io_info->raw_dxpl_id;
-
-        /* Call generic sequence operation routine */
-        if((ret_value = H5VM_opvv(dset_max_nseq, dset_curr_seq, dset_len_arr, dset_off_arr,
-                mem_max_nseq, mem_curr_seq, mem_len_arr, mem_off_arr,
-                H5D__contig_readvv_cb, &udata)) < 0)
+        /* Read the sequences with one vector request to the file driver */
+        if((ret_value = H5D__contig_vector_io(io_info, FALSE,
+                dset_max_nseq, dset_curr_seq, dset_len_arr, dset_off_arr,
+                mem_max_nseq, mem_curr_seq, mem_len_arr, mem_off_arr)) < 0)
             HGOTO_ERROR(H5E_DATASET, H5E_CANTOPERATE, FAIL, "can't perform vectorized read")
     } /* end else */
 
@@ -1184,36 +1350,6 @@ H5D__contig_writevv_sieve_cb(hsize_t dst_off, hsize_t src_off, size_t len,
 done:
     FUNC_LEAVE_NOAPI(ret_value)
 }   /* end H5D__contig_writevv_sieve_cb() */
-
-
-/*-------------------------------------------------------------------------
- * Function:	H5D__contig_writevv_cb
- *
- * Purpose:	Callback operator for H5D__contig_writevv().
- *
- * Return:	Non-negative on success/Negative on failure
- *
- * Programmer:	Quincey Koziol
- *              Thursday, Sept 30, 2010
- *
- *-------------------------------------------------------------------------
- */
-static herr_t
-H5D__contig_writevv_cb(hsize_t dst_off, hsize_t src_off, size_t len, void *_udata)
-{
-    H5D_contig_writevv_ud_t *udata = (H5D_contig_writevv_ud_t *)_udata; /* User data for H5VM_opvv() operator */
-    herr_t ret_value = SUCCEED; /* Return value */
-
-    FUNC_ENTER_STATIC
-
-    /* Write data */
-    if(H5F_block_write(udata->file, H5FD_MEM_DRAW, (udata->dset_addr + dst_off), len, udata->dxpl_id, (udata->wbuf + src_off)) < 0)
-        HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "block write failed")
-
-done:
-    FUNC_LEAVE_NOAPI(ret_value)
-}   /* end H5D__contig_writevv_cb() */
-
 
 /*-------------------------------------------------------------------------
  * Function:	H5D__contig_writevv
@@ -1251,8 +1387,9 @@ H5D__contig_writevv(const H5D_io_info_t *io_info,
     HDassert(mem_len_arr);
     HDassert(mem_off_arr);
 
-    /* Check if data sieving is enabled */
-    if(H5F_HAS_FEATURE(io_info->dset->oloc.file, H5FD_FEAT_DATA_SIEVE)) {
+    /* Check if data sieving is enabled and worthwhile for these sequences */
+    if(H5F_HAS_FEATURE(io_info->dset->oloc.file, H5FD_FEAT_DATA_SIEVE)
+            && !H5D__contig_use_vector(io_info, dset_max_nseq, *dset_curr_seq, dset_len_arr, dset_off_arr)) {
         H5D_contig_writevv_sieve_ud_t udata;    /* User data for H5VM_opvv() operator */
 
         /* Set up user data for H5VM_opvv() */
@@ -1269,19 +1406,11 @@ H5D__contig_writevv(const H5D_io_info_t *io_info,
             HGOTO_ERROR(H5E_DATASET, H5E_CANTOPERATE, FAIL, "can't perform vectorized sieve buffer write")
     } /* end if */
     else {
-        H5D_contig_writevv_ud_t udata;     /* User data for H5VM_opvv() operator */
-
-        /* Set up user data for H5VM_opvv() */
-        udata.file = io_info->dset->oloc.file;
-        udata.dset_addr = io_info->store->contig.dset_addr;
-        udata.wbuf = (const unsigned char *)io_info->u.wbuf;
-        udata.dxpl_id = io_info->raw_dxpl_id;
-
-        /* Call generic sequence operation routine */
-        if((ret_value = H5VM_opvv(dset_max_nseq, dset_curr_seq, dset_len_arr, dset_off_arr,
-                mem_max_nseq, mem_curr_seq, mem_len_arr, mem_off_arr,
-                H5D__contig_writevv_cb, &udata)) < 0)
-            HGOTO_ERROR(H5E_DATASET, H5E_CANTOPERATE, FAIL, "can't perform vectorized read")
+        /* Write the sequences with one vector request to the file driver */
+        if((ret_value = H5D__contig_vector_io(io_info, TRUE,
+                dset_max_nseq, dset_curr_seq, dset_len_arr, dset_off_arr,
+                mem_max_nseq, mem_curr_seq, mem_len_arr, mem_off_arr)) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTOPERATE, FAIL, "can't perform vectorized write")
     } /* end else */
 
 done:
@@ -325,10 +325,10 @@ H5D__extend(H5D_t *dataset, const hsize_t *size, hid_t dxpl_id)
                         dataset->shared->cache.chunk.scaled_dims[u] = scaled;
 
                         /* Check if algorithm for computing hash values will change */
-                        if((scaled > dataset->shared->cache.chunk.nslots &&
-                                    dataset->shared->cache.chunk.scaled_dims[u] <= dataset->shared->cache.chunk.nslots)
-                                || (scaled <= dataset->shared->cache.chunk.nslots &&
-                                    dataset->shared->cache.chunk.scaled_dims[u] > dataset->shared->cache.chunk.nslots))
+                        if((scaled > dataset->shared->cache.chunk.nbuckets &&
+                                    dataset->shared->cache.chunk.scaled_dims[u] <= dataset->shared->cache.chunk.nbuckets)
+                                || (scaled <= dataset->shared->cache.chunk.nbuckets &&
+                                    dataset->shared->cache.chunk.scaled_dims[u] > dataset->shared->cache.chunk.nbuckets))
                             update_chunks = TRUE;
 
                         /* Check if the number of bits required to encode the scaled size value changed */
@@ -324,7 +324,8 @@ H5D_term_package(void)
     Non-negative on success/Negative on failure.
  DESCRIPTION
     Query all the values from a DXPL that are needed by internal routines
-    within the library.
+    within the library.  The DXPL keeps them decoded between calls, until
+    one of them changes.
  GLOBAL VARIABLES
  COMMENTS, BUGS, ASSUMPTIONS
  EXAMPLES
@@ -345,52 +346,9 @@ H5D__get_dxpl_cache_real(hid_t dxpl_id, H5D_dxpl_cache_t *cache)
     if(NULL == (dx_plist = (H5P_genplist_t *)H5I_object(dxpl_id)))
         HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a dataset transfer property list")
 
-    /* Get maximum temporary buffer size */
-    if(H5P_get(dx_plist, H5D_XFER_MAX_TEMP_BUF_NAME, &cache->max_temp_buf) < 0)
-        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "Can't retrieve maximum temporary buffer size")
-
-    /* Get temporary buffer pointer */
-    if(H5P_get(dx_plist, H5D_XFER_TCONV_BUF_NAME, &cache->tconv_buf) < 0)
-        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "Can't retrieve temporary buffer pointer")
-
-    /* Get background buffer pointer */
-    if(H5P_get(dx_plist, H5D_XFER_BKGR_BUF_NAME, &cache->bkgr_buf) < 0)
-        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "Can't retrieve background buffer pointer")
-
-    /* Get background buffer type */
-    if(H5P_get(dx_plist, H5D_XFER_BKGR_BUF_TYPE_NAME, &cache->bkgr_buf_type) < 0)
-        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "Can't retrieve background buffer type")
-
-    /* Get B-tree split ratios */
-    if(H5P_get(dx_plist, H5D_XFER_BTREE_SPLIT_RATIO_NAME, &cache->btree_split_ratio) < 0)
-        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "Can't retrieve B-tree split ratios")
-
-    /* Get I/O vector size */
-    if(H5P_get(dx_plist, H5D_XFER_HYPER_VECTOR_SIZE_NAME, &cache->vec_size) < 0)
-        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "Can't retrieve I/O vector size")
-
-#ifdef H5_HAVE_PARALLEL
-    /* Collect Parallel I/O information for possible later use */
-    if(H5P_get(dx_plist, H5D_XFER_IO_XFER_MODE_NAME, &cache->xfer_mode) < 0)
-        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "Can't retrieve parallel transfer method")
-    if(H5P_get(dx_plist, H5D_XFER_MPIO_COLLECTIVE_OPT_NAME, &cache->coll_opt_mode) < 0)
-        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "Can't retrieve collective transfer option")
-#endif /* H5_HAVE_PARALLEL */
-
-    /* Get error detection properties */
-    if(H5P_get(dx_plist, H5D_XFER_EDC_NAME, &cache->err_detect) < 0)
-        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "Can't retrieve error detection info")
-
-    /* Get filter callback function */
-    if(H5P_get(dx_plist, H5D_XFER_FILTER_CB_NAME, &cache->filter_cb) < 0)
-        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "Can't retrieve filter callback function")
-
-    /* Look at the data transform property */
-    /* (Note: 'peek', not 'get' - if this turns out to be a problem, we should
-     *          add a H5D__free_dxpl_cache() routine. -QAK)
-     */
-    if(H5P_peek(dx_plist, H5D_XFER_XFORM_NAME, &cache->data_xform_prop) < 0)
-        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "Can't retrieve data transform info")
+    /* Get the values from the DXPL's cached copy */
+    if(H5P_get_cache(dx_plist, cache) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "Can't retrieve DXPL values")
 
 done:
     FUNC_LEAVE_NOAPI(ret_value)
@@ -1195,10 +1153,16 @@ H5D__create(H5F_t *file, hid_t type_id, const H5S_t *space, hid_t dcpl_id,
         /* Don't allow compact datasets to allocate space later */
         if(layout->type == H5D_COMPACT && fill->alloc_time != H5D_ALLOC_TIME_EARLY)
             HGOTO_ERROR(H5E_DATASET, H5E_BADVALUE, NULL, "compact dataset must have early space allocation")
+    } /* end if */
 
-        /* If MPI VFD is used, no filter support yet. */
-        if(H5F_HAS_FEATURE(file, H5FD_FEAT_HAS_MPI) && pline->nused > 0)
-            HGOTO_ERROR(H5E_DATASET, H5E_UNSUPPORTED, NULL, "Parallel I/O does not support filters yet")
+    /* Chunked datasets start out with the v1 B-tree index, which all
+     * versions of the library can read.  (The DCPL may have been retrieved
+     * from a dataset that uses a different index.)
+     */
+    if(H5D_CHUNKED == new_dset->shared->layout.type) {
+        new_dset->shared->layout.version = H5O_LAYOUT_VERSION_DEFAULT;
+        new_dset->shared->layout.u.chunk.flags = 0;
+        new_dset->shared->layout.storage.u.chunk.idx_type = H5D_CHUNK_IDX_BTREE;
     } /* end if */
 
     /* Set the latest version of the layout, pline & fill messages, if requested */
@@ -1216,6 +1180,12 @@ H5D__create(H5F_t *file, hid_t type_id, const H5S_t *space, hid_t dcpl_id,
     if(H5F_HAS_FEATURE(file, H5FD_FEAT_ALLOCATE_EARLY))
         new_dset->shared->dcpl_cache.fill.alloc_time = H5D_ALLOC_TIME_EARLY;
 
+    /* Set the latest indexing type for the layout message, if requested */
+    /* (This depends on the space allocation time, so it must come after it is settled) */
+    if(H5F_USE_LATEST_FORMAT(file))
+        if(H5D__layout_set_latest_indexing(&new_dset->shared->layout, new_dset->shared->space, &new_dset->shared->dcpl_cache) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTSET, NULL, "can't set latest indexing")
+
     /* Set the dataset's I/O operations */
     if(H5D__layout_set_io_ops(new_dset) < 0)
         HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, NULL, "unable to initialize I/O operations")
@@ -1804,6 +1774,13 @@ H5D_close(H5D_t *dataset)
         dataset->shared = H5FL_FREE(H5D_shared_t, dataset->shared);
     } /* end if */
     else {
+        /* Write back the chunks cached for this dataset through this
+         *      object, which may not be used to evict them anymore */
+        if(H5D_CHUNKED == dataset->shared->layout.type
+                && dataset->shared->cache.chunk.owner == dataset)
+            if(H5D__chunk_cache_disown(dataset, H5AC_ind_read_dxpl_id) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTFLUSH, FAIL, "unable to flush cached raw data")
+
         /* Decrement the ref. count for this object in the top file */
         if(H5FO_top_decr(dataset->oloc.file, dataset->oloc.addr) < 0)
             HGOTO_ERROR(H5E_DATASET, H5E_CANTRELEASE, FAIL, "can't decrement count for object")
@@ -2538,10 +2515,10 @@ H5D__set_extent(H5D_t *dset, const hsize_t *size, hid_t dxpl_id)
                     dset->shared->cache.chunk.scaled_dims[u] = scaled;
 
                     /* Check if algorithm for computing hash values will change */
-                    if((scaled > dset->shared->cache.chunk.nslots &&
-                                dset->shared->cache.chunk.scaled_dims[u] <= dset->shared->cache.chunk.nslots)
-                            || (scaled <= dset->shared->cache.chunk.nslots &&
-                                dset->shared->cache.chunk.scaled_dims[u] > dset->shared->cache.chunk.nslots))
+                    if((scaled > dset->shared->cache.chunk.nbuckets &&
+                                dset->shared->cache.chunk.scaled_dims[u] <= dset->shared->cache.chunk.nbuckets)
+                            || (scaled <= dset->shared->cache.chunk.nbuckets &&
+                                dset->shared->cache.chunk.scaled_dims[u] > dset->shared->cache.chunk.nbuckets))
                         update_chunks = TRUE;
 
                     /* Check if the number of bits required to encode the scaled size value changed */
@@ -2566,6 +2543,10 @@ H5D__set_extent(H5D_t *dset, const hsize_t *size, hid_t dxpl_id)
          */
         /* Update the index values for the cached chunks for this dataset */
         if(H5D_CHUNKED == dset->shared->layout.type) {
+            /* Chunk indices change, and chunks read ahead may be pruned */
+            if(H5D__chunk_prefetch_reset(dset) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTFREE, FAIL, "can't release chunks read ahead")
+
             /* Set the cached chunk info */
             if(H5D__chunk_set_info(dset) < 0)
                 HGOTO_ERROR(H5E_DATASET, H5E_CANTSET, FAIL, "unable to update # of chunks")
@@ -2629,6 +2610,11 @@ H5D__set_extent(H5D_t *dset, const hsize_t *size, hid_t dxpl_id)
             HGOTO_ERROR(H5E_DATASET, H5E_CANTSET, FAIL, "unable to mark dataspace as dirty")
     } /* end if */
 
+    /* Publish the new extent to SWMR readers right away */
+    if(changed && (H5F_INTENT(dset->oloc.file) & H5F_ACC_SWMR_WRITE))
+        if(H5D__flush(dset, dxpl_id) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTFLUSH, FAIL, "unable to flush dataset")
+
 done:
     FUNC_LEAVE_NOAPI_TAG(ret_value, FAIL)
 } /* end H5D__set_extent() */
@@ -2711,6 +2697,139 @@ done:
     FUNC_LEAVE_NOAPI_TAG(ret_value, FAIL)
 } /* end H5D__flush_real() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__flush
+ *
+ * Purpose:     Flush a dataset's raw data and then all of its metadata to
+ *              the file, making its current state visible to SWMR
+ *              readers.
+ *
+ * Return:	Success:	Non-negative
+ *		Failure:	Negative
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5D__flush(H5D_t *dataset, hid_t dxpl_id)
+{
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_PACKAGE_TAG(dxpl_id, dataset->oloc.addr, FAIL)
+
+    /* Check args */
+    HDassert(dataset);
+    HDassert(dataset->shared);
+
+    /* Flush the raw data first, so the metadata never points to data
+     * that isn't in the file yet */
+    if(H5D__flush_real(dataset, dxpl_id) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTFLUSH, FAIL, "unable to flush cached dataset info")
+
+    /* Flush the metadata tagged with the dataset's object header address */
+    if(H5AC_flush_tagged_metadata(dataset->oloc.file, dataset->oloc.addr, dxpl_id) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTFLUSH, FAIL, "unable to flush dataset metadata")
+
+done:
+    FUNC_LEAVE_NOAPI_TAG(ret_value, FAIL)
+} /* end H5D__flush() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__refresh
+ *
+ * Purpose:     Discard everything cached in memory about a dataset and
+ *              re-read its dataspace and storage layout from the file, so
+ *              that a SWMR reader sees the writer's latest flushed state.
+ *
+ * Return:	Success:	Non-negative
+ *		Failure:	Negative
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5D__refresh(H5D_t *dataset, hid_t dxpl_id)
+{
+    H5S_t *space = NULL;                /* Dataspace re-read from file */
+    H5O_layout_t layout;                /* Layout message re-read from file */
+    hbool_t layout_read = FALSE;        /* Whether the layout message was read */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_PACKAGE_TAG(dxpl_id, dataset->oloc.addr, FAIL)
+
+    /* Check args */
+    HDassert(dataset);
+    HDassert(dataset->shared);
+
+    /* Virtual datasets don't keep their data in this file */
+    if(H5D_VIRTUAL == dataset->shared->layout.type)
+        HGOTO_DONE(SUCCEED)
+
+    /* Allow addresses of anything the writer has added to the file */
+    if(H5F_refresh_eoa(dataset->oloc.file) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "unable to refresh end of allocated space")
+
+    /* Release the chunks and the chunk index, which pins its metadata */
+    if(H5D_CHUNKED == dataset->shared->layout.type)
+        if(H5D__chunk_release(dataset, dxpl_id) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTFREE, FAIL, "unable to release cached chunks")
+
+    /* Evict the dataset's metadata, so it is read again from the file */
+    if(H5AC_evict_tagged_metadata(dataset->oloc.file, dataset->oloc.addr, dxpl_id) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTEXPUNGE, FAIL, "unable to evict dataset metadata")
+
+    /* Update the dataset's dataspace */
+    if(NULL == (space = H5S_read(&(dataset->oloc), dxpl_id)))
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTLOAD, FAIL, "unable to load dataspace info from dataset header")
+    if(H5S_extent_copy(dataset->shared->space, space) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTCOPY, FAIL, "unable to copy dataspace extent")
+    if(H5D__cache_dataspace_info(dataset) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTCOPY, FAIL, "can't cache dataspace info")
+
+    /* Update where the dataset's raw data is stored */
+    HDmemset(&layout, 0, sizeof(layout));
+    if(NULL == H5O_msg_read(&(dataset->oloc), H5O_LAYOUT_ID, &layout, dxpl_id))
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTLOAD, FAIL, "unable to load layout info from dataset header")
+    layout_read = TRUE;
+    if(layout.type != dataset->shared->layout.type)
+        HGOTO_ERROR(H5E_DATASET, H5E_BADVALUE, FAIL, "dataset layout changed")
+    switch(dataset->shared->layout.type) {
+        case H5D_CONTIGUOUS:
+            dataset->shared->layout.storage.u.contig.addr = layout.storage.u.contig.addr;
+            dataset->shared->layout.storage.u.contig.size = layout.storage.u.contig.size;
+            break;
+
+        case H5D_CHUNKED:
+            dataset->shared->layout.storage.u.chunk.idx_addr = layout.storage.u.chunk.idx_addr;
+            if(H5D__chunk_refresh(dataset, dxpl_id) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "unable to refresh chunk index")
+            break;
+
+        case H5D_COMPACT:
+            /* Take over the buffer just read */
+            H5MM_xfree(dataset->shared->layout.storage.u.compact.buf);
+            dataset->shared->layout.storage.u.compact.buf = layout.storage.u.compact.buf;
+            dataset->shared->layout.storage.u.compact.size = layout.storage.u.compact.size;
+            dataset->shared->layout.storage.u.compact.dirty = FALSE;
+            layout.storage.u.compact.buf = NULL;
+            break;
+
+        case H5D_VIRTUAL:
+        case H5D_LAYOUT_ERROR:
+        case H5D_NLAYOUTS:
+        default:
+            HGOTO_ERROR(H5E_DATASET, H5E_UNSUPPORTED, FAIL, "unsupported storage layout")
+    } /* end switch */
+
+done:
+    if(space && H5S_close(space) < 0)
+        HDONE_ERROR(H5E_DATASET, H5E_CLOSEERROR, FAIL, "unable to release dataspace")
+    if(layout_read && H5O_msg_reset(H5O_LAYOUT_ID, &layout) < 0)
+        HDONE_ERROR(H5E_DATASET, H5E_CANTRESET, FAIL, "unable to reset layout info")
+
+    FUNC_LEAVE_NOAPI_TAG(ret_value, FAIL)
+} /* end H5D__refresh() */
+
 
 /*-------------------------------------------------------------------------
  * Function:    H5D__mark
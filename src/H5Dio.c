@@ -46,6 +46,24 @@
 /* Local Typedefs */
 /******************/
 
+/* One dataset's part of a multi-dataset transfer */
+typedef struct H5D_multi_info_t {
+    H5D_t *dset;                /* Dataset to transfer */
+    hid_t mem_type_id;          /* Memory datatype */
+    const H5S_t *mem_space;     /* Memory selection (NULL for H5S_ALL) */
+    const H5S_t *file_space;    /* File selection (NULL for H5S_ALL) */
+    void *buf;                  /* Application buffer */
+} H5D_multi_info_t;
+
+/* An extent of a multi-dataset transfer, contiguous in the file and in memory */
+typedef struct H5D_multi_piece_t {
+    size_t file_idx;            /* Index of the first entry in the same file */
+    haddr_t addr;               /* Address of the extent in the file */
+    size_t len;                 /* Length of the extent in bytes */
+    uint8_t *buf;               /* Location of the extent in the application's buffer */
+    size_t idx;                 /* Order of the extent within the transfer */
+} H5D_multi_piece_t;
+
 
 /********************/
 /* Local Prototypes */
@@ -54,6 +72,15 @@
 /* Internal I/O routines */
 static herr_t H5D__pre_write(H5D_t *dset, hbool_t direct_write, hid_t mem_type_id, 
     const H5S_t *mem_space, const H5S_t *file_space, hid_t dxpl_id, const void *buf);
+static herr_t H5D__multi_init(size_t count, const hid_t *dset_id,
+    const hid_t *mem_type_id, const hid_t *mem_space_id,
+    const hid_t *file_space_id, void * const *buf, H5D_multi_info_t *info);
+static herr_t H5D__multi_io(size_t count, const H5D_multi_info_t *info,
+    hid_t dxpl_id, hbool_t do_write, hbool_t *done);
+static herr_t H5D__multi_alloc(H5D_t *dset, H5D_dxpl_cache_t *dxpl_cache,
+    hid_t dxpl_id, hid_t mem_type_id, const H5S_t *mem_space,
+    const H5S_t *file_space, hsize_t nelmts);
+static int H5D__multi_cmp_piece(const void *_piece1, const void *_piece2);
 
 /* Setup/teardown routines */
 static herr_t H5D__ioinfo_init(H5D_t *dset,
@@ -64,7 +91,7 @@ const
     hid_t dxpl_id, const H5D_type_info_t *type_info, H5D_storage_t *store,
     H5D_io_info_t *io_info);
 static herr_t H5D__typeinfo_init(const H5D_t *dset, const H5D_dxpl_cache_t *dxpl_cache,
-    hid_t dxpl_id, hid_t mem_type_id, hbool_t do_write,
+    hid_t dxpl_id, hid_t mem_type_id, const H5S_t *mem_space, hbool_t do_write,
     H5D_type_info_t *type_info);
 #ifdef H5_HAVE_PARALLEL
 static herr_t H5D__ioinfo_adjust(H5D_io_info_t *io_info, const H5D_t *dset,
@@ -124,8 +151,10 @@ H5Dread(hid_t dset_id, hid_t mem_type_id, hid_t mem_space_id,
 	hid_t file_space_id, hid_t plist_id, void *buf/*out*/)
 {
     H5D_t		   *dset = NULL;
+    H5P_genplist_t 	   *plist;      /* Property list pointer */
     const H5S_t		   *mem_space = NULL;
     const H5S_t		   *file_space = NULL;
+    hbool_t                 direct_read = FALSE;
     herr_t                  ret_value = SUCCEED;  /* Return value */
 
     FUNC_ENTER_API(FAIL)
@@ -138,6 +167,45 @@ H5Dread(hid_t dset_id, hid_t mem_type_id, hid_t mem_space_id,
     if(NULL == dset->oloc.file)
 	HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a dataset")
 
+    /* Get the default dataset transfer property list if the user didn't provide one */
+    if (H5P_DEFAULT == plist_id)
+        plist_id= H5P_DATASET_XFER_DEFAULT;
+    else
+        if(TRUE != H5P_isa_class(plist_id, H5P_DATASET_XFER))
+            HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not xfer parms")
+
+    /* Get the dataset transfer property list */
+    if(NULL == (plist = (H5P_genplist_t *)H5I_object(plist_id)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a dataset transfer property list")
+
+    /* Retrieve the 'direct read' flag */
+    if(H5P_get(plist, H5D_XFER_DIRECT_CHUNK_READ_FLAG_NAME, &direct_read) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "error getting flag for direct chunk read")
+
+    /* Direct chunk read */
+    if(direct_read) {
+        hsize_t *direct_offset;
+        uint32_t direct_filters = 0;
+
+        if(H5D_CHUNKED != dset->shared->layout.type)
+	    HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a chunked dataset")
+
+        /* Retrieve parameters for direct chunk read */
+        if(H5P_get(plist, H5D_XFER_DIRECT_CHUNK_READ_OFFSET_NAME, &direct_offset) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "error getting offset info for direct chunk read")
+        if(NULL == direct_offset)
+            HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "no offset for direct chunk read")
+
+        /* read raw data */
+        if(H5D__chunk_direct_read(dset, plist_id, direct_offset, &direct_filters, buf) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "can't read chunk directly")
+
+        /* Return the chunk's filter mask */
+        if(H5P_set(plist, H5D_XFER_DIRECT_CHUNK_READ_FILTERS_NAME, &direct_filters) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "error setting filter mask for direct chunk read")
+        HGOTO_DONE(SUCCEED)
+    } /* end if */
+
     if(mem_space_id < 0 || file_space_id < 0)
         HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a data space")
 
@@ -158,13 +226,6 @@ H5Dread(hid_t dset_id, hid_t mem_type_id, hid_t mem_space_id,
 	    HGOTO_ERROR(H5E_DATASPACE, H5E_BADRANGE, FAIL, "selection+offset not within extent")
     } /* end if */
 
-    /* Get the default dataset transfer property list if the user didn't provide one */
-    if (H5P_DEFAULT == plist_id)
-        plist_id= H5P_DATASET_XFER_DEFAULT;
-    else
-        if(TRUE != H5P_isa_class(plist_id, H5P_DATASET_XFER))
-            HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not xfer parms")
-
     /* read raw data */
     if(H5D__read(dset, mem_type_id, mem_space, file_space, plist_id, buf/*out*/) < 0)
 	HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "can't read data")
@@ -348,6 +409,605 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5D__pre_write() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Dread_multi
+ *
+ * Purpose:	Reads (part of) COUNT datasets into application memory in
+ *		one operation.  Entry U reads the selection FILE_SPACE_ID[U]
+ *		of dataset DSET_ID[U] into the selection MEM_SPACE_ID[U] of
+ *		BUF[U], converting to MEM_TYPE_ID[U], exactly as H5Dread()
+ *		would.  All entries share the transfer properties in
+ *		DXPL_ID.
+ *
+ *		When no entry needs type conversion or a data transform and
+ *		all datasets are stored contiguously, the pieces of every
+ *		entry are sorted by file address and read with a single
+ *		vector request per file.  Otherwise the entries are read one
+ *		at a time, in order.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Dread_multi(size_t count, const hid_t *dset_id, const hid_t *mem_type_id,
+    const hid_t *mem_space_id, const hid_t *file_space_id, hid_t dxpl_id,
+    void **buf/*out*/)
+{
+    H5D_multi_info_t *info = NULL;      /* Resolved entries */
+    hbool_t     done = FALSE;           /* Whether the merged transfer was performed */
+    size_t      u;                      /* Local index variable */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE7("e", "z*i*i*i*iix", count, dset_id, mem_type_id, mem_space_id,
+             file_space_id, dxpl_id, buf);
+
+    /* Check arguments */
+    if(count == 0)
+        HGOTO_DONE(SUCCEED)
+    if(!dset_id || !mem_type_id || !mem_space_id || !file_space_id || !buf)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "no entry arrays")
+
+    /* Get the default dataset transfer property list if the user didn't provide one */
+    if(H5P_DEFAULT == dxpl_id)
+        dxpl_id = H5P_DATASET_XFER_DEFAULT;
+    else
+        if(TRUE != H5P_isa_class(dxpl_id, H5P_DATASET_XFER))
+            HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not xfer parms")
+
+    /* Resolve the entries */
+    if(NULL == (info = (H5D_multi_info_t *)H5MM_malloc(count * sizeof(H5D_multi_info_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for entries")
+    if(H5D__multi_init(count, dset_id, mem_type_id, mem_space_id, file_space_id, buf, info) < 0)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "invalid entry")
+
+    /* Read all entries in one merged request, if possible */
+    if(H5D__multi_io(count, info, dxpl_id, FALSE, &done) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "can't read data")
+
+    /* Otherwise, read the entries one at a time */
+    if(!done)
+        for(u = 0; u < count; u++)
+            if(H5D__read(info[u].dset, info[u].mem_type_id, info[u].mem_space, info[u].file_space, dxpl_id, info[u].buf) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "can't read data")
+
+done:
+    H5MM_xfree(info);
+
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Dread_multi() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Dwrite_multi
+ *
+ * Purpose:	Writes (part of) COUNT datasets from application memory in
+ *		one operation.  Entry U writes the selection
+ *		MEM_SPACE_ID[U] of BUF[U], in type MEM_TYPE_ID[U], to the
+ *		selection FILE_SPACE_ID[U] of dataset DSET_ID[U], exactly
+ *		as H5Dwrite() would.  All entries share the transfer
+ *		properties in DXPL_ID.
+ *
+ *		When no entry needs type conversion or a data transform,
+ *		all datasets are stored contiguously and no two entries
+ *		write the same bytes, the pieces of every entry are sorted
+ *		by file address and written with a single vector request
+ *		per file.  Otherwise the entries are written one at a time,
+ *		in order.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Dwrite_multi(size_t count, const hid_t *dset_id, const hid_t *mem_type_id,
+    const hid_t *mem_space_id, const hid_t *file_space_id, hid_t dxpl_id,
+    const void **buf)
+{
+    H5D_multi_info_t *info = NULL;      /* Resolved entries */
+    hbool_t     done = FALSE;           /* Whether the merged transfer was performed */
+    size_t      u;                      /* Local index variable */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE7("e", "z*i*i*i*ii**x", count, dset_id, mem_type_id, mem_space_id,
+             file_space_id, dxpl_id, buf);
+
+    /* Check arguments */
+    if(count == 0)
+        HGOTO_DONE(SUCCEED)
+    if(!dset_id || !mem_type_id || !mem_space_id || !file_space_id || !buf)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "no entry arrays")
+
+    /* Get the default dataset transfer property list if the user didn't provide one */
+    if(H5P_DEFAULT == dxpl_id)
+        dxpl_id = H5P_DATASET_XFER_DEFAULT;
+    else
+        if(TRUE != H5P_isa_class(dxpl_id, H5P_DATASET_XFER))
+            HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not xfer parms")
+
+    /* Resolve the entries */
+    if(NULL == (info = (H5D_multi_info_t *)H5MM_malloc(count * sizeof(H5D_multi_info_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for entries")
+    if(H5D__multi_init(count, dset_id, mem_type_id, mem_space_id, file_space_id, (void * const *)buf, info) < 0)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "invalid entry")
+
+    /* Write all entries in one merged request, if possible */
+    if(H5D__multi_io(count, info, dxpl_id, TRUE, &done) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "can't write data")
+
+    /* Otherwise, write the entries one at a time */
+    if(!done)
+        for(u = 0; u < count; u++)
+            if(H5D__write(info[u].dset, info[u].mem_type_id, info[u].mem_space, info[u].file_space, dxpl_id, info[u].buf) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "can't write data")
+
+done:
+    H5MM_xfree(info);
+
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Dwrite_multi() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__multi_init
+ *
+ * Purpose:	Check the entries of a multi-dataset transfer and resolve
+ *		their IDs into INFO.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__multi_init(size_t count, const hid_t *dset_id, const hid_t *mem_type_id,
+    const hid_t *mem_space_id, const hid_t *file_space_id, void * const *buf,
+    H5D_multi_info_t *info)
+{
+    size_t      u;                      /* Local index variable */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    for(u = 0; u < count; u++) {
+        if(NULL == (info[u].dset = (H5D_t *)H5I_object_verify(dset_id[u], H5I_DATASET)))
+            HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a dataset")
+        if(NULL == info[u].dset->oloc.file)
+            HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a dataset")
+        if(NULL == H5I_object_verify(mem_type_id[u], H5I_DATATYPE))
+            HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a datatype")
+        info[u].mem_type_id = mem_type_id[u];
+        info[u].buf = buf[u];
+
+        if(mem_space_id[u] < 0 || file_space_id[u] < 0)
+            HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a dataspace")
+
+        info[u].mem_space = NULL;
+        if(H5S_ALL != mem_space_id[u]) {
+            if(NULL == (info[u].mem_space = (const H5S_t *)H5I_object_verify(mem_space_id[u], H5I_DATASPACE)))
+                HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a dataspace")
+
+            /* Check for valid selection */
+            if(H5S_SELECT_VALID(info[u].mem_space) != TRUE)
+                HGOTO_ERROR(H5E_DATASPACE, H5E_BADRANGE, FAIL, "memory selection+offset not within extent")
+        } /* end if */
+        info[u].file_space = NULL;
+        if(H5S_ALL != file_space_id[u]) {
+            if(NULL == (info[u].file_space = (const H5S_t *)H5I_object_verify(file_space_id[u], H5I_DATASPACE)))
+                HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a dataspace")
+
+            /* Check for valid selection */
+            if(H5S_SELECT_VALID(info[u].file_space) != TRUE)
+                HGOTO_ERROR(H5E_DATASPACE, H5E_BADRANGE, FAIL, "file selection+offset not within extent")
+        } /* end if */
+    } /* end for */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__multi_init() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__multi_cmp_piece
+ *
+ * Purpose:	Compare two pieces of a multi-dataset transfer by file and
+ *		address, for qsort().  Pieces at the same address keep
+ *		their order in the transfer.
+ *
+ * Return:	<0, 0 or >0, as for qsort()
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+H5D__multi_cmp_piece(const void *_piece1, const void *_piece2)
+{
+    const H5D_multi_piece_t *piece1 = (const H5D_multi_piece_t *)_piece1;
+    const H5D_multi_piece_t *piece2 = (const H5D_multi_piece_t *)_piece2;
+    int ret_value = 0;          /* Return value */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    if(piece1->file_idx != piece2->file_idx)
+        ret_value = (piece1->file_idx < piece2->file_idx) ? -1 : 1;
+    else if(H5F_addr_ne(piece1->addr, piece2->addr))
+        ret_value = H5F_addr_lt(piece1->addr, piece2->addr) ? -1 : 1;
+    else if(piece1->idx != piece2->idx)
+        ret_value = (piece1->idx < piece2->idx) ? -1 : 1;
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__multi_cmp_piece() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__multi_alloc
+ *
+ * Purpose:	Allocate (and initialize) the storage of a dataset before
+ *		a merged multi-dataset write, as H5D__write() would.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__multi_alloc(H5D_t *dset, H5D_dxpl_cache_t *dxpl_cache, hid_t dxpl_id,
+    hid_t mem_type_id, const H5S_t *mem_space, const H5S_t *file_space,
+    hsize_t nelmts)
+{
+    H5D_io_info_t io_info;              /* Dataset I/O info     */
+    H5D_type_info_t type_info;          /* Datatype info for operation */
+    H5D_storage_t store;                /* Union of EFL and chunk pointer in file space */
+    hbool_t     type_info_init = FALSE; /* Whether the datatype info has been initialized */
+    hbool_t     io_info_init = FALSE;   /* Whether the I/O info has been initialized */
+    hbool_t     full_overwrite;         /* Whether we are over-writing all the elements */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_STATIC_TAG(dxpl_id, dset->oloc.addr, FAIL)
+
+    /* Set up datatype info for operation */
+    if(H5D__typeinfo_init(dset, dxpl_cache, dxpl_id, mem_type_id, mem_space, TRUE, &type_info) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "unable to set up type info")
+    type_info_init = TRUE;
+
+    /* Set up I/O operation */
+    io_info.op_type = H5D_IO_OP_WRITE;
+    io_info.u.wbuf = NULL;
+    if(H5D__ioinfo_init(dset, dxpl_cache, dxpl_id, &type_info, &store, &io_info) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "unable to set up I/O operation")
+    io_info_init = TRUE;
+
+    /* Always allow fill values to be written if the dataset has a VL datatype */
+    if(H5T_detect_class(dset->shared->type, H5T_VLEN, FALSE))
+        full_overwrite = FALSE;
+    else
+        full_overwrite = (hbool_t)(H5S_GET_EXTENT_NPOINTS(file_space) == (hssize_t)nelmts);
+
+    /* Allocate storage */
+    if(H5D__alloc_storage(&io_info, H5D_ALLOC_WRITE, full_overwrite, NULL) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "unable to initialize storage")
+
+done:
+    if(io_info_init) {
+#ifdef H5_DEBUG_BUILD
+        /* release the metadata dxpl that was copied in the init function */
+        if(H5I_dec_ref(io_info.md_dxpl_id) < 0)
+            HDONE_ERROR(H5E_DATASET, H5E_CANTDEC, FAIL, "can't close metadata dxpl")
+#endif /* H5_DEBUG_BUILD */
+#ifdef H5_HAVE_PARALLEL
+        /* Shut down io_info struct */
+        if(H5D__ioinfo_term(&io_info) < 0)
+            HDONE_ERROR(H5E_DATASET, H5E_CANTCLOSEOBJ, FAIL, "can't shut down io_info")
+#endif /*H5_HAVE_PARALLEL*/
+    } /* end if */
+
+    /* Shut down datatype info for operation */
+    if(type_info_init && H5D__typeinfo_term(&type_info) < 0)
+        HDONE_ERROR(H5E_DATASET, H5E_CANTCLOSEOBJ, FAIL, "unable to shut down type info")
+
+    FUNC_LEAVE_NOAPI_TAG(ret_value, FAIL)
+} /* end H5D__multi_alloc() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__multi_io
+ *
+ * Purpose:	Perform a multi-dataset transfer as one merged request, if
+ *		every entry can be moved between the file and the
+ *		application's buffers without type conversion: the
+ *		extents of all entries are sorted by file address and
+ *		handed to the file driver as one vector request per file,
+ *		which lets it combine neighbouring extents into single
+ *		system calls.
+ *
+ *		DONE is set to FALSE, and nothing is transferred, when an
+ *		entry needs the general I/O path (type conversion, data
+ *		transforms, non-contiguous or external storage, MPI
+ *		drivers, reads of unallocated datasets, or writes that
+ *		overlap); the caller then transfers the entries one at a
+ *		time.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__multi_io(size_t count, const H5D_multi_info_t *info, hid_t dxpl_id,
+    hbool_t do_write, hbool_t *done)
+{
+    H5D_dxpl_cache_t _dxpl_cache;       /* Data transfer property cache buffer */
+    H5D_dxpl_cache_t *dxpl_cache = &_dxpl_cache;   /* Data transfer property cache */
+    H5D_multi_piece_t *piece = NULL;    /* Extents of the transfer */
+    size_t      npieces = 0;            /* Number of extents */
+    size_t      max_pieces = 0;         /* Number of extents allocated */
+    hsize_t     *file_off = NULL;       /* File sequence offsets */
+    size_t      *file_len = NULL;       /* File sequence lengths */
+    hsize_t     *mem_off = NULL;        /* Memory sequence offsets */
+    size_t      *mem_len = NULL;        /* Memory sequence lengths */
+    haddr_t     *addrs = NULL;          /* Vector request addresses */
+    size_t      *sizes = NULL;          /* Vector request sizes */
+    void        **bufs = NULL;          /* Vector request buffers */
+    H5S_sel_iter_t file_iter;           /* File selection iterator */
+    H5S_sel_iter_t mem_iter;            /* Memory selection iterator */
+    hbool_t     file_iter_init = FALSE; /* Whether the file iterator has been initialized */
+    hbool_t     mem_iter_init = FALSE;  /* Whether the memory iterator has been initialized */
+#ifdef H5_DEBUG_BUILD
+    H5D_io_info_t dxpl_info;            /* Holder for the raw data & metadata dxpls */
+    hbool_t     dxpl_info_init = FALSE; /* Whether the dxpls have been set up */
+#endif /* H5_DEBUG_BUILD */
+    size_t      u, v;                   /* Local index variables */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    HDassert(info);
+    HDassert(done);
+
+    *done = FALSE;
+
+    /* Fill the DXPL cache values for later use */
+    if(H5D__get_dxpl_cache(dxpl_id, &dxpl_cache) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't fill dxpl cache")
+
+    /* Data transforms need the general I/O path */
+    if(!H5Z_xform_noop(dxpl_cache->data_xform_prop))
+        HGOTO_DONE(SUCCEED)
+
+    /* Check that every entry can go straight between the file and memory */
+    for(u = 0; u < count; u++) {
+        const H5D_t *dset = info[u].dset;
+        const H5S_t *file_space = info[u].file_space ? info[u].file_space : dset->shared->space;
+        const H5S_t *mem_space = info[u].mem_space ? info[u].mem_space : file_space;
+        const H5T_t *mem_type;
+        H5T_path_t *tpath;
+        hssize_t nelmts;
+
+        if(dset->shared->layout.type != H5D_CONTIGUOUS || dset->shared->dcpl_cache.efl.nused > 0)
+            HGOTO_DONE(SUCCEED)
+#ifdef H5_HAVE_PARALLEL
+        if(H5F_HAS_FEATURE(dset->oloc.file, H5FD_FEAT_HAS_MPI))
+            HGOTO_DONE(SUCCEED)
+#endif /* H5_HAVE_PARALLEL */
+        if(do_write && 0 == (H5F_INTENT(dset->oloc.file) & H5F_ACC_RDWR))
+            HGOTO_DONE(SUCCEED)
+        if(!H5S_has_extent(file_space) || !H5S_has_extent(mem_space))
+            HGOTO_DONE(SUCCEED)
+        if((nelmts = H5S_GET_SELECT_NPOINTS(mem_space)) < 0 || nelmts != H5S_GET_SELECT_NPOINTS(file_space))
+            HGOTO_DONE(SUCCEED)
+        if(nelmts > 0 && NULL == info[u].buf)
+            HGOTO_DONE(SUCCEED)
+        if(!do_write && nelmts > 0 && !(*dset->shared->layout.ops->is_space_alloc)(&dset->shared->layout.storage))
+            HGOTO_DONE(SUCCEED)
+
+        /* Check for type conversion */
+        mem_type = (const H5T_t *)H5I_object(info[u].mem_type_id);
+        HDassert(mem_type);
+        if(NULL == (tpath = H5T_path_find(do_write ? mem_type : dset->shared->type,
+                do_write ? dset->shared->type : mem_type, NULL, NULL, dxpl_id, FALSE)))
+            HGOTO_ERROR(H5E_DATASET, H5E_UNSUPPORTED, FAIL, "unable to convert between src and dest datatype")
+        if(!H5T_path_noop(tpath))
+            HGOTO_DONE(SUCCEED)
+    } /* end for */
+
+    /* Allocate sequence lists */
+    if(NULL == (file_off = (hsize_t *)H5MM_malloc(dxpl_cache->vec_size * sizeof(hsize_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "can't allocate file offset vector array")
+    if(NULL == (file_len = (size_t *)H5MM_malloc(dxpl_cache->vec_size * sizeof(size_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "can't allocate file length vector array")
+    if(NULL == (mem_off = (hsize_t *)H5MM_malloc(dxpl_cache->vec_size * sizeof(hsize_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "can't allocate memory offset vector array")
+    if(NULL == (mem_len = (size_t *)H5MM_malloc(dxpl_cache->vec_size * sizeof(size_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "can't allocate memory length vector array")
+
+    /* Break every entry into extents that are contiguous in both the file and memory */
+    for(u = 0; u < count; u++) {
+        H5D_t *dset = info[u].dset;
+        const H5S_t *file_space = info[u].file_space ? info[u].file_space : dset->shared->space;
+        const H5S_t *mem_space = info[u].mem_space ? info[u].mem_space : file_space;
+        size_t elmt_size = H5T_get_size(dset->shared->type);
+        size_t file_idx;                /* Index of first entry in the same file */
+        size_t file_nseq = 0, mem_nseq = 0;     /* Number of sequences fetched */
+        size_t curr_file_seq = 0, curr_mem_seq = 0;     /* Current sequences */
+        size_t file_nelem, mem_nelem;   /* Number of elements in fetched sequences */
+        hsize_t file_left, mem_left;    /* Number of elements left to fetch */
+        hsize_t nbytes;                 /* Number of bytes left to transfer */
+        hsize_t nelmts;                 /* Number of elements to transfer */
+
+        H5_CHECKED_ASSIGN(nelmts, hsize_t, H5S_GET_SELECT_NPOINTS(mem_space), hssize_t);
+        if(nelmts == 0)
+            continue;
+
+        /* Allocate storage for datasets that don't have it yet */
+        if(do_write && !(*dset->shared->layout.ops->is_space_alloc)(&dset->shared->layout.storage))
+            if(H5D__multi_alloc(dset, dxpl_cache, dxpl_id, info[u].mem_type_id, mem_space, file_space, nelmts) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "unable to initialize storage")
+
+        /* Identify the file */
+        for(file_idx = 0; file_idx < u; file_idx++)
+            if(H5F_SAME_SHARED(info[file_idx].dset->oloc.file, dset->oloc.file))
+                break;
+
+        /* Initialize the selection iterators */
+        if(H5S_select_iter_init(&file_iter, file_space, elmt_size) < 0)
+            HGOTO_ERROR(H5E_DATASPACE, H5E_CANTINIT, FAIL, "unable to initialize file selection iterator")
+        file_iter_init = TRUE;
+        if(H5S_select_iter_init(&mem_iter, mem_space, elmt_size) < 0)
+            HGOTO_ERROR(H5E_DATASPACE, H5E_CANTINIT, FAIL, "unable to initialize memory selection iterator")
+        mem_iter_init = TRUE;
+
+        file_left = mem_left = nelmts;
+        nbytes = nelmts * elmt_size;
+        while(nbytes > 0) {
+            haddr_t addr;               /* Address of extent */
+            uint8_t *buf;               /* Location of extent in memory */
+            size_t len;                 /* Length of extent */
+
+            /* Get more sequences, when needed */
+            if(curr_file_seq >= file_nseq) {
+                if(H5S_SELECT_GET_SEQ_LIST(file_space, H5S_GET_SEQ_LIST_SORTED, &file_iter, dxpl_cache->vec_size, (size_t)file_left, &file_nseq, &file_nelem, file_off, file_len) < 0)
+                    HGOTO_ERROR(H5E_INTERNAL, H5E_UNSUPPORTED, FAIL, "sequence length generation failed")
+                file_left -= file_nelem;
+                curr_file_seq = 0;
+            } /* end if */
+            if(curr_mem_seq >= mem_nseq) {
+                if(H5S_SELECT_GET_SEQ_LIST(mem_space, 0, &mem_iter, dxpl_cache->vec_size, (size_t)mem_left, &mem_nseq, &mem_nelem, mem_off, mem_len) < 0)
+                    HGOTO_ERROR(H5E_INTERNAL, H5E_UNSUPPORTED, FAIL, "sequence length generation failed")
+                mem_left -= mem_nelem;
+                curr_mem_seq = 0;
+            } /* end if */
+
+            /* Take the part the current sequences have in common */
+            len = MIN(file_len[curr_file_seq], mem_len[curr_mem_seq]);
+            addr = dset->shared->layout.storage.u.contig.addr + file_off[curr_file_seq];
+            buf = (uint8_t *)info[u].buf + mem_off[curr_mem_seq];
+
+            /* Extend the previous extent, or add a new one */
+            if(npieces > 0 && piece[npieces - 1].file_idx == file_idx
+                    && H5F_addr_eq(piece[npieces - 1].addr + piece[npieces - 1].len, addr)
+                    && piece[npieces - 1].buf + piece[npieces - 1].len == buf)
+                piece[npieces - 1].len += len;
+            else {
+                if(npieces == max_pieces) {
+                    H5D_multi_piece_t *new_piece;       /* Larger array of extents */
+
+                    max_pieces = MAX(2 * max_pieces, 64);
+                    if(NULL == (new_piece = (H5D_multi_piece_t *)H5MM_realloc(piece, max_pieces * sizeof(H5D_multi_piece_t))))
+                        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "can't allocate transfer extents")
+                    piece = new_piece;
+                } /* end if */
+                piece[npieces].file_idx = file_idx;
+                piece[npieces].addr = addr;
+                piece[npieces].len = len;
+                piece[npieces].buf = buf;
+                piece[npieces].idx = npieces;
+                npieces++;
+            } /* end else */
+
+            /* Advance past the extent */
+            file_off[curr_file_seq] += len;
+            if(0 == (file_len[curr_file_seq] -= len))
+                curr_file_seq++;
+            mem_off[curr_mem_seq] += len;
+            if(0 == (mem_len[curr_mem_seq] -= len))
+                curr_mem_seq++;
+            nbytes -= len;
+        } /* end while */
+
+        /* Release the selection iterators */
+        file_iter_init = FALSE;
+        if(H5S_SELECT_ITER_RELEASE(&file_iter) < 0)
+            HGOTO_ERROR(H5E_DATASPACE, H5E_CANTRELEASE, FAIL, "unable to release file selection iterator")
+        mem_iter_init = FALSE;
+        if(H5S_SELECT_ITER_RELEASE(&mem_iter) < 0)
+            HGOTO_ERROR(H5E_DATASPACE, H5E_CANTRELEASE, FAIL, "unable to release memory selection iterator")
+    } /* end for */
+
+    /* Sort the extents by file and address */
+    HDqsort(piece, npieces, sizeof(H5D_multi_piece_t), H5D__multi_cmp_piece);
+
+    /* Writes must happen in order where entries overlap, so leave those to
+     * the general I/O path.
+     */
+    if(do_write)
+        for(u = 1; u < npieces; u++)
+            if(piece[u].file_idx == piece[u - 1].file_idx
+                    && H5F_addr_lt(piece[u].addr, piece[u - 1].addr + piece[u - 1].len))
+                HGOTO_DONE(SUCCEED)
+
+    /* Write any cached raw data to the file, and forget it when writing */
+    for(u = 0; u < count; u++) {
+        H5D_t *dset = info[u].dset;
+
+        if(H5D__flush_sieve_buf(dset, dxpl_id) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTFLUSH, FAIL, "unable to flush sieve buffer")
+        if(do_write)
+            dset->shared->cache.contig.sieve_size = 0;
+    } /* end for */
+
+    /* Set up the vector requests */
+    if(npieces > 0) {
+        if(NULL == (addrs = (haddr_t *)H5MM_malloc(npieces * sizeof(haddr_t))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "can't allocate address vector")
+        if(NULL == (sizes = (size_t *)H5MM_malloc(npieces * sizeof(size_t))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "can't allocate size vector")
+        if(NULL == (bufs = (void **)H5MM_malloc(npieces * sizeof(void *))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "can't allocate buffer vector")
+        for(u = 0; u < npieces; u++) {
+            addrs[u] = piece[u].addr;
+            sizes[u] = piece[u].len;
+            bufs[u] = piece[u].buf;
+        } /* end for */
+    } /* end if */
+
+#ifdef H5_DEBUG_BUILD
+    /* Set the dxpl IO type for sanity checking at the FD layer */
+    if(H5D_set_io_info_dxpls(&dxpl_info, dxpl_id) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTCOPY, FAIL, "can't set metadata and raw data dxpls")
+    dxpl_info_init = TRUE;
+#endif /* H5_DEBUG_BUILD */
+
+    /* Issue one vector request per file */
+    for(u = 0; u < npieces; u = v) {
+        H5F_t *file = info[piece[u].file_idx].dset->oloc.file;
+
+        for(v = u + 1; v < npieces; v++)
+            if(piece[v].file_idx != piece[u].file_idx)
+                break;
+
+        if(do_write) {
+            if(H5F_block_writev(file, H5FD_MEM_DRAW, v - u, addrs + u, sizes + u, dxpl_id, (const void **)(bufs + u)) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "vector write failed")
+        } /* end if */
+        else {
+            if(H5F_block_readv(file, H5FD_MEM_DRAW, v - u, addrs + u, sizes + u, dxpl_id, bufs + u) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "vector read failed")
+        } /* end else */
+    } /* end for */
+
+    *done = TRUE;
+
+done:
+#ifdef H5_DEBUG_BUILD
+    /* release the metadata dxpl that was copied above */
+    if(dxpl_info_init && H5I_dec_ref(dxpl_info.md_dxpl_id) < 0)
+        HDONE_ERROR(H5E_DATASET, H5E_CANTDEC, FAIL, "can't close metadata dxpl")
+#endif /* H5_DEBUG_BUILD */
+    if(file_iter_init && H5S_SELECT_ITER_RELEASE(&file_iter) < 0)
+        HDONE_ERROR(H5E_DATASPACE, H5E_CANTRELEASE, FAIL, "unable to release file selection iterator")
+    if(mem_iter_init && H5S_SELECT_ITER_RELEASE(&mem_iter) < 0)
+        HDONE_ERROR(H5E_DATASPACE, H5E_CANTRELEASE, FAIL, "unable to release memory selection iterator")
+    H5MM_xfree(file_off);
+    H5MM_xfree(file_len);
+    H5MM_xfree(mem_off);
+    H5MM_xfree(mem_len);
+    H5MM_xfree(addrs);
+    H5MM_xfree(sizes);
+    H5MM_xfree(bufs);
+    H5MM_xfree(piece);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__multi_io() */
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5D__read
@@ -411,7 +1071,7 @@ H5D__read(H5D_t *dataset, hid_t mem_type_id, const H5S_t *mem_space,
         HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't fill dxpl cache")
 
     /* Set up datatype info for operation */
-    if(H5D__typeinfo_init(dataset, dxpl_cache, dxpl_id, mem_type_id, FALSE, &type_info) < 0)
+    if(H5D__typeinfo_init(dataset, dxpl_cache, dxpl_id, mem_type_id, mem_space, FALSE, &type_info) < 0)
         HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "unable to set up type info")
     type_info_init = TRUE;
 
@@ -636,7 +1296,7 @@ H5D__write(H5D_t *dataset, hid_t mem_type_id, const H5S_t *mem_space,
         HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't fill dxpl cache")
 
     /* Set up datatype info for operation */
-    if(H5D__typeinfo_init(dataset, dxpl_cache, dxpl_id, mem_type_id, TRUE, &type_info) < 0)
+    if(H5D__typeinfo_init(dataset, dxpl_cache, dxpl_id, mem_type_id, mem_space, TRUE, &type_info) < 0)
         HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "unable to set up type info")
     type_info_init = TRUE;
 
@@ -659,10 +1319,13 @@ H5D__write(H5D_t *dataset, hid_t mem_type_id, const H5S_t *mem_space,
                 H5T_get_ref_type(type_info.mem_type) == H5R_DATASET_REGION)
             HGOTO_ERROR(H5E_DATASET, H5E_UNSUPPORTED, FAIL, "Parallel IO does not support writing region reference datatypes yet")
 
-        /* Can't write to chunked datasets with filters, in parallel */
-        if(dataset->shared->layout.type == H5D_CHUNKED &&
+        /* Can't write to chunked datasets with filters in parallel, except
+         *  with collective I/O
+         */
+        if(dxpl_cache->xfer_mode != H5FD_MPIO_COLLECTIVE &&
+                dataset->shared->layout.type == H5D_CHUNKED &&
                 dataset->shared->dcpl_cache.pline.nused > 0)
-            HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "cannot write to chunked storage with filters in parallel")
+            HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "cannot write to chunked storage with filters in parallel without collective I/O")
     } /* end if */
     else {
         /* Collective access is not permissible without a MPI based VFD */
@@ -893,6 +1556,14 @@ const
         io_info->io_ops.single_read = H5D__select_read;
         io_info->io_ops.single_write = H5D__select_write;
     } /* end if */
+    else if(type_info->is_conv_inplace) {
+        /*
+         * Read directly into the application's buffer and convert the
+         * data there.
+         */
+        io_info->io_ops.single_read = H5D__select_read_inplace;
+        io_info->io_ops.single_write = H5D__scatgath_write;
+    } /* end if */
     else {
         /*
          * This is the general case (type conversion, usually).
@@ -926,7 +1597,7 @@ done:
  */
 static herr_t
 H5D__typeinfo_init(const H5D_t *dset, const H5D_dxpl_cache_t *dxpl_cache,
-    hid_t dxpl_id, hid_t mem_type_id, hbool_t do_write,
+    hid_t dxpl_id, hid_t mem_type_id, const H5S_t *mem_space, hbool_t do_write,
     H5D_type_info_t *type_info)
 {
     const H5T_t	*src_type;              /* Source datatype */
@@ -1002,6 +1673,22 @@ H5D__typeinfo_init(const H5D_t *dset, const H5D_dxpl_cache_t *dxpl_cache,
                 type_info->need_bkg = H5T_BKG_NO; /*never needed even if app says yes*/
         } /* end else */
 
+        /*
+         * When reading into a contiguous memory selection with a conversion
+         * that doesn't change the element size or widens it (byte order
+         * swapping, integer or floating-point promotion) and doesn't need a
+         * background buffer, read straight into the application's buffer and
+         * convert it there, avoiding the type conversion buffer.
+         */
+        if(!do_write && type_info->is_xform_noop &&
+                type_info->need_bkg == H5T_BKG_NO &&
+                (NULL == type_info->cmpd_subset || H5T_SUBSET_FALSE == type_info->cmpd_subset->subset) &&
+                type_info->dst_type_size >= type_info->src_type_size &&
+                H5T_detect_class(dst_type, H5T_VLEN, FALSE) == FALSE &&
+                H5S_SELECT_IS_CONTIGUOUS(mem_space) == TRUE) {
+            type_info->is_conv_inplace = TRUE;
+            HGOTO_DONE(SUCCEED)
+        } /* end if */
 
         /* Set up datatype conversion/background buffers */
 
@@ -1142,6 +1829,12 @@ H5D__ioinfo_adjust(H5D_io_info_t *io_info, const H5D_t *dset, hid_t dxpl_id,
             io_info->io_ops.single_write = H5D__mpio_select_write;
         } /* end if */
         else {
+            /* Filtered chunks can only be written with collective I/O */
+            if(io_info->op_type == H5D_IO_OP_WRITE &&
+                    dset->shared->layout.type == H5D_CHUNKED &&
+                    dset->shared->dcpl_cache.pline.nused > 0)
+                HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "cannot write to chunked storage with filters in parallel without collective I/O")
+
             /* If we won't be doing collective I/O, but the user asked for
              * collective I/O, change the request to use independent I/O, but
              * mark it so that we remember to revert the change.
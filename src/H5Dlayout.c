@@ -96,8 +96,27 @@ H5D__layout_set_io_ops(const H5D_t *dataset)
             dataset->shared->layout.ops = H5D_LOPS_CHUNK;
 
             /* Set the chunk operations */
-            /* (Only "B-tree" indexing type currently supported) */
-            dataset->shared->layout.storage.u.chunk.ops = H5D_COPS_BTREE;
+            switch(dataset->shared->layout.storage.u.chunk.idx_type) {
+                case H5D_CHUNK_IDX_BTREE:
+                    dataset->shared->layout.storage.u.chunk.ops = H5D_COPS_BTREE;
+                    break;
+
+                case H5D_CHUNK_IDX_SINGLE:
+                    dataset->shared->layout.storage.u.chunk.ops = H5D_COPS_SINGLE;
+                    break;
+
+                case H5D_CHUNK_IDX_FARRAY:
+                    dataset->shared->layout.storage.u.chunk.ops = H5D_COPS_FARRAY;
+                    break;
+
+                case H5D_CHUNK_IDX_EARRAY:
+                    dataset->shared->layout.storage.u.chunk.ops = H5D_COPS_EARRAY;
+                    break;
+
+                case H5D_CHUNK_IDX_NTYPES:
+                default:
+                    HGOTO_ERROR(H5E_DATASET, H5E_UNSUPPORTED, FAIL, "unknown chunk index method")
+            } /* end switch */
             break;
 
         case H5D_COMPACT:
@@ -119,6 +138,109 @@ done:
 } /* end H5D__layout_set_io_ops() */
 
 
+/*-------------------------------------------------------------------------
+ * Function:    H5D__layout_set_latest_indexing
+ *
+ * Purpose:     Set the latest indexing type for a chunked dataset's layout.
+ *              Datasets that are exactly one chunk use the single chunk
+ *              index, datasets with fixed maximum dimensions use a fixed
+ *              array and datasets with one unlimited dimension use an
+ *              extensible array.  All other datasets keep the v1 B-tree.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5D__layout_set_latest_indexing(H5O_layout_t *layout, const H5S_t *space,
+    const H5D_dcpl_cache_t *dcpl_cache)
+{
+    int sndims;                         /* Rank of dataspace */
+    unsigned ndims;                     /* Rank of dataspace */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    /* Sanity check */
+    HDassert(layout);
+    HDassert(space);
+    HDassert(dcpl_cache);
+
+    /* The indexing methods only apply to chunked datasets (currently) */
+    if(layout->type == H5D_CHUNKED) {
+        hsize_t cur_dims[H5O_LAYOUT_NDIMS];     /* Current dimensions of dataset */
+        hsize_t max_dims[H5O_LAYOUT_NDIMS];     /* Maximum dimensions of dataset */
+        hbool_t single = TRUE;                  /* Fulfill single chunk indexing */
+        unsigned unlim_count = 0;               /* Count of unlimited max. dimensions */
+        unsigned u;                             /* Local index variable */
+
+        /* Query the dimensionality of the dataspace */
+        if((sndims = H5S_get_simple_extent_dims(space, cur_dims, max_dims)) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "invalid dataspace rank")
+        ndims = (unsigned)sndims;
+
+        /* Spin through the max. dimensions, looking for unlimited dimensions */
+        for(u = 0; u < ndims; u++) {
+            if(max_dims[u] == H5S_UNLIMITED)
+                unlim_count++;
+            if(cur_dims[u] != max_dims[u] || cur_dims[u] != layout->u.chunk.dim[u])
+                single = FALSE;
+        } /* end for */
+
+        /* Chunked datasets with unlimited dimension(s) */
+        if(unlim_count) {
+            /* Check for only one unlimited dimension */
+            if(1 == unlim_count) {
+                /* Set the chunk index type to an extensible array */
+                layout->storage.u.chunk.idx_type = H5D_CHUNK_IDX_EARRAY;
+                layout->storage.u.chunk.ops = H5D_COPS_EARRAY;
+
+                /* Set the extensible array creation parameters */
+                /* (use hard-coded defaults, applications can't tune these yet) */
+                layout->u.chunk.u.earray.cparam.max_nelmts_bits = H5D_EARRAY_MAX_NELMTS_BITS;
+                layout->u.chunk.u.earray.cparam.idx_blk_elmts = H5D_EARRAY_IDX_BLK_ELMTS;
+                layout->u.chunk.u.earray.cparam.sup_blk_min_data_ptrs = H5D_EARRAY_SUP_BLK_MIN_DATA_PTRS;
+                layout->u.chunk.u.earray.cparam.data_blk_min_elmts = H5D_EARRAY_DATA_BLK_MIN_ELMTS;
+                layout->u.chunk.u.earray.cparam.max_dblk_page_nelmts_bits = H5D_EARRAY_MAX_DBLK_PAGE_NELMTS_BITS;
+            } /* end if */
+            /* (More than one unlimited dimension keeps the v1 B-tree index) */
+        } /* end if */
+        else {
+            /* Check if we should use the single chunk index */
+            /* (A filtered chunk can move when it is rewritten, which would
+             *  require updating a layout message that is constant when space
+             *  is allocated early, so use a fixed array for that case)
+             */
+            if(single && !(dcpl_cache->pline.nused > 0 && dcpl_cache->fill.alloc_time == H5D_ALLOC_TIME_EARLY)) {
+                /* Set the chunk index type to "single chunk" */
+                layout->storage.u.chunk.idx_type = H5D_CHUNK_IDX_SINGLE;
+                layout->storage.u.chunk.ops = H5D_COPS_SINGLE;
+
+                /* Remember whether the single chunk is filtered */
+                if(dcpl_cache->pline.nused > 0)
+                    layout->u.chunk.flags |= H5O_LAYOUT_CHUNK_SINGLE_INDEX_WITH_FILTER;
+            } /* end if */
+            else {
+                /* Set the chunk index type to a fixed array */
+                layout->storage.u.chunk.idx_type = H5D_CHUNK_IDX_FARRAY;
+                layout->storage.u.chunk.ops = H5D_COPS_FARRAY;
+
+                /* Set the fixed array creation parameters */
+                /* (use hard-coded defaults, applications can't tune these yet) */
+                layout->u.chunk.u.farray.cparam.max_dblk_page_nelmts_bits = H5D_FARRAY_MAX_DBLK_PAGE_NELMTS_BITS;
+            } /* end else */
+        } /* end else */
+
+        /* Indices other than the v1 B-tree need the latest layout message */
+        if(layout->storage.u.chunk.idx_type != H5D_CHUNK_IDX_BTREE)
+            layout->version = H5O_LAYOUT_VERSION_4;
+    } /* end if */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__layout_set_latest_indexing() */
+
+
 /*-------------------------------------------------------------------------
  * Function:    H5D__layout_meta_size
  *
@@ -164,15 +286,63 @@ H5D__layout_meta_size(const H5F_t *f, const H5O_layout_t *layout, hbool_t includ
             break;
 
         case H5D_CHUNKED:
-            /* Number of dimensions (1 byte) */
-            HDassert(layout->u.chunk.ndims > 0 && layout->u.chunk.ndims <= H5O_LAYOUT_NDIMS);
-            ret_value++;
+            if(layout->storage.u.chunk.idx_type == H5D_CHUNK_IDX_BTREE) {
+                /* Number of dimensions (1 byte) */
+                HDassert(layout->u.chunk.ndims > 0 && layout->u.chunk.ndims <= H5O_LAYOUT_NDIMS);
+                ret_value++;
 
-            /* Dimension sizes */
-            ret_value += layout->u.chunk.ndims * 4;
+                /* Dimension sizes */
+                ret_value += layout->u.chunk.ndims * 4;
 
-            /* B-tree address */
-            ret_value += H5F_SIZEOF_ADDR(f);    /* Address of data */
+                /* B-tree address */
+                ret_value += H5F_SIZEOF_ADDR(f);    /* Address of data */
+            } /* end if */
+            else {
+                /* Chunked layout feature flags */
+                ret_value++;
+
+                /* Number of dimensions (1 byte) */
+                HDassert(layout->u.chunk.ndims > 0 && layout->u.chunk.ndims <= H5O_LAYOUT_NDIMS);
+                ret_value++;
+
+                /* Encoded # of bytes for each chunk dimension */
+                HDassert(layout->u.chunk.enc_bytes_per_dim > 0 && layout->u.chunk.enc_bytes_per_dim <= 8);
+                ret_value++;
+
+                /* Dimension sizes */
+                ret_value += layout->u.chunk.ndims * layout->u.chunk.enc_bytes_per_dim;
+
+                /* Type of chunk index */
+                ret_value++;
+
+                switch(layout->storage.u.chunk.idx_type) {
+                    case H5D_CHUNK_IDX_SINGLE:
+                        /* Possible filter information */
+                        if(layout->u.chunk.flags & H5O_LAYOUT_CHUNK_SINGLE_INDEX_WITH_FILTER) {
+                            ret_value += H5F_SIZEOF_SIZE(f);    /* Size of chunk (in file) */
+                            ret_value += 4;                     /* Filter mask for chunk */
+                        } /* end if */
+                        break;
+
+                    case H5D_CHUNK_IDX_FARRAY:
+                        /* Fixed array creation parameters */
+                        ret_value += H5D_FARRAY_CREATE_PARAM_SIZE;
+                        break;
+
+                    case H5D_CHUNK_IDX_EARRAY:
+                        /* Extensible array creation parameters */
+                        ret_value += H5D_EARRAY_CREATE_PARAM_SIZE;
+                        break;
+
+                    case H5D_CHUNK_IDX_BTREE:
+                    case H5D_CHUNK_IDX_NTYPES:
+                    default:
+                        HGOTO_ERROR(H5E_OHDR, H5E_CANTENCODE, 0, "Invalid chunk index type")
+                } /* end switch */
+
+                /* Chunk index address */
+                ret_value += H5F_SIZEOF_ADDR(f);
+            } /* end else */
             break;
 
         case H5D_VIRTUAL:
@@ -431,7 +601,7 @@ H5D__layout_oh_write(H5D_t *dataset, hid_t dxpl_id, H5O_t *oh, unsigned update_f
     HDassert(oh);
 
     /* Write the layout message to the dataset's header */
-    if(H5O_msg_write_oh(dataset->oloc.file, dxpl_id, oh, H5O_LAYOUT_ID, H5O_MSG_FLAG_CONSTANT, update_flags, &dataset->shared->layout) < 0)
+    if(H5O_msg_write_oh(dataset->oloc.file, dxpl_id, oh, H5O_LAYOUT_ID, 0, update_flags, &dataset->shared->layout) < 0)
         HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "unable to update layout message")
 
 done:
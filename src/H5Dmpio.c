@@ -86,6 +86,11 @@
 #define H5D_CHUNK_SELECT_IRREG        2
 #define H5D_CHUNK_SELECT_NONE         0
 
+/***** Macros for collective IO on filtered chunks. *****/
+/* MPI message tags for sending pieces of filtered chunks between processes */
+#define H5D_FILTERED_CHUNK_WRITE_TAG  1
+#define H5D_FILTERED_CHUNK_READ_TAG   2
+
 
 /******************/
 /* Local Typedefs */
@@ -96,6 +101,40 @@ typedef struct H5D_chunk_addr_info_t {
   H5D_chunk_info_t chunk_info;
 } H5D_chunk_addr_info_t;
 
+/* Selection made by one process in a filtered chunk */
+typedef struct H5D_filtered_sel_t {
+    hsize_t index;                      /* Index of chunk in dataset */
+    hsize_t scaled[H5O_LAYOUT_NDIMS];   /* Scaled coordinates of chunk */
+    hsize_t npoints;                    /* # of elements selected in chunk */
+    int rank;                           /* Rank of process with selection */
+} H5D_filtered_sel_t;
+
+/* Information about a filtered chunk, for collective IO */
+typedef struct H5D_filtered_chunk_t {
+    hsize_t index;                      /* Index of chunk in dataset */
+    const H5D_filtered_sel_t *sels;     /* Selections in chunk by all processes (sorted by rank) */
+    size_t nsels;                       /* # of selections in chunk */
+    int owner;                          /* Rank of process which filters the chunk */
+    H5D_chunk_info_t *chunk_info;       /* This process's selection in chunk (NULL if none) */
+    H5D_chunk_ud_t udata;               /* Chunk's location in the file */
+    void *buf;                          /* Unfiltered chunk data */
+    size_t buf_size;                    /* Size of chunk data buffer */
+} H5D_filtered_chunk_t;
+
+/* New size of a filtered chunk, agreed between processes before allocating file space */
+typedef struct H5D_filtered_size_t {
+    hsize_t index;                      /* Index of chunk in dataset */
+    hsize_t nbytes;                     /* Size of filtered chunk */
+    unsigned filter_mask;               /* Excluded filters for chunk */
+} H5D_filtered_size_t;
+
+/* Block of raw data to transfer in a collective IO on filtered chunks */
+typedef struct H5D_filtered_io_t {
+    haddr_t addr;                       /* Address of block in file */
+    size_t len;                         /* Length of block */
+    void *buf;                          /* Buffer for block */
+} H5D_filtered_io_t;
+
 
 /********************/
 /* Local Prototypes */
@@ -126,6 +165,38 @@ static herr_t H5D__mpio_get_min_chunk(const H5D_io_info_t *io_info,
     const H5D_chunk_map_t *fm, int *min_chunkf);
 static herr_t H5D__mpio_get_sum_chunk(const H5D_io_info_t *io_info,
     const H5D_chunk_map_t *fm, int *sum_chunkf);
+static herr_t H5D__link_chunk_filtered_collective_io(H5D_io_info_t *io_info,
+    const H5D_type_info_t *type_info, H5D_chunk_map_t *fm,
+    H5P_genplist_t *dx_plist);
+static herr_t H5D__multi_chunk_filtered_collective_io(H5D_io_info_t *io_info,
+    const H5D_type_info_t *type_info, H5D_chunk_map_t *fm,
+    H5P_genplist_t *dx_plist);
+static herr_t H5D__filtered_collective_init(const H5D_io_info_t *io_info,
+    const H5D_chunk_map_t *fm, H5D_filtered_sel_t **sels,
+    H5D_filtered_chunk_t **chunks, size_t *nchunks);
+static herr_t H5D__filtered_collective_chunk_io(H5D_io_info_t *io_info,
+    const H5D_type_info_t *type_info, H5D_filtered_chunk_t *chunks,
+    size_t nchunks);
+static herr_t H5D__filtered_collective_gather(const H5D_io_info_t *io_info,
+    const H5D_type_info_t *type_info, H5D_filtered_chunk_t *chunks,
+    size_t nchunks);
+static herr_t H5D__filtered_collective_scatter(const H5D_io_info_t *io_info,
+    const H5D_type_info_t *type_info, H5D_filtered_chunk_t *chunks,
+    size_t nchunks);
+static herr_t H5D__filtered_collective_update(const H5D_io_info_t *io_info,
+    H5D_filtered_chunk_t *chunks, size_t nchunks, H5Z_pipeline_job_t *jobs);
+static herr_t H5D__filtered_collective_raw_io(const H5D_io_info_t *io_info,
+    const H5D_type_info_t *type_info, H5D_io_op_type_t op_type,
+    H5D_filtered_io_t *ios, size_t nios, haddr_t base_addr);
+static herr_t H5D__filtered_collective_copy(const void *src,
+    const H5S_t *src_space, void *dst, const H5S_t *dst_space,
+    size_t elmt_size, size_t nelmts, const H5D_dxpl_cache_t *dxpl_cache);
+static herr_t H5D__filtered_collective_fill(const H5D_io_info_t *io_info,
+    void *buf, size_t buf_size);
+static int H5D__cmp_filtered_sel(const void *sel1, const void *sel2);
+static int H5D__cmp_filtered_size(const void *size1, const void *size2);
+static int H5D__cmp_filtered_chunk(const void *chunk1, const void *chunk2);
+static int H5D__cmp_filtered_io(const void *io1, const void *io2);
 
 
 /*********************/
@@ -208,10 +279,9 @@ H5D__mpio_opt_possible(const H5D_io_info_t *io_info, const H5S_t *file_space,
      *  use collective IO will defer until each chunk IO is reached.
      */
 
-    /* Don't allow collective operations if filters need to be applied */
-    if(io_info->dset->shared->layout.type == H5D_CHUNKED &&
-            io_info->dset->shared->dcpl_cache.pline.nused > 0)
-        local_cause |= H5D_MPIO_FILTERS;
+    /* (Filtered chunks are handled by the collective IO routines for
+     *  filtered chunks, so filters don't prevent collective IO)
+     */
 
     /* Check for independent I/O */
     if(local_cause & H5D_MPIO_SET_INDEPENDENT)
@@ -683,7 +753,17 @@ H5D__chunk_collective_io(H5D_io_info_t *io_info, const H5D_type_info_t *type_inf
 #endif
 
     /* step 2:  Go ahead to do IO.*/
-    if(H5D_ONE_LINK_CHUNK_IO == io_option || H5D_ONE_LINK_CHUNK_IO_MORE_OPT == io_option) {
+    if(io_info->dset->shared->dcpl_cache.pline.nused > 0) {
+        /* Filtered chunks must be processed whole, by a single process */
+        if(H5D_ONE_LINK_CHUNK_IO == io_option || H5D_ONE_LINK_CHUNK_IO_MORE_OPT == io_option) {
+            if(H5D__link_chunk_filtered_collective_io(io_info, type_info, fm, dx_plist) < 0)
+                HGOTO_ERROR(H5E_IO, H5E_CANTGET, FAIL, "couldn't finish filtered linked chunk MPI-IO")
+        } /* end if */
+        else
+            if(H5D__multi_chunk_filtered_collective_io(io_info, type_info, fm, dx_plist) < 0)
+                HGOTO_ERROR(H5E_IO, H5E_CANTGET, FAIL, "couldn't finish filtered multiple chunk MPI-IO")
+    } /* end if */
+    else if(H5D_ONE_LINK_CHUNK_IO == io_option || H5D_ONE_LINK_CHUNK_IO_MORE_OPT == io_option) {
         if(H5D__link_chunk_collective_io(io_info, type_info, fm, sum_chunk, dx_plist) < 0)
             HGOTO_ERROR(H5E_IO, H5E_CANTGET, FAIL, "couldn't finish linked chunk MPI-IO")
     } /* end if */
@@ -1306,6 +1386,1087 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5D__multi_chunk_collective_io */
 
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__link_chunk_filtered_collective_io
+ *
+ * Purpose:     Routine for one collective IO on all the filtered chunks
+ *              selected by any process.
+ *
+ *              A filtered chunk must be read, unfiltered, filtered and
+ *              written as a whole, so each chunk is assigned to a single
+ *              process (its "owner").  Other processes with a selection
+ *              in the chunk send their piece of the chunk to the owner
+ *              when writing, and receive it from the owner when reading.
+ *              The raw chunks of all processes are read and written with
+ *              one collective MPI-IO operation each.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__link_chunk_filtered_collective_io(H5D_io_info_t *io_info, const H5D_type_info_t *type_info,
+    H5D_chunk_map_t *fm, H5P_genplist_t *dx_plist)
+{
+    H5D_filtered_sel_t *sels = NULL;        /* Selections in chunks by all processes */
+    H5D_filtered_chunk_t *chunks = NULL;    /* Chunks selected by any process */
+    size_t nchunks = 0;                     /* # of chunks selected by any process */
+    H5D_mpio_actual_chunk_opt_mode_t actual_chunk_opt_mode = H5D_MPIO_LINK_CHUNK;
+    H5D_mpio_actual_io_mode_t actual_io_mode = H5D_MPIO_CHUNK_COLLECTIVE;
+    herr_t ret_value = SUCCEED;
+
+    FUNC_ENTER_STATIC
+
+    /* Set the actual-chunk-opt-mode property. */
+    if(H5P_set(dx_plist, H5D_MPIO_ACTUAL_CHUNK_OPT_MODE_NAME, &actual_chunk_opt_mode) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "couldn't set actual chunk opt mode property")
+
+    /* Set the actual-io-mode property.
+     * Link chunk I/O does not break to independent, so can set right away */
+    if(H5P_set(dx_plist, H5D_MPIO_ACTUAL_IO_MODE_NAME, &actual_io_mode) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "couldn't set actual io mode property")
+
+    /* Find the chunks selected by all processes, and their owners */
+    if(H5D__filtered_collective_init(io_info, fm, &sels, &chunks, &nchunks) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "unable to determine filtered chunks selected")
+
+    /* Perform I/O on all the chunks at once */
+    if(nchunks > 0)
+        if(H5D__filtered_collective_chunk_io(io_info, type_info, chunks, nchunks) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_CANTGET, FAIL, "couldn't finish filtered collective MPI-IO")
+
+done:
+    if(chunks)
+        H5MM_xfree(chunks);
+    if(sels)
+        H5MM_xfree(sels);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__link_chunk_filtered_collective_io() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__multi_chunk_filtered_collective_io
+ *
+ * Purpose:     To do collective IO on the filtered chunks selected by any
+ *              process, one chunk at a time.
+ *
+ *              Each chunk is processed as in
+ *              H5D__link_chunk_filtered_collective_io(), with one
+ *              collective MPI-IO operation per chunk.  This bounds the
+ *              memory used for unfiltered chunks by each process.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__multi_chunk_filtered_collective_io(H5D_io_info_t *io_info, const H5D_type_info_t *type_info,
+    H5D_chunk_map_t *fm, H5P_genplist_t *dx_plist)
+{
+    H5D_filtered_sel_t *sels = NULL;        /* Selections in chunks by all processes */
+    H5D_filtered_chunk_t *chunks = NULL;    /* Chunks selected by any process */
+    size_t nchunks = 0;                     /* # of chunks selected by any process */
+    H5D_mpio_actual_chunk_opt_mode_t actual_chunk_opt_mode = H5D_MPIO_MULTI_CHUNK;
+    H5D_mpio_actual_io_mode_t actual_io_mode = H5D_MPIO_NO_COLLECTIVE;
+    size_t u;                               /* Local index variable */
+    herr_t ret_value = SUCCEED;
+
+    FUNC_ENTER_STATIC
+
+    /* Set the actual chunk opt mode property */
+    if(H5P_set(dx_plist, H5D_MPIO_ACTUAL_CHUNK_OPT_MODE_NAME, &actual_chunk_opt_mode) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "couldn't set actual chunk opt mode property")
+
+    /* Find the chunks selected by all processes, and their owners */
+    if(H5D__filtered_collective_init(io_info, fm, &sels, &chunks, &nchunks) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "unable to determine filtered chunks selected")
+
+    /* Perform I/O on each chunk, with all processes */
+    for(u = 0; u < nchunks; u++) {
+        /* Filtered chunks are always accessed collectively */
+        if(chunks[u].chunk_info)
+            actual_io_mode = actual_io_mode | H5D_MPIO_CHUNK_COLLECTIVE;
+
+        if(H5D__filtered_collective_chunk_io(io_info, type_info, &chunks[u], (size_t)1) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_CANTGET, FAIL, "couldn't finish filtered collective MPI-IO")
+    } /* end for */
+
+    /* Write the local value of actual io mode to the DXPL. */
+    if(H5P_set(dx_plist, H5D_MPIO_ACTUAL_IO_MODE_NAME, &actual_io_mode) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "couldn't set actual io mode property")
+
+done:
+    if(chunks)
+        H5MM_xfree(chunks);
+    if(sels)
+        H5MM_xfree(sels);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__multi_chunk_filtered_collective_io() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__filtered_collective_init
+ *
+ * Purpose:     Share the chunks selected by each process with all the
+ *              other processes, and assign each chunk to an owner.
+ *
+ *              The owner of a chunk is the process with the largest
+ *              selection in it (the lowest rank, for a tie), so the
+ *              fewest elements are sent between processes.
+ *
+ *              On return, *CHUNKS is sorted by chunk index and is the
+ *              same on all processes, except for each chunk's selection
+ *              by this process.  *SELS holds the selections that the
+ *              chunks refer to; both arrays must be freed by the caller.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__filtered_collective_init(const H5D_io_info_t *io_info, const H5D_chunk_map_t *fm,
+    H5D_filtered_sel_t **_sels, H5D_filtered_chunk_t **_chunks, size_t *_nchunks)
+{
+    H5D_filtered_sel_t *local_sels = NULL;  /* Selections in chunks by this process */
+    H5D_filtered_sel_t *sels = NULL;        /* Selections in chunks by all processes */
+    H5D_filtered_chunk_t *chunks = NULL;    /* Chunks selected by any process */
+    int        *recv_counts = NULL;         /* # of bytes of selections from each process */
+    int        *displs = NULL;              /* Offset of selections from each process */
+    size_t      num_local;                  /* # of chunks selected by this process */
+    size_t      num_sels = 0;               /* # of selections by all processes */
+    size_t      nchunks = 0;                /* # of chunks selected by any process */
+    size_t      total_bytes = 0;            /* Size of selections by all processes */
+    int         send_count;                 /* # of bytes of selections from this process */
+    int         mpi_rank;                   /* Rank of this process */
+    int         mpi_size;                   /* # of processes */
+    int         mpi_code;                   /* MPI return code */
+    int         r;                          /* Local index variable */
+    size_t      u, v;                       /* Local index variables */
+    herr_t      ret_value = SUCCEED;
+
+    FUNC_ENTER_STATIC
+
+    HDassert(io_info);
+    HDassert(fm);
+    HDassert(_sels);
+    HDassert(_chunks);
+    HDassert(_nchunks);
+
+    /* Get the rank of this process & the number of processes */
+    if((mpi_rank = H5F_mpi_get_rank(io_info->dset->oloc.file)) < 0)
+        HGOTO_ERROR(H5E_IO, H5E_MPI, FAIL, "unable to obtain mpi rank")
+    if((mpi_size = H5F_mpi_get_size(io_info->dset->oloc.file)) < 0)
+        HGOTO_ERROR(H5E_IO, H5E_MPI, FAIL, "unable to obtain mpi size")
+
+    /* Describe this process's selection in each chunk */
+    num_local = H5SL_count(fm->sel_chunks);
+    if(num_local > 0) {
+        H5SL_node_t *chunk_node;        /* Current node in chunk skip list */
+
+        if(NULL == (local_sels = (H5D_filtered_sel_t *)H5MM_calloc(num_local * sizeof(H5D_filtered_sel_t))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "couldn't allocate chunk selection buffer")
+
+        u = 0;
+        chunk_node = H5SL_first(fm->sel_chunks);
+        while(chunk_node) {
+            const H5D_chunk_info_t *chunk_info;     /* Chunk information */
+
+            if(NULL == (chunk_info = (const H5D_chunk_info_t *)H5SL_item(chunk_node)))
+                HGOTO_ERROR(H5E_STORAGE, H5E_CANTGET, FAIL, "couldn't get chunk info from skip list")
+
+            local_sels[u].index = chunk_info->index;
+            HDmemcpy(local_sels[u].scaled, chunk_info->scaled, sizeof(local_sels[u].scaled));
+            local_sels[u].npoints = (hsize_t)chunk_info->chunk_points;
+            local_sels[u].rank = mpi_rank;
+
+            u++;
+            chunk_node = H5SL_next(chunk_node);
+        } /* end while */
+    } /* end if */
+
+    /* Share the number of selections by each process */
+    H5_CHECKED_ASSIGN(send_count, int, num_local * sizeof(H5D_filtered_sel_t), size_t);
+    if(NULL == (recv_counts = (int *)H5MM_malloc((size_t)mpi_size * sizeof(int))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "couldn't allocate receive counts buffer")
+    if(NULL == (displs = (int *)H5MM_malloc((size_t)mpi_size * sizeof(int))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "couldn't allocate receive displacements buffer")
+    if(MPI_SUCCESS != (mpi_code = MPI_Allgather(&send_count, 1, MPI_INT, recv_counts, 1, MPI_INT, io_info->comm)))
+        HMPI_GOTO_ERROR(FAIL, "MPI_Allgather failed", mpi_code)
+    for(r = 0; r < mpi_size; r++) {
+        H5_CHECKED_ASSIGN(displs[r], int, total_bytes, size_t);
+        total_bytes += (size_t)recv_counts[r];
+    } /* end for */
+    num_sels = total_bytes / sizeof(H5D_filtered_sel_t);
+
+    if(num_sels > 0) {
+        /* Share the selections by each process */
+        if(NULL == (sels = (H5D_filtered_sel_t *)H5MM_malloc(total_bytes)))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "couldn't allocate chunk selection buffer")
+        if(MPI_SUCCESS != (mpi_code = MPI_Allgatherv(local_sels, send_count, MPI_BYTE, sels, recv_counts, displs, MPI_BYTE, io_info->comm)))
+            HMPI_GOTO_ERROR(FAIL, "MPI_Allgatherv failed", mpi_code)
+
+        /* Group the selections by chunk */
+        HDqsort(sels, num_sels, sizeof(H5D_filtered_sel_t), H5D__cmp_filtered_sel);
+        nchunks = 1;
+        for(u = 1; u < num_sels; u++)
+            if(sels[u].index != sels[u - 1].index)
+                nchunks++;
+
+        /* Set up the chunks */
+        if(NULL == (chunks = (H5D_filtered_chunk_t *)H5MM_calloc(nchunks * sizeof(H5D_filtered_chunk_t))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "couldn't allocate filtered chunk buffer")
+        for(u = 0, v = 0; v < nchunks; v++) {
+            H5D_filtered_chunk_t *chunk = &chunks[v];   /* Current chunk */
+            hsize_t max_npoints = 0;                    /* Largest selection in chunk */
+
+            chunk->index = sels[u].index;
+            chunk->sels = &sels[u];
+            while(u < num_sels && sels[u].index == chunk->index) {
+                if(0 == chunk->nsels || sels[u].npoints > max_npoints) {
+                    max_npoints = sels[u].npoints;
+                    chunk->owner = sels[u].rank;
+                } /* end if */
+                chunk->nsels++;
+                u++;
+            } /* end while */
+            chunk->chunk_info = fm->select_chunk[chunk->index];
+            chunk->udata.ent = NULL;
+            chunk->udata.chunk_block.offset = HADDR_UNDEF;
+        } /* end for */
+        HDassert(u == num_sels);
+    } /* end if */
+
+    /* Set return values */
+    *_sels = sels;
+    *_chunks = chunks;
+    *_nchunks = nchunks;
+    sels = NULL;
+    chunks = NULL;
+
+done:
+    if(local_sels)
+        H5MM_xfree(local_sels);
+    if(sels)
+        H5MM_xfree(sels);
+    if(chunks)
+        H5MM_xfree(chunks);
+    if(recv_counts)
+        H5MM_xfree(recv_counts);
+    if(displs)
+        H5MM_xfree(displs);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__filtered_collective_init() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__filtered_collective_chunk_io
+ *
+ * Purpose:     Read or write a set of filtered chunks, with all processes.
+ *
+ *              1. Look up the chunks' current locations in the file.
+ *              2. Each owner reads & unfilters its chunks, if their data
+ *                 is needed (for a read, or a partial write); the raw
+ *                 chunks are read with one collective operation.
+ *              3. For a read, the owners send the chunks to the other
+ *                 processes with selections in them.  For a write, the
+ *                 other processes send their pieces of the chunks to the
+ *                 owners, which filter the chunks.  The chunks' new sizes
+ *                 are shared, all processes update the chunk index, and
+ *                 the filtered chunks are written with one collective
+ *                 operation.
+ *
+ *              CHUNKS must be sorted by chunk index and be the same on
+ *              all processes.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__filtered_collective_chunk_io(H5D_io_info_t *io_info, const H5D_type_info_t *type_info,
+    H5D_filtered_chunk_t *chunks, size_t nchunks)
+{
+    const H5D_t *dset = io_info->dset;      /* Local pointer to dataset info */
+    const H5O_pline_t *pline = &dset->shared->dcpl_cache.pline;    /* I/O pipeline info */
+    H5Z_pipeline_job_t *jobs = NULL;        /* Filter pipeline job for each chunk */
+    H5D_filtered_io_t *ios = NULL;          /* Raw chunks to read or write */
+    size_t      nios = 0;                   /* # of raw chunks to read or write */
+    size_t      nowned = 0;                 /* # of chunks owned by this process */
+    haddr_t     base_addr = HADDR_UNDEF;    /* Address of any chunk in the file */
+    size_t      chunk_size;                 /* Size of an unfiltered chunk */
+    hsize_t     chunk_nelmts;               /* # of elements in a chunk */
+    int         mpi_rank;                   /* Rank of this process */
+    size_t      u, v;                       /* Local index variables */
+    herr_t      ret_value = SUCCEED;
+
+    FUNC_ENTER_STATIC
+
+    HDassert(io_info);
+    HDassert(type_info);
+    HDassert(chunks);
+    HDassert(nchunks > 0);
+    HDassert(pline->nused > 0);
+
+    /* Get the rank of this process */
+    if((mpi_rank = H5F_mpi_get_rank(dset->oloc.file)) < 0)
+        HGOTO_ERROR(H5E_IO, H5E_MPI, FAIL, "unable to obtain mpi rank")
+
+    /* Get the size of a chunk */
+    H5_CHECKED_ASSIGN(chunk_size, size_t, dset->shared->layout.u.chunk.size, uint32_t);
+    chunk_nelmts = (hsize_t)(chunk_size / type_info->src_type_size);
+
+    if(NULL == (jobs = (H5Z_pipeline_job_t *)H5MM_calloc(nchunks * sizeof(H5Z_pipeline_job_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for filter jobs")
+    if(NULL == (ios = (H5D_filtered_io_t *)H5MM_malloc(nchunks * sizeof(H5D_filtered_io_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for raw chunk I/O")
+
+    /* Look up the chunks in the file, with all processes */
+    for(u = 0; u < nchunks; u++) {
+        if(H5D__chunk_lookup(dset, io_info->md_dxpl_id, chunks[u].sels->scaled, &chunks[u].udata) < 0)
+            HGOTO_ERROR(H5E_STORAGE, H5E_CANTGET, FAIL, "couldn't get chunk address")
+        if(!H5F_addr_defined(base_addr) && H5F_addr_defined(chunks[u].udata.chunk_block.offset))
+            base_addr = chunks[u].udata.chunk_block.offset;
+    } /* end for */
+
+    /* Set up the chunks owned by this process */
+    for(u = 0; u < nchunks; u++) {
+        H5D_filtered_chunk_t *chunk = &chunks[u];   /* Current chunk */
+        hsize_t npoints = 0;                        /* # of elements selected in chunk */
+        hbool_t need_data;                          /* Whether the chunk's current data is needed */
+
+        if(chunk->owner != mpi_rank)
+            continue;
+        nowned++;
+
+        /* The chunk's current data is needed for a read, or if the chunk
+         *  isn't entirely overwritten.
+         */
+        for(v = 0; v < chunk->nsels; v++)
+            npoints += chunk->sels[v].npoints;
+        need_data = (io_info->op_type == H5D_IO_OP_READ || npoints < chunk_nelmts);
+
+        if(need_data && H5F_addr_defined(chunk->udata.chunk_block.offset)) {
+            H5Z_pipeline_job_t *job = &jobs[u];     /* Filter job for chunk */
+
+            /* Read the raw chunk (below) */
+            job->filter_mask = chunk->udata.filter_mask;
+            job->nbytes = job->buf_size = (size_t)chunk->udata.chunk_block.length;
+            if(NULL == (job->buf = H5MM_malloc(job->buf_size)))
+                HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for raw data chunk")
+
+            ios[nios].addr = chunk->udata.chunk_block.offset;
+            ios[nios].len = job->nbytes;
+            ios[nios].buf = job->buf;
+            nios++;
+        } /* end if */
+        else {
+            if(NULL == (chunk->buf = H5MM_malloc(chunk_size)))
+                HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for raw data chunk")
+            chunk->buf_size = chunk_size;
+
+            /* Initialize the part of the chunk that isn't overwritten */
+            if(need_data)
+                if(H5D__filtered_collective_fill(io_info, chunk->buf, chunk_size) < 0)
+                    HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "unable to fill chunk")
+        } /* end else */
+    } /* end for */
+
+    /* Read the raw chunks, with all processes, if any exist in the file */
+    if(H5F_addr_defined(base_addr)) {
+        if(H5D__filtered_collective_raw_io(io_info, type_info, H5D_IO_OP_READ, ios, nios, base_addr) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "couldn't read filtered chunks")
+
+        /* Unfilter the chunks read */
+        if(nios > 0) {
+            if(H5Z_pipeline_multi(pline, H5Z_FLAG_REVERSE, io_info->dxpl_cache->err_detect,
+                    io_info->dxpl_cache->filter_cb, io_info->dxpl_cache->filter_nthreads,
+                    nchunks, jobs) < 0)
+                HGOTO_ERROR(H5E_PLINE, H5E_CANTFILTER, FAIL, "data pipeline read failed")
+
+            for(u = 0; u < nchunks; u++)
+                if(jobs[u].buf) {
+                    if(jobs[u].nbytes != chunk_size)
+                        HGOTO_ERROR(H5E_PLINE, H5E_BADVALUE, FAIL, "unfiltered chunk has wrong size")
+                    chunks[u].buf = jobs[u].buf;
+                    chunks[u].buf_size = jobs[u].buf_size;
+                    jobs[u].buf = NULL;
+                } /* end if */
+        } /* end if */
+    } /* end if */
+
+    if(io_info->op_type == H5D_IO_OP_WRITE) {
+        /* Collect the pieces of the chunks in their owners */
+        if(H5D__filtered_collective_gather(io_info, type_info, chunks, nchunks) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTRECV, FAIL, "unable to send pieces of chunks to their owners")
+
+        /* Filter the chunks owned by this process */
+        for(u = 0; u < nchunks; u++)
+            if(chunks[u].owner == mpi_rank) {
+                jobs[u].filter_mask = 0;
+                jobs[u].nbytes = chunk_size;
+                jobs[u].buf_size = chunks[u].buf_size;
+                jobs[u].buf = chunks[u].buf;
+                chunks[u].buf = NULL;
+            } /* end if */
+        if(nowned > 0)
+            if(H5Z_pipeline_multi(pline, 0, io_info->dxpl_cache->err_detect,
+                    io_info->dxpl_cache->filter_cb, io_info->dxpl_cache->filter_nthreads,
+                    nchunks, jobs) < 0)
+                HGOTO_ERROR(H5E_PLINE, H5E_CANTFILTER, FAIL, "output pipeline failed")
+
+        /* Move the chunks to fit their new sizes, with all processes */
+        if(H5D__filtered_collective_update(io_info, chunks, nchunks, jobs) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTUPDATE, FAIL, "unable to update locations of filtered chunks")
+
+        /* Write the filtered chunks, with all processes */
+        nios = 0;
+        for(u = 0; u < nchunks; u++)
+            if(chunks[u].owner == mpi_rank) {
+                ios[nios].addr = chunks[u].udata.chunk_block.offset;
+                ios[nios].len = jobs[u].nbytes;
+                ios[nios].buf = jobs[u].buf;
+                nios++;
+            } /* end if */
+        if(H5D__filtered_collective_raw_io(io_info, type_info, H5D_IO_OP_WRITE, ios, nios, chunks[0].udata.chunk_block.offset) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "couldn't write filtered chunks")
+    } /* end if */
+    else {
+        /* Send the chunks to the processes with selections in them */
+        if(H5D__filtered_collective_scatter(io_info, type_info, chunks, nchunks) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTRECV, FAIL, "unable to send chunks from their owners")
+    } /* end else */
+
+done:
+    for(u = 0; u < nchunks; u++) {
+        if(jobs)
+            H5MM_xfree(jobs[u].buf);
+        chunks[u].buf = H5MM_xfree(chunks[u].buf);
+        chunks[u].buf_size = 0;
+    } /* end for */
+    if(jobs)
+        H5MM_xfree(jobs);
+    if(ios)
+        H5MM_xfree(ios);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__filtered_collective_chunk_io() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__filtered_collective_gather
+ *
+ * Purpose:     Copy the elements written by all processes into the
+ *              unfiltered chunks owned by this process.
+ *
+ *              Each process sends a message to the owner of each chunk
+ *              it has a selection in, holding the chunk's index, the
+ *              serialized selection in the chunk and the elements
+ *              selected.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__filtered_collective_gather(const H5D_io_info_t *io_info, const H5D_type_info_t *type_info,
+    H5D_filtered_chunk_t *chunks, size_t nchunks)
+{
+    size_t      elmt_size = type_info->src_type_size;   /* Size of an element */
+    MPI_Request *send_reqs = NULL;          /* Requests for messages sent */
+    uint8_t   **send_bufs = NULL;           /* Buffers for messages sent */
+    uint8_t    *recv_buf = NULL;            /* Buffer for messages received */
+    size_t      recv_buf_size = 0;          /* Size of receive buffer */
+    H5S_t      *recv_space = NULL;          /* Selection in chunk from message received */
+    size_t      nsends = 0;                 /* # of messages sent */
+    size_t      nrecvs = 0;                 /* # of messages to receive */
+    hbool_t     sends_pending = FALSE;      /* Whether the messages sent need to be waited for */
+    int         mpi_rank;                   /* Rank of this process */
+    int         mpi_code;                   /* MPI return code */
+    size_t      u;                          /* Local index variable */
+    herr_t      ret_value = SUCCEED;
+
+    FUNC_ENTER_STATIC
+
+    /* Get the rank of this process */
+    if((mpi_rank = H5F_mpi_get_rank(io_info->dset->oloc.file)) < 0)
+        HGOTO_ERROR(H5E_IO, H5E_MPI, FAIL, "unable to obtain mpi rank")
+
+    if(NULL == (send_reqs = (MPI_Request *)H5MM_malloc(nchunks * sizeof(MPI_Request))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "couldn't allocate send requests buffer")
+    if(NULL == (send_bufs = (uint8_t **)H5MM_calloc(nchunks * sizeof(uint8_t *))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "couldn't allocate send buffers")
+
+    /* Send or copy this process's selection in each chunk */
+    for(u = 0; u < nchunks; u++) {
+        H5D_filtered_chunk_t *chunk = &chunks[u];   /* Current chunk */
+        H5D_chunk_info_t *chunk_info = chunk->chunk_info;   /* This process's selection in chunk */
+
+        if(chunk->owner == mpi_rank) {
+            HDassert(chunk_info);
+            HDassert(chunk->buf);
+
+            /* Copy this process's elements into the chunk */
+            if(H5D__filtered_collective_copy(io_info->u.wbuf, chunk_info->mspace, chunk->buf,
+                    chunk_info->fspace, elmt_size, (size_t)chunk_info->chunk_points, io_info->dxpl_cache) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTCOPY, FAIL, "unable to copy elements into chunk")
+
+            /* Expect a message from each other process with a selection */
+            nrecvs += chunk->nsels - 1;
+        } /* end if */
+        else if(chunk_info) {
+            hssize_t sel_size;          /* Size of serialized selection */
+            size_t msg_size;            /* Size of message */
+            int msg_count;              /* Size of message, for MPI */
+            uint8_t *p;                 /* Pointer into message */
+
+            /* Compute the size of the message */
+            if((sel_size = H5S_SELECT_SERIAL_SIZE(chunk_info->fspace)) < 0)
+                HGOTO_ERROR(H5E_DATASPACE, H5E_CANTGET, FAIL, "unable to get size of selection")
+            msg_size = sizeof(uint64_t) + (size_t)sel_size + (size_t)chunk_info->chunk_points * elmt_size;
+            H5_CHECKED_ASSIGN(msg_count, int, msg_size, size_t);
+
+            /* Build the message */
+            if(NULL == (send_bufs[nsends] = (uint8_t *)H5MM_malloc(msg_size)))
+                HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "couldn't allocate send buffer")
+            p = send_bufs[nsends];
+            UINT64ENCODE(p, chunk->index);
+            if(H5S_SELECT_SERIALIZE(chunk_info->fspace, &p) < 0)
+                HGOTO_ERROR(H5E_DATASPACE, H5E_CANTENCODE, FAIL, "unable to serialize selection")
+            if(H5D__filtered_collective_copy(io_info->u.wbuf, chunk_info->mspace, p, NULL,
+                    elmt_size, (size_t)chunk_info->chunk_points, io_info->dxpl_cache) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTCOPY, FAIL, "unable to copy elements into message")
+
+            /* Send it to the chunk's owner */
+            if(MPI_SUCCESS != (mpi_code = MPI_Isend(send_bufs[nsends], msg_count, MPI_BYTE, chunk->owner, H5D_FILTERED_CHUNK_WRITE_TAG, io_info->comm, &send_reqs[nsends])))
+                HMPI_GOTO_ERROR(FAIL, "MPI_Isend failed", mpi_code)
+            nsends++;
+            sends_pending = TRUE;
+        } /* end if */
+    } /* end for */
+
+    /* Receive the other processes' elements in the chunks owned by this
+     *  process, in whatever order they arrive.
+     */
+    for(u = 0; u < nrecvs; u++) {
+        H5D_filtered_chunk_t key;       /* Key for chunk search */
+        H5D_filtered_chunk_t *chunk;    /* Chunk for message */
+        MPI_Status status;              /* Status of message */
+        int msg_count;                  /* Size of message */
+        const uint8_t *p;               /* Pointer into message */
+        hssize_t npoints;               /* # of elements in message */
+
+        /* Receive the next message */
+        if(MPI_SUCCESS != (mpi_code = MPI_Probe(MPI_ANY_SOURCE, H5D_FILTERED_CHUNK_WRITE_TAG, io_info->comm, &status)))
+            HMPI_GOTO_ERROR(FAIL, "MPI_Probe failed", mpi_code)
+        if(MPI_SUCCESS != (mpi_code = MPI_Get_count(&status, MPI_BYTE, &msg_count)))
+            HMPI_GOTO_ERROR(FAIL, "MPI_Get_count failed", mpi_code)
+        if((size_t)msg_count > recv_buf_size) {
+            uint8_t *tmp_buf;           /* Reallocated receive buffer */
+
+            if(NULL == (tmp_buf = (uint8_t *)H5MM_realloc(recv_buf, (size_t)msg_count)))
+                HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "couldn't allocate receive buffer")
+            recv_buf = tmp_buf;
+            recv_buf_size = (size_t)msg_count;
+        } /* end if */
+        if(MPI_SUCCESS != (mpi_code = MPI_Recv(recv_buf, msg_count, MPI_BYTE, status.MPI_SOURCE, H5D_FILTERED_CHUNK_WRITE_TAG, io_info->comm, MPI_STATUS_IGNORE)))
+            HMPI_GOTO_ERROR(FAIL, "MPI_Recv failed", mpi_code)
+
+        /* Find the chunk */
+        p = recv_buf;
+        UINT64DECODE(p, key.index);
+        chunk = (H5D_filtered_chunk_t *)HDbsearch(&key, chunks, nchunks, sizeof(H5D_filtered_chunk_t), H5D__cmp_filtered_chunk);
+        if(NULL == chunk || chunk->owner != mpi_rank)
+            HGOTO_ERROR(H5E_DATASET, H5E_BADVALUE, FAIL, "received elements for a chunk not owned by this process")
+
+        /* Decode the selection */
+        if(NULL == (recv_space = H5S_copy(chunk->chunk_info->fspace, FALSE, TRUE)))
+            HGOTO_ERROR(H5E_DATASPACE, H5E_CANTCOPY, FAIL, "unable to copy chunk dataspace")
+        if(H5S_SELECT_DESERIALIZE(&recv_space, &p) < 0)
+            HGOTO_ERROR(H5E_DATASPACE, H5E_CANTDECODE, FAIL, "unable to deserialize selection")
+        if((npoints = H5S_GET_SELECT_NPOINTS(recv_space)) < 0)
+            HGOTO_ERROR(H5E_DATASPACE, H5E_CANTCOUNT, FAIL, "unable to get number of elements selected")
+
+        /* Copy the elements into the chunk */
+        if(H5D__filtered_collective_copy(p, NULL, chunk->buf, recv_space, elmt_size,
+                (size_t)npoints, io_info->dxpl_cache) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTCOPY, FAIL, "unable to copy elements into chunk")
+
+        if(H5S_close(recv_space) < 0)
+            HGOTO_ERROR(H5E_DATASPACE, H5E_CANTRELEASE, FAIL, "can't close dataspace")
+        recv_space = NULL;
+    } /* end for */
+
+    /* Wait for the messages sent to be received */
+    if(nsends > 0)
+        if(MPI_SUCCESS != (mpi_code = MPI_Waitall((int)nsends, send_reqs, MPI_STATUSES_IGNORE)))
+            HMPI_GOTO_ERROR(FAIL, "MPI_Waitall failed", mpi_code)
+    sends_pending = FALSE;
+
+done:
+    /* Don't release the send buffers while they are still in use */
+    if(sends_pending)
+        if(MPI_SUCCESS != (mpi_code = MPI_Waitall((int)nsends, send_reqs, MPI_STATUSES_IGNORE)))
+            HMPI_DONE_ERROR(FAIL, "MPI_Waitall failed", mpi_code)
+
+    if(recv_space && H5S_close(recv_space) < 0)
+        HDONE_ERROR(H5E_DATASPACE, H5E_CANTRELEASE, FAIL, "can't close dataspace")
+    if(recv_buf)
+        H5MM_xfree(recv_buf);
+    if(send_bufs) {
+        for(u = 0; u < nchunks; u++)
+            H5MM_xfree(send_bufs[u]);
+        H5MM_xfree(send_bufs);
+    } /* end if */
+    if(send_reqs)
+        H5MM_xfree(send_reqs);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__filtered_collective_gather() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__filtered_collective_scatter
+ *
+ * Purpose:     Copy the elements read by this process out of the
+ *              unfiltered chunks.
+ *
+ *              The owner of each chunk sends the chunk to the other
+ *              processes with a selection in it.  Messages between a
+ *              pair of processes are sent & received in chunk index
+ *              order, so MPI's message ordering matches them up.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__filtered_collective_scatter(const H5D_io_info_t *io_info, const H5D_type_info_t *type_info,
+    H5D_filtered_chunk_t *chunks, size_t nchunks)
+{
+    size_t      elmt_size = type_info->dst_type_size;   /* Size of an element */
+    MPI_Request *send_reqs = NULL;          /* Requests for chunks sent */
+    size_t      nsends = 0;                 /* # of chunks sent */
+    size_t      max_sends = 0;              /* # of chunks to send */
+    hbool_t     sends_pending = FALSE;      /* Whether the chunks sent need to be waited for */
+    size_t      chunk_size;                 /* Size of an unfiltered chunk */
+    int         chunk_count;                /* Size of an unfiltered chunk, for MPI */
+    int         mpi_rank;                   /* Rank of this process */
+    int         mpi_code;                   /* MPI return code */
+    size_t      u, v;                       /* Local index variables */
+    herr_t      ret_value = SUCCEED;
+
+    FUNC_ENTER_STATIC
+
+    /* Get the rank of this process */
+    if((mpi_rank = H5F_mpi_get_rank(io_info->dset->oloc.file)) < 0)
+        HGOTO_ERROR(H5E_IO, H5E_MPI, FAIL, "unable to obtain mpi rank")
+
+    /* Get the size of a chunk */
+    H5_CHECKED_ASSIGN(chunk_size, size_t, io_info->dset->shared->layout.u.chunk.size, uint32_t);
+    H5_CHECKED_ASSIGN(chunk_count, int, chunk_size, size_t);
+
+    /* Send the chunks owned by this process */
+    for(u = 0; u < nchunks; u++)
+        if(chunks[u].owner == mpi_rank)
+            max_sends += chunks[u].nsels - 1;
+    if(max_sends > 0) {
+        if(NULL == (send_reqs = (MPI_Request *)H5MM_malloc(max_sends * sizeof(MPI_Request))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "couldn't allocate send requests buffer")
+
+        for(u = 0; u < nchunks; u++)
+            if(chunks[u].owner == mpi_rank)
+                for(v = 0; v < chunks[u].nsels; v++)
+                    if(chunks[u].sels[v].rank != mpi_rank) {
+                        if(MPI_SUCCESS != (mpi_code = MPI_Isend(chunks[u].buf, chunk_count, MPI_BYTE, chunks[u].sels[v].rank, H5D_FILTERED_CHUNK_READ_TAG, io_info->comm, &send_reqs[nsends])))
+                            HMPI_GOTO_ERROR(FAIL, "MPI_Isend failed", mpi_code)
+                        nsends++;
+                        sends_pending = TRUE;
+                    } /* end if */
+        HDassert(nsends == max_sends);
+    } /* end if */
+
+    /* Receive the chunks owned by other processes */
+    for(u = 0; u < nchunks; u++)
+        if(chunks[u].chunk_info && chunks[u].owner != mpi_rank) {
+            if(NULL == (chunks[u].buf = H5MM_malloc(chunk_size)))
+                HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for raw data chunk")
+            chunks[u].buf_size = chunk_size;
+            if(MPI_SUCCESS != (mpi_code = MPI_Recv(chunks[u].buf, chunk_count, MPI_BYTE, chunks[u].owner, H5D_FILTERED_CHUNK_READ_TAG, io_info->comm, MPI_STATUS_IGNORE)))
+                HMPI_GOTO_ERROR(FAIL, "MPI_Recv failed", mpi_code)
+        } /* end if */
+
+    /* Copy the elements selected by this process out of the chunks */
+    for(u = 0; u < nchunks; u++)
+        if(chunks[u].chunk_info) {
+            H5D_chunk_info_t *chunk_info = chunks[u].chunk_info;    /* This process's selection in chunk */
+
+            if(H5D__filtered_collective_copy(chunks[u].buf, chunk_info->fspace, io_info->u.rbuf,
+                    chunk_info->mspace, elmt_size, (size_t)chunk_info->chunk_points, io_info->dxpl_cache) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTCOPY, FAIL, "unable to copy elements from chunk")
+        } /* end if */
+
+    /* Wait for the chunks sent to be received */
+    if(nsends > 0)
+        if(MPI_SUCCESS != (mpi_code = MPI_Waitall((int)nsends, send_reqs, MPI_STATUSES_IGNORE)))
+            HMPI_GOTO_ERROR(FAIL, "MPI_Waitall failed", mpi_code)
+    sends_pending = FALSE;
+
+done:
+    /* Don't release the chunks while they are still being sent */
+    if(sends_pending)
+        if(MPI_SUCCESS != (mpi_code = MPI_Waitall((int)nsends, send_reqs, MPI_STATUSES_IGNORE)))
+            HMPI_DONE_ERROR(FAIL, "MPI_Waitall failed", mpi_code)
+
+    if(send_reqs)
+        H5MM_xfree(send_reqs);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__filtered_collective_scatter() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__filtered_collective_update
+ *
+ * Purpose:     Share the new sizes of the filtered chunks with all the
+ *              processes, and reallocate the chunks in the file.
+ *
+ *              File space allocation and chunk index updates are metadata
+ *              operations, so all processes perform them for every chunk,
+ *              in the same order.
+ *
+ *              JOBS holds the filtered chunks owned by this process.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__filtered_collective_update(const H5D_io_info_t *io_info, H5D_filtered_chunk_t *chunks,
+    size_t nchunks, H5Z_pipeline_job_t *jobs)
+{
+    H5D_filtered_size_t *local_sizes = NULL;    /* New sizes of chunks owned by this process */
+    H5D_filtered_size_t *sizes = NULL;  /* New sizes of all chunks */
+    int        *recv_counts = NULL;     /* # of bytes of sizes from each process */
+    int        *displs = NULL;          /* Offset of sizes from each process */
+    size_t      nlocal = 0;             /* # of chunks owned by this process */
+    size_t      total_bytes = 0;        /* Size of sizes from all processes */
+    int         send_count;             /* # of bytes of sizes from this process */
+    int         mpi_rank;               /* Rank of this process */
+    int         mpi_size;               /* # of processes */
+    int         mpi_code;               /* MPI return code */
+    int         r;                      /* Local index variable */
+    size_t      u;                      /* Local index variable */
+    herr_t      ret_value = SUCCEED;
+
+    FUNC_ENTER_STATIC
+
+    /* Get the rank of this process & the number of processes */
+    if((mpi_rank = H5F_mpi_get_rank(io_info->dset->oloc.file)) < 0)
+        HGOTO_ERROR(H5E_IO, H5E_MPI, FAIL, "unable to obtain mpi rank")
+    if((mpi_size = H5F_mpi_get_size(io_info->dset->oloc.file)) < 0)
+        HGOTO_ERROR(H5E_IO, H5E_MPI, FAIL, "unable to obtain mpi size")
+
+    if(NULL == (local_sizes = (H5D_filtered_size_t *)H5MM_calloc(nchunks * sizeof(H5D_filtered_size_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "couldn't allocate chunk sizes buffer")
+    if(NULL == (sizes = (H5D_filtered_size_t *)H5MM_malloc(nchunks * sizeof(H5D_filtered_size_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "couldn't allocate chunk sizes buffer")
+    if(NULL == (recv_counts = (int *)H5MM_calloc((size_t)mpi_size * sizeof(int))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "couldn't allocate receive counts buffer")
+    if(NULL == (displs = (int *)H5MM_malloc((size_t)mpi_size * sizeof(int))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "couldn't allocate receive displacements buffer")
+
+    /* Describe the chunks owned by this process; every process knows
+     *  how many chunks each process owns.
+     */
+    for(u = 0; u < nchunks; u++) {
+        recv_counts[chunks[u].owner] += (int)sizeof(H5D_filtered_size_t);
+        if(chunks[u].owner == mpi_rank) {
+            local_sizes[nlocal].index = chunks[u].index;
+            local_sizes[nlocal].nbytes = (hsize_t)jobs[u].nbytes;
+            local_sizes[nlocal].filter_mask = jobs[u].filter_mask;
+            nlocal++;
+        } /* end if */
+    } /* end for */
+    for(r = 0; r < mpi_size; r++) {
+        H5_CHECKED_ASSIGN(displs[r], int, total_bytes, size_t);
+        total_bytes += (size_t)recv_counts[r];
+    } /* end for */
+    HDassert(total_bytes == nchunks * sizeof(H5D_filtered_size_t));
+    H5_CHECKED_ASSIGN(send_count, int, nlocal * sizeof(H5D_filtered_size_t), size_t);
+
+    /* Share the new sizes */
+    if(MPI_SUCCESS != (mpi_code = MPI_Allgatherv(local_sizes, send_count, MPI_BYTE, sizes, recv_counts, displs, MPI_BYTE, io_info->comm)))
+        HMPI_GOTO_ERROR(FAIL, "MPI_Allgatherv failed", mpi_code)
+    HDqsort(sizes, nchunks, sizeof(H5D_filtered_size_t), H5D__cmp_filtered_size);
+
+    /* Reallocate the chunks & update the chunk index */
+    for(u = 0; u < nchunks; u++) {
+        HDassert(sizes[u].index == chunks[u].index);
+
+        if(H5D__chunk_update_block(io_info, &chunks[u].udata, sizes[u].nbytes, sizes[u].filter_mask) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTUPDATE, FAIL, "unable to update chunk location")
+    } /* end for */
+
+done:
+    if(local_sizes)
+        H5MM_xfree(local_sizes);
+    if(sizes)
+        H5MM_xfree(sizes);
+    if(recv_counts)
+        H5MM_xfree(recv_counts);
+    if(displs)
+        H5MM_xfree(displs);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__filtered_collective_update() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__filtered_collective_raw_io
+ *
+ * Purpose:     Read or write raw (filtered) chunks, with one collective
+ *              MPI-IO operation for all processes.
+ *
+ *              IOS describes this process's chunks and is sorted in
+ *              place.  A process without any chunks still participates,
+ *              at BASE_ADDR, which must be a valid address in the file.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__filtered_collective_raw_io(const H5D_io_info_t *io_info, const H5D_type_info_t *type_info,
+    H5D_io_op_type_t op_type, H5D_filtered_io_t *ios, size_t nios, haddr_t base_addr)
+{
+    H5D_io_info_t raw_io_info;              /* I/O info for raw chunks */
+    H5D_storage_t ctg_store;                /* Storage info for "fake" contiguous dataset */
+    MPI_Datatype file_type = MPI_BYTE;      /* MPI file datatype for chunks */
+    hbool_t     file_type_is_derived = FALSE;
+    MPI_Datatype mem_type = MPI_BYTE;       /* MPI memory datatype for chunks */
+    hbool_t     mem_type_is_derived = FALSE;
+    int        *lengths = NULL;             /* Length of each chunk */
+    MPI_Aint   *file_disps = NULL;          /* Displacement of each chunk in the file */
+    MPI_Aint   *mem_disps = NULL;           /* Displacement of each chunk's buffer */
+    hsize_t     mpi_buf_count = 0;          /* Number of MPI types */
+    void       *buf;                        /* Base buffer for I/O */
+    uint8_t     dummy = 0;                  /* Placeholder buffer, for no chunks */
+    int         mpi_code;                   /* MPI return code */
+    size_t      u;                          /* Local index variable */
+    herr_t      ret_value = SUCCEED;
+
+    FUNC_ENTER_STATIC
+
+    HDassert(H5F_addr_defined(base_addr));
+
+    /* Set up I/O info object for the raw chunks */
+    HDmemcpy(&raw_io_info, io_info, sizeof(raw_io_info));
+    raw_io_info.op_type = op_type;
+    raw_io_info.store = &ctg_store;
+
+    if(nios > 0) {
+        MPI_Aint base_mem;              /* Address of first chunk's buffer */
+
+        /* MPI file types must be in increasing file order */
+        if(nios > 1)
+            HDqsort(ios, nios, sizeof(H5D_filtered_io_t), H5D__cmp_filtered_io);
+
+        if(NULL == (lengths = (int *)H5MM_malloc(nios * sizeof(int))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "couldn't allocate chunk lengths buffer")
+        if(NULL == (file_disps = (MPI_Aint *)H5MM_malloc(nios * sizeof(MPI_Aint))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "couldn't allocate chunk file displacement buffer")
+        if(NULL == (mem_disps = (MPI_Aint *)H5MM_malloc(nios * sizeof(MPI_Aint))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "couldn't allocate chunk memory displacement buffer")
+
+        /* Describe the chunks relative to the first one */
+        if(MPI_SUCCESS != (mpi_code = MPI_Get_address(ios[0].buf, &base_mem)))
+            HMPI_GOTO_ERROR(FAIL, "MPI_Get_address failed", mpi_code)
+        for(u = 0; u < nios; u++) {
+            H5_CHECKED_ASSIGN(lengths[u], int, ios[u].len, size_t);
+            file_disps[u] = (MPI_Aint)(ios[u].addr - ios[0].addr);
+            if(MPI_SUCCESS != (mpi_code = MPI_Get_address(ios[u].buf, &mem_disps[u])))
+                HMPI_GOTO_ERROR(FAIL, "MPI_Get_address failed", mpi_code)
+            mem_disps[u] -= base_mem;
+        } /* end for */
+
+        /* Create the MPI datatypes */
+        if(MPI_SUCCESS != (mpi_code = MPI_Type_create_hindexed((int)nios, lengths, file_disps, MPI_BYTE, &file_type)))
+            HMPI_GOTO_ERROR(FAIL, "MPI_Type_create_hindexed failed", mpi_code)
+        file_type_is_derived = TRUE;
+        if(MPI_SUCCESS != (mpi_code = MPI_Type_commit(&file_type)))
+            HMPI_GOTO_ERROR(FAIL, "MPI_Type_commit failed", mpi_code)
+        if(MPI_SUCCESS != (mpi_code = MPI_Type_create_hindexed((int)nios, lengths, mem_disps, MPI_BYTE, &mem_type)))
+            HMPI_GOTO_ERROR(FAIL, "MPI_Type_create_hindexed failed", mpi_code)
+        mem_type_is_derived = TRUE;
+        if(MPI_SUCCESS != (mpi_code = MPI_Type_commit(&mem_type)))
+            HMPI_GOTO_ERROR(FAIL, "MPI_Type_commit failed", mpi_code)
+
+        ctg_store.contig.dset_addr = ios[0].addr;
+        buf = ios[0].buf;
+        mpi_buf_count = (hsize_t)1;
+    } /* end if */
+    else {
+        /* No chunks for this process, participate with no data */
+        ctg_store.contig.dset_addr = base_addr;
+        buf = &dummy;
+    } /* end else */
+
+    if(op_type == H5D_IO_OP_WRITE)
+        raw_io_info.u.wbuf = buf;
+    else
+        raw_io_info.u.rbuf = buf;
+
+    /* Perform final collective I/O operation */
+    if(H5D__final_collective_io(&raw_io_info, type_info, mpi_buf_count, &file_type, &mem_type) < 0)
+        HGOTO_ERROR(H5E_IO, H5E_CANTGET, FAIL, "couldn't finish MPI-IO")
+
+done:
+    if(lengths)
+        H5MM_xfree(lengths);
+    if(file_disps)
+        H5MM_xfree(file_disps);
+    if(mem_disps)
+        H5MM_xfree(mem_disps);
+
+    /* Free the MPI buf and file types, if they were derived */
+    if(mem_type_is_derived && MPI_SUCCESS != (mpi_code = MPI_Type_free(&mem_type)))
+        HMPI_DONE_ERROR(FAIL, "MPI_Type_free failed", mpi_code)
+    if(file_type_is_derived && MPI_SUCCESS != (mpi_code = MPI_Type_free(&file_type)))
+        HMPI_DONE_ERROR(FAIL, "MPI_Type_free failed", mpi_code)
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__filtered_collective_raw_io() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__filtered_collective_copy
+ *
+ * Purpose:     Copy NELMTS elements from the selection SRC_SPACE in SRC
+ *              to the selection DST_SPACE in DST.  A NULL dataspace means
+ *              the elements are packed together in that buffer.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__filtered_collective_copy(const void *src, const H5S_t *src_space, void *dst,
+    const H5S_t *dst_space, size_t elmt_size, size_t nelmts, const H5D_dxpl_cache_t *dxpl_cache)
+{
+    H5S_sel_iter_t iter;            /* Selection iterator */
+    hbool_t     iter_init = FALSE;  /* Whether the selection iterator has been initialized */
+    void       *tmp_buf = NULL;     /* Buffer for packed elements */
+    herr_t      ret_value = SUCCEED;
+
+    FUNC_ENTER_STATIC
+
+    HDassert(src);
+    HDassert(dst);
+
+    if(0 == nelmts)
+        HGOTO_DONE(SUCCEED)
+
+    /* Gather the elements from the source selection */
+    if(src_space) {
+        void *gath_buf;             /* Buffer to gather elements into */
+
+        if(dst_space) {
+            if(NULL == (tmp_buf = H5MM_malloc(nelmts * elmt_size)))
+                HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "couldn't allocate gather buffer")
+            gath_buf = tmp_buf;
+        } /* end if */
+        else
+            gath_buf = dst;
+
+        if(H5S_select_iter_init(&iter, src_space, elmt_size) < 0)
+            HGOTO_ERROR(H5E_DATASPACE, H5E_CANTINIT, FAIL, "unable to initialize selection iterator")
+        iter_init = TRUE;
+        if(nelmts != H5D__gather_mem(src, src_space, &iter, nelmts, dxpl_cache, gath_buf))
+            HGOTO_ERROR(H5E_IO, H5E_CANTCOPY, FAIL, "mem gather failed")
+        if(H5S_SELECT_ITER_RELEASE(&iter) < 0)
+            HGOTO_ERROR(H5E_DATASPACE, H5E_CANTFREE, FAIL, "can't release selection iterator")
+        iter_init = FALSE;
+
+        src = gath_buf;
+    } /* end if */
+
+    /* Scatter the packed elements to the destination selection */
+    if(dst_space) {
+        if(H5S_select_iter_init(&iter, dst_space, elmt_size) < 0)
+            HGOTO_ERROR(H5E_DATASPACE, H5E_CANTINIT, FAIL, "unable to initialize selection iterator")
+        iter_init = TRUE;
+        if(H5D__scatter_mem(src, dst_space, &iter, nelmts, dxpl_cache, dst) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_CANTCOPY, FAIL, "mem scatter failed")
+    } /* end if */
+    else if(NULL == src_space)
+        HDmemcpy(dst, src, nelmts * elmt_size);
+
+done:
+    if(iter_init && H5S_SELECT_ITER_RELEASE(&iter) < 0)
+        HDONE_ERROR(H5E_DATASPACE, H5E_CANTFREE, FAIL, "can't release selection iterator")
+    if(tmp_buf)
+        H5MM_xfree(tmp_buf);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__filtered_collective_copy() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__filtered_collective_fill
+ *
+ * Purpose:     Initialize an unfiltered chunk that doesn't exist in the
+ *              file yet, as H5D__chunk_lock() does.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__filtered_collective_fill(const H5D_io_info_t *io_info, void *buf, size_t buf_size)
+{
+    const H5D_t *dset = io_info->dset;      /* Local pointer to dataset info */
+    const H5O_fill_t *fill = &dset->shared->dcpl_cache.fill;   /* Fill value info */
+    H5D_fill_value_t fill_status;           /* Fill value status */
+    H5D_fill_buf_info_t fb_info;            /* Dataset's fill buffer info */
+    hbool_t     fb_info_init = FALSE;       /* Whether the fill value buffer has been initialized */
+    herr_t      ret_value = SUCCEED;
+
+    FUNC_ENTER_STATIC
+
+    if(H5P_is_fill_value_defined(fill, &fill_status) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't tell if fill value defined")
+
+    if(fill->fill_time == H5D_FILL_TIME_ALLOC ||
+            (fill->fill_time == H5D_FILL_TIME_IFSET &&
+             (fill_status == H5D_FILL_VALUE_USER_DEFINED ||
+              fill_status == H5D_FILL_VALUE_DEFAULT))) {
+        /* Replicate the fill value throughout the chunk */
+        if(H5D__fill_init(&fb_info, buf, NULL, NULL, NULL, NULL,
+                &dset->shared->dcpl_cache.fill, dset->shared->type,
+                dset->shared->type_id, (size_t)0, buf_size, io_info->md_dxpl_id) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "can't initialize fill buffer info")
+        fb_info_init = TRUE;
+
+        /* Check for VL datatype & non-default fill value */
+        if(fb_info.has_vlen_fill_type)
+            /* Fill the buffer with VL datatype fill values */
+            if(H5D__fill_refill_vl(&fb_info, fb_info.elmts_per_buf, io_info->md_dxpl_id) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTCONVERT, FAIL, "can't refill fill value buffer")
+    } /* end if */
+    else
+        HDmemset(buf, 0, buf_size);
+
+done:
+    if(fb_info_init && H5D__fill_term(&fb_info) < 0)
+        HDONE_ERROR(H5E_DATASET, H5E_CANTFREE, FAIL, "Can't release fill buffer info")
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__filtered_collective_fill() */
+
 
 /*-------------------------------------------------------------------------
  * Function:    H5D__inter_collective_io
@@ -1484,6 +2645,111 @@ H5D__cmp_chunk_addr(const void *chunk_addr_info1, const void *chunk_addr_info2)
    FUNC_LEAVE_NOAPI(H5F_addr_cmp(addr1, addr2))
 } /* end H5D__cmp_chunk_addr() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__cmp_filtered_sel
+ *
+ * Purpose:     Routine to compare selections in filtered chunks
+ *
+ * Description: Callback for qsort() to sort selections by chunk index,
+ *              then by the rank of the process with the selection
+ *
+ * Return:      -1, 0, 1
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+H5D__cmp_filtered_sel(const void *sel1, const void *sel2)
+{
+    const H5D_filtered_sel_t *s1 = (const H5D_filtered_sel_t *)sel1;
+    const H5D_filtered_sel_t *s2 = (const H5D_filtered_sel_t *)sel2;
+    int ret_value;
+
+    FUNC_ENTER_STATIC_NOERR
+
+    if(s1->index != s2->index)
+        ret_value = (s1->index < s2->index) ? -1 : 1;
+    else
+        ret_value = (s1->rank > s2->rank) - (s1->rank < s2->rank);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__cmp_filtered_sel() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__cmp_filtered_chunk
+ *
+ * Purpose:     Routine to compare filtered chunks
+ *
+ * Description: Callback for bsearch() to find a chunk by its index
+ *
+ * Return:      -1, 0, 1
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+H5D__cmp_filtered_chunk(const void *chunk1, const void *chunk2)
+{
+    hsize_t index1, index2;
+
+    FUNC_ENTER_STATIC_NOERR
+
+    index1 = ((const H5D_filtered_chunk_t *)chunk1)->index;
+    index2 = ((const H5D_filtered_chunk_t *)chunk2)->index;
+
+    FUNC_LEAVE_NOAPI((index1 > index2) - (index1 < index2))
+} /* end H5D__cmp_filtered_chunk() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__cmp_filtered_size
+ *
+ * Purpose:     Routine to compare new sizes of filtered chunks
+ *
+ * Description: Callback for qsort() to sort chunk sizes by chunk index
+ *
+ * Return:      -1, 0, 1
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+H5D__cmp_filtered_size(const void *size1, const void *size2)
+{
+    hsize_t index1, index2;
+
+    FUNC_ENTER_STATIC_NOERR
+
+    index1 = ((const H5D_filtered_size_t *)size1)->index;
+    index2 = ((const H5D_filtered_size_t *)size2)->index;
+
+    FUNC_LEAVE_NOAPI((index1 > index2) - (index1 < index2))
+} /* end H5D__cmp_filtered_size() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__cmp_filtered_io
+ *
+ * Purpose:     Routine to compare addresses of raw chunks
+ *
+ * Description: Callback for qsort() to sort raw chunk I/O by file address
+ *
+ * Return:      -1, 0, 1
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+H5D__cmp_filtered_io(const void *io1, const void *io2)
+{
+    haddr_t addr1, addr2;
+
+    FUNC_ENTER_STATIC_NOERR
+
+    addr1 = ((const H5D_filtered_io_t *)io1)->addr;
+    addr2 = ((const H5D_filtered_io_t *)io2)->addr;
+
+    FUNC_LEAVE_NOAPI(H5F_addr_cmp(addr1, addr2))
+} /* end H5D__cmp_filtered_io() */
+
 
 /*-------------------------------------------------------------------------
  * Function:    H5D__sort_chunk
@@ -67,6 +67,21 @@
 #define H5D_MARK_SPACE  0x01
 #define H5D_MARK_LAYOUT  0x02
 
+/* Default creation parameters for chunk index data structures */
+/* See H5O_layout_chunk_t */
+
+/* Fixed array creation values */
+#define H5D_FARRAY_CREATE_PARAM_SIZE            1       /* Size of the creation parameters in bytes */
+#define H5D_FARRAY_MAX_DBLK_PAGE_NELMTS_BITS    10      /* i.e. 1024 elements per data block page */
+
+/* Extensible array creation values */
+#define H5D_EARRAY_CREATE_PARAM_SIZE            5       /* Size of the creation parameters in bytes */
+#define H5D_EARRAY_MAX_NELMTS_BITS              32      /* i.e. 4 giga-elements */
+#define H5D_EARRAY_IDX_BLK_ELMTS                4
+#define H5D_EARRAY_SUP_BLK_MIN_DATA_PTRS        4
+#define H5D_EARRAY_DATA_BLK_MIN_ELMTS           16
+#define H5D_EARRAY_MAX_DBLK_PAGE_NELMTS_BITS    10      /* i.e. 1024 elements per data block page */
+
 
 /****************************/
 /* Package Private Typedefs */
@@ -87,6 +102,7 @@ typedef struct H5D_type_info_t {
     size_t max_type_size;	        /* Size of largest source/destination type */
     hbool_t is_conv_noop;               /* Whether the type conversion is a NOOP */
     hbool_t is_xform_noop;              /* Whether the data transform is a NOOP */
+    hbool_t is_conv_inplace;            /* Whether to convert in the application's buffer */
     const H5T_subset_info_t *cmpd_subset;   /* Info related to the compound subset conversion functions */
     H5T_bkg_t need_bkg;		        /* Type of background buf needed */
     size_t request_nelmts;		/* Requested strip mine	*/
@@ -259,12 +275,13 @@ typedef struct H5D_chunk_common_ud_t {
 } H5D_chunk_common_ud_t;
 
 /* B-tree callback info for various operations */
+struct H5D_rdcc_ent_t;  /* Forward declaration of struct used below */
 typedef struct H5D_chunk_ud_t {
     /* Downward */
     H5D_chunk_common_ud_t common;       /* Common info for B-tree user data (must be first) */
 
     /* Upward */
-    unsigned    idx_hint;               /* Index of chunk in cache, if present */
+    struct H5D_rdcc_ent_t *ent;         /* Chunk's entry in cache, if present */
     H5F_block_t chunk_block;            /* Offset/length of chunk in file */
     unsigned	filter_mask;		/* Excluded filters	*/
     hsize_t     chunk_idx;              /* Chunk index for EA, FA indexing */
@@ -371,25 +388,93 @@ typedef struct H5D_chunk_cached_t {
     unsigned	filter_mask;			/*excluded filters	*/
 } H5D_chunk_cached_t;
 
+/*
+ * Lists of the raw data chunk cache's replacement policy.  This is an
+ * adaptive replacement cache (ARC), with sizes measured in bytes: chunks
+ * accessed once recently are on the T1 list and chunks accessed more than
+ * once on the T2 list, so a scan through a dataset can only push out the
+ * chunks on T1.  The B1 & B2 lists hold "ghosts" of chunks recently evicted
+ * from T1 & T2, and a miss on a ghost adapts the target size of T1.
+ */
+typedef enum H5D_rdcc_list_t {
+    H5D_RDCC_T1 = 0,            /* Cached chunks accessed once recently */
+    H5D_RDCC_T2,                /* Cached chunks accessed more than once recently */
+    H5D_RDCC_B1,                /* Ghosts of chunks evicted from T1 */
+    H5D_RDCC_B2,                /* Ghosts of chunks evicted from T2 */
+    H5D_RDCC_NLISTS             /* Number of lists (must be last) */
+} H5D_rdcc_list_t;
+
+/* Memory pool for cached chunks, owned by one dataset or shared by all the
+ * datasets in a file */
+typedef struct H5D_rdcc_pool_t {
+    size_t      nbytes_max;     /* Maximum cached raw data in bytes */
+    size_t      nbytes_used;    /* Current cached raw data in bytes */
+    size_t      nents_max;      /* Maximum number of cached chunks (0 for no limit) */
+    size_t      p;              /* Target size of T1 list, in bytes */
+    size_t      ndsets;         /* Number of datasets using the pool */
+    hbool_t     shared;         /* Whether the pool is shared by the file's datasets */
+    struct {
+        struct H5D_rdcc_ent_t *head;    /* Least recently used entry */
+        struct H5D_rdcc_ent_t *tail;    /* Most recently used entry */
+        size_t  nbytes;         /* Size of chunks on list, in bytes */
+        size_t  nents;          /* Number of entries on list */
+    } list[H5D_RDCC_NLISTS];
+} H5D_rdcc_pool_t;
+
 /* The raw data chunk cache */
-struct H5D_rdcc_ent_t;  /* Forward declaration of struct used below */
 typedef struct H5D_rdcc_t {
     struct {
-        unsigned	ninits;	/* Number of chunk creations		*/
-        unsigned	nhits;	/* Number of cache hits			*/
-        unsigned	nmisses;/* Number of cache misses		*/
-        unsigned	nflushes;/* Number of cache flushes		*/
+        hsize_t	ninits;	/* Number of chunk creations		*/
+        hsize_t	nhits;	/* Number of cache hits			*/
+        hsize_t	nmisses;/* Number of cache misses		*/
+        hsize_t	nflushes;/* Number of cache flushes		*/
+        hsize_t	nevictions;/* Number of cache evictions		*/
+        hsize_t	nghost_hits;/* Number of misses on recently evicted chunks */
+        hsize_t	nprefetches;/* Number of chunks read ahead		*/
+        hsize_t	nprefetch_hits;/* Number of chunks read ahead & then accessed */
+        hsize_t	nwrite_behinds;/* Number of evicted chunks written behind */
     } stats;
     size_t		nbytes_max; /* Maximum cached raw data in bytes	*/
-    size_t		nslots;	/* Number of chunk slots allocated	*/
+    size_t		nslots;	/* Initial number of hash table buckets	*/
     double		w0;     /* Chunk preemption policy          */
     struct H5D_rdcc_ent_t *head; /* Head of doubly linked list		*/
     struct H5D_rdcc_ent_t *tail; /* Tail of doubly linked list		*/
-    struct H5D_rdcc_ent_t *tmp_head; /* Head of temporary doubly linked list.  Chunks on this list are not in the hash table (slot).  The head entry is a sentinel (does not refer to an actual chunk). */
     size_t		nbytes_used; /* Current cached raw data in bytes */
-    int			nused;	/* Number of chunk slots in use		*/
+    int			nused;	/* Number of chunks cached		*/
     H5D_chunk_cached_t last;    /* Cached copy of last chunk information */
-    struct H5D_rdcc_ent_t **slot; /* Chunk slots, each points to a chunk*/
+    struct H5D_rdcc_ent_t **slot; /* Hash table buckets, each a chain of entries */
+    size_t		nbuckets; /* Number of hash table buckets	*/
+    size_t		nentries; /* Number of entries (chunks & ghosts) in hash table */
+    H5D_rdcc_pool_t	*pool;	/* Memory pool used, NULL if no cache	*/
+    H5D_rdcc_pool_t	local_pool; /* Pool used when not sharing the file's */
+    const H5D_t		*owner; /* Dataset to write back chunks evicted for other datasets */
+
+    /* Reading chunks ahead, for sequential access */
+    struct {
+        size_t          nchunks;        /* # of chunks to read ahead, 0 if disabled */
+        hsize_t         last;           /* Index of chunk accessed last */
+        hssize_t        stride;         /* Difference between the last two chunk indices */
+        unsigned        run;            /* # of chunks accessed with the same stride */
+        size_t          nents;          /* # of chunks read ahead */
+        hsize_t         *idx;           /* Indices of chunks read ahead */
+        H5Z_pipeline_job_t *jobs;       /* Chunks read ahead (NULL buffer once used) */
+        H5Z_pipeline_multi_t *multi;    /* Chunks being filtered in the background */
+    } prefetch;
+
+    /* Writing evicted chunks behind, during an I/O operation */
+    struct {
+        size_t          nchunks;        /* # of chunks to collect, 0 if disabled */
+        hbool_t         active;         /* Whether evicted chunks are collected now */
+        hid_t           dxpl_id;        /* DXPL for writing while active */
+        const H5D_dxpl_cache_t *dxpl_cache; /* DXPL cache while active */
+        size_t          nents;          /* # of chunks collected */
+        struct H5D_rdcc_ent_t *ents;    /* Chunks collected */
+        size_t          npending;       /* # of chunks being filtered */
+        struct H5D_rdcc_ent_t *pending; /* Chunks being filtered */
+        H5Z_pipeline_job_t *jobs;       /* Filter jobs for the pending chunks */
+        H5Z_pipeline_multi_t *multi;    /* Pending chunks being filtered in the background */
+    } write_behind;
+
     H5SL_t		*sel_chunks; /* Skip list containing information for each chunk selected */
     H5S_t		*single_space; /* Dataspace for single element I/O on chunks */
     H5D_chunk_info_t    *single_chunk_info;  /* Pointer to single chunk's info */
@@ -518,6 +603,9 @@ H5_DLLVAR const H5D_layout_ops_t H5D_LOPS_VIRTUAL[1];
 
 /* Chunked layout operations */
 H5_DLLVAR const H5D_chunk_ops_t H5D_COPS_BTREE[1];
+H5_DLLVAR const H5D_chunk_ops_t H5D_COPS_SINGLE[1];
+H5_DLLVAR const H5D_chunk_ops_t H5D_COPS_FARRAY[1];
+H5_DLLVAR const H5D_chunk_ops_t H5D_COPS_EARRAY[1];
 
 
 /******************************/
@@ -546,6 +634,8 @@ H5_DLL herr_t H5D__get_dxpl_cache(hid_t dxpl_id, H5D_dxpl_cache_t **cache);
 H5_DLL herr_t H5D__flush_sieve_buf(H5D_t *dataset, hid_t dxpl_id);
 H5_DLL herr_t H5D__mark(const H5D_t *dataset, hid_t dxpl_id, unsigned flags);
 H5_DLL herr_t H5D__flush_real(H5D_t *dataset, hid_t dxpl_id);
+H5_DLL herr_t H5D__flush(H5D_t *dataset, hid_t dxpl_id);
+H5_DLL herr_t H5D__refresh(H5D_t *dataset, hid_t dxpl_id);
 #ifdef H5_DEBUG_BUILD
 H5_DLL herr_t H5D_set_io_info_dxpls(H5D_io_info_t *io_info, hid_t dxpl_id);
 #endif /* H5_DEBUG_BUILD */
@@ -565,11 +655,17 @@ H5_DLL herr_t H5D__select_read(const H5D_io_info_t *io_info,
 H5_DLL herr_t H5D__select_write(const H5D_io_info_t *io_info,
     const H5D_type_info_t *type_info,
     hsize_t nelmts, const H5S_t *file_space, const H5S_t *mem_space);
+H5_DLL herr_t H5D__select_read_inplace(const H5D_io_info_t *io_info,
+    const H5D_type_info_t *type_info,
+    hsize_t nelmts, const H5S_t *file_space, const H5S_t *mem_space);
 
 /* Functions that perform scatter-gather serial I/O operations */
 H5_DLL herr_t H5D__scatter_mem(const void *_tscat_buf,
     const H5S_t *space, H5S_sel_iter_t *iter, size_t nelmts,
     const H5D_dxpl_cache_t *dxpl_cache, void *_buf);
+H5_DLL size_t H5D__gather_mem(const void *_buf,
+    const H5S_t *space, H5S_sel_iter_t *iter, size_t nelmts,
+    const H5D_dxpl_cache_t *dxpl_cache, void *_tgath_buf/*out*/);
 H5_DLL herr_t H5D__scatgath_read(const H5D_io_info_t *io_info,
     const H5D_type_info_t *type_info,
     hsize_t nelmts, const H5S_t *file_space, const H5S_t *mem_space);
@@ -579,6 +675,8 @@ H5_DLL herr_t H5D__scatgath_write(const H5D_io_info_t *io_info,
 
 /* Functions that operate on dataset's layout information */
 H5_DLL herr_t H5D__layout_set_io_ops(const H5D_t *dataset);
+H5_DLL herr_t H5D__layout_set_latest_indexing(H5O_layout_t *layout,
+    const H5S_t *space, const H5D_dcpl_cache_t *dcpl_cache);
 H5_DLL size_t H5D__layout_meta_size(const H5F_t *f, const H5O_layout_t *layout,
     hbool_t include_compact_data);
 H5_DLL herr_t H5D__layout_oh_create(H5F_t *file, hid_t dxpl_id, H5O_t *oh,
@@ -619,8 +717,17 @@ H5_DLL herr_t H5D__chunk_prune_by_extent(H5D_t *dset, hid_t dxpl_id,
     const hsize_t *old_dim);
 #ifdef H5_HAVE_PARALLEL
 H5_DLL herr_t H5D__chunk_addrmap(const H5D_io_info_t *io_info, haddr_t chunk_addr[]);
+H5_DLL herr_t H5D__chunk_update_block(const H5D_io_info_t *io_info,
+    H5D_chunk_ud_t *udata, hsize_t nbytes, unsigned filter_mask);
 #endif /* H5_HAVE_PARALLEL */
 H5_DLL herr_t H5D__chunk_update_cache(H5D_t *dset, hid_t dxpl_id);
+H5_DLL herr_t H5D__chunk_cache_disown(const H5D_t *dset, hid_t dxpl_id);
+H5_DLL herr_t H5D__chunk_cache_get_stats(const H5D_t *dset,
+    H5D_chunk_cache_stats_t *stats);
+H5_DLL herr_t H5D__chunk_cache_reset_stats(H5D_t *dset);
+H5_DLL herr_t H5D__chunk_prefetch_reset(const H5D_t *dset);
+H5_DLL herr_t H5D__chunk_release(H5D_t *dset, hid_t dxpl_id);
+H5_DLL herr_t H5D__chunk_refresh(H5D_t *dset, hid_t dxpl_id);
 H5_DLL herr_t H5D__chunk_copy(H5F_t *f_src, H5O_storage_chunk_t *storage_src,
     H5O_layout_chunk_t *layout_src, H5F_t *f_dst, H5O_storage_chunk_t *storage_dst,
     const H5S_extent_t *ds_extent_src, const H5T_t *dt_src,
@@ -632,6 +739,10 @@ H5_DLL herr_t H5D__chunk_delete(H5F_t *f, hid_t dxpl_id, H5O_t *oh,
     H5O_storage_t *store);
 H5_DLL herr_t H5D__chunk_direct_write(const H5D_t *dset, hid_t dxpl_id, uint32_t filters, 
          hsize_t *offset, uint32_t data_size, const void *buf);
+H5_DLL herr_t H5D__chunk_direct_read(const H5D_t *dset, hid_t dxpl_id,
+    const hsize_t *offset, uint32_t *filters, void *buf);
+H5_DLL herr_t H5D__chunk_get_info_by_coord(const H5D_t *dset, hid_t dxpl_id,
+    const hsize_t *offset, unsigned *filter_mask, haddr_t *addr, hsize_t *size);
 #ifdef H5D_CHUNK_DEBUG
 H5_DLL herr_t H5D__chunk_stats(const H5D_t *dset, hbool_t headers);
 #endif /* H5D_CHUNK_DEBUG */
@@ -715,6 +826,7 @@ H5_DLL htri_t H5D__mpio_opt_possible(const H5D_io_info_t *io_info,
 #ifdef H5D_TESTING
 H5_DLL herr_t H5D__layout_version_test(hid_t did, unsigned *version);
 H5_DLL herr_t H5D__layout_contig_size_test(hid_t did, hsize_t *size);
+H5_DLL herr_t H5D__layout_idx_type_test(hid_t did, H5D_chunk_index_t *idx_type);
 H5_DLL herr_t H5D__current_cache_size_test(hid_t did, size_t *nbytes_used, int *nused);
 #endif /* H5D_TESTING */
 
@@ -52,6 +52,8 @@
 #define H5D_ACS_DATA_CACHE_NUM_SLOTS_NAME   "rdcc_nslots"   /* Size of raw data chunk cache(slots) */
 #define H5D_ACS_DATA_CACHE_BYTE_SIZE_NAME   "rdcc_nbytes"   /* Size of raw data chunk cache(bytes) */
 #define H5D_ACS_PREEMPT_READ_CHUNKS_NAME    "rdcc_w0"       /* Preemption read chunks first */
+#define H5D_ACS_CHUNK_PREFETCH_NAME         "chunk_prefetch" /* # of chunks to read ahead */
+#define H5D_ACS_CHUNK_WRITE_BEHIND_NAME     "chunk_write_behind" /* # of evicted chunks to write behind */
 #define H5D_ACS_VDS_VIEW_NAME               "vds_view"      /* VDS view option */
 #define H5D_ACS_VDS_PRINTF_GAP_NAME         "vds_printf_gap" /* VDS printf gap size */
 #define H5D_ACS_EFILE_PREFIX_NAME           "external file prefix" /* External file prefix */
@@ -82,6 +84,7 @@
 #define H5D_XFER_FILTER_CB_NAME         "filter_cb"     /* Filter callback function */
 #define H5D_XFER_CONV_CB_NAME           "type_conv_cb"  /* Type conversion callback function */
 #define H5D_XFER_XFORM_NAME             "data_transform" /* Data transform */
+#define H5D_XFER_FILTER_NTHREADS_NAME   "filter_nthreads" /* # of threads for filter pipeline */
 #ifdef H5_HAVE_INSTRUMENTED_LIBRARY
 /* Collective chunk instrumentation properties */
 #define H5D_XFER_COLL_CHUNK_LINK_HARD_NAME "coll_chunk_link_hard"
@@ -135,6 +138,7 @@ typedef struct H5D_dxpl_cache_t {
 #endif /*H5_HAVE_PARALLEL*/
     H5Z_cb_t filter_cb;         /* Filter callback function (H5D_XFER_FILTER_CB_NAME) */
     H5Z_data_xform_t *data_xform_prop; /* Data transform prop (H5D_XFER_XFORM_NAME) */
+    unsigned filter_nthreads;   /* # of threads for filter pipeline (H5D_XFER_FILTER_NTHREADS_NAME) */
 } H5D_dxpl_cache_t;
 
 /* Typedef for cached dataset creation property list information */
@@ -39,6 +39,11 @@
 #define H5D_XFER_DIRECT_CHUNK_WRITE_FILTERS_NAME	"direct_chunk_filters"
 #define H5D_XFER_DIRECT_CHUNK_WRITE_OFFSET_NAME		"direct_chunk_offset"
 #define H5D_XFER_DIRECT_CHUNK_WRITE_DATASIZE_NAME	"direct_chunk_datasize"
+
+/* Property names for H5DOread_chunk */
+#define H5D_XFER_DIRECT_CHUNK_READ_FLAG_NAME	        "direct_chunk_read_flag"
+#define H5D_XFER_DIRECT_CHUNK_READ_OFFSET_NAME		"direct_chunk_read_offset"
+#define H5D_XFER_DIRECT_CHUNK_READ_FILTERS_NAME		"direct_chunk_read_filters"
  
 /*******************/
 /* Public Typedefs */
@@ -58,6 +63,10 @@ typedef enum H5D_layout_t {
 /* Types of chunk index data structures */
 typedef enum H5D_chunk_index_t {
     H5D_CHUNK_IDX_BTREE	= 0,	/* v1 B-tree index		     	*/
+    H5D_CHUNK_IDX_SINGLE = 1,   /* Single chunk index (cur dims[]=max dims[]=chunk dims[]) */
+                                /* (2 is reserved for an implicit "no index" type) */
+    H5D_CHUNK_IDX_FARRAY = 3,   /* Fixed array (for 0 unlimited dims)	*/
+    H5D_CHUNK_IDX_EARRAY = 4,   /* Extensible array (for 1 unlimited dim) */
     H5D_CHUNK_IDX_NTYPES        /* this one must be last!		*/
 } H5D_chunk_index_t;
 
@@ -101,6 +110,24 @@ typedef enum H5D_vds_view_t {
     H5D_VDS_LAST_AVAILABLE      = 1
 } H5D_vds_view_t;
 
+/* Raw data chunk cache statistics, from H5Dget_chunk_cache_stats() */
+typedef struct H5D_chunk_cache_stats_t {
+    hsize_t     nhits;          /* Number of chunk accesses found in the cache */
+    hsize_t     nmisses;        /* Number of chunks read from the file into the cache */
+    hsize_t     ninits;         /* Number of chunks created in the cache (not in the file) */
+    hsize_t     nevictions;     /* Number of chunks evicted to make room for others */
+    hsize_t     nflushes;       /* Number of chunks written to the file */
+    hsize_t     nghost_hits;    /* Number of misses on chunks that were recently evicted */
+    hsize_t     nprefetches;    /* Number of chunks read ahead (see H5Pset_chunk_prefetch) */
+    hsize_t     nprefetch_hits; /* Number of chunks read ahead that were then accessed */
+    hsize_t     nwrite_behinds; /* Number of evicted chunks written behind (see H5Pset_chunk_write_behind) */
+    size_t      nbytes_used;    /* Size of the dataset's cached chunks, in bytes */
+    size_t      nused;          /* Number of the dataset's cached chunks */
+    size_t      pool_nbytes_used; /* Size of all chunks cached in the dataset's pool, in bytes */
+    size_t      pool_nbytes_max;  /* Size of the dataset's pool, in bytes */
+    hbool_t     pool_shared;    /* Whether the pool is shared by all datasets in the file */
+} H5D_chunk_cache_stats_t;
+
 /********************/
 /* Public Variables */
 /********************/
@@ -142,6 +169,12 @@ H5_DLL herr_t H5Dread(hid_t dset_id, hid_t mem_type_id, hid_t mem_space_id,
 			hid_t file_space_id, hid_t plist_id, void *buf/*out*/);
 H5_DLL herr_t H5Dwrite(hid_t dset_id, hid_t mem_type_id, hid_t mem_space_id,
 			 hid_t file_space_id, hid_t plist_id, const void *buf);
+H5_DLL herr_t H5Dread_multi(size_t count, const hid_t *dset_id,
+    const hid_t *mem_type_id, const hid_t *mem_space_id,
+    const hid_t *file_space_id, hid_t dxpl_id, void **buf/*out*/);
+H5_DLL herr_t H5Dwrite_multi(size_t count, const hid_t *dset_id,
+    const hid_t *mem_type_id, const hid_t *mem_space_id,
+    const hid_t *file_space_id, hid_t dxpl_id, const void **buf);
 H5_DLL herr_t H5Diterate(void *buf, hid_t type_id, hid_t space_id,
             H5D_operator_t op, void *operator_data);
 H5_DLL herr_t H5Dvlen_reclaim(hid_t type_id, hid_t space_id, hid_t plist_id, void *buf);
@@ -149,11 +182,19 @@ H5_DLL herr_t H5Dvlen_get_buf_size(hid_t dataset_id, hid_t type_id, hid_t space_
 H5_DLL herr_t H5Dfill(const void *fill, hid_t fill_type, void *buf,
         hid_t buf_type, hid_t space);
 H5_DLL herr_t H5Dset_extent(hid_t dset_id, const hsize_t size[]);
+H5_DLL herr_t H5Dflush(hid_t dset_id);
+H5_DLL herr_t H5Drefresh(hid_t dset_id);
 H5_DLL herr_t H5Dscatter(H5D_scatter_func_t op, void *op_data, hid_t type_id,
     hid_t dst_space_id, void *dst_buf);
 H5_DLL herr_t H5Dgather(hid_t src_space_id, const void *src_buf, hid_t type_id,
     size_t dst_buf_size, void *dst_buf, H5D_gather_func_t op, void *op_data);
 H5_DLL herr_t H5Ddebug(hid_t dset_id);
+H5_DLL herr_t H5Dget_chunk_cache_stats(hid_t dset_id, H5D_chunk_cache_stats_t *stats);
+H5_DLL herr_t H5Dreset_chunk_cache_stats(hid_t dset_id);
+H5_DLL herr_t H5Dget_chunk_storage_size(hid_t dset_id, const hsize_t *offset,
+    hsize_t *chunk_nbytes);
+H5_DLL herr_t H5Dget_chunk_info_by_coord(hid_t dset_id, const hsize_t *offset,
+    unsigned *filter_mask, haddr_t *addr, hsize_t *size);
 
 /* Symbols defined for compatibility with previous versions of the HDF5 API.
  *
@@ -33,6 +33,8 @@
 #include "H5Dpkg.h"		/* Datasets				*/
 #include "H5Eprivate.h"		/* Error handling		  	*/
 #include "H5FLprivate.h"	/* Free Lists                           */
+#include "H5MMprivate.h"	/* Memory management			*/
+#include "H5Tprivate.h"		/* Datatypes				*/
 
 
 /****************/
@@ -44,13 +46,26 @@
 /* Local Typedefs */
 /******************/
 
+/* Offsets of an element of a point selection, for sorting by file offset */
+typedef struct H5D_select_pnt_t {
+    hsize_t file_off;           /* Offset of element in the file */
+    hsize_t mem_off;            /* Offset of element in memory */
+    size_t idx;                 /* Position of element in the selection */
+} H5D_select_pnt_t;
+
 
 /********************/
 /* Local Prototypes */
 /********************/
 
 static herr_t H5D__select_io(const H5D_io_info_t *io_info, size_t elmt_size,
-    size_t nelmts, const H5S_t *file_space, const H5S_t *mem_space);
+    size_t mem_elmt_size, size_t nelmts, const H5S_t *file_space,
+    const H5S_t *mem_space);
+static int H5D__select_cmp_pnt(const void *_pnt1, const void *_pnt2);
+static herr_t H5D__select_io_points(const H5D_io_info_t *io_info,
+    size_t elmt_size, size_t mem_elmt_size, size_t nelmts,
+    const H5S_t *file_space, const H5S_t *mem_space, hsize_t *file_off,
+    size_t *file_len, hsize_t *mem_off, size_t *mem_len);
 
 
 /*********************/
@@ -75,6 +90,12 @@ H5FL_SEQ_DEFINE(hsize_t);
  *
  * Purpose:	Perform I/O directly from application memory and a file
  *
+ *		If MEM_ELMT_SIZE is larger than ELMT_SIZE, the memory
+ *		selection is laid out with elements of MEM_ELMT_SIZE bytes
+ *		and the ELMT_SIZE byte file elements of each contiguous run
+ *		of memory elements are packed at the start of that run,
+ *		leaving room for them to be converted in place.
+ *
  * Return:	Non-negative on success/Negative on failure
  *
  * Programmer:	Quincey Koziol
@@ -84,7 +105,8 @@ H5FL_SEQ_DEFINE(hsize_t);
  */
 static herr_t
 H5D__select_io(const H5D_io_info_t *io_info, size_t elmt_size,
-    size_t nelmts, const H5S_t *file_space, const H5S_t *mem_space)
+    size_t mem_elmt_size, size_t nelmts, const H5S_t *file_space,
+    const H5S_t *mem_space)
 {
     H5S_sel_iter_t mem_iter;    /* Memory selection iteration info */
     hbool_t mem_iter_init = 0;  /* Memory selection iteration info has been initialized */
@@ -144,7 +166,7 @@ H5D__select_io(const H5D_io_info_t *io_info, size_t elmt_size,
         file_nseq = mem_nseq = 1;
         curr_mem_seq = curr_file_seq = 0;
         *file_off *= elmt_size;
-        *mem_off *= elmt_size;
+        *mem_off *= mem_elmt_size;
         *file_len = *mem_len = elmt_size;
 
         /* Perform I/O on memory and file sequences */
@@ -165,6 +187,12 @@ H5D__select_io(const H5D_io_info_t *io_info, size_t elmt_size,
         /* Decrement number of elements left to process */
         HDassert(((size_t)tmp_file_len % elmt_size) == 0);
     } /* end if */
+    /* Sort point selections in the file by offset */
+    else if(H5S_GET_SELECT_TYPE(file_space) == H5S_SEL_POINTS) {
+        if(H5D__select_io_points(io_info, elmt_size, mem_elmt_size, nelmts,
+                file_space, mem_space, file_off, file_len, mem_off, mem_len) < 0)
+            HGOTO_ERROR(H5E_DATASPACE, H5E_CANTOPERATE, FAIL, "point selection I/O failed")
+    } /* end if */
     else {
         size_t mem_nelem;           /* Number of elements used in memory sequences */
         size_t file_nelem;          /* Number of elements used in file sequences */
@@ -175,7 +203,7 @@ H5D__select_io(const H5D_io_info_t *io_info, size_t elmt_size,
         file_iter_init = 1;	/* File selection iteration info has been initialized */
 
         /* Initialize memory iterator */
-        if(H5S_select_iter_init(&mem_iter, mem_space, elmt_size) < 0)
+        if(H5S_select_iter_init(&mem_iter, mem_space, mem_elmt_size) < 0)
             HGOTO_ERROR(H5E_DATASPACE, H5E_CANTINIT, FAIL, "unable to initialize selection iterator")
         mem_iter_init = 1;	/* Memory selection iteration info has been initialized */
 
@@ -201,6 +229,14 @@ H5D__select_io(const H5D_io_info_t *io_info, size_t elmt_size,
                 if(H5S_SELECT_GET_SEQ_LIST(mem_space, 0, &mem_iter, io_info->dxpl_cache->vec_size, nelmts, &mem_nseq, &mem_nelem, mem_off, mem_len) < 0)
                     HGOTO_ERROR(H5E_INTERNAL, H5E_UNSUPPORTED, FAIL, "sequence length generation failed")
 
+                /* Pack the file elements at the start of each memory sequence */
+                if(mem_elmt_size != elmt_size) {
+                    size_t u;           /* Local index variable */
+
+                    for(u = 0; u < mem_nseq; u++)
+                        mem_len[u] = (mem_len[u] / mem_elmt_size) * elmt_size;
+                } /* end if */
+
                 /* Start at the beginning of the sequences again */
                 curr_mem_seq = 0;
             } /* end if */
@@ -250,6 +286,193 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5D__select_io() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__select_cmp_pnt
+ *
+ * Purpose:	Compare two point selection elements by file offset, for
+ *		qsort().  Elements at the same offset keep their order in
+ *		the selection, so the last of several writes to an element
+ *		still wins.
+ *
+ * Return:	<0, 0 or >0, as for qsort()
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+H5D__select_cmp_pnt(const void *_pnt1, const void *_pnt2)
+{
+    const H5D_select_pnt_t *pnt1 = (const H5D_select_pnt_t *)_pnt1;
+    const H5D_select_pnt_t *pnt2 = (const H5D_select_pnt_t *)_pnt2;
+    int ret_value = 0;          /* Return value */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    if(pnt1->file_off < pnt2->file_off)
+        ret_value = -1;
+    else if(pnt1->file_off > pnt2->file_off)
+        ret_value = 1;
+    else if(pnt1->idx < pnt2->idx)
+        ret_value = -1;
+    else if(pnt1->idx > pnt2->idx)
+        ret_value = 1;
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__select_cmp_pnt() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__select_io_points
+ *
+ * Purpose:	Perform I/O for a point selection in the file, in order of
+ *		file offset.
+ *
+ *		The file and memory offset of every element are gathered
+ *		in selection order and the elements are sorted by file
+ *		offset, which keeps each memory offset paired with its file
+ *		element.  The sorted elements are then handed to the layout
+ *		in batches of up to the vector size of file and memory
+ *		sequences, merging elements which are adjacent in the file
+ *		or in memory.  This replaces one short, out-of-order I/O
+ *		call for each point with vectored I/O which moves forward
+ *		through the file.
+ *
+ *		The vector arrays passed in must hold the dataset transfer
+ *		property list's vector size of sequences.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__select_io_points(const H5D_io_info_t *io_info, size_t elmt_size,
+    size_t mem_elmt_size, size_t nelmts, const H5S_t *file_space,
+    const H5S_t *mem_space, hsize_t *file_off, size_t *file_len,
+    hsize_t *mem_off, size_t *mem_len)
+{
+    H5S_sel_iter_t iter;        /* Selection iteration info */
+    hbool_t iter_init = FALSE;  /* Selection iteration info has been initialized */
+    H5D_select_pnt_t *pnt = NULL;       /* Offsets of each element */
+    size_t vec_size = io_info->dxpl_cache->vec_size;   /* Maximum number of sequences */
+    hbool_t sorted = TRUE;      /* Whether the points are already in file order */
+    size_t nseq;                /* Number of sequences generated */
+    size_t seq_nelem;           /* Number of elements in sequences generated */
+    size_t u, v, w;             /* Local index variables */
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Check args */
+    HDassert(io_info);
+    HDassert(nelmts > 1);
+    HDassert(H5S_GET_SELECT_TYPE(file_space) == H5S_SEL_POINTS);
+
+    /* Allocate the element offsets */
+    if(NULL == (pnt = (H5D_select_pnt_t *)H5MM_malloc(sizeof(H5D_select_pnt_t) * nelmts)))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "can't allocate point offsets")
+
+    /* Get the file offset of each element, in selection order */
+    if(H5S_select_iter_init(&iter, file_space, elmt_size) < 0)
+        HGOTO_ERROR(H5E_DATASPACE, H5E_CANTINIT, FAIL, "unable to initialize selection iterator")
+    iter_init = TRUE;
+    for(w = 0; w < nelmts; ) {
+        if(H5S_SELECT_GET_SEQ_LIST(file_space, 0, &iter, vec_size, nelmts - w, &nseq, &seq_nelem, file_off, file_len) < 0)
+            HGOTO_ERROR(H5E_INTERNAL, H5E_UNSUPPORTED, FAIL, "sequence length generation failed")
+        for(u = 0; u < nseq; u++)
+            for(v = 0; v < file_len[u]; v += elmt_size, w++) {
+                pnt[w].file_off = file_off[u] + v;
+                pnt[w].idx = w;
+                if(w > 0 && pnt[w].file_off < pnt[w - 1].file_off)
+                    sorted = FALSE;
+            } /* end for */
+    } /* end for */
+    if(H5S_SELECT_ITER_RELEASE(&iter) < 0)
+        HGOTO_ERROR(H5E_DATASPACE, H5E_CANTRELEASE, FAIL, "unable to release selection iterator")
+    iter_init = FALSE;
+
+    /* Get the memory offset of each element, packing the file elements at
+     * the start of each memory sequence, as H5D__select_io() does */
+    if(H5S_select_iter_init(&iter, mem_space, mem_elmt_size) < 0)
+        HGOTO_ERROR(H5E_DATASPACE, H5E_CANTINIT, FAIL, "unable to initialize selection iterator")
+    iter_init = TRUE;
+    for(w = 0; w < nelmts; ) {
+        if(H5S_SELECT_GET_SEQ_LIST(mem_space, 0, &iter, vec_size, nelmts - w, &nseq, &seq_nelem, mem_off, mem_len) < 0)
+            HGOTO_ERROR(H5E_INTERNAL, H5E_UNSUPPORTED, FAIL, "sequence length generation failed")
+        for(u = 0; u < nseq; u++)
+            for(v = 0; v < (mem_len[u] / mem_elmt_size); v++, w++)
+                pnt[w].mem_off = mem_off[u] + (v * elmt_size);
+    } /* end for */
+    if(H5S_SELECT_ITER_RELEASE(&iter) < 0)
+        HGOTO_ERROR(H5E_DATASPACE, H5E_CANTRELEASE, FAIL, "unable to release selection iterator")
+    iter_init = FALSE;
+
+    /* Put the elements in file order */
+    if(!sorted)
+        HDqsort(pnt, nelmts, sizeof(H5D_select_pnt_t), H5D__select_cmp_pnt);
+
+    /* Perform the I/O, a batch of sequences at a time */
+    for(w = 0; w < nelmts; ) {
+        size_t file_nseq = 0;       /* Number of sequences in the file */
+        size_t mem_nseq = 0;        /* Number of sequences in memory */
+        size_t curr_file_seq = 0;   /* Current file sequence to operate on */
+        size_t curr_mem_seq = 0;    /* Current memory sequence to operate on */
+        ssize_t tmp_file_len;       /* Number of bytes transferred */
+
+        /* Build the file and memory sequences for the next elements */
+        while(w < nelmts) {
+            hbool_t file_extend = (file_nseq > 0 && pnt[w].file_off == (file_off[file_nseq - 1] + file_len[file_nseq - 1]));
+            hbool_t mem_extend = (mem_nseq > 0 && pnt[w].mem_off == (mem_off[mem_nseq - 1] + mem_len[mem_nseq - 1]));
+
+            /* Stop when a new sequence won't fit */
+            if((!file_extend && file_nseq == vec_size) || (!mem_extend && mem_nseq == vec_size))
+                break;
+
+            if(file_extend)
+                file_len[file_nseq - 1] += elmt_size;
+            else {
+                file_off[file_nseq] = pnt[w].file_off;
+                file_len[file_nseq++] = elmt_size;
+            } /* end else */
+            if(mem_extend)
+                mem_len[mem_nseq - 1] += elmt_size;
+            else {
+                mem_off[mem_nseq] = pnt[w].mem_off;
+                mem_len[mem_nseq++] = elmt_size;
+            } /* end else */
+            w++;
+        } /* end while */
+
+        /* Perform I/O on memory and file sequences */
+        if(io_info->op_type == H5D_IO_OP_READ) {
+            if((tmp_file_len = (*io_info->layout_ops.readvv)(io_info,
+                    file_nseq, &curr_file_seq, file_len, file_off,
+                    mem_nseq, &curr_mem_seq, mem_len, mem_off)) < 0)
+                HGOTO_ERROR(H5E_DATASPACE, H5E_READERROR, FAIL, "read error")
+        } /* end if */
+        else {
+            HDassert(io_info->op_type == H5D_IO_OP_WRITE);
+            if((tmp_file_len = (*io_info->layout_ops.writevv)(io_info,
+                    file_nseq, &curr_file_seq, file_len, file_off,
+                    mem_nseq, &curr_mem_seq, mem_len, mem_off)) < 0)
+                HGOTO_ERROR(H5E_DATASPACE, H5E_WRITEERROR, FAIL, "write error")
+        } /* end else */
+
+        /* Both lists describe the same elements, so both are used up */
+        HDassert(curr_file_seq == file_nseq);
+        HDassert(curr_mem_seq == mem_nseq);
+    } /* end for */
+
+done:
+    /* Release selection iterator */
+    if(iter_init)
+        if(H5S_SELECT_ITER_RELEASE(&iter) < 0)
+            HDONE_ERROR(H5E_DATASPACE, H5E_CANTRELEASE, FAIL, "unable to release selection iterator")
+
+    pnt = (H5D_select_pnt_t *)H5MM_xfree(pnt);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__select_io_points() */
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5D__select_read
@@ -273,14 +496,83 @@ H5D__select_read(const H5D_io_info_t *io_info, const H5D_type_info_t *type_info,
 
     /* Call generic selection operation */
     H5_CHECK_OVERFLOW(nelmts, hsize_t, size_t);
-    if(H5D__select_io(io_info, type_info->src_type_size, (size_t)nelmts,
-            file_space, mem_space) < 0)
+    if(H5D__select_io(io_info, type_info->src_type_size, type_info->src_type_size,
+            (size_t)nelmts, file_space, mem_space) < 0)
         HGOTO_ERROR(H5E_DATASPACE, H5E_READERROR, FAIL, "read error")
 
 done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5D__select_read() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__select_read_inplace
+ *
+ * Purpose:	Reads directly from file into application memory, then
+ *		converts the elements in place in the application's buffer,
+ *		one contiguous run of the memory selection at a time.
+ *		The destination datatype must be at least as large as the
+ *		source datatype and need no background buffer.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5D__select_read_inplace(const H5D_io_info_t *io_info, const H5D_type_info_t *type_info,
+    hsize_t nelmts, const H5S_t *file_space, const H5S_t *mem_space)
+{
+    H5S_sel_iter_t mem_iter;    /* Memory selection iteration info */
+    hbool_t mem_iter_init = FALSE;      /* Memory selection iteration info has been initialized */
+    hsize_t mem_off[H5D_IO_VECTOR_SIZE];        /* Sequence offsets in memory */
+    size_t mem_len[H5D_IO_VECTOR_SIZE];         /* Sequence lengths in memory */
+    uint8_t *buf = (uint8_t *)io_info->u.rbuf;  /* Application buffer */
+    size_t nleft;               /* Number of elements left to convert */
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    /* Sanity check */
+    HDassert(type_info->is_conv_inplace);
+    HDassert(type_info->dst_type_size >= type_info->src_type_size);
+
+    /* Read the file elements into the memory selection, packed at the
+     * start of each contiguous run */
+    H5_CHECKED_ASSIGN(nleft, size_t, nelmts, hsize_t);
+    if(H5D__select_io(io_info, type_info->src_type_size, type_info->dst_type_size,
+            nleft, file_space, mem_space) < 0)
+        HGOTO_ERROR(H5E_DATASPACE, H5E_READERROR, FAIL, "read error")
+
+    /* Convert each run of the memory selection in place */
+    if(H5S_select_iter_init(&mem_iter, mem_space, type_info->dst_type_size) < 0)
+        HGOTO_ERROR(H5E_DATASPACE, H5E_CANTINIT, FAIL, "unable to initialize selection iterator")
+    mem_iter_init = TRUE;
+    while(nleft > 0) {
+        size_t mem_nseq;        /* Number of sequences generated */
+        size_t mem_nelem;       /* Number of elements in sequences */
+        size_t u;               /* Local index variable */
+
+        if(H5S_SELECT_GET_SEQ_LIST(mem_space, 0, &mem_iter, (size_t)H5D_IO_VECTOR_SIZE, nleft, &mem_nseq, &mem_nelem, mem_off, mem_len) < 0)
+            HGOTO_ERROR(H5E_INTERNAL, H5E_UNSUPPORTED, FAIL, "sequence length generation failed")
+
+        for(u = 0; u < mem_nseq; u++)
+            if(H5T_convert(type_info->tpath, type_info->src_type_id, type_info->dst_type_id,
+                    mem_len[u] / type_info->dst_type_size, (size_t)0, (size_t)0,
+                    buf + mem_off[u], NULL, io_info->md_dxpl_id) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTCONVERT, FAIL, "datatype conversion failed")
+
+        nleft -= mem_nelem;
+    } /* end while */
+
+done:
+    /* Release memory selection iterator */
+    if(mem_iter_init)
+        if(H5S_SELECT_ITER_RELEASE(&mem_iter) < 0)
+            HDONE_ERROR(H5E_DATASPACE, H5E_CANTRELEASE, FAIL, "unable to release selection iterator")
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__select_read_inplace() */
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5D__select_write
@@ -304,8 +596,8 @@ H5D__select_write(const H5D_io_info_t *io_info, const H5D_type_info_t *type_info
 
     /* Call generic selection operation */
     H5_CHECK_OVERFLOW(nelmts, hsize_t, size_t);
-    if(H5D__select_io(io_info, type_info->dst_type_size, (size_t)nelmts,
-            file_space, mem_space) < 0)
+    if(H5D__select_io(io_info, type_info->dst_type_size, type_info->dst_type_size,
+            (size_t)nelmts, file_space, mem_space) < 0)
         HGOTO_ERROR(H5E_DATASPACE, H5E_WRITEERROR, FAIL, "write error")
 
 done:
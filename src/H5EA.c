@@ -88,6 +88,8 @@ hbool_t H5_PKG_INIT_VAR = FALSE;
  * client class..
  */
 const H5EA_class_t *const H5EA_client_class_g[] = {
+    H5EA_CLS_CHUNK,		/* 0 - H5EA_CLS_CHUNK_ID 		*/
+    H5EA_CLS_FILT_CHUNK,	/* 1 - H5EA_CLS_FILT_CHUNK_ID 		*/
     H5EA_CLS_TEST,		/* ? - H5EA_CLS_TEST_ID			*/
 };
 
@@ -104,6 +106,9 @@ const H5EA_class_t *const H5EA_client_class_g[] = {
 /* Declare a free list to manage the H5EA_t struct */
 H5FL_DEFINE_STATIC(H5EA_t);
 
+/* Declare a PQ free list to manage the element */
+H5FL_BLK_DEFINE_STATIC(ea_native_elmt);
+
 
 
 /*-------------------------------------------------------------------------
@@ -789,6 +794,62 @@ CATCH
 
 END_FUNC(PRIV)  /* end H5EA_get() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:    H5EA_iterate
+ *
+ * Purpose:     Iterate over the elements of an extensible array, up to the
+ *              highest element index that has been set.
+ *
+ * Note:        This is not very efficient, we should be iterating directly
+ *              over the extensible array's data blocks [and pages].
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+BEGIN_FUNC(PRIV, ERR,
+herr_t, SUCCEED, FAIL,
+H5EA_iterate(H5EA_t *ea, hid_t dxpl_id, H5EA_operator_t op, void *udata))
+
+    /* Local variables */
+    uint8_t     *elmt = NULL;
+    hsize_t     u;
+
+    /*
+     * Check arguments.
+     */
+    HDassert(ea);
+    HDassert(op);
+    HDassert(udata);
+
+    /* Allocate space for a native array element */
+    if(NULL == (elmt = H5FL_BLK_MALLOC(ea_native_elmt, ea->hdr->cparam.cls->nat_elmt_size)))
+        H5E_THROW(H5E_CANTALLOC, "memory allocation failed for extensible array element")
+
+    /* Iterate over all elements in array */
+    for(u = 0; u < ea->hdr->stats.stored.max_idx_set; u++) {
+        int cb_ret;     /* Return value from callback */
+
+        /* Get array element */
+        if(H5EA_get(ea, dxpl_id, u, elmt) < 0)
+            H5E_THROW(H5E_CANTGET, "unable to get extensible array element")
+
+        /* Make callback */
+        if((cb_ret = (*op)(u, elmt, udata)) != H5_ITER_CONT) {
+            if(cb_ret < 0)
+                H5E_PRINTF(H5E_BADITER, "iterator function failed");
+            H5_LEAVE(cb_ret)
+        } /* end if */
+    } /* end for */
+
+CATCH
+
+    if(elmt)
+        elmt = H5FL_BLK_FREE(ea_native_elmt, elmt);
+
+END_FUNC(PRIV)  /* end H5EA_iterate() */
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5EA_depend
@@ -1142,3 +1203,33 @@ CATCH
 
 END_FUNC(PRIV)  /* end H5EA_delete() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5EA_patch_file
+ *
+ * Purpose:	Patch the top-level file pointer contained in ea
+ *              to point to the given file, if they are different.
+ *              This is possible because the file pointer in ea can be
+ *              closed out if ea remains open.
+ *
+ * Return:	SUCCEED
+ *
+ *-------------------------------------------------------------------------
+ */
+BEGIN_FUNC(PRIV, NOERR,
+herr_t, SUCCEED, -,
+H5EA_patch_file(H5EA_t *ea, H5F_t *f))
+
+    /* Local variables */
+
+    /*
+     * Check arguments.
+     */
+    HDassert(ea);
+    HDassert(f);
+
+    if(ea->f != f || ea->hdr->f != f)
+        ea->f = ea->hdr->f = f;
+
+END_FUNC(PRIV)  /* end H5EA_patch_file() */
+
@@ -457,9 +457,9 @@ H5Fcreate(const char *filename, unsigned flags, hid_t fcpl_id, hid_t fapl_id)
     if(!filename || !*filename)
         HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "invalid file name")
     /* In this routine, we only accept the following flags:
-     *          H5F_ACC_EXCL and H5F_ACC_TRUNC
+     *          H5F_ACC_EXCL, H5F_ACC_TRUNC and H5F_ACC_SWMR_WRITE
      */
-    if(flags & ~(H5F_ACC_EXCL | H5F_ACC_TRUNC))
+    if(flags & ~(H5F_ACC_EXCL | H5F_ACC_TRUNC | H5F_ACC_SWMR_WRITE))
         HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "invalid flags")
     /* The H5F_ACC_EXCL and H5F_ACC_TRUNC flags are mutually exclusive */
     if((flags & H5F_ACC_EXCL) && (flags & H5F_ACC_TRUNC))
@@ -564,6 +564,12 @@ H5Fopen(const char *filename, unsigned flags, hid_t fapl_id)
     if((flags & ~H5F_ACC_PUBLIC_FLAGS) ||
             (flags & H5F_ACC_TRUNC) || (flags & H5F_ACC_EXCL))
 	HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "invalid file open flags")
+    /* Asking for SWMR write access on a read-only file is invalid */
+    if((flags & H5F_ACC_SWMR_WRITE) && 0 == (flags & H5F_ACC_RDWR))
+        HGOTO_ERROR(H5E_FILE, H5E_CANTOPENFILE, FAIL, "SWMR write access on a file open for read-only access is not allowed")
+    /* Asking for SWMR read access on a non-read-only file is invalid */
+    if((flags & H5F_ACC_SWMR_READ) && (flags & H5F_ACC_RDWR))
+        HGOTO_ERROR(H5E_FILE, H5E_CANTOPENFILE, FAIL, "SWMR read access on a file open for read-write access is not allowed")
 
     /* Verify access property list and get correct dxpl */
     if(H5P_verify_apl_and_dxpl(&fapl_id, H5P_CLS_FACC, &dxpl_id, H5I_INVALID_HID, TRUE) < 0)
@@ -856,12 +862,13 @@ H5Fget_intent(hid_t file_id, unsigned *intent_flags)
 
         /* HDF5 uses some flags internally that users don't know about.
          * Simplify things for them so that they only get either H5F_ACC_RDWR
-         * or H5F_ACC_RDONLY.
+         * or H5F_ACC_RDONLY, along with any SWMR access flag.
          */
         if(H5F_INTENT(file) & H5F_ACC_RDWR)
             *intent_flags = H5F_ACC_RDWR;
         else
             *intent_flags = H5F_ACC_RDONLY;
+        *intent_flags |= H5F_INTENT(file) & (H5F_ACC_SWMR_WRITE | H5F_ACC_SWMR_READ);
     } /* end if */
 
 done:
@@ -1227,6 +1234,97 @@ done:
     FUNC_LEAVE_API(ret_value)
 } /* H5Freset_mdc_hit_rate_stats() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:    H5Fget_page_buffering_stats
+ *
+ * Purpose:     Retrieve the statistics for the file's page buffer.  Each
+ *		array has two elements: element 0 counts metadata pages and
+ *		element 1 counts raw data pages.
+ *
+ *		ACCESSES is the number of page accesses, HITS the number
+ *		found in the page buffer, MISSES the number that loaded a
+ *		page, EVICTIONS the number of pages evicted to make room,
+ *		and BYPASSES the number of accesses that went directly to
+ *		the file.  Any of the arrays may be NULL.
+ *
+ * Return:      Success:        SUCCEED
+ *              Failure:        FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Fget_page_buffering_stats(hid_t file_id, unsigned accesses[2], unsigned hits[2],
+    unsigned misses[2], unsigned evictions[2], unsigned bypasses[2])
+{
+    H5F_t      *file;                   /* File object for file ID */
+    H5F_page_buf_t *pb;                 /* Page buffer */
+    herr_t     ret_value = SUCCEED;     /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE6("e", "i*Iu*Iu*Iu*Iu*Iu", file_id, accesses, hits, misses, evictions,
+             bypasses);
+
+    /* Check args */
+    if(NULL == (file = (H5F_t *)H5I_object_verify(file_id, H5I_FILE)))
+         HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "not a file ID")
+    if(NULL == (pb = file->shared->page_buf))
+         HGOTO_ERROR(H5E_FILE, H5E_BADVALUE, FAIL, "page buffering not enabled on file")
+
+    /* Retrieve the statistics */
+    if(accesses)
+        HDmemcpy(accesses, pb->accesses, sizeof(pb->accesses));
+    if(hits)
+        HDmemcpy(hits, pb->hits, sizeof(pb->hits));
+    if(misses)
+        HDmemcpy(misses, pb->misses, sizeof(pb->misses));
+    if(evictions)
+        HDmemcpy(evictions, pb->evictions, sizeof(pb->evictions));
+    if(bypasses)
+        HDmemcpy(bypasses, pb->bypasses, sizeof(pb->bypasses));
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* H5Fget_page_buffering_stats() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5Freset_page_buffering_stats
+ *
+ * Purpose:     Reset the statistics for the file's page buffer.
+ *
+ * Return:      Success:        SUCCEED
+ *              Failure:        FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Freset_page_buffering_stats(hid_t file_id)
+{
+    H5F_t      *file;                   /* File object for file ID */
+    H5F_page_buf_t *pb;                 /* Page buffer */
+    herr_t     ret_value = SUCCEED;     /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE1("e", "i", file_id);
+
+    /* Check args */
+    if(NULL == (file = (H5F_t *)H5I_object_verify(file_id, H5I_FILE)))
+         HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "not a file ID")
+    if(NULL == (pb = file->shared->page_buf))
+         HGOTO_ERROR(H5E_FILE, H5E_BADVALUE, FAIL, "page buffering not enabled on file")
+
+    /* Reset the statistics */
+    HDmemset(pb->accesses, 0, sizeof(pb->accesses));
+    HDmemset(pb->hits, 0, sizeof(pb->hits));
+    HDmemset(pb->misses, 0, sizeof(pb->misses));
+    HDmemset(pb->evictions, 0, sizeof(pb->evictions));
+    HDmemset(pb->bypasses, 0, sizeof(pb->bypasses));
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* H5Freset_page_buffering_stats() */
+
 
 /*-------------------------------------------------------------------------
  * Function:    H5Fget_name
@@ -79,6 +79,8 @@ hbool_t H5_PKG_INIT_VAR = FALSE;
  * client class..
  */
 const H5FA_class_t *const H5FA_client_class_g[] = {
+    H5FA_CLS_CHUNK,		/* 0 - H5FA_CLS_CHUNK_ID 		*/
+    H5FA_CLS_FILT_CHUNK,	/* 1 - H5FA_CLS_FILT_CHUNK_ID 		*/
     H5FA_CLS_TEST,		/* ? - H5FA_CLS_TEST_ID 		*/
 };
 
@@ -726,8 +728,9 @@ H5FA_iterate(H5FA_t *fa, hid_t dxpl_id, H5FA_operator_t op, void *udata))
             H5E_THROW(H5E_CANTGET, "unable to delete fixed array")
 
         /* Make callback */
-        if((cb_ret = (*op)(u, elmt, udata)) < 0) {
-            H5E_PRINTF(H5E_BADITER, "iterator function failed");
+        if((cb_ret = (*op)(u, elmt, udata)) != H5_ITER_CONT) {
+            if(cb_ret < 0)
+                H5E_PRINTF(H5E_BADITER, "iterator function failed");
             H5_LEAVE(cb_ret)
         } /* end if */
     } /* end for */
@@ -739,3 +742,33 @@ CATCH
 
 END_FUNC(PRIV)  /* end H5FA_iterate() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5FA_patch_file
+ *
+ * Purpose:	Patch the top-level file pointer contained in fa
+ *              to point to the given file, if they are different.
+ *              This is possible because the file pointer in fa can be
+ *              closed out if fa remains open.
+ *
+ * Return:	SUCCEED
+ *
+ *-------------------------------------------------------------------------
+ */
+BEGIN_FUNC(PRIV, NOERR,
+herr_t, SUCCEED, -,
+H5FA_patch_file(H5FA_t *fa, H5F_t *f))
+
+    /* Local variables */
+
+    /*
+     * Check arguments.
+     */
+    HDassert(fa);
+    HDassert(f);
+
+    if(fa->f != f || fa->hdr->f != f)
+        fa->f = fa->hdr->f = f;
+
+END_FUNC(PRIV)  /* end H5FA_patch_file() */
+
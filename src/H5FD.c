@@ -1587,6 +1587,139 @@ done:
     FUNC_LEAVE_API(ret_value)
 } /* end H5FDwrite() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5FDreadv
+ *
+ * Purpose:	Reads COUNT extents from FILE according to the data transfer
+ *		property list DXPL_ID (which may be the constant H5P_DEFAULT).
+ *		Extent U starts at address ADDRS[U], is SIZES[U] bytes long
+ *		and is stored in BUFS[U].  Drivers with a vector callback
+ *		handle the whole list in one request.
+ *
+ * Return:	Success:	Non-negative
+ *
+ *		Failure:	Negative. The contents of
+ *				the buffers are undefined.
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5FDreadv(H5FD_t *file, H5FD_mem_t type, hid_t dxpl_id, size_t count,
+    const haddr_t addrs[], const size_t sizes[], void *bufs[]/*out*/)
+{
+    H5P_genplist_t *dxpl;               /* DXPL object */
+    haddr_t     *rel_addrs = NULL;      /* Addresses relative to the base address */
+    size_t      u;                      /* Local index variable */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE7("e", "*xMtiz*a*zx", file, type, dxpl_id, count, addrs, sizes, bufs);
+
+    /* Check args */
+    if(!file || !file->cls)
+	HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "invalid file pointer")
+
+    /* Get the default dataset transfer property list if the user didn't provide one */
+    if(H5P_DEFAULT == dxpl_id)
+        dxpl_id = H5P_DATASET_XFER_DEFAULT;
+    else
+        if(TRUE != H5P_isa_class(dxpl_id, H5P_DATASET_XFER))
+            HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a data transfer property list")
+    if(count > 0 && (!addrs || !sizes || !bufs))
+	HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "null address, size or buffer list")
+    for(u = 0; u < count; u++)
+        if(!bufs[u])
+            HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "null buffer in list")
+
+    /* Get the DXPL plist object for DXPL ID */
+    if(NULL == (dxpl = (H5P_genplist_t *)H5I_object(dxpl_id)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "can't get property list")
+
+    /* Compensate for base address addition in internal routine */
+    if(count > 0 && file->base_addr > 0) {
+        if(NULL == (rel_addrs = (haddr_t *)H5MM_malloc(count * sizeof(haddr_t))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for address list")
+        for(u = 0; u < count; u++)
+            rel_addrs[u] = addrs[u] - file->base_addr;
+    } /* end if */
+
+    /* Do the real work */
+    if(H5FD_readv(file, dxpl, type, count, (rel_addrs ? rel_addrs : addrs), sizes, bufs) < 0)
+	HGOTO_ERROR(H5E_VFL, H5E_READERROR, FAIL, "file read request failed")
+
+done:
+    rel_addrs = (haddr_t *)H5MM_xfree(rel_addrs);
+
+    FUNC_LEAVE_API(ret_value)
+} /* end H5FDreadv() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5FDwritev
+ *
+ * Purpose:	Writes COUNT extents to FILE according to the data transfer
+ *		property list DXPL_ID (which may be the constant H5P_DEFAULT).
+ *		Extent U starts at address ADDRS[U], is SIZES[U] bytes long
+ *		and is taken from BUFS[U].  Drivers with a vector callback
+ *		handle the whole list in one request.
+ *
+ * Return:	Success:	Non-negative
+ *
+ *		Failure:	Negative
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5FDwritev(H5FD_t *file, H5FD_mem_t type, hid_t dxpl_id, size_t count,
+    const haddr_t addrs[], const size_t sizes[], const void *bufs[])
+{
+    H5P_genplist_t *dxpl;               /* DXPL object */
+    haddr_t     *rel_addrs = NULL;      /* Addresses relative to the base address */
+    size_t      u;                      /* Local index variable */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE7("e", "*xMtiz*a*z**x", file, type, dxpl_id, count, addrs, sizes, bufs);
+
+    /* Check args */
+    if(!file || !file->cls)
+	HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "invalid file pointer")
+
+    /* Get the default dataset transfer property list if the user didn't provide one */
+    if(H5P_DEFAULT == dxpl_id)
+        dxpl_id = H5P_DATASET_XFER_DEFAULT;
+    else
+        if(TRUE != H5P_isa_class(dxpl_id, H5P_DATASET_XFER))
+            HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a data transfer property list")
+    if(count > 0 && (!addrs || !sizes || !bufs))
+	HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "null address, size or buffer list")
+    for(u = 0; u < count; u++)
+        if(!bufs[u])
+            HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "null buffer in list")
+
+    /* Get the DXPL plist object for DXPL ID */
+    if(NULL == (dxpl = (H5P_genplist_t *)H5I_object(dxpl_id)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "can't get property list")
+
+    /* Compensate for base address addition in internal routine */
+    if(count > 0 && file->base_addr > 0) {
+        if(NULL == (rel_addrs = (haddr_t *)H5MM_malloc(count * sizeof(haddr_t))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for address list")
+        for(u = 0; u < count; u++)
+            rel_addrs[u] = addrs[u] - file->base_addr;
+    } /* end if */
+
+    /* Do the real work */
+    if(H5FD_writev(file, dxpl, type, count, (rel_addrs ? rel_addrs : addrs), sizes, bufs) < 0)
+	HGOTO_ERROR(H5E_VFL, H5E_WRITEERROR, FAIL, "file write request failed")
+
+done:
+    rel_addrs = (haddr_t *)H5MM_xfree(rel_addrs);
+
+    FUNC_LEAVE_API(ret_value)
+} /* end H5FDwritev() */
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5FDflush
@@ -2004,3 +2137,30 @@ H5FD_get_base_addr(const H5FD_t *file)
     FUNC_LEAVE_NOAPI(file->base_addr)
 } /* end H5FD_get_base_addr() */
 
+
+/*--------------------------------------------------------------------------
+ * Function:    H5FD_set_alignment
+ *
+ * Purpose:     Set the alignment and alignment threshold used for new
+ *              allocations from the file.  (Overrides the values from the
+ *              file access property list, e.g. for paged aggregation)
+ *
+ * Return:      Non-negative if succeed; negative if fails.
+ *
+ *--------------------------------------------------------------------------
+ */
+herr_t
+H5FD_set_alignment(H5FD_t *file, hsize_t alignment, hsize_t threshold)
+{
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    HDassert(file);
+    HDassert(alignment > 0);
+
+    /* Set the file's alignment parameters */
+    file->alignment = alignment;
+    file->threshold = threshold;
+
+    FUNC_LEAVE_NOAPI(SUCCEED)
+} /* end H5FD_set_alignment() */
+
@@ -39,6 +39,7 @@
 #include "H5Fprivate.h"         /* File access				*/
 #include "H5FDpkg.h"		/* File Drivers				*/
 #include "H5Iprivate.h"		/* IDs			  		*/
+#include "H5MMprivate.h"	/* Memory management			*/
 
 
 /****************/
@@ -50,6 +51,15 @@
 /* Local Typedefs */
 /******************/
 
+#ifdef H5_HAVE_THREADSAFE
+/* States of the API lock around a driver read, see H5FD_api_lock_allow_release() */
+typedef enum H5FD_api_lock_state_t {
+    H5FD_API_LOCK_HELD,                 /* Lock must stay held */
+    H5FD_API_LOCK_RELEASABLE,           /* Next driver read may release the lock */
+    H5FD_API_LOCK_WAS_RELEASED          /* A driver read released & retook the lock */
+} H5FD_api_lock_state_t;
+#endif /* H5_HAVE_THREADSAFE */
+
 
 /********************/
 /* Package Typedefs */
@@ -75,6 +85,12 @@
 /* Local Variables */
 /*******************/
 
+#ifdef H5_HAVE_THREADSAFE
+/* State of the API lock for the driver read in progress.  Only changed by
+ * the thread holding the API lock. */
+static H5FD_api_lock_state_t H5FD_api_lock_state_g = H5FD_API_LOCK_HELD;
+#endif /* H5_HAVE_THREADSAFE */
+
 
 
 /*-------------------------------------------------------------------------
@@ -279,6 +295,142 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5FD_write() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5FD_readv
+ *
+ * Purpose:	Private version of H5FDreadv().  Reads COUNT extents in
+ *		one driver call when the driver has a readv callback, and
+ *		falls back to one H5FD_read() call per extent otherwise.
+ *		The addresses are relative to the base address for the file.
+ *
+ * Return:	Success:	Non-negative
+ *		Failure:	Negative
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5FD_readv(H5FD_t *file, const H5P_genplist_t *dxpl, H5FD_mem_t type,
+    size_t count, const haddr_t addrs[], const size_t sizes[], void *bufs[]/*out*/)
+{
+    haddr_t     *abs_addrs = NULL;      /* Absolute addresses passed to the driver */
+    haddr_t     eoa = HADDR_UNDEF;
+    size_t      u;                      /* Local index variable */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    HDassert(file && file->cls);
+    HDassert(TRUE == H5P_class_isa(H5P_CLASS(dxpl), H5P_CLS_DATASET_XFER_g));
+    HDassert(0 == count || (addrs && sizes && bufs));
+
+    /* The no-op case */
+    if(0 == count)
+        HGOTO_DONE(SUCCEED)
+
+    /* Drivers without a vector callback get one call per extent */
+    if(NULL == file->cls->readv) {
+        for(u = 0; u < count; u++)
+            if(H5FD_read(file, dxpl, type, addrs[u], sizes[u], bufs[u]) < 0)
+                HGOTO_ERROR(H5E_VFL, H5E_READERROR, FAIL, "driver read request failed")
+        HGOTO_DONE(SUCCEED)
+    } /* end if */
+
+    if(HADDR_UNDEF == (eoa = (file->cls->get_eoa)(file, type)))
+	HGOTO_ERROR(H5E_VFL, H5E_CANTINIT, FAIL, "driver get_eoa request failed")
+    for(u = 0; u < count; u++) {
+        HDassert(bufs[u]);
+        if((addrs[u] + file->base_addr + sizes[u]) > eoa)
+            HGOTO_ERROR(H5E_ARGS, H5E_OVERFLOW, FAIL, "addr overflow, addr = %llu, size=%llu, eoa=%llu", 
+                        (unsigned long long)(addrs[u] + file->base_addr), (unsigned long long)sizes[u], (unsigned long long)eoa)
+    } /* end for */
+
+    /* Compensate for the base address, if there is one */
+    if(file->base_addr > 0) {
+        if(NULL == (abs_addrs = (haddr_t *)H5MM_malloc(count * sizeof(haddr_t))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for address list")
+        for(u = 0; u < count; u++)
+            abs_addrs[u] = addrs[u] + file->base_addr;
+    } /* end if */
+
+    /* Dispatch to driver */
+    if((file->cls->readv)(file, type, H5P_PLIST_ID(dxpl), count, (abs_addrs ? abs_addrs : addrs), sizes, bufs) < 0)
+        HGOTO_ERROR(H5E_VFL, H5E_READERROR, FAIL, "driver readv request failed")
+
+done:
+    abs_addrs = (haddr_t *)H5MM_xfree(abs_addrs);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_readv() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5FD_writev
+ *
+ * Purpose:	Private version of H5FDwritev().  Writes COUNT extents in
+ *		one driver call when the driver has a writev callback, and
+ *		falls back to one H5FD_write() call per extent otherwise.
+ *		The addresses are relative to the base address for the file.
+ *
+ * Return:	Success:	Non-negative
+ *		Failure:	Negative
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5FD_writev(H5FD_t *file, const H5P_genplist_t *dxpl, H5FD_mem_t type,
+    size_t count, const haddr_t addrs[], const size_t sizes[], const void *bufs[])
+{
+    haddr_t     *abs_addrs = NULL;      /* Absolute addresses passed to the driver */
+    haddr_t     eoa = HADDR_UNDEF;
+    size_t      u;                      /* Local index variable */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    HDassert(file && file->cls);
+    HDassert(TRUE == H5P_class_isa(H5P_CLASS(dxpl), H5P_CLS_DATASET_XFER_g));
+    HDassert(0 == count || (addrs && sizes && bufs));
+
+    /* The no-op case */
+    if(0 == count)
+        HGOTO_DONE(SUCCEED)
+
+    /* Drivers without a vector callback get one call per extent */
+    if(NULL == file->cls->writev) {
+        for(u = 0; u < count; u++)
+            if(H5FD_write(file, dxpl, type, addrs[u], sizes[u], bufs[u]) < 0)
+                HGOTO_ERROR(H5E_VFL, H5E_WRITEERROR, FAIL, "driver write request failed")
+        HGOTO_DONE(SUCCEED)
+    } /* end if */
+
+    if(HADDR_UNDEF == (eoa = (file->cls->get_eoa)(file, type)))
+	HGOTO_ERROR(H5E_VFL, H5E_CANTINIT, FAIL, "driver get_eoa request failed")
+    for(u = 0; u < count; u++) {
+        HDassert(bufs[u]);
+        if((addrs[u] + file->base_addr + sizes[u]) > eoa)
+            HGOTO_ERROR(H5E_ARGS, H5E_OVERFLOW, FAIL, "addr overflow, addr = %llu, size=%llu, eoa=%llu", 
+                        (unsigned long long)(addrs[u] + file->base_addr), (unsigned long long)sizes[u], (unsigned long long)eoa)
+    } /* end for */
+
+    /* Compensate for the base address, if there is one */
+    if(file->base_addr > 0) {
+        if(NULL == (abs_addrs = (haddr_t *)H5MM_malloc(count * sizeof(haddr_t))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for address list")
+        for(u = 0; u < count; u++)
+            abs_addrs[u] = addrs[u] + file->base_addr;
+    } /* end if */
+
+    /* Dispatch to driver */
+    if((file->cls->writev)(file, type, H5P_PLIST_ID(dxpl), count, (abs_addrs ? abs_addrs : addrs), sizes, bufs) < 0)
+        HGOTO_ERROR(H5E_VFL, H5E_WRITEERROR, FAIL, "driver writev request failed")
+
+done:
+    abs_addrs = (haddr_t *)H5MM_xfree(abs_addrs);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_writev() */
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5FD_set_eoa
@@ -401,3 +553,109 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5FD_get_eof() */
 
+#ifdef H5_HAVE_THREADSAFE
+
+/*-------------------------------------------------------------------------
+ * Function:	H5FD_api_lock_allow_release
+ *
+ * Purpose:	Tells the file driver that the next read reaching it goes
+ *		into a buffer that no other thread can see (the application's
+ *		buffer, or one private to this I/O operation), so the driver
+ *		may let go of the API lock while it waits for the data.
+ *		Must be paired with H5FD_api_lock_disallow_release() once
+ *		the read returns.
+ *
+ * Return:	void
+ *
+ *-------------------------------------------------------------------------
+ */
+void
+H5FD_api_lock_allow_release(void)
+{
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    HDassert(H5FD_API_LOCK_HELD == H5FD_api_lock_state_g);
+
+    H5FD_api_lock_state_g = H5FD_API_LOCK_RELEASABLE;
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5FD_api_lock_allow_release() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5FD_api_lock_disallow_release
+ *
+ * Purpose:	Ends the window opened by H5FD_api_lock_allow_release().
+ *
+ * Return:	TRUE if the driver released the API lock during the read,
+ *		in which case other threads may have changed any library
+ *		state in the meantime, FALSE otherwise.
+ *
+ *-------------------------------------------------------------------------
+ */
+hbool_t
+H5FD_api_lock_disallow_release(void)
+{
+    hbool_t ret_value = FALSE;  /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    ret_value = (hbool_t)(H5FD_API_LOCK_WAS_RELEASED == H5FD_api_lock_state_g);
+    H5FD_api_lock_state_g = H5FD_API_LOCK_HELD;
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_api_lock_disallow_release() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5FD_api_lock_release
+ *
+ * Purpose:	Called by a file driver right before it blocks in a read
+ *		system call.  Releases the API lock if the library allowed
+ *		it for this read and the calling thread isn't inside a
+ *		nested API call.  Between this call and
+ *		H5FD_api_lock_reacquire() the driver must not call back
+ *		into the library at all, not even to report an error.
+ *
+ * Return:	TRUE if the lock was released, FALSE otherwise.
+ *
+ *-------------------------------------------------------------------------
+ */
+hbool_t
+H5FD_api_lock_release(void)
+{
+    hbool_t ret_value = FALSE;  /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    if(H5FD_API_LOCK_RELEASABLE == H5FD_api_lock_state_g) {
+        H5FD_api_lock_state_g = H5FD_API_LOCK_HELD;
+        if(H5TS_mutex_unlock_single(&H5_g.init_lock, &ret_value) != 0)
+            ret_value = FALSE;
+    } /* end if */
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_api_lock_release() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5FD_api_lock_reacquire
+ *
+ * Purpose:	Takes back the API lock released by H5FD_api_lock_release().
+ *
+ * Return:	void
+ *
+ *-------------------------------------------------------------------------
+ */
+void
+H5FD_api_lock_reacquire(void)
+{
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    H5TS_mutex_lock(&H5_g.init_lock);
+    H5FD_api_lock_state_g = H5FD_API_LOCK_WAS_RELEASED;
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5FD_api_lock_reacquire() */
+#endif /* H5_HAVE_THREADSAFE */
+
@@ -90,6 +90,13 @@ static herr_t H5FD_mpio_read(H5FD_t *_file, H5FD_mem_t type, hid_t dxpl_id, hadd
             size_t size, void *buf);
 static herr_t H5FD_mpio_write(H5FD_t *_file, H5FD_mem_t type, hid_t dxpl_id, haddr_t addr,
             size_t size, const void *buf);
+static herr_t H5FD_mpio_readv(H5FD_t *_file, H5FD_mem_t type, hid_t dxpl_id,
+            size_t count, const haddr_t addrs[], const size_t sizes[], void *bufs[]);
+static herr_t H5FD_mpio_writev(H5FD_t *_file, H5FD_mem_t type, hid_t dxpl_id,
+            size_t count, const haddr_t addrs[], const size_t sizes[], const void *bufs[]);
+static herr_t H5FD_mpio_vector_io(H5FD_mpio_t *file, H5FD_mem_t type, hid_t dxpl_id,
+            size_t count, const haddr_t addrs[], const size_t sizes[], void *bufs[],
+            hbool_t do_write);
 static herr_t H5FD_mpio_flush(H5FD_t *_file, hid_t dxpl_id, unsigned closing);
 static herr_t H5FD_mpio_truncate(H5FD_t *_file, hid_t dxpl_id, hbool_t closing);
 static int H5FD_mpio_mpi_rank(const H5FD_t *_file);
@@ -126,6 +133,8 @@ static const H5FD_class_mpi_t H5FD_mpio_g = {
     H5FD_mpio_get_handle,                       /*get_handle            */
     H5FD_mpio_read,				/*read			*/
     H5FD_mpio_write,				/*write			*/
+    H5FD_mpio_readv,                            /*readv                 */
+    H5FD_mpio_writev,                           /*writev                */
     H5FD_mpio_flush,				/*flush			*/
     H5FD_mpio_truncate,				/*truncate		*/
     NULL,                                       /*lock                  */
@@ -1850,6 +1859,257 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5FD_mpio_write() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5FD_mpio_vector_io
+ *
+ * Purpose:	Common code for H5FD_mpio_readv() and H5FD_mpio_writev().
+ *
+ *		Independent raw data transfers are grouped into runs of
+ *		extents that follow each other in the file.  Each run is
+ *		described by one MPI hindexed datatype over the caller's
+ *		buffers and moved with a single MPI_File_read_at() or
+ *		MPI_File_write_at() call.  (Describing the file side with a
+ *		derived type too would need MPI_File_set_view(), which is
+ *		collective.)  Collective transfers, metadata and extents
+ *		too large for an MPI count go through H5FD_mpio_read() and
+ *		H5FD_mpio_write() one extent at a time.
+ *
+ * Return:	Success:	Non-negative
+ *		Failure:	Negative
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_mpio_vector_io(H5FD_mpio_t *file, H5FD_mem_t type, hid_t dxpl_id,
+    size_t count, const haddr_t addrs[], const size_t sizes[], void *bufs[],
+    hbool_t do_write)
+{
+    H5P_genplist_t              *plist;         /* Property list pointer */
+    H5FD_mpio_xfer_t            xfer_mode;      /* I/O tranfer mode */
+    int                         *blocks = NULL; /* Block lengths for the memory type */
+    MPI_Aint                    *disps = NULL;  /* Block addresses for the memory type */
+    MPI_Datatype                mem_type = MPI_DATATYPE_NULL;   /* Memory type for one run */
+    MPI_Status  		mpi_stat;       /* Status from I/O operation */
+    int				mpi_code;	/* MPI return code */
+#if MPI_VERSION >= 3
+    MPI_Count         		bytes_moved;    /* Number of bytes transferred */
+#else
+    int                         bytes_moved;    /* Number of bytes transferred */
+#endif
+    hbool_t                     one_at_a_time = FALSE;  /* Whether to fall back to one extent per call */
+    size_t                      u;              /* Local index variable */
+    herr_t              	ret_value = SUCCEED;
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    HDassert(file);
+    HDassert(H5FD_MPIO == file->pub.driver_id);
+    HDassert(0 == count || (addrs && sizes && bufs));
+
+    /* Only independent raw data transfers are batched */
+    if(type != H5FD_MEM_DRAW)
+        one_at_a_time = TRUE;
+    else {
+        if(NULL == (plist = (H5P_genplist_t *)H5I_object(dxpl_id)))
+            HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a data transfer property list")
+        if(H5P_get(plist, H5D_XFER_IO_XFER_MODE_NAME, &xfer_mode) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get MPI-I/O transfer mode")
+        if(xfer_mode == H5FD_MPIO_COLLECTIVE)
+            one_at_a_time = TRUE;
+    } /* end else */
+    for(u = 0; u < count && !one_at_a_time; u++)
+        if(sizes[u] > (size_t)INT_MAX)
+            one_at_a_time = TRUE;
+
+    if(one_at_a_time) {
+        for(u = 0; u < count; u++) {
+            if(do_write) {
+                if(H5FD_mpio_write((H5FD_t *)file, type, dxpl_id, addrs[u], sizes[u], bufs[u]) < 0)
+                    HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "file write failed")
+            } /* end if */
+            else
+                if(H5FD_mpio_read((H5FD_t *)file, type, dxpl_id, addrs[u], sizes[u], bufs[u]) < 0)
+                    HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "file read failed")
+        } /* end for */
+        HGOTO_DONE(SUCCEED)
+    } /* end if */
+
+    /* Allocate the block descriptions */
+    if(NULL == (blocks = (int *)H5MM_malloc(count * sizeof(int))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "can't allocate block lengths")
+    if(NULL == (disps = (MPI_Aint *)H5MM_malloc(count * sizeof(MPI_Aint))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "can't allocate block addresses")
+
+    /* Portably initialize MPI status variable */
+    HDmemset(&mpi_stat, 0, sizeof(MPI_Status));
+
+    u = 0;
+    while(u < count) {
+        size_t      first = u;          /* First extent in this run */
+        haddr_t     pos = addrs[u];     /* End of the extents gathered so far */
+        MPI_Offset  mpi_off;            /* File offset of this run */
+        int         nblocks = 0;        /* # of blocks in the memory type */
+        int         run_size = 0;       /* # of bytes in this run */
+
+        if(H5FD_mpi_haddr_to_MPIOff(addrs[u], &mpi_off) < 0)
+            HGOTO_ERROR(H5E_INTERNAL, H5E_BADRANGE, FAIL, "can't convert from haddr to MPI off")
+
+        /* Gather the extents that are adjacent in the file */
+        do {
+            if(sizes[u] > 0) {
+                if(MPI_SUCCESS != (mpi_code = MPI_Get_address(bufs[u], &disps[nblocks])))
+                    HMPI_GOTO_ERROR(FAIL, "MPI_Get_address failed", mpi_code)
+                blocks[nblocks] = (int)sizes[u];
+                nblocks++;
+            } /* end if */
+            run_size += (int)sizes[u];
+            pos += sizes[u];
+            u++;
+        } while(u < count && addrs[u] == pos && sizes[u] <= (size_t)(INT_MAX - run_size));
+
+        if(0 == nblocks)
+            continue;
+
+        /* Build the memory type for the run */
+        if(MPI_SUCCESS != (mpi_code = MPI_Type_create_hindexed(nblocks, blocks, disps, MPI_BYTE, &mem_type)))
+            HMPI_GOTO_ERROR(FAIL, "MPI_Type_create_hindexed failed", mpi_code)
+        if(MPI_SUCCESS != (mpi_code = MPI_Type_commit(&mem_type)))
+            HMPI_GOTO_ERROR(FAIL, "MPI_Type_commit failed", mpi_code)
+
+#ifdef H5FDmpio_DEBUG
+        if(H5FD_mpio_Debug[(int)(do_write ? 'w' : 'r')])
+            fprintf(stdout, "in H5FD_mpio_vector_io  mpi_off=%ld  nblocks=%d  run_size=%d\n",
+                    (long)mpi_off, nblocks, run_size);
+#endif
+
+        /* Move the data */
+        if(do_write) {
+            if(MPI_SUCCESS != (mpi_code = MPI_File_write_at(file->f, mpi_off, MPI_BOTTOM, 1, mem_type, &mpi_stat)))
+                HMPI_GOTO_ERROR(FAIL, "MPI_File_write_at failed", mpi_code)
+        } /* end if */
+        else
+            if(MPI_SUCCESS != (mpi_code = MPI_File_read_at(file->f, mpi_off, MPI_BOTTOM, 1, mem_type, &mpi_stat)))
+                HMPI_GOTO_ERROR(FAIL, "MPI_File_read_at failed", mpi_code)
+
+        /* How many bytes were actually moved? */
+#if MPI_VERSION >= 3
+        if(MPI_SUCCESS != (mpi_code = MPI_Get_elements_x(&mpi_stat, MPI_BYTE, &bytes_moved)))
+#else
+        if(MPI_SUCCESS != (mpi_code = MPI_Get_elements(&mpi_stat, MPI_BYTE, &bytes_moved)))
+#endif
+            HMPI_GOTO_ERROR(FAIL, "MPI_Get_elements failed", mpi_code)
+
+        if(MPI_SUCCESS != (mpi_code = MPI_Type_free(&mem_type)))
+            HMPI_GOTO_ERROR(FAIL, "MPI_Type_free failed", mpi_code)
+        mem_type = MPI_DATATYPE_NULL;
+
+        if(do_write) {
+            /* Check for write failure */
+            if(bytes_moved != run_size)
+                HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "file write failed")
+
+            /* Track the local EOF, as in H5FD_mpio_write() */
+            file->eof = HADDR_UNDEF;
+            if(pos > file->local_eof)
+                file->local_eof = pos;
+        } /* end if */
+        else {
+            size_t  nread;      /* # of bytes left to account for */
+            size_t  v;          /* Local index variable */
+
+            /* Check for read failure */
+            if(bytes_moved < 0 || bytes_moved > run_size)
+                HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "file read failed")
+
+            /* This gives us zeroes beyond end of physical MPI file */
+            if(bytes_moved < run_size) {
+                nread = (size_t)bytes_moved;
+                for(v = first; v < u; v++) {
+                    size_t  got = MIN(sizes[v], nread);     /* # of bytes read into the extent */
+
+                    if(got < sizes[v])
+                        HDmemset((unsigned char *)bufs[v] + got, 0, sizes[v] - got);
+                    nread -= got;
+                } /* end for */
+            } /* end if */
+        } /* end else */
+    } /* end while */
+
+done:
+    if(MPI_DATATYPE_NULL != mem_type)
+        MPI_Type_free(&mem_type);
+    blocks = (int *)H5MM_xfree(blocks);
+    disps = (MPI_Aint *)H5MM_xfree(disps);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_mpio_vector_io() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5FD_mpio_readv
+ *
+ * Purpose:	Reads COUNT extents from FILE into the buffers in BUFS,
+ *		batching them as described in H5FD_mpio_vector_io().
+ *
+ * Return:	Success:	Non-negative
+ *		Failure:	Negative
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_mpio_readv(H5FD_t *_file, H5FD_mem_t type, hid_t dxpl_id, size_t count,
+    const haddr_t addrs[], const size_t sizes[], void *bufs[]/*out*/)
+{
+    herr_t      ret_value = SUCCEED;
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+#ifdef H5FDmpio_DEBUG
+    if(H5FD_mpio_Debug[(int)'t'])
+    	fprintf(stdout, "Entering H5FD_mpio_readv\n");
+#endif
+
+    if(H5FD_mpio_vector_io((H5FD_mpio_t *)_file, type, dxpl_id, count, addrs, sizes, bufs, FALSE) < 0)
+        HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "file vector read failed")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_mpio_readv() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5FD_mpio_writev
+ *
+ * Purpose:	Writes COUNT extents to FILE from the buffers in BUFS,
+ *		batching them as described in H5FD_mpio_vector_io().
+ *
+ * Return:	Success:	Non-negative
+ *		Failure:	Negative
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_mpio_writev(H5FD_t *_file, H5FD_mem_t type, hid_t dxpl_id, size_t count,
+    const haddr_t addrs[], const size_t sizes[], const void *bufs[])
+{
+    herr_t      ret_value = SUCCEED;
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+#ifdef H5FDmpio_DEBUG
+    if(H5FD_mpio_Debug[(int)'t'])
+    	fprintf(stdout, "Entering H5FD_mpio_writev\n");
+#endif
+
+    /* (Casting away const OK, the buffers are only read from) */
+    if(H5FD_mpio_vector_io((H5FD_mpio_t *)_file, type, dxpl_id, count, addrs, sizes, (void **)bufs, TRUE) < 0)
+        HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "file vector write failed")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_mpio_writev() */
+
 
 /*-------------------------------------------------------------------------
  * Function:    H5FD_mpio_flush
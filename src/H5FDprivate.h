@@ -158,6 +158,16 @@ H5_DLL herr_t H5FD_read(H5FD_t *file, const H5P_genplist_t *dxpl, H5FD_mem_t typ
     haddr_t addr, size_t size, void *buf/*out*/);
 H5_DLL herr_t H5FD_write(H5FD_t *file, const H5P_genplist_t *dxpl, H5FD_mem_t type,
     haddr_t addr, size_t size, const void *buf);
+H5_DLL herr_t H5FD_readv(H5FD_t *file, const H5P_genplist_t *dxpl, H5FD_mem_t type,
+    size_t count, const haddr_t addrs[], const size_t sizes[], void *bufs[]/*out*/);
+H5_DLL herr_t H5FD_writev(H5FD_t *file, const H5P_genplist_t *dxpl, H5FD_mem_t type,
+    size_t count, const haddr_t addrs[], const size_t sizes[], const void *bufs[]);
+#ifdef H5_HAVE_THREADSAFE
+H5_DLL void H5FD_api_lock_allow_release(void);
+H5_DLL hbool_t H5FD_api_lock_disallow_release(void);
+H5_DLL hbool_t H5FD_api_lock_release(void);
+H5_DLL void H5FD_api_lock_reacquire(void);
+#endif /* H5_HAVE_THREADSAFE */
 H5_DLL herr_t H5FD_flush(H5FD_t *file, hid_t dxpl_id, unsigned closing);
 H5_DLL herr_t H5FD_truncate(H5FD_t *file, hid_t dxpl_id, hbool_t closing);
 H5_DLL herr_t H5FD_lock(H5FD_t *file, hbool_t rw);
@@ -166,6 +176,7 @@ H5_DLL herr_t H5FD_get_fileno(const H5FD_t *file, unsigned long *filenum);
 H5_DLL herr_t H5FD_get_vfd_handle(H5FD_t *file, hid_t fapl, void** file_handle);
 H5_DLL herr_t H5FD_set_base_addr(H5FD_t *file, haddr_t base_addr);
 H5_DLL haddr_t H5FD_get_base_addr(const H5FD_t *file);
+H5_DLL herr_t H5FD_set_alignment(H5FD_t *file, hsize_t alignment, hsize_t threshold);
 
 /* Function prototypes for MPI based VFDs*/
 #ifdef H5_HAVE_PARALLEL
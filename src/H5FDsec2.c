@@ -38,6 +38,10 @@
 #include "H5MMprivate.h"    /* Memory management        */
 #include "H5Pprivate.h"     /* Property lists           */
 
+#if defined(H5_HAVE_PREADV) || defined(H5_HAVE_PWRITEV)
+#include <sys/uio.h>
+#endif /* defined(H5_HAVE_PREADV) || defined(H5_HAVE_PWRITEV) */
+
 /* The driver identification number, initialized at runtime */
 static hid_t H5FD_SEC2_g = 0;
 
@@ -98,6 +102,11 @@ typedef struct H5FD_sec2_t {
      */
     hbool_t         fam_to_sec2;
 
+    /* Whether the file was opened as a SWMR reader, in which case another
+     * process may extend the file and 'eof' must be re-queried.
+     */
+    hbool_t         swmr_read;
+
 } H5FD_sec2_t;
 
 /*
@@ -122,6 +131,20 @@ typedef struct H5FD_sec2_t {
                                  HADDR_UNDEF==(A)+(Z) ||                    \
                                 (HDoff_t)((A)+(Z))<(HDoff_t)(A))
 
+#if defined(H5_HAVE_PREADV) || defined(H5_HAVE_PWRITEV)
+/* Maximum number of I/O vectors passed to one preadv()/pwritev() call */
+#ifdef IOV_MAX
+#define H5FD_SEC2_IOV_MAX       IOV_MAX
+#else /* IOV_MAX */
+#define H5FD_SEC2_IOV_MAX       16
+#endif /* IOV_MAX */
+
+/* Largest hole between two extents that a vector read reads through
+ * (into a scratch buffer) rather than splitting the request.
+ */
+#define H5FD_SEC2_MAX_GAP       ((size_t)(64 * 1024))
+#endif /* defined(H5_HAVE_PREADV) || defined(H5_HAVE_PWRITEV) */
+
 /* Prototypes */
 static herr_t H5FD_sec2_term(void);
 static H5FD_t *H5FD_sec2_open(const char *name, unsigned flags, hid_t fapl_id,
@@ -137,6 +160,10 @@ static herr_t H5FD_sec2_read(H5FD_t *_file, H5FD_mem_t type, hid_t fapl_id, hadd
             size_t size, void *buf);
 static herr_t H5FD_sec2_write(H5FD_t *_file, H5FD_mem_t type, hid_t fapl_id, haddr_t addr,
             size_t size, const void *buf);
+static herr_t H5FD_sec2_readv(H5FD_t *_file, H5FD_mem_t type, hid_t dxpl_id,
+            size_t count, const haddr_t addrs[], const size_t sizes[], void *bufs[]);
+static herr_t H5FD_sec2_writev(H5FD_t *_file, H5FD_mem_t type, hid_t dxpl_id,
+            size_t count, const haddr_t addrs[], const size_t sizes[], const void *bufs[]);
 static herr_t H5FD_sec2_truncate(H5FD_t *_file, hid_t dxpl_id, hbool_t closing);
 static herr_t H5FD_sec2_lock(H5FD_t *_file, hbool_t rw);
 static herr_t H5FD_sec2_unlock(H5FD_t *_file);
@@ -169,6 +196,8 @@ static const H5FD_class_t H5FD_sec2_g = {
     H5FD_sec2_get_handle,       /* get_handle           */
     H5FD_sec2_read,             /* read                 */
     H5FD_sec2_write,            /* write                */
+    H5FD_sec2_readv,            /* readv                */
+    H5FD_sec2_writev,           /* writev               */
     NULL,                       /* flush                */
     H5FD_sec2_truncate,         /* truncate             */
     H5FD_sec2_lock,             /* lock                 */
@@ -359,6 +388,7 @@ H5FD_sec2_open(const char *name, unsigned flags, hid_t fapl_id, haddr_t maxaddr)
     H5_CHECKED_ASSIGN(file->eof, haddr_t, sb.st_size, h5_stat_size_t);
     file->pos = HADDR_UNDEF;
     file->op = OP_UNKNOWN;
+    file->swmr_read = (H5F_ACC_SWMR_READ & flags) ? TRUE : FALSE;
 #ifdef H5_HAVE_WIN32_API
     file->hFile = (HANDLE)_get_osfhandle(fd);
     if(INVALID_HANDLE_VALUE == file->hFile)
@@ -599,6 +629,9 @@ H5FD_sec2_set_eoa(H5FD_t *_file, H5FD_mem_t H5_ATTR_UNUSED type, haddr_t addr)
  *              either the filesystem end-of-file or the HDF5 end-of-address
  *              markers.
  *
+ *              For a SWMR reader the filesystem size is queried again,
+ *              since the writer may have extended the file.
+ *
  * Return:      End of file address, the first address past the end of the 
  *              "file", either the filesystem file or the HDF5 file.
  *
@@ -611,10 +644,18 @@ static haddr_t
 H5FD_sec2_get_eof(const H5FD_t *_file, H5FD_mem_t H5_ATTR_UNUSED type)
 {
     const H5FD_sec2_t   *file = (const H5FD_sec2_t *)_file;
+    haddr_t             ret_value = file->eof;  /* Return value */
 
     FUNC_ENTER_NOAPI_NOINIT_NOERR
 
-    FUNC_LEAVE_NOAPI(file->eof)
+    if(file->swmr_read) {
+        h5_stat_t       sb;
+
+        if(HDfstat(file->fd, &sb) == 0 && (haddr_t)sb.st_size > ret_value)
+            ret_value = (haddr_t)sb.st_size;
+    } /* end if */
+
+    FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5FD_sec2_get_eof() */
 
 
@@ -669,6 +710,9 @@ H5FD_sec2_read(H5FD_t *_file, H5FD_mem_t H5_ATTR_UNUSED type, hid_t H5_ATTR_UNUS
     haddr_t addr, size_t size, void *buf /*out*/)
 {
     H5FD_sec2_t     *file       = (H5FD_sec2_t *)_file;
+#if defined(H5_HAVE_THREADSAFE) && defined(H5_HAVE_PREAD)
+    hbool_t         api_lock_released = FALSE;          /* Whether the API lock was released for the read */
+#endif /* defined(H5_HAVE_THREADSAFE) && defined(H5_HAVE_PREAD) */
     herr_t          ret_value   = SUCCEED;                  /* Return value */
 
     FUNC_ENTER_NOAPI_NOINIT
@@ -682,11 +726,13 @@ H5FD_sec2_read(H5FD_t *_file, H5FD_mem_t H5_ATTR_UNUSED type, hid_t H5_ATTR_UNUS
     if(REGION_OVERFLOW(addr, size))
         HGOTO_ERROR(H5E_ARGS, H5E_OVERFLOW, FAIL, "addr overflow, addr = %llu", (unsigned long long)addr)
 
-    /* Seek to the correct location */
+#ifndef H5_HAVE_PREAD
+    /* Seek to the correct location (if we don't have pread) */
     if(addr != file->pos || OP_READ != file->op) {
         if(HDlseek(file->fd, (HDoff_t)addr, SEEK_SET) < 0)
             HSYS_GOTO_ERROR(H5E_IO, H5E_SEEKERROR, FAIL, "unable to seek to proper position")
     } /* end if */
+#endif /* H5_HAVE_PREAD */
 
     /* Read data, being careful of interrupted system calls, partial results,
      * and the end of the file.
@@ -704,14 +750,40 @@ H5FD_sec2_read(H5FD_t *_file, H5FD_mem_t H5_ATTR_UNUSED type, hid_t H5_ATTR_UNUS
         else
             bytes_in = (h5_posix_io_t)size;
 
+#ifdef H5_HAVE_PREAD
+#ifdef H5_HAVE_THREADSAFE
+        /* pread() shares no state with other callbacks on this file, so
+         * let other threads into the library while this one waits, if
+         * the library allowed it for this read */
+        api_lock_released = H5FD_api_lock_release();
+#endif /* H5_HAVE_THREADSAFE */
+        do {
+            bytes_read = HDpread(file->fd, buf, bytes_in, (HDoff_t)addr);
+        } while(-1 == bytes_read && EINTR == errno);
+#ifdef H5_HAVE_THREADSAFE
+        if(api_lock_released) {
+            int myerrno = errno;
+
+            /* Take the lock back before anything can report an error */
+            H5FD_api_lock_reacquire();
+            api_lock_released = FALSE;
+            errno = myerrno;
+        } /* end if */
+#endif /* H5_HAVE_THREADSAFE */
+#else /* H5_HAVE_PREAD */
         do {
             bytes_read = HDread(file->fd, buf, bytes_in);
         } while(-1 == bytes_read && EINTR == errno);
+#endif /* H5_HAVE_PREAD */
         
         if(-1 == bytes_read) { /* error */
             int myerrno = errno;
             time_t mytime = HDtime(NULL);
+#ifdef H5_HAVE_PREAD
+            HDoff_t myoffset = (HDoff_t)addr;
+#else /* H5_HAVE_PREAD */
             HDoff_t myoffset = HDlseek(file->fd, (HDoff_t)0, SEEK_CUR);
+#endif /* H5_HAVE_PREAD */
 
             HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "file read failed: time = %s, filename = '%s', file descriptor = %d, errno = %d, error message = '%s', buf = %p, total read size = %llu, bytes this sub-read = %llu, bytes actually read = %llu, offset = %llu", HDctime(&mytime), file->filename, file->fd, myerrno, HDstrerror(myerrno), buf, (unsigned long long)size, (unsigned long long)bytes_in, (unsigned long long)bytes_read, (unsigned long long)myoffset);
         } /* end if */
@@ -730,9 +802,11 @@ H5FD_sec2_read(H5FD_t *_file, H5FD_mem_t H5_ATTR_UNUSED type, hid_t H5_ATTR_UNUS
         buf = (char *)buf + bytes_read;
     } /* end while */
 
-    /* Update current position */
+#ifndef H5_HAVE_PREAD
+    /* Update current position (pread() doesn't move it) */
     file->pos = addr;
     file->op = OP_READ;
+#endif /* H5_HAVE_PREAD */
 
 done:
     if(ret_value < 0) {
@@ -835,6 +909,250 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5FD_sec2_write() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_sec2_readv
+ *
+ * Purpose:     Reads COUNT extents from FILE into the buffers in BUFS.
+ *              Extents that follow each other in the file, or that are
+ *              separated by holes of at most H5FD_SEC2_MAX_GAP bytes, are
+ *              read with a single preadv() call; the holes are read into
+ *              a scratch buffer and discarded.  Reading past the end of
+ *              the file yields zeros, as in H5FD_sec2_read().
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_sec2_readv(H5FD_t *_file, H5FD_mem_t H5_ATTR_UNUSED type, hid_t H5_ATTR_UNUSED dxpl_id,
+    size_t count, const haddr_t addrs[], const size_t sizes[], void *bufs[] /*out*/)
+{
+    H5FD_sec2_t     *file       = (H5FD_sec2_t *)_file;
+#ifdef H5_HAVE_PREADV
+    struct iovec    *iov        = NULL;     /* I/O vectors for one preadv() call */
+    unsigned char   *scratch    = NULL;     /* Destination for holes between extents */
+#endif /* H5_HAVE_PREADV */
+    size_t          u;                      /* Local index variable */
+    herr_t          ret_value   = SUCCEED;  /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    HDassert(file && file->pub.cls);
+    HDassert(0 == count || (addrs && sizes && bufs));
+
+#ifdef H5_HAVE_PREADV
+    if(NULL == (iov = (struct iovec *)H5MM_malloc(H5FD_SEC2_IOV_MAX * sizeof(struct iovec))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "unable to allocate I/O vectors")
+
+    u = 0;
+    while(u < count) {
+        haddr_t     start = addrs[u];   /* File address of this preadv() call */
+        haddr_t     pos = start;        /* End of the extents gathered so far */
+        int         niov = 0;           /* # of I/O vectors gathered */
+        int         iov_idx = 0;        /* First I/O vector not yet filled */
+
+        /* Gather the extents that can share one call */
+        do {
+            if(!H5F_addr_defined(addrs[u]))
+                HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "addr undefined, addr = %llu", (unsigned long long)addrs[u])
+            if(REGION_OVERFLOW(addrs[u], sizes[u]))
+                HGOTO_ERROR(H5E_ARGS, H5E_OVERFLOW, FAIL, "addr overflow, addr = %llu", (unsigned long long)addrs[u])
+
+            /* Read through a short hole into the scratch buffer */
+            if(addrs[u] > pos) {
+                if(NULL == scratch && NULL == (scratch = (unsigned char *)H5MM_malloc(H5FD_SEC2_MAX_GAP)))
+                    HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "unable to allocate scratch buffer")
+                iov[niov].iov_base = scratch;
+                iov[niov].iov_len = (size_t)(addrs[u] - pos);
+                niov++;
+            } /* end if */
+            if(sizes[u] > 0) {
+                HDassert(bufs[u]);
+                iov[niov].iov_base = bufs[u];
+                iov[niov].iov_len = sizes[u];
+                niov++;
+            } /* end if */
+            pos = addrs[u] + sizes[u];
+            u++;
+        } while(u < count && niov < (H5FD_SEC2_IOV_MAX - 1) && addrs[u] >= pos
+                && (addrs[u] - pos) <= H5FD_SEC2_MAX_GAP);
+
+        /* Read data, being careful of interrupted system calls, partial
+         * results, and the end of the file.
+         */
+        while(iov_idx < niov) {
+            ssize_t bytes_read = -1;    /* # of bytes actually read */
+
+            do {
+                bytes_read = HDpreadv(file->fd, iov + iov_idx, niov - iov_idx, (HDoff_t)start);
+            } while(-1 == bytes_read && EINTR == errno);
+
+            if(-1 == bytes_read) { /* error */
+                int myerrno = errno;
+                time_t mytime = HDtime(NULL);
+
+                HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "file vector read failed: time = %s, filename = '%s', file descriptor = %d, errno = %d, error message = '%s', # of vectors = %d, offset = %llu", HDctime(&mytime), file->filename, file->fd, myerrno, HDstrerror(myerrno), niov - iov_idx, (unsigned long long)start);
+            } /* end if */
+
+            if(0 == bytes_read) {
+                /* end of file but not end of format address space */
+                for(; iov_idx < niov; iov_idx++)
+                    HDmemset(iov[iov_idx].iov_base, 0, iov[iov_idx].iov_len);
+                break;
+            } /* end if */
+
+            /* Skip the vectors that were filled and trim a partial one */
+            start += (haddr_t)bytes_read;
+            while(iov_idx < niov && (size_t)bytes_read >= iov[iov_idx].iov_len) {
+                bytes_read -= (ssize_t)iov[iov_idx].iov_len;
+                iov_idx++;
+            } /* end while */
+            if(iov_idx < niov) {
+                iov[iov_idx].iov_base = (unsigned char *)iov[iov_idx].iov_base + bytes_read;
+                iov[iov_idx].iov_len -= (size_t)bytes_read;
+            } /* end if */
+        } /* end while */
+    } /* end while */
+
+    /* preadv() doesn't move the file position */
+    file->pos = HADDR_UNDEF;
+    file->op = OP_UNKNOWN;
+#else /* H5_HAVE_PREADV */
+    for(u = 0; u < count; u++)
+        if(H5FD_sec2_read(_file, type, dxpl_id, addrs[u], sizes[u], bufs[u]) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "file read failed")
+#endif /* H5_HAVE_PREADV */
+
+done:
+#ifdef H5_HAVE_PREADV
+    iov = (struct iovec *)H5MM_xfree(iov);
+    scratch = (unsigned char *)H5MM_xfree(scratch);
+
+    if(ret_value < 0) {
+        /* Reset last file I/O information */
+        file->pos = HADDR_UNDEF;
+        file->op = OP_UNKNOWN;
+    } /* end if */
+#endif /* H5_HAVE_PREADV */
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_sec2_readv() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_sec2_writev
+ *
+ * Purpose:     Writes COUNT extents to FILE from the buffers in BUFS.
+ *              Extents that follow each other in the file are written
+ *              with a single pwritev() call.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD_sec2_writev(H5FD_t *_file, H5FD_mem_t H5_ATTR_UNUSED type, hid_t H5_ATTR_UNUSED dxpl_id,
+    size_t count, const haddr_t addrs[], const size_t sizes[], const void *bufs[])
+{
+    H5FD_sec2_t     *file       = (H5FD_sec2_t *)_file;
+#ifdef H5_HAVE_PWRITEV
+    struct iovec    *iov        = NULL;     /* I/O vectors for one pwritev() call */
+#endif /* H5_HAVE_PWRITEV */
+    size_t          u;                      /* Local index variable */
+    herr_t          ret_value   = SUCCEED;  /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    HDassert(file && file->pub.cls);
+    HDassert(0 == count || (addrs && sizes && bufs));
+
+#ifdef H5_HAVE_PWRITEV
+    if(NULL == (iov = (struct iovec *)H5MM_malloc(H5FD_SEC2_IOV_MAX * sizeof(struct iovec))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "unable to allocate I/O vectors")
+
+    u = 0;
+    while(u < count) {
+        haddr_t     start = addrs[u];   /* File address of this pwritev() call */
+        haddr_t     pos = start;        /* End of the extents gathered so far */
+        int         niov = 0;           /* # of I/O vectors gathered */
+        int         iov_idx = 0;        /* First I/O vector not yet written */
+
+        /* Gather the extents that are adjacent in the file */
+        do {
+            if(!H5F_addr_defined(addrs[u]))
+                HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "addr undefined, addr = %llu", (unsigned long long)addrs[u])
+            if(REGION_OVERFLOW(addrs[u], sizes[u]))
+                HGOTO_ERROR(H5E_ARGS, H5E_OVERFLOW, FAIL, "addr overflow, addr = %llu, size = %llu", (unsigned long long)addrs[u], (unsigned long long)sizes[u])
+
+            if(sizes[u] > 0) {
+                HDassert(bufs[u]);
+                iov[niov].iov_base = (void *)bufs[u]; /* Casting away const OK -QAK */
+                iov[niov].iov_len = sizes[u];
+                niov++;
+            } /* end if */
+            pos = addrs[u] + sizes[u];
+            u++;
+        } while(u < count && niov < H5FD_SEC2_IOV_MAX && addrs[u] == pos);
+
+        /* Write the data, being careful of interrupted system calls and
+         * partial results
+         */
+        while(iov_idx < niov) {
+            ssize_t bytes_wrote = -1;   /* # of bytes written */
+
+            do {
+                bytes_wrote = HDpwritev(file->fd, iov + iov_idx, niov - iov_idx, (HDoff_t)start);
+            } while(-1 == bytes_wrote && EINTR == errno);
+
+            if(-1 == bytes_wrote) { /* error */
+                int myerrno = errno;
+                time_t mytime = HDtime(NULL);
+
+                HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "file vector write failed: time = %s, filename = '%s', file descriptor = %d, errno = %d, error message = '%s', # of vectors = %d, offset = %llu", HDctime(&mytime), file->filename, file->fd, myerrno, HDstrerror(myerrno), niov - iov_idx, (unsigned long long)start);
+            } /* end if */
+            HDassert(bytes_wrote > 0);
+
+            /* Skip the vectors that were written and trim a partial one */
+            start += (haddr_t)bytes_wrote;
+            while(iov_idx < niov && (size_t)bytes_wrote >= iov[iov_idx].iov_len) {
+                bytes_wrote -= (ssize_t)iov[iov_idx].iov_len;
+                iov_idx++;
+            } /* end while */
+            if(iov_idx < niov) {
+                iov[iov_idx].iov_base = (unsigned char *)iov[iov_idx].iov_base + bytes_wrote;
+                iov[iov_idx].iov_len -= (size_t)bytes_wrote;
+            } /* end if */
+        } /* end while */
+
+        /* Update eof */
+        if(pos > file->eof)
+            file->eof = pos;
+    } /* end while */
+
+    /* pwritev() doesn't move the file position */
+    file->pos = HADDR_UNDEF;
+    file->op = OP_UNKNOWN;
+#else /* H5_HAVE_PWRITEV */
+    for(u = 0; u < count; u++)
+        if(H5FD_sec2_write(_file, type, dxpl_id, addrs[u], sizes[u], bufs[u]) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "file write failed")
+#endif /* H5_HAVE_PWRITEV */
+
+done:
+#ifdef H5_HAVE_PWRITEV
+    iov = (struct iovec *)H5MM_xfree(iov);
+
+    if(ret_value < 0) {
+        /* Reset last file I/O information */
+        file->pos = HADDR_UNDEF;
+        file->op = OP_UNKNOWN;
+    } /* end if */
+#endif /* H5_HAVE_PWRITEV */
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_sec2_writev() */
+
 
 /*-------------------------------------------------------------------------
  * Function:    H5FD_sec2_truncate
@@ -36,11 +36,23 @@
 #include "H5Eprivate.h"		/* Error handling		  	*/
 #include "H5FLprivate.h"	/* Free Lists                           */
 #include "H5MMprivate.h"	/* Memory management			*/
+#include "H5VMprivate.h"	/* Vectors and arrays 			*/
 
 /*
  * Private type definitions
  */
 
+/*
+    Block free lists round each request up to a size class, so that blocks
+    of similar sizes share one free list instead of each exact size getting
+    its own.  Sizes up to H5FL_BLK_CLASS_SMALL are rounded up to a multiple
+    of H5FL_BLK_CLASS_ALIGN; larger sizes get 2^H5FL_BLK_CLASS_SUBDIV classes
+    between each power of two, wasting at most 12.5% of a block.
+ */
+#define H5FL_BLK_CLASS_SMALL    256
+#define H5FL_BLK_CLASS_ALIGN    16
+#define H5FL_BLK_CLASS_SUBDIV   3
+
 /*
     Default limits on how much memory can accumulate on each free list before
     it is garbage collected.
@@ -144,6 +156,7 @@ static int H5FL__blk_term(void);
 static herr_t H5FL__fac_gc(void);
 static herr_t H5FL__fac_gc_list(H5FL_fac_head_t *head);
 static int H5FL__fac_term_all(void);
+static size_t H5FL__blk_class_size(size_t size);
 
 /* Declare a free list to manage the H5FL_blk_node_t struct */
 H5FL_DEFINE(H5FL_blk_node_t);
@@ -445,6 +458,10 @@ H5FL_reg_malloc(H5FL_reg_head_t *head H5FL_TRACK_PARAMS)
 
         /* Increment the number of blocks allocated in list */
         head->allocated++;
+
+        /* Update the peak memory used by the list */
+        if(head->allocated * head->size > head->peak_mem)
+            head->peak_mem = head->allocated * head->size;
     } /* end else */
 
 #ifdef H5FL_TRACK
@@ -671,6 +688,39 @@ printf("%s: head->name = %s, head->allocated = %d\n", FUNC, H5FL_reg_gc_head.fir
 }   /* end H5FL__reg_term() */
 
 
+/*-------------------------------------------------------------------------
+ * Function:	H5FL__blk_class_size
+ *
+ * Purpose:	Rounds a block size up to its size class.  All blocks in a
+ *      block free list are allocated at a class size.
+ *
+ * Return:	Size of the class that a block of SIZE bytes belongs to
+ *
+ *-------------------------------------------------------------------------
+ */
+static size_t
+H5FL__blk_class_size(size_t size)
+{
+    size_t step;                /* Distance between classes around SIZE */
+    size_t ret_value;           /* Return value */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    /* Pick the spacing of the classes around this size */
+    if(size <= H5FL_BLK_CLASS_SMALL)
+        step = H5FL_BLK_CLASS_ALIGN;
+    else
+        step = (size_t)1 << (H5VM_log2_gen((uint64_t)(size - 1)) - H5FL_BLK_CLASS_SUBDIV);
+
+    /* Round up, leaving sizes too close to the top of the range alone */
+    ret_value = (size + (step - 1)) & ~(step - 1);
+    if(ret_value < size)
+        ret_value = size;
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FL__blk_class_size() */
+
+
 /*-------------------------------------------------------------------------
  * Function:	H5FL_blk_find_list
  *
@@ -856,6 +906,9 @@ H5FL_blk_free_block_avail(H5FL_blk_head_t *head, size_t size)
     /* Double check parameters */
     HDassert(head);
 
+    /* Get the size class for blocks of this size */
+    size = H5FL__blk_class_size(size);
+
     /* check if there is a free list for blocks of this size */
     /* and if there are any blocks available on the list */
     if((free_list = H5FL_blk_find_list(&(head->head), size)) != NULL && free_list->list != NULL)
@@ -902,6 +955,9 @@ H5FL_blk_malloc(H5FL_blk_head_t *head, size_t size H5FL_TRACK_PARAMS)
         if(H5FL_blk_init(head)<0)
             HGOTO_ERROR(H5E_RESOURCE, H5E_CANTINIT, NULL, "can't initialize 'block' list")
 
+    /* Allocate blocks at the size of their class */
+    size = H5FL__blk_class_size(size);
+
     /* check if there is a free list for blocks of this size */
     /* and if there are any blocks available on the list */
     if((free_list=H5FL_blk_find_list(&(head->head),size))!=NULL && free_list->list!=NULL) {
@@ -923,8 +979,13 @@ H5FL_blk_malloc(H5FL_blk_head_t *head, size_t size H5FL_TRACK_PARAMS)
         if(NULL == (temp = (H5FL_blk_list_t *)H5FL_malloc(sizeof(H5FL_blk_list_t) + H5FL_TRACK_SIZE + size)))
             HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, NULL, "memory allocation failed for chunk")
 
-        /* Increment the number of blocks allocated */
+        /* Increment the number of blocks & memory allocated */
         head->allocated++;
+        head->alloc_mem += size;
+
+        /* Update the peak memory used by the queue */
+        if(head->alloc_mem > head->peak_mem)
+            head->peak_mem = head->alloc_mem;
     } /* end else */
 
     /* Initialize the block allocated */
@@ -991,8 +1052,10 @@ H5FL_blk_calloc(H5FL_blk_head_t *head, size_t size H5FL_TRACK_PARAMS)
     if (NULL==(ret_value = H5FL_blk_malloc(head,size H5FL_TRACK_INFO_INT)))
         HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, NULL, "memory allocation failed")
 
-    /* Clear the block to zeros */
-    HDmemset(ret_value,0,size);
+    /* Clear the whole block to zeros */
+    /* (H5D__fill_init relies on H5FL_BLK_AVAIL finding blocks that are all
+     *  zeros, for any size in the class) */
+    HDmemset(ret_value,0,H5FL__blk_class_size(size));
 
 done:
     FUNC_LEAVE_NOAPI(ret_value)
@@ -1137,8 +1200,8 @@ H5FL_blk_realloc(H5FL_blk_head_t *head, void *block, size_t new_size H5FL_TRACK_
         /* Get the pointer to the chunk info header in front of the chunk to free */
         temp=(H5FL_blk_list_t *)((unsigned char *)block - (sizeof(H5FL_blk_list_t) + H5FL_TRACK_SIZE)); /*lint !e826 Pointer-to-pointer cast is appropriate here */
 
-        /* check if we are actually changing the size of the buffer */
-        if(new_size!=temp->size) {
+        /* check if we are actually changing the size class of the buffer */
+        if(H5FL__blk_class_size(new_size)!=temp->size) {
             size_t blk_size;           /* Temporary block size */
 
             if((ret_value=H5FL_blk_malloc(head,new_size H5FL_TRACK_INFO_INT))==NULL)
@@ -1211,6 +1274,7 @@ H5FL__blk_gc_list(H5FL_blk_head_t *head)
 
             /* Decrement the number of blocks & memory allocated from this PQ */
             head->allocated--;
+            head->alloc_mem -= head->head->size;
             head->list_mem -= head->head->size;
 
             /* Decrement global count of free memory on "block" lists */
@@ -1532,8 +1596,13 @@ H5FL_arr_malloc(H5FL_arr_head_t *head, size_t elem)
         if(NULL == (new_obj = (H5FL_arr_list_t *)H5FL_malloc(sizeof(H5FL_arr_list_t)+mem_size)))
             HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, NULL, "memory allocation failed")
 
-        /* Increment the number of blocks allocated in list */
+        /* Increment the number of blocks & memory allocated in list */
         head->allocated++;
+        head->alloc_mem += mem_size;
+
+        /* Update the peak memory used by the list */
+        if(head->alloc_mem > head->peak_mem)
+            head->peak_mem = head->alloc_mem;
     } /* end else */
 
     /* Initialize the new object */
@@ -1692,8 +1761,9 @@ H5FL__arr_gc_list(H5FL_arr_head_t *head)
             head->list_arr[u].list = NULL;
             head->list_arr[u].onlist = 0;
 
-            /* Decrement count of free memory on this "array" list */
+            /* Decrement count of free & allocated memory on this "array" list */
             head->list_mem -= total_mem;
+            head->alloc_mem -= total_mem;
 
             /* Decrement global count of free memory on "array" lists */
             H5FL_arr_gc_head.mem_freed -= total_mem;
@@ -2162,6 +2232,10 @@ H5FL_fac_malloc(H5FL_fac_head_t *head H5FL_TRACK_PARAMS)
 
         /* Increment the number of blocks allocated in list */
         head->allocated++;
+
+        /* Update the peak memory used by the factory */
+        if(head->allocated * head->size > head->peak_mem)
+            head->peak_mem = head->allocated * head->size;
     } /* end else */
 
 #ifdef H5FL_TRACK
@@ -2533,3 +2607,155 @@ H5FL_set_free_list_limits(int reg_global_lim, int reg_list_lim, int arr_global_l
     FUNC_LEAVE_NOAPI(ret_value)
 }   /* end H5FL_set_free_list_limits() */
 
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5FL_get_free_list_sizes
+ *
+ * Purpose:	Gets the current size of the different kinds of free lists.
+ *      These lists are global for the entire library.  The size returned
+ *      is the memory held on each kind of list, waiting to be reused.
+ *      NULL can be passed for any size that isn't wanted.
+ *
+ * Parameters:
+ *  size_t *reg_size;    OUT: The memory on all "regular" free lists
+ *  size_t *arr_size;    OUT: The memory on all "array" free lists
+ *  size_t *blk_size;    OUT: The memory on all "block" free lists
+ *  size_t *fac_size;    OUT: The memory on all "factory" free lists
+ *
+ * Return:	Success:	non-negative
+ *
+ *		Failure:	negative
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5FL_get_free_list_sizes(size_t *reg_size, size_t *arr_size, size_t *blk_size,
+    size_t *fac_size)
+{
+    FUNC_ENTER_NOAPI_NOERR
+
+    /* Retrieve the amount of memory on each kind of free list */
+    if(reg_size)
+        *reg_size = H5FL_reg_gc_head.mem_freed;
+    if(arr_size)
+        *arr_size = H5FL_arr_gc_head.mem_freed;
+    if(blk_size)
+        *blk_size = H5FL_blk_gc_head.mem_freed;
+    if(fac_size)
+        *fac_size = H5FL_fac_gc_head.mem_freed;
+
+    FUNC_LEAVE_NOAPI(SUCCEED)
+}   /* end H5FL_get_free_list_sizes() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5FL_iterate
+ *
+ * Purpose:	Calls OP with the memory use of each free list that has been
+ *      used since the library was initialized.
+ *
+ *      The information for all the lists is gathered before OP is first
+ *      called, so OP may call library routines that create or release
+ *      free lists (factories, for example).
+ *
+ * Return:	Success:	The last value returned by OP.  A positive
+ *                              value from OP stops the iteration early.
+ *		Failure:	negative
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5FL_iterate(H5_free_list_operator_t op, void *op_data)
+{
+    H5_free_list_info_t *info = NULL;   /* Information for each list */
+    H5FL_reg_gc_node_t *reg_node;       /* Regular free list being examined */
+    H5FL_gc_arr_node_t *arr_node;       /* Array free list being examined */
+    H5FL_blk_gc_node_t *blk_node;       /* Block free list being examined */
+    H5FL_fac_gc_node_t *fac_node;       /* Factory free list being examined */
+    size_t nlists = 0;                  /* Number of free lists */
+    size_t u;                           /* Local index variable */
+    herr_t ret_value = H5_ITER_CONT;    /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    /* Sanity check */
+    HDassert(op);
+
+    /* Count the free lists */
+    for(reg_node = H5FL_reg_gc_head.first; reg_node; reg_node = reg_node->next)
+        nlists++;
+    for(arr_node = H5FL_arr_gc_head.first; arr_node; arr_node = arr_node->next)
+        nlists++;
+    for(blk_node = H5FL_blk_gc_head.first; blk_node; blk_node = blk_node->next)
+        nlists++;
+    for(fac_node = H5FL_fac_gc_head.first; fac_node; fac_node = fac_node->next)
+        nlists++;
+    if(0 == nlists)
+        HGOTO_DONE(H5_ITER_CONT)
+
+    if(NULL == (info = (H5_free_list_info_t *)H5MM_malloc(nlists * sizeof(H5_free_list_info_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for free list info")
+
+    /* Gather the information for each list */
+    u = 0;
+    for(reg_node = H5FL_reg_gc_head.first; reg_node; reg_node = reg_node->next, u++) {
+        H5FL_reg_head_t *head = reg_node->list;
+
+        info[u].name = head->name;
+        info[u].type = H5_FREE_LIST_REG;
+        info[u].nalloc = head->allocated;
+        info[u].alloc_size = head->allocated * head->size;
+        info[u].peak_alloc_size = head->peak_mem;
+        info[u].nfree = head->onlist;
+        info[u].free_size = head->onlist * head->size;
+    } /* end for */
+    for(arr_node = H5FL_arr_gc_head.first; arr_node; arr_node = arr_node->next, u++) {
+        H5FL_arr_head_t *head = arr_node->list;
+        int v;
+
+        info[u].name = head->name;
+        info[u].type = H5_FREE_LIST_ARR;
+        info[u].nalloc = head->allocated;
+        info[u].alloc_size = head->alloc_mem;
+        info[u].peak_alloc_size = head->peak_mem;
+        info[u].nfree = 0;
+        for(v = 0; v < head->maxelem; v++)
+            info[u].nfree += head->list_arr[v].onlist;
+        info[u].free_size = head->list_mem;
+    } /* end for */
+    for(blk_node = H5FL_blk_gc_head.first; blk_node; blk_node = blk_node->next, u++) {
+        H5FL_blk_head_t *head = blk_node->pq;
+
+        info[u].name = head->name;
+        info[u].type = H5_FREE_LIST_BLK;
+        info[u].nalloc = head->allocated;
+        info[u].alloc_size = head->alloc_mem;
+        info[u].peak_alloc_size = head->peak_mem;
+        info[u].nfree = head->onlist;
+        info[u].free_size = head->list_mem;
+    } /* end for */
+    for(fac_node = H5FL_fac_gc_head.first; fac_node; fac_node = fac_node->next, u++) {
+        H5FL_fac_head_t *head = fac_node->list;
+
+        info[u].name = NULL;
+        info[u].type = H5_FREE_LIST_FAC;
+        info[u].nalloc = head->allocated;
+        info[u].alloc_size = head->allocated * head->size;
+        info[u].peak_alloc_size = head->peak_mem;
+        info[u].nfree = head->onlist;
+        info[u].free_size = head->onlist * head->size;
+    } /* end for */
+    HDassert(u == nlists);
+
+    /* Make the callbacks */
+    for(u = 0; u < nlists && ret_value == H5_ITER_CONT; u++)
+        if((ret_value = (*op)(&info[u], op_data)) < 0)
+            HGOTO_ERROR(H5E_RESOURCE, H5E_BADITER, FAIL, "iteration operator failed")
+
+done:
+    if(info)
+        info = (H5_free_list_info_t *)H5MM_xfree(info);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+}   /* end H5FL_iterate() */
@@ -103,6 +103,7 @@ typedef struct H5FL_reg_head_t {
     const char *name;   /* Name of the type */
     size_t size;        /* Size of the blocks in the list */
     H5FL_reg_node_t *list;  /* List of free blocks */
+    size_t peak_mem;    /* Most memory allocated for the list at once */
 } H5FL_reg_head_t;
 
 /*
@@ -111,7 +112,7 @@ typedef struct H5FL_reg_head_t {
 #define H5FL_REG_NAME(t)        H5_##t##_reg_free_list
 #ifndef H5_NO_REG_FREE_LISTS
 /* Common macros for H5FL_DEFINE & H5FL_DEFINE_STATIC */
-#define H5FL_DEFINE_COMMON(t) H5FL_reg_head_t H5FL_REG_NAME(t)={0,0,0,#t,sizeof(t),NULL}
+#define H5FL_DEFINE_COMMON(t) H5FL_reg_head_t H5FL_REG_NAME(t)={0,0,0,#t,sizeof(t),NULL,0}
 
 /* Declare a free list to manage objects of type 't' */
 #define H5FL_DEFINE(t) H5_DLL H5FL_DEFINE_COMMON(t)
@@ -172,6 +173,8 @@ typedef struct H5FL_blk_head_t {
     size_t list_mem;    /* Amount of memory in block on free list */
     const char *name;   /* Name of the type */
     H5FL_blk_node_t *head;  /* Pointer to first free list in queue */
+    size_t alloc_mem;   /* Amount of memory in blocks allocated (in use & on free list) */
+    size_t peak_mem;    /* Most memory allocated for the queue at once */
 } H5FL_blk_head_t;
 
 /*
@@ -180,7 +183,7 @@ typedef struct H5FL_blk_head_t {
 #define H5FL_BLK_NAME(t)        H5_##t##_blk_free_list
 #ifndef H5_NO_BLK_FREE_LISTS
 /* Common macro for H5FL_BLK_DEFINE & H5FL_BLK_DEFINE_STATIC */
-#define H5FL_BLK_DEFINE_COMMON(t) H5FL_blk_head_t H5FL_BLK_NAME(t)={0,0,0,0,#t"_blk",NULL}
+#define H5FL_BLK_DEFINE_COMMON(t) H5FL_blk_head_t H5FL_BLK_NAME(t)={0,0,0,0,#t"_blk",NULL,0,0}
 
 /* Declare a free list to manage objects of type 't' */
 #define H5FL_BLK_DEFINE(t)  H5_DLL H5FL_BLK_DEFINE_COMMON(t)
@@ -245,6 +248,8 @@ typedef struct H5FL_arr_head_t {
     size_t base_size;      /* Size of the "base" object in the list */
     size_t elem_size;      /* Size of the array elements in the list */
     H5FL_arr_node_t *list_arr;  /* Array of lists of free blocks */
+    size_t alloc_mem;      /* Amount of memory in blocks allocated (in use & on free list) */
+    size_t peak_mem;       /* Most memory allocated for the list at once */
 } H5FL_arr_head_t;
 
 /*
@@ -253,7 +258,7 @@ typedef struct H5FL_arr_head_t {
 #define H5FL_ARR_NAME(t)        H5_##t##_arr_free_list
 #ifndef H5_NO_ARR_FREE_LISTS
 /* Common macro for H5FL_ARR_DEFINE & H5FL_ARR_DEFINE_STATIC (and H5FL_BARR variants) */
-#define H5FL_ARR_DEFINE_COMMON(b,t,m) H5FL_arr_head_t H5FL_ARR_NAME(t)={0,0,0,#t"_arr",m+1,b,sizeof(t),NULL}
+#define H5FL_ARR_DEFINE_COMMON(b,t,m) H5FL_arr_head_t H5FL_ARR_NAME(t)={0,0,0,#t"_arr",m+1,b,sizeof(t),NULL,0,0}
 
 /* Declare a free list to manage arrays of type 't' */
 #define H5FL_ARR_DEFINE(t,m)  H5_DLL H5FL_ARR_DEFINE_COMMON(0,t,m)
@@ -312,7 +317,7 @@ typedef struct H5FL_seq_head_t {
 #define H5FL_SEQ_NAME(t)        H5_##t##_seq_free_list
 #ifndef H5_NO_SEQ_FREE_LISTS
 /* Common macro for H5FL_SEQ_DEFINE & H5FL_SEQ_DEFINE_STATIC */
-#define H5FL_SEQ_DEFINE_COMMON(t) H5FL_seq_head_t H5FL_SEQ_NAME(t)={{0,0,0,0,#t"_seq",NULL},sizeof(t)}
+#define H5FL_SEQ_DEFINE_COMMON(t) H5FL_seq_head_t H5FL_SEQ_NAME(t)={{0,0,0,0,#t"_seq",NULL,0,0},sizeof(t)}
 
 /* Declare a free list to manage sequences of type 't' */
 #define H5FL_SEQ_DEFINE(t)  H5_DLL H5FL_SEQ_DEFINE_COMMON(t)
@@ -360,6 +365,7 @@ typedef struct H5FL_fac_head_t {
     size_t size;        /* Size of the blocks in the list */
     H5FL_fac_node_t *list;  /* List of free blocks */
     H5FL_fac_gc_node_t *prev_gc; /* Previous garbage collection node in list */
+    size_t peak_mem;    /* Most memory allocated for the factory at once */
 } H5FL_fac_head_t;
 
 
@@ -425,6 +431,9 @@ H5_DLL herr_t H5FL_garbage_coll(void);
 H5_DLL herr_t H5FL_set_free_list_limits(int reg_global_lim, int reg_list_lim,
     int arr_global_lim, int arr_list_lim, int blk_global_lim, int blk_list_lim,
     int fac_global_lim, int fac_list_lim);
+H5_DLL herr_t H5FL_get_free_list_sizes(size_t *reg_size, size_t *arr_size,
+    size_t *blk_size, size_t *fac_size);
+H5_DLL herr_t H5FL_iterate(H5_free_list_operator_t op, void *op_data);
 H5_DLL int   H5FL_term_interface(void);
 
 #endif
@@ -154,6 +154,8 @@ H5F_get_access_plist(H5F_t *f, hbool_t app_ref)
         HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set data cache byte size")
     if(H5P_set(new_plist, H5F_ACS_PREEMPT_READ_CHUNKS_NAME, &(f->shared->rdcc_w0)) < 0)
         HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set preempt read chunks")
+    if(H5P_set(new_plist, H5F_ACS_DATA_CACHE_SHARED_SIZE_NAME, &(f->shared->rdcc_shared_nbytes)) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set shared data cache byte size")
     if(H5P_set(new_plist, H5F_ACS_ALIGN_THRHD_NAME, &(f->shared->threshold)) < 0)
         HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set alignment threshold")
     if(H5P_set(new_plist, H5F_ACS_ALIGN_NAME, &(f->shared->alignment)) < 0)
@@ -168,6 +170,10 @@ H5F_get_access_plist(H5F_t *f, hbool_t app_ref)
         HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set 'small data' cache size")
     if(H5P_set(new_plist, H5F_ACS_LATEST_FORMAT_NAME, &(f->shared->latest_format)) < 0)
         HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set 'latest format' flag")
+    if(H5P_set(new_plist, H5F_ACS_META_CACHE_IMAGE_NAME, &(f->shared->mdc_image)) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set metadata cache image flag")
+    if(H5P_set(new_plist, H5F_ACS_METADATA_READ_ATTEMPTS_NAME, &(f->shared->read_attempts)) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set # of metadata read attempts")
     if(f->shared->efc)
         efc_size = H5F_efc_max_nfiles(f->shared->efc);
     if(H5P_set(new_plist, H5F_ACS_EFC_SIZE_NAME, &efc_size) < 0)
@@ -575,6 +581,7 @@ H5F_new(H5F_file_t *shared, unsigned flags, hid_t fcpl_id, hid_t fapl_id, H5FD_t
     else {
         H5P_genplist_t *plist;          /* Property list */
         unsigned        efc_size;       /* External file cache size */
+        hsize_t         fs_page_size;   /* File space page size */
         size_t u;                       /* Local index variable */
 
         HDassert(lf != NULL);
@@ -610,6 +617,8 @@ H5F_new(H5F_file_t *shared, unsigned flags, hid_t fcpl_id, hid_t fapl_id, H5FD_t
             HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, NULL, "can't get file space strategy")
         if(H5P_get(plist, H5F_CRT_FREE_SPACE_THRESHOLD_NAME, &f->shared->fs_threshold) < 0)
             HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, NULL, "can't get free-space section threshold")
+        if(H5P_get(plist, H5F_CRT_FILE_SPACE_PAGE_SIZE_NAME, &fs_page_size) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, NULL, "can't get file space page size")
 
         /* Get the FAPL values to cache */
         if(NULL == (plist = (H5P_genplist_t *)H5I_object(fapl_id)))
@@ -622,6 +631,8 @@ H5F_new(H5F_file_t *shared, unsigned flags, hid_t fcpl_id, hid_t fapl_id, H5FD_t
             HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, NULL, "can't get data cache byte size")
         if(H5P_get(plist, H5F_ACS_PREEMPT_READ_CHUNKS_NAME, &(f->shared->rdcc_w0)) < 0)
             HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, NULL, "can't get preempt read chunk")
+        if(H5P_get(plist, H5F_ACS_DATA_CACHE_SHARED_SIZE_NAME, &(f->shared->rdcc_shared_nbytes)) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, NULL, "can't get shared data cache byte size")
         if(H5P_get(plist, H5F_ACS_ALIGN_THRHD_NAME, &(f->shared->threshold)) < 0)
             HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, NULL, "can't get alignment threshold")
         if(H5P_get(plist, H5F_ACS_ALIGN_NAME, &(f->shared->alignment)) < 0)
@@ -632,6 +643,16 @@ H5F_new(H5F_file_t *shared, unsigned flags, hid_t fcpl_id, hid_t fapl_id, H5FD_t
             HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, NULL, "can't get sieve buffer size")
         if(H5P_get(plist, H5F_ACS_LATEST_FORMAT_NAME, &(f->shared->latest_format)) < 0)
             HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, NULL, "can't get 'latest format' flag")
+        if(H5P_get(plist, H5F_ACS_META_CACHE_IMAGE_NAME, &(f->shared->mdc_image)) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, NULL, "can't get metadata cache image flag")
+        if(H5P_get(plist, H5F_ACS_METADATA_READ_ATTEMPTS_NAME, &(f->shared->read_attempts)) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, NULL, "can't get # of metadata read attempts")
+
+        /* Metadata read by a SWMR reader can be caught half-written, so
+         *      retry it more by default */
+        if(0 == f->shared->read_attempts)
+            f->shared->read_attempts = (flags & H5F_ACC_SWMR_READ) ?
+                    H5F_SWMR_METADATA_READ_ATTEMPTS : H5F_METADATA_READ_ATTEMPTS;
         if(H5P_get(plist, H5F_ACS_META_BLOCK_SIZE_NAME, &(f->shared->meta_aggr.alloc_size)) < 0)
             HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, NULL, "can't get metadata cache size")
         f->shared->meta_aggr.feature_flag = H5FD_FEAT_AGGREGATE_METADATA;
@@ -656,10 +677,19 @@ H5F_new(H5F_file_t *shared, unsigned flags, hid_t fcpl_id, hid_t fapl_id, H5FD_t
             HGOTO_ERROR(H5E_FILE, H5E_BADVALUE, NULL, "bad maximum address from VFD")
         if(H5FD_get_feature_flags(lf, &f->shared->feature_flags) < 0)
             HGOTO_ERROR(H5E_FILE, H5E_CANTGET, NULL, "can't get feature flags from VFD")
+
+        /* Metadata & raw data that other processes read (or write) with
+         *      SWMR access must go straight to (and from) the file */
+        if(flags & (H5F_ACC_SWMR_WRITE | H5F_ACC_SWMR_READ))
+            f->shared->feature_flags &= ~(unsigned long)(H5FD_FEAT_ACCUMULATE_METADATA | H5FD_FEAT_DATA_SIEVE);
         if(H5FD_get_fs_type_map(lf, f->shared->fs_type_map) < 0)
             HGOTO_ERROR(H5E_FILE, H5E_CANTGET, NULL, "can't get free space type mapping from VFD")
         if(H5MF_init_merge_flags(f) < 0)
             HGOTO_ERROR(H5E_FILE, H5E_CANTINIT, NULL, "problem initializing free space merge flags")
+
+        /* Set up paged aggregation, if the file uses it */
+        if(fs_page_size > 0 && H5F__set_paged_aggr(f, fs_page_size) < 0)
+            HGOTO_ERROR(H5E_FILE, H5E_CANTINIT, NULL, "can't set up paged aggregation")
         f->shared->tmp_addr = f->shared->maxaddr;
         /* Disable temp. space allocation for parallel I/O (for now) */
         /* (When we've arranged to have the relocated metadata addresses (and
@@ -748,6 +778,9 @@ H5F_dest(H5F_t *f, hid_t dxpl_id, hbool_t flush)
     if(1 == f->shared->nrefs) {
         H5F_io_info_t fio_info;             /* I/O info for operation */
 
+        /* All datasets must have released the shared chunk cache by now */
+        HDassert(NULL == f->shared->rdcc_pool);
+
         /* Flush at this point since the file will be closed.
          * Only try to flush the file if it was opened with write access, and if
          * the caller requested a flush.
@@ -775,6 +808,22 @@ H5F_dest(H5F_t *f, hid_t dxpl_id, hbool_t flush)
              *      'eoa' value)
              */
             if(H5F_ACC_RDWR & H5F_INTENT(f)) {
+                /* Write the metadata cache image, if requested.  (This is
+                 *      done while the cache is still populated and clean,
+                 *      and before the free space managers are shut down,
+                 *      so the image's space is tracked like any other
+                 *      metadata.  Drivers with driver info are skipped, as
+                 *      the superblock extension can't grow before their
+                 *      driver info has been decoded when the file is opened)
+                 */
+                if(flush && f->shared->mdc_image
+                        && f->shared->sblock->super_vers >= HDF5_SUPERBLOCK_VERSION_2
+                        && !H5F_HAS_FEATURE(f, H5FD_FEAT_HAS_MPI)
+                        && 0 == H5FD_sb_size(f->shared->lf))
+                    if(H5F__super_write_cache_image(f, dxpl_id) < 0)
+                        /* Push error, but keep going*/
+                        HDONE_ERROR(H5E_FILE, H5E_CANTFLUSH, FAIL, "unable to write metadata cache image")
+
                 if(H5MF_close(f, dxpl_id) < 0)
                     /* Push error, but keep going*/
                     HDONE_ERROR(H5E_FILE, H5E_CANTRELEASE, FAIL, "can't release file free space info")
@@ -831,6 +880,9 @@ H5F_dest(H5F_t *f, hid_t dxpl_id, hbool_t flush)
             HDONE_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "can't get property list")
 
         /* Destroy other components of the file */
+        if(H5F__page_dest(&fio_info) < 0)
+            /* Push error, but keep going*/
+            HDONE_ERROR(H5E_FILE, H5E_CANTRELEASE, FAIL, "problems closing file")
         if(H5F__accum_reset(&fio_info, TRUE) < 0)
             /* Push error, but keep going*/
             HDONE_ERROR(H5E_FILE, H5E_CANTRELEASE, FAIL, "problems closing file")
@@ -1013,6 +1065,8 @@ H5F_open(const char *name, unsigned flags, hid_t fcpl_id, hid_t fapl_id,
 	    HGOTO_ERROR(H5E_FILE, H5E_CANTOPENFILE, NULL, "file exists")
 	if((flags & H5F_ACC_RDWR) && 0 == (shared->flags & H5F_ACC_RDWR))
 	    HGOTO_ERROR(H5E_FILE, H5E_CANTOPENFILE, NULL, "file is already open for read-only")
+	if((flags & (H5F_ACC_SWMR_WRITE | H5F_ACC_SWMR_READ)) != (shared->flags & (H5F_ACC_SWMR_WRITE | H5F_ACC_SWMR_READ)))
+	    HGOTO_ERROR(H5E_FILE, H5E_CANTOPENFILE, NULL, "SWMR access flags don't match the file's open flags")
 
         /* Allocate new "high-level" file struct */
         if((file = H5F_new(shared, flags, fcpl_id, fapl_id, NULL)) == NULL)
@@ -1047,6 +1101,19 @@ H5F_open(const char *name, unsigned flags, hid_t fcpl_id, hid_t fapl_id,
     shared = file->shared;
     lf = shared->lf;
 
+    /* Check the requirements of SWMR access, the first time the file is opened */
+    if(shared->nrefs == 1 && (flags & (H5F_ACC_SWMR_WRITE | H5F_ACC_SWMR_READ))) {
+        /* The metadata of files split across several files by the file
+         *      driver isn't in one address space the readers can follow */
+        if(H5FD_sb_size(lf) > 0)
+            HGOTO_ERROR(H5E_FILE, H5E_UNSUPPORTED, NULL, "SWMR access is not supported by the file driver")
+
+        /* The writer's metadata must be checksummed, for the readers to
+         *      detect (and retry) reading it half-written */
+        if((flags & H5F_ACC_SWMR_WRITE) && !shared->latest_format)
+            HGOTO_ERROR(H5E_FILE, H5E_BADVALUE, NULL, "SWMR write access requires the latest file format")
+    } /* end if */
+
     /*
      * Read or write the file superblock, depending on whether the file is
      * empty or not.
@@ -1083,6 +1150,31 @@ H5F_open(const char *name, unsigned flags, hid_t fcpl_id, hid_t fapl_id,
     if(NULL == (a_plist = (H5P_genplist_t *)H5I_object(fapl_id)))
         HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, NULL, "not file access property list")
 
+    /* Create the page buffer, the first time the file is opened and only
+     * after the superblock has determined the file space page size.
+     */
+    if(shared->nrefs == 1) {
+        size_t page_buf_size;           /* Size of page buffer */
+
+        if(H5P_get(a_plist, H5F_ACS_PAGE_BUFFER_SIZE_NAME, &page_buf_size) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, NULL, "can't get page buffer size")
+        if(page_buf_size > 0) {
+            unsigned min_meta_perc, min_raw_perc;   /* Reserved percentages of pages */
+
+            /* The page buffer would hold on to pages the other side of a
+             *      SWMR file has changed */
+            if(flags & (H5F_ACC_SWMR_WRITE | H5F_ACC_SWMR_READ))
+                HGOTO_ERROR(H5E_FILE, H5E_UNSUPPORTED, NULL, "page buffering is not supported with SWMR access")
+
+            if(H5P_get(a_plist, H5F_ACS_PAGE_BUFFER_MIN_META_PERC_NAME, &min_meta_perc) < 0)
+                HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, NULL, "can't get minimum metadata page percentage")
+            if(H5P_get(a_plist, H5F_ACS_PAGE_BUFFER_MIN_RAW_PERC_NAME, &min_raw_perc) < 0)
+                HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, NULL, "can't get minimum raw data page percentage")
+            if(H5F__page_create(file, dxpl_id, page_buf_size, min_meta_perc, min_raw_perc) < 0)
+                HGOTO_ERROR(H5E_FILE, H5E_CANTINIT, NULL, "unable to create page buffer")
+        } /* end if */
+    } /* end if */
+
     /*
      * Decide the file close degree.  If it's the first time to open the
      * file, set the degree to access property list value; if it's the
@@ -1187,6 +1279,11 @@ H5F_flush(H5F_t *f, hid_t dxpl_id, hbool_t closing)
         /* Push error, but keep going*/
         HDONE_ERROR(H5E_IO, H5E_CANTFLUSH, FAIL, "unable to flush metadata accumulator")
 
+    /* Flush out the page buffer */
+    if(H5F__page_flush(&fio_info) < 0)
+        /* Push error, but keep going*/
+        HDONE_ERROR(H5E_IO, H5E_CANTFLUSH, FAIL, "unable to flush page buffer")
+
     /* Flush file buffers to disk. */
     if(H5FD_flush(f->shared->lf, dxpl_id, closing) < 0)
         /* Push error, but keep going*/
@@ -1945,6 +2042,34 @@ H5F_set_store_msg_crt_idx(H5F_t *f, hbool_t flag)
     FUNC_LEAVE_NOAPI(SUCCEED)
 } /* H5F_set_store_msg_crt_idx() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:    H5F_set_rdcc_pool
+ *
+ * Purpose:     Set the memory pool of the raw data chunk cache shared by
+ *              all the datasets in the file.  (The pool is created and
+ *              released by the H5D package, as datasets use it.)
+ *
+ * Return:      Success:        SUCCEED
+ *              Failure:        FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5F_set_rdcc_pool(H5F_t *f, struct H5D_rdcc_pool_t *pool)
+{
+    /* Use FUNC_ENTER_NOAPI_NOINIT_NOERR here to avoid performance issues */
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    /* Sanity check */
+    HDassert(f);
+    HDassert(f->shared);
+
+    f->shared->rdcc_pool = pool;
+
+    FUNC_LEAVE_NOAPI(SUCCEED)
+} /* H5F_set_rdcc_pool() */
+
 
 /*-------------------------------------------------------------------------
  * Function:    H5F_get_file_image
@@ -2112,6 +2237,84 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5F__set_eoa() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5F_refresh_eoa
+ *
+ * Purpose:	Extend the file's 'eoa' value to the end of the file, so
+ *		that a SWMR reader can read the metadata & raw data the
+ *		writer has added to the file since it was opened.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5F_refresh_eoa(const H5F_t *f)
+{
+    haddr_t eoa;                        /* End of allocated space in the file */
+    haddr_t eof;                        /* End of the file */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    HDassert(f);
+    HDassert(f->shared);
+
+    /* Get the current 'eoa' & 'eof' values */
+    if(HADDR_UNDEF == (eoa = H5FD_get_eoa(f->shared->lf, H5FD_MEM_DEFAULT)))
+        HGOTO_ERROR(H5E_FILE, H5E_CANTGET, FAIL, "driver get_eoa request failed")
+    if(HADDR_UNDEF == (eof = H5FD_get_eof(f->shared->lf, H5FD_MEM_DEFAULT)))
+        HGOTO_ERROR(H5E_FILE, H5E_CANTGET, FAIL, "driver get_eof request failed")
+
+    /* Only ever grow the 'eoa' */
+    if(H5F_addr_gt(eof, eoa))
+        if(H5FD_set_eoa(f->shared->lf, H5FD_MEM_DEFAULT, eof) < 0)
+            HGOTO_ERROR(H5E_FILE, H5E_CANTSET, FAIL, "driver set_eoa request failed")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5F_refresh_eoa() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5F__set_paged_aggr
+ *
+ * Purpose:     Switch the file to paged aggregation with pages of
+ *              PAGE_SIZE bytes: allocations of at least a page are
+ *              aligned on page boundaries, and the metadata and "small
+ *              data" aggregators hand out space a page at a time.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5F__set_paged_aggr(H5F_t *f, hsize_t page_size)
+{
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    /* Sanity check */
+    HDassert(f);
+    HDassert(f->shared);
+    HDassert(page_size > 0);
+
+    f->shared->fs_page_size = page_size;
+    f->shared->alignment = page_size;
+    f->shared->threshold = page_size;
+    f->shared->meta_aggr.alloc_size = page_size;
+    f->shared->sdata_aggr.alloc_size = page_size;
+
+    /* Have the file driver align new page-sized blocks */
+    if(H5FD_set_alignment(f->shared->lf, page_size, page_size) < 0)
+        HGOTO_ERROR(H5E_FILE, H5E_CANTSET, FAIL, "can't set file driver alignment")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5F__set_paged_aggr() */
+
 #ifdef H5_HAVE_PARALLEL
 
 /*-------------------------------------------------------------------------
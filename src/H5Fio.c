@@ -129,14 +129,94 @@ HDfprintf(stderr, "%s: read from addr = %a, size = %Zu\n", FUNC, addr, size);
     if(NULL == (fio_info.dxpl = (H5P_genplist_t *)H5I_object(my_dxpl_id)))
         HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "can't get property list")
 
+    /* Pass through page buffer layer, if enabled */
+    if(f->shared->page_buf) {
+        if(H5F__page_read(&fio_info, map_type, addr, size, buf) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "read through page buffer failed")
+    } /* end if */
     /* Pass through metadata accumulator layer */
-    if(H5F__accum_read(&fio_info, map_type, addr, size, buf) < 0)
+    else if(H5F__accum_read(&fio_info, map_type, addr, size, buf) < 0)
         HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "read through metadata accumulator failed")
 
 done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5F_block_read() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5F_block_read_private
+ *
+ * Purpose:	Reads some raw data from a file into a buffer that no other
+ *		thread can see, such as the application's buffer.  Works
+ *		like H5F_block_read(), except that in the thread-safe
+ *		library the file driver may release the API lock while it
+ *		waits for the data, so other threads can use the library in
+ *		the meantime.
+ *
+ *		The metadata tag and ring in the transfer property list
+ *		(which may be shared with other threads) are restored when
+ *		the lock was released, since another thread may have set
+ *		its own.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5F_block_read_private(const H5F_t *f, haddr_t addr, size_t size,
+    hid_t dxpl_id, void *buf/*out*/)
+{
+#ifdef H5_HAVE_THREADSAFE
+    H5P_genplist_t *dxpl;               /* Data transfer property list */
+    haddr_t     tag;                    /* Metadata tag in the DXPL */
+    H5AC_ring_t ring;                   /* Metadata ring in the DXPL */
+    herr_t      status;                 /* Status of the read */
+#endif /* H5_HAVE_THREADSAFE */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    HDassert(f);
+    HDassert(f->shared);
+    HDassert(buf);
+
+#ifdef H5_HAVE_THREADSAFE
+    /* Pages read through the page buffer are shared, so only direct
+     * reads may release the lock */
+    if(f->shared->page_buf) {
+        if(H5F_block_read(f, H5FD_MEM_DRAW, addr, size, dxpl_id, buf) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "block read failed")
+        HGOTO_DONE(SUCCEED)
+    } /* end if */
+
+    /* Remember this thread's metadata tag & ring */
+    if(NULL == (dxpl = (H5P_genplist_t *)H5I_object(dxpl_id)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "can't get property list")
+    if(H5P_get(dxpl, H5AC_METADATA_TAG_NAME, &tag) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "unable to get metadata tag")
+    if(H5P_get(dxpl, H5AC_RING_NAME, &ring) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "unable to get metadata ring")
+
+    /* Read the data, letting the driver release the API lock */
+    H5FD_api_lock_allow_release();
+    status = H5F_block_read(f, H5FD_MEM_DRAW, addr, size, dxpl_id, buf);
+    if(H5FD_api_lock_disallow_release()) {
+        if(H5P_set(dxpl, H5AC_METADATA_TAG_NAME, &tag) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "unable to restore metadata tag")
+        if(H5P_set(dxpl, H5AC_RING_NAME, &ring) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "unable to restore metadata ring")
+    } /* end if */
+    if(status < 0)
+        HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "block read failed")
+#else /* H5_HAVE_THREADSAFE */
+    if(H5F_block_read(f, H5FD_MEM_DRAW, addr, size, dxpl_id, buf) < 0)
+        HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "block read failed")
+#endif /* H5_HAVE_THREADSAFE */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5F_block_read_private() */
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5F_block_write
@@ -177,6 +257,10 @@ HDfprintf(stderr, "%s: write to addr = %a, size = %Zu\n", FUNC, addr, size);
     if(H5F_addr_le(f->shared->tmp_addr, (addr + size)))
         HGOTO_ERROR(H5E_IO, H5E_BADRANGE, FAIL, "attempting I/O in temporary file space")
 
+    /* Drop any part of the metadata cache image that is overwritten */
+    if(f->shared->cache && H5AC_invalidate_cache_image(f->shared->cache, addr, size) < 0)
+        HGOTO_ERROR(H5E_IO, H5E_CANTREMOVE, FAIL, "can't invalidate metadata cache image")
+
     /* Treat global heap as raw data */
     map_type = (type == H5FD_MEM_GHEAP) ? H5FD_MEM_DRAW : type;
 
@@ -191,11 +275,165 @@ HDfprintf(stderr, "%s: write to addr = %a, size = %Zu\n", FUNC, addr, size);
     if(NULL == (fio_info.dxpl = (H5P_genplist_t *)H5I_object(my_dxpl_id)))
         HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "can't get property list")
 
+    /* Pass through page buffer layer, if enabled */
+    if(f->shared->page_buf) {
+        if(H5F__page_write(&fio_info, map_type, addr, size, buf) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "write through page buffer failed")
+    } /* end if */
     /* Pass through metadata accumulator layer */
-    if(H5F__accum_write(&fio_info, map_type, addr, size, buf) < 0)
+    else if(H5F__accum_write(&fio_info, map_type, addr, size, buf) < 0)
         HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "write through metadata accumulator failed")
 
 done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5F_block_write() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5F_block_readv
+ *
+ * Purpose:	Reads a list of COUNT blocks from the file in one request.
+ *		Block U is SIZES[U] bytes at ADDRS[U], relative to the base
+ *		address for the file.  Raw data goes straight to the file
+ *		driver's vector I/O routine; metadata still passes through
+ *		the metadata accumulator (and all blocks through the page
+ *		buffer, when enabled) one block at a time.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5F_block_readv(const H5F_t *f, H5FD_mem_t type, size_t count,
+    const haddr_t addrs[], const size_t sizes[], hid_t dxpl_id, void *bufs[]/*out*/)
+{
+    H5F_io_info_t fio_info;             /* I/O info for operation */
+    H5FD_mem_t  map_type;               /* Mapped memory type */
+    hid_t       my_dxpl_id = dxpl_id;   /* transfer property to use for I/O */
+    size_t      u;                      /* Local index variable */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    HDassert(f);
+    HDassert(f->shared);
+    HDassert(0 == count || (addrs && sizes && bufs));
+
+    /* Check for attempting I/O on 'temporary' file address */
+    for(u = 0; u < count; u++) {
+        HDassert(H5F_addr_defined(addrs[u]));
+        if(H5F_addr_le(f->shared->tmp_addr, (addrs[u] + sizes[u])))
+            HGOTO_ERROR(H5E_IO, H5E_BADRANGE, FAIL, "attempting I/O in temporary file space")
+    } /* end for */
+
+    /* Treat global heap as raw data */
+    map_type = (type == H5FD_MEM_GHEAP) ? H5FD_MEM_DRAW : type;
+
+#ifdef H5_DEBUG_BUILD
+    /* GHEAP type is treated as RAW, so update the dxpl type property too */
+    if(H5FD_MEM_GHEAP == type)
+        my_dxpl_id = H5AC_rawdata_dxpl_id;
+#endif /* H5_DEBUG_BUILD */
+
+    /* Set up I/O info for operation */
+    fio_info.f = f;
+    if(NULL == (fio_info.dxpl = (H5P_genplist_t *)H5I_object(my_dxpl_id)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "can't get property list")
+
+    /* Blocks may live in the page buffer, so they go one at a time */
+    if(f->shared->page_buf) {
+        for(u = 0; u < count; u++)
+            if(H5F__page_read(&fio_info, map_type, addrs[u], sizes[u], bufs[u]) < 0)
+                HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "read through page buffer failed")
+    } /* end if */
+    /* Metadata may live in the accumulator, so it goes one block at a time */
+    else if((f->shared->feature_flags & H5FD_FEAT_ACCUMULATE_METADATA) && map_type != H5FD_MEM_DRAW) {
+        for(u = 0; u < count; u++)
+            if(H5F__accum_read(&fio_info, map_type, addrs[u], sizes[u], bufs[u]) < 0)
+                HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "read through metadata accumulator failed")
+    } /* end if */
+    else
+        if(H5FD_readv(f->shared->lf, fio_info.dxpl, map_type, count, addrs, sizes, bufs) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "driver vector read request failed")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5F_block_readv() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5F_block_writev
+ *
+ * Purpose:	Writes a list of COUNT blocks to the file in one request.
+ *		Block U is SIZES[U] bytes at ADDRS[U], relative to the base
+ *		address for the file.  Raw data goes straight to the file
+ *		driver's vector I/O routine; metadata still passes through
+ *		the metadata accumulator (and all blocks through the page
+ *		buffer, when enabled) one block at a time.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5F_block_writev(const H5F_t *f, H5FD_mem_t type, size_t count,
+    const haddr_t addrs[], const size_t sizes[], hid_t dxpl_id, const void *bufs[])
+{
+    H5F_io_info_t fio_info;             /* I/O info for operation */
+    H5FD_mem_t  map_type;               /* Mapped memory type */
+    hid_t       my_dxpl_id = dxpl_id;   /* transfer property to use for I/O */
+    size_t      u;                      /* Local index variable */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    HDassert(f);
+    HDassert(f->shared);
+    HDassert(H5F_INTENT(f) & H5F_ACC_RDWR);
+    HDassert(0 == count || (addrs && sizes && bufs));
+
+    /* Check for attempting I/O on 'temporary' file address */
+    for(u = 0; u < count; u++) {
+        HDassert(H5F_addr_defined(addrs[u]));
+        if(H5F_addr_le(f->shared->tmp_addr, (addrs[u] + sizes[u])))
+            HGOTO_ERROR(H5E_IO, H5E_BADRANGE, FAIL, "attempting I/O in temporary file space")
+
+        /* Drop any part of the metadata cache image that is overwritten */
+        if(f->shared->cache && H5AC_invalidate_cache_image(f->shared->cache, addrs[u], sizes[u]) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_CANTREMOVE, FAIL, "can't invalidate metadata cache image")
+    } /* end for */
+
+    /* Treat global heap as raw data */
+    map_type = (type == H5FD_MEM_GHEAP) ? H5FD_MEM_DRAW : type;
+
+#ifdef H5_DEBUG_BUILD
+    /* GHEAP type is treated as RAW, so update the dxpl type property too */
+    if(H5FD_MEM_GHEAP == type)
+        my_dxpl_id = H5AC_rawdata_dxpl_id;
+#endif /* H5_DEBUG_BUILD */
+
+    /* Set up I/O info for operation */
+    fio_info.f = f;
+    if(NULL == (fio_info.dxpl = (H5P_genplist_t *)H5I_object(my_dxpl_id)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "can't get property list")
+
+    /* Blocks may live in the page buffer, so they go one at a time */
+    if(f->shared->page_buf) {
+        for(u = 0; u < count; u++)
+            if(H5F__page_write(&fio_info, map_type, addrs[u], sizes[u], bufs[u]) < 0)
+                HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "write through page buffer failed")
+    } /* end if */
+    /* Metadata may live in the accumulator, so it goes one block at a time */
+    else if((f->shared->feature_flags & H5FD_FEAT_ACCUMULATE_METADATA) && map_type != H5FD_MEM_DRAW) {
+        for(u = 0; u < count; u++)
+            if(H5F__accum_write(&fio_info, map_type, addrs[u], sizes[u], bufs[u]) < 0)
+                HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "write through metadata accumulator failed")
+    } /* end if */
+    else
+        if(H5FD_writev(f->shared->lf, fio_info.dxpl, map_type, count, addrs, sizes, bufs) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "driver vector write request failed")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5F_block_writev() */
+
@@ -0,0 +1,736 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * Copyright by the Board of Trustees of the University of Illinois.         *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of HDF5.  The full HDF5 copyright notice, including     *
+ * terms governing use, modification, and redistribution, is contained in    *
+ * the files COPYING and Copyright.html.  COPYING can be found at the root   *
+ * of the source code distribution tree; Copyright.html can be found at the  *
+ * root level of an installed copy of the electronic HDF5 document set and   *
+ * is linked from the top-level documents page.  It can also be found at     *
+ * http://hdfgroup.org/HDF5/doc/Copyright.html.  If you do not have          *
+ * access to either file, you may request a copy from help@hdfgroup.org.     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/*-------------------------------------------------------------------------
+ *
+ * Created:             H5Fpage.c
+ *
+ * Purpose:             File "page buffer" routines.  (Used to cache whole
+ *                      file space pages of files that use paged aggregation,
+ *                      so that small metadata and raw data I/Os are turned
+ *                      into page sized I/Os on page boundaries)
+ *
+ *-------------------------------------------------------------------------
+ */
+
+/****************/
+/* Module Setup */
+/****************/
+
+#include "H5Fmodule.h"          /* This source code file is part of the H5F module */
+
+
+/***********/
+/* Headers */
+/***********/
+#include "H5private.h"		/* Generic Functions			*/
+#include "H5Eprivate.h"		/* Error handling		  	*/
+#include "H5Fpkg.h"             /* File access				*/
+#include "H5FDprivate.h"	/* File drivers				*/
+#include "H5Iprivate.h"		/* IDs			  		*/
+#include "H5MMprivate.h"	/* Memory management			*/
+
+
+/****************/
+/* Local Macros */
+/****************/
+
+/* Kind of page used for a given (mapped) memory type */
+#define H5F_PAGE_KIND(T)        ((T) == H5FD_MEM_DRAW ? H5F_PAGE_RAW : H5F_PAGE_META)
+
+/* Memory type used when moving a page of the given kind to/from the file */
+#define H5F_PAGE_IO_TYPE(K)     ((K) == H5F_PAGE_RAW ? H5FD_MEM_DRAW : H5FD_MEM_DEFAULT)
+
+/* Unlink a page from the LRU list */
+#define H5F_PAGE_LRU_REMOVE(PB, PG)                                           \
+{                                                                             \
+    if((PG)->prev)                                                            \
+        (PG)->prev->next = (PG)->next;                                        \
+    else                                                                      \
+        (PB)->lru_head = (PG)->next;                                          \
+    if((PG)->next)                                                            \
+        (PG)->next->prev = (PG)->prev;                                        \
+    else                                                                      \
+        (PB)->lru_tail = (PG)->prev;                                          \
+    (PG)->prev = (PG)->next = NULL;                                           \
+}
+
+/* Link a page at the head (most recently used end) of the LRU list */
+#define H5F_PAGE_LRU_PREPEND(PB, PG)                                          \
+{                                                                             \
+    (PG)->prev = NULL;                                                        \
+    (PG)->next = (PB)->lru_head;                                              \
+    if((PB)->lru_head)                                                        \
+        (PB)->lru_head->prev = (PG);                                          \
+    else                                                                      \
+        (PB)->lru_tail = (PG);                                                \
+    (PB)->lru_head = (PG);                                                    \
+}
+
+
+/******************/
+/* Local Typedefs */
+/******************/
+
+
+/********************/
+/* Package Typedefs */
+/********************/
+
+
+/********************/
+/* Local Prototypes */
+/********************/
+static herr_t H5F__page_evict(const H5F_io_info_t *fio_info, H5F_page_t *page);
+static herr_t H5F__page_make_space(const H5F_io_info_t *fio_info,
+    unsigned kind, hbool_t *made_space);
+static herr_t H5F__page_protect(const H5F_io_info_t *fio_info, H5FD_mem_t type,
+    haddr_t page_addr, H5F_page_t **page);
+static herr_t H5F__page_free_cb(void *item, void *key, void *op_data);
+
+
+/*********************/
+/* Package Variables */
+/*********************/
+
+
+/*****************************/
+/* Library Private Variables */
+/*****************************/
+
+
+/*******************/
+/* Local Variables */
+/*******************/
+
+/* Declare a free list to manage the page buffer struct */
+H5FL_DEFINE_STATIC(H5F_page_buf_t);
+
+/* Declare a free list to manage the page struct */
+H5FL_DEFINE_STATIC(H5F_page_t);
+
+/* Declare a free list to manage the page contents */
+H5FL_BLK_DEFINE_STATIC(page_buf);
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5F__page_create
+ *
+ * Purpose:	Create a page buffer of SIZE bytes for a file that uses
+ *		paged aggregation.  MIN_META_PERC and MIN_RAW_PERC are the
+ *		percentages of the pages that are kept for metadata and
+ *		raw data respectively.
+ *
+ *		The page buffer replaces the metadata accumulator, which is
+ *		flushed and disabled for the file.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5F__page_create(H5F_t *f, hid_t dxpl_id, size_t size, unsigned min_meta_perc,
+    unsigned min_raw_perc)
+{
+    H5F_io_info_t fio_info;             /* I/O info for operation */
+    H5F_page_buf_t *pb = NULL;          /* New page buffer */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    /* Sanity checks */
+    HDassert(f);
+    HDassert(f->shared);
+    HDassert(NULL == f->shared->page_buf);
+    HDassert(min_meta_perc + min_raw_perc <= 100);
+
+    /* Check arguments */
+    if(0 == f->shared->fs_page_size)
+        HGOTO_ERROR(H5E_FILE, H5E_BADVALUE, FAIL, "page buffering requires a file created with a file space page size")
+    if(size < f->shared->fs_page_size)
+        HGOTO_ERROR(H5E_FILE, H5E_BADVALUE, FAIL, "page buffer size must be at least one page")
+    if(H5F_HAS_FEATURE(f, H5FD_FEAT_HAS_MPI))
+        HGOTO_ERROR(H5E_FILE, H5E_UNSUPPORTED, FAIL, "page buffering is not supported in parallel")
+    if(!H5F_HAS_FEATURE(f, H5FD_FEAT_AGGREGATE_METADATA) || !H5F_HAS_FEATURE(f, H5FD_FEAT_AGGREGATE_SMALLDATA))
+        HGOTO_ERROR(H5E_FILE, H5E_UNSUPPORTED, FAIL, "page buffering requires a file driver that aggregates allocations")
+
+    /* Set up I/O info for operation */
+    fio_info.f = f;
+    if(NULL == (fio_info.dxpl = (H5P_genplist_t *)H5I_object(dxpl_id)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "can't get property list")
+
+    /* Allocate the page buffer */
+    if(NULL == (pb = H5FL_CALLOC(H5F_page_buf_t)))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed")
+    pb->page_size = (size_t)f->shared->fs_page_size;
+    pb->max_pages = size / pb->page_size;
+    pb->min_pages[H5F_PAGE_META] = (pb->max_pages * min_meta_perc) / 100;
+    pb->min_pages[H5F_PAGE_RAW] = (pb->max_pages * min_raw_perc) / 100;
+    if(NULL == (pb->pages = H5SL_create(H5SL_TYPE_HADDR, NULL)))
+        HGOTO_ERROR(H5E_FILE, H5E_CANTCREATE, FAIL, "can't create skip list for pages")
+
+    /* The page buffer takes over from the metadata accumulator: write out
+     * and release anything held there, then turn it off for the file.
+     * (Must be reset while the feature flag is still set, to free the buffer)
+     */
+    if(H5F__accum_reset(&fio_info, TRUE) < 0)
+        HGOTO_ERROR(H5E_FILE, H5E_CANTRESET, FAIL, "can't reset metadata accumulator")
+    f->shared->feature_flags &= ~(unsigned long)H5FD_FEAT_ACCUMULATE_METADATA;
+
+    f->shared->page_buf = pb;
+
+done:
+    if(ret_value < 0 && pb) {
+        if(pb->pages)
+            H5SL_close(pb->pages);
+        pb = H5FL_FREE(H5F_page_buf_t, pb);
+    } /* end if */
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5F__page_create() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5F__page_evict
+ *
+ * Purpose:	Remove a page from the page buffer, writing it to the file
+ *		first if it is dirty.  Any part of the page past the end of
+ *		the file's allocated space is discarded.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5F__page_evict(const H5F_io_info_t *fio_info, H5F_page_t *page)
+{
+    H5F_page_buf_t *pb = fio_info->f->shared->page_buf;   /* Page buffer */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    HDassert(pb);
+    HDassert(page);
+
+    /* Write the page out if it is dirty */
+    if(page->dirty) {
+        H5FD_mem_t io_type = H5F_PAGE_IO_TYPE(page->kind);
+        haddr_t eoa;
+
+        if(HADDR_UNDEF == (eoa = H5FD_get_eoa(fio_info->f->shared->lf, io_type)))
+            HGOTO_ERROR(H5E_FILE, H5E_CANTGET, FAIL, "unable to get end of allocated space")
+        if(H5F_addr_lt(page->addr, eoa))
+            if(H5FD_write(fio_info->f->shared->lf, fio_info->dxpl, io_type, page->addr, (size_t)MIN(pb->page_size, eoa - page->addr), page->buf) < 0)
+                HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "unable to write page")
+    } /* end if */
+
+    /* Remove the page from the buffer */
+    if(NULL == H5SL_remove(pb->pages, &page->addr))
+        HGOTO_ERROR(H5E_FILE, H5E_CANTREMOVE, FAIL, "can't remove page from skip list")
+    H5F_PAGE_LRU_REMOVE(pb, page)
+    pb->npages[page->kind]--;
+    pb->evictions[page->kind]++;
+
+    /* Release the page */
+    page->buf = H5FL_BLK_FREE(page_buf, page->buf);
+    page = H5FL_FREE(H5F_page_t, page);
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5F__page_evict() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5F__page_make_space
+ *
+ * Purpose:	Evict the least recently used page that may be given up for
+ *		a page of kind KIND: any page of that kind, or a page of the
+ *		other kind when more than that kind's reserved number of
+ *		pages are held.  MADE_SPACE is set to FALSE when no page can
+ *		be evicted.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5F__page_make_space(const H5F_io_info_t *fio_info, unsigned kind,
+    hbool_t *made_space)
+{
+    H5F_page_buf_t *pb = fio_info->f->shared->page_buf;   /* Page buffer */
+    H5F_page_t *page;                   /* Page to consider */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    HDassert(pb);
+    HDassert(made_space);
+
+    *made_space = FALSE;
+    for(page = pb->lru_tail; page; page = page->prev)
+        if(page->kind == kind || pb->npages[page->kind] > pb->min_pages[page->kind]) {
+            if(H5F__page_evict(fio_info, page) < 0)
+                HGOTO_ERROR(H5E_FILE, H5E_CANTFREE, FAIL, "unable to evict page")
+            *made_space = TRUE;
+            break;
+        } /* end if */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5F__page_make_space() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5F__page_protect
+ *
+ * Purpose:	Find the page at PAGE_ADDR in the page buffer, loading it
+ *		from the file if it isn't held, and make it the most recently
+ *		used page.  *PAGE is set to NULL when the page isn't held and
+ *		no room can be made for it, in which case the access should
+ *		go directly to the file.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5F__page_protect(const H5F_io_info_t *fio_info, H5FD_mem_t type,
+    haddr_t page_addr, H5F_page_t **page)
+{
+    H5F_page_buf_t *pb = fio_info->f->shared->page_buf;   /* Page buffer */
+    unsigned    kind = H5F_PAGE_KIND(type); /* Kind of page */
+    H5F_page_t *new_page = NULL;        /* Page loaded */
+    haddr_t     eoa;                    /* End of allocated space */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    HDassert(pb);
+    HDassert(0 == (page_addr % pb->page_size));
+    HDassert(page);
+
+    pb->accesses[kind]++;
+
+    /* Check for the page being held already */
+    if(NULL != (*page = (H5F_page_t *)H5SL_search(pb->pages, &page_addr))) {
+        pb->hits[kind]++;
+        H5F_PAGE_LRU_REMOVE(pb, *page)
+        H5F_PAGE_LRU_PREPEND(pb, *page)
+        HGOTO_DONE(SUCCEED)
+    } /* end if */
+    pb->misses[kind]++;
+
+    /* Make room for the page, if necessary */
+    if((pb->npages[H5F_PAGE_META] + pb->npages[H5F_PAGE_RAW]) >= pb->max_pages) {
+        hbool_t made_space;
+
+        if(H5F__page_make_space(fio_info, kind, &made_space) < 0)
+            HGOTO_ERROR(H5E_FILE, H5E_CANTFREE, FAIL, "unable to make space in page buffer")
+        if(!made_space) {
+            pb->bypasses[kind]++;
+            HGOTO_DONE(SUCCEED)
+        } /* end if */
+    } /* end if */
+
+    /* Allocate the page */
+    if(NULL == (new_page = H5FL_CALLOC(H5F_page_t)))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed")
+    if(NULL == (new_page->buf = H5FL_BLK_MALLOC(page_buf, pb->page_size)))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed")
+    new_page->addr = page_addr;
+    new_page->kind = kind;
+
+    /* Load the allocated part of the page, zero-filling the rest */
+    if(HADDR_UNDEF == (eoa = H5FD_get_eoa(fio_info->f->shared->lf, type)))
+        HGOTO_ERROR(H5E_FILE, H5E_CANTGET, FAIL, "unable to get end of allocated space")
+    if(H5F_addr_lt(page_addr, eoa)) {
+        size_t read_size = (size_t)MIN(pb->page_size, eoa - page_addr);
+
+        if(H5FD_read(fio_info->f->shared->lf, fio_info->dxpl, type, page_addr, read_size, new_page->buf) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "unable to read page")
+        if(read_size < pb->page_size)
+            HDmemset(new_page->buf + read_size, 0, pb->page_size - read_size);
+    } /* end if */
+    else
+        HDmemset(new_page->buf, 0, pb->page_size);
+
+    /* Add the page to the buffer */
+    if(H5SL_insert(pb->pages, new_page, &new_page->addr) < 0)
+        HGOTO_ERROR(H5E_FILE, H5E_CANTINSERT, FAIL, "can't insert page into skip list")
+    H5F_PAGE_LRU_PREPEND(pb, new_page)
+    pb->npages[kind]++;
+
+    *page = new_page;
+    new_page = NULL;
+
+done:
+    if(new_page) {
+        if(new_page->buf)
+            new_page->buf = H5FL_BLK_FREE(page_buf, new_page->buf);
+        new_page = H5FL_FREE(H5F_page_t, new_page);
+    } /* end if */
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5F__page_protect() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5F__page_read
+ *
+ * Purpose:	Read some data through the page buffer.  Accesses smaller
+ *		than a page are satisfied from the (one or two) pages they
+ *		touch; larger accesses go directly to the file, with any
+ *		newer data from dirty pages copied over the result.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5F__page_read(const H5F_io_info_t *fio_info, H5FD_mem_t type, haddr_t addr,
+    size_t size, void *_buf)
+{
+    H5F_page_buf_t *pb;                 /* Page buffer */
+    unsigned char *buf = (unsigned char *)_buf; /* Pointer to buffer */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    /* Sanity checks */
+    HDassert(fio_info);
+    HDassert(fio_info->f->shared->page_buf);
+    HDassert(buf);
+
+    pb = fio_info->f->shared->page_buf;
+
+    if(size >= pb->page_size) {
+        haddr_t page_addr = addr - (addr % pb->page_size);
+        H5SL_node_t *node;
+
+        pb->accesses[H5F_PAGE_KIND(type)]++;
+        pb->bypasses[H5F_PAGE_KIND(type)]++;
+
+        if(H5FD_read(fio_info->f->shared->lf, fio_info->dxpl, type, addr, size, buf) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "driver read request failed")
+
+        /* Overlay newer data from dirty pages */
+        for(node = H5SL_above(pb->pages, &page_addr); node; node = H5SL_next(node)) {
+            H5F_page_t *page = (H5F_page_t *)H5SL_item(node);
+            haddr_t start, end;
+
+            if(H5F_addr_ge(page->addr, addr + size))
+                break;
+            if(!page->dirty)
+                continue;
+            start = MAX(addr, page->addr);
+            end = MIN(addr + size, page->addr + pb->page_size);
+            HDmemcpy(buf + (start - addr), page->buf + (start - page->addr), (size_t)(end - start));
+        } /* end for */
+    } /* end if */
+    else {
+        while(size > 0) {
+            haddr_t page_addr = addr - (addr % pb->page_size);
+            size_t offset = (size_t)(addr - page_addr);
+            size_t len = MIN(size, pb->page_size - offset);
+            H5F_page_t *page;
+
+            if(H5F__page_protect(fio_info, type, page_addr, &page) < 0)
+                HGOTO_ERROR(H5E_FILE, H5E_CANTLOAD, FAIL, "unable to load page")
+            if(page)
+                HDmemcpy(buf, page->buf + offset, len);
+            else
+                if(H5FD_read(fio_info->f->shared->lf, fio_info->dxpl, type, addr, len, buf) < 0)
+                    HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "driver read request failed")
+
+            addr += len;
+            buf += len;
+            size -= len;
+        } /* end while */
+    } /* end else */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5F__page_read() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5F__page_write
+ *
+ * Purpose:	Write some data through the page buffer.  Accesses smaller
+ *		than a page update the (one or two) pages they touch, which
+ *		are written to the file when evicted or flushed; larger
+ *		accesses go directly to the file and also update any pages
+ *		held for that range.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5F__page_write(const H5F_io_info_t *fio_info, H5FD_mem_t type, haddr_t addr,
+    size_t size, const void *_buf)
+{
+    H5F_page_buf_t *pb;                 /* Page buffer */
+    const unsigned char *buf = (const unsigned char *)_buf; /* Pointer to buffer */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    /* Sanity checks */
+    HDassert(fio_info);
+    HDassert(fio_info->f->shared->page_buf);
+    HDassert(buf);
+
+    pb = fio_info->f->shared->page_buf;
+
+    if(size >= pb->page_size) {
+        haddr_t page_addr = addr - (addr % pb->page_size);
+        H5SL_node_t *node;
+
+        pb->accesses[H5F_PAGE_KIND(type)]++;
+        pb->bypasses[H5F_PAGE_KIND(type)]++;
+
+        if(H5FD_write(fio_info->f->shared->lf, fio_info->dxpl, type, addr, size, buf) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "driver write request failed")
+
+        /* Keep pages held for the range up to date */
+        for(node = H5SL_above(pb->pages, &page_addr); node; node = H5SL_next(node)) {
+            H5F_page_t *page = (H5F_page_t *)H5SL_item(node);
+            haddr_t start, end;
+
+            if(H5F_addr_ge(page->addr, addr + size))
+                break;
+            start = MAX(addr, page->addr);
+            end = MIN(addr + size, page->addr + pb->page_size);
+            HDmemcpy(page->buf + (start - page->addr), buf + (start - addr), (size_t)(end - start));
+        } /* end for */
+    } /* end if */
+    else {
+        while(size > 0) {
+            haddr_t page_addr = addr - (addr % pb->page_size);
+            size_t offset = (size_t)(addr - page_addr);
+            size_t len = MIN(size, pb->page_size - offset);
+            H5F_page_t *page;
+
+            if(H5F__page_protect(fio_info, type, page_addr, &page) < 0)
+                HGOTO_ERROR(H5E_FILE, H5E_CANTLOAD, FAIL, "unable to load page")
+            if(page) {
+                HDmemcpy(page->buf + offset, buf, len);
+                page->dirty = TRUE;
+            } /* end if */
+            else
+                if(H5FD_write(fio_info->f->shared->lf, fio_info->dxpl, type, addr, len, buf) < 0)
+                    HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "driver write request failed")
+
+            addr += len;
+            buf += len;
+            size -= len;
+        } /* end while */
+    } /* end else */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5F__page_write() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5F__page_free
+ *
+ * Purpose:	Drop any pages that lie entirely within a block of file
+ *		space being freed, without writing them to the file.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5F__page_free(const H5F_t *f, haddr_t addr, hsize_t size)
+{
+    H5F_page_buf_t *pb;                 /* Page buffer */
+    H5SL_node_t *node;                  /* Current skip list node */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    HDassert(f);
+    HDassert(f->shared);
+
+    /* Nothing to do if there's no page buffer, or no whole page to drop */
+    pb = f->shared->page_buf;
+    if(NULL == pb || size < pb->page_size)
+        HGOTO_DONE(SUCCEED)
+
+    node = H5SL_above(pb->pages, &addr);
+    while(node) {
+        H5F_page_t *page = (H5F_page_t *)H5SL_item(node);
+
+        if(H5F_addr_gt(page->addr + pb->page_size, addr + size))
+            break;
+        node = H5SL_next(node);
+
+        if(NULL == H5SL_remove(pb->pages, &page->addr))
+            HGOTO_ERROR(H5E_FILE, H5E_CANTREMOVE, FAIL, "can't remove page from skip list")
+        H5F_PAGE_LRU_REMOVE(pb, page)
+        pb->npages[page->kind]--;
+        page->buf = H5FL_BLK_FREE(page_buf, page->buf);
+        page = H5FL_FREE(H5F_page_t, page);
+    } /* end while */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5F__page_free() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5F__page_flush
+ *
+ * Purpose:	Write all dirty pages to the file.  The dirty pages of each
+ *		kind are written in address order with one vector request.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5F__page_flush(const H5F_io_info_t *fio_info)
+{
+    H5F_page_buf_t *pb;                 /* Page buffer */
+    haddr_t    *addrs = NULL;           /* Addresses of pages to write */
+    size_t     *sizes = NULL;           /* Sizes of pages to write */
+    const void **bufs = NULL;           /* Contents of pages to write */
+    size_t      npages;                 /* # of pages held */
+    unsigned    kind;                   /* Kind of page to write */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    HDassert(fio_info);
+
+    pb = fio_info->f->shared->page_buf;
+    if(NULL == pb || 0 == (npages = pb->npages[H5F_PAGE_META] + pb->npages[H5F_PAGE_RAW]))
+        HGOTO_DONE(SUCCEED)
+
+    /* Allocate the vectors for the largest possible request */
+    if(NULL == (addrs = (haddr_t *)H5MM_malloc(npages * sizeof(haddr_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed")
+    if(NULL == (sizes = (size_t *)H5MM_malloc(npages * sizeof(size_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed")
+    if(NULL == (bufs = (const void **)H5MM_malloc(npages * sizeof(void *))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed")
+
+    for(kind = 0; kind < H5F_PAGE_NKINDS; kind++) {
+        H5FD_mem_t io_type = H5F_PAGE_IO_TYPE(kind);
+        H5SL_node_t *node;
+        haddr_t eoa;
+        size_t count = 0;
+
+        if(0 == pb->npages[kind])
+            continue;
+        if(HADDR_UNDEF == (eoa = H5FD_get_eoa(fio_info->f->shared->lf, io_type)))
+            HGOTO_ERROR(H5E_FILE, H5E_CANTGET, FAIL, "unable to get end of allocated space")
+
+        /* Gather the dirty pages, trimmed to the allocated space */
+        for(node = H5SL_first(pb->pages); node; node = H5SL_next(node)) {
+            H5F_page_t *page = (H5F_page_t *)H5SL_item(node);
+
+            if(page->kind != kind || !page->dirty)
+                continue;
+            page->dirty = FALSE;
+            if(H5F_addr_ge(page->addr, eoa))
+                continue;
+            addrs[count] = page->addr;
+            sizes[count] = (size_t)MIN(pb->page_size, eoa - page->addr);
+            bufs[count] = page->buf;
+            count++;
+        } /* end for */
+
+        if(count > 0)
+            if(H5FD_writev(fio_info->f->shared->lf, fio_info->dxpl, io_type, count, addrs, sizes, bufs) < 0)
+                HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "unable to write pages")
+    } /* end for */
+
+done:
+    H5MM_xfree(addrs);
+    H5MM_xfree(sizes);
+    H5MM_xfree(bufs);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5F__page_flush() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5F__page_free_cb
+ *
+ * Purpose:	Skip list callback to release a page.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5F__page_free_cb(void *item, void H5_ATTR_UNUSED *key, void H5_ATTR_UNUSED *op_data)
+{
+    H5F_page_t *page = (H5F_page_t *)item;
+
+    FUNC_ENTER_STATIC_NOERR
+
+    HDassert(page);
+
+    page->buf = H5FL_BLK_FREE(page_buf, page->buf);
+    page = H5FL_FREE(H5F_page_t, page);
+
+    FUNC_LEAVE_NOAPI(SUCCEED)
+} /* end H5F__page_free_cb() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5F__page_dest
+ *
+ * Purpose:	Write out any dirty pages and release the file's page
+ *		buffer.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5F__page_dest(const H5F_io_info_t *fio_info)
+{
+    H5F_page_buf_t *pb;                 /* Page buffer */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    HDassert(fio_info);
+
+    pb = fio_info->f->shared->page_buf;
+    if(NULL == pb)
+        HGOTO_DONE(SUCCEED)
+
+    /* Write out dirty pages */
+    if(H5F__page_flush(fio_info) < 0)
+        HDONE_ERROR(H5E_FILE, H5E_CANTFLUSH, FAIL, "unable to flush page buffer")
+
+    /* Release the pages and the buffer */
+    if(H5SL_destroy(pb->pages, H5F__page_free_cb, NULL) < 0)
+        HDONE_ERROR(H5E_FILE, H5E_CANTCLOSEOBJ, FAIL, "can't destroy skip list of pages")
+    pb = H5FL_FREE(H5F_page_buf_t, pb);
+    fio_info->f->shared->page_buf = NULL;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5F__page_dest() */
+
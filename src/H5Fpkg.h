@@ -42,6 +42,7 @@
 #include "H5FSprivate.h"	/* File free space                      */
 #include "H5Gprivate.h"		/* Groups 			  	*/
 #include "H5Oprivate.h"         /* Object header messages               */
+#include "H5SLprivate.h"	/* Skip lists				*/
 #include "H5UCprivate.h"	/* Reference counted object functions	*/
 
 
@@ -59,7 +60,7 @@
 #define H5F_SUPER_ALL_FLAGS             (H5F_SUPER_WRITE_ACCESS | H5F_SUPER_FILE_OK)
 
 /* Mask for removing private file access flags */
-#define H5F_ACC_PUBLIC_FLAGS 	        0x001fu
+#define H5F_ACC_PUBLIC_FLAGS 	        0x007fu
 
 /* Free space section+aggregator merge flags */
 #define H5F_FS_MERGE_METADATA           0x01    /* Section can merge with metadata aggregator */
@@ -180,6 +181,40 @@ typedef struct H5F_meta_accum_t {
     hbool_t             dirty;          /* Flag to indicate that the accumulated metadata is dirty */
 } H5F_meta_accum_t;
 
+/* Kinds of pages held in the page buffer (used to index the per-kind
+ * limits and statistics below) */
+#define H5F_PAGE_META   0               /* Page holds metadata */
+#define H5F_PAGE_RAW    1               /* Page holds raw data */
+#define H5F_PAGE_NKINDS 2               /* Number of page kinds */
+
+/* A file space page held in the page buffer */
+typedef struct H5F_page_t {
+    haddr_t             addr;           /* File address of the page (page aligned) */
+    unsigned char      *buf;            /* Page contents */
+    unsigned            kind;           /* H5F_PAGE_META or H5F_PAGE_RAW */
+    hbool_t             dirty;          /* Whether the page must be written out */
+    struct H5F_page_t  *prev;           /* Previous (more recently used) page on LRU list */
+    struct H5F_page_t  *next;           /* Next (less recently used) page on LRU list */
+} H5F_page_t;
+
+/* Page buffer for files using paged aggregation */
+typedef struct H5F_page_buf_t {
+    size_t              page_size;      /* Size of each page (the file space page size) */
+    size_t              max_pages;      /* Maximum # of pages held */
+    size_t              min_pages[H5F_PAGE_NKINDS]; /* # of pages reserved for each kind */
+    size_t              npages[H5F_PAGE_NKINDS]; /* # of pages currently held for each kind */
+    H5SL_t             *pages;          /* Pages held, indexed by address */
+    H5F_page_t         *lru_head;       /* Most recently used page */
+    H5F_page_t         *lru_tail;       /* Least recently used page */
+
+    /* Statistics */
+    unsigned            accesses[H5F_PAGE_NKINDS]; /* # of page accesses */
+    unsigned            hits[H5F_PAGE_NKINDS];  /* # of accesses satisfied by a held page */
+    unsigned            misses[H5F_PAGE_NKINDS]; /* # of accesses that loaded a page */
+    unsigned            evictions[H5F_PAGE_NKINDS]; /* # of pages evicted */
+    unsigned            bypasses[H5F_PAGE_NKINDS]; /* # of accesses that went directly to the file */
+} H5F_page_buf_t;
+
 /* Enum for free space manager state */
 typedef enum H5F_fs_state_t {
     H5F_FS_STATE_CLOSED,                /* Free space manager is closed */
@@ -264,11 +299,15 @@ struct H5F_file_t {
     size_t	rdcc_nslots;	/* Size of raw data chunk cache (slots)	*/
     size_t	rdcc_nbytes;	/* Size of raw data chunk cache	(bytes)	*/
     double	rdcc_w0;	/* Preempt read chunks first? [0.0..1.0]*/
+    size_t	rdcc_shared_nbytes; /* Size of raw data chunk cache shared by all datasets (bytes), 0 if not shared */
+    struct H5D_rdcc_pool_t *rdcc_pool; /* Raw data chunk cache memory shared by all datasets */
     size_t      sieve_buf_size; /* Size of the data sieve buffer allocated (in bytes) */
     hsize_t	threshold;	/* Threshold for alignment		*/
     hsize_t	alignment;	/* Alignment				*/
     unsigned	gc_ref;		/* Garbage-collect references?		*/
     hbool_t	latest_format;	/* Always use the latest format?	*/
+    hbool_t	mdc_image;	/* Write a metadata cache image on close? */
+    unsigned	read_attempts;	/* # of times to try reading metadata that fails its checksum */
     hbool_t	store_msg_crt_idx;  /* Store creation index for object header messages?	*/
     unsigned	ncwfs;		/* Num entries on cwfs list		*/
     struct H5HG_heap_t **cwfs;	/* Global heap cache			*/
@@ -279,6 +318,7 @@ struct H5F_file_t {
     /* File space allocation information */
     H5F_file_space_type_t fs_strategy;	/* File space handling strategy		*/
     hsize_t     fs_threshold;	/* Free space section threshold 	*/
+    hsize_t     fs_page_size;   /* File space page size (0 if not paged) */
     hbool_t     use_tmp_space;  /* Whether temp. file space allocation is allowed */
     haddr_t	tmp_addr;       /* Next address to use for temp. space in the file */
     unsigned fs_aggr_merge[H5FD_MEM_NTYPES];    /* Flags for whether free space can merge with aggregator(s) */
@@ -293,6 +333,9 @@ struct H5F_file_t {
 
     /* Metadata accumulator information */
     H5F_meta_accum_t accum;     /* Metadata accumulator info           	*/
+
+    /* Page buffer information */
+    H5F_page_buf_t *page_buf;   /* Page buffer (NULL if not enabled)    */
 };
 
 /*
@@ -345,6 +388,7 @@ H5_DLL htri_t H5F_is_hdf5(const char *name, hid_t dxpl_id);
 H5_DLL herr_t H5F_get_objects(const H5F_t *f, unsigned types, size_t max_index, hid_t *obj_id_list, hbool_t app_ref, size_t *obj_id_count_ptr);
 H5_DLL ssize_t H5F_get_file_image(H5F_t *f, void *buf_ptr, size_t buf_len, hid_t dxpl_id);
 H5_DLL herr_t H5F_close(H5F_t *f);
+H5_DLL herr_t H5F__set_paged_aggr(H5F_t *f, hsize_t page_size);
 
 /* File mount related routines */
 H5_DLL herr_t H5F_close_mounts(H5F_t *f);
@@ -354,12 +398,13 @@ H5_DLL herr_t H5F_mount_count_ids(H5F_t *f, unsigned *nopen_files, unsigned *nop
 /* Superblock related routines */
 H5_DLL herr_t H5F__super_init(H5F_t *f, hid_t dxpl_id);
 H5_DLL herr_t H5F__super_read(H5F_t *f, hid_t dxpl_id);
+H5_DLL herr_t H5F__super_write_cache_image(H5F_t *f, hid_t dxpl_id);
 H5_DLL herr_t H5F__super_size(H5F_t *f, hid_t dxpl_id, hsize_t *super_size, hsize_t *super_ext_size);
 H5_DLL herr_t H5F__super_free(H5F_super_t *sblock);
 
 /* Superblock extension related routines */
 H5_DLL herr_t H5F_super_ext_open(H5F_t *f, haddr_t ext_addr, H5O_loc_t *ext_ptr);
-H5_DLL herr_t H5F_super_ext_write_msg(H5F_t *f, hid_t dxpl_id, void *mesg, unsigned id, hbool_t may_create);
+H5_DLL herr_t H5F_super_ext_write_msg(H5F_t *f, hid_t dxpl_id, void *mesg, unsigned id, hbool_t may_create, unsigned mesg_flags);
 H5_DLL herr_t H5F_super_ext_remove_msg(H5F_t *f, hid_t dxpl_id, unsigned id);
 H5_DLL herr_t H5F_super_ext_close(H5F_t *f, H5O_loc_t *ext_ptr, hid_t dxpl_id,
     hbool_t was_created);
@@ -374,6 +419,17 @@ H5_DLL herr_t H5F__accum_free(const H5F_io_info_t *fio_info, H5FD_mem_t type,
 H5_DLL herr_t H5F__accum_flush(const H5F_io_info_t *fio_info);
 H5_DLL herr_t H5F__accum_reset(const H5F_io_info_t *fio_info, hbool_t flush);
 
+/* Page buffer routines */
+H5_DLL herr_t H5F__page_create(H5F_t *f, hid_t dxpl_id, size_t size,
+    unsigned min_meta_perc, unsigned min_raw_perc);
+H5_DLL herr_t H5F__page_read(const H5F_io_info_t *fio_info, H5FD_mem_t type,
+    haddr_t addr, size_t size, void *buf);
+H5_DLL herr_t H5F__page_write(const H5F_io_info_t *fio_info, H5FD_mem_t type,
+    haddr_t addr, size_t size, const void *buf);
+H5_DLL herr_t H5F__page_free(const H5F_t *f, haddr_t addr, hsize_t size);
+H5_DLL herr_t H5F__page_flush(const H5F_io_info_t *fio_info);
+H5_DLL herr_t H5F__page_dest(const H5F_io_info_t *fio_info);
+
 /* Shared file list related routines */
 H5_DLL herr_t H5F_sfile_add(H5F_file_t *shared);
 H5_DLL H5F_file_t * H5F_sfile_search(H5FD_t *lf);
@@ -396,6 +452,7 @@ H5_DLL herr_t H5F_get_sohm_mesg_count_test(hid_t fid, unsigned type_id,
     size_t *mesg_count);
 H5_DLL herr_t H5F_check_cached_stab_test(hid_t file_id);
 H5_DLL herr_t H5F_get_maxaddr_test(hid_t file_id, haddr_t *maxaddr);
+H5_DLL herr_t H5F_get_mdc_image_stats_test(hid_t file_id, unsigned *nentries, unsigned *nhits);
 #endif /* H5F_TESTING */
 
 #endif /* _H5Fpkg_H */
@@ -306,6 +306,9 @@
 #define H5F_RDCC_NSLOTS(F)      ((F)->shared->rdcc_nslots)
 #define H5F_RDCC_NBYTES(F)      ((F)->shared->rdcc_nbytes)
 #define H5F_RDCC_W0(F)          ((F)->shared->rdcc_w0)
+#define H5F_RDCC_SHARED_NBYTES(F) ((F)->shared->rdcc_shared_nbytes)
+#define H5F_RDCC_POOL(F)        ((F)->shared->rdcc_pool)
+#define H5F_SET_RDCC_POOL(F, P) ((F)->shared->rdcc_pool = (P), SUCCEED)
 #define H5F_SIEVE_BUF_SIZE(F)   ((F)->shared->sieve_buf_size)
 #define H5F_GC_REF(F)           ((F)->shared->gc_ref)
 #define H5F_USE_LATEST_FORMAT(F) ((F)->shared->latest_format)
@@ -315,6 +318,7 @@
 #define H5F_SET_GRP_BTREE_SHARED(F, RC) (((F)->shared->grp_btree_shared = (RC)) ? SUCCEED : FAIL)
 #define H5F_USE_TMP_SPACE(F)    ((F)->shared->use_tmp_space)
 #define H5F_IS_TMP_ADDR(F, ADDR) (H5F_addr_le((F)->shared->tmp_addr, (ADDR)))
+#define H5F_GET_READ_ATTEMPTS(F) ((F)->shared->read_attempts)
 #ifdef H5_HAVE_PARALLEL
 #define H5F_COLL_MD_READ(F)     ((F)->coll_md_read)
 #endif /* H5_HAVE_PARALLEL */
@@ -351,6 +355,9 @@
 #define H5F_RDCC_NSLOTS(F)      (H5F_rdcc_nslots(F))
 #define H5F_RDCC_NBYTES(F)      (H5F_rdcc_nbytes(F))
 #define H5F_RDCC_W0(F)          (H5F_rdcc_w0(F))
+#define H5F_RDCC_SHARED_NBYTES(F) (H5F_rdcc_shared_nbytes(F))
+#define H5F_RDCC_POOL(F)        (H5F_rdcc_pool(F))
+#define H5F_SET_RDCC_POOL(F, P) (H5F_set_rdcc_pool((F), (P)))
 #define H5F_SIEVE_BUF_SIZE(F)   (H5F_sieve_buf_size(F))
 #define H5F_GC_REF(F)           (H5F_gc_ref(F))
 #define H5F_USE_LATEST_FORMAT(F) (H5F_use_latest_format(F))
@@ -360,6 +367,7 @@
 #define H5F_SET_GRP_BTREE_SHARED(F, RC) (H5F_set_grp_btree_shared((F), (RC)))
 #define H5F_USE_TMP_SPACE(F)    (H5F_use_tmp_space(F))
 #define H5F_IS_TMP_ADDR(F, ADDR) (H5F_is_tmp_addr((F), (ADDR)))
+#define H5F_GET_READ_ATTEMPTS(F) (H5F_get_read_attempts(F))
 #ifdef H5_HAVE_PARALLEL
 #define H5F_COLL_MD_READ(F)     (H5F_coll_md_read(F))
 #endif /* H5_HAVE_PARALLEL */
@@ -437,6 +445,7 @@
 #define H5F_CRT_SHMSG_BTREE_MIN_NAME "shmsg_btree_min"  /* Shared message B-tree minimum size */
 #define H5F_CRT_FILE_SPACE_STRATEGY_NAME "file_space_strategy"  /* File space handling strategy */
 #define H5F_CRT_FREE_SPACE_THRESHOLD_NAME "free_space_threshold"  /* Free space section threshold */
+#define H5F_CRT_FILE_SPACE_PAGE_SIZE_NAME "file_space_page_size"  /* File space page size (0 if not paged) */
 
 
 
@@ -445,6 +454,7 @@
 #define H5F_ACS_DATA_CACHE_NUM_SLOTS_NAME       "rdcc_nslots"   /* Size of raw data chunk cache(slots) */
 #define H5F_ACS_DATA_CACHE_BYTE_SIZE_NAME       "rdcc_nbytes"   /* Size of raw data chunk cache(bytes) */
 #define H5F_ACS_PREEMPT_READ_CHUNKS_NAME        "rdcc_w0"       /* Preemption read chunks first */
+#define H5F_ACS_DATA_CACHE_SHARED_SIZE_NAME     "rdcc_shared_nbytes" /* Size of raw data chunk cache shared by all datasets (bytes) */
 #define H5F_ACS_ALIGN_THRHD_NAME                "threshold"     /* Threshold for alignment */
 #define H5F_ACS_ALIGN_NAME                      "align"         /* Alignment */
 #define H5F_ACS_META_BLOCK_SIZE_NAME            "meta_block_size" /* Minimum metadata allocation block size (when aggregating metadata allocations) */
@@ -464,6 +474,11 @@
 #define H5F_ACS_CORE_WRITE_TRACKING_FLAG_NAME       "core_write_tracking_flag" /* Whether or not core VFD backing store write tracking is enabled */
 #define H5F_ACS_CORE_WRITE_TRACKING_PAGE_SIZE_NAME  "core_write_tracking_page_size" /* The page size in kiB when core VFD write tracking is enabled */
 #define H5F_ACS_COLL_MD_WRITE_FLAG_NAME         "collective_metadata_write" /* property indicating whether metadata writes are done collectively or not */
+#define H5F_ACS_PAGE_BUFFER_SIZE_NAME           "page_buffer_size" /* Size of the page buffer (bytes) */
+#define H5F_ACS_PAGE_BUFFER_MIN_META_PERC_NAME  "page_buffer_min_meta_perc" /* Percentage of the page buffer kept for metadata pages */
+#define H5F_ACS_PAGE_BUFFER_MIN_RAW_PERC_NAME   "page_buffer_min_raw_perc" /* Percentage of the page buffer kept for raw data pages */
+#define H5F_ACS_META_CACHE_IMAGE_NAME           "mdc_image"     /* Whether to write a metadata cache image when the file is closed */
+#define H5F_ACS_METADATA_READ_ATTEMPTS_NAME     "metadata_read_attempts" /* # of times to try reading a piece of metadata that fails its checksum */
 
 /* ======================== File Mount properties ====================*/
 #define H5F_MNT_SYM_LOCAL_NAME 		"local"                 /* Whether absolute symlinks local to file. */
@@ -503,6 +518,17 @@
 #define H5F_FILE_SPACE_STRATEGY_DEF	        H5F_FILE_SPACE_ALL
 /* Default free space section threshold used by free-space managers */
 #define H5F_FREE_SPACE_THRESHOLD_DEF	        1
+/* Default file space page size (not paged) */
+#define H5F_FILE_SPACE_PAGE_SIZE_DEF	        0
+/* Minimum file space page size */
+#define H5F_FILE_SPACE_PAGE_SIZE_MIN	        512
+
+/* Default # of times to try reading a piece of metadata that fails its
+ *      checksum, for regular and for SWMR read access */
+#define H5F_METADATA_READ_ATTEMPTS              1
+#define H5F_SWMR_METADATA_READ_ATTEMPTS         100
+/* Maximum # of metadata read attempts */
+#define H5F_MAX_METADATA_READ_ATTEMPTS          1000
 
 /* Macros to define signatures of all objects in the file */
 
@@ -561,6 +587,7 @@
 
 /* Forward declarations (for prototypes & type definitions) */
 struct H5B_class_t;
+struct H5D_rdcc_pool_t;
 struct H5UC_t;
 struct H5O_loc_t;
 struct H5HG_heap_t;
@@ -639,6 +666,9 @@ H5_DLL H5F_close_degree_t H5F_get_fc_degree(const H5F_t *f);
 H5_DLL size_t H5F_rdcc_nbytes(const H5F_t *f);
 H5_DLL size_t H5F_rdcc_nslots(const H5F_t *f);
 H5_DLL double H5F_rdcc_w0(const H5F_t *f);
+H5_DLL size_t H5F_rdcc_shared_nbytes(const H5F_t *f);
+H5_DLL struct H5D_rdcc_pool_t *H5F_rdcc_pool(const H5F_t *f);
+H5_DLL herr_t H5F_set_rdcc_pool(H5F_t *f, struct H5D_rdcc_pool_t *pool);
 H5_DLL size_t H5F_sieve_buf_size(const H5F_t *f);
 H5_DLL unsigned H5F_gc_ref(const H5F_t *f);
 H5_DLL hbool_t H5F_use_latest_format(const H5F_t *f);
@@ -648,6 +678,7 @@ H5_DLL struct H5UC_t *H5F_grp_btree_shared(const H5F_t *f);
 H5_DLL herr_t H5F_set_grp_btree_shared(H5F_t *f, struct H5UC_t *rc);
 H5_DLL hbool_t H5F_use_tmp_space(const H5F_t *f);
 H5_DLL hbool_t H5F_is_tmp_addr(const H5F_t *f, haddr_t addr);
+H5_DLL unsigned H5F_get_read_attempts(const H5F_t *f);
 #ifdef H5_HAVE_PARALLEL
 H5_DLL H5P_coll_md_read_flag_t H5F_coll_md_read(const H5F_t *f);
 H5_DLL void H5F_set_coll_md_read(H5F_t *f, H5P_coll_md_read_flag_t flag);
@@ -658,6 +689,7 @@ H5_DLL hid_t H5F_get_driver_id(const H5F_t *f);
 H5_DLL herr_t H5F_get_fileno(const H5F_t *f, unsigned long *filenum);
 H5_DLL hbool_t H5F_has_feature(const H5F_t *f, unsigned feature);
 H5_DLL haddr_t H5F_get_eoa(const H5F_t *f, H5FD_mem_t type);
+H5_DLL herr_t H5F_refresh_eoa(const H5F_t *f);
 H5_DLL herr_t H5F_get_vfd_handle(const H5F_t *file, hid_t fapl, void **file_handle);
 
 /* Functions that check file mounting information */
@@ -669,8 +701,16 @@ H5_DLL herr_t H5F_flush_mounts(H5F_t *f, hid_t dxpl_id);
 /* Functions that operate on blocks of bytes wrt super block */
 H5_DLL herr_t H5F_block_read(const H5F_t *f, H5FD_mem_t type, haddr_t addr,
                 size_t size, hid_t dxpl_id, void *buf/*out*/);
+H5_DLL herr_t H5F_block_read_private(const H5F_t *f, haddr_t addr,
+                size_t size, hid_t dxpl_id, void *buf/*out*/);
 H5_DLL herr_t H5F_block_write(const H5F_t *f, H5FD_mem_t type, haddr_t addr,
                 size_t size, hid_t dxpl_id, const void *buf);
+H5_DLL herr_t H5F_block_readv(const H5F_t *f, H5FD_mem_t type, size_t count,
+                const haddr_t addrs[], const size_t sizes[], hid_t dxpl_id,
+                void *bufs[]/*out*/);
+H5_DLL herr_t H5F_block_writev(const H5F_t *f, H5FD_mem_t type, size_t count,
+                const haddr_t addrs[], const size_t sizes[], hid_t dxpl_id,
+                const void *bufs[]);
 
 /* Address-related functions */
 H5_DLL void H5F_addr_encode(const H5F_t *f, uint8_t **pp, haddr_t addr);
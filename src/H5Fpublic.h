@@ -51,6 +51,12 @@
  *
  * Note that H5F_ACC_DEBUG is deprecated (nonfuncational) but retained as a
  * symbol for backward compatibility.
+ *
+ * H5F_ACC_SWMR_WRITE and H5F_ACC_SWMR_READ open a file for single-writer /
+ * multiple-reader (SWMR) access: one process opens the file with
+ * H5F_ACC_RDWR | H5F_ACC_SWMR_WRITE and appends to its datasets, while
+ * other processes open it with H5F_ACC_RDONLY | H5F_ACC_SWMR_READ and
+ * call H5Drefresh() to see the new data.
  */
 #define H5F_ACC_RDONLY	(H5CHECK H5OPEN 0x0000u)	/*absence of rdwr => rd-only */
 #define H5F_ACC_RDWR	(H5CHECK H5OPEN 0x0001u)	/*open for read and write    */
@@ -58,6 +64,8 @@
 #define H5F_ACC_EXCL	(H5CHECK H5OPEN 0x0004u)	/*fail if file already exists*/
 /* NOTE: 0x0008u was H5F_ACC_DEBUG, now deprecated */
 #define H5F_ACC_CREAT	(H5CHECK H5OPEN 0x0010u)	/*create non-existing files  */
+#define H5F_ACC_SWMR_WRITE	(H5CHECK H5OPEN 0x0020u) /*single writer of a SWMR file  */
+#define H5F_ACC_SWMR_READ	(H5CHECK H5OPEN 0x0040u) /*concurrent reader of a SWMR file*/
 
 /* Value passed to H5Pset_elink_acc_flags to cause flags to be taken from the
  * parent file. */
@@ -214,6 +222,9 @@ H5_DLL herr_t H5Fget_mdc_size(hid_t file_id,
                               size_t * cur_size_ptr,
                               int * cur_num_entries_ptr);
 H5_DLL herr_t H5Freset_mdc_hit_rate_stats(hid_t file_id);
+H5_DLL herr_t H5Fget_page_buffering_stats(hid_t file_id, unsigned accesses[2],
+    unsigned hits[2], unsigned misses[2], unsigned evictions[2], unsigned bypasses[2]);
+H5_DLL herr_t H5Freset_page_buffering_stats(hid_t file_id);
 H5_DLL ssize_t H5Fget_name(hid_t obj_id, char *name, size_t size);
 H5_DLL herr_t H5Fget_info2(hid_t obj_id, H5F_info2_t *finfo);
 H5_DLL ssize_t H5Fget_free_sections(hid_t file_id, H5F_mem_t type,
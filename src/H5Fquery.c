@@ -656,6 +656,58 @@ H5F_rdcc_w0(const H5F_t *f)
     FUNC_LEAVE_NOAPI(f->shared->rdcc_w0)
 } /* end H5F_rdcc_w0() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5F_rdcc_shared_nbytes
+ *
+ * Purpose:	Retrieve the size of the raw data chunk cache shared by all
+ *              the datasets in the file.
+ *
+ * Return:	Success:	Size of the shared raw data chunk cache, in
+ *                              bytes, or 0 if the datasets don't share one.
+ *
+ * 		Failure:	(should not happen)
+ *
+ *-------------------------------------------------------------------------
+ */
+size_t
+H5F_rdcc_shared_nbytes(const H5F_t *f)
+{
+    /* Use FUNC_ENTER_NOAPI_NOINIT_NOERR here to avoid performance issues */
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    HDassert(f);
+    HDassert(f->shared);
+
+    FUNC_LEAVE_NOAPI(f->shared->rdcc_shared_nbytes)
+} /* end H5F_rdcc_shared_nbytes() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5F_rdcc_pool
+ *
+ * Purpose:	Retrieve the memory pool of the raw data chunk cache shared
+ *              by all the datasets in the file.
+ *
+ * Return:	Success:	Pointer to the pool, or NULL if it hasn't been
+ *                              created.
+ *
+ * 		Failure:	(should not happen)
+ *
+ *-------------------------------------------------------------------------
+ */
+struct H5D_rdcc_pool_t *
+H5F_rdcc_pool(const H5F_t *f)
+{
+    /* Use FUNC_ENTER_NOAPI_NOINIT_NOERR here to avoid performance issues */
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    HDassert(f);
+    HDassert(f->shared);
+
+    FUNC_LEAVE_NOAPI(f->shared->rdcc_pool)
+} /* end H5F_rdcc_pool() */
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5F_get_base_addr
@@ -1045,6 +1097,29 @@ H5F_is_tmp_addr(const H5F_t *f, haddr_t addr)
     FUNC_LEAVE_NOAPI(H5F_addr_le(f->shared->tmp_addr, addr))
 } /* end H5F_is_tmp_addr() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5F_get_read_attempts
+ *
+ * Purpose:	Retrieve the # of times to try reading a piece of metadata
+ *		that fails its checksum.
+ *
+ * Return:	Number of read attempts (at least 1)
+ *
+ *-------------------------------------------------------------------------
+ */
+unsigned
+H5F_get_read_attempts(const H5F_t *f)
+{
+    /* Use FUNC_ENTER_NOAPI_NOINIT_NOERR here to avoid performance issues */
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    HDassert(f);
+    HDassert(f->shared);
+
+    FUNC_LEAVE_NOAPI(f->shared->read_attempts)
+} /* end H5F_get_read_attempts() */
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5F_use_tmp_space
@@ -29,6 +29,7 @@
 #include "H5Fpkg.h"             /* File access                          */
 #include "H5FDprivate.h"	/* File drivers                         */
 #include "H5Iprivate.h"		/* IDs                                  */
+#include "H5MFprivate.h"	/* File memory management		*/
 #include "H5MMprivate.h"	/* Memory management			*/
 #include "H5Pprivate.h"		/* Property lists                       */
 #include "H5SMprivate.h"        /* Shared Object Header Messages        */
@@ -250,10 +251,15 @@ H5F__super_read(H5F_t *f, hid_t dxpl_id)
     haddr_t             super_addr;         /* Absolute address of superblock */
     haddr_t             eof;                /* End of file address */
     unsigned      	rw_flags;           /* Read/write permissions for file */
+    H5O_mdci_t          mdci;               /* Metadata cache image message */
     herr_t              ret_value = SUCCEED; /* Return value */
 
     FUNC_ENTER_PACKAGE_TAG(dxpl_id, H5AC__SUPERBLOCK_TAG, FAIL)
 
+    /* No metadata cache image until one is found in the superblock extension */
+    mdci.addr = HADDR_UNDEF;
+    mdci.size = 0;
+
     /* initialize the drvinfo to NULL -- we will overwrite this if there
      * is a driver information block 
      */
@@ -569,6 +575,15 @@ H5F__super_read(H5F_t *f, hid_t dxpl_id)
 		if(H5P_set(c_plist, H5F_CRT_FREE_SPACE_THRESHOLD_NAME, &fsinfo.threshold) < 0)
 		    HGOTO_ERROR(H5E_FILE, H5E_CANTSET, FAIL, "unable to set file space strategy")
 	    } /* end if */
+	    if(f->shared->fs_page_size != fsinfo.page_size) {
+		/* Switch to paged aggregation for the file's space */
+		if(H5F__set_paged_aggr(f, fsinfo.page_size) < 0)
+		    HGOTO_ERROR(H5E_FILE, H5E_CANTINIT, FAIL, "unable to set file space page size")
+
+		/* Set non-default page size in the property list */
+		if(H5P_set(c_plist, H5F_CRT_FILE_SPACE_PAGE_SIZE_NAME, &fsinfo.page_size) < 0)
+		    HGOTO_ERROR(H5E_FILE, H5E_CANTSET, FAIL, "unable to set file space page size")
+	    } /* end if */
 
 	    /* Set free-space manager addresses */
 	    f->shared->fs_addr[0] = HADDR_UNDEF;
@@ -576,9 +591,24 @@ H5F__super_read(H5F_t *f, hid_t dxpl_id)
 		f->shared->fs_addr[u] = fsinfo.fs_addr[u-1];
         } /* end if */
 
+        /* Check for the extension having a 'metadata cache image' message */
+        if((status = H5O_msg_exists(&ext_loc, H5O_MDCI_MSG_ID, dxpl_id)) < 0)
+            HGOTO_ERROR(H5E_FILE, H5E_CANTGET, FAIL, "unable to read object header")
+        if(status)
+	    if(NULL == H5O_msg_read(&ext_loc, H5O_MDCI_MSG_ID, &mdci, dxpl_id))
+		HGOTO_ERROR(H5E_FILE, H5E_CANTGET, FAIL, "unable to get metadata cache image message")
+
         /* Close superblock extension */
         if(H5F_super_ext_close(f, &ext_loc, dxpl_id, FALSE) < 0)
 	    HGOTO_ERROR(H5E_FILE, H5E_CANTCLOSEOBJ, FAIL, "unable to close file's superblock extension")
+
+        /* Load the metadata cache image, so the entries in it (starting
+         * with the root group's object header) are not read individually.
+         * (The cache image is not used for parallel I/O)
+         */
+        if(H5F_addr_defined(mdci.addr) && !H5F_HAS_FEATURE(f, H5FD_FEAT_HAS_MPI))
+            if(H5AC_load_cache_image(f, dxpl_id, mdci.addr, (size_t)mdci.size) < 0)
+                HGOTO_ERROR(H5E_FILE, H5E_CANTLOAD, FAIL, "unable to load metadata cache image")
     } /* end if */
 
     /* Update the driver info if VFD indicated to do so */
@@ -622,7 +652,7 @@ H5F__super_read(H5F_t *f, hid_t dxpl_id)
 		f->shared->sblock = sblock;
 #endif /* JRM */
 
-                if(H5F_super_ext_write_msg(f, dxpl_id, &drvinfo, H5O_DRVINFO_ID, FALSE) < 0)
+                if(H5F_super_ext_write_msg(f, dxpl_id, &drvinfo, H5O_DRVINFO_ID, FALSE, H5O_MSG_FLAG_DONTSHARE) < 0)
                     HGOTO_ERROR(H5E_FILE, H5E_WRITEERROR, FAIL, "error in writing message to superblock extension")
 
 #if 1 /* bug fix test code -- tidy this up if all goes well */ /* JRM */
@@ -646,6 +676,19 @@ H5F__super_read(H5F_t *f, hid_t dxpl_id)
     /* Set the pointer to the pinned superblock */
     f->shared->sblock = sblock;
 
+    /* The metadata cache image is only valid for the file as it was
+     * closed, so remove it (and release its space) when the file is
+     * opened for writing.
+     */
+    if(((rw_flags & H5AC__READ_ONLY_FLAG) == 0) && H5F_addr_defined(mdci.addr)) {
+        if(H5F_super_ext_remove_msg(f, dxpl_id, H5O_MDCI_MSG_ID) < 0)
+            HGOTO_ERROR(H5E_FILE, H5E_CANTRELEASE, FAIL, "error in removing message from superblock extension")
+
+        /* Check if the superblock extension was removed */
+        if(!H5F_addr_defined(sblock->ext_addr))
+            sblock_flags |= H5AC__DIRTIED_FLAG;
+    } /* end if */
+
 done:
     /* Reset the ring in the DXPL */
     if(H5AC_reset_ring(dxpl, orig_ring) < 0)
@@ -751,10 +794,16 @@ H5F__super_init(H5F_t *f, hid_t dxpl_id)
     else if(f->shared->sohm_nindexes > 0)
         super_vers = HDF5_SUPERBLOCK_VERSION_2;
     /* Bump superblock version to create superblock extension for
-     * non-default file space strategy or non-default free-space threshold
+     * non-default file space strategy, free-space threshold or page size
      */
     else if(f->shared->fs_strategy != H5F_FILE_SPACE_STRATEGY_DEF ||
-            f->shared->fs_threshold != H5F_FREE_SPACE_THRESHOLD_DEF)
+            f->shared->fs_threshold != H5F_FREE_SPACE_THRESHOLD_DEF ||
+            f->shared->fs_page_size != H5F_FILE_SPACE_PAGE_SIZE_DEF)
+        super_vers = HDF5_SUPERBLOCK_VERSION_2;
+    /* Bump superblock version to allow a metadata cache image to be stored
+     * in the superblock extension when the file is closed
+     */
+    else if(f->shared->mdc_image)
         super_vers = HDF5_SUPERBLOCK_VERSION_2;
     /* Check for non-default indexed storage B-tree internal 'K' value
      * and set the version # of the superblock to 1 if it is a non-default
@@ -862,7 +911,8 @@ H5F__super_init(H5F_t *f, hid_t dxpl_id)
     } /* end if */
     /* Files with non-default free space settings always need the superblock extension */
     else if(f->shared->fs_strategy != H5F_FILE_SPACE_STRATEGY_DEF ||
-            f->shared->fs_threshold != H5F_FREE_SPACE_THRESHOLD_DEF) {
+            f->shared->fs_threshold != H5F_FREE_SPACE_THRESHOLD_DEF ||
+            f->shared->fs_page_size != H5F_FILE_SPACE_PAGE_SIZE_DEF) {
         HDassert(super_vers >= HDF5_SUPERBLOCK_VERSION_2);
         need_ext = TRUE;
     } /* end if */
@@ -949,13 +999,15 @@ H5F__super_init(H5F_t *f, hid_t dxpl_id)
 
         /* Check for non-default free space settings */
 	if(f->shared->fs_strategy != H5F_FILE_SPACE_STRATEGY_DEF ||
-                f->shared->fs_threshold != H5F_FREE_SPACE_THRESHOLD_DEF) {
+                f->shared->fs_threshold != H5F_FREE_SPACE_THRESHOLD_DEF ||
+                f->shared->fs_page_size != H5F_FILE_SPACE_PAGE_SIZE_DEF) {
 	    H5FD_mem_t   type;         	/* Memory type for iteration */
             H5O_fsinfo_t fsinfo;	/* Free space manager info message */
 
 	    /* Write free-space manager info message to superblock extension object header if needed */
 	    fsinfo.strategy = f->shared->fs_strategy;
 	    fsinfo.threshold = f->shared->fs_threshold;
+	    fsinfo.page_size = f->shared->fs_page_size;
 	    for(type = H5FD_MEM_SUPER; type < H5FD_MEM_NTYPES; H5_INC_ENUM(H5FD_mem_t, type))
                 fsinfo.fs_addr[type-1] = HADDR_UNDEF;
 
@@ -1197,7 +1249,8 @@ done:
  *-------------------------------------------------------------------------
  */
 herr_t
-H5F_super_ext_write_msg(H5F_t *f, hid_t dxpl_id, void *mesg, unsigned id, hbool_t may_create)
+H5F_super_ext_write_msg(H5F_t *f, hid_t dxpl_id, void *mesg, unsigned id, hbool_t may_create,
+    unsigned mesg_flags)
 {
     H5P_genplist_t *dxpl = NULL;        /* DXPL for setting ring */
     H5AC_ring_t orig_ring = H5AC_RING_INV;      /* Original ring value */
@@ -1242,7 +1295,7 @@ H5F_super_ext_write_msg(H5F_t *f, hid_t dxpl_id, void *mesg, unsigned id, hbool_
 	    HGOTO_ERROR(H5E_OHDR, H5E_CANTGET, FAIL, "Message should not exist")
 
 	/* Create the message with ID in the superblock extension */
-	if(H5O_msg_create(&ext_loc, id, H5O_MSG_FLAG_DONTSHARE, H5O_UPDATE_TIME, mesg, dxpl_id) < 0)
+	if(H5O_msg_create(&ext_loc, id, mesg_flags, H5O_UPDATE_TIME, mesg, dxpl_id) < 0)
 	    HGOTO_ERROR(H5E_OHDR, H5E_CANTGET, FAIL, "unable to create the message in object header")
     } /* end if */
     else {
@@ -1250,7 +1303,7 @@ H5F_super_ext_write_msg(H5F_t *f, hid_t dxpl_id, void *mesg, unsigned id, hbool_
 	    HGOTO_ERROR(H5E_OHDR, H5E_CANTGET, FAIL, "Message should exist")
 
 	/* Update the message with ID in the superblock extension */
-	if(H5O_msg_write(&ext_loc, id, H5O_MSG_FLAG_DONTSHARE, H5O_UPDATE_TIME, mesg, dxpl_id) < 0)
+	if(H5O_msg_write(&ext_loc, id, mesg_flags, H5O_UPDATE_TIME, mesg, dxpl_id) < 0)
 	    HGOTO_ERROR(H5E_OHDR, H5E_CANTGET, FAIL, "unable to write the message in object header")
     } /* end else */
 
@@ -1346,3 +1399,58 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* H5F_super_ext_remove_msg() */
 
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5F__super_write_cache_image
+ *
+ * Purpose:     Write the metadata cache image to a newly allocated block
+ *              in the file, and record its location in a 'metadata cache
+ *              image' message in the superblock extension.
+ *
+ *              The message is flagged so that library versions which do
+ *              not understand it refuse to open the file for writing,
+ *              since they would not remove the (then stale) image.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5F__super_write_cache_image(H5F_t *f, hid_t dxpl_id)
+{
+    H5O_mdci_t  mdci;                   /* Metadata cache image message */
+    void       *image = NULL;           /* Metadata cache image */
+    size_t      image_len = 0;          /* Size of metadata cache image */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    /* Sanity checks */
+    HDassert(f);
+    HDassert(f->shared->sblock);
+    HDassert(f->shared->sblock->super_vers >= HDF5_SUPERBLOCK_VERSION_2);
+
+    /* Construct the image from the (clean) entries in the cache */
+    if(H5AC_get_cache_image(f, &image, &image_len) < 0)
+        HGOTO_ERROR(H5E_FILE, H5E_CANTGET, FAIL, "unable to construct metadata cache image")
+
+    if(image_len > 0) {
+        /* Allocate space for the image and write it */
+        if(HADDR_UNDEF == (mdci.addr = H5MF_alloc(f, H5FD_MEM_SUPER, dxpl_id, (hsize_t)image_len)))
+            HGOTO_ERROR(H5E_FILE, H5E_CANTALLOC, FAIL, "file allocation failed for metadata cache image")
+        mdci.size = (hsize_t)image_len;
+        if(H5F_block_write(f, H5FD_MEM_SUPER, mdci.addr, image_len, dxpl_id, image) < 0)
+            HGOTO_ERROR(H5E_FILE, H5E_WRITEERROR, FAIL, "unable to write metadata cache image")
+
+        /* Record the image's location in the superblock extension */
+        if(H5F_super_ext_write_msg(f, dxpl_id, &mdci, H5O_MDCI_MSG_ID, TRUE,
+                H5O_MSG_FLAG_DONTSHARE | H5O_MSG_FLAG_FAIL_IF_UNKNOWN_AND_OPEN_FOR_WRITE) < 0)
+            HGOTO_ERROR(H5E_FILE, H5E_WRITEERROR, FAIL, "error in writing message to superblock extension")
+    } /* end if */
+
+done:
+    image = H5MM_xfree(image);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5F__super_write_cache_image() */
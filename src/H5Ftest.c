@@ -186,3 +186,36 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5F_get_maxaddr_test() */
 
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5F_get_mdc_image_stats_test
+ *
+ * Purpose:     Retrieve the number of entries in the metadata cache image
+ *              loaded when the file was opened, and how many of them have
+ *              been loaded into the cache from the image.
+ *
+ * Return:	Success:        Non-negative
+ *		Failure:	Negative
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5F_get_mdc_image_stats_test(hid_t file_id, unsigned *nentries, unsigned *nhits)
+{
+    H5F_t	*file;                  /* File info */
+    herr_t	ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    /* Check arguments */
+    if(NULL == (file = (H5F_t *)H5I_object_verify(file_id, H5I_FILE)))
+	HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a file")
+
+    /* Retrieve the cache image statistics */
+    if(H5AC_get_cache_image_stats(file->shared->cache, nentries, nhits) < 0)
+	HGOTO_ERROR(H5E_FILE, H5E_CANTGET, FAIL, "can't get metadata cache image statistics")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5F_get_mdc_image_stats_test() */
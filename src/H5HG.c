@@ -74,6 +74,13 @@
 /* Local Typedefs */
 /******************/
 
+/* Object reference sorted by collection for batched reads */
+typedef struct H5HG_batch_ent_t {
+    haddr_t     addr;           /* Address of the object's collection */
+    size_t      idx;            /* Object's index within the collection */
+    size_t      u;              /* Position of the object in the caller's arrays */
+} H5HG_batch_ent_t;
+
 
 /********************/
 /* Package Typedefs */
@@ -85,6 +92,7 @@
 /********************/
 
 static haddr_t H5HG_create(H5F_t *f, hid_t dxpl_id, size_t size);
+static int H5HG_batch_cmp(const void *_ent1, const void *_ent2);
 
 
 /*********************/
@@ -586,6 +594,104 @@ done:
 } /* H5HG_insert() */
 
 
+/*-------------------------------------------------------------------------
+ * Function:	H5HG_insert_batch
+ *
+ * Purpose:	Inserts NOBJS objects into the global heap, as if by calling
+ *		H5HG_insert() for each one.  A collection is kept protected
+ *		for as long as the objects fit in it, and new collections
+ *		are sized to hold as many of the remaining objects as
+ *		H5HG_MAXSIZE allows, so short objects are packed together
+ *		with one protect per collection.
+ *
+ * Return:	Success:	Non-negative, with the heap object IDs
+ *				returned through HOBJS.
+ *
+ *		Failure:	Negative
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5HG_insert_batch(H5F_t *f, hid_t dxpl_id, size_t nobjs, const size_t sizes[],
+    void *objs[], H5HG_t hobjs[]/*out*/)
+{
+    size_t	total_need = 0;		/*space needed for remaining objects	*/
+    H5HG_heap_t	*heap = NULL;
+    unsigned 	heap_flags = H5AC__NO_FLAGS_SET;
+    size_t	u;			/*local index variable			*/
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_NOAPI_TAG(dxpl_id, H5AC__GLOBALHEAP_TAG, FAIL)
+
+    /* Check args */
+    HDassert(f);
+    HDassert(0 == nobjs || (sizes && objs && hobjs));
+
+    if(0 == (H5F_INTENT(f) & H5F_ACC_RDWR))
+	HGOTO_ERROR(H5E_HEAP, H5E_WRITEERROR, FAIL, "no write intent on file")
+
+    for(u = 0; u < nobjs; u++)
+        total_need += H5HG_SIZEOF_OBJHDR(f) + H5HG_ALIGN(sizes[u]);
+
+    for(u = 0; u < nobjs; u++) {
+        size_t	need = H5HG_SIZEOF_OBJHDR(f) + H5HG_ALIGN(sizes[u]);
+        size_t	idx;
+
+        HDassert(0 == sizes[u] || objs[u]);
+
+        /* Release the current collection once it is full */
+        if(heap && heap->obj[0].size < need) {
+            if(H5AC_unprotect(f, dxpl_id, H5AC_GHEAP, heap->addr, heap, heap_flags) < 0)
+                HGOTO_ERROR(H5E_HEAP, H5E_CANTUNPROTECT, FAIL, "unable to unprotect heap.")
+            heap = NULL;
+            heap_flags = H5AC__NO_FLAGS_SET;
+        } /* end if */
+
+        if(NULL == heap) {
+            haddr_t addr = HADDR_UNDEF;     /* Address of heap to add objects within */
+
+            /* Look for a heap in the file's CWFS that has enough space for the object */
+            if(H5F_cwfs_find_free_heap(f, dxpl_id, need, &addr) < 0)
+                HGOTO_ERROR(H5E_HEAP, H5E_NOTFOUND, FAIL, "error trying to locate heap")
+
+            /* Otherwise, allocate a collection large enough for the rest of the batch */
+            if(!H5F_addr_defined(addr)) {
+                size_t heap_size = MIN(total_need + H5HG_SIZEOF_HDR(f), H5HG_MAXSIZE);
+
+                heap_size = MAX(heap_size, need + H5HG_SIZEOF_HDR(f));
+                addr = H5HG_create(f, dxpl_id, heap_size);
+
+                if(!H5F_addr_defined(addr))
+                    HGOTO_ERROR(H5E_HEAP, H5E_CANTINIT, FAIL, "unable to allocate a global heap collection")
+            } /* end if */
+            HDassert(H5F_addr_defined(addr));
+
+            if(NULL == (heap = H5HG_protect(f, dxpl_id, addr, H5AC__NO_FLAGS_SET)))
+                HGOTO_ERROR(H5E_HEAP, H5E_CANTPROTECT, FAIL, "unable to protect global heap")
+        } /* end if */
+
+        /* Split the free space to make room for the new object */
+        if(0 == (idx = H5HG_alloc(f, heap, sizes[u], &heap_flags)))
+            HGOTO_ERROR(H5E_HEAP, H5E_CANTALLOC, FAIL, "unable to allocate global heap object")
+
+        /* Copy data into the heap */
+        if(sizes[u] > 0)
+            HDmemcpy(heap->obj[idx].begin + H5HG_SIZEOF_OBJHDR(f), objs[u], sizes[u]);
+        heap_flags |= H5AC__DIRTIED_FLAG;
+
+        hobjs[u].addr = heap->addr;
+        hobjs[u].idx = idx;
+        total_need -= need;
+    } /* end for */
+
+done:
+    if(heap && H5AC_unprotect(f, dxpl_id, H5AC_GHEAP, heap->addr, heap, heap_flags) < 0)
+        HDONE_ERROR(H5E_HEAP, H5E_CANTUNPROTECT, FAIL, "unable to unprotect heap.")
+
+    FUNC_LEAVE_NOAPI_TAG(ret_value, FAIL)
+} /* H5HG_insert_batch() */
+
+
 /*-------------------------------------------------------------------------
  * Function:	H5HG_read
  *
@@ -660,6 +766,112 @@ done:
 } /* end H5HG_read() */
 
 
+/*-------------------------------------------------------------------------
+ * Function:	H5HG_batch_cmp
+ *
+ * Purpose:	Callback for qsort() to order object references by the
+ *		address of their collection, then by index.
+ *
+ * Return:	-1, 0 or 1, as for qsort()
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+H5HG_batch_cmp(const void *_ent1, const void *_ent2)
+{
+    const H5HG_batch_ent_t *ent1 = (const H5HG_batch_ent_t *)_ent1;
+    const H5HG_batch_ent_t *ent2 = (const H5HG_batch_ent_t *)_ent2;
+
+    if(H5F_addr_lt(ent1->addr, ent2->addr))
+        return(-1);
+    if(H5F_addr_gt(ent1->addr, ent2->addr))
+        return(1);
+    if(ent1->idx < ent2->idx)
+        return(-1);
+    if(ent1->idx > ent2->idx)
+        return(1);
+    return(0);
+} /* end H5HG_batch_cmp() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5HG_read_batch
+ *
+ * Purpose:	Reads NOBJS global heap objects into the buffers OBJECTS
+ *		supplied by the caller, copying at most SIZES[u] bytes of
+ *		object U.  The references are grouped by collection so that
+ *		each collection is protected only once, no matter how many
+ *		of its objects are read.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5HG_read_batch(H5F_t *f, hid_t dxpl_id, size_t nobjs, const H5HG_t *hobjs,
+    void *objects[], const size_t sizes[])
+{
+    H5HG_batch_ent_t *ents = NULL;      /* Object references, sorted by collection */
+    H5HG_heap_t	*heap = NULL;           /* Pointer to global heap object */
+    size_t      u;                      /* Local index variable */
+    herr_t	ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_NOAPI_TAG(dxpl_id, H5AC__GLOBALHEAP_TAG, FAIL)
+
+    /* Check args */
+    HDassert(f);
+    HDassert(0 == nobjs || (hobjs && objects && sizes));
+
+    if(0 == nobjs)
+        HGOTO_DONE(SUCCEED)
+
+    /* Sort the references so that objects in the same collection are adjacent */
+    if(NULL == (ents = (H5HG_batch_ent_t *)H5MM_malloc(nobjs * sizeof(H5HG_batch_ent_t))))
+	HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed")
+    for(u = 0; u < nobjs; u++) {
+        ents[u].addr = hobjs[u].addr;
+        ents[u].idx = hobjs[u].idx;
+        ents[u].u = u;
+    } /* end for */
+    HDqsort(ents, nobjs, sizeof(H5HG_batch_ent_t), H5HG_batch_cmp);
+
+    for(u = 0; u < nobjs; u++) {
+        size_t size;            /* Number of bytes to copy */
+
+        /* Move to the next collection, if necessary */
+        if(NULL == heap || !H5F_addr_eq(heap->addr, ents[u].addr)) {
+            if(heap) {
+                if(H5AC_unprotect(f, dxpl_id, H5AC_GHEAP, heap->addr, heap, H5AC__NO_FLAGS_SET) < 0)
+                    HGOTO_ERROR(H5E_HEAP, H5E_CANTUNPROTECT, FAIL, "unable to release global heap")
+                heap = NULL;
+            } /* end if */
+
+            if(NULL == (heap = H5HG_protect(f, dxpl_id, ents[u].addr, H5AC__READ_ONLY_FLAG)))
+                HGOTO_ERROR(H5E_HEAP, H5E_CANTPROTECT, FAIL, "unable to protect global heap")
+
+            /* Advance the heap in the CWFS list, as H5HG_read() would */
+            if(heap->obj[0].begin)
+                if(H5F_cwfs_advance_heap(f, heap, FALSE) < 0)
+                    HGOTO_ERROR(H5E_HEAP, H5E_CANTMODIFY, FAIL, "can't adjust file's CWFS")
+        } /* end if */
+
+        HDassert(ents[u].idx < heap->nused);
+        HDassert(heap->obj[ents[u].idx].begin);
+        size = MIN(heap->obj[ents[u].idx].size, sizes[ents[u].u]);
+        if(size > 0)
+            HDmemcpy(objects[ents[u].u], heap->obj[ents[u].idx].begin + H5HG_SIZEOF_OBJHDR(f), size);
+    } /* end for */
+
+done:
+    if(heap && H5AC_unprotect(f, dxpl_id, H5AC_GHEAP, heap->addr, heap, H5AC__NO_FLAGS_SET) < 0)
+        HDONE_ERROR(H5E_HEAP, H5E_CANTUNPROTECT, FAIL, "unable to release global heap")
+    if(ents)
+        H5MM_xfree(ents);
+
+    FUNC_LEAVE_NOAPI_TAG(ret_value, FAIL)
+} /* end H5HG_read_batch() */
+
+
 /*-------------------------------------------------------------------------
  * Function:	H5HG_link
  *
@@ -58,7 +58,11 @@ typedef struct H5HG_heap_t H5HG_heap_t;
 /* Main global heap routines */
 H5_DLL herr_t H5HG_insert(H5F_t *f, hid_t dxpl_id, size_t size, void *obj,
 			   H5HG_t *hobj/*out*/);
+H5_DLL herr_t H5HG_insert_batch(H5F_t *f, hid_t dxpl_id, size_t nobjs,
+    const size_t sizes[], void *objs[], H5HG_t hobjs[]/*out*/);
 H5_DLL void *H5HG_read(H5F_t *f, hid_t dxpl_id, H5HG_t *hobj, void *object, size_t *buf_size/*out*/);
+H5_DLL herr_t H5HG_read_batch(H5F_t *f, hid_t dxpl_id, size_t nobjs,
+    const H5HG_t *hobjs, void *objects[], const size_t sizes[]);
 H5_DLL int H5HG_link(H5F_t *f, hid_t dxpl_id, const H5HG_t *hobj, int adjust);
 H5_DLL herr_t H5HG_get_obj_size(H5F_t *f, hid_t dxpl_id, H5HG_t *hobj, size_t *obj_size);
 H5_DLL herr_t H5HG_remove(H5F_t *f, hid_t dxpl_id, H5HG_t *hobj);
@@ -45,7 +45,6 @@
 #include "H5Ipkg.h"		/* IDs			  		*/
 #include "H5MMprivate.h"	/* Memory management			*/
 #include "H5Oprivate.h"		/* Object headers		  	*/
-#include "H5SLprivate.h"	/* Skip Lists                           */
 
 /* Define this to compile in support for dumping ID information */
 /* #define H5I_DEBUG_OUTPUT */
@@ -64,6 +63,29 @@
 #define H5I_MAKE(g,i)	((((hid_t)(g) & TYPE_MASK) << ID_BITS) |	  \
 			     ((hid_t)(i) & ID_MASK))
 
+/*
+ * An atom index is the slot that holds the ID in its type's ID table,
+ * combined with the generation of that slot.  The generation is bumped each
+ * time the slot is freed, so that a stale ID isn't mistaken for the ID that
+ * reuses its slot later.
+ */
+#define H5I_SLOT_BITS	32
+#define H5I_SLOT_MASK	(((hid_t)1 << H5I_SLOT_BITS) - 1)
+#define H5I_GEN_MASK	(((hid_t)1 << (ID_BITS - H5I_SLOT_BITS)) - 1)
+
+/* Combine a generation and a slot into an atom index */
+#define H5I_INDEX(g,s)	((((hid_t)(g) & H5I_GEN_MASK) << H5I_SLOT_BITS) | \
+			     ((hid_t)(s) & H5I_SLOT_MASK))
+
+/* Get the slot of an atom */
+#define H5I_SLOT(a)	((size_t)((hid_t)(a) & H5I_SLOT_MASK))
+
+/* Initial number of slots in a type's ID table */
+#define H5I_SLOTS_INIT	64
+
+/* Value of free slot list links that point nowhere */
+#define H5I_NO_SLOT	((size_t)-1)
+
 /* Local typedefs */
 
 /* Atom information structure used */
@@ -72,15 +94,31 @@ typedef struct H5I_id_info_t {
     unsigned	count;		/* ref. count for this atom		    */
     unsigned    app_count;      /* ref. count of application visible atoms  */
     const void	*obj_ptr;	/* pointer associated with the atom	    */
+    hbool_t     marked;         /* Whether the atom was removed during an iteration */
+    struct H5I_id_info_t *next; /* Next atom of the type, in creation order */
+    struct H5I_id_info_t *prev; /* Previous atom of the type                */
 } H5I_id_info_t;
 
+/* Slot in a type's ID table */
+typedef struct H5I_slot_t {
+    H5I_id_info_t *info;        /* Atom in this slot, NULL if slot is free  */
+    hid_t       gen;            /* Generation of the slot's atom            */
+    size_t      next_free;      /* Next free slot, when this one is free    */
+} H5I_slot_t;
+
 /* ID type structure used */
 typedef struct {
     const H5I_class_t *cls;     /* Pointer to ID class                      */
     unsigned	init_count;	/* # of times this type has been initialized*/
     uint64_t	id_count;	/* Current number of IDs held		    */
-    uint64_t	nextid;		/* ID to use for the next atom		    */
-    H5SL_t      *ids;           /* Pointer to skip list that stores IDs     */
+    H5I_slot_t  *slots;         /* Table of IDs, indexed by slot            */
+    size_t      nslots;         /* Number of slots handed out (incl. reserved) */
+    size_t      nalloc;         /* Number of slots allocated in the table   */
+    size_t      free_slot;      /* First slot on the free list              */
+    H5I_id_info_t *first;       /* Oldest atom in the type                  */
+    H5I_id_info_t *last;        /* Newest atom in the type                  */
+    unsigned    iterating;      /* Depth of iterations over the type's IDs  */
+    hbool_t     has_marked;     /* Whether any atoms are marked for removal */
 } H5I_id_type_t;
 
 typedef struct {
@@ -130,6 +168,9 @@ H5FL_DEFINE_STATIC(H5I_class_t);
 
 /*--------------------- Local function prototypes ---------------------------*/
 static htri_t H5I__clear_type_cb(void *_id, void *key, void *udata);
+static void H5I__release_id(H5I_id_type_t *type_ptr, H5I_id_info_t *id_ptr);
+static void H5I__remove_id(H5I_id_type_t *type_ptr, H5I_id_info_t *id_ptr);
+static void H5I__end_iterate(H5I_id_type_t *type_ptr);
 static int H5I__destroy_type(H5I_type_t type);
 static void *H5I__remove_verify(hid_t id, H5I_type_t id_type);
 static void *H5I__remove_common(H5I_id_type_t *type_ptr, hid_t id);
@@ -170,7 +211,7 @@ H5I_term_package(void)
 
         /* How many types are still being used? */
         for(type = (H5I_type_t)0; type < H5I_next_type; H5_INC_ENUM(H5I_type_t, type))
-            if((type_ptr = H5I_id_type_list_g[type]) && type_ptr->ids)
+            if((type_ptr = H5I_id_type_list_g[type]) && type_ptr->slots)
                 n++;
 
         /* If no types are used then clean up */
@@ -178,7 +219,7 @@ H5I_term_package(void)
             for(type = (H5I_type_t)0; type < H5I_next_type; H5_INC_ENUM(H5I_type_t,type)) {
                 type_ptr = H5I_id_type_list_g[type];
                 if(type_ptr) {
-                    HDassert(NULL == type_ptr->ids);
+                    HDassert(NULL == type_ptr->slots);
                     type_ptr = H5FL_FREE(H5I_id_type_t, type_ptr);
                     H5I_id_type_list_g[type] = NULL;
                     n++;
@@ -323,9 +364,16 @@ H5I_register_type(const H5I_class_t *cls)
     if(type_ptr->init_count == 0) {
         type_ptr->cls = cls;
         type_ptr->id_count = 0;
-        type_ptr->nextid = cls->reserved;
-        if(NULL == (type_ptr->ids = H5SL_create(H5SL_TYPE_HID, NULL)))
-            HGOTO_ERROR(H5E_ATOM, H5E_CANTCREATE, FAIL, "skip list creation failed")
+        type_ptr->nslots = cls->reserved;
+        type_ptr->nalloc = H5I_SLOTS_INIT;
+        while(type_ptr->nalloc <= type_ptr->nslots)
+            type_ptr->nalloc *= 2;
+        type_ptr->free_slot = H5I_NO_SLOT;
+        type_ptr->first = type_ptr->last = NULL;
+        type_ptr->iterating = 0;
+        type_ptr->has_marked = FALSE;
+        if(NULL == (type_ptr->slots = (H5I_slot_t *)H5MM_calloc(type_ptr->nalloc * sizeof(H5I_slot_t))))
+            HGOTO_ERROR(H5E_ATOM, H5E_CANTALLOC, FAIL, "ID table allocation failed")
     } /* end if */
 
     /* Increment the count of the times this type has been initialized */
@@ -334,8 +382,8 @@ H5I_register_type(const H5I_class_t *cls)
 done:
     if(ret_value < 0) {	/* Clean up on error */
         if(type_ptr) {
-            if(type_ptr->ids)
-                H5SL_close(type_ptr->ids);
+            if(type_ptr->slots)
+                H5MM_xfree(type_ptr->slots);
             (void)H5FL_FREE(H5I_id_type_t, type_ptr);
         } /* end if */
     } /* end if */
@@ -517,6 +565,7 @@ herr_t
 H5I_clear_type(H5I_type_t type, hbool_t force, hbool_t app_ref)
 {
     H5I_clear_type_ud_t udata;          /* udata struct for callback */
+    H5I_id_info_t *id_ptr, *next_ptr;   /* Current & next IDs in the type */
     int         ret_value = SUCCEED;    /* Return value */
 
     FUNC_ENTER_NOAPI(FAIL)
@@ -532,9 +581,16 @@ H5I_clear_type(H5I_type_t type, hbool_t force, hbool_t app_ref)
     udata.force = force;
     udata.app_ref = app_ref;
 
-    /* Attempt to free all ids in the type */
-    if(H5SL_try_free_safe(udata.type_ptr->ids, H5I__clear_type_cb, &udata) < 0)
-        HGOTO_ERROR(H5E_ATOM, H5E_CANTDELETE, FAIL, "can't free ids in type")
+    /* Attempt to free all ids in the type.  IDs removed meanwhile (by the
+     * free callbacks too) are only marked, and released once the scan ends.
+     */
+    udata.type_ptr->iterating++;
+    for(id_ptr = udata.type_ptr->first; id_ptr; id_ptr = next_ptr) {
+        next_ptr = id_ptr->next;
+        if(!id_ptr->marked)
+            (void)H5I__clear_type_cb(id_ptr, NULL, &udata);
+    } /* end for */
+    H5I__end_iterate(udata.type_ptr);
 
 done:
     FUNC_LEAVE_NOAPI(ret_value)
@@ -597,8 +653,8 @@ H5I__clear_type_cb(void *_id, void H5_ATTR_UNUSED *key, void *_udata)
 
         /* Remove ID if requested */
         if(ret_value) {
-            /* Free ID info */
-            id = H5FL_FREE(H5I_id_info_t, id);
+            /* Remove ID from the type */
+            H5I__remove_id(udata->type_ptr, id);
 
             /* Decrement the number of IDs in the type */
             udata->type_ptr->id_count--;
@@ -682,9 +738,14 @@ H5I__destroy_type(H5I_type_t type)
     if(type_ptr->cls->flags & H5I_CLASS_IS_APPLICATION)
         type_ptr->cls = H5FL_FREE(H5I_class_t, (void *)type_ptr->cls);
 
-    if(H5SL_close(type_ptr->ids) < 0)
-        HGOTO_ERROR(H5E_ATOM, H5E_CANTCLOSEOBJ, FAIL, "can't close skip list")
-    type_ptr->ids = NULL;
+    /* Release the ID table, along with any IDs left in it */
+    while(type_ptr->first) {
+        H5I_id_info_t *id_ptr = type_ptr->first;
+
+        type_ptr->first = id_ptr->next;
+        id_ptr = H5FL_FREE(H5I_id_info_t, id_ptr);
+    } /* end while */
+    type_ptr->slots = (H5I_slot_t *)H5MM_xfree(type_ptr->slots);
 
     type_ptr = H5FL_FREE(H5I_id_type_t, type_ptr);
     H5I_id_type_list_g[type] = NULL;
@@ -748,6 +809,7 @@ H5I_register(H5I_type_t type, const void *object, hbool_t app_ref)
 {
     H5I_id_type_t	*type_ptr;	/*ptr to the type		*/
     H5I_id_info_t	*id_ptr;	/*ptr to the new ID information */
+    size_t		slot;		/*slot for the new ID		*/
     hid_t		new_id;		/*new ID			*/
     hid_t		ret_value = SUCCEED; /*return value		*/
 
@@ -759,26 +821,50 @@ H5I_register(H5I_type_t type, const void *object, hbool_t app_ref)
     type_ptr = H5I_id_type_list_g[type];
     if(NULL == type_ptr || type_ptr->init_count <= 0)
 	HGOTO_ERROR(H5E_ATOM, H5E_BADGROUP, FAIL, "invalid type")
+
+    /* Make room for a new slot in the ID table, if no freed one can be reused */
+    if(type_ptr->free_slot == H5I_NO_SLOT && type_ptr->nslots == type_ptr->nalloc) {
+        H5I_slot_t *new_slots;          /* Extended ID table */
+        size_t new_nalloc = 2 * type_ptr->nalloc;       /* New table size */
+
+        if(type_ptr->nslots > (size_t)H5I_SLOT_MASK)
+            HGOTO_ERROR(H5E_ATOM, H5E_NOIDS, FAIL, "no IDs available in type")
+        if(NULL == (new_slots = (H5I_slot_t *)H5MM_realloc(type_ptr->slots, new_nalloc * sizeof(H5I_slot_t))))
+            HGOTO_ERROR(H5E_ATOM, H5E_CANTALLOC, FAIL, "can't extend ID table")
+        HDmemset(new_slots + type_ptr->nalloc, 0, (new_nalloc - type_ptr->nalloc) * sizeof(H5I_slot_t));
+        type_ptr->slots = new_slots;
+        type_ptr->nalloc = new_nalloc;
+    } /* end if */
+
     if(NULL == (id_ptr = H5FL_MALLOC(H5I_id_info_t)))
         HGOTO_ERROR(H5E_ATOM, H5E_NOSPACE, FAIL, "memory allocation failed")
 
+    /* Take the most recently freed slot, or the next one never used */
+    if(type_ptr->free_slot != H5I_NO_SLOT) {
+        slot = type_ptr->free_slot;
+        type_ptr->free_slot = type_ptr->slots[slot].next_free;
+    } /* end if */
+    else
+        slot = type_ptr->nslots++;
+
     /* Create the struct & it's ID */
-    new_id = H5I_MAKE(type, type_ptr->nextid);
+    new_id = H5I_MAKE(type, H5I_INDEX(type_ptr->slots[slot].gen, slot));
     id_ptr->id = new_id;
     id_ptr->count = 1; /*initial reference count*/
     id_ptr->app_count = !!app_ref;
     id_ptr->obj_ptr = object;
-
-    /* Insert into the type */
-    if(H5SL_insert(type_ptr->ids, id_ptr, &id_ptr->id) < 0)
-        HGOTO_ERROR(H5E_ATOM, H5E_CANTINSERT, FAIL, "can't insert ID node into skip list")
+    id_ptr->marked = FALSE;
+
+    /* Insert into the type, after its newest ID */
+    type_ptr->slots[slot].info = id_ptr;
+    id_ptr->next = NULL;
+    id_ptr->prev = type_ptr->last;
+    if(type_ptr->last)
+        type_ptr->last->next = id_ptr;
+    else
+        type_ptr->first = id_ptr;
+    type_ptr->last = id_ptr;
     type_ptr->id_count++;
-    type_ptr->nextid++;
-
-    /*
-     * Sanity check for the 'nextid' getting too large and wrapping around.
-     */
-    HDassert(type_ptr->nextid <= ID_MASK);
 
     /* Set return value */
     ret_value = new_id;
@@ -1093,12 +1179,12 @@ H5I__remove_common(H5I_id_type_t *type_ptr, hid_t id)
     HDassert(type_ptr);
 
     /* Get the ID node for the ID */
-    if(NULL == (curr_id = (H5I_id_info_t *)H5SL_remove(type_ptr->ids, &id)))
-        HGOTO_ERROR(H5E_ATOM, H5E_CANTDELETE, NULL, "can't remove ID node from skip list")
+    if(NULL == (curr_id = H5I__find_id(id)))
+        HGOTO_ERROR(H5E_ATOM, H5E_CANTDELETE, NULL, "can't remove ID node from ID table")
 
     /* (Casting away const OK -QAK) */
     ret_value = (void *)curr_id->obj_ptr;
-    curr_id = H5FL_FREE(H5I_id_info_t, curr_id);
+    H5I__remove_id(type_ptr, curr_id);
 
     /* Decrement the number of IDs in the type */
     (type_ptr->id_count)--;
@@ -1107,6 +1193,119 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5I__remove_common() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5I__release_id
+ *
+ * Purpose:	Unlinks an ID from its type and puts its slot on the type's
+ *		free list, bumping the slot's generation so that the old ID
+ *		stays invalid when the slot is reused.
+ *
+ * Return:	void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5I__release_id(H5I_id_type_t *type_ptr, H5I_id_info_t *id_ptr)
+{
+    H5I_slot_t *slot;           /* ID's slot in the type's ID table */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    /* Sanity check */
+    HDassert(type_ptr);
+    HDassert(id_ptr);
+    HDassert(H5I_SLOT(id_ptr->id) < type_ptr->nslots);
+
+    /* Unlink the ID from the type's list of IDs */
+    if(id_ptr->prev)
+        id_ptr->prev->next = id_ptr->next;
+    else
+        type_ptr->first = id_ptr->next;
+    if(id_ptr->next)
+        id_ptr->next->prev = id_ptr->prev;
+    else
+        type_ptr->last = id_ptr->prev;
+
+    /* Free the slot */
+    slot = &type_ptr->slots[H5I_SLOT(id_ptr->id)];
+    HDassert(slot->info == id_ptr);
+    slot->info = NULL;
+    slot->gen = (slot->gen + 1) & H5I_GEN_MASK;
+    slot->next_free = type_ptr->free_slot;
+    type_ptr->free_slot = H5I_SLOT(id_ptr->id);
+
+    id_ptr = H5FL_FREE(H5I_id_info_t, id_ptr);
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5I__release_id() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5I__remove_id
+ *
+ * Purpose:	Removes an ID from its type.  While the type's IDs are being
+ *		iterated over, the ID is only marked as removed, and is
+ *		released when the outermost iteration ends.
+ *
+ * Return:	void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5I__remove_id(H5I_id_type_t *type_ptr, H5I_id_info_t *id_ptr)
+{
+    FUNC_ENTER_STATIC_NOERR
+
+    /* Sanity check */
+    HDassert(type_ptr);
+    HDassert(id_ptr);
+    HDassert(!id_ptr->marked);
+
+    if(type_ptr->iterating > 0) {
+        id_ptr->marked = TRUE;
+        type_ptr->has_marked = TRUE;
+    } /* end if */
+    else
+        H5I__release_id(type_ptr, id_ptr);
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5I__remove_id() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5I__end_iterate
+ *
+ * Purpose:	Ends an iteration over a type's IDs, releasing the IDs that
+ *		were removed during it if it was the outermost iteration.
+ *
+ * Return:	void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5I__end_iterate(H5I_id_type_t *type_ptr)
+{
+    FUNC_ENTER_STATIC_NOERR
+
+    /* Sanity check */
+    HDassert(type_ptr);
+    HDassert(type_ptr->iterating > 0);
+
+    if(--type_ptr->iterating == 0 && type_ptr->has_marked) {
+        H5I_id_info_t *id_ptr, *next_ptr;       /* Current & next IDs in the type */
+
+        for(id_ptr = type_ptr->first; id_ptr; id_ptr = next_ptr) {
+            next_ptr = id_ptr->next;
+            if(id_ptr->marked)
+                H5I__release_id(type_ptr, id_ptr);
+        } /* end for */
+        type_ptr->has_marked = FALSE;
+    } /* end if */
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5I__end_iterate() */
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5I_remove
@@ -1953,15 +2152,23 @@ H5I_iterate(H5I_type_t type, H5I_search_func_t func, void *udata, hbool_t app_re
     /* Only iterate through ID list if it is initialized and there are IDs in type */
     if(type_ptr && type_ptr->init_count > 0 && type_ptr->id_count > 0) {
         H5I_iterate_ud_t iter_udata;    /* User data for iteration callback */
-        herr_t iter_status;             /* Iteration status */
+        H5I_id_info_t *id_ptr, *next_ptr;       /* Current & next IDs in the type */
+        int iter_status = H5_ITER_CONT; /* Iteration status */
 
         /* Set up iterator user data */
         iter_udata.user_func = func;
         iter_udata.user_udata = udata;
         iter_udata.app_ref = app_ref;
 
-        /* Iterate over IDs */
-        if((iter_status = H5SL_iterate(type_ptr->ids, H5I__iterate_cb, &iter_udata)) < 0)
+        /* Iterate over IDs, skipping those removed during the iteration */
+        type_ptr->iterating++;
+        for(id_ptr = type_ptr->first; id_ptr && iter_status == H5_ITER_CONT; id_ptr = next_ptr) {
+            next_ptr = id_ptr->next;
+            if(!id_ptr->marked)
+                iter_status = H5I__iterate_cb(id_ptr, NULL, &iter_udata);
+        } /* end for */
+        H5I__end_iterate(type_ptr);
+        if(iter_status < 0)
             HGOTO_ERROR(H5E_ATOM, H5E_BADITER, FAIL, "iteration failed")
     } /* end if */
 
@@ -1989,6 +2196,8 @@ H5I__find_id(hid_t id)
 {
     H5I_type_t		type;			/*ID's type		*/
     H5I_id_type_t	*type_ptr;		/*ptr to the type	*/
+    H5I_id_info_t	*id_ptr;		/*ptr to the ID in the slot */
+    size_t		slot;			/*ID's slot		*/
     H5I_id_info_t	*ret_value = NULL;	/* Return value */
 
     FUNC_ENTER_STATIC_NOERR
@@ -2002,8 +2211,13 @@ H5I__find_id(hid_t id)
     if(!type_ptr || type_ptr->init_count <= 0)
 	HGOTO_DONE(NULL)
 
-    /* Locate the ID node for the ID */
-    ret_value = (H5I_id_info_t *)H5SL_search(type_ptr->ids, &id);
+    /* Locate the ID node for the ID, ignoring IDs whose slot was reused */
+    slot = H5I_SLOT(id);
+    if(slot >= type_ptr->nslots)
+	HGOTO_DONE(NULL)
+    id_ptr = type_ptr->slots[slot].info;
+    if(id_ptr && id_ptr->id == id && !id_ptr->marked)
+        ret_value = id_ptr;
 
 done:
     FUNC_LEAVE_NOAPI(ret_value)
@@ -2213,6 +2427,7 @@ static herr_t
 H5I__debug(H5I_type_t type)
 {
     H5I_id_type_t *type_ptr;
+    H5I_id_info_t *id_ptr;
 
     FUNC_ENTER_STATIC_NOERR
 
@@ -2223,11 +2438,13 @@ H5I__debug(H5I_type_t type)
     fprintf(stderr, "	 init_count = %u\n", type_ptr->init_count);
     fprintf(stderr, "	 reserved   = %u\n", type_ptr->cls->reserved);
     fprintf(stderr, "	 id_count   = %llu\n", (unsigned long long)type_ptr->id_count);
-    fprintf(stderr, "	 nextid	    = %llu\n", (unsigned long long)type_ptr->nextid);
+    fprintf(stderr, "	 nslots	    = %llu\n", (unsigned long long)type_ptr->nslots);
 
     /* List */
     fprintf(stderr, "	 List:\n");
-    H5SL_iterate(type_ptr->ids, H5I__debug_cb, &type);
+    for(id_ptr = type_ptr->first; id_ptr; id_ptr = id_ptr->next)
+        if(!id_ptr->marked)
+            H5I__debug_cb(id_ptr, NULL, &type);
 
     FUNC_LEAVE_NOAPI(SUCCEED)
 } /* end H5I__debug() */
@@ -470,6 +470,8 @@ HDfprintf(stderr, "%s: alloc_type = %u, size = %Hu\n", FUNC, (unsigned)alloc_typ
         if(f->shared->fs_man[fs_type]) {
             H5MF_free_section_t *node;      /* Free space section pointer */
             htri_t node_found = FALSE;      /* Whether an existing free list node was found */
+            haddr_t pad_addr = HADDR_UNDEF; /* Address of space skipped for paging */
+            hsize_t pad_size = 0;           /* Size of space skipped for paging */
 
             /* Try to get a section from the free space manager */
             if((node_found = H5FS_sect_find(f, dxpl_id, f->shared->fs_man[fs_type], size, (H5FS_section_info_t **)&node)) < 0)
@@ -478,6 +480,37 @@ HDfprintf(stderr, "%s: alloc_type = %u, size = %Hu\n", FUNC, (unsigned)alloc_typ
 HDfprintf(stderr, "%s: Check 1.5, node_found = %t\n", FUNC, node_found);
 #endif /* H5MF_ALLOC_DEBUG_MORE */
 
+            /* With paged aggregation, the block may have to start further into
+             * the section to respect page boundaries.
+             */
+            if(node_found) {
+                pad_size = H5MF_PAGE_PAD(f, node->sect_info.addr, size);
+
+                if(pad_size > 0) {
+                    if((pad_size + size) <= node->sect_info.size) {
+                        /* Skip over the padding, which is freed below */
+                        pad_addr = node->sect_info.addr;
+                        node->sect_info.addr += pad_size;
+                        node->sect_info.size -= pad_size;
+                    } /* end if */
+                    else {
+                        H5MF_sect_ud_t udata;               /* User data for callback */
+
+                        udata.f = f;
+                        udata.dxpl_id = dxpl_id;
+                        udata.alloc_type = alloc_type;
+                        udata.allow_sect_absorb = TRUE;
+                        udata.allow_eoa_shrink_only = FALSE;
+
+                        /* Put the section back and use an aggregator instead */
+                        pad_size = 0;
+                        if(H5FS_sect_add(f, dxpl_id, f->shared->fs_man[fs_type], (H5FS_section_info_t *)node, H5FS_ADD_RETURNED_SPACE, &udata) < 0)
+                            HGOTO_ERROR(H5E_RESOURCE, H5E_CANTINSERT, HADDR_UNDEF, "can't re-add section to file free space")
+                        node_found = FALSE;
+                    } /* end else */
+                } /* end if */
+            } /* end if */
+
             /* Check for actually finding section */
             if(node_found) {
                 /* Sanity check */
@@ -517,6 +550,11 @@ HDfprintf(stderr, "%s: Check 1.7, re-adding node, node->sect_info.size = %Hu\n",
                         HGOTO_ERROR(H5E_RESOURCE, H5E_CANTINSERT, HADDR_UNDEF, "can't re-add section to file free space")
                 } /* end else */
 
+                /* Return any space skipped for paging to the free space */
+                if(pad_size > 0)
+                    if(H5MF_xfree(f, alloc_type, dxpl_id, pad_addr, pad_size) < 0)
+                        HGOTO_ERROR(H5E_RESOURCE, H5E_CANTFREE, HADDR_UNDEF, "can't free page padding")
+
                 /* Leave now */
                 HGOTO_DONE(ret_value)
             } /* end if */
@@ -660,6 +698,10 @@ HDfprintf(stderr, "%s: Entering - alloc_type = %u, addr = %a, size = %Hu\n", FUN
     if(H5F__accum_free(&fio_info, alloc_type, addr, size) < 0)
         HGOTO_ERROR(H5E_RESOURCE, H5E_CANTFREE, FAIL, "can't check free space intersection w/metadata accumulator")
 
+    /* Drop any pages in the file's page buffer that are wholly freed */
+    if(H5F__page_free(f, addr, size) < 0)
+        HGOTO_ERROR(H5E_RESOURCE, H5E_CANTFREE, FAIL, "can't drop freed pages from page buffer")
+
     /* Get free space type from allocation type */
     fs_type = H5MF_ALLOC_TO_FS_TYPE(f, alloc_type);
 #ifdef H5MF_ALLOC_DEBUG_MORE
@@ -820,6 +862,10 @@ HDfprintf(stderr, "%s: Entering: alloc_type = %u, addr = %a, size = %Hu, extra_r
     if(H5AC_set_ring(dxpl_id, H5AC_RING_FSM, &dxpl, &orig_ring) < 0)
         HGOTO_ERROR(H5E_RESOURCE, H5E_CANTSET, FAIL, "unable to set ring value")
 
+    /* With paged aggregation, a small block mustn't grow across a page boundary */
+    if(H5MF_PAGE_PAD(f, addr, size + extra_requested) > 0)
+        HGOTO_DONE(FALSE)
+
     /* Check if the block is exactly at the end of the file */
     if((ret_value = H5FD_try_extend(f->shared->lf, map_type, f, end, extra_requested)) < 0)
         HGOTO_ERROR(H5E_RESOURCE, H5E_CANTEXTEND, FAIL, "error extending file")
@@ -1234,10 +1280,11 @@ HDfprintf(stderr, "%s: Entering\n", FUNC);
 
 	fsinfo.strategy = f->shared->fs_strategy;
 	fsinfo.threshold = f->shared->fs_threshold;
+	fsinfo.page_size = f->shared->fs_page_size;
 
 	/* Write free-space manager info message to superblock extension object header */
 	/* Create the superblock extension object header in advance if needed */
-	if(H5F_super_ext_write_msg(f, dxpl_id, &fsinfo, H5O_FSINFO_ID, TRUE) < 0)
+	if(H5F_super_ext_write_msg(f, dxpl_id, &fsinfo, H5O_FSINFO_ID, TRUE, H5O_MSG_FLAG_DONTSHARE) < 0)
 	    HGOTO_ERROR(H5E_RESOURCE, H5E_WRITEERROR, FAIL, "error in writing message to superblock extension")
 
 	/* Re-allocate free-space manager header and/or section info header */
@@ -1272,7 +1319,7 @@ HDfprintf(stderr, "%s: Entering\n", FUNC);
 
 	/* Update the free space manager info message in superblock extension object header */
 	if(update)
-            if(H5F_super_ext_write_msg(f, dxpl_id, &fsinfo, H5O_FSINFO_ID, FALSE) < 0)
+            if(H5F_super_ext_write_msg(f, dxpl_id, &fsinfo, H5O_FSINFO_ID, FALSE, H5O_MSG_FLAG_DONTSHARE) < 0)
 	        HGOTO_ERROR(H5E_RESOURCE, H5E_WRITEERROR, FAIL, "error in writing message to superblock extension")
 
 	/* Final close of free-space managers */
@@ -205,6 +205,10 @@ HDfprintf(stderr, "%s: aggr = {%a, %Hu, %Hu}\n", FUNC, aggr->addr, aggr->tot_siz
 	    aggr_frag_addr = aggr->addr;
 	    aggr_frag_size = alignment - aggr_mis_align;
 	} /* end if */
+        /* With paged aggregation, skip to the next page rather than have a
+         * small block cross a page boundary */
+        else if(aggr->addr > 0 && (aggr_frag_size = H5MF_PAGE_PAD(f, aggr->addr, size)) > 0)
+	    aggr_frag_addr = aggr->addr;
 
 	alloc_type = aggr->feature_flag == H5FD_FEAT_AGGREGATE_METADATA ? H5FD_MEM_DEFAULT : H5FD_MEM_DRAW;
 	other_alloc_type = other_aggr->feature_flag == H5FD_FEAT_AGGREGATE_METADATA ? H5FD_MEM_DEFAULT : H5FD_MEM_DRAW;
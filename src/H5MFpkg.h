@@ -55,6 +55,17 @@
 /* (values stored in free space data structures in file) */
 #define H5MF_FSPACE_SECT_SIMPLE         0       /* Section is a range of actual bytes in file */
 
+/* Padding needed in front of a block of S bytes at address A so that, with
+ * paged aggregation, a block of at least a page starts on a page boundary and
+ * a smaller block doesn't cross one.  (Zero for files without paging)
+ */
+#define H5MF_PAGE_OFFSET(F, A)  ((A) % (F)->shared->fs_page_size)
+#define H5MF_PAGE_PAD(F, A, S)                                                \
+    (((F)->shared->fs_page_size == 0 || H5MF_PAGE_OFFSET(F, A) == 0) ? (hsize_t)0 : \
+        (((S) >= (F)->shared->fs_page_size ||                                 \
+                (H5MF_PAGE_OFFSET(F, A) + (S)) > (F)->shared->fs_page_size) ? \
+            ((F)->shared->fs_page_size - H5MF_PAGE_OFFSET(F, A)) : (hsize_t)0))
+
 
 /****************************/
 /* Package Private Typedefs */
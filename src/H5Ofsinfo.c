@@ -65,8 +65,10 @@ const H5O_msg_class_t H5O_MSG_FSINFO[1] = {{
     H5O_fsinfo_debug          	/* debug the message            	*/
 }};
 
-/* Current version of free-space manager info information */
-#define H5O_FSINFO_VERSION 	0
+/* Versions of free-space manager info information */
+#define H5O_FSINFO_VERSION_0 	0
+#define H5O_FSINFO_VERSION_1 	1       /* Adds file space page size */
+#define H5O_FSINFO_VERSION_LATEST H5O_FSINFO_VERSION_1
 
 /* Declare a free list to manage the H5O_fsinfo_t struct */
 H5FL_DEFINE_STATIC(H5O_fsinfo_t);
@@ -90,6 +92,7 @@ H5O_fsinfo_decode(H5F_t *f, hid_t H5_ATTR_UNUSED dxpl_id, H5O_t H5_ATTR_UNUSED *
 {
     H5O_fsinfo_t	*fsinfo = NULL; /* free-space manager info */
     H5FD_mem_t 		type;		/* Memory type for iteration */
+    unsigned            vers;           /* Message version */
     void                *ret_value = NULL;      /* Return value */
 
     FUNC_ENTER_NOAPI_NOINIT
@@ -99,7 +102,8 @@ H5O_fsinfo_decode(H5F_t *f, hid_t H5_ATTR_UNUSED dxpl_id, H5O_t H5_ATTR_UNUSED *
     HDassert(p);
 
     /* Version of message */
-    if(*p++ != H5O_FSINFO_VERSION)
+    vers = *p++;
+    if(vers > H5O_FSINFO_VERSION_LATEST)
         HGOTO_ERROR(H5E_OHDR, H5E_CANTLOAD, NULL, "bad version number for message")
 
     /* Allocate space for message */
@@ -109,6 +113,13 @@ H5O_fsinfo_decode(H5F_t *f, hid_t H5_ATTR_UNUSED dxpl_id, H5O_t H5_ATTR_UNUSED *
     fsinfo->strategy = (H5F_file_space_type_t)*p++;	/* file space strategy */
     H5F_DECODE_LENGTH(f, p, fsinfo->threshold);	/* free space section size threshold */
 
+    /* File space page size: only exists for version 1 and later */
+    if(vers >= H5O_FSINFO_VERSION_1) {
+        H5F_DECODE_LENGTH(f, p, fsinfo->page_size);
+    } /* end if */
+    else
+        fsinfo->page_size = 0;
+
     /* Addresses of free space managers: only exist for H5F_FILE_SPACE_ALL_PERSIST */
     if(fsinfo->strategy == H5F_FILE_SPACE_ALL_PERSIST) {
 	for(type = H5FD_MEM_SUPER; type < H5FD_MEM_NTYPES; H5_INC_ENUM(H5FD_mem_t, type))
@@ -154,9 +165,13 @@ H5O_fsinfo_encode(H5F_t *f, hbool_t H5_ATTR_UNUSED disable_shared, uint8_t *p, c
     HDassert(p);
     HDassert(fsinfo);
 
-    *p++ = H5O_FSINFO_VERSION;	/* message version */
+    /* Use the newer version only when paged aggregation is in effect, so
+     * that files which don't use it remain readable by older libraries */
+    *p++ = (uint8_t)(fsinfo->page_size ? H5O_FSINFO_VERSION_1 : H5O_FSINFO_VERSION_0); /* message version */
     *p++ = fsinfo->strategy;	/* file space strategy */
     H5F_ENCODE_LENGTH(f, p, fsinfo->threshold); /* free-space section size threshold */
+    if(fsinfo->page_size)
+        H5F_ENCODE_LENGTH(f, p, fsinfo->page_size); /* file space page size */
 
     /* Addresses of free space managers: only exist for H5F_FILE_SPACE_ALL_PERSIST */
     if(fsinfo->strategy == H5F_FILE_SPACE_ALL_PERSIST) {
@@ -236,6 +251,7 @@ H5O_fsinfo_size(const H5F_t *f, hbool_t H5_ATTR_UNUSED disable_shared, const voi
 
     ret_value = 2                       /* Version & strategy */
 		+ (size_t)H5F_SIZEOF_SIZE(f)	/* Threshold */
+                + (fsinfo->page_size ? (size_t)H5F_SIZEOF_SIZE(f) : 0) /* Page size */
                 + fs_addr_size;		/* Addresses of free-space managers */
 
     FUNC_LEAVE_NOAPI(ret_value)
@@ -299,6 +315,9 @@ H5O_fsinfo_debug(H5F_t H5_ATTR_UNUSED *f, hid_t H5_ATTR_UNUSED dxpl_id, const vo
     HDfprintf(stream, "%*s%-*s %Hu\n", indent, "", fwidth,
               "Free space section threshold:", fsinfo->threshold);
 
+    HDfprintf(stream, "%*s%-*s %Hu\n", indent, "", fwidth,
+              "File space page size:", fsinfo->page_size);
+
     if(fsinfo->strategy == H5F_FILE_SPACE_ALL_PERSIST) {
 	for(type = H5FD_MEM_SUPER; type < H5FD_MEM_NTYPES; H5_INC_ENUM(H5FD_mem_t, type))
 	    HDfprintf(stream, "%*s%-*s %a\n", indent, "", fwidth,
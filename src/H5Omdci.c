@@ -0,0 +1,303 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * Copyright by the Board of Trustees of the University of Illinois.         *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of HDF5.  The full HDF5 copyright notice, including     *
+ * terms governing use, modification, and redistribution, is contained in    *
+ * the files COPYING and Copyright.html.  COPYING can be found at the root   *
+ * of the source code distribution tree; Copyright.html can be found at the  *
+ * root level of an installed copy of the electronic HDF5 document set and   *
+ * is linked from the top-level documents page.  It can also be found at     *
+ * http://hdfgroup.org/HDF5/doc/Copyright.html.  If you do not have          *
+ * access to either file, you may request a copy from help@hdfgroup.org.     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/*-------------------------------------------------------------------------
+ *
+ * Created:             H5Omdci.c
+ *
+ * Purpose:             Metadata cache image message.  Stored in the
+ *                      superblock extension to record the location of
+ *                      the block holding the metadata cache image that
+ *                      was written when the file was last closed.
+ *
+ *-------------------------------------------------------------------------
+ */
+
+#include "H5Omodule.h"          /* This source code file is part of the H5O module */
+
+
+#include "H5private.h"		/* Generic Functions	*/
+#include "H5Eprivate.h"		/* Error handling	*/
+#include "H5FLprivate.h"	/* Free lists          	*/
+#include "H5MFprivate.h"        /* File space management */
+#include "H5Opkg.h"             /* Object headers	*/
+
+/* PRIVATE PROTOTYPES */
+static void *H5O_mdci_decode(H5F_t *f, hid_t dxpl_id, H5O_t *open_oh, unsigned mesg_flags, unsigned *ioflags, const uint8_t *p);
+static herr_t H5O_mdci_encode(H5F_t *f, hbool_t disable_shared, uint8_t *p, const void *_mesg);
+static void *H5O_mdci_copy(const void *_mesg, void *_dest);
+static size_t H5O_mdci_size(const H5F_t *f, hbool_t disable_shared, const void *_mesg);
+static herr_t H5O_mdci_free(void *mesg);
+static herr_t H5O_mdci_delete(H5F_t *f, hid_t dxpl_id, H5O_t *open_oh, void *_mesg);
+static herr_t H5O_mdci_debug(H5F_t *f, hid_t dxpl_id, const void *_mesg,
+    FILE * stream, int indent, int fwidth);
+
+/* This message derives from H5O message class */
+const H5O_msg_class_t H5O_MSG_MDCI[1] = {{
+    H5O_MDCI_MSG_ID,          	/* message id number             	*/
+    "mdci",                 	/* message name for debugging    	*/
+    sizeof(H5O_mdci_t),       	/* native message size           	*/
+    0,				/* messages are sharable?        	*/
+    H5O_mdci_decode,          	/* decode message                	*/
+    H5O_mdci_encode,          	/* encode message                	*/
+    H5O_mdci_copy,            	/* copy the native value         	*/
+    H5O_mdci_size,            	/* size of metadata cache image message */
+    NULL,                   	/* default reset method         	*/
+    H5O_mdci_free,	        /* free method				*/
+    H5O_mdci_delete,  		/* file delete method			*/
+    NULL,			/* link method				*/
+    NULL,			/* set share method			*/
+    NULL,		    	/* can share method			*/
+    NULL,			/* pre copy native value to file 	*/
+    NULL,			/* copy native value to file    	*/
+    NULL,			/* post copy native value to file	*/
+    NULL,			/* get creation index			*/
+    NULL,			/* set creation index			*/
+    H5O_mdci_debug            	/* debug the message            	*/
+}};
+
+/* Current version of metadata cache image information */
+#define H5O_MDCI_VERSION_0 	0
+
+/* Declare a free list to manage the H5O_mdci_t struct */
+H5FL_DEFINE_STATIC(H5O_mdci_t);
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5O_mdci_decode
+ *
+ * Purpose:     Decode a message and return a pointer to a newly allocated one.
+ *
+ * Return:      Success:        Ptr to new message in native form.
+ *              Failure:        NULL
+ *
+ *-------------------------------------------------------------------------
+ */
+static void *
+H5O_mdci_decode(H5F_t *f, hid_t H5_ATTR_UNUSED dxpl_id, H5O_t H5_ATTR_UNUSED *open_oh,
+    unsigned H5_ATTR_UNUSED mesg_flags, unsigned H5_ATTR_UNUSED *ioflags, const uint8_t *p)
+{
+    H5O_mdci_t		*mesg = NULL;   /* New metadata cache image message */
+    void                *ret_value = NULL;      /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    /* check args */
+    HDassert(f);
+    HDassert(p);
+
+    /* Version of message */
+    if(*p++ != H5O_MDCI_VERSION_0)
+        HGOTO_ERROR(H5E_OHDR, H5E_CANTLOAD, NULL, "bad version number for message")
+
+    /* Allocate space for message */
+    if(NULL == (mesg = H5FL_MALLOC(H5O_mdci_t)))
+	HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, NULL, "memory allocation failed for metadata cache image message")
+
+    /* Decode */
+    H5F_addr_decode(f, &p, &(mesg->addr));
+    H5F_DECODE_LENGTH(f, p, mesg->size);
+
+    /* Set return value */
+    ret_value = mesg;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5O_mdci_decode() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5O_mdci_encode
+ *
+ * Purpose:     Encodes a message.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5O_mdci_encode(H5F_t *f, hbool_t H5_ATTR_UNUSED disable_shared, uint8_t *p, const void *_mesg)
+{
+    const H5O_mdci_t	*mesg = (const H5O_mdci_t *)_mesg;
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    /* check args */
+    HDassert(f);
+    HDassert(p);
+    HDassert(mesg);
+
+    /* encode */
+    *p++ = H5O_MDCI_VERSION_0;
+    H5F_addr_encode(f, &p, mesg->addr);
+    H5F_ENCODE_LENGTH(f, p, mesg->size);
+
+    FUNC_LEAVE_NOAPI(SUCCEED)
+} /* end H5O_mdci_encode() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5O_mdci_copy
+ *
+ * Purpose:     Copies a message from _MESG to _DEST, allocating _DEST if
+ *              necessary.
+ *
+ * Return:      Success:        Ptr to _DEST
+ *              Failure:        NULL
+ *
+ *-------------------------------------------------------------------------
+ */
+static void *
+H5O_mdci_copy(const void *_mesg, void *_dest)
+{
+    const H5O_mdci_t	*mesg = (const H5O_mdci_t *)_mesg;
+    H5O_mdci_t		*dest = (H5O_mdci_t *) _dest;
+    void		*ret_value = NULL;      /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    /* check args */
+    HDassert(mesg);
+    if(!dest && NULL == (dest = H5FL_MALLOC(H5O_mdci_t)))
+	HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, NULL, "memory allocation failed")
+
+    /* copy */
+    *dest = *mesg;
+
+    /* Set return value */
+    ret_value = dest;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5O_mdci_copy() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5O_mdci_size
+ *
+ * Purpose:     Returns the size of the raw message in bytes not counting
+ *              the message type or size fields, but only the data fields.
+ *              This function doesn't take into account alignment.
+ *
+ * Return:      Success:        Message data size in bytes without alignment.
+ *              Failure:        zero
+ *
+ *-------------------------------------------------------------------------
+ */
+static size_t
+H5O_mdci_size(const H5F_t *f, hbool_t H5_ATTR_UNUSED disable_shared,
+    const void H5_ATTR_UNUSED *_mesg)
+{
+    size_t ret_value = 0;       /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    /* check args */
+    HDassert(f);
+
+    ret_value = (size_t)(1 +                    /* Version number */
+                H5F_SIZEOF_ADDR(f) +            /* Address of image */
+                H5F_SIZEOF_SIZE(f));            /* Length of image */
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5O_mdci_size() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5O_mdci_free
+ *
+ * Purpose:     Free's the message
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5O_mdci_free(void *mesg)
+{
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    HDassert(mesg);
+
+    mesg = H5FL_FREE(H5O_mdci_t, mesg);
+
+    FUNC_LEAVE_NOAPI(SUCCEED)
+} /* end H5O_mdci_free() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5O_mdci_delete
+ *
+ * Purpose:     Free file space referenced by message
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5O_mdci_delete(H5F_t *f, hid_t dxpl_id, H5O_t H5_ATTR_UNUSED *open_oh, void *_mesg)
+{
+    H5O_mdci_t *mesg = (H5O_mdci_t *)_mesg;
+    herr_t ret_value = SUCCEED;   /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    /* check args */
+    HDassert(f);
+    HDassert(mesg);
+
+    /* Free file space for cache image */
+    if(H5F_addr_defined(mesg->addr))
+        if(H5MF_xfree(f, H5FD_MEM_SUPER, dxpl_id, mesg->addr, mesg->size) < 0)
+            HGOTO_ERROR(H5E_OHDR, H5E_CANTFREE, FAIL, "unable to free file space for cache image block")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5O_mdci_delete() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5O_mdci_debug
+ *
+ * Purpose:     Prints debugging info for a message.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5O_mdci_debug(H5F_t H5_ATTR_UNUSED *f, hid_t H5_ATTR_UNUSED dxpl_id, const void *_mesg, FILE * stream,
+	       int indent, int fwidth)
+{
+    const H5O_mdci_t	*mdci = (const H5O_mdci_t *) _mesg;
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    /* check args */
+    HDassert(f);
+    HDassert(mdci);
+    HDassert(stream);
+    HDassert(indent >= 0);
+    HDassert(fwidth >= 0);
+
+    HDfprintf(stream, "%*s%-*s %a\n", indent, "", fwidth,
+              "Metadata Cache Image Block address:", mdci->addr);
+
+    HDfprintf(stream, "%*s%-*s %Hu\n", indent, "", fwidth,
+              "Metadata Cache Image Block size in bytes:", mdci->size);
+
+    FUNC_LEAVE_NOAPI(SUCCEED)
+} /* end H5O_mdci_debug() */
+
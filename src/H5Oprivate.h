@@ -198,7 +198,8 @@ typedef struct H5O_copy_t {
 #define H5O_AINFO_ID    0x0015          /* Attribute info message.  */
 #define H5O_REFCOUNT_ID 0x0016          /* Reference count message.  */
 #define H5O_FSINFO_ID   0x0017          /* Free-space manager info message.  */
-#define H5O_UNKNOWN_ID  0x0018          /* Placeholder message ID for unknown message.  */
+#define H5O_MDCI_MSG_ID 0x0018          /* Metadata cache image message.  */
+#define H5O_UNKNOWN_ID  0x0019          /* Placeholder message ID for unknown message.  */
                                         /* (this should never exist in a file) */
 
 /* Shared object message types.
@@ -389,9 +390,17 @@ typedef struct H5O_efl_t {
  *      and 'size' callbacks for places to change when updating this. */
 #define H5O_LAYOUT_VERSION_LATEST H5O_LAYOUT_VERSION_4
 
+/* Flags for chunked layout feature encoding */
+#define H5O_LAYOUT_CHUNK_SINGLE_INDEX_WITH_FILTER       0x02
+#define H5O_LAYOUT_ALL_CHUNK_FLAGS      (                                     \
+    H5O_LAYOUT_CHUNK_SINGLE_INDEX_WITH_FILTER                                 \
+    )
+
 /* Forward declaration of structs used below */
 struct H5D_layout_ops_t;                /* Defined in H5Dpkg.h               */
 struct H5D_chunk_ops_t;                 /* Defined in H5Dpkg.h               */
+struct H5EA_t;                          /* Defined in H5EApkg.h              */
+struct H5FA_t;                          /* Defined in H5FApkg.h              */
 
 typedef struct H5O_storage_contig_t {
     haddr_t	addr;			/* File address of data              */
@@ -403,12 +412,31 @@ typedef struct H5O_storage_chunk_btree_t {
     H5UC_t     *shared;			/* Ref-counted shared info for B-tree nodes */
 } H5O_storage_chunk_btree_t;
 
+typedef struct H5O_storage_chunk_single_filt_t {
+    uint32_t    nbytes;                 /* Size of chunk (in file)           */
+    uint32_t    filter_mask;            /* Excluded filters for chunk        */
+} H5O_storage_chunk_single_filt_t;
+
+typedef struct H5O_storage_chunk_farray_t {
+    haddr_t     dset_ohdr_addr;         /* File address dataset's object header */
+    struct H5FA_t *fa;                  /* Pointer to fixed array struct     */
+} H5O_storage_chunk_farray_t;
+
+typedef struct H5O_storage_chunk_earray_t {
+    haddr_t     dset_ohdr_addr;         /* File address dataset's object header */
+    struct H5EA_t *ea;                  /* Pointer to extensible index struct */
+    hbool_t     ohdr_depend;            /* Whether the index header is a flush dependency child of the dataset's object header (SWMR writes) */
+} H5O_storage_chunk_earray_t;
+
 typedef struct H5O_storage_chunk_t {
     H5D_chunk_index_t idx_type;		/* Type of chunk index               */
     haddr_t	idx_addr;		/* File address of chunk index       */
     const struct H5D_chunk_ops_t *ops;  /* Pointer to chunked storage operations */
     union {
         H5O_storage_chunk_btree_t btree;   /* Information for v1 B-tree index   */
+        H5O_storage_chunk_single_filt_t single;    /* Information for single chunk w/ filters index */
+        H5O_storage_chunk_farray_t farray; /* Information for fixed array index */
+        H5O_storage_chunk_earray_t earray; /* Information for extensible array index */
     } u;
 } H5O_storage_chunk_t;
 
@@ -503,7 +531,34 @@ typedef struct H5O_storage_t {
     } u;
 } H5O_storage_t;
 
+typedef struct H5O_layout_chunk_farray_cparam_t {
+    uint8_t max_dblk_page_nelmts_bits;  /* Log2(Max. # of elements in a data block page) -
+                                         * i.e. # of bits needed to store max. # of elements
+                                         * in a data block page
+                                         */
+} H5O_layout_chunk_farray_cparam_t;
+
+typedef struct H5O_layout_chunk_farray_t {
+    H5O_layout_chunk_farray_cparam_t cparam; /* Creation parameters for fixed array data structure */
+} H5O_layout_chunk_farray_t;
+
+typedef struct H5O_layout_chunk_earray_cparam_t {
+    uint8_t max_nelmts_bits;            /* Log2(Max. # of elements in array) - i.e. # of bits needed to store max. # of elements */
+    uint8_t idx_blk_elmts;              /* # of elements to store in index block */
+    uint8_t data_blk_min_elmts;         /* Min. # of elements per data block */
+    uint8_t sup_blk_min_data_ptrs;      /* Min. # of data block pointers for a super block */
+    uint8_t max_dblk_page_nelmts_bits;  /* Log2(Max. # of elements in data block page) - i.e. # of bits needed to store max. # of elements in data block page */
+} H5O_layout_chunk_earray_cparam_t;
+
+typedef struct H5O_layout_chunk_earray_t {
+    H5O_layout_chunk_earray_cparam_t cparam; /* Creation parameters for extensible array data structure */
+    unsigned unlim_dim;                 /* Rank of unlimited dimension for dataset */
+    hsize_t swizzled_max_chunks[H5O_LAYOUT_NDIMS];      /* # of chunks in each max. dimension, with the unlimited dimension first */
+    hsize_t swizzled_max_down_chunks[H5O_LAYOUT_NDIMS]; /* "down" size of swizzled_max_chunks */
+} H5O_layout_chunk_earray_t;
+
 typedef struct H5O_layout_chunk_t {
+    uint8_t     flags;                  /* Chunk layout flags                */
     unsigned	ndims;			/* Num dimensions in chunk           */
     uint32_t	dim[H5O_LAYOUT_NDIMS];	/* Size of chunk in elements         */
     unsigned    enc_bytes_per_dim;      /* Encoded # of bytes for storing each chunk dimension */
@@ -514,6 +569,10 @@ typedef struct H5O_layout_chunk_t {
     hsize_t     max_chunks[H5O_LAYOUT_NDIMS];      /* # of chunks in each dataset's max. dimension */
     hsize_t    	down_chunks[H5O_LAYOUT_NDIMS];     /* "down" size of number of chunks in each dimension */
     hsize_t    	max_down_chunks[H5O_LAYOUT_NDIMS]; /* "down" size of number of chunks in each max dim */
+    union {
+        H5O_layout_chunk_farray_t farray;  /* Information for fixed array index */
+        H5O_layout_chunk_earray_t earray;  /* Information for extensible array index */
+    } u;
 } H5O_layout_chunk_t;
 
 typedef struct H5O_layout_t {
@@ -694,9 +753,20 @@ typedef unsigned H5O_unknown_t;         /* Original message type ID */
 typedef struct H5O_fsinfo_t {
     H5F_file_space_type_t strategy;	/* File space strategy */
     hsize_t		  threshold;	/* Free space section threshold */
+    hsize_t		  page_size;	/* File space page size (0 if not paged) */
     haddr_t     	  fs_addr[H5FD_MEM_NTYPES-1]; /* Addresses of free space managers */
 } H5O_fsinfo_t;
 
+/*
+ * Metadata Cache Image Message.
+ * Contains the base address and length of the metadata cache image.
+ * (Data structure in memory)
+ */
+typedef struct H5O_mdci_t {
+    haddr_t	addr;		/* Address of the metadata cache image */
+    hsize_t	size;		/* Size of the metadata cache image */
+} H5O_mdci_t;
+
 /* Typedef for "application" iteration operations */
 typedef herr_t (*H5O_operator_t)(const void *mesg/*in*/, unsigned idx,
     void *operator_data/*in,out*/);
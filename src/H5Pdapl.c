@@ -63,6 +63,16 @@
 #define H5D_ACS_PREEMPT_READ_CHUNKS_DEF         H5D_CHUNK_CACHE_W0_DEFAULT
 #define H5D_ACS_PREEMPT_READ_CHUNKS_ENC         H5P__encode_double
 #define H5D_ACS_PREEMPT_READ_CHUNKS_DEC         H5P__decode_double
+/* Definitions for chunk read-ahead */
+#define H5D_ACS_CHUNK_PREFETCH_SIZE             sizeof(size_t)
+#define H5D_ACS_CHUNK_PREFETCH_DEF              0
+#define H5D_ACS_CHUNK_PREFETCH_ENC              H5P__encode_size_t
+#define H5D_ACS_CHUNK_PREFETCH_DEC              H5P__decode_size_t
+/* Definitions for chunk write-behind */
+#define H5D_ACS_CHUNK_WRITE_BEHIND_SIZE         sizeof(size_t)
+#define H5D_ACS_CHUNK_WRITE_BEHIND_DEF          0
+#define H5D_ACS_CHUNK_WRITE_BEHIND_ENC          H5P__encode_size_t
+#define H5D_ACS_CHUNK_WRITE_BEHIND_DEC          H5P__decode_size_t
 /* Definitions for VDS view option */
 #define H5D_ACS_VDS_VIEW_SIZE                   sizeof(H5D_vds_view_t)
 #define H5D_ACS_VDS_VIEW_DEF                    H5D_VDS_LAST_AVAILABLE
@@ -179,6 +189,8 @@ H5P__dacc_reg_prop(H5P_genclass_t *pclass)
     size_t rdcc_nslots = H5D_ACS_DATA_CACHE_NUM_SLOTS_DEF;      /* Default raw data chunk cache # of slots */
     size_t rdcc_nbytes = H5D_ACS_DATA_CACHE_BYTE_SIZE_DEF;      /* Default raw data chunk cache # of bytes */
     double rdcc_w0 = H5D_ACS_PREEMPT_READ_CHUNKS_DEF;           /* Default raw data chunk cache dirty ratio */
+    size_t prefetch = H5D_ACS_CHUNK_PREFETCH_DEF;               /* Default # of chunks to read ahead */
+    size_t write_behind = H5D_ACS_CHUNK_WRITE_BEHIND_DEF;       /* Default # of chunks to write behind */
     H5D_vds_view_t virtual_view = H5D_ACS_VDS_VIEW_DEF;         /* Default VDS view option */
     hsize_t printf_gap = H5D_ACS_VDS_PRINTF_GAP_DEF;            /* Default VDS printf gap */
     herr_t ret_value = SUCCEED;         /* Return value */
@@ -200,6 +212,16 @@ H5P__dacc_reg_prop(H5P_genclass_t *pclass)
              NULL, NULL, NULL, H5D_ACS_PREEMPT_READ_CHUNKS_ENC, H5D_ACS_PREEMPT_READ_CHUNKS_DEC, NULL, NULL, NULL, NULL) < 0)
          HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
 
+    /* Register the # of chunks to read ahead */
+    if(H5P_register_real(pclass, H5D_ACS_CHUNK_PREFETCH_NAME, H5D_ACS_CHUNK_PREFETCH_SIZE, &prefetch,
+             NULL, NULL, NULL, H5D_ACS_CHUNK_PREFETCH_ENC, H5D_ACS_CHUNK_PREFETCH_DEC, NULL, NULL, NULL, NULL) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
+
+    /* Register the # of chunks to write behind */
+    if(H5P_register_real(pclass, H5D_ACS_CHUNK_WRITE_BEHIND_NAME, H5D_ACS_CHUNK_WRITE_BEHIND_SIZE, &write_behind,
+             NULL, NULL, NULL, H5D_ACS_CHUNK_WRITE_BEHIND_ENC, H5D_ACS_CHUNK_WRITE_BEHIND_DEC, NULL, NULL, NULL, NULL) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
+
     /* Register the VDS view option */
     if(H5P_register_real(pclass, H5D_ACS_VDS_VIEW_NAME, H5D_ACS_VDS_VIEW_SIZE, &virtual_view,
             NULL, NULL, NULL, H5D_ACS_VDS_VIEW_ENC, H5D_ACS_VDS_VIEW_DEC,
@@ -606,6 +628,150 @@ done:
     FUNC_LEAVE_API(ret_value)
 } /* end H5Pget_chunk_cache() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Pset_chunk_prefetch
+ *
+ * Purpose:	Set the number of chunks to read ahead when a chunked
+ *		dataset is read sequentially.  Once the chunks are accessed
+ *		with a constant stride (in the order of the chunk indices),
+ *		the next NCHUNKS chunks along that stride are read from the
+ *		file and run through the filter pipeline in the background
+ *		while the current chunk is processed, and are kept until
+ *		they're accessed.
+ *
+ *		A value of zero (the default) disables reading ahead.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pset_chunk_prefetch(hid_t dapl_id, size_t nchunks)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value = SUCCEED; /* return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "iz", dapl_id, nchunks);
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(dapl_id, H5P_DATASET_ACCESS)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Set value */
+    if(H5P_set(plist, H5D_ACS_CHUNK_PREFETCH_NAME, &nchunks) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set # of chunks to read ahead")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pset_chunk_prefetch() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Pget_chunk_prefetch
+ *
+ * Purpose:	Retrieves the number of chunks to read ahead when a chunked
+ *		dataset is read sequentially.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pget_chunk_prefetch(hid_t dapl_id, size_t *nchunks /*out*/)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value = SUCCEED; /* return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "ix", dapl_id, nchunks);
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(dapl_id, H5P_DATASET_ACCESS)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Get value */
+    if(nchunks)
+        if(H5P_get(plist, H5D_ACS_CHUNK_PREFETCH_NAME, nchunks) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get # of chunks to read ahead")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pget_chunk_prefetch() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Pset_chunk_write_behind
+ *
+ * Purpose:	Set the number of dirty chunks of a filtered dataset to
+ *		collect when they're evicted from the chunk cache during an
+ *		I/O operation.  Each time NCHUNKS chunks have been collected
+ *		they're run through the filter pipeline in the background,
+ *		and written to the file while the next group is collected
+ *		(or at the end of the operation).
+ *
+ *		A value of zero (the default) writes evicted chunks as soon
+ *		as they're evicted.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pset_chunk_write_behind(hid_t dapl_id, size_t nchunks)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value = SUCCEED; /* return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "iz", dapl_id, nchunks);
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(dapl_id, H5P_DATASET_ACCESS)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Set value */
+    if(H5P_set(plist, H5D_ACS_CHUNK_WRITE_BEHIND_NAME, &nchunks) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set # of chunks to write behind")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pset_chunk_write_behind() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Pget_chunk_write_behind
+ *
+ * Purpose:	Retrieves the number of evicted chunks to collect before
+ *		writing them in the background.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pget_chunk_write_behind(hid_t dapl_id, size_t *nchunks /*out*/)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value = SUCCEED; /* return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "ix", dapl_id, nchunks);
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(dapl_id, H5P_DATASET_ACCESS)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Get value */
+    if(nchunks)
+        if(H5P_get(plist, H5D_ACS_CHUNK_WRITE_BEHIND_NAME, nchunks) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get # of chunks to write behind")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pget_chunk_write_behind() */
+
 
 /*-------------------------------------------------------------------------
  * Function:       H5P__encode_chunk_cache_nslots
@@ -44,6 +44,11 @@
 /* Local Macros */
 /****************/
 
+/* Mark a list's cached property values stale when a property among them changes */
+#define H5P_CACHE_CHANGED(L, P)                                               \
+    if((P)->cached)                                                           \
+        (L)->cache_valid = FALSE;
+
 
 /******************/
 /* Local Typedefs */
@@ -692,6 +697,10 @@ H5P_copy_pclass(H5P_genclass_t *pclass)
     if(NULL == (new_pclass = H5P_create_class(pclass->parent, pclass->name, pclass->type, pclass->create_func, pclass->create_data, pclass->copy_func, pclass->copy_data, pclass->close_func, pclass->close_data)))
         HGOTO_ERROR(H5E_PLIST, H5E_CANTCREATE, NULL, "unable to create property list class")
 
+    /* Keep the class's struct of cached values */
+    new_pclass->cache_size = pclass->cache_size;
+    new_pclass->cache_func = pclass->cache_func;
+
     /* Copy the properties registered for this class */
     if(pclass->nprops > 0) {
         H5SL_node_t *curr_node;   /* Current node in skip list */
@@ -1101,6 +1110,7 @@ H5P_create_prop(const char *name, size_t size, H5P_prop_within_t type,
     /* Set the property initial values */
     prop->name = H5MM_xstrdup(name); /* Duplicate name */
     prop->shared_name = FALSE;
+    prop->cached = FALSE;
     prop->size = size;
     prop->type = type;
 
@@ -1214,7 +1224,7 @@ H5P__find_prop_plist(const H5P_genplist_t *plist, const char *name)
     HDassert(name);
 
     /* Check if the property has been deleted from list */
-    if(H5SL_search(plist->del,name) != NULL) {
+    if(H5SL_count(plist->del) > 0 && H5SL_search(plist->del,name) != NULL) {
         HGOTO_ERROR(H5E_PLIST, H5E_NOTFOUND, NULL, "property deleted from skip list")
     } /* end if */
     else {
@@ -2578,6 +2588,12 @@ H5P_insert(H5P_genplist_t *plist, const char *name, size_t size,
             prp_cmp, prp_close)))
         HGOTO_ERROR(H5E_PLIST, H5E_CANTCREATE, FAIL, "Can't create property")
 
+    /* The property may replace a deleted one from the list's cached values,
+     * so treat changes to it as changes to them.
+     */
+    new_prop->cached = TRUE;
+    plist->cache_valid = FALSE;
+
     /* Insert property into property list class */
     if(H5P_add_prop(plist->props, new_prop) < 0)
         HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "Can't insert property into class")
@@ -2634,11 +2650,11 @@ H5P__do_prop(H5P_genplist_t *plist, const char *name, H5P_do_plist_op_t plist_op
     HDassert(pclass_op);
 
     /* Check if the property has been deleted */
-    if(NULL != H5SL_search(plist->del, name))
+    if(H5SL_count(plist->del) > 0 && NULL != H5SL_search(plist->del, name))
         HGOTO_ERROR(H5E_PLIST, H5E_NOTFOUND, FAIL, "property doesn't exist")
 
     /* Find property in changed list */
-    if(NULL != (prop = (H5P_genprop_t *)H5SL_search(plist->props, name))) {
+    if(H5SL_count(plist->props) > 0 && NULL != (prop = (H5P_genprop_t *)H5SL_search(plist->props, name))) {
         /* Call the 'found in propery list' callback */
         if((*plist_op)(plist, name, prop, udata) < 0)
             HGOTO_ERROR(H5E_PLIST, H5E_CANTOPERATE, FAIL, "can't operate on property")
@@ -2713,6 +2729,9 @@ H5P__poke_plist_cb(H5P_genplist_t *plist, const char *name, H5P_genprop_t *prop,
     HDassert(name);
     HDassert(prop);
 
+    /* The list's cached values are stale, if they include this property */
+    H5P_CACHE_CHANGED(plist, prop)
+
     /* Check for property size >0 */
     if(0 == prop->size)
         HGOTO_ERROR(H5E_PLIST, H5E_BADVALUE, FAIL, "property has zero size")
@@ -2762,6 +2781,9 @@ H5P__poke_pclass_cb(H5P_genplist_t *plist, const char *name, H5P_genprop_t *prop
     HDassert(prop);
     HDassert(prop->cmp);
 
+    /* The list's cached values are stale, if they include this property */
+    H5P_CACHE_CHANGED(plist, prop)
+
     /* Check for property size >0 */
     if(0 == prop->size)
         HGOTO_ERROR(H5E_PLIST, H5E_BADVALUE, FAIL, "property has zero size")
@@ -2832,6 +2854,132 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 }   /* H5P_poke() */
 
+
+/*--------------------------------------------------------------------------
+ NAME
+    H5P_set_class_cache
+ PURPOSE
+    Internal routine to define the struct of property values that lists of
+    a class cache.
+ USAGE
+    herr_t H5P_set_class_cache(pclass, size, cache_func, names)
+        H5P_genclass_t *pclass;     IN: Property list class to modify
+        size_t size;                IN: Size of the struct
+        H5P_cls_cache_func_t cache_func; IN: Function to fill the struct
+                                    from a property list of the class
+        const char * const *names;  IN: NULL-terminated array of the names
+                                    of the properties the struct holds
+ RETURNS
+    Returns non-negative on success, negative on failure.
+ DESCRIPTION
+        Library classes whose properties are queried on every I/O call can
+    keep them decoded in a struct with a fixed layout, which H5P_get_cache()
+    fills once per property list and then hands out until one of the named
+    properties changes in that list.  Only changes to the named properties
+    are tracked, so CACHE_FUNC must not read any others, and their values
+    must not depend on 'get' callbacks.
+ GLOBAL VARIABLES
+ COMMENTS, BUGS, ASSUMPTIONS
+    Must be called before any property lists of the class are created.
+ EXAMPLES
+ REVISION LOG
+--------------------------------------------------------------------------*/
+herr_t
+H5P_set_class_cache(H5P_genclass_t *pclass, size_t size,
+    H5P_cls_cache_func_t cache_func, const char * const *names)
+{
+    H5P_genprop_t *prop;        /* Property in the struct */
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    /* Sanity check */
+    HDassert(pclass);
+    HDassert(pclass->plists == 0);
+    HDassert(size > 0);
+    HDassert(cache_func);
+    HDassert(names);
+
+    /* Mark the properties held in the struct */
+    for(; *names; names++) {
+        if(NULL == (prop = H5P_find_prop_pclass(pclass, *names)))
+            HGOTO_ERROR(H5E_PLIST, H5E_NOTFOUND, FAIL, "can't find property in class")
+        prop->cached = TRUE;
+    } /* end for */
+
+    pclass->cache_size = size;
+    pclass->cache_func = cache_func;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+}   /* H5P_set_class_cache() */
+
+
+/*--------------------------------------------------------------------------
+ NAME
+    H5P_get_cache
+ PURPOSE
+    Internal routine to retrieve the struct of cached property values for a
+    property list.
+ USAGE
+    herr_t H5P_get_cache(plist, value)
+        H5P_genplist_t *plist;  IN: Property list to query
+        void *value;            OUT: Pointer to the struct to fill
+ RETURNS
+    Returns non-negative on success, negative on failure.
+ DESCRIPTION
+        Copies the struct of property values defined with
+    H5P_set_class_cache() for the list's class (or the nearest ancestor class
+    with one) into VALUE.  The struct is only filled from the properties when
+    the list has none cached or one of its properties has changed since.
+        Lists of classes derived from the one defining the struct are filled
+    each time, as their own properties could shadow those in the struct.
+ GLOBAL VARIABLES
+ COMMENTS, BUGS, ASSUMPTIONS
+ EXAMPLES
+ REVISION LOG
+--------------------------------------------------------------------------*/
+herr_t
+H5P_get_cache(H5P_genplist_t *plist, void *value)
+{
+    H5P_genclass_t *tclass;     /* Class defining the struct */
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    /* Sanity check */
+    HDassert(plist);
+    HDassert(value);
+
+    /* Use the list's cached values, if they are current */
+    if(plist->cache_valid) {
+        HDmemcpy(value, plist->cache, plist->pclass->cache_size);
+        HGOTO_DONE(SUCCEED)
+    } /* end if */
+
+    /* Find the class defining the struct */
+    tclass = plist->pclass;
+    while(tclass && 0 == tclass->cache_size)
+        tclass = tclass->parent;
+    if(NULL == tclass)
+        HGOTO_ERROR(H5E_PLIST, H5E_NOTFOUND, FAIL, "property list class has no cached values")
+
+    /* Fill the struct from the properties */
+    if((*tclass->cache_func)(plist, value) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't retrieve property values")
+
+    /* Keep the values for the next query */
+    if(tclass == plist->pclass) {
+        if(NULL == plist->cache && NULL == (plist->cache = H5MM_malloc(tclass->cache_size)))
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTALLOC, FAIL, "memory allocation failed for cached property values")
+        HDmemcpy(plist->cache, value, tclass->cache_size);
+        plist->cache_valid = TRUE;
+    } /* end if */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+}   /* H5P_get_cache() */
+
 
 /*--------------------------------------------------------------------------
  NAME
@@ -2869,6 +3017,9 @@ H5P__set_plist_cb(H5P_genplist_t *plist, const char *name, H5P_genprop_t *prop,
     HDassert(name);
     HDassert(prop);
 
+    /* The list's cached values are stale, if they include this property */
+    H5P_CACHE_CHANGED(plist, prop)
+
     /* Check for property size >0 */
     if(0 == prop->size)
         HGOTO_ERROR(H5E_PLIST, H5E_BADVALUE, FAIL, "property has zero size")
@@ -2945,6 +3096,9 @@ H5P__set_pclass_cb(H5P_genplist_t *plist, const char *name, H5P_genprop_t *prop,
     HDassert(prop);
     HDassert(prop->cmp);
 
+    /* The list's cached values are stale, if they include this property */
+    H5P_CACHE_CHANGED(plist, prop)
+
     /* Check for property size >0 */
     if(0 == prop->size)
         HGOTO_ERROR(H5E_PLIST, H5E_BADVALUE, FAIL, "property has zero size")
@@ -4425,6 +4579,9 @@ H5P__del_plist_cb(H5P_genplist_t *plist, const char *name, H5P_genprop_t *prop,
     HDassert(name);
     HDassert(prop);
 
+    /* The list's cached values are stale, if they include this property */
+    H5P_CACHE_CHANGED(plist, prop)
+
     /* Pass value to 'close' callback, if it exists */
     if(NULL != prop->del) {
         /* Call user's callback */
@@ -4496,6 +4653,9 @@ H5P__del_pclass_cb(H5P_genplist_t *plist, const char *name, H5P_genprop_t *prop,
     HDassert(name);
     HDassert(prop);
 
+    /* The list's cached values are stale, if they include this property */
+    H5P_CACHE_CHANGED(plist, prop)
+
     /* Pass value to 'del' callback, if it exists */
     if(NULL != prop->del) {
         /* Allocate space for a temporary copy of the property value */
@@ -4664,6 +4824,12 @@ H5P_copy_prop_plist(hid_t dst_id, hid_t src_id, const char *name)
                 prop->del, prop->copy, prop->cmp, prop->close)))
             HGOTO_ERROR(H5E_PLIST, H5E_CANTCREATE, FAIL,"Can't create property")
 
+        /* Treat changes to the property as changes to the list's cached values,
+         * as for properties inserted with H5P_insert()
+         */
+        new_prop->cached = TRUE;
+        dst_plist->cache_valid = FALSE;
+
         /* Call property creation callback, if it exists */
         if(new_prop->create) {
             if((new_prop->create)(new_prop->name, new_prop->size, new_prop->value) < 0)
@@ -4990,6 +5156,9 @@ H5P_close(void *_plist)
     /* Free the properties */
     H5SL_destroy(plist->props,H5P_free_prop_cb,&make_cb);
 
+    /* Free the cached property values */
+    H5MM_xfree(plist->cache);
+
     /* Destroy property list object */
     plist = H5FL_FREE(H5P_genplist_t, plist);
 
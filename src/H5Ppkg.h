@@ -70,6 +70,7 @@ typedef struct H5P_genprop_t {
     void *value;        /* Pointer to property value */
     H5P_prop_within_t type;     /* Type of object the property is within */
     hbool_t shared_name;   /* Whether the name is shared or not */
+    hbool_t cached;     /* Whether the value is in the class's struct of cached values */
 
     /* Callback function pointers & info */
     H5P_prp_create_func_t create;   /* Function to call when a property is created */
@@ -103,6 +104,10 @@ struct H5P_genclass_t {
     void *copy_data;       /* Pointer to user data to pass along to copy callback */
     H5P_cls_close_func_t close_func;    /* Function to call when a property list is closed */
     void *close_data;      /* Pointer to user data to pass along to close callback */
+
+    /* Struct of property values that lists of this class cache */
+    size_t     cache_size; /* Size of the struct (0 if the class has none) */
+    H5P_cls_cache_func_t cache_func;    /* Function to fill the struct from a property list */
 };
 
 /* Define structure to hold property list information */
@@ -113,6 +118,8 @@ struct H5P_genplist_t {
     hbool_t class_init; /* Whether the class initialization callback finished successfully */
     H5SL_t *del;        /* Skip list containing names of deleted properties */
     H5SL_t *props;      /* Skip list containing properties */
+    void   *cache;      /* Struct of cached property values, for the class's cache */
+    hbool_t cache_valid; /* Whether the cached values are current */
 };
 
 /* Property list/class iterator callback function pointer */
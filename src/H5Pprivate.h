@@ -88,6 +88,9 @@ typedef enum H5P_plist_type_t {
 /* Function pointer for library classes with properties to register */
 typedef herr_t (*H5P_reg_prop_func_t)(H5P_genclass_t *pclass);
 
+/* Function pointer for filling a class's struct of cached property values */
+typedef herr_t (*H5P_cls_cache_func_t)(H5P_genplist_t *plist, void *cache);
+
 /*
  * Each library property list class has a variable of this type that contains
  * class variables and methods used to initialize the class.
@@ -158,6 +161,9 @@ H5_DLL herr_t H5P_get(H5P_genplist_t *plist, const char *name, void *value);
 H5_DLL herr_t H5P_set(H5P_genplist_t *plist, const char *name, const void *value);
 H5_DLL herr_t H5P_peek(H5P_genplist_t *plist, const char *name, void *value);
 H5_DLL herr_t H5P_poke(H5P_genplist_t *plist, const char *name, const void *value);
+H5_DLL herr_t H5P_set_class_cache(H5P_genclass_t *pclass, size_t size,
+    H5P_cls_cache_func_t cache_func, const char * const *names);
+H5_DLL herr_t H5P_get_cache(H5P_genplist_t *plist, void *value);
 H5_DLL herr_t H5P_insert(H5P_genplist_t *plist, const char *name, size_t size,
     void *value, H5P_prp_set_func_t prp_set, H5P_prp_get_func_t prp_get,
     H5P_prp_encode_func_t prp_encode, H5P_prp_decode_func_t prp_decode,
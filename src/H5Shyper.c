@@ -24,14 +24,31 @@
 
 
 #include "H5private.h"		/* Generic Functions			*/
+#include "H5Dprivate.h"		/* Datasets				*/
 #include "H5Eprivate.h"		/* Error handling			*/
 #include "H5FLprivate.h"	/* Free Lists				*/
 #include "H5Iprivate.h"		/* ID Functions				*/
+#include "H5MMprivate.h"	/* Memory management			*/
 #include "H5Spkg.h"		/* Dataspace functions			*/
 #include "H5VMprivate.h"         /* Vector functions			*/
 
 /* Local datatypes */
 
+/* Block bound, sorted when building a span tree from a list of blocks */
+typedef struct H5S_hyper_block_ent_t {
+    hsize_t low;                /* Low bound of block in a dimension */
+    size_t idx;                 /* Index of block in the caller's list */
+} H5S_hyper_block_ent_t;
+
+/* Information for building a span tree from a list of blocks */
+typedef struct H5S_hyper_block_info_t {
+    unsigned rank;              /* Rank of dataspace */
+    const hsize_t *start;       /* Start of each block, rank values per block */
+    const hsize_t *block;       /* Size of each block, rank values per block */
+    H5S_hyper_block_ent_t *ent[H5S_MAX_RANK];  /* Blocks sorted by low bound, per dimension */
+    hsize_t *bound[H5S_MAX_RANK];   /* Sorted span boundaries, per dimension */
+    size_t *active[H5S_MAX_RANK];   /* Blocks covering the current span, per dimension */
+} H5S_hyper_block_info_t;
 /* Static function prototypes */
 static herr_t H5S_hyper_free_span_info(H5S_hyper_span_info_t *span_info);
 static herr_t H5S_hyper_free_span(H5S_hyper_span_t *span);
@@ -41,6 +58,14 @@ static herr_t H5S_hyper_span_precompute(H5S_hyper_span_info_t *spans, size_t elm
 static herr_t H5S_generate_hyperslab(H5S_t *space, H5S_seloper_t op,
     const hsize_t start[], const hsize_t stride[], const hsize_t count[], const hsize_t block[]);
 static herr_t H5S_hyper_generate_spans(H5S_t *space);
+#ifndef NEW_HYPERSLAB_API
+static herr_t H5S_hyper_combine_spans(H5S_t *space, H5S_seloper_t op,
+    H5S_hyper_span_info_t *new_spans);
+static int H5S_hyper_cmp_block_ent(const void *_ent1, const void *_ent2);
+static int H5S_hyper_cmp_block_bound(const void *_bound1, const void *_bound2);
+static H5S_hyper_span_info_t *H5S_hyper_make_spans_blocks(H5S_hyper_block_info_t *info,
+    unsigned dim, const size_t *blocks, size_t nblocks);
+#endif /* NEW_HYPERSLAB_API */
 /* Needed for use in hyperslab code (H5Shyper.c) */
 #ifdef NEW_HYPERSLAB_API
 static herr_t H5S_select_select (H5S_t *space1, H5S_seloper_t op, H5S_t *space2);
@@ -73,6 +98,11 @@ static herr_t H5S_hyper_adjust_u(H5S_t *space, const hsize_t *offset);
 static herr_t H5S_hyper_project_scalar(const H5S_t *space, hsize_t *offset);
 static herr_t H5S_hyper_project_simple(const H5S_t *space, H5S_t *new_space, hsize_t *offset);
 static herr_t H5S_hyper_iter_init(H5S_sel_iter_t *iter, const H5S_t *space);
+static hbool_t H5S_hyper_seq_cache_valid(const H5S_t *space);
+static void H5S_hyper_free_seq_cache(H5S_hyper_seq_cache_t *cache);
+static herr_t H5S_hyper_get_seq_list_cached(H5S_sel_iter_t *iter,
+    size_t maxseq, size_t maxelem, size_t *nseq, size_t *nelem,
+    hsize_t *off, size_t *len);
 
 /* Selection iteration callbacks */
 static herr_t H5S_hyper_iter_coords(const H5S_sel_iter_t *iter, hsize_t *coords);
@@ -145,6 +175,9 @@ H5FL_DEFINE_STATIC(H5S_hyper_span_t);
 /* Declare a free list to manage the H5S_hyper_span_info_t struct */
 H5FL_DEFINE_STATIC(H5S_hyper_span_info_t);
 
+/* Declare a free list to manage the H5S_hyper_seq_cache_t struct */
+H5FL_DEFINE_STATIC(H5S_hyper_seq_cache_t);
+
 /* #define H5S_HYPER_DEBUG */
 #ifdef H5S_HYPER_DEBUG
 static herr_t
@@ -383,6 +416,14 @@ H5S_hyper_iter_init(H5S_sel_iter_t *iter, const H5S_t *space)
 
         /* Initialize irregular region information also (for release) */
         iter->u.hyp.spans = NULL;
+
+        /* Generate sequences from the compiled list, if it is up to date */
+        if(iter->elmt_size > 0 && H5S_hyper_seq_cache_valid(space))
+            iter->u.hyp.seq_cache = space->select.sel_info.hslab->seq_cache;
+        else
+            iter->u.hyp.seq_cache = NULL;
+        iter->u.hyp.cache_seq = 0;
+        iter->u.hyp.cache_elmt = 0;
     } /* end if */
     else {
 /* Initialize the information needed for non-regular hyperslab I/O */
@@ -412,6 +453,9 @@ H5S_hyper_iter_init(H5S_sel_iter_t *iter, const H5S_t *space)
 
         /* Flag the diminfo information as not valid in the iterator */
         iter->u.hyp.diminfo_valid = FALSE;
+
+        /* Irregular selections are never compiled */
+        iter->u.hyp.seq_cache = NULL;
     } /* end else */
 
     /* Initialize type of selection iterator */
@@ -1659,6 +1703,9 @@ H5S_hyper_copy (H5S_t *dst, const H5S_t *src, hbool_t share_selection)
     dst_hslab->num_elem_non_unlim = src_hslab->num_elem_non_unlim;
     dst->select.sel_info.hslab->span_lst=src->select.sel_info.hslab->span_lst;
 
+    /* The compiled sequence list is not copied, the destination may be modified */
+    dst_hslab->seq_cache = NULL;
+
     /* Check if there is hyperslab span information to copy */
     /* (Regular hyperslab information is copied with the selection structure) */
     if(src->select.sel_info.hslab->span_lst!=NULL) {
@@ -3385,6 +3432,10 @@ H5S_hyper_release(H5S_t *space)
                 HGOTO_ERROR(H5E_INTERNAL, H5E_CANTFREE, FAIL, "failed to release hyperslab spans")
         } /* end if */
 
+        /* Release the compiled sequence list */
+        if(space->select.sel_info.hslab->seq_cache != NULL)
+            H5S_hyper_free_seq_cache(space->select.sel_info.hslab->seq_cache);
+
         /* Release space for the hyperslab selection information */
         space->select.sel_info.hslab = H5FL_FREE(H5S_hyper_sel_t, space->select.sel_info.hslab);
     } /* end if */
@@ -3752,6 +3803,7 @@ H5S_hyper_add_span_element(H5S_t *space, unsigned rank, hsize_t *coords)
         /* Allocate selection info */
         if(NULL == (space->select.sel_info.hslab = H5FL_MALLOC(H5S_hyper_sel_t)))
             HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "can't allocate hyperslab info")
+        space->select.sel_info.hslab->seq_cache = NULL;
 
         /* Set the selection to the new span tree */
         space->select.sel_info.hslab->span_lst = head;
@@ -4473,6 +4525,7 @@ H5S_hyper_project_simple(const H5S_t *base_space, H5S_t *new_space, hsize_t *off
     /* Allocate space for the hyperslab selection information */
     if(NULL == (new_space->select.sel_info.hslab = H5FL_MALLOC(H5S_hyper_sel_t)))
         HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "can't allocate hyperslab info")
+    new_space->select.sel_info.hslab->seq_cache = NULL;
 
     /* Set unlim_dim */
     new_space->select.sel_info.hslab->unlim_dim = -1;
@@ -4829,7 +4882,8 @@ done:
     Non-negative on success, negative on failure
  DESCRIPTION
     Create a new span node and append to a span list.  Update the previous
-    span in the list also.
+    span in the list also.  If SPAN_TREE is NULL, the span list is not
+    wanted by the caller and nothing is appended.
  GLOBAL VARIABLES
  COMMENTS, BUGS, ASSUMPTIONS
  EXAMPLES
@@ -4844,7 +4898,10 @@ H5S_hyper_append_span (H5S_hyper_span_t **prev_span, H5S_hyper_span_info_t ** sp
     FUNC_ENTER_NOAPI_NOINIT
 
     HDassert(prev_span);
-    HDassert(span_tree);
+
+    /* Check for a span list which isn't wanted */
+    if(span_tree == NULL)
+        HGOTO_DONE(SUCCEED)
 
     /* Check for adding first node to merged spans */
     if(*prev_span==NULL) {
@@ -4943,6 +5000,9 @@ done:
     'b' span tree, the area defined by the overlap of the 'a' hyperslab span
     tree and the 'b' span tree, and the area defined by the 'b' hyperslab span
     tree which does not overlap the 'a' span tree.
+
+    Any of the output span trees may be NULL, if the caller doesn't need
+    that area; those spans are then not copied.
  GLOBAL VARIABLES
  COMMENTS, BUGS, ASSUMPTIONS
  EXAMPLES
@@ -4970,38 +5030,38 @@ H5S_hyper_clip_spans (H5S_hyper_span_info_t *a_spans, H5S_hyper_span_info_t *b_s
     /* Check args */
     HDassert(a_spans);
     HDassert(b_spans);
-    HDassert(a_not_b);
-    HDassert(a_and_b);
-    HDassert(b_not_a);
 
-    /* Check if both span trees are not defined */
-    if(a_spans==NULL && b_spans==NULL) {
+    /* Reset the span trees to return */
+    if(a_not_b)
         *a_not_b=NULL;
+    if(a_and_b)
         *a_and_b=NULL;
+    if(b_not_a)
         *b_not_a=NULL;
+
+    /* Check if both span trees are not defined */
+    if(a_spans==NULL && b_spans==NULL) {
+        /* Nothing to do */
     } /* end if */
     /* If span 'a' is not defined, but 'b' is, copy 'b' and set the other return span trees to empty */
     else if(a_spans==NULL) {
-        *a_not_b=NULL;
-        *a_and_b=NULL;
-        if((*b_not_a=H5S_hyper_copy_span(b_spans))==NULL)
-            HGOTO_ERROR(H5E_INTERNAL, H5E_CANTCOPY, FAIL, "can't copy hyperslab span tree")
+        if(b_not_a)
+            if((*b_not_a=H5S_hyper_copy_span(b_spans))==NULL)
+                HGOTO_ERROR(H5E_INTERNAL, H5E_CANTCOPY, FAIL, "can't copy hyperslab span tree")
     } /* end if */
     /* If span 'b' is not defined, but 'a' is, copy 'a' and set the other return span trees to empty */
     else if(b_spans==NULL) {
-        if((*a_not_b=H5S_hyper_copy_span(a_spans))==NULL)
-            HGOTO_ERROR(H5E_INTERNAL, H5E_CANTCOPY, FAIL, "can't copy hyperslab span tree")
-        *a_and_b=NULL;
-        *b_not_a=NULL;
+        if(a_not_b)
+            if((*a_not_b=H5S_hyper_copy_span(a_spans))==NULL)
+                HGOTO_ERROR(H5E_INTERNAL, H5E_CANTCOPY, FAIL, "can't copy hyperslab span tree")
     } /* end if */
     /* If span 'a' and 'b' are both defined, calculate the proper span trees */
     else {
         /* Check if both span trees completely overlap */
         if(H5S_hyper_cmp_spans(a_spans,b_spans)==TRUE) {
-            *a_not_b=NULL;
-            if((*a_and_b=H5S_hyper_copy_span(a_spans))==NULL)
-                HGOTO_ERROR(H5E_INTERNAL, H5E_CANTCOPY, FAIL, "can't copy hyperslab span tree")
-            *b_not_a=NULL;
+            if(a_and_b)
+                if((*a_and_b=H5S_hyper_copy_span(a_spans))==NULL)
+                    HGOTO_ERROR(H5E_INTERNAL, H5E_CANTCOPY, FAIL, "can't copy hyperslab span tree")
         } /* end if */
         else {
             /* Get the pointers to the new and old span lists */
@@ -5063,7 +5123,7 @@ H5S_hyper_clip_spans (H5S_hyper_span_info_t *a_spans, H5S_hyper_span_info_t *b_s
                         down_b_not_a=NULL;
 
                         /* Check for overlaps in the 'down spans' of span 'a' & 'b' */
-                        if(H5S_hyper_clip_spans(span_a->down,span_b->down,&down_a_not_b,&down_a_and_b,&down_b_not_a)<0)
+                        if(H5S_hyper_clip_spans(span_a->down,span_b->down,(a_not_b ? &down_a_not_b : NULL),(a_and_b ? &down_a_and_b : NULL),(b_not_a ? &down_b_not_a : NULL))<0)
                             HGOTO_ERROR(H5E_DATASPACE, H5E_CANTCLIP, FAIL, "can't clip hyperslab information")
 
                         /* Check for additions to the a_not_b list */
@@ -5150,7 +5210,7 @@ H5S_hyper_clip_spans (H5S_hyper_span_info_t *a_spans, H5S_hyper_span_info_t *b_s
                         down_b_not_a=NULL;
 
                         /* Check for overlaps in the 'down spans' of span 'a' & 'b' */
-                        if(H5S_hyper_clip_spans(span_a->down,span_b->down,&down_a_not_b,&down_a_and_b,&down_b_not_a)<0)
+                        if(H5S_hyper_clip_spans(span_a->down,span_b->down,(a_not_b ? &down_a_not_b : NULL),(a_and_b ? &down_a_and_b : NULL),(b_not_a ? &down_b_not_a : NULL))<0)
                             HGOTO_ERROR(H5E_DATASPACE, H5E_CANTCLIP, FAIL, "can't clip hyperslab information")
 
                         /* Check for additions to the a_not_b list */
@@ -5233,7 +5293,7 @@ H5S_hyper_clip_spans (H5S_hyper_span_info_t *a_spans, H5S_hyper_span_info_t *b_s
                         down_b_not_a=NULL;
 
                         /* Check for overlaps in the 'down spans' of span 'a' & 'b' */
-                        if(H5S_hyper_clip_spans(span_a->down,span_b->down,&down_a_not_b,&down_a_and_b,&down_b_not_a)<0)
+                        if(H5S_hyper_clip_spans(span_a->down,span_b->down,(a_not_b ? &down_a_not_b : NULL),(a_and_b ? &down_a_and_b : NULL),(b_not_a ? &down_b_not_a : NULL))<0)
                             HGOTO_ERROR(H5E_DATASPACE, H5E_CANTCLIP, FAIL, "can't clip hyperslab information")
 
                         /* Check for additions to the a_not_b list */
@@ -5325,7 +5385,7 @@ H5S_hyper_clip_spans (H5S_hyper_span_info_t *a_spans, H5S_hyper_span_info_t *b_s
                         down_b_not_a=NULL;
 
                         /* Check for overlaps in the 'down spans' of span 'a' & 'b' */
-                        if(H5S_hyper_clip_spans(span_a->down,span_b->down,&down_a_not_b,&down_a_and_b,&down_b_not_a)<0)
+                        if(H5S_hyper_clip_spans(span_a->down,span_b->down,(a_not_b ? &down_a_not_b : NULL),(a_and_b ? &down_a_and_b : NULL),(b_not_a ? &down_b_not_a : NULL))<0)
                             HGOTO_ERROR(H5E_DATASPACE, H5E_CANTCLIP, FAIL, "can't clip hyperslab information")
 
                         /* Check for additions to the a_not_b list */
@@ -6270,9 +6330,6 @@ H5S_generate_hyperslab (H5S_t *space, H5S_seloper_t op,
 		      const hsize_t block[])
 {
     H5S_hyper_span_info_t *new_spans=NULL;  /* Span tree for new hyperslab */
-    H5S_hyper_span_info_t *a_not_b=NULL;    /* Span tree for hyperslab spans in old span tree and not in new span tree */
-    H5S_hyper_span_info_t *a_and_b=NULL;    /* Span tree for hyperslab spans in both old and new span trees */
-    H5S_hyper_span_info_t *b_not_a=NULL;    /* Span tree for hyperslab spans in new span tree and not in old span tree */
     herr_t      ret_value=SUCCEED;       /* Return value */
 
     FUNC_ENTER_NOAPI_NOINIT
@@ -6289,6 +6346,43 @@ H5S_generate_hyperslab (H5S_t *space, H5S_seloper_t op,
     if((new_spans=H5S_hyper_make_spans(space->extent.rank,start,stride,count,block))==NULL)
         HGOTO_ERROR(H5E_DATASPACE, H5E_CANTINSERT, FAIL, "can't create hyperslab information")
 
+    /* Combine the new spans with the current selection */
+    if(H5S_hyper_combine_spans(space, op, new_spans) < 0)
+        HGOTO_ERROR(H5E_DATASPACE, H5E_CANTINSERT, FAIL, "can't combine hyperslab information")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5S_generate_hyperslab() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5S_hyper_combine_spans
+ *
+ * Purpose:	Combine a span tree with the current hyperslab selection of
+ *              a dataspace, using a selection operation.  The span tree
+ *              is owned by this routine and is either attached to the
+ *              selection or released.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5S_hyper_combine_spans(H5S_t *space, H5S_seloper_t op,
+    H5S_hyper_span_info_t *new_spans)
+{
+    H5S_hyper_span_info_t *a_not_b=NULL;    /* Span tree for hyperslab spans in old span tree and not in new span tree */
+    H5S_hyper_span_info_t *a_and_b=NULL;    /* Span tree for hyperslab spans in both old and new span trees */
+    H5S_hyper_span_info_t *b_not_a=NULL;    /* Span tree for hyperslab spans in new span tree and not in old span tree */
+    herr_t      ret_value=SUCCEED;       /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    /* Check args */
+    HDassert(space);
+    HDassert(op > H5S_SELECT_NOOP && op < H5S_SELECT_INVALID);
+    HDassert(new_spans);
+
     /* Generate list of blocks to add/remove based on selection operation */
     if(op==H5S_SELECT_SET) {
         /* Add new spans to current selection */
@@ -6304,8 +6398,14 @@ H5S_generate_hyperslab (H5S_t *space, H5S_seloper_t op,
     else {
         hbool_t updated_spans = FALSE;  /* Whether the spans in the selection were modified */
 
-        /* Generate lists of spans which overlap and don't overlap */
-        if(H5S_hyper_clip_spans(space->select.sel_info.hslab->span_lst,new_spans,&a_not_b,&a_and_b,&b_not_a)<0)
+        /* Generate lists of spans which overlap and don't overlap, skipping
+         * the lists which the operation doesn't use (so an "or" doesn't copy
+         * the whole current selection into 'a_not_b')
+         */
+        if(H5S_hyper_clip_spans(space->select.sel_info.hslab->span_lst, new_spans,
+                ((op == H5S_SELECT_XOR || op == H5S_SELECT_NOTB) ? &a_not_b : NULL),
+                (op == H5S_SELECT_AND ? &a_and_b : NULL),
+                ((op == H5S_SELECT_OR || op == H5S_SELECT_XOR || op == H5S_SELECT_NOTA) ? &b_not_a : NULL)) < 0)
             HGOTO_ERROR(H5E_DATASPACE, H5E_CANTCLIP, FAIL, "can't clip hyperslab information")
 
         switch(op) {
@@ -6490,7 +6590,7 @@ done:
             HDONE_ERROR(H5E_INTERNAL, H5E_CANTFREE, FAIL, "failed to release temporary hyperslab spans")
 
     FUNC_LEAVE_NOAPI(ret_value)
-} /* end H5S_generate_hyperslab() */
+} /* end H5S_hyper_combine_spans() */
 
 
 /*-------------------------------------------------------------------------
@@ -6748,6 +6848,7 @@ H5S_select_hyperslab (H5S_t *space, H5S_seloper_t op,
         /* Allocate space for the hyperslab selection information */
         if(NULL == (space->select.sel_info.hslab = H5FL_MALLOC(H5S_hyper_sel_t)))
             HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "can't allocate hyperslab info")
+        space->select.sel_info.hslab->seq_cache = NULL;
 
         /* Save the diminfo */
         space->select.num_elem = 1;
@@ -6908,6 +7009,496 @@ H5Sselect_hyperslab(hid_t space_id, H5S_seloper_t op, const hsize_t start[],
 done:
     FUNC_LEAVE_API(ret_value)
 } /* end H5Sselect_hyperslab() */
+
+/*--------------------------------------------------------------------------
+ NAME
+    H5S_hyper_cmp_block_ent
+ PURPOSE
+    Compare two block bounds, for sorting blocks by their low bound
+ USAGE
+    int H5S_hyper_cmp_block_ent(_ent1, _ent2)
+        const void *_ent1;      IN: Pointer to first block bound
+        const void *_ent2;      IN: Pointer to second block bound
+ RETURNS
+    <0, 0 or >0, as for qsort()
+ DESCRIPTION
+    Ties are broken by the block's index, so the sort is deterministic.
+ GLOBAL VARIABLES
+ COMMENTS, BUGS, ASSUMPTIONS
+ EXAMPLES
+ REVISION LOG
+--------------------------------------------------------------------------*/
+static int
+H5S_hyper_cmp_block_ent(const void *_ent1, const void *_ent2)
+{
+    const H5S_hyper_block_ent_t *ent1 = (const H5S_hyper_block_ent_t *)_ent1;
+    const H5S_hyper_block_ent_t *ent2 = (const H5S_hyper_block_ent_t *)_ent2;
+    int ret_value = 0;
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    if(ent1->low < ent2->low)
+        ret_value = -1;
+    else if(ent1->low > ent2->low)
+        ret_value = 1;
+    else if(ent1->idx < ent2->idx)
+        ret_value = -1;
+    else if(ent1->idx > ent2->idx)
+        ret_value = 1;
+
+    FUNC_LEAVE_NOAPI(ret_value)
+}   /* H5S_hyper_cmp_block_ent() */
+
+
+/*--------------------------------------------------------------------------
+ NAME
+    H5S_hyper_cmp_block_bound
+ PURPOSE
+    Compare two span boundaries, for qsort()
+ USAGE
+    int H5S_hyper_cmp_block_bound(_bound1, _bound2)
+        const void *_bound1;    IN: Pointer to first boundary
+        const void *_bound2;    IN: Pointer to second boundary
+ RETURNS
+    <0, 0 or >0, as for qsort()
+ DESCRIPTION
+ GLOBAL VARIABLES
+ COMMENTS, BUGS, ASSUMPTIONS
+ EXAMPLES
+ REVISION LOG
+--------------------------------------------------------------------------*/
+static int
+H5S_hyper_cmp_block_bound(const void *_bound1, const void *_bound2)
+{
+    hsize_t bound1 = *(const hsize_t *)_bound1;
+    hsize_t bound2 = *(const hsize_t *)_bound2;
+    int ret_value = 0;
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    if(bound1 < bound2)
+        ret_value = -1;
+    else if(bound1 > bound2)
+        ret_value = 1;
+
+    FUNC_LEAVE_NOAPI(ret_value)
+}   /* H5S_hyper_cmp_block_bound() */
+
+
+/*--------------------------------------------------------------------------
+ NAME
+    H5S_hyper_make_spans_blocks
+ PURPOSE
+    Create a span tree for the union of a list of blocks
+ USAGE
+    H5S_hyper_span_info_t *H5S_hyper_make_spans_blocks(info, dim, blocks, nblocks)
+        H5S_hyper_block_info_t *info;   IN: Block list & per-dimension scratch space
+        unsigned dim;                   IN: Dimension to build spans for
+        const size_t *blocks;           IN: Indices of blocks to build spans from
+        size_t nblocks;                 IN: Number of blocks
+ RETURNS
+    Pointer to new span tree on success, NULL on failure
+ DESCRIPTION
+    Sweeps the blocks in dimension DIM in order of their bounds.  The
+    boundaries of all the blocks split the dimension into spans which are
+    each covered by a fixed set of blocks.  The span tree for the next
+    dimension down is built from the blocks covering each span, and
+    adjacent spans with equal down trees are merged as they are appended.
+
+    Each block is sorted once per span it covers, so a list of mostly
+    disjoint blocks is built in O(n log n) time, instead of combining the
+    blocks into the selection one at a time.
+ GLOBAL VARIABLES
+ COMMENTS, BUGS, ASSUMPTIONS
+    The scratch arrays in INFO for dimension DIM and below must hold
+    NBLOCKS entries (2 * NBLOCKS for the boundaries).
+ EXAMPLES
+ REVISION LOG
+--------------------------------------------------------------------------*/
+static H5S_hyper_span_info_t *
+H5S_hyper_make_spans_blocks(H5S_hyper_block_info_t *info, unsigned dim,
+    const size_t *blocks, size_t nblocks)
+{
+    H5S_hyper_block_ent_t *ent = info->ent[dim];    /* Blocks sorted by low bound */
+    hsize_t *bound = info->bound[dim];      /* Sorted span boundaries */
+    size_t *active = info->active[dim];     /* Blocks covering the current span */
+    H5S_hyper_span_info_t *spans = NULL;    /* Span tree for this dimension */
+    H5S_hyper_span_info_t *down = NULL;     /* Span tree for the next dimension down */
+    H5S_hyper_span_t *last_span = NULL;     /* Last span appended */
+    size_t nbound;                  /* Number of distinct boundaries */
+    size_t nactive = 0;             /* Number of blocks covering the current span */
+    size_t next_ent = 0;            /* Next block to become active */
+    size_t u, v, w;                 /* Local index variables */
+    H5S_hyper_span_info_t *ret_value = NULL;    /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    /* Check args */
+    HDassert(info);
+    HDassert(dim < info->rank);
+    HDassert(blocks);
+    HDassert(nblocks > 0);
+
+    /* Gather the bounds of the blocks in this dimension */
+    for(u = 0; u < nblocks; u++) {
+        size_t off = (blocks[u] * info->rank) + dim;
+
+        ent[u].low = info->start[off];
+        ent[u].idx = blocks[u];
+        bound[2 * u] = info->start[off];
+        bound[(2 * u) + 1] = info->start[off] + info->block[off];
+    } /* end for */
+    HDqsort(ent, nblocks, sizeof(H5S_hyper_block_ent_t), H5S_hyper_cmp_block_ent);
+    HDqsort(bound, 2 * nblocks, sizeof(hsize_t), H5S_hyper_cmp_block_bound);
+
+    /* Remove duplicate boundaries */
+    for(u = 1, nbound = 1; u < (2 * nblocks); u++)
+        if(bound[u] != bound[nbound - 1])
+            bound[nbound++] = bound[u];
+
+    /* Sweep the spans between boundaries */
+    for(u = 0; (u + 1) < nbound; u++) {
+        /* Drop the blocks which end before this span */
+        for(v = 0, w = 0; v < nactive; v++) {
+            size_t off = (active[v] * info->rank) + dim;
+
+            if((info->start[off] + info->block[off]) > bound[u])
+                active[w++] = active[v];
+        } /* end for */
+        nactive = w;
+
+        /* Add the blocks which start at this span */
+        while(next_ent < nblocks && ent[next_ent].low == bound[u])
+            active[nactive++] = ent[next_ent++].idx;
+
+        /* Skip gaps between blocks */
+        if(nactive == 0)
+            continue;
+
+        /* Build the spans in the next dimension down */
+        if((dim + 1) < info->rank)
+            if(NULL == (down = H5S_hyper_make_spans_blocks(info, dim + 1, active, nactive)))
+                HGOTO_ERROR(H5E_DATASPACE, H5E_CANTINSERT, NULL, "can't create hyperslab spans")
+
+        /* Merge/add the span to the span tree */
+        if(H5S_hyper_append_span(&last_span, &spans, bound[u], bound[u + 1] - 1, down, NULL) < 0)
+            HGOTO_ERROR(H5E_RESOURCE, H5E_CANTAPPEND, NULL, "can't allocate hyperslab span")
+
+        /* Release the down spans, the span tree holds its own reference */
+        if(down) {
+            if(H5S_hyper_free_span_info(down) < 0)
+                HGOTO_ERROR(H5E_INTERNAL, H5E_CANTFREE, NULL, "failed to release hyperslab spans")
+            down = NULL;
+        } /* end if */
+    } /* end for */
+
+    /* Set return value */
+    ret_value = spans;
+
+done:
+    if(ret_value == NULL) {
+        if(down)
+            if(H5S_hyper_free_span_info(down) < 0)
+                HDONE_ERROR(H5E_INTERNAL, H5E_CANTFREE, NULL, "failed to release hyperslab spans")
+        if(spans)
+            if(H5S_hyper_free_span_info(spans) < 0)
+                HDONE_ERROR(H5E_INTERNAL, H5E_CANTFREE, NULL, "failed to release hyperslab spans")
+    } /* end if */
+
+    FUNC_LEAVE_NOAPI(ret_value)
+}   /* H5S_hyper_make_spans_blocks() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5S_select_blocks
+ *
+ * Purpose:	Internal version of H5Sselect_blocks().
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5S_select_blocks(H5S_t *space, H5S_seloper_t op, size_t num_blocks,
+    const hsize_t *start, const hsize_t *block)
+{
+    H5S_hyper_block_info_t info;    /* Information for building span tree */
+    H5S_hyper_span_info_t *new_spans = NULL;    /* Span tree for new blocks */
+    size_t *blocks = NULL;          /* Indices of non-empty blocks */
+    size_t nblocks = 0;             /* Number of non-empty blocks */
+    unsigned rank;                  /* Rank of dataspace */
+    unsigned u;                     /* Local index variable */
+    size_t v;                       /* Local index variable */
+    herr_t ret_value = SUCCEED;     /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    /* Check args */
+    HDassert(space);
+    HDassert(num_blocks > 0);
+    HDassert(start);
+    HDassert(block);
+    HDassert(op > H5S_SELECT_NOOP && op < H5S_SELECT_INVALID);
+
+    rank = space->extent.rank;
+    HDmemset(&info, 0, sizeof(info));
+
+    /* Collect the non-empty blocks */
+    if(NULL == (blocks = (size_t *)H5MM_malloc(sizeof(size_t) * num_blocks)))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "can't allocate block list")
+    for(v = 0; v < num_blocks; v++) {
+        for(u = 0; u < rank; u++)
+            if(block[(v * rank) + u] == 0)
+                break;
+        if(u == rank)
+            blocks[nblocks++] = v;
+    } /* end for */
+
+    /* Treat a list of empty blocks as a zero-sized hyperslab */
+    if(nblocks == 0) {
+        switch(op) {
+            case H5S_SELECT_SET:   /* Select "set" operation */
+            case H5S_SELECT_AND:   /* Binary "and" operation for hyperslabs */
+            case H5S_SELECT_NOTA:  /* Binary "B not A" operation for hyperslabs */
+                /* Convert to "none" selection */
+                if(H5S_select_none(space) < 0)
+                    HGOTO_ERROR(H5E_DATASPACE, H5E_CANTDELETE, FAIL, "can't convert selection")
+                HGOTO_DONE(SUCCEED);
+
+            case H5S_SELECT_OR:    /* Binary "or" operation for hyperslabs */
+            case H5S_SELECT_XOR:   /* Binary "xor" operation for hyperslabs */
+            case H5S_SELECT_NOTB:  /* Binary "A not B" operation for hyperslabs */
+                HGOTO_DONE(SUCCEED);        /* Selection stays same */
+
+            case H5S_SELECT_NOOP:
+            case H5S_SELECT_APPEND:
+            case H5S_SELECT_PREPEND:
+            case H5S_SELECT_INVALID:
+            default:
+                HGOTO_ERROR(H5E_ARGS, H5E_UNSUPPORTED, FAIL, "invalid selection operation")
+        } /* end switch */
+    } /* end if */
+
+    /* Check for operating on unlimited selection */
+    if((H5S_GET_SELECT_TYPE(space) == H5S_SEL_HYPERSLABS)
+            && (space->select.sel_info.hslab->unlim_dim >= 0)
+            && (op != H5S_SELECT_SET))
+        HGOTO_ERROR(H5E_DATASPACE, H5E_UNSUPPORTED, FAIL, "unsupported operation on unlimited selection")
+
+    /* Fixup operation for non-hyperslab selections */
+    switch(H5S_GET_SELECT_TYPE(space)) {
+        case H5S_SEL_NONE:   /* No elements selected in dataspace */
+            switch(op) {
+                case H5S_SELECT_SET:   /* Select "set" operation */
+                    break;
+
+                case H5S_SELECT_OR:    /* Binary "or" operation for hyperslabs */
+                case H5S_SELECT_XOR:   /* Binary "xor" operation for hyperslabs */
+                case H5S_SELECT_NOTA:  /* Binary "B not A" operation for hyperslabs */
+                    op = H5S_SELECT_SET; /* Maps to "set" operation when applied to "none" selection */
+                    break;
+
+                case H5S_SELECT_AND:   /* Binary "and" operation for hyperslabs */
+                case H5S_SELECT_NOTB:  /* Binary "A not B" operation for hyperslabs */
+                    HGOTO_DONE(SUCCEED);        /* Selection stays "none" */
+
+                case H5S_SELECT_NOOP:
+                case H5S_SELECT_APPEND:
+                case H5S_SELECT_PREPEND:
+                case H5S_SELECT_INVALID:
+                default:
+                    HGOTO_ERROR(H5E_ARGS, H5E_UNSUPPORTED, FAIL, "invalid selection operation")
+            } /* end switch */
+            break;
+
+        case H5S_SEL_ALL:    /* All elements selected in dataspace */
+            switch(op) {
+                case H5S_SELECT_SET:   /* Select "set" operation */
+                    break;
+
+                case H5S_SELECT_OR:    /* Binary "or" operation for hyperslabs */
+                    HGOTO_DONE(SUCCEED);        /* Selection stays "all" */
+
+                case H5S_SELECT_AND:   /* Binary "and" operation for hyperslabs */
+                    op = H5S_SELECT_SET; /* Maps to "set" operation when applied to "all" selection */
+                    break;
+
+                case H5S_SELECT_XOR:   /* Binary "xor" operation for hyperslabs */
+                case H5S_SELECT_NOTB:  /* Binary "A not B" operation for hyperslabs */
+                    /* Convert current "all" selection to "real" hyperslab selection */
+                    /* Then allow operation to proceed */
+                    {
+                        hsize_t tmp_start[H5O_LAYOUT_NDIMS];   /* Temporary start information */
+
+                        HDmemset(tmp_start, 0, sizeof(tmp_start));
+                        if(H5S_select_hyperslab(space, H5S_SELECT_SET, tmp_start, NULL, _ones, space->extent.size) < 0)
+                            HGOTO_ERROR(H5E_DATASPACE, H5E_CANTDELETE, FAIL, "can't convert selection")
+                    } /* end case */
+                    break;
+
+                case H5S_SELECT_NOTA:  /* Binary "B not A" operation for hyperslabs */
+                    /* Convert to "none" selection */
+                    if(H5S_select_none(space) < 0)
+                        HGOTO_ERROR(H5E_DATASPACE, H5E_CANTDELETE, FAIL, "can't convert selection")
+                    HGOTO_DONE(SUCCEED);
+
+                case H5S_SELECT_NOOP:
+                case H5S_SELECT_APPEND:
+                case H5S_SELECT_PREPEND:
+                case H5S_SELECT_INVALID:
+                default:
+                    HGOTO_ERROR(H5E_ARGS, H5E_UNSUPPORTED, FAIL, "invalid selection operation")
+            } /* end switch */
+            break;
+
+        case H5S_SEL_HYPERSLABS:
+            /* Hyperslab operation on hyperslab selection, OK */
+            break;
+
+        case H5S_SEL_POINTS: /* Can't combine hyperslab operations and point selections currently */
+            if(op == H5S_SELECT_SET)    /* Allow only "set" operation to proceed */
+                break;
+            /* Else fall through to error */
+
+        case H5S_SEL_ERROR:
+        case H5S_SEL_N:
+        default:
+            HGOTO_ERROR(H5E_ARGS, H5E_UNSUPPORTED, FAIL, "invalid selection operation")
+    } /* end switch */
+
+    /* Allocate the scratch space for building the span tree */
+    info.rank = rank;
+    info.start = start;
+    info.block = block;
+    for(u = 0; u < rank; u++) {
+        if(NULL == (info.ent[u] = (H5S_hyper_block_ent_t *)H5MM_malloc(sizeof(H5S_hyper_block_ent_t) * nblocks)))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "can't allocate block bounds")
+        if(NULL == (info.bound[u] = (hsize_t *)H5MM_malloc(sizeof(hsize_t) * 2 * nblocks)))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "can't allocate span boundaries")
+        if(NULL == (info.active[u] = (size_t *)H5MM_malloc(sizeof(size_t) * nblocks)))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "can't allocate active block list")
+    } /* end for */
+
+    /* Build the span tree for the union of the blocks */
+    if(NULL == (new_spans = H5S_hyper_make_spans_blocks(&info, 0, blocks, nblocks)))
+        HGOTO_ERROR(H5E_DATASPACE, H5E_CANTINSERT, FAIL, "can't create hyperslab information")
+
+    if(op == H5S_SELECT_SET) {
+        /* If we are setting a new selection, remove current selection first */
+        if(H5S_SELECT_RELEASE(space) < 0)
+            HGOTO_ERROR(H5E_DATASPACE, H5E_CANTDELETE, FAIL, "can't release selection")
+
+        /* Allocate space for the hyperslab selection information */
+        if(NULL == (space->select.sel_info.hslab = H5FL_MALLOC(H5S_hyper_sel_t)))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "can't allocate hyperslab info")
+        space->select.sel_info.hslab->seq_cache = NULL;
+        space->select.sel_info.hslab->unlim_dim = -1;
+        space->select.sel_info.hslab->diminfo_valid = FALSE;
+
+        /* Use the new span tree as the selection */
+        space->select.sel_info.hslab->span_lst = new_spans;
+        space->select.num_elem = H5S_hyper_spans_nelem(new_spans);
+        new_spans = NULL;
+
+        /* Attempt to rebuild "optimized" start/stride/count/block information */
+        if(H5S_hyper_rebuild(space) < 0)
+            HGOTO_ERROR(H5E_DATASPACE, H5E_CANTCOUNT, FAIL, "can't rebuild hyperslab info")
+    } /* end if */
+    else {
+        H5S_hyper_span_info_t *tmp_spans = new_spans;  /* Span tree handed off */
+
+        /* Sanity check */
+        HDassert(H5S_GET_SELECT_TYPE(space) == H5S_SEL_HYPERSLABS);
+
+        /* Check if there's no hyperslab span information currently */
+        if(NULL == space->select.sel_info.hslab->span_lst)
+            if(H5S_hyper_generate_spans(space) < 0)
+                HGOTO_ERROR(H5E_DATASPACE, H5E_UNINITIALIZED, FAIL, "dataspace does not have span tree")
+
+        /* Indicate that the regular dimensions are no longer valid */
+        space->select.sel_info.hslab->diminfo_valid = FALSE;
+
+        /* Combine the new spans with the selection, in one pass */
+        new_spans = NULL;
+        if(H5S_hyper_combine_spans(space, op, tmp_spans) < 0)
+            HGOTO_ERROR(H5E_DATASPACE, H5E_CANTINSERT, FAIL, "can't combine hyperslab information")
+    } /* end else */
+
+    /* Set selection type */
+    space->select.type = H5S_sel_hyper;
+
+done:
+    if(new_spans)
+        if(H5S_hyper_free_span_info(new_spans) < 0)
+            HDONE_ERROR(H5E_INTERNAL, H5E_CANTFREE, FAIL, "failed to release hyperslab spans")
+    for(u = 0; u < H5S_MAX_RANK; u++) {
+        info.ent[u] = (H5S_hyper_block_ent_t *)H5MM_xfree(info.ent[u]);
+        info.bound[u] = (hsize_t *)H5MM_xfree(info.bound[u]);
+        info.active[u] = (size_t *)H5MM_xfree(info.active[u]);
+    } /* end for */
+    blocks = (size_t *)H5MM_xfree(blocks);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+}   /* end H5S_select_blocks() */
+
+
+/*--------------------------------------------------------------------------
+ NAME
+    H5Sselect_blocks
+ PURPOSE
+    Specify a list of blocks to combine with the current selection
+ USAGE
+    herr_t H5Sselect_blocks(dsid, op, num_blocks, start, block)
+        hid_t dsid;             IN: Dataspace ID of selection to modify
+        H5S_seloper_t op;       IN: Operation to perform on current selection
+        size_t num_blocks;      IN: Number of blocks in START & BLOCK arrays
+        const hsize_t *start;   IN: Offset of start of each block
+        const hsize_t *block;   IN: Size of each block
+ RETURNS
+    Non-negative on success/Negative on failure
+ DESCRIPTION
+    Combines the union of a list of blocks with the current selection for a
+    dataspace, as a hyperslab selection.  The START and BLOCK arrays are
+    2-D arrays of size <dataspace rank> by NUM_BLOCKS.  The blocks may be
+    given in any order and may overlap; blocks with a zero size are ignored.
+
+    This is equivalent to selecting each block with H5Sselect_hyperslab()
+    and the H5S_SELECT_OR operation, then combining the result with the
+    current selection using OP, but the blocks are sorted and merged into
+    a span tree in one pass instead of one block at a time.
+ GLOBAL VARIABLES
+ COMMENTS, BUGS, ASSUMPTIONS
+ EXAMPLES
+ REVISION LOG
+--------------------------------------------------------------------------*/
+herr_t
+H5Sselect_blocks(hid_t space_id, H5S_seloper_t op, size_t num_blocks,
+    const hsize_t *start, const hsize_t *block)
+{
+    H5S_t *space;               /* Dataspace to modify selection of */
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE5("e", "iSsz*h*h", space_id, op, num_blocks, start, block);
+
+    /* Check args */
+    if(NULL == (space = (H5S_t *)H5I_object_verify(space_id, H5I_DATASPACE)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a data space")
+    if(H5S_SCALAR == H5S_GET_EXTENT_TYPE(space))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "hyperslab doesn't support H5S_SCALAR space")
+    if(H5S_NULL == H5S_GET_EXTENT_TYPE(space))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "hyperslab doesn't support H5S_NULL space")
+    if(start == NULL || block == NULL || num_blocks == 0)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "blocks not specified")
+    if(!(op > H5S_SELECT_NOOP && op < H5S_SELECT_INVALID))
+        HGOTO_ERROR(H5E_ARGS, H5E_UNSUPPORTED, FAIL, "invalid selection operation")
+
+    if(H5S_select_blocks(space, op, num_blocks, start, block) < 0)
+        HGOTO_ERROR(H5E_DATASPACE, H5E_CANTINIT, FAIL, "unable to set block selection")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Sselect_blocks() */
 #else /* NEW_HYPERSLAB_API */ /* Works */
 
 /*-------------------------------------------------------------------------
@@ -7169,6 +7760,7 @@ H5S_generate_hyperslab (H5S_t *space, H5S_seloper_t op,
         /* Allocate space for the hyperslab selection information */
         if((space->select.sel_info.hslab=H5FL_MALLOC(H5S_hyper_sel_t))==NULL)
             HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "can't allocate hyperslab info")
+        space->select.sel_info.hslab->seq_cache = NULL;
 
         /* Set unlim_dim */
         space->select.sel_info.hslab->unlim_dim = -1;
@@ -7435,6 +8027,7 @@ H5S_select_hyperslab (H5S_t *space, H5S_seloper_t op,
         /* Allocate space for the hyperslab selection information */
         if(NULL == (space->select.sel_info.hslab = H5FL_MALLOC(H5S_hyper_sel_t)))
             HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "can't allocate hyperslab info")
+        space->select.sel_info.hslab->seq_cache = NULL;
 
         /* Save the diminfo */
         space->select.num_elem=1;
@@ -9072,6 +9665,169 @@ H5S_hyper_get_seq_list_single(const H5S_t *space, H5S_sel_iter_t *iter,
 } /* end H5S_hyper_get_seq_list_single() */
 
 
+/*--------------------------------------------------------------------------
+ NAME
+    H5S_hyper_seq_cache_valid
+ PURPOSE
+    Check if a hyperslab selection's compiled sequence list is up to date
+ USAGE
+    hbool_t H5S_hyper_seq_cache_valid(space)
+        const H5S_t *space;     IN: Dataspace to query
+ RETURNS
+    TRUE if the selection has a compiled sequence list which was generated
+        from the current selection, extent and offset, FALSE otherwise.
+ DESCRIPTION
+    Compares the regular selection information, dataspace extent and
+    selection offset recorded when the sequence list was compiled against
+    the dataspace's current values.  This is cheap, so the sequence list
+    doesn't need to be invalidated by every routine which changes the
+    selection.
+ GLOBAL VARIABLES
+ COMMENTS, BUGS, ASSUMPTIONS
+ EXAMPLES
+ REVISION LOG
+--------------------------------------------------------------------------*/
+static hbool_t
+H5S_hyper_seq_cache_valid(const H5S_t *space)
+{
+    const H5S_hyper_sel_t *hslab = space->select.sel_info.hslab;  /* Hyperslab selection info */
+    const H5S_hyper_seq_cache_t *cache = hslab->seq_cache;      /* Compiled sequence list */
+    unsigned u;                 /* Local index variable */
+    hbool_t ret_value = TRUE;   /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    if(NULL == cache || !hslab->diminfo_valid || hslab->unlim_dim >= 0
+            || cache->rank != space->extent.rank)
+        ret_value = FALSE;
+    else
+        for(u = 0; u < cache->rank; u++)
+            if(cache->dims[u] != space->extent.size[u]
+                    || cache->offset[u] != space->select.offset[u]
+                    || cache->diminfo[u].start != hslab->opt_diminfo[u].start
+                    || cache->diminfo[u].stride != hslab->opt_diminfo[u].stride
+                    || cache->diminfo[u].count != hslab->opt_diminfo[u].count
+                    || cache->diminfo[u].block != hslab->opt_diminfo[u].block) {
+                ret_value = FALSE;
+                break;
+            } /* end if */
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5S_hyper_seq_cache_valid() */
+
+
+/*--------------------------------------------------------------------------
+ NAME
+    H5S_hyper_free_seq_cache
+ PURPOSE
+    Release a compiled sequence list
+ USAGE
+    void H5S_hyper_free_seq_cache(cache)
+        H5S_hyper_seq_cache_t *cache;   IN: Sequence list to free
+ RETURNS
+    None
+ DESCRIPTION
+    Releases the offset & length arrays and the sequence list itself.
+ GLOBAL VARIABLES
+ COMMENTS, BUGS, ASSUMPTIONS
+ EXAMPLES
+ REVISION LOG
+--------------------------------------------------------------------------*/
+static void
+H5S_hyper_free_seq_cache(H5S_hyper_seq_cache_t *cache)
+{
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    HDassert(cache);
+
+    H5MM_xfree(cache->off);
+    H5MM_xfree(cache->len);
+    cache = H5FL_FREE(H5S_hyper_seq_cache_t, cache);
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5S_hyper_free_seq_cache() */
+
+
+/*--------------------------------------------------------------------------
+ NAME
+    H5S_hyper_get_seq_list_cached
+ PURPOSE
+    Create a list of offsets & lengths for a selection, from the
+    selection's compiled sequence list
+ USAGE
+    herr_t H5S_hyper_get_seq_list_cached(iter,maxseq,maxelem,nseq,nelem,off,len)
+        H5S_sel_iter_t *iter;   IN/OUT: Selection iterator describing last
+                                    position of interest in selection.
+        size_t maxseq;          IN: Maximum number of sequences to generate
+        size_t maxelem;         IN: Maximum number of elements to include in the
+                                    generated sequences
+        size_t *nseq;           OUT: Actual number of sequences generated
+        size_t *nelem;          OUT: Actual number of elements in sequences generated
+        hsize_t *off;           OUT: Array of offsets
+        size_t *len;            OUT: Array of lengths
+ RETURNS
+    Non-negative on success/Negative on failure.
+ DESCRIPTION
+    Copies sequences out of the compiled list, scaling them by the
+    iterator's element size and splitting the last one if MAXELEM is
+    reached in the middle of it.  Only the compiled list position in the
+    iterator is updated, so iterators used this way must only be used to
+    generate sequences.
+ GLOBAL VARIABLES
+ COMMENTS, BUGS, ASSUMPTIONS
+ EXAMPLES
+ REVISION LOG
+--------------------------------------------------------------------------*/
+static herr_t
+H5S_hyper_get_seq_list_cached(H5S_sel_iter_t *iter, size_t maxseq,
+    size_t maxelem, size_t *nseq, size_t *nelem, hsize_t *off, size_t *len)
+{
+    const H5S_hyper_seq_cache_t *cache = iter->u.hyp.seq_cache;    /* Compiled sequence list */
+    size_t elmt_size = iter->elmt_size;     /* Size of each element */
+    size_t cache_seq = iter->u.hyp.cache_seq;   /* Current sequence in list */
+    size_t cache_elmt = iter->u.hyp.cache_elmt; /* Elements used from current sequence */
+    size_t curr_seq = 0;        /* Number of sequences generated */
+    size_t tot_elem = 0;        /* Number of elements in sequences generated */
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    HDassert(cache);
+
+    /* Don't generate more elements than are left in the selection */
+    if((hsize_t)maxelem > iter->elmt_left)
+        maxelem = (size_t)iter->elmt_left;
+
+    while(curr_seq < maxseq && tot_elem < maxelem && cache_seq < cache->nseq) {
+        size_t avail = cache->len[cache_seq] - cache_elmt;      /* Elements left in sequence */
+        size_t nelmts = MIN(avail, maxelem - tot_elem);         /* Elements to use */
+
+        off[curr_seq] = (cache->off[cache_seq] + cache_elmt) * elmt_size;
+        len[curr_seq] = nelmts * elmt_size;
+        curr_seq++;
+        tot_elem += nelmts;
+
+        /* Advance to the next sequence, or remember how far we got */
+        if(nelmts == avail) {
+            cache_seq++;
+            cache_elmt = 0;
+        } /* end if */
+        else
+            cache_elmt += nelmts;
+    } /* end while */
+
+    /* Update the iterator */
+    iter->u.hyp.cache_seq = cache_seq;
+    iter->u.hyp.cache_elmt = cache_elmt;
+    iter->elmt_left -= tot_elem;
+
+    /* Set the number of sequences & elements generated */
+    *nseq = curr_seq;
+    *nelem = tot_elem;
+
+    FUNC_LEAVE_NOAPI(SUCCEED)
+} /* end H5S_hyper_get_seq_list_cached() */
+
+
 /*--------------------------------------------------------------------------
  NAME
     H5S_hyper_get_seq_list
@@ -9124,8 +9880,11 @@ H5S_hyper_get_seq_list(const H5S_t *space, unsigned H5_ATTR_UNUSED flags, H5S_se
     HDassert(len);
     HDassert(space->select.sel_info.hslab->unlim_dim < 0);
 
+    /* Check for a compiled sequence list */
+    if(iter->u.hyp.seq_cache)
+        ret_value = H5S_hyper_get_seq_list_cached(iter, maxseq, maxelem, nseq, nelem, off, len);
     /* Check for the special case of just one H5Sselect_hyperslab call made */
-    if(space->select.sel_info.hslab->diminfo_valid) {
+    else if(space->select.sel_info.hslab->diminfo_valid) {
         const H5S_hyper_dim_t *tdiminfo;    /* Temporary pointer to diminfo information */
         const hssize_t *sel_off;    /* Selection offset in dataspace */
         hsize_t *mem_size;      /* Size of the source buffer */
@@ -9249,6 +10008,121 @@ H5S_hyper_get_seq_list(const H5S_t *space, unsigned H5_ATTR_UNUSED flags, H5S_se
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5S_hyper_get_seq_list() */
 
+
+/*--------------------------------------------------------------------------
+ NAME
+    H5S__hyper_compile
+ PURPOSE
+    Compile a regular hyperslab selection into a sequence list
+ USAGE
+    herr_t H5S__hyper_compile(space)
+        H5S_t *space;           IN/OUT: Dataspace to compile selection of
+ RETURNS
+    Non-negative on success/Negative on failure.
+ DESCRIPTION
+    Generates the complete list of offset/length sequences for the
+    selection, in units of elements, and attaches it to the selection.
+    Later selection iterators over the dataspace, for any element size,
+    copy their sequences out of this list instead of walking the selection
+    again, as long as the selection, extent and offset are unchanged.
+    Selections which aren't regular hyperslabs are left as they are.
+ GLOBAL VARIABLES
+ COMMENTS, BUGS, ASSUMPTIONS
+ EXAMPLES
+ REVISION LOG
+--------------------------------------------------------------------------*/
+herr_t
+H5S__hyper_compile(H5S_t *space)
+{
+    H5S_hyper_sel_t *hslab;             /* Hyperslab selection info */
+    H5S_hyper_seq_cache_t *cache = NULL;    /* New sequence list */
+    H5S_sel_iter_t iter;                /* Selection iterator */
+    hbool_t iter_init = FALSE;          /* Selection iteration info has been initialized */
+    size_t nalloc = 0;                  /* Number of sequences allocated */
+    size_t u, v;                        /* Local index variables */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    /* Check args */
+    HDassert(space && H5S_SEL_HYPERSLABS == H5S_GET_SELECT_TYPE(space));
+    hslab = space->select.sel_info.hslab;
+
+    /* Check if the current sequence list is still valid */
+    if(H5S_hyper_seq_cache_valid(space))
+        HGOTO_DONE(SUCCEED)
+
+    /* Release the out of date sequence list */
+    if(hslab->seq_cache) {
+        H5S_hyper_free_seq_cache(hslab->seq_cache);
+        hslab->seq_cache = NULL;
+    } /* end if */
+
+    /* Only regular selections can be cheaply checked for changes later */
+    if(!hslab->diminfo_valid || hslab->unlim_dim >= 0 || 0 == space->select.num_elem)
+        HGOTO_DONE(SUCCEED)
+
+    /* Allocate the new sequence list and record what it was generated from */
+    if(NULL == (cache = H5FL_CALLOC(H5S_hyper_seq_cache_t)))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "can't allocate sequence list")
+    cache->rank = space->extent.rank;
+    for(u = 0; u < cache->rank; u++) {
+        cache->dims[u] = space->extent.size[u];
+        cache->offset[u] = space->select.offset[u];
+        cache->diminfo[u] = hslab->opt_diminfo[u];
+    } /* end for */
+
+    /* Generate the sequences, in units of elements */
+    if(H5S_select_iter_init(&iter, space, (size_t)1) < 0)
+        HGOTO_ERROR(H5E_DATASPACE, H5E_CANTINIT, FAIL, "unable to initialize selection iterator")
+    iter_init = TRUE;
+    while(iter.elmt_left > 0) {
+        size_t nseq, nelem;             /* Number of sequences & elements generated */
+
+        /* Make room for more sequences */
+        if(cache->nseq + H5D_IO_VECTOR_SIZE > nalloc) {
+            hsize_t *new_off;
+            size_t *new_len;
+
+            nalloc = MAX(2 * nalloc, cache->nseq + H5D_IO_VECTOR_SIZE);
+            if(NULL == (new_off = (hsize_t *)H5MM_realloc(cache->off, nalloc * sizeof(hsize_t))))
+                HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "can't allocate sequence offsets")
+            cache->off = new_off;
+            if(NULL == (new_len = (size_t *)H5MM_realloc(cache->len, nalloc * sizeof(size_t))))
+                HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "can't allocate sequence lengths")
+            cache->len = new_len;
+        } /* end if */
+
+        if(H5S_hyper_get_seq_list(space, 0, &iter, (size_t)H5D_IO_VECTOR_SIZE, (size_t)-1, &nseq, &nelem, cache->off + cache->nseq, cache->len + cache->nseq) < 0)
+            HGOTO_ERROR(H5E_DATASPACE, H5E_UNSUPPORTED, FAIL, "sequence length generation failed")
+        cache->nseq += nseq;
+    } /* end while */
+
+    /* Merge sequences which are adjacent, e.g. split between generator calls */
+    for(u = 0, v = 1; v < cache->nseq; v++) {
+        if(cache->off[u] + cache->len[u] == cache->off[v])
+            cache->len[u] += cache->len[v];
+        else {
+            u++;
+            cache->off[u] = cache->off[v];
+            cache->len[u] = cache->len[v];
+        } /* end else */
+    } /* end for */
+    cache->nseq = u + 1;
+
+    /* Attach the sequence list to the selection */
+    hslab->seq_cache = cache;
+    cache = NULL;
+
+done:
+    if(iter_init && H5S_SELECT_ITER_RELEASE(&iter) < 0)
+        HDONE_ERROR(H5E_DATASPACE, H5E_CANTRELEASE, FAIL, "unable to release selection iterator")
+    if(cache)
+        H5S_hyper_free_seq_cache(cache);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5S__hyper_compile() */
+
 
 /*--------------------------------------------------------------------------
  NAME
@@ -113,6 +113,19 @@ struct H5S_hyper_span_info_t {
     struct H5S_hyper_span_t *head;  /* Pointer to list of spans in next dimension down */
 };
 
+/* Compiled offset/length sequence list for a regular hyperslab selection.
+ * The selection it was generated from is recorded, so the list can be
+ * checked against the current selection before it is used. */
+typedef struct H5S_hyper_seq_cache_t {
+    unsigned rank;                              /* Rank of dataspace */
+    hsize_t dims[H5S_MAX_RANK];                 /* Dataspace extent */
+    hssize_t offset[H5S_MAX_RANK];              /* Selection offset */
+    H5S_hyper_dim_t diminfo[H5S_MAX_RANK];      /* Regular selection info */
+    size_t nseq;                                /* Number of sequences */
+    hsize_t *off;                               /* Sequence offsets, in elements */
+    size_t *len;                                /* Sequence lengths, in elements */
+} H5S_hyper_seq_cache_t;
+
 /* Information about new-style hyperslab selection */
 typedef struct {
     hbool_t diminfo_valid;                      /* Whether the dataset has valid diminfo */
@@ -127,6 +140,7 @@ typedef struct {
     int unlim_dim;                              /* Dimension where selection is unlimited, or -1 if none */
     hsize_t num_elem_non_unlim;                 /* # of elements in a "slice" excluding the unlimited dimension */
     H5S_hyper_span_info_t *span_lst; /* List of hyperslab span information */
+    H5S_hyper_seq_cache_t *seq_cache; /* Compiled sequence list (NULL if not compiled) */
 } H5S_hyper_sel_t;
 
 /* Selection information methods */
@@ -274,11 +288,13 @@ H5_DLL herr_t H5S__hyper_project_intersection(const H5S_t *src_space,
     const H5S_t *dst_space, const H5S_t *src_intersect_space,
     H5S_t *proj_space);
 H5_DLL herr_t H5S__hyper_subtract(H5S_t *space, H5S_t *subtract_space);
+H5_DLL herr_t H5S__hyper_compile(H5S_t *space);
 
 /* Testing functions */
 #ifdef H5S_TESTING
 H5_DLL htri_t H5S_select_shape_same_test(hid_t sid1, hid_t sid2);
 H5_DLL htri_t H5S_get_rebuild_status_test(hid_t space_id);
+H5_DLL htri_t H5S_get_compiled_status_test(hid_t space_id);
 #endif /* H5S_TESTING */
 
 #endif /*_H5Spkg_H*/
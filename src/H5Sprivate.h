@@ -86,6 +86,11 @@ typedef struct {
     /* Irregular hyperslab selection fields */
     H5S_hyper_span_info_t *spans;  /* Pointer to copy of the span tree */
     H5S_hyper_span_t *span[H5S_MAX_RANK];/* Array of pointers to span nodes */
+
+    /* Compiled sequence list fields (only used when generating sequences) */
+    const struct H5S_hyper_seq_cache_t *seq_cache; /* Compiled sequence list, if valid for the selection */
+    size_t cache_seq;                   /* Current sequence in the compiled list */
+    size_t cache_elmt;                  /* Elements already used from the current sequence */
 } H5S_hyper_iter_t;
 
 /* "All" selection iteration container */
@@ -113,6 +113,8 @@ H5_DLL herr_t H5Sselect_hyperslab(hid_t space_id, H5S_seloper_t op,
 				   const hsize_t _stride[],
 				   const hsize_t count[],
 				   const hsize_t _block[]);
+H5_DLL herr_t H5Sselect_blocks(hid_t space_id, H5S_seloper_t op,
+    size_t num_blocks, const hsize_t *start, const hsize_t *block);
 /* #define NEW_HYPERSLAB_API */
 /* Note that these haven't been working for a while and were never
  *      publicly released - QAK */
@@ -137,6 +139,7 @@ H5_DLL herr_t H5Sselect_all(hid_t spaceid);
 H5_DLL herr_t H5Sselect_none(hid_t spaceid);
 H5_DLL herr_t H5Soffset_simple(hid_t space_id, const hssize_t *offset);
 H5_DLL htri_t H5Sselect_valid(hid_t spaceid);
+H5_DLL herr_t H5Sselect_compile(hid_t spaceid);
 H5_DLL htri_t H5Sis_regular_hyperslab(hid_t spaceid);
 H5_DLL htri_t H5Sget_regular_hyperslab(hid_t spaceid, hsize_t start[],
     hsize_t stride[], hsize_t count[], hsize_t block[]);
@@ -384,6 +384,57 @@ done:
     FUNC_LEAVE_API(ret_value)
 }   /* H5Sselect_valid() */
 
+
+/*--------------------------------------------------------------------------
+ NAME
+    H5Sselect_compile
+ PURPOSE
+    Precompute the sequence list for a dataspace selection, for reuse
+ USAGE
+    herr_t H5Sselect_compile(spaceid)
+        hid_t spaceid;          IN: Dataspace ID of selection to compile
+ RETURNS
+    Non-negative on success/Negative on failure
+ DESCRIPTION
+    Generates the offset/length sequences for the current selection once
+    and keeps them with the dataspace.  I/O operations which use the
+    dataspace afterwards take their sequences from this list instead of
+    walking the selection again, which makes repeatedly reading or writing
+    the same selection, e.g. from many datasets, much cheaper.  The list is
+    ignored (and regenerated on the next call) once the selection, extent
+    or offset of the dataspace changes.
+ GLOBAL VARIABLES
+ COMMENTS, BUGS, ASSUMPTIONS
+    Only regular hyperslab selections are compiled; other selections are
+    already cheap to iterate over, or can't be cheaply checked for
+    changes, and are left as they are.
+ EXAMPLES
+ REVISION LOG
+--------------------------------------------------------------------------*/
+herr_t
+H5Sselect_compile(hid_t spaceid)
+{
+    H5S_t *space;       /* Dataspace to compile selection of */
+    herr_t ret_value = SUCCEED; /* return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE1("e", "i", spaceid);
+
+    /* Check args */
+    if(NULL == (space = (H5S_t *)H5I_object_verify(spaceid, H5I_DATASPACE)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a dataspace")
+    if(TRUE != H5S_SELECT_VALID(space))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADRANGE, FAIL, "selection + offset not within extent")
+
+    /* Compile the selection */
+    if(H5S_GET_SELECT_TYPE(space) == H5S_SEL_HYPERSLABS)
+        if(H5S__hyper_compile(space) < 0)
+            HGOTO_ERROR(H5E_DATASPACE, H5E_CANTINIT, FAIL, "unable to compile selection")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+}   /* H5Sselect_compile() */
+
 
 /*--------------------------------------------------------------------------
  NAME
@@ -109,3 +109,44 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* H5S_get_rebuild_status_test() */
 
+
+/*--------------------------------------------------------------------------
+ NAME
+    H5S_get_compiled_status_test
+ PURPOSE
+    Determine whether a hyperslab selection has a compiled sequence list
+ USAGE
+    htri_t H5S_get_compiled_status_test(hid_t space_id)
+        hid_t space_id;          IN:  dataspace id
+ RETURNS
+    Non-negative TRUE/FALSE on success, negative on failure
+ DESCRIPTION
+    Query whether a sequence list is attached to the hyperslab selection
+    (whether or not it is still up to date)
+ GLOBAL VARIABLES
+ COMMENTS, BUGS, ASSUMPTIONS
+    DO NOT USE THIS FUNCTION FOR ANYTHING EXCEPT TESTING
+ EXAMPLES
+ REVISION LOG
+--------------------------------------------------------------------------*/
+htri_t
+H5S_get_compiled_status_test(hid_t space_id)
+{
+    H5S_t *space;               /* Pointer to dataspace */
+    htri_t ret_value = FAIL;    /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    /* Get dataspace structures */
+    if(NULL == (space = (H5S_t *)H5I_object_verify(space_id, H5I_DATASPACE)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a dataspace")
+
+    if(H5S_GET_SELECT_TYPE(space) == H5S_SEL_HYPERSLABS)
+        ret_value = (htri_t)(space->select.sel_info.hslab->seq_cache != NULL);
+    else
+        ret_value = FALSE;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5S_get_compiled_status_test() */
+
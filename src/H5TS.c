@@ -17,6 +17,13 @@
 #include "H5private.h"    /*library                     */
 #include "H5Eprivate.h"    /*error handling              */
 #include "H5MMprivate.h"  /*memory management functions    */
+#include "H5TSprivate.h"  /*threads                       */
+
+/* Worker threads for H5TS_task_run() are only available with Pthreads */
+#if defined(H5_HAVE_PTHREAD_H) && !defined(H5_HAVE_WIN_THREADS)
+#include <pthread.h>
+#define H5TS_HAVE_TASK_THREADS
+#endif /* defined(H5_HAVE_PTHREAD_H) && !defined(H5_HAVE_WIN_THREADS) */
 
 #ifdef H5_HAVE_THREADSAFE
 
@@ -217,6 +224,62 @@ H5TS_mutex_unlock(H5TS_mutex_t *mutex)
 } /* H5TS_mutex_unlock */
 
 
+/*--------------------------------------------------------------------------
+ * NAME
+ *    H5TS_mutex_unlock_single
+ *
+ * USAGE
+ *    H5TS_mutex_unlock_single(&mutex_var, &unlocked)
+ *
+ * RETURNS
+ *    0 on success and non-zero on error.
+ *
+ * DESCRIPTION
+ *    Releases a recursive lock, but only when the calling thread holds it
+ *    exactly once.  A thread that holds the lock more than once is inside
+ *    a nested call and may still have state that other threads must not
+ *    see, so the lock is left alone in that case.  UNLOCKED is set to
+ *    whether the lock was released; if so, the caller must take it again
+ *    with H5TS_mutex_lock().
+ *
+ *    With Windows threads the lock is never released, since a critical
+ *    section doesn't expose its recursion count.
+ *
+ *--------------------------------------------------------------------------
+ */
+herr_t
+H5TS_mutex_unlock_single(H5TS_mutex_t *mutex, hbool_t *unlocked)
+{
+#ifdef  H5_HAVE_WIN_THREADS
+    *unlocked = FALSE;
+    return 0;
+#else  /* H5_HAVE_WIN_THREADS */
+    herr_t ret_value = pthread_mutex_lock(&mutex->atomic_lock);
+
+    *unlocked = FALSE;
+    if(ret_value)
+        return ret_value;
+
+    if(mutex->lock_count == 1 && pthread_equal(HDpthread_self(), mutex->owner_thread)) {
+        mutex->lock_count = 0;
+        *unlocked = TRUE;
+    } /* end if */
+
+    ret_value = pthread_mutex_unlock(&mutex->atomic_lock);
+
+    if(*unlocked) {
+        int err;
+
+        err = pthread_cond_signal(&mutex->cond_var);
+        if(err != 0)
+            ret_value = err;
+    } /* end if */
+
+    return ret_value;
+#endif /* H5_HAVE_WIN_THREADS */
+} /* H5TS_mutex_unlock_single */
+
+
 /*--------------------------------------------------------------------------
  * NAME
  *    H5TS_cancel_count_inc
@@ -518,3 +581,263 @@ H5TS_create_thread(void *(*func)(void *), H5TS_attr_t *attr, void *udata)
 } /* H5TS_create_thread */
 
 #endif  /* H5_HAVE_THREADSAFE */
+
+
+/* Shared state for the threads executing one H5TS_task_run() call */
+typedef struct H5TS_task_info_t {
+    H5TS_task_op_t op;                  /* Operation to apply to each task */
+    void *udata;                        /* User data for operation */
+    size_t ntasks;                      /* Number of tasks */
+    size_t next;                        /* Next task to hand out */
+    hbool_t failed;                     /* Whether any task has failed */
+#ifdef H5TS_HAVE_TASK_THREADS
+    pthread_mutex_t lock;               /* Protects 'next' and 'failed' */
+#endif /* H5TS_HAVE_TASK_THREADS */
+} H5TS_task_info_t;
+
+/* Tasks started by H5TS_task_start() */
+struct H5TS_task_t {
+    H5TS_task_info_t info;              /* Shared task information */
+#ifdef H5TS_HAVE_TASK_THREADS
+    pthread_t threads[H5TS_TASK_MAX_THREADS];   /* Worker threads */
+    unsigned nworkers;                  /* # of worker threads created */
+#endif /* H5TS_HAVE_TASK_THREADS */
+};
+
+
+/*--------------------------------------------------------------------------
+ * NAME
+ *    H5TS_task_worker
+ *
+ * RETURNS
+ *    NULL
+ *
+ * DESCRIPTION
+ *    Repeatedly claims the next unprocessed task and applies the operation
+ *    to it, until all tasks have been handed out or a task has failed.
+ *    Runs on the worker threads as well as on the calling thread.
+ *
+ *--------------------------------------------------------------------------
+ */
+static void *
+H5TS_task_worker(void *_info)
+{
+    H5TS_task_info_t *info = (H5TS_task_info_t *)_info;
+
+    for(;;) {
+        size_t idx;             /* Index of task to execute */
+        hbool_t done;           /* Whether there's nothing left to do */
+
+#ifdef H5TS_HAVE_TASK_THREADS
+        pthread_mutex_lock(&info->lock);
+#endif /* H5TS_HAVE_TASK_THREADS */
+        done = (info->failed || info->next >= info->ntasks);
+        idx = info->next++;
+#ifdef H5TS_HAVE_TASK_THREADS
+        pthread_mutex_unlock(&info->lock);
+#endif /* H5TS_HAVE_TASK_THREADS */
+        if(done)
+            break;
+
+        if((info->op)(idx, info->udata) < 0) {
+#ifdef H5TS_HAVE_TASK_THREADS
+            pthread_mutex_lock(&info->lock);
+#endif /* H5TS_HAVE_TASK_THREADS */
+            info->failed = TRUE;
+#ifdef H5TS_HAVE_TASK_THREADS
+            pthread_mutex_unlock(&info->lock);
+#endif /* H5TS_HAVE_TASK_THREADS */
+        } /* end if */
+    } /* end for */
+
+    return NULL;
+} /* H5TS_task_worker() */
+
+
+/*--------------------------------------------------------------------------
+ * NAME
+ *    H5TS_task_run
+ *
+ * RETURNS
+ *    Non-negative on success / Negative on failure (if any task failed)
+ *
+ * DESCRIPTION
+ *    Applies OP to each task index in [0, NTASKS), using up to NTHREADS
+ *    threads (including the calling thread).  Returns once every task
+ *    has completed.  Tasks are handed out in increasing index order, but
+ *    may complete in any order.  After a task fails, no further tasks are
+ *    started.
+ *
+ *    The operation runs outside of the library's normal function entry
+ *    and error stack machinery on the worker threads, so it must not
+ *    touch shared library state that isn't protected by the caller.
+ *
+ *    If threads aren't available, or can't be created, the tasks are
+ *    executed serially on the calling thread.  This routine is available
+ *    whether or not the library is built thread-safe.
+ *
+ *--------------------------------------------------------------------------
+ */
+herr_t
+H5TS_task_run(unsigned nthreads, size_t ntasks, H5TS_task_op_t op, void *udata)
+{
+    H5TS_task_info_t info;              /* Shared task information */
+#ifdef H5TS_HAVE_TASK_THREADS
+    pthread_t threads[H5TS_TASK_MAX_THREADS];   /* Worker threads */
+    unsigned nworkers = 0;              /* # of worker threads created */
+    unsigned u;                         /* Local index variable */
+#endif /* H5TS_HAVE_TASK_THREADS */
+
+    HDassert(op);
+
+    /* Set up shared info */
+    info.op = op;
+    info.udata = udata;
+    info.ntasks = ntasks;
+    info.next = 0;
+    info.failed = FALSE;
+
+#ifdef H5TS_HAVE_TASK_THREADS
+    /* Don't create more threads than there are tasks to give them */
+    if(nthreads > H5TS_TASK_MAX_THREADS)
+        nthreads = H5TS_TASK_MAX_THREADS;
+    if((size_t)nthreads > ntasks)
+        nthreads = (unsigned)ntasks;
+
+    if(nthreads > 1) {
+        pthread_mutex_init(&info.lock, NULL);
+
+        /* Start the worker threads (the calling thread is the last worker) */
+        for(u = 0; u < (nthreads - 1); u++) {
+            if(pthread_create(&threads[nworkers], NULL, H5TS_task_worker, &info))
+                break;
+            nworkers++;
+        } /* end for */
+
+        /* Do our share of the work */
+        H5TS_task_worker(&info);
+
+        /* Wait for the workers to finish */
+        for(u = 0; u < nworkers; u++)
+            pthread_join(threads[u], NULL);
+
+        pthread_mutex_destroy(&info.lock);
+    } /* end if */
+    else
+#endif /* H5TS_HAVE_TASK_THREADS */
+        H5TS_task_worker(&info);
+
+    return(info.failed ? FAIL : SUCCEED);
+} /* H5TS_task_run() */
+
+
+/*--------------------------------------------------------------------------
+ * NAME
+ *    H5TS_task_start
+ *
+ * RETURNS
+ *    Handle for the tasks on success / NULL on failure
+ *
+ * DESCRIPTION
+ *    Like H5TS_task_run(), but applies OP to the tasks on up to NTHREADS
+ *    worker threads only, and returns without waiting for them.  The
+ *    tasks must be waited for with H5TS_task_wait(), which releases the
+ *    handle, and UDATA must remain valid until then.
+ *
+ *    If threads aren't available, or can't be created, the tasks are
+ *    executed on the calling thread before returning.
+ *
+ *--------------------------------------------------------------------------
+ */
+H5TS_task_t *
+H5TS_task_start(unsigned nthreads, size_t ntasks, H5TS_task_op_t op, void *udata)
+{
+    H5TS_task_t *task;                  /* Handle for the tasks */
+#ifdef H5TS_HAVE_TASK_THREADS
+    unsigned u;                         /* Local index variable */
+#endif /* H5TS_HAVE_TASK_THREADS */
+
+    HDassert(op);
+
+    /* Allocate the handle */
+    if(NULL == (task = (H5TS_task_t *)HDmalloc(sizeof(H5TS_task_t))))
+        return NULL;
+
+    /* Set up shared info */
+    task->info.op = op;
+    task->info.udata = udata;
+    task->info.ntasks = ntasks;
+    task->info.next = 0;
+    task->info.failed = FALSE;
+
+#ifdef H5TS_HAVE_TASK_THREADS
+    task->nworkers = 0;
+
+    /* Don't create more threads than there are tasks to give them */
+    if(0 == nthreads)
+        nthreads = 1;
+    if(nthreads > H5TS_TASK_MAX_THREADS)
+        nthreads = H5TS_TASK_MAX_THREADS;
+    if((size_t)nthreads > ntasks)
+        nthreads = (unsigned)ntasks;
+
+    if(nthreads > 0) {
+        pthread_mutex_init(&task->info.lock, NULL);
+
+        /* Start the worker threads */
+        for(u = 0; u < nthreads; u++) {
+            if(pthread_create(&task->threads[task->nworkers], NULL, H5TS_task_worker, &task->info))
+                break;
+            task->nworkers++;
+        } /* end for */
+
+        /* Do the work here if no thread could be created */
+        if(0 == task->nworkers) {
+            pthread_mutex_destroy(&task->info.lock);
+            H5TS_task_worker(&task->info);
+        } /* end if */
+    } /* end if */
+#else /* H5TS_HAVE_TASK_THREADS */
+    H5TS_task_worker(&task->info);
+#endif /* H5TS_HAVE_TASK_THREADS */
+
+    return task;
+} /* H5TS_task_start() */
+
+
+/*--------------------------------------------------------------------------
+ * NAME
+ *    H5TS_task_wait
+ *
+ * RETURNS
+ *    Non-negative on success / Negative on failure (if any task failed)
+ *
+ * DESCRIPTION
+ *    Waits for the tasks started by H5TS_task_start() to complete, then
+ *    releases TASK.
+ *
+ *--------------------------------------------------------------------------
+ */
+herr_t
+H5TS_task_wait(H5TS_task_t *task)
+{
+    herr_t ret_value;
+#ifdef H5TS_HAVE_TASK_THREADS
+    unsigned u;                         /* Local index variable */
+#endif /* H5TS_HAVE_TASK_THREADS */
+
+    HDassert(task);
+
+#ifdef H5TS_HAVE_TASK_THREADS
+    if(task->nworkers > 0) {
+        for(u = 0; u < task->nworkers; u++)
+            pthread_join(task->threads[u], NULL);
+        pthread_mutex_destroy(&task->info.lock);
+    } /* end if */
+#endif /* H5TS_HAVE_TASK_THREADS */
+
+    ret_value = task->info.failed ? FAIL : SUCCEED;
+    HDfree(task);
+
+    return ret_value;
+} /* H5TS_task_wait() */
@@ -33,6 +33,33 @@
 #include "H5TSpublic.h"		/*Public API prototypes */
 #endif /* LATER */
 
+/* Maximum # of threads used by H5TS_task_run() */
+#define H5TS_TASK_MAX_THREADS   256
+
+/* Operation applied to each task by H5TS_task_run() */
+typedef herr_t (*H5TS_task_op_t)(size_t idx, void *udata);
+
+/* Tasks running in the background (opaque) */
+typedef struct H5TS_task_t H5TS_task_t;
+
+#if defined c_plusplus || defined __cplusplus
+extern      "C"
+{
+#endif	/* c_plusplus || __cplusplus */
+
+/* Parallel task execution, available in all builds */
+H5_DLL herr_t H5TS_task_run(unsigned nthreads, size_t ntasks, H5TS_task_op_t op,
+    void *udata);
+H5_DLL H5TS_task_t *H5TS_task_start(unsigned nthreads, size_t ntasks,
+    H5TS_task_op_t op, void *udata);
+H5_DLL herr_t H5TS_task_wait(H5TS_task_t *task);
+
+#if defined c_plusplus || defined __cplusplus
+}
+#endif	/* c_plusplus || __cplusplus */
+
+#ifdef H5_HAVE_THREADSAFE
+
 #ifdef H5_HAVE_WIN_THREADS
 
 /* Library level data structures */
@@ -120,6 +147,7 @@ extern      "C"
 H5_DLL void   H5TS_pthread_first_thread_init(void);
 H5_DLL herr_t H5TS_mutex_lock(H5TS_mutex_t *mutex);
 H5_DLL herr_t H5TS_mutex_unlock(H5TS_mutex_t *mutex);
+H5_DLL herr_t H5TS_mutex_unlock_single(H5TS_mutex_t *mutex, hbool_t *unlocked);
 H5_DLL herr_t H5TS_cancel_count_inc(void);
 H5_DLL herr_t H5TS_cancel_count_dec(void);
 H5_DLL H5TS_thread_t H5TS_create_thread(void *(*func)(void *), H5TS_attr_t * attr, void *udata);
@@ -128,4 +156,6 @@ H5_DLL H5TS_thread_t H5TS_create_thread(void *(*func)(void *), H5TS_attr_t * att
 }
 #endif	/* c_plusplus || __cplusplus */
 
+#endif	/* H5_HAVE_THREADSAFE */
+
 #endif	/* H5TSprivate_H_ */
@@ -679,6 +679,8 @@
     hbool_t	s_mv, d_mv;		/*move data to align it?	*/    \
     ssize_t	s_stride, d_stride;	/*src and dst strides		*/    \
     size_t      safe;                   /*how many elements are safe to process in each pass */ \
+    size_t      blk_nelmts;             /*# of elements in current block */   \
+    DT          dst_block[H5T_CONV_BLOCK_NELMTS]; /*block of converted values */ \
     H5P_genplist_t      *plist;         /*Property list pointer         */    \
     H5T_conv_cb_t       cb_struct;      /*conversion callback structure */    \
                                                                               \
@@ -771,7 +773,12 @@
             } /* end else */						      \
                                                                               \
             /* Perform loop over elements to convert */			      \
-            if (s_mv && d_mv) {						      \
+            if(!cb_struct.func && !s_mv && !d_mv &&                           \
+                    s_stride == (ssize_t)sizeof(ST) &&                        \
+                    d_stride == (ssize_t)sizeof(DT)) {                        \
+                /* Packed, aligned data without an exception handler */      \
+                H5T_CONV_LOOP_BLOCK(GUTS,STYPE,DTYPE,ST,DT,D_MIN,D_MAX)       \
+            } else if (s_mv && d_mv) {					      \
                 /* Alignment is required for both source and dest */	      \
                 s = &src_aligned;					      \
                 H5T_CONV_LOOP_OUTER(PRE_SALIGN,PRE_DALIGN,POST_SALIGN,POST_DALIGN,GUTS,STYPE,DTYPE,s,d,ST,DT,D_MIN,D_MAX) \
@@ -901,6 +908,35 @@ done:                                                                         \
         dst = (DT *)dst_buf;						      \
     }
 
+/* The number of elements converted at a time by H5T_CONV_LOOP_BLOCK */
+#define H5T_CONV_BLOCK_NELMTS   128
+
+/* The blocked loop for packed & aligned buffers when no exception handling
+ * routine is set.  Each block of source elements is converted (and clipped
+ * to the destination's range, by the "no exception" guts) into a local
+ * array before being moved to its place in the (possibly overlapping)
+ * destination.  The source and the local array can't alias, so the inner
+ * loops, one of which has a constant trip count, can be vectorized by the
+ * compiler.
+ */
+#define H5T_CONV_LOOP_BLOCK(GUTS,STYPE,DTYPE,ST,DT,D_MIN,D_MAX)              \
+    for(elmtno = 0; elmtno < safe; elmtno += blk_nelmts) {                    \
+        size_t u;                                                             \
+                                                                              \
+        blk_nelmts = MIN(safe - elmtno, H5T_CONV_BLOCK_NELMTS);              \
+        if(blk_nelmts == H5T_CONV_BLOCK_NELMTS) {                             \
+            for(u = 0; u < H5T_CONV_BLOCK_NELMTS; u++)                        \
+                H5T_CONV_LOOP_GUTS(H5_GLUE(GUTS,_NOEX),STYPE,DTYPE,(src + u),(dst_block + u),ST,DT,D_MIN,D_MAX) \
+        } /* end if */                                                        \
+        else {                                                                \
+            for(u = 0; u < blk_nelmts; u++)                                   \
+                H5T_CONV_LOOP_GUTS(H5_GLUE(GUTS,_NOEX),STYPE,DTYPE,(src + u),(dst_block + u),ST,DT,D_MIN,D_MAX) \
+        } /* end else */                                                      \
+        HDmemmove(dst, dst_block, blk_nelmts * sizeof(DT));                   \
+        src += blk_nelmts;                                                    \
+        dst += blk_nelmts;                                                    \
+    }
+
 /* Macro to call the actual "guts" of the type conversion, or call the "no exception" guts */
 #ifdef H5_WANT_DCONV_EXCEPTION
 #define H5T_CONV_LOOP_GUTS(GUTS,STYPE,DTYPE,S,D,ST,DT,D_MIN,D_MAX)			      \
@@ -958,6 +994,28 @@ done:                                                                         \
 /* Swap two elements (I & J) of an array using a temporary variable */
 #define H5_SWAP_BYTES(ARRAY,I,J) {uint8_t _tmp; _tmp=ARRAY[I]; ARRAY[I]=ARRAY[J]; ARRAY[J]=_tmp;}
 
+/* Reverse the bytes of each of the NELMTS packed elements of type T (an
+ * unsigned integer type of 2, 4 or 8 bytes) in BUF.  Whole elements are
+ * loaded, swapped with shifts & masks and stored back, which compilers
+ * recognize as a byte swap and can vectorize.
+ */
+#define H5T_SWAP_PACKED(T, SWAP, BUF, NELMTS) {                               \
+    size_t _u;                                                                \
+                                                                              \
+    for(_u = 0; _u < (NELMTS); _u++) {                                        \
+        T _v;                                                                 \
+                                                                              \
+        HDmemcpy(&_v, (BUF) + _u * sizeof(T), sizeof(T));                     \
+        _v = SWAP(_v);                                                        \
+        HDmemcpy((BUF) + _u * sizeof(T), &_v, sizeof(T));                     \
+    }                                                                         \
+}
+#define H5T_SWAP_16(V) ((uint16_t)(((V) >> 8) | ((V) << 8)))
+#define H5T_SWAP_32(V) ((((V) >> 24) & 0x000000ffu) | (((V) >> 8) & 0x0000ff00u) | \
+        (((V) << 8) & 0x00ff0000u) | (((V) << 24) & 0xff000000u))
+#define H5T_SWAP_64(V) ((uint64_t)H5T_SWAP_32((uint32_t)(V)) << 32 |          \
+        (uint64_t)H5T_SWAP_32((uint32_t)((V) >> 32)))
+
 /* Minimum size of variable-length conversion buffer */
 #define H5T_VLEN_MIN_CONF_BUF_SIZE      4096
 
@@ -965,6 +1023,14 @@ done:                                                                         \
 /* Local Typedefs */
 /******************/
 
+/* A run of bytes copied unchanged from a source compound element to the
+ * destination element (one or more adjacent members needing no conversion) */
+typedef struct H5T_conv_struct_copy_t {
+    size_t      src_offset;             /*offset of run in source element    */
+    size_t      dst_offset;             /*offset of run in dest. element     */
+    size_t      size;                   /*number of bytes in run             */
+} H5T_conv_struct_copy_t;
+
 /* Conversion data for H5T__conv_struct() */
 typedef struct H5T_conv_struct_t {
     int	*src2dst;		/*mapping from src to dst member num */
@@ -973,6 +1039,9 @@ typedef struct H5T_conv_struct_t {
     H5T_path_t	**memb_path;		/*conversion path for each member    */
     H5T_subset_info_t   subset_info;    /*info related to compound subsets   */
     unsigned            src_nmembs;     /*needed by free function            */
+    hbool_t             *memb_copied;   /*source member is in a copy run     */
+    H5T_conv_struct_copy_t *copy;       /*coalesced copies of no-op members  */
+    size_t              ncopies;        /*number of copy runs                */
 } H5T_conv_struct_t;
 
 /* Conversion data for H5T__conv_enum() */
@@ -1180,6 +1249,27 @@ H5T__conv_order_opt(hid_t src_id, hid_t dst_id, H5T_cdata_t *cdata,
             } /* end if */
 
             buf_stride = buf_stride ? buf_stride : src->shared->size;
+
+            /* Swap packed elements a whole word at a time */
+            if(buf_stride == src->shared->size) {
+                switch(src->shared->size) {
+                    case 2:
+                        H5T_SWAP_PACKED(uint16_t, H5T_SWAP_16, buf, nelmts)
+                        HGOTO_DONE(SUCCEED)
+
+                    case 4:
+                        H5T_SWAP_PACKED(uint32_t, H5T_SWAP_32, buf, nelmts)
+                        HGOTO_DONE(SUCCEED)
+
+                    case 8:
+                        H5T_SWAP_PACKED(uint64_t, H5T_SWAP_64, buf, nelmts)
+                        HGOTO_DONE(SUCCEED)
+
+                    default:
+                        break;
+                } /* end switch */
+            } /* end if */
+
             switch(src->shared->size) {
                 case 1:
                     /*no-op*/
@@ -1887,6 +1977,8 @@ H5T_conv_struct_free(H5T_conv_struct_t *priv)
     H5MM_xfree(src_memb_id);
     H5MM_xfree(dst_memb_id);
     H5MM_xfree(priv->memb_path);
+    H5MM_xfree(priv->memb_copied);
+    H5MM_xfree(priv->copy);
 
     FUNC_LEAVE_NOAPI((H5T_conv_struct_t *)H5MM_xfree(priv))
 } /* end H5T_conv_struct_free() */
@@ -2035,6 +2127,45 @@ H5T_conv_struct_init(H5T_t *src, H5T_t *dst, H5T_cdata_t *cdata, hid_t dxpl_id)
         } /* end if */
     } /* end for */
 
+    /*
+     * (Re)build the copy program: members which need no conversion are
+     * moved straight from the source element to the background buffer,
+     * with members adjacent in both the source and the destination
+     * coalesced into a single copy.  (Members are sorted by offset, so
+     * adjacent members are next to each other in the source.)
+     */
+    H5MM_xfree(priv->memb_copied);
+    H5MM_xfree(priv->copy);
+    priv->copy = NULL;
+    priv->ncopies = 0;
+    if(NULL == (priv->memb_copied = (hbool_t *)H5MM_calloc(src_nmembs * sizeof(hbool_t))) ||
+            NULL == (priv->copy = (H5T_conv_struct_copy_t *)H5MM_malloc(src_nmembs * sizeof(H5T_conv_struct_copy_t)))) {
+        cdata->priv = H5T_conv_struct_free(priv);
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed")
+    } /* end if */
+    for(i = 0; i < src_nmembs; i++) {
+        const H5T_cmemb_t *src_memb, *dst_memb;
+
+        if(src2dst[i] < 0 || !priv->memb_path[i]->is_noop)
+            continue;
+        src_memb = &src->shared->u.compnd.memb[i];
+        dst_memb = &dst->shared->u.compnd.memb[src2dst[i]];
+        if(src_memb->size != dst_memb->size)
+            continue;
+
+        priv->memb_copied[i] = TRUE;
+        if(priv->ncopies > 0 &&
+                priv->copy[priv->ncopies - 1].src_offset + priv->copy[priv->ncopies - 1].size == src_memb->offset &&
+                priv->copy[priv->ncopies - 1].dst_offset + priv->copy[priv->ncopies - 1].size == dst_memb->offset)
+            priv->copy[priv->ncopies - 1].size += src_memb->size;
+        else {
+            priv->copy[priv->ncopies].src_offset = src_memb->offset;
+            priv->copy[priv->ncopies].dst_offset = dst_memb->offset;
+            priv->copy[priv->ncopies].size = src_memb->size;
+            priv->ncopies++;
+        } /* end else */
+    } /* end for */
+
     /* The compound conversion functions need a background buffer */
     cdata->need_bkg = H5T_BKG_YES;
 
@@ -2245,6 +2376,13 @@ H5T__conv_struct(hid_t src_id, hid_t dst_id, H5T_cdata_t *cdata, size_t nelmts,
 
             /* Conversion loop... */
             for(elmtno = 0; elmtno < nelmts; elmtno++) {
+                /*
+                 * Copy the members which need no conversion directly to the
+                 * background buffer.  They are skipped by the loops below.
+                 */
+                for(u = 0; u < priv->ncopies; u++)
+                    HDmemcpy(xbkg + priv->copy[u].dst_offset, xbuf + priv->copy[u].src_offset, priv->copy[u].size);
+
                 /*
                  * For each source member which will be present in the
                  * destination, convert the member to the destination type unless
@@ -2254,8 +2392,8 @@ H5T__conv_struct(hid_t src_id, hid_t dst_id, H5T_cdata_t *cdata, size_t nelmts,
                  * right side.
                  */
                 for(u = 0, offset = 0; u < src->shared->u.compnd.nmembs; u++) {
-                    if(src2dst[u] < 0)
-                        continue; /*subsetting*/
+                    if(src2dst[u] < 0 || priv->memb_copied[u])
+                        continue; /*subsetting or already copied*/
                     src_memb = src->shared->u.compnd.memb + u;
                     dst_memb = dst->shared->u.compnd.memb + src2dst[u];
 
@@ -2285,8 +2423,8 @@ H5T__conv_struct(hid_t src_id, hid_t dst_id, H5T_cdata_t *cdata, size_t nelmts,
                  */
                 H5_CHECK_OVERFLOW(src->shared->u.compnd.nmembs, size_t, int);
                 for(i = (int)src->shared->u.compnd.nmembs - 1; i >= 0; --i) {
-                    if(src2dst[i] < 0)
-                        continue; /*subsetting*/
+                    if(src2dst[i] < 0 || priv->memb_copied[i])
+                        continue; /*subsetting or already copied*/
                     src_memb = src->shared->u.compnd.memb + i;
                     dst_memb = dst->shared->u.compnd.memb + src2dst[i];
 
@@ -2549,6 +2687,19 @@ H5T__conv_struct_opt(hid_t src_id, hid_t dst_id, H5T_cdata_t *cdata,
                 } /* end for */
             } /* end if */
             else {
+                /*
+                 * Copy the members which need no conversion directly to the
+                 * background buffer, before any members are moved within the
+                 * buffer.  They are skipped by the loops below.
+                 */
+                if(priv->ncopies > 0)
+                    for(xbuf = buf, xbkg = bkg, elmtno = 0; elmtno < nelmts; elmtno++) {
+                        for(u = 0; u < priv->ncopies; u++)
+                            HDmemcpy(xbkg + priv->copy[u].dst_offset, xbuf + priv->copy[u].src_offset, priv->copy[u].size);
+                        xbuf += buf_stride;
+                        xbkg += bkg_stride;
+                    } /* end for */
+
                 /*
                  * For each member where the destination is not larger than the
                  * source, stride through all the elements converting only that member
@@ -2557,8 +2708,8 @@ H5T__conv_struct_opt(hid_t src_id, hid_t dst_id, H5T_cdata_t *cdata,
                  * left as possible in the buffer.
                  */
                 for(u = 0, offset = 0; u < src->shared->u.compnd.nmembs; u++) {
-                    if(src2dst[u] < 0)
-                        continue; /*subsetting*/
+                    if(src2dst[u] < 0 || priv->memb_copied[u])
+                        continue; /*subsetting or already copied*/
                     src_memb = src->shared->u.compnd.memb + u;
                     dst_memb = dst->shared->u.compnd.memb + src2dst[u];
 
@@ -2592,7 +2743,7 @@ H5T__conv_struct_opt(hid_t src_id, hid_t dst_id, H5T_cdata_t *cdata,
                  */
                 H5_CHECK_OVERFLOW(src->shared->u.compnd.nmembs, size_t, int);
                 for(i = (int)src->shared->u.compnd.nmembs - 1; i >= 0; --i) {
-                    if(src2dst[i] < 0)
+                    if(src2dst[i] < 0 || priv->memb_copied[i])
                         continue;
                     src_memb = src->shared->u.compnd.memb + i;
                     dst_memb = dst->shared->u.compnd.memb + src2dst[i];
@@ -3221,6 +3372,22 @@ H5T__conv_vlen(hid_t src_id, hid_t dst_id, H5T_cdata_t *cdata, size_t nelmts,
             if(write_to_file && parent_is_vlen && bkg != NULL)
                 nested = TRUE;
 
+            /* Move sequences whose base type needs no conversion between
+             * memory and the global heap in one batch, instead of one heap
+             * access per element */
+            if(noop_conv && !parent_is_vlen) {
+                if(H5T_LOC_DISK == src->shared->u.vlen.loc && H5T_LOC_MEMORY == dst->shared->u.vlen.loc) {
+                    if(H5T__vlen_disk_read_batch(src, dst, nelmts, (size_t)s_stride, (size_t)d_stride, buf, vl_alloc_info, dxpl_id) < 0)
+                        HGOTO_ERROR(H5E_DATATYPE, H5E_READERROR, FAIL, "can't read VL data")
+                    nelmts = 0;
+                } /* end if */
+                else if(H5T_LOC_MEMORY == src->shared->u.vlen.loc && H5T_LOC_DISK == dst->shared->u.vlen.loc) {
+                    if(H5T__vlen_disk_write_batch(src, dst, nelmts, (size_t)s_stride, (size_t)d_stride, buf, bkg, (size_t)b_stride, dxpl_id) < 0)
+                        HGOTO_ERROR(H5E_DATATYPE, H5E_WRITEERROR, FAIL, "can't write VL data")
+                    nelmts = 0;
+                } /* end else-if */
+            } /* end if */
+
             /* The outer loop of the type conversion macro, controlling which */
             /* direction the buffer is walked */
             while(nelmts > 0) {
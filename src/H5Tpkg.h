@@ -1295,6 +1295,12 @@ H5_DLL void H5T__bit_neg(uint8_t *buf, size_t start, size_t size);
 /* VL functions */
 H5_DLL H5T_t * H5T__vlen_create(const H5T_t *base);
 H5_DLL htri_t H5T__vlen_set_loc(const H5T_t *dt, H5F_t *f, H5T_loc_t loc);
+H5_DLL herr_t H5T__vlen_disk_read_batch(const H5T_t *src, const H5T_t *dst,
+    size_t nelmts, size_t s_stride, size_t d_stride, void *buf,
+    const H5T_vlen_alloc_info_t *vl_alloc_info, hid_t dxpl_id);
+H5_DLL herr_t H5T__vlen_disk_write_batch(const H5T_t *src, const H5T_t *dst,
+    size_t nelmts, size_t s_stride, size_t d_stride, void *buf, const void *bkg,
+    size_t b_stride, hid_t dxpl_id);
 
 /* Array functions */
 H5_DLL H5T_t *H5T__array_create(H5T_t *base, unsigned ndims, const hsize_t dim[/* ndims */]);
@@ -985,6 +985,227 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 }   /* end H5T_vlen_disk_setnull() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T__vlen_disk_read_batch
+ *
+ * Purpose:	Reads NELMTS disk based VL elements from BUF into the memory
+ *		based VL type DST, in place.  All heap IDs are decoded up
+ *		front and the sequences are fetched with a single
+ *		H5HG_read_batch() call into one temporary buffer, so each
+ *		global heap collection is protected once instead of once
+ *		per element.  The base types of SRC and DST must not need
+ *		conversion.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5T__vlen_disk_read_batch(const H5T_t *src, const H5T_t *dst, size_t nelmts,
+    size_t s_stride, size_t d_stride, void *buf,
+    const H5T_vlen_alloc_info_t *vl_alloc_info, hid_t dxpl_id)
+{
+    H5F_t       *f = src->shared->u.vlen.f;     /* File the sequences are in */
+    H5HG_t      *hobjs = NULL;          /* Heap ID of each element */
+    size_t      *seq_lens = NULL;       /* Sequence length of each element */
+    H5HG_t      *rd_hobjs = NULL;       /* Heap IDs of the non-nil sequences */
+    void        **rd_bufs = NULL;       /* Destinations of the non-nil sequences */
+    size_t      *rd_sizes = NULL;       /* Sizes of the non-nil sequences */
+    uint8_t     *seq_buf = NULL;        /* Buffer holding all the sequences */
+    size_t      seq_buf_size = 0;       /* Size of sequence buffer */
+    size_t      base_size;              /* Size of the base type */
+    size_t      nobjs = 0;              /* Number of non-nil sequences */
+    uint8_t     *p;                     /* Pointer into element buffer */
+    size_t      u, v;                   /* Local index variables */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    /* check parameters */
+    HDassert(src && H5T_LOC_DISK == src->shared->u.vlen.loc);
+    HDassert(dst && H5T_LOC_MEMORY == dst->shared->u.vlen.loc);
+    HDassert(buf);
+    HDassert(f);
+
+    base_size = H5T_get_size(dst->shared->parent);
+
+    if(NULL == (hobjs = (H5HG_t *)H5MM_malloc(nelmts * sizeof(H5HG_t))) ||
+            NULL == (seq_lens = (size_t *)H5MM_malloc(nelmts * sizeof(size_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for VL batch")
+
+    /* Decode every heap ID before the destination overwrites any of them */
+    for(u = 0, p = (uint8_t *)buf; u < nelmts; u++, p += s_stride) {
+        const uint8_t *vl = p;
+
+        UINT32DECODE(vl, seq_lens[u]);
+        H5F_addr_decode(f, &vl, &(hobjs[u].addr));
+        UINT32DECODE(vl, hobjs[u].idx);
+
+        if(hobjs[u].addr > 0) {
+            seq_buf_size += seq_lens[u] * base_size;
+            nobjs++;
+        } /* end if */
+    } /* end for */
+
+    /* Fetch all the sequences at once */
+    if(nobjs > 0) {
+        if(NULL == (rd_hobjs = (H5HG_t *)H5MM_malloc(nobjs * sizeof(H5HG_t))) ||
+                NULL == (rd_bufs = (void **)H5MM_malloc(nobjs * sizeof(void *))) ||
+                NULL == (rd_sizes = (size_t *)H5MM_malloc(nobjs * sizeof(size_t))) ||
+                NULL == (seq_buf = (uint8_t *)H5MM_malloc(MAX(seq_buf_size, 1))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for VL batch")
+
+        for(u = 0, v = 0, p = seq_buf; u < nelmts; u++)
+            if(hobjs[u].addr > 0) {
+                rd_hobjs[v] = hobjs[u];
+                rd_bufs[v] = p;
+                rd_sizes[v] = seq_lens[u] * base_size;
+                p += rd_sizes[v];
+                v++;
+            } /* end if */
+
+        if(H5HG_read_batch(f, dxpl_id, nobjs, rd_hobjs, rd_bufs, rd_sizes) < 0)
+            HGOTO_ERROR(H5E_DATATYPE, H5E_READERROR, FAIL, "Unable to read VL information")
+    } /* end if */
+
+    /* Write the sequences to their destination locations */
+    for(u = 0, v = 0, p = (uint8_t *)buf; u < nelmts; u++, p += d_stride)
+        if(hobjs[u].addr > 0) {
+            if((*(dst->shared->u.vlen.write))(NULL, dxpl_id, vl_alloc_info, p, rd_bufs[v], NULL, seq_lens[u], base_size) < 0)
+                HGOTO_ERROR(H5E_DATATYPE, H5E_WRITEERROR, FAIL, "can't write VL data")
+            v++;
+        } /* end if */
+        else {
+            if((*(dst->shared->u.vlen.setnull))(NULL, dxpl_id, p, NULL) < 0)
+                HGOTO_ERROR(H5E_DATATYPE, H5E_WRITEERROR, FAIL, "can't set VL data to 'nil'")
+        } /* end else */
+
+done:
+    H5MM_xfree(hobjs);
+    H5MM_xfree(seq_lens);
+    H5MM_xfree(rd_hobjs);
+    H5MM_xfree(rd_bufs);
+    H5MM_xfree(rd_sizes);
+    H5MM_xfree(seq_buf);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+}   /* end H5T__vlen_disk_read_batch() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T__vlen_disk_write_batch
+ *
+ * Purpose:	Writes NELMTS memory based VL elements from BUF to the disk
+ *		based VL type DST, in place.  The sequences are inserted
+ *		into the global heap with a single H5HG_insert_batch()
+ *		call, which packs them into as few collections as possible.
+ *		Heap objects for the old data in the background buffer BKG,
+ *		if any, are released.  The base types of SRC and DST must
+ *		not need conversion.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5T__vlen_disk_write_batch(const H5T_t *src, const H5T_t *dst, size_t nelmts,
+    size_t s_stride, size_t d_stride, void *buf, const void *bkg, size_t b_stride,
+    hid_t dxpl_id)
+{
+    H5F_t       *f = dst->shared->u.vlen.f;     /* File to write the sequences to */
+    H5HG_t      *hobjs = NULL;          /* Heap ID of each element */
+    size_t      *seq_lens = NULL;       /* Sequence length of each element */
+    H5HG_t      *wr_hobjs = NULL;       /* Heap IDs of the non-nil sequences */
+    void        **wr_bufs = NULL;       /* Sources of the non-nil sequences */
+    size_t      *wr_sizes = NULL;       /* Sizes of the non-nil sequences */
+    size_t      base_size;              /* Size of the base type */
+    size_t      nobjs = 0;              /* Number of non-nil sequences */
+    uint8_t     *p;                     /* Pointer into element buffer */
+    size_t      u, v;                   /* Local index variables */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    /* check parameters */
+    HDassert(src && H5T_LOC_MEMORY == src->shared->u.vlen.loc);
+    HDassert(dst && H5T_LOC_DISK == dst->shared->u.vlen.loc);
+    HDassert(buf);
+    HDassert(f);
+
+    base_size = H5T_get_size(dst->shared->parent);
+
+    if(NULL == (hobjs = (H5HG_t *)H5MM_malloc(nelmts * sizeof(H5HG_t))) ||
+            NULL == (seq_lens = (size_t *)H5MM_malloc(nelmts * sizeof(size_t))) ||
+            NULL == (wr_hobjs = (H5HG_t *)H5MM_malloc(nelmts * sizeof(H5HG_t))) ||
+            NULL == (wr_bufs = (void **)H5MM_malloc(nelmts * sizeof(void *))) ||
+            NULL == (wr_sizes = (size_t *)H5MM_malloc(nelmts * sizeof(size_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for VL batch")
+
+    /* Gather every sequence before the destination overwrites any of them */
+    for(u = 0, p = (uint8_t *)buf; u < nelmts; u++, p += s_stride) {
+        if((*(src->shared->u.vlen.isnull))(NULL, p)) {
+            hobjs[u].addr = 0;
+            seq_lens[u] = 0;
+        } /* end if */
+        else {
+            ssize_t sseq_len;       /* (signed) The number of elements in the sequence */
+
+            if((sseq_len = (*(src->shared->u.vlen.getlen))(p)) < 0)
+                HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "incorrect length")
+            seq_lens[u] = (size_t)sseq_len;
+            if(NULL == (wr_bufs[nobjs] = (*(src->shared->u.vlen.getptr))(p)))
+                HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "invalid source pointer")
+            wr_sizes[nobjs] = seq_lens[u] * base_size;
+            hobjs[u].addr = HADDR_UNDEF;
+            nobjs++;
+        } /* end else */
+    } /* end for */
+
+    /* Free heap objects for old data */
+    if(bkg != NULL) {
+        const uint8_t *bg;      /* Pointer into background buffer */
+
+        for(u = 0, bg = (const uint8_t *)bkg; u < nelmts; u++, bg += b_stride) {
+            const uint8_t *vl = bg + 4;     /* Skip the length of the sequence */
+            H5HG_t bg_hobjid;               /* "Background" VL info sequence's ID info */
+
+            H5F_addr_decode(f, &vl, &(bg_hobjid.addr));
+            UINT32DECODE(vl, bg_hobjid.idx);
+            if(bg_hobjid.addr > 0)
+                if(H5HG_remove(f, dxpl_id, &bg_hobjid) < 0)
+                    HGOTO_ERROR(H5E_DATATYPE, H5E_WRITEERROR, FAIL, "Unable to remove heap object")
+        } /* end for */
+    } /* end if */
+
+    /* Write the VL information to disk (allocates space also) */
+    if(nobjs > 0 && H5HG_insert_batch(f, dxpl_id, nobjs, wr_sizes, wr_bufs, wr_hobjs) < 0)
+        HGOTO_ERROR(H5E_DATATYPE, H5E_WRITEERROR, FAIL, "Unable to write VL information")
+
+    /* Encode the heap information */
+    for(u = 0, v = 0, p = (uint8_t *)buf; u < nelmts; u++, p += d_stride) {
+        uint8_t *vl = p;
+
+        if(0 != hobjs[u].addr)
+            hobjs[u] = wr_hobjs[v++];
+        else
+            hobjs[u].idx = 0;
+
+        UINT32ENCODE(vl, seq_lens[u]);
+        H5F_addr_encode(f, &vl, hobjs[u].addr);
+        UINT32ENCODE(vl, hobjs[u].idx);
+    } /* end for */
+
+done:
+    H5MM_xfree(hobjs);
+    H5MM_xfree(seq_lens);
+    H5MM_xfree(wr_hobjs);
+    H5MM_xfree(wr_bufs);
+    H5MM_xfree(wr_sizes);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+}   /* end H5T__vlen_disk_write_batch() */
+
 
 /*--------------------------------------------------------------------------
  NAME
@@ -26,6 +26,7 @@
 #include "H5Pprivate.h"         /* Property lists                       */
 #include "H5PLprivate.h"        /* Plugins                              */
 #include "H5Sprivate.h"		/* Dataspace functions			*/
+#include "H5TSprivate.h"	/* Threads				*/
 #include "H5Zpkg.h"		/* Data filters				*/
 
 #ifdef H5_HAVE_SZLIB_H
@@ -48,6 +49,22 @@ typedef struct H5Z_object_t {
     htri_t       found;         /* Whether we find an object using the filter */
 } H5Z_object_t;
 
+/* User data for H5Z_pipeline_multi() job callback */
+typedef struct H5Z_pipeline_multi_ud_t {
+    const H5O_pline_t *pline;   /* Filter pipeline to apply                   */
+    unsigned    flags;          /* Pipeline flags (direction, etc.)           */
+    H5Z_EDC_t   edc_read;       /* Error detection setting for reads          */
+    H5Z_cb_t    cb_struct;      /* Filter failure callback                    */
+    H5Z_pipeline_job_t *jobs;   /* Array of jobs to process                   */
+} H5Z_pipeline_multi_ud_t;
+
+/* Buffers being processed in the background */
+struct H5Z_pipeline_multi_t {
+    H5Z_pipeline_multi_ud_t udata; /* User data for job callback              */
+    H5TS_task_t *task;          /* Background tasks, NULL if already done     */
+    herr_t      status;         /* Outcome, when the jobs are already done    */
+};
+
 /* Enumerated type for dataset creation prelude callbacks */
 typedef enum {
     H5Z_PRELUDE_CAN_APPLY,      /* Call "can apply" callback */
@@ -70,6 +87,9 @@ static int H5Z_find_idx(H5Z_filter_t id);
 static int H5Z__check_unregister_dset_cb(void *obj_ptr, hid_t obj_id, void *key);
 static int H5Z__check_unregister_group_cb(void *obj_ptr, hid_t obj_id, void *key);
 static int H5Z__flush_file_cb(void *obj_ptr, hid_t obj_id, void *key);
+static herr_t H5Z__pipeline_multi_cb(size_t idx, void *_udata);
+static herr_t H5Z__pipeline_multi_nthreads(const H5O_pline_t *pline,
+    unsigned *nthreads);
 
 
 /*-------------------------------------------------------------------------
@@ -1432,6 +1452,224 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 }
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z__pipeline_multi_cb
+ *
+ * Purpose:	Runs one job of H5Z_pipeline_multi() through the pipeline.
+ *		May be called from a worker thread.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5Z__pipeline_multi_cb(size_t idx, void *_udata)
+{
+    H5Z_pipeline_multi_ud_t *udata = (H5Z_pipeline_multi_ud_t *)_udata;
+    H5Z_pipeline_job_t *job = &udata->jobs[idx];
+
+    /* Skip empty jobs */
+    if(NULL == job->buf) {
+        job->status = SUCCEED;
+        return SUCCEED;
+    } /* end if */
+
+    job->status = H5Z_pipeline(udata->pline, udata->flags, &job->filter_mask,
+            udata->edc_read, udata->cb_struct, &job->nbytes, &job->buf_size,
+            &job->buf);
+
+    return job->status;
+} /* end H5Z__pipeline_multi_cb() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z__pipeline_multi_nthreads
+ *
+ * Purpose:	Limit the number of threads used to process buffers through
+ *		a pipeline.  NTHREADS is set to zero when the pipeline must
+ *		run serially on the calling thread: if any filter in it
+ *		isn't registered yet (so that plugins are loaded and errors
+ *		are reported on the calling thread), or if the library has
+ *		been built with debugging features that keep unprotected
+ *		global state on the filter path.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5Z__pipeline_multi_nthreads(const H5O_pline_t *pline, unsigned *nthreads)
+{
+    htri_t avail;                       /* Whether all the filters are available */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    HDassert(pline);
+    HDassert(nthreads);
+
+    /* Only use worker threads when every filter is already registered */
+    if((avail = H5Z_all_filters_avail(pline)) < 0)
+        HGOTO_ERROR(H5E_PLINE, H5E_CANTGET, FAIL, "can't check filter availability")
+    if(!avail)
+        *nthreads = 0;
+#if defined(H5_HAVE_CODESTACK) || defined(H5_MEMORY_ALLOC_SANITY_CHECK) || defined(H5Z_DEBUG)
+    /* These features track global state that the filter path updates */
+    *nthreads = 0;
+#endif /* defined(H5_HAVE_CODESTACK) || defined(H5_MEMORY_ALLOC_SANITY_CHECK) || defined(H5Z_DEBUG) */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5Z__pipeline_multi_nthreads() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z_pipeline_multi
+ *
+ * Purpose:	Process several independent buffers through the filter
+ *		pipeline, using up to NTHREADS threads.  Each job is
+ *		processed exactly as H5Z_pipeline() would, with the job's
+ *		status recording the outcome for that buffer.  Jobs with a
+ *		NULL buffer are skipped.
+ *
+ *		The pipeline runs serially when threads can't be used
+ *		safely (see H5Z__pipeline_multi_nthreads).
+ *
+ *		Note that the filter callbacks, and the application's
+ *		filter failure callback in CB_STRUCT, may be invoked from
+ *		threads other than the calling thread.
+ *
+ * Return:	Non-negative on success/Negative if any job failed
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Z_pipeline_multi(const H5O_pline_t *pline, unsigned flags,
+    H5Z_EDC_t edc_read, H5Z_cb_t cb_struct, unsigned nthreads,
+    size_t njobs, H5Z_pipeline_job_t *jobs)
+{
+    H5Z_pipeline_multi_ud_t udata;      /* User data for job callback */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    HDassert(pline);
+    HDassert(0 == (flags & ~((unsigned)H5Z_FLAG_INVMASK)));
+    HDassert(jobs || 0 == njobs);
+
+    if(H5Z__pipeline_multi_nthreads(pline, &nthreads) < 0)
+        HGOTO_ERROR(H5E_PLINE, H5E_CANTGET, FAIL, "can't determine # of threads for pipeline")
+
+    /* Set up user data for job callback */
+    udata.pline = pline;
+    udata.flags = flags;
+    udata.edc_read = edc_read;
+    udata.cb_struct = cb_struct;
+    udata.jobs = jobs;
+
+    /* Filter the buffers */
+    if(H5TS_task_run(nthreads, njobs, H5Z__pipeline_multi_cb, &udata) < 0)
+        HGOTO_ERROR(H5E_PLINE, H5E_CANTFILTER, FAIL, "filter pipeline failed for one or more buffers")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5Z_pipeline_multi() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z_pipeline_multi_start
+ *
+ * Purpose:	Start processing several independent buffers through the
+ *		filter pipeline in the background, on up to NTHREADS worker
+ *		threads, as H5Z_pipeline_multi() would.  The calling thread
+ *		may carry on with other work, but must not touch the jobs,
+ *		or modify PLINE, until H5Z_pipeline_multi_wait() is called.
+ *
+ *		When threads can't be used safely, the buffers are processed
+ *		before returning.
+ *
+ * Return:	Success:	Handle to wait for the buffers with
+ *		Failure:	NULL
+ *
+ *-------------------------------------------------------------------------
+ */
+H5Z_pipeline_multi_t *
+H5Z_pipeline_multi_start(const H5O_pline_t *pline, unsigned flags,
+    H5Z_EDC_t edc_read, H5Z_cb_t cb_struct, unsigned nthreads,
+    size_t njobs, H5Z_pipeline_job_t *jobs)
+{
+    H5Z_pipeline_multi_t *multi = NULL;         /* Handle for the buffers */
+    H5Z_pipeline_multi_t *ret_value = NULL;     /* Return value */
+
+    FUNC_ENTER_NOAPI(NULL)
+
+    HDassert(pline);
+    HDassert(0 == (flags & ~((unsigned)H5Z_FLAG_INVMASK)));
+    HDassert(jobs || 0 == njobs);
+
+    if(H5Z__pipeline_multi_nthreads(pline, &nthreads) < 0)
+        HGOTO_ERROR(H5E_PLINE, H5E_CANTGET, NULL, "can't determine # of threads for pipeline")
+
+    if(NULL == (multi = (H5Z_pipeline_multi_t *)H5MM_malloc(sizeof(H5Z_pipeline_multi_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, NULL, "memory allocation failed for pipeline jobs")
+
+    /* Set up user data for job callback */
+    multi->udata.pline = pline;
+    multi->udata.flags = flags;
+    multi->udata.edc_read = edc_read;
+    multi->udata.cb_struct = cb_struct;
+    multi->udata.jobs = jobs;
+    multi->task = NULL;
+    multi->status = SUCCEED;
+
+    /* Start filtering the buffers, or just filter them now */
+    if(nthreads > 0)
+        multi->task = H5TS_task_start(nthreads, njobs, H5Z__pipeline_multi_cb, &multi->udata);
+    if(NULL == multi->task)
+        multi->status = H5TS_task_run(0, njobs, H5Z__pipeline_multi_cb, &multi->udata);
+
+    ret_value = multi;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5Z_pipeline_multi_start() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z_pipeline_multi_wait
+ *
+ * Purpose:	Wait for the buffers started with H5Z_pipeline_multi_start()
+ *		to be processed, then release MULTI.  Each job's status
+ *		records the outcome for its buffer.
+ *
+ * Return:	Non-negative on success/Negative if any job failed
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Z_pipeline_multi_wait(H5Z_pipeline_multi_t *multi)
+{
+    herr_t status;                      /* Outcome of processing the buffers */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    HDassert(multi);
+
+    if(multi->task)
+        status = H5TS_task_wait(multi->task);
+    else
+        status = multi->status;
+    H5MM_xfree(multi);
+
+    if(status < 0)
+        HGOTO_ERROR(H5E_PLINE, H5E_CANTFILTER, FAIL, "filter pipeline failed for one or more buffers")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5Z_pipeline_multi_wait() */
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5Z_filter_info
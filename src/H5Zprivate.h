@@ -61,6 +61,18 @@ typedef struct H5Z_filter_info_t {
     unsigned		*cd_values;	/*client data values		     */
 } H5Z_filter_info_t;
 
+/* A buffer to process with H5Z_pipeline_multi() */
+typedef struct H5Z_pipeline_job_t {
+    unsigned	filter_mask;	/* Excluded filters (in/out)		     */
+    size_t	nbytes;		/* Number of valid bytes in buffer (in/out)  */
+    size_t	buf_size;	/* Allocated size of buffer (in/out)	     */
+    void	*buf;		/* Buffer to filter, NULL to skip (in/out)   */
+    herr_t	status;		/* Outcome of filtering this buffer (out)    */
+} H5Z_pipeline_job_t;
+
+/* Buffers being processed in the background by H5Z_pipeline_multi_start() (opaque) */
+typedef struct H5Z_pipeline_multi_t H5Z_pipeline_multi_t;
+
 /*****************************/
 /* Library-private Variables */
 /*****************************/
@@ -83,6 +95,15 @@ H5_DLL herr_t H5Z_pipeline(const struct H5O_pline_t *pline,
  			    H5Z_EDC_t edc_read, H5Z_cb_t cb_struct,
 			    size_t *nbytes/*in,out*/, size_t *buf_size/*in,out*/,
                             void **buf/*in,out*/);
+H5_DLL herr_t H5Z_pipeline_multi(const struct H5O_pline_t *pline,
+                            unsigned flags, H5Z_EDC_t edc_read,
+                            H5Z_cb_t cb_struct, unsigned nthreads,
+                            size_t njobs, H5Z_pipeline_job_t *jobs/*in,out*/);
+H5_DLL H5Z_pipeline_multi_t *H5Z_pipeline_multi_start(const struct H5O_pline_t *pline,
+                            unsigned flags, H5Z_EDC_t edc_read,
+                            H5Z_cb_t cb_struct, unsigned nthreads,
+                            size_t njobs, H5Z_pipeline_job_t *jobs/*in,out*/);
+H5_DLL herr_t H5Z_pipeline_multi_wait(H5Z_pipeline_multi_t *multi);
 H5_DLL H5Z_class2_t *H5Z_find(H5Z_filter_t id);
 H5_DLL herr_t H5Z_can_apply(hid_t dcpl_id, hid_t type_id);
 H5_DLL herr_t H5Z_set_local(hid_t dcpl_id, hid_t type_id);
@@ -333,6 +333,33 @@ typedef struct H5_ih_info_t {
     hsize_t     heap_size;
 } H5_ih_info_t;
 
+/*
+ * Kinds of free lists the library keeps, for H5_free_list_info_t
+ */
+typedef enum H5_free_list_type_t {
+    H5_FREE_LIST_REG,           /* Objects of one fixed-size type       */
+    H5_FREE_LIST_ARR,           /* Arrays of a type, up to a maximum length */
+    H5_FREE_LIST_BLK,           /* Blocks (and sequences) of any size   */
+    H5_FREE_LIST_FAC            /* Factory for blocks of a size chosen at runtime */
+} H5_free_list_type_t;
+
+/*
+ * Memory use of a free list, reported by H5iterate_free_lists()
+ */
+typedef struct H5_free_list_info_t {
+    const char *name;           /* Name of the list's type (NULL for factories) */
+    H5_free_list_type_t type;   /* Kind of free list                    */
+    size_t nalloc;              /* # of blocks allocated, in use or free */
+    size_t alloc_size;          /* Bytes in allocated blocks            */
+    size_t peak_alloc_size;     /* Largest value of alloc_size so far   */
+    size_t nfree;               /* # of blocks on the free list         */
+    size_t free_size;           /* Bytes in blocks on the free list     */
+} H5_free_list_info_t;
+
+/* Typedef for H5iterate_free_lists() callbacks */
+typedef herr_t (*H5_free_list_operator_t)(const H5_free_list_info_t *info,
+    void *op_data);
+
 /* Functions in H5.c */
 H5_DLL herr_t H5open(void);
 H5_DLL herr_t H5close(void);
@@ -341,6 +368,9 @@ H5_DLL herr_t H5garbage_collect(void);
 H5_DLL herr_t H5set_free_list_limits (int reg_global_lim, int reg_list_lim,
                 int arr_global_lim, int arr_list_lim, int blk_global_lim,
                 int blk_list_lim);
+H5_DLL herr_t H5get_free_list_sizes(size_t *reg_size, size_t *arr_size,
+                size_t *blk_size, size_t *fac_size);
+H5_DLL herr_t H5iterate_free_lists(H5_free_list_operator_t op, void *op_data);
 H5_DLL herr_t H5get_libversion(unsigned *majnum, unsigned *minnum,
 				unsigned *relnum);
 H5_DLL herr_t H5check_version(unsigned majnum, unsigned minnum,
@@ -650,6 +650,7 @@ add_test (
         ttsafe_dcreate.h5
         ttsafe_cancel.h5
         ttsafe_acreate.h5
+        ttsafe_dread.h5
     WORKING_DIRECTORY
         ${HDF5_TEST_BINARY_DIR}/H5TEST
 )
@@ -814,6 +815,7 @@ if (BUILD_SHARED_LIBS)
           ttsafe_dcreate.h5
           ttsafe_cancel.h5
           ttsafe_acreate.h5
+          ttsafe_dread.h5
       WORKING_DIRECTORY
           ${HDF5_TEST_BINARY_DIR}/H5TEST-shared
   )
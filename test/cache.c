@@ -205,6 +205,7 @@ static void cedds__H5C_flush_invalidate_cache__bucket_scan(H5F_t * file_ptr);
 static unsigned check_stats(void);
 #if H5C_COLLECT_CACHE_STATS
 static void check_stats__smoke_check_1(H5F_t * file_ptr);
+static void check_stats__flush_writes(H5F_t * file_ptr);
 #endif /* H5C_COLLECT_CACHE_STATS */
 
 
@@ -33293,7 +33294,7 @@ cedds__expunge_dirty_entry_in_flush_test(H5F_t * file_ptr)
 
 	if ( ( cache_ptr->slist_scan_restarts != 1 ) ||
              ( cache_ptr->LRU_scan_restarts != 0 ) ||
-             ( cache_ptr->hash_bucket_scan_restarts != 0 ) ) {
+             ( cache_ptr->index_scan_restarts != 0 ) ) {
 
             pass = FALSE;
             failure_mssg = "unexpected scan restart stats in cedds__expunge_dirty_entry_in_flush_test().";
@@ -33681,7 +33682,7 @@ cedds__H5C_make_space_in_cache(H5F_t * file_ptr)
 
 	if ( ( cache_ptr->slist_scan_restarts != 0 ) ||
              ( cache_ptr->LRU_scan_restarts != 1 ) ||
-             ( cache_ptr->hash_bucket_scan_restarts != 0 ) ) {
+             ( cache_ptr->index_scan_restarts != 0 ) ) {
 
             pass = FALSE;
             failure_mssg = "unexpected scan restart stats in cedds__H5C_make_space_in_cache().";
@@ -34098,7 +34099,7 @@ cedds__H5C__autoadjust__ageout__evict_aged_out_entries(H5F_t * file_ptr)
 
 	if ( ( cache_ptr->slist_scan_restarts != 0 ) ||
              ( cache_ptr->LRU_scan_restarts != 1 ) ||
-             ( cache_ptr->hash_bucket_scan_restarts != 0 ) ) {
+             ( cache_ptr->index_scan_restarts != 0 ) ) {
 
             pass = FALSE;
             failure_mssg = "unexpected scan restart stats in cedds__H5C__autoadjust__ageout__evict_aged_out_entries().";
@@ -34127,59 +34128,51 @@ cedds__H5C__autoadjust__ageout__evict_aged_out_entries(H5F_t * file_ptr)
  *
  * Purpose:	Verify that H5C_flush_invalidate_cache() can handle
  *		the removal from the cache of the next item in 
- *		its scans of hash buckets.
+ *		its scans of the index list.
  *
  *		!!!!!!!!!! WARNING !!!!!!!!!!
  *
- *		This test may fail to function correctly if the hash 
- *		table size or hash function is altered.  
- *
  *		To setup the test, this function depends on the fact that 
  *		H5C_flush_invalidate_cache() does alternating scans of the
  *		slist and the index.  If this changes, the test will likely
  *		also cease to function correctly.
  *
- *		The test relies on a known hash function and hash table 
- *		size to select a set of test entries that will all hash 
- *		to the same hash bucket -- call it the test hash bucket.  
- *		It also relies on known behavior of the cache to place 
- *		the entries in the test bucket in a known order.
- *
- *		To avoid pre-mature flushes of the entries in the 
- *		test hash bucket, all entries are initially clean,
- *		with the exception of the first entry which is dirty.
- *		It avoids premature flushing by being the parent in 
- *		a flush dependency.  The first entry in the test bucket
- *		also has a flush op which expunges the second entry --
- *		setting up the failure.
- *
- *		An additional dirty entry is added (which must hash
- *		to a different bucket, and must have a higher address 
- *		than at least the first entry in the test hash bucket.
- *		This entry is the child in a flush dependency with the 
- *		first entry in the above hash bucket, and contains
- *		a flush op to destroy this flush dependency. 
- *
- *		Since the first entry in the test hash bucket has a lower
- *		address that the other dirty entry, the scan of the 
- *		slist encounters it first, and passes over it because 
- *		it has a flush dependency height of 1.
+ *		The test relies on the index list holding the entries in
+ *		the order of their insertion into the cache, to place the
+ *		test entries in a known order.
+ *
+ *		To avoid pre-mature flushes of the test entries, all 
+ *		entries are initially clean, with the exception of the 
+ *		first entry which is dirty.  It avoids premature flushing
+ *		by being the parent in a flush dependency.  The first 
+ *		entry also has a flush op which expunges the second
+ *		entry -- which follows it in the index list, setting up
+ *		the failure.
+ *
+ *		An additional dirty entry is added last (which must have
+ *		a higher address than the first entry).  This entry is 
+ *		the child in a flush dependency with the first entry,
+ *		and contains a flush op to destroy this flush dependency. 
+ *
+ *		Since the first entry has a lower address that the other
+ *		dirty entry, the scan of the slist encounters it first, 
+ *		and passes over it because it has a flush dependency 
+ *		height of 1.
  *
  *		The scan then encounters the second dirty entry and flushes
  *		it -- causing it to destroy the flush dependency and thus 
- *		reducing the flush dependency height of the first entry in 
- *		the test hash bucket to zero.
+ *		reducing the flush dependency height of the first entry 
+ *		to zero.
  *
  *		After completing a scan of the slist, 
  *		H5C_flush_invalidate_cache() then scans the index,
  *		flushing all entries of flush dependency height zero.
  *
  *		This sets up the potential error when the first entry
- *		in the test hash bucket is flushed -- expunging the 
- *		second entry as a side effect.  If 
- *		H5C_flush_invalidate_cache() fails to detect this, 
- *		it will attempt to continue its scan of the bucket with
- *		an entry that has been deleted from the cache.
+ *		is flushed -- expunging the second entry as a side
+ *		effect.  If H5C_flush_invalidate_cache() fails to detect
+ *		this, it will attempt to continue its scan of the index
+ *		list with an entry that has been deleted from the cache.
  *
  *              Do nothing if pass is FALSE on entry.
  *
@@ -34200,9 +34193,7 @@ cedds__H5C_flush_invalidate_cache__bucket_scan(H5F_t * file_ptr)
 {
     H5C_t *                    cache_ptr = file_ptr->shared->cache;
     int		               i;
-    int		               expected_hash_bucket = 0;
     herr_t	               result;
-    haddr_t                    entry_addr;
     test_entry_t *             entry_ptr;
     test_entry_t *             base_addr = NULL;
     struct H5C_cache_entry_t * scan_ptr;
@@ -34262,8 +34253,8 @@ cedds__H5C_flush_invalidate_cache__bucket_scan(H5F_t * file_ptr)
 	H5C_stats__reset(cache_ptr);
 
 
-	/* load one dirty and three clean entries that should hash to the 
-         * same hash bucket.  
+	/* load one dirty and three clean entries, that will be adjacent
+         * in the index list.
          */
 
         protect_entry(file_ptr, MONSTER_ENTRY_TYPE, 0);
@@ -34276,29 +34267,7 @@ cedds__H5C_flush_invalidate_cache__bucket_scan(H5F_t * file_ptr)
 	}
     }
 
-    if ( pass ) {
-
-        /* verify that the above entries hash to the same bucket */
-        base_addr = entries[MONSTER_ENTRY_TYPE];
-        entry_ptr = &(base_addr[0]);
-        entry_addr = entry_ptr->header.addr;
-
-        HDassert(entry_addr == entry_ptr->addr);
-
-        expected_hash_bucket = H5C__HASH_FCN(entry_addr);
-
-        for ( i = 8; i <= 24; i += 8 ) {
-        
-            entry_ptr = &(base_addr[i]);
-            entry_addr = entry_ptr->header.addr;
-
-            if ( expected_hash_bucket != H5C__HASH_FCN(entry_addr) ) {
-
-                pass = FALSE;
-                failure_mssg = "Test entries don't map to same bucket -- hash table size or hash fcn change?";
-            }
-        }
-    }
+    base_addr = entries[MONSTER_ENTRY_TYPE];
 
     if ( pass ) {
 
@@ -34322,22 +34291,6 @@ cedds__H5C_flush_invalidate_cache__bucket_scan(H5F_t * file_ptr)
 	unprotect_entry(file_ptr, MONSTER_ENTRY_TYPE, 31, H5C__DIRTIED_FLAG);
     }
 
-    if ( pass ) {
-
-        /* verify that the dirty entry doesn't map to the same 
-         * hash bucket as the clean entries.
-         */
-
-        entry_ptr = &(base_addr[31]);
-        entry_addr = entry_ptr->header.addr;
-
-        if ( expected_hash_bucket == H5C__HASH_FCN(entry_addr) ) {
-
-            pass = FALSE;
-            failure_mssg = "Dirty entry maps to same hash bucket as clean entries?!?!";
-        }
-    }
-
     if ( pass ) {
 
 	/* Next, create the flush dependency requiring (MET, 31) to 
@@ -34371,50 +34324,41 @@ cedds__H5C_flush_invalidate_cache__bucket_scan(H5F_t * file_ptr)
 
     if ( pass ) {
 
-        /* now do some protect / unprotect cycles to force the 
-         * entries into the desired order in the hash bucket.
-         * Recall that entries are moved to the head of the 
-         * hash bucket list on lookup.
-         */
-
-	for ( i = 24; i >= 0; i -= 8 )
-	{
-	    protect_entry(file_ptr, MONSTER_ENTRY_TYPE, i);
-            unprotect_entry(file_ptr, MONSTER_ENTRY_TYPE, i, H5C__NO_FLAGS_SET);
-	}
-    }
-
-    if ( pass ) {
-
-        /* scan the hash bucket to verify that the expected entries appear
-         * in the expected order.
+        /* scan the index list to verify that the expected entries appear
+         * in the expected order -- that of their insertion into the 
+         * cache, so that (MET, 8) follows (MET, 0).
          */
-        scan_ptr = cache_ptr->index[expected_hash_bucket];
+        scan_ptr = cache_ptr->il_head;
 
         i = 0;
 
-        while ( ( pass ) && ( i <= 24 ) )
+        while ( ( pass ) && ( i < 5 ) )
 	{
-            entry_ptr = &(base_addr[i]);
+            entry_ptr = &(base_addr[expected[i].entry_index]);
 
             if ( scan_ptr == NULL ) {
 
                 pass = FALSE;
-                failure_mssg = "premature end of hash bucket list?!?!";
+                failure_mssg = "premature end of index list?!?!";
 
-            } else if ( ( scan_ptr == NULL ) ||
-                        ( scan_ptr != &(entry_ptr->header) ) ) {
+            } else if ( scan_ptr != &(entry_ptr->header) ) {
 
                 pass = FALSE;
-                failure_mssg = "bad test hash bucket setup?!?!";
+                failure_mssg = "bad test index list setup?!?!";
             }
 
             if ( pass ) {
 
-                scan_ptr = scan_ptr->ht_next;
-                i += 8;
+                scan_ptr = scan_ptr->il_next;
+                i++;
             }
 	}
+
+        if ( ( pass ) && ( scan_ptr != NULL ) ) {
+
+            pass = FALSE;
+            failure_mssg = "unexpected entries in index list?!?!";
+        }
     }
 
 
@@ -34473,7 +34417,7 @@ cedds__H5C_flush_invalidate_cache__bucket_scan(H5F_t * file_ptr)
 
 	if ( ( cache_ptr->slist_scan_restarts != 0 ) ||
              ( cache_ptr->LRU_scan_restarts != 0 ) ||
-             ( cache_ptr->hash_bucket_scan_restarts != 1 ) ) {
+             ( cache_ptr->index_scan_restarts != 1 ) ) {
 
             pass = FALSE;
             failure_mssg = "unexpected scan restart stats in cedds__H5C_flush_invalidate_cache__bucket_scan().";
@@ -34544,6 +34488,11 @@ check_stats(void)
         check_stats__smoke_check_1(file_ptr);
     }
 
+    if ( pass ) {
+
+        check_stats__flush_writes(file_ptr);
+    }
+
 
 
     if ( pass ) {
@@ -34683,7 +34632,7 @@ check_stats__smoke_check_1(H5F_t * file_ptr)
              ( cache_ptr->successful_ht_searches != 0 ) ||
              ( cache_ptr->total_successful_ht_search_depth != 0 ) ||
              ( cache_ptr->failed_ht_searches != 32 ) ||
-             ( cache_ptr->total_failed_ht_search_depth != 48 ) ||
+             ( cache_ptr->total_failed_ht_search_depth != 0 ) ||
              ( cache_ptr->max_index_len != 32 ) ||
              ( cache_ptr->max_index_size != 2 * 1024 * 1024 ) ||
              ( cache_ptr->max_clean_index_size != 0 ) ||
@@ -34702,7 +34651,7 @@ check_stats__smoke_check_1(H5F_t * file_ptr)
              ( cache_ptr->entries_scanned_to_make_space != 0 ) ||
              ( cache_ptr->slist_scan_restarts != 0 ) ||
              ( cache_ptr->LRU_scan_restarts != 0 ) ||
-             ( cache_ptr->hash_bucket_scan_restarts != 0 ) ) {
+             ( cache_ptr->index_scan_restarts != 0 ) ) {
 
             pass = FALSE;
             failure_mssg = "Unexpected cache stats in check_stats__smoke_check_1(1).";
@@ -34777,9 +34726,9 @@ check_stats__smoke_check_1(H5F_t * file_ptr)
         if ( ( cache_ptr->total_ht_insertions != 32 ) ||
              ( cache_ptr->total_ht_deletions != 0 ) ||
              ( cache_ptr->successful_ht_searches != 32 ) ||
-             ( cache_ptr->total_successful_ht_search_depth != 96 ) ||
+             ( cache_ptr->total_successful_ht_search_depth != 0 ) ||
              ( cache_ptr->failed_ht_searches != 32 ) ||
-             ( cache_ptr->total_failed_ht_search_depth != 48 ) ||
+             ( cache_ptr->total_failed_ht_search_depth != 0 ) ||
              ( cache_ptr->max_index_len != 32 ) ||
              ( cache_ptr->max_index_size != 2 * 1024 * 1024 ) ||
              ( cache_ptr->max_clean_index_size != 0 ) ||
@@ -34798,7 +34747,7 @@ check_stats__smoke_check_1(H5F_t * file_ptr)
              ( cache_ptr->entries_scanned_to_make_space != 0 ) ||
              ( cache_ptr->slist_scan_restarts != 0 ) ||
              ( cache_ptr->LRU_scan_restarts != 0 ) ||
-             ( cache_ptr->hash_bucket_scan_restarts != 0 ) ) {
+             ( cache_ptr->index_scan_restarts != 0 ) ) {
 
             pass = FALSE;
             failure_mssg = "Unexpected cache stats in check_stats__smoke_check_1(2).";
@@ -34870,9 +34819,9 @@ check_stats__smoke_check_1(H5F_t * file_ptr)
         if ( ( cache_ptr->total_ht_insertions != 33 ) ||
              ( cache_ptr->total_ht_deletions != 1 ) ||
              ( cache_ptr->successful_ht_searches != 32 ) ||
-             ( cache_ptr->total_successful_ht_search_depth != 96 ) ||
+             ( cache_ptr->total_successful_ht_search_depth != 0 ) ||
              ( cache_ptr->failed_ht_searches != 33 ) ||
-             ( cache_ptr->total_failed_ht_search_depth != 52 ) ||
+             ( cache_ptr->total_failed_ht_search_depth != 0 ) ||
              ( cache_ptr->max_index_len != 32 ) ||
              ( cache_ptr->max_index_size != 2 * 1024 * 1024 ) ||
              ( cache_ptr->max_clean_index_size != 2 * 1024 * 1024 ) ||
@@ -34891,7 +34840,7 @@ check_stats__smoke_check_1(H5F_t * file_ptr)
              ( cache_ptr->entries_scanned_to_make_space != 33 ) ||
              ( cache_ptr->slist_scan_restarts != 0 ) ||
              ( cache_ptr->LRU_scan_restarts != 0 ) ||
-             ( cache_ptr->hash_bucket_scan_restarts != 0 ) ) {
+             ( cache_ptr->index_scan_restarts != 0 ) ) {
 
             pass = FALSE;
             failure_mssg = "Unexpected cache stats in check_stats__smoke_check_1(3).";
@@ -34981,9 +34930,13 @@ check_stats__smoke_check_1(H5F_t * file_ptr)
         if ( ( cache_ptr->total_ht_insertions != 33 ) ||
              ( cache_ptr->total_ht_deletions != 33 ) ||
              ( cache_ptr->successful_ht_searches != 33 ) ||
-             ( cache_ptr->total_successful_ht_search_depth != 99 ) ||
+             ( cache_ptr->total_successful_ht_search_depth != 0 ) ||
              ( cache_ptr->failed_ht_searches != 33 ) ||
-             ( cache_ptr->total_failed_ht_search_depth != 52 ) ||
+             ( cache_ptr->total_failed_ht_search_depth != 0 ) ||
+             ( cache_ptr->successful_ht_searches_by_type[MONSTER_ENTRY_TYPE] != 33 ) ||
+             ( cache_ptr->total_ht_search_depth_by_type[MONSTER_ENTRY_TYPE] != 0 ) ||
+             ( cache_ptr->max_ht_search_depth_by_type[MONSTER_ENTRY_TYPE] != 0 ) ||
+             ( cache_ptr->index_resizes != 0 ) ||
              ( cache_ptr->max_index_len != 32 ) ||
              ( cache_ptr->max_index_size != 2 * 1024 * 1024 ) ||
              ( cache_ptr->max_clean_index_size != 2 * 1024 * 1024 ) ||
@@ -35002,7 +34955,7 @@ check_stats__smoke_check_1(H5F_t * file_ptr)
              ( cache_ptr->entries_scanned_to_make_space != 33 ) ||
              ( cache_ptr->slist_scan_restarts != 0 ) ||
              ( cache_ptr->LRU_scan_restarts != 0 ) ||
-             ( cache_ptr->hash_bucket_scan_restarts != 0 ) ) {
+             ( cache_ptr->index_scan_restarts != 0 ) ) {
 
             pass = FALSE;
             failure_mssg = "Unexpected cache stats in check_stats__smoke_check_1(4).";
@@ -35042,6 +34995,172 @@ check_stats__smoke_check_1(H5F_t * file_ptr)
 
 } /* check_stats__smoke_check_1() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	check_stats__flush_writes()
+ *
+ * Purpose:	Verify that H5C_flush_cache() writes the images of the
+ *		entries it flushes in address order, combining images that
+ *		are adjacent in the file into a single write, and that the
+ *		combined writes put the expected images in the file.
+ *
+ *		Do this by dirtying two runs of adjacent monster entries,
+ *		flushing the cache, and checking the flush write stats.
+ *		Then evict the entries and protect them again, so that
+ *		the deserialize callback checks the images read back.
+ *
+ *              Do nothing if pass is FALSE on entry.
+ *
+ * Return:	void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+check_stats__flush_writes(H5F_t * file_ptr)
+{
+    H5C_t *        cache_ptr = file_ptr->shared->cache;
+    int		   i;
+    herr_t	   result;
+
+    if ( pass ) {
+
+        if ( ( cache_ptr == NULL ) ||
+             ( cache_ptr->index_len != 0 ) ) {
+
+            pass = FALSE;
+            failure_mssg = "bad cache on entry to check_stats__flush_writes().";
+
+        } else {
+
+            /* set min clean size to zero, so that no entries are 
+             * flushed to make space as they are inserted.
+             */
+            cache_ptr->min_clean_size = 0;
+
+            H5C_stats__reset(cache_ptr);
+        }
+    }
+
+    if ( pass ) {
+
+        /* insert two runs of dirty monster entries -- 0 to 15, and 
+         * 20 to 23 -- and flush them.
+         */
+        for ( i = 0; i < 16; i++ )
+
+            insert_entry(file_ptr, MONSTER_ENTRY_TYPE, i, H5C__NO_FLAGS_SET);
+
+        for ( i = 20; i < 24; i++ )
+
+            insert_entry(file_ptr, MONSTER_ENTRY_TYPE, i, H5C__NO_FLAGS_SET);
+    }
+
+    if ( pass ) {
+
+        result = H5C_flush_cache(file_ptr, H5AC_ind_read_dxpl_id, H5C__NO_FLAGS_SET);
+
+        if ( result < 0 ) {
+
+            pass = FALSE;
+            failure_mssg = "cache flush failed in check_stats__flush_writes(1).";
+
+        } else if ( ( cache_ptr->index_len != 20 ) ||
+                    ( cache_ptr->slist_len != 0 ) ||
+                    ( cache_ptr->flush_write_list != NULL ) ||
+                    ( cache_ptr->flushes[MONSTER_ENTRY_TYPE] != 20 ) ||
+                    ( cache_ptr->flush_write_images != 20 ) ||
+                    ( cache_ptr->flush_writes != 2 ) ) {
+
+            pass = FALSE;
+            failure_mssg = "Unexpected flush write stats in check_stats__flush_writes(1).";
+        }
+    }
+
+    if ( pass ) {
+
+        /* dirty a single entry, and flush again */
+	protect_entry(file_ptr, MONSTER_ENTRY_TYPE, 7);
+	unprotect_entry(file_ptr, MONSTER_ENTRY_TYPE, 7, H5C__DIRTIED_FLAG);
+    }
+
+    if ( pass ) {
+
+        result = H5C_flush_cache(file_ptr, H5AC_ind_read_dxpl_id, H5C__NO_FLAGS_SET);
+
+        if ( result < 0 ) {
+
+            pass = FALSE;
+            failure_mssg = "cache flush failed in check_stats__flush_writes(2).";
+
+        } else if ( ( cache_ptr->slist_len != 0 ) ||
+                    ( cache_ptr->flushes[MONSTER_ENTRY_TYPE] != 21 ) ||
+                    ( cache_ptr->flush_write_images != 21 ) ||
+                    ( cache_ptr->flush_writes != 3 ) ) {
+
+            pass = FALSE;
+            failure_mssg = "Unexpected flush write stats in check_stats__flush_writes(2).";
+        }
+    }
+
+    if ( pass ) {
+
+        /* evict everything, and load the entries back from the file */
+        result = H5C_flush_cache(file_ptr, H5AC_ind_read_dxpl_id, H5C__FLUSH_INVALIDATE_FLAG);
+
+        if ( ( result < 0 ) || ( cache_ptr->index_len != 0 ) ) {
+
+            pass = FALSE;
+            failure_mssg = "cache flush invalidate failed in check_stats__flush_writes().";
+        }
+    }
+
+    for ( i = 0; ( pass ) && ( i < 24 ); i++ )
+    {
+        if ( ( i < 16 ) || ( i >= 20 ) ) {
+
+	    protect_entry(file_ptr, MONSTER_ENTRY_TYPE, i);
+	    unprotect_entry(file_ptr, MONSTER_ENTRY_TYPE, i, H5C__NO_FLAGS_SET);
+        }
+    }
+
+    if ( pass ) {
+
+        if ( ( cache_ptr->index_len != 20 ) ||
+             ( cache_ptr->misses[MONSTER_ENTRY_TYPE] != 20 ) ||
+             ( cache_ptr->flush_write_images != 21 ) ||
+             ( cache_ptr->flush_writes != 3 ) ) {
+
+            pass = FALSE;
+            failure_mssg = "Unexpected cache stats in check_stats__flush_writes(3).";
+        }
+    }
+
+    if ( pass ) {
+
+        result = H5C_flush_cache(file_ptr, H5AC_ind_read_dxpl_id, H5C__FLUSH_INVALIDATE_FLAG);
+
+        if ( ( result < 0 ) || ( cache_ptr->index_len != 0 ) ) {
+
+            pass = FALSE;
+            failure_mssg = "final cache flush invalidate failed in check_stats__flush_writes().";
+        }
+    }
+
+    if ( pass ) {
+
+	reset_entries();
+    }
+
+    if ( pass ) {
+
+	/* reset cache min clean size to its expected value */
+        cache_ptr->min_clean_size = (1 * 1024 * 1024);
+    }
+
+    return;
+
+} /* check_stats__flush_writes() */
+
 #endif /* H5C_COLLECT_CACHE_STATS */
 
 
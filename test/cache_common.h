@@ -359,20 +359,17 @@ typedef struct test_entry_t
  * updated as necessary.
  */
 
-#define H5C__HASH_MASK          ((size_t)(H5C__HASH_TABLE_LEN - 1) << 3)
-
 #define H5C_TEST__PRE_HT_SEARCH_SC(cache_ptr, Addr)          \
 if ( ( (cache_ptr) == NULL ) ||                              \
      ( (cache_ptr)->magic != H5C__H5C_T_MAGIC ) ||           \
      ( (cache_ptr)->index_size !=                            \
        ((cache_ptr)->clean_index_size + (cache_ptr)->dirty_index_size) ) || \
-     ( ! H5F_addr_defined(Addr) ) ||                         \
-     ( H5C__HASH_FCN(Addr) < 0 ) ||                          \
-     ( H5C__HASH_FCN(Addr) >= H5C__HASH_TABLE_LEN ) ) {      \
+     ( (cache_ptr)->index == NULL ) ||                       \
+     ( ! H5F_addr_defined(Addr) ) ) {                        \
     HDfprintf(stdout, "Pre HT search SC failed.\n");         \
 }
 
-#define H5C_TEST__POST_SUC_HT_SEARCH_SC(cache_ptr, entry_ptr, Addr, k) \
+#define H5C_TEST__POST_SUC_HT_SEARCH_SC(cache_ptr, entry_ptr, Addr, bucket) \
 if ( ( (cache_ptr) == NULL ) ||                                   \
      ( (cache_ptr)->magic != H5C__H5C_T_MAGIC ) ||                \
      ( (cache_ptr)->index_len < 1 ) ||                            \
@@ -382,10 +379,10 @@ if ( ( (cache_ptr) == NULL ) ||                                   \
        ((cache_ptr)->clean_index_size + (cache_ptr)->dirty_index_size) ) || \
      ( H5F_addr_ne((entry_ptr)->addr, (Addr)) ) ||                \
      ( (entry_ptr)->size <= 0 ) ||                                \
-     ( ((cache_ptr)->index)[k] == NULL ) ||                       \
-     ( ( ((cache_ptr)->index)[k] != (entry_ptr) ) &&              \
+     ( *(bucket) == NULL ) ||                                     \
+     ( ( *(bucket) != (entry_ptr) ) &&                            \
        ( (entry_ptr)->ht_prev == NULL ) ) ||                      \
-     ( ( ((cache_ptr)->index)[k] == (entry_ptr) ) &&              \
+     ( ( *(bucket) == (entry_ptr) ) &&                            \
        ( (entry_ptr)->ht_prev != NULL ) ) ||                      \
      ( ( (entry_ptr)->ht_prev != NULL ) &&                        \
        ( (entry_ptr)->ht_prev->ht_next != (entry_ptr) ) ) ||      \
@@ -394,29 +391,27 @@ if ( ( (cache_ptr) == NULL ) ||                                   \
     HDfprintf(stdout, "Post successful HT search SC failed.\n");  \
 }
 
-#define H5C_TEST__POST_HT_SHIFT_TO_FRONT(cache_ptr, entry_ptr, k)      \
+#define H5C_TEST__POST_HT_SHIFT_TO_FRONT(cache_ptr, entry_ptr, bucket) \
 if ( ( (cache_ptr) == NULL ) ||                                        \
-     ( ((cache_ptr)->index)[k] != (entry_ptr) ) ||                     \
+     ( *(bucket) != (entry_ptr) ) ||                                   \
      ( (entry_ptr)->ht_prev != NULL ) ) {                              \
     HDfprintf(stdout, "Post HT shift to front failed.\n");             \
 }
 
 #define H5C_TEST__SEARCH_INDEX(cache_ptr, Addr, entry_ptr)              \
 {                                                                       \
-    int k;                                                              \
-    int depth = 0;                                                      \
+    H5C_cache_entry_t **bucket;                                         \
     H5C_TEST__PRE_HT_SEARCH_SC(cache_ptr, Addr)                         \
-    k = H5C__HASH_FCN(Addr);                                            \
-    entry_ptr = ((cache_ptr)->index)[k];                                \
+    bucket = H5C__INDEX_BUCKET(cache_ptr, Addr);                        \
+    entry_ptr = *bucket;                                                \
     while ( ( entry_ptr ) && ( H5F_addr_ne(Addr, (entry_ptr)->addr) ) ) \
     {                                                                   \
         (entry_ptr) = (entry_ptr)->ht_next;                             \
-        (depth)++;                                                      \
     }                                                                   \
     if ( entry_ptr )                                                    \
     {                                                                   \
-        H5C_TEST__POST_SUC_HT_SEARCH_SC(cache_ptr, entry_ptr, Addr, k)  \
-        if ( entry_ptr != ((cache_ptr)->index)[k] )                     \
+        H5C_TEST__POST_SUC_HT_SEARCH_SC(cache_ptr, entry_ptr, Addr, bucket) \
+        if ( entry_ptr != *bucket )                                     \
         {                                                               \
             if ( (entry_ptr)->ht_next )                                 \
             {                                                           \
@@ -424,11 +419,11 @@ if ( ( (cache_ptr) == NULL ) ||                                        \
             }                                                           \
             HDassert( (entry_ptr)->ht_prev != NULL );                   \
             (entry_ptr)->ht_prev->ht_next = (entry_ptr)->ht_next;       \
-            ((cache_ptr)->index)[k]->ht_prev = (entry_ptr);             \
-            (entry_ptr)->ht_next = ((cache_ptr)->index)[k];             \
+            (*bucket)->ht_prev = (entry_ptr);                           \
+            (entry_ptr)->ht_next = *bucket;                             \
             (entry_ptr)->ht_prev = NULL;                                \
-            ((cache_ptr)->index)[k] = (entry_ptr);                      \
-            H5C_TEST__POST_HT_SHIFT_TO_FRONT(cache_ptr, entry_ptr, k)   \
+            *bucket = (entry_ptr);                                      \
+            H5C_TEST__POST_HT_SHIFT_TO_FRONT(cache_ptr, entry_ptr, bucket) \
         }                                                               \
     }                                                                   \
 }
@@ -0,0 +1,412 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * Copyright by the Board of Trustees of the University of Illinois.         *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of HDF5.  The full HDF5 copyright notice, including     *
+ * terms governing use, modification, and redistribution, is contained in    *
+ * the files COPYING and Copyright.html.  COPYING can be found at the root   *
+ * of the source code distribution tree; Copyright.html can be found at the  *
+ * root level of an installed copy of the electronic HDF5 document set and   *
+ * is linked from the top-level documents page.  It can also be found at     *
+ * http://hdfgroup.org/HDF5/doc/Copyright.html.  If you do not have          *
+ * access to either file, you may request a copy from help@hdfgroup.org.     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/*
+ * Purpose:	Tests for the metadata cache image written when a file is
+ *		closed and loaded when it is reopened.
+ */
+
+#include "h5test.h"
+
+#define H5F_FRIEND		/*suppress error about including H5Fpkg	  */
+#define H5F_TESTING
+#include "H5Fpkg.h"
+
+const char *FILENAME[] = {
+    "cache_image",
+    NULL
+};
+
+#define FILENAME_LEN    1024
+
+#define NUM_GROUPS      20
+#define DSET_SIZE       64              /* # of ints in each dataset */
+#define NEW_GROUP       "new_group"
+
+
+/*-------------------------------------------------------------------------
+ * Function:    test_props
+ *
+ * Purpose:     Check setting and retrieving the metadata cache image
+ *              configuration, including invalid values.
+ *
+ * Return:      Success:        0
+ *              Failure:        1
+ *
+ *-------------------------------------------------------------------------
+ */
+static unsigned
+test_props(void)
+{
+    hid_t       fapl = -1;
+    H5AC_cache_image_config_t config;
+    herr_t      ret;
+
+    TESTING("metadata cache image properties");
+
+    if((fapl = H5Pcreate(H5P_FILE_ACCESS)) < 0) TEST_ERROR
+
+    /* Check the default */
+    config.version = H5AC__CURR_CACHE_IMAGE_CONFIG_VERSION;
+    if(H5Pget_mdc_image_config(fapl, &config) < 0) TEST_ERROR
+    if(config.generate_image) TEST_ERROR
+
+    /* Set and retrieve a value */
+    config.generate_image = TRUE;
+    if(H5Pset_mdc_image_config(fapl, &config) < 0) TEST_ERROR
+    config.generate_image = FALSE;
+    if(H5Pget_mdc_image_config(fapl, &config) < 0) TEST_ERROR
+    if(!config.generate_image) TEST_ERROR
+
+    /* Invalid values */
+    config.version = H5AC__CURR_CACHE_IMAGE_CONFIG_VERSION + 1;
+    H5E_BEGIN_TRY {
+        ret = H5Pset_mdc_image_config(fapl, &config);
+    } H5E_END_TRY;
+    if(ret >= 0) TEST_ERROR
+    H5E_BEGIN_TRY {
+        ret = H5Pget_mdc_image_config(fapl, &config);
+    } H5E_END_TRY;
+    if(ret >= 0) TEST_ERROR
+    H5E_BEGIN_TRY {
+        ret = H5Pset_mdc_image_config(fapl, NULL);
+    } H5E_END_TRY;
+    if(ret >= 0) TEST_ERROR
+
+    if(H5Pclose(fapl) < 0) TEST_ERROR
+
+    PASSED()
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Pclose(fapl);
+    } H5E_END_TRY;
+    return 1;
+} /* end test_props() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    check_file
+ *
+ * Purpose:     Open every group and dataset in the test file and verify
+ *              the data.  Each dataset holds its group's index plus
+ *              OFFSET, added to the element index.
+ *
+ * Return:      Success:        0
+ *              Failure:        -1
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+check_file(hid_t file, int offset, hbool_t has_new_group)
+{
+    hid_t       gid = -1, did = -1;
+    char        name[32];
+    int         rbuf[DSET_SIZE];
+    unsigned    u, v;
+
+    for(u = 0; u < NUM_GROUPS; u++) {
+        HDsnprintf(name, sizeof(name), "group_%u", u);
+        if((gid = H5Gopen2(file, name, H5P_DEFAULT)) < 0) TEST_ERROR
+        if((did = H5Dopen2(gid, "dset", H5P_DEFAULT)) < 0) TEST_ERROR
+        if(H5Dread(did, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, rbuf) < 0) TEST_ERROR
+        for(v = 0; v < DSET_SIZE; v++)
+            if(rbuf[v] != (int)(u + v) + offset) TEST_ERROR
+        if(H5Dclose(did) < 0) TEST_ERROR
+        if(H5Gclose(gid) < 0) TEST_ERROR
+    } /* end for */
+
+    if((H5Lexists(file, NEW_GROUP, H5P_DEFAULT) > 0) != has_new_group) TEST_ERROR
+
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Dclose(did);
+        H5Gclose(gid);
+    } H5E_END_TRY;
+    return -1;
+} /* end check_file() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    write_dsets
+ *
+ * Purpose:     Write every dataset in the test file, creating the groups
+ *              and datasets if CREATE is set.
+ *
+ * Return:      Success:        0
+ *              Failure:        -1
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+write_dsets(hid_t file, int offset, hbool_t create)
+{
+    hid_t       gid = -1, sid = -1, did = -1;
+    hsize_t     dims[1] = {DSET_SIZE};
+    char        name[32];
+    int         wbuf[DSET_SIZE];
+    unsigned    u, v;
+
+    if((sid = H5Screate_simple(1, dims, NULL)) < 0) TEST_ERROR
+
+    for(u = 0; u < NUM_GROUPS; u++) {
+        HDsnprintf(name, sizeof(name), "group_%u", u);
+        if(create) {
+            if((gid = H5Gcreate2(file, name, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT)) < 0) TEST_ERROR
+            if((did = H5Dcreate2(gid, "dset", H5T_NATIVE_INT, sid, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT)) < 0) TEST_ERROR
+        } /* end if */
+        else {
+            if((gid = H5Gopen2(file, name, H5P_DEFAULT)) < 0) TEST_ERROR
+            if((did = H5Dopen2(gid, "dset", H5P_DEFAULT)) < 0) TEST_ERROR
+        } /* end else */
+        for(v = 0; v < DSET_SIZE; v++)
+            wbuf[v] = (int)(u + v) + offset;
+        if(H5Dwrite(did, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, wbuf) < 0) TEST_ERROR
+        if(H5Dclose(did) < 0) TEST_ERROR
+        if(H5Gclose(gid) < 0) TEST_ERROR
+    } /* end for */
+
+    if(H5Sclose(sid) < 0) TEST_ERROR
+
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Dclose(did);
+        H5Gclose(gid);
+        H5Sclose(sid);
+    } H5E_END_TRY;
+    return -1;
+} /* end write_dsets() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    test_reopen
+ *
+ * Purpose:     Create a file that is closed with a metadata cache image,
+ *              and verify that the image is used when the file is
+ *              reopened read-only, that it is discarded when the file is
+ *              reopened for writing, and that a file modified after being
+ *              reopened with an image reads back correctly.
+ *
+ * Return:      Success:        0
+ *              Failure:        1
+ *
+ *-------------------------------------------------------------------------
+ */
+static unsigned
+test_reopen(hid_t fapl, hbool_t image_supported)
+{
+    char        filename[FILENAME_LEN];
+    hid_t       img_fapl = -1, file = -1, gid = -1, plist = -1;
+    H5AC_cache_image_config_t config;
+    unsigned    nentries, nhits;
+
+    TESTING("metadata cache image on file reopen");
+
+    /* No image is written for drivers that store driver info in the file */
+    if(!image_supported) {
+        SKIPPED();
+        HDputs("    Not supported by the split, multi and family file drivers");
+        return 0;
+    } /* end if */
+
+    h5_fixname(FILENAME[0], fapl, filename, sizeof(filename));
+
+    /* File access property list that requests a cache image */
+    if((img_fapl = H5Pcopy(fapl)) < 0) TEST_ERROR
+    config.version = H5AC__CURR_CACHE_IMAGE_CONFIG_VERSION;
+    config.generate_image = TRUE;
+    if(H5Pset_mdc_image_config(img_fapl, &config) < 0) TEST_ERROR
+
+    /* Create the file, closing it with a cache image */
+    if((file = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, img_fapl)) < 0) TEST_ERROR
+    if(write_dsets(file, 0, TRUE) < 0) TEST_ERROR
+
+    /* The setting is reported by the file's access property list */
+    if((plist = H5Fget_access_plist(file)) < 0) TEST_ERROR
+    config.generate_image = FALSE;
+    if(H5Pget_mdc_image_config(plist, &config) < 0) TEST_ERROR
+    if(!config.generate_image) TEST_ERROR
+    if(H5Pclose(plist) < 0) TEST_ERROR
+
+    if(H5Fclose(file) < 0) TEST_ERROR
+
+    /* Reopen read-only: the metadata is loaded from the image */
+    if((file = H5Fopen(filename, H5F_ACC_RDONLY, fapl)) < 0) TEST_ERROR
+    if(H5F_get_mdc_image_stats_test(file, &nentries, &nhits) < 0) TEST_ERROR
+    if(nentries == 0) TEST_ERROR
+    if(check_file(file, 0, FALSE) < 0) TEST_ERROR
+    if(H5F_get_mdc_image_stats_test(file, &nentries, &nhits) < 0) TEST_ERROR
+    if(nhits == 0 || nhits > nentries) TEST_ERROR
+    if(H5Fclose(file) < 0) TEST_ERROR
+
+    /* A read-only open leaves the image in place */
+    if((file = H5Fopen(filename, H5F_ACC_RDONLY, fapl)) < 0) TEST_ERROR
+    if(H5F_get_mdc_image_stats_test(file, &nentries, &nhits) < 0) TEST_ERROR
+    if(nentries == 0) TEST_ERROR
+    if(H5Fclose(file) < 0) TEST_ERROR
+
+    /* Reopen for writing without requesting an image, and modify the file */
+    if((file = H5Fopen(filename, H5F_ACC_RDWR, fapl)) < 0) TEST_ERROR
+    if(H5F_get_mdc_image_stats_test(file, &nentries, &nhits) < 0) TEST_ERROR
+    if(nentries == 0) TEST_ERROR
+    if(write_dsets(file, 100, FALSE) < 0) TEST_ERROR
+    if((gid = H5Gcreate2(file, NEW_GROUP, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT)) < 0) TEST_ERROR
+    if(H5Gclose(gid) < 0) TEST_ERROR
+    if(check_file(file, 100, TRUE) < 0) TEST_ERROR
+    if(H5Fclose(file) < 0) TEST_ERROR
+
+    /* The image was discarded */
+    if((file = H5Fopen(filename, H5F_ACC_RDONLY, fapl)) < 0) TEST_ERROR
+    if(H5F_get_mdc_image_stats_test(file, &nentries, &nhits) < 0) TEST_ERROR
+    if(nentries != 0) TEST_ERROR
+    if(check_file(file, 100, TRUE) < 0) TEST_ERROR
+    if(H5Fclose(file) < 0) TEST_ERROR
+
+    /* Reopen for writing with an image, delete a group and modify the data */
+    if((file = H5Fopen(filename, H5F_ACC_RDWR, img_fapl)) < 0) TEST_ERROR
+    if(H5Ldelete(file, NEW_GROUP, H5P_DEFAULT) < 0) TEST_ERROR
+    if(write_dsets(file, 200, FALSE) < 0) TEST_ERROR
+    if(H5Fclose(file) < 0) TEST_ERROR
+
+    /* The new image reflects the changes */
+    if((file = H5Fopen(filename, H5F_ACC_RDONLY, fapl)) < 0) TEST_ERROR
+    if(H5F_get_mdc_image_stats_test(file, &nentries, &nhits) < 0) TEST_ERROR
+    if(nentries == 0) TEST_ERROR
+    if(check_file(file, 200, FALSE) < 0) TEST_ERROR
+    if(H5Fclose(file) < 0) TEST_ERROR
+
+    if(H5Pclose(img_fapl) < 0) TEST_ERROR
+
+    PASSED()
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Gclose(gid);
+        H5Pclose(plist);
+        H5Fclose(file);
+        H5Pclose(img_fapl);
+    } H5E_END_TRY;
+    return 1;
+} /* end test_reopen() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    test_old_format
+ *
+ * Purpose:     Verify that no image is written for a file whose superblock
+ *              can't hold one, because it was created by default and is
+ *              then reopened requesting an image.
+ *
+ * Return:      Success:        0
+ *              Failure:        1
+ *
+ *-------------------------------------------------------------------------
+ */
+static unsigned
+test_old_format(hid_t fapl)
+{
+    char        filename[FILENAME_LEN];
+    hid_t       img_fapl = -1, file = -1;
+    H5AC_cache_image_config_t config;
+    unsigned    nentries;
+
+    TESTING("metadata cache image with version 0 superblock");
+
+    h5_fixname(FILENAME[0], fapl, filename, sizeof(filename));
+
+    if((img_fapl = H5Pcopy(fapl)) < 0) TEST_ERROR
+    config.version = H5AC__CURR_CACHE_IMAGE_CONFIG_VERSION;
+    config.generate_image = TRUE;
+    if(H5Pset_mdc_image_config(img_fapl, &config) < 0) TEST_ERROR
+
+    if((file = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0) TEST_ERROR
+    if(write_dsets(file, 0, TRUE) < 0) TEST_ERROR
+    if(H5Fclose(file) < 0) TEST_ERROR
+
+    if((file = H5Fopen(filename, H5F_ACC_RDWR, img_fapl)) < 0) TEST_ERROR
+    if(check_file(file, 0, FALSE) < 0) TEST_ERROR
+    if(H5Fclose(file) < 0) TEST_ERROR
+
+    if((file = H5Fopen(filename, H5F_ACC_RDONLY, fapl)) < 0) TEST_ERROR
+    if(H5F_get_mdc_image_stats_test(file, &nentries, NULL) < 0) TEST_ERROR
+    if(nentries != 0) TEST_ERROR
+    if(check_file(file, 0, FALSE) < 0) TEST_ERROR
+    if(H5Fclose(file) < 0) TEST_ERROR
+
+    if(H5Pclose(img_fapl) < 0) TEST_ERROR
+
+    PASSED()
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Fclose(file);
+        H5Pclose(img_fapl);
+    } H5E_END_TRY;
+    return 1;
+} /* end test_old_format() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    main
+ *
+ * Purpose:     Test the metadata cache image
+ *
+ * Return:      Success:        EXIT_SUCCESS
+ *              Failure:        EXIT_FAILURE
+ *
+ *-------------------------------------------------------------------------
+ */
+int
+main(void)
+{
+    hid_t       fapl = -1;
+    unsigned    nerrors = 0;
+    hbool_t     image_supported;
+    const char *env_h5_drvr;
+
+    env_h5_drvr = HDgetenv("HDF5_DRIVER");
+    if(env_h5_drvr == NULL)
+        env_h5_drvr = "nomatch";
+    image_supported = HDstrcmp(env_h5_drvr, "split") && HDstrcmp(env_h5_drvr, "multi")
+            && HDstrcmp(env_h5_drvr, "family");
+
+    h5_reset();
+    fapl = h5_fileaccess();
+
+    nerrors += test_props();
+    nerrors += test_reopen(fapl, image_supported);
+    nerrors += test_old_format(fapl);
+
+    if(nerrors)
+        goto error;
+
+    HDputs("All metadata cache image tests passed.");
+    h5_cleanup(FILENAME, fapl);
+    HDexit(EXIT_SUCCESS);
+
+error:
+    HDputs("*** TESTS FAILED ***");
+    H5E_BEGIN_TRY {
+        H5Pclose(fapl);
+    } H5E_END_TRY;
+    HDexit(EXIT_FAILURE);
+} /* end main() */
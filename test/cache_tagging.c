@@ -233,7 +233,6 @@ static int print_index(hid_t fid) {
 
     H5F_t * f = NULL;         /* File Pointer */
     H5C_t * cache_ptr = NULL; /* Cache Pointer */
-    int i = 0; /* Iterator */
     H5C_cache_entry_t *next_entry_ptr = NULL; /* entry pointer */
 
     /* Get Internal File / Cache Pointers */
@@ -242,20 +241,17 @@ static int print_index(hid_t fid) {
 
     /* Initial (debugging) loop */
     printf("CACHE SNAPSHOT:\n");
-    for (i = 0; i < H5C__HASH_TABLE_LEN; i++) {
-        next_entry_ptr = cache_ptr->index[i];
-
-        while (next_entry_ptr != NULL) {
-            printf("Addr = %u, ", (unsigned int)next_entry_ptr->addr);
-            printf("Tag = %u, ", (unsigned int)next_entry_ptr->tag);
-            printf("Dirty = %d, ", (int)next_entry_ptr->is_dirty);
-            printf("Protected = %d, ", (int)next_entry_ptr->is_protected);
-            print_entry_type_to_screen(next_entry_ptr->type->id);
-            printf("\n");
-            next_entry_ptr = next_entry_ptr->ht_next;
-        } /* end if */
-
-    } /* end for */
+    next_entry_ptr = cache_ptr->il_head;
+
+    while (next_entry_ptr != NULL) {
+        printf("Addr = %u, ", (unsigned int)next_entry_ptr->addr);
+        printf("Tag = %u, ", (unsigned int)next_entry_ptr->tag);
+        printf("Dirty = %d, ", (int)next_entry_ptr->is_dirty);
+        printf("Protected = %d, ", (int)next_entry_ptr->is_protected);
+        print_entry_type_to_screen(next_entry_ptr->type->id);
+        printf("\n");
+        next_entry_ptr = next_entry_ptr->il_next;
+    } /* end while */
     printf("\n");
 
     return 0;
@@ -290,26 +286,21 @@ static int verify_no_unknown_tags(hid_t fid)
 
     H5F_t * f = NULL;         /* File Pointer */
     H5C_t * cache_ptr = NULL; /* Cache Pointer */
-    int i = 0; /* Iterator */
     H5C_cache_entry_t *next_entry_ptr = NULL; /* entry pointer */
 
     /* Get Internal File / Cache Pointers */
     if ( NULL == (f = (H5F_t *)H5I_object(fid)) ) TEST_ERROR;
     cache_ptr = f->shared->cache;
 
-    for (i = 0; i < H5C__HASH_TABLE_LEN; i++) {
+    next_entry_ptr = cache_ptr->il_head;
 
-        next_entry_ptr = cache_ptr->index[i];
+    while (next_entry_ptr != NULL) {
 
-        while (next_entry_ptr != NULL) {
+        if ( next_entry_ptr->tag != H5AC__IGNORE_TAG ) TEST_ERROR;
 
-            if ( next_entry_ptr->tag != H5AC__IGNORE_TAG ) TEST_ERROR;
+        next_entry_ptr = next_entry_ptr->il_next;
 
-            next_entry_ptr = next_entry_ptr->ht_next;
-
-        } /* end if */
-
-    } /* for */
+    } /* end while */
 
     return 0;
 
@@ -342,30 +333,25 @@ static int mark_all_entries_investigated(hid_t fid)
 
     H5F_t * f = NULL;         /* File Pointer */
     H5C_t * cache_ptr = NULL; /* Cache Pointer */
-    int i = 0; /* Iterator */
     H5C_cache_entry_t *next_entry_ptr = NULL; /* entry pointer */
 
     /* Get Internal File / Cache Pointers */
     if ( NULL == (f = (H5F_t *)H5I_object(fid)) ) TEST_ERROR;
     cache_ptr = f->shared->cache;
 
-    for (i = 0; i < H5C__HASH_TABLE_LEN; i++) {
-
-        next_entry_ptr = cache_ptr->index[i];
+    next_entry_ptr = cache_ptr->il_head;
 
-        while (next_entry_ptr != NULL) {
+    while (next_entry_ptr != NULL) {
 
-            if ( next_entry_ptr->tag != H5AC__IGNORE_TAG ) {
+        if ( next_entry_ptr->tag != H5AC__IGNORE_TAG ) {
 
-                    next_entry_ptr->tag = H5AC__IGNORE_TAG;
-
-            } /* end if */
-
-            next_entry_ptr = next_entry_ptr->ht_next;
+                next_entry_ptr->tag = H5AC__IGNORE_TAG;
 
         } /* end if */
 
-    } /* for */
+        next_entry_ptr = next_entry_ptr->il_next;
+
+    } /* end while */
 
     return 0;
 
@@ -396,7 +382,6 @@ error:
  */
 static int verify_tag(hid_t fid, int id, haddr_t tag)
 {
-    int i = 0;                           /* Iterator */
     int found = FALSE;                   /* If Entry Found */
     H5F_t * f = NULL;         /* File Pointer */
     H5C_t * cache_ptr = NULL; /* Cache Pointer */
@@ -406,33 +391,31 @@ static int verify_tag(hid_t fid, int id, haddr_t tag)
     if ( NULL == (f = (H5F_t *)H5I_object(fid)) ) TEST_ERROR;
     cache_ptr = f->shared->cache;
 
-    for (i = 0; i < H5C__HASH_TABLE_LEN; i++) {
-
-        next_entry_ptr = cache_ptr->index[i];
-
-        while (next_entry_ptr != NULL) {
+    next_entry_ptr = cache_ptr->il_head;
 
-            if ( (next_entry_ptr->type->id == id) && (next_entry_ptr->tag != H5AC__IGNORE_TAG) ) {
-                
-                if (!found) {
+    while (next_entry_ptr != NULL) {
 
-                    if (next_entry_ptr->tag != tag) TEST_ERROR;
-
-                    /* note that we've found the entry */
-                    found = TRUE;
+        /* The index list isn't in address order, so look for an entry
+         * with the tag rather than checking the first one of the type.
+         * Entries with wrong tags are caught by verify_no_unknown_tags().
+         */
+        if ( (next_entry_ptr->type->id == id) && (next_entry_ptr->tag == tag) ) {
+            
+            if (!found) {
 
-                    /* Ignore this tag now that we've verified it was initially tagged correctly. */
-                    next_entry_ptr->tag = H5AC__IGNORE_TAG;
+                /* note that we've found the entry */
+                found = TRUE;
 
-                }
-    
-            } /* end if */
+                /* Ignore this tag now that we've verified it was initially tagged correctly. */
+                next_entry_ptr->tag = H5AC__IGNORE_TAG;
 
-            next_entry_ptr = next_entry_ptr->ht_next;
+            }
 
         } /* end if */
 
-    } /* for */
+        next_entry_ptr = next_entry_ptr->il_next;
+
+    } /* end while */
 
     if (found == FALSE) 
         TEST_ERROR;
@@ -489,7 +472,6 @@ static int get_new_object_header_tag(hid_t fid, haddr_t *tag)
 {
     H5F_t * f = NULL;         /* File Pointer */
     H5C_t * cache_ptr = NULL; /* Cache Pointer */
-    int i = 0;                              /* Iterator */
     H5C_cache_entry_t * next_entry_ptr = NULL;   /* Entry Pointer */
     int found = FALSE;                      /* If entry is found */
 
@@ -497,28 +479,22 @@ static int get_new_object_header_tag(hid_t fid, haddr_t *tag)
     if ( NULL == (f = (H5F_t *)H5I_object(fid)) ) TEST_ERROR;
     cache_ptr = f->shared->cache;
 
-    for (i = 0; i < H5C__HASH_TABLE_LEN; i++) {
-        
-        next_entry_ptr = cache_ptr->index[i];
+    next_entry_ptr = cache_ptr->il_head;
 
-        while (next_entry_ptr != NULL) {
+    while (next_entry_ptr != NULL) {
 
-            if ( (next_entry_ptr->tag != H5AC__IGNORE_TAG) && (next_entry_ptr->type->id == H5AC_OHDR_ID) ) {
+        if ( (next_entry_ptr->tag != H5AC__IGNORE_TAG) && (next_entry_ptr->type->id == H5AC_OHDR_ID) ) {
 
-                *tag = next_entry_ptr->tag;
-                next_entry_ptr->tag = H5AC__IGNORE_TAG;
-                found = TRUE;
-                break;
-
-            } /* end if */
-
-            next_entry_ptr = next_entry_ptr->ht_next;
+            *tag = next_entry_ptr->tag;
+            next_entry_ptr->tag = H5AC__IGNORE_TAG;
+            found = TRUE;
+            break;
 
         } /* end if */
 
-        if (found) break;
+        next_entry_ptr = next_entry_ptr->il_next;
 
-    } /* end for */
+    } /* end while */
 
     if (found == FALSE) TEST_ERROR;
     
@@ -28,10 +28,17 @@
  */
 #define H5Z_FRIEND
 
+/*
+ * This file needs to access private information from the H5D package.
+ */
+#define H5D_FRIEND
+#define H5D_TESTING
+
 
 #include "h5test.h"
 #include "H5srcdir.h"
 #include "H5Zpkg.h"
+#include "H5Dpkg.h"
 #ifdef H5_HAVE_SZLIB_H
 #   include "szlib.h"
 #endif
@@ -51,6 +58,10 @@ const char *FILENAME[] = {
     "copy_dcpl_newfile",
     "layout_extend",
     "zero_chunk",
+    "filter_nthreads",
+    "chunk_index",
+    "chunk_cache_arc",
+    "chunk_prefetch",
     NULL
 };
 #define FILENAME_BUF_SIZE       1024
@@ -69,6 +80,8 @@ const char *FILENAME[] = {
 #define DSET_COMPACT_MAX2_NAME   "max_compact_2"
 #define DSET_CONV_BUF_NAME	"conv_buf"
 #define DSET_TCONV_NAME		"tconv"
+#define DSET_TCONV_INPLACE_NAME	"tconv_inplace"
+#define DSET_MULTI_IO_NAME	"multi_io_%d"
 #define DSET_DEFLATE_NAME	"deflate"
 #define DSET_SHUFFLE_NAME	"shuffle"
 #define DSET_FLETCHER32_NAME	"fletcher32"
@@ -1123,6 +1136,20 @@ test_conv_buffer(hid_t fid)
 
   if(H5Dread(dataset, ctype2, H5S_ALL, H5S_ALL, xfer_list, cfrR) < 0) goto error;
 
+  /* Read should fail again once the same transfer list's buffer shrinks */
+  size = (DIM2 * DIM3 * (sizeof(int))+ DIM2 * (sizeof(float))+
+         DIM3 * (sizeof(double)));
+  if(H5Pset_buffer(xfer_list, size, NULL, NULL) < 0) goto error;
+
+  H5E_BEGIN_TRY {
+    status = H5Dread(dataset, ctype2, H5S_ALL, H5S_ALL, xfer_list, cfrR);
+  } H5E_END_TRY;
+  if(status >= 0) {
+      H5_FAILED();
+      puts("    Library used a stale conversion buffer size");
+      goto error;
+  }
+
 
   if(H5Pclose(xfer_list) < 0) goto error;
   if(H5Sclose(space) < 0) goto error;
@@ -1233,6 +1260,285 @@ error:
     return -1;
 }
 
+/*-------------------------------------------------------------------------
+ * Function:	test_tconv_inplace
+ *
+ * Purpose:	Test reading with byte order conversion and widening
+ *		conversions, which are done in place in the application's
+ *		buffer when the memory selection is contiguous, from a
+ *		chunked dataset with partial and unallocated chunks.
+ *
+ * Return:	Success:	0
+ *		Failure:	-1
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+test_tconv_inplace(hid_t file)
+{
+    const hsize_t dims[2] = {40, 30};   /* Dataset dimensions */
+    const hsize_t chunk_dims[2] = {16, 16};     /* Chunk dimensions */
+    const short fill = 7;               /* Fill value */
+    short       wbuf[40][30];           /* Data written */
+    short       sbuf[40][30];           /* Data read as shorts */
+    long long   llbuf[40][30];          /* Data read as long longs */
+    double      dbuf[20][20];           /* Data read as doubles */
+    int         ibuf[40][40];           /* Data read as ints */
+    hsize_t     start[2], count[2];     /* Hyperslab selection */
+    hsize_t     mdims[2];               /* Memory dataspace dimensions */
+    hid_t       dcpl = -1, space = -1, mspace = -1, dataset = -1;
+    int         i, j;
+
+    TESTING("data type conversion in the application's buffer");
+
+    for(i = 0; i < 40; i++)
+        for(j = 0; j < 30; j++)
+            wbuf[i][j] = (short)(i * 100 - j * 50);
+
+    /* Create a big-endian chunked dataset with a fill value */
+    if((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0) TEST_ERROR
+    if(H5Pset_chunk(dcpl, 2, chunk_dims) < 0) TEST_ERROR
+    if(H5Pset_fill_value(dcpl, H5T_NATIVE_SHORT, &fill) < 0) TEST_ERROR
+    if((space = H5Screate_simple(2, dims, NULL)) < 0) TEST_ERROR
+    if((dataset = H5Dcreate2(file, DSET_TCONV_INPLACE_NAME, H5T_STD_I16BE, space,
+            H5P_DEFAULT, dcpl, H5P_DEFAULT)) < 0) TEST_ERROR
+
+    /* Write the first 32 rows, leaving the last row of chunks unallocated */
+    start[0] = start[1] = 0;
+    count[0] = 32; count[1] = 30;
+    if(H5Sselect_hyperslab(space, H5S_SELECT_SET, start, NULL, count, NULL) < 0) TEST_ERROR
+    if(H5Dwrite(dataset, H5T_NATIVE_SHORT, space, space, H5P_DEFAULT, wbuf) < 0) TEST_ERROR
+    for(i = 32; i < 40; i++)
+        for(j = 0; j < 30; j++)
+            wbuf[i][j] = fill;
+    if(H5Sselect_all(space) < 0) TEST_ERROR
+
+    /* Read with byte order conversion */
+    if(H5Dread(dataset, H5T_NATIVE_SHORT, H5S_ALL, H5S_ALL, H5P_DEFAULT, sbuf) < 0) TEST_ERROR
+    for(i = 0; i < 40; i++)
+        for(j = 0; j < 30; j++)
+            if(sbuf[i][j] != wbuf[i][j]) TEST_ERROR
+
+    /* Read with widening integer conversion */
+    if(H5Dread(dataset, H5T_NATIVE_LLONG, H5S_ALL, H5S_ALL, H5P_DEFAULT, llbuf) < 0) TEST_ERROR
+    for(i = 0; i < 40; i++)
+        for(j = 0; j < 30; j++)
+            if(llbuf[i][j] != (long long)wbuf[i][j]) TEST_ERROR
+
+    /* Read a hyperslab spanning chunks with integer to floating-point
+     * conversion into a (contiguous) memory dataspace of a different shape */
+    start[0] = 15; start[1] = 3;
+    count[0] = 20; count[1] = 20;
+    if(H5Sselect_hyperslab(space, H5S_SELECT_SET, start, NULL, count, NULL) < 0) TEST_ERROR
+    mdims[0] = 400;
+    if((mspace = H5Screate_simple(1, mdims, NULL)) < 0) TEST_ERROR
+    if(H5Dread(dataset, H5T_NATIVE_DOUBLE, mspace, space, H5P_DEFAULT, dbuf) < 0) TEST_ERROR
+    for(i = 0; i < 20; i++)
+        for(j = 0; j < 20; j++)
+            if(!H5_DBL_ABS_EQUAL(dbuf[i][j], (double)wbuf[i + 15][j + 3])) TEST_ERROR
+    if(H5Sclose(mspace) < 0) TEST_ERROR
+
+    /* Read into a non-contiguous memory selection, which uses the type
+     * conversion buffer */
+    mdims[0] = mdims[1] = 40;
+    if((mspace = H5Screate_simple(2, mdims, NULL)) < 0) TEST_ERROR
+    start[0] = 0; start[1] = 5;
+    if(H5Sselect_hyperslab(mspace, H5S_SELECT_SET, start, NULL, count, NULL) < 0) TEST_ERROR
+    HDmemset(ibuf, 0, sizeof(ibuf));
+    if(H5Dread(dataset, H5T_NATIVE_INT, mspace, space, H5P_DEFAULT, ibuf) < 0) TEST_ERROR
+    for(i = 0; i < 40; i++)
+        for(j = 0; j < 40; j++) {
+            int expect = (i < 20 && j >= 5 && j < 25) ? wbuf[i + 15][j - 2] : 0;
+
+            if(ibuf[i][j] != expect) TEST_ERROR
+        } /* end for */
+
+    if(H5Sclose(mspace) < 0) TEST_ERROR
+    if(H5Dclose(dataset) < 0) TEST_ERROR
+    if(H5Sclose(space) < 0) TEST_ERROR
+    if(H5Pclose(dcpl) < 0) TEST_ERROR
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Dclose(dataset);
+        H5Sclose(mspace);
+        H5Sclose(space);
+        H5Pclose(dcpl);
+    } H5E_END_TRY;
+
+    return -1;
+} /* end test_tconv_inplace() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	test_multi_io
+ *
+ * Purpose:	Test reading and writing several datasets at once with
+ *		H5Dread_multi() and H5Dwrite_multi(), both when the pieces
+ *		are merged into one request and when some entries need
+ *		type conversion or chunked storage.
+ *
+ * Return:	Success:	0
+ *		Failure:	-1
+ *
+ *-------------------------------------------------------------------------
+ */
+#define MULTI_IO_NDSETS 4
+static herr_t
+test_multi_io(hid_t file)
+{
+    const hsize_t dims[2] = {12, 10};   /* Dataset dimensions */
+    const hsize_t chunk_dims[2] = {5, 5};       /* Chunk dimensions */
+    hid_t       dset[MULTI_IO_NDSETS];  /* Datasets */
+    hid_t       mem_type[MULTI_IO_NDSETS];      /* Memory datatypes */
+    hid_t       mem_space[MULTI_IO_NDSETS];     /* Memory dataspaces */
+    hid_t       file_space[MULTI_IO_NDSETS];    /* File dataspaces */
+    const void  *wbufs[MULTI_IO_NDSETS];        /* Buffers written */
+    void        *rbufs[MULTI_IO_NDSETS];        /* Buffers read */
+    int         wbuf[MULTI_IO_NDSETS][12][10];  /* Data written */
+    int         rbuf[MULTI_IO_NDSETS][12][10];  /* Data read */
+    int         expect[MULTI_IO_NDSETS][12][10];        /* Data expected in the file */
+    hsize_t     start[2], stride[2], count[2];  /* Hyperslab selection */
+    hid_t       be_dset = -1;           /* Big-endian dataset */
+    hid_t       dcpl = -1, space = -1, sel = -1, strided = -1;
+    char        name[32];
+    int         i, j, k;
+
+    TESTING("multi-dataset read and write");
+
+    for(k = 0; k < MULTI_IO_NDSETS; k++) {
+        dset[k] = -1;
+        for(i = 0; i < 12; i++)
+            for(j = 0; j < 10; j++) {
+                wbuf[k][i][j] = k * 1000 + i * 10 + j;
+                expect[k][i][j] = 0;
+            } /* end for */
+    } /* end for */
+
+    /* Create two contiguous datasets, a contiguous big-endian dataset and
+     * a chunked dataset */
+    if((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0) TEST_ERROR
+    if(H5Pset_chunk(dcpl, 2, chunk_dims) < 0) TEST_ERROR
+    if((space = H5Screate_simple(2, dims, NULL)) < 0) TEST_ERROR
+    for(k = 0; k < MULTI_IO_NDSETS; k++) {
+        HDsprintf(name, DSET_MULTI_IO_NAME, k);
+        if((dset[k] = H5Dcreate2(file, name, k == 2 ? H5T_STD_I32BE : H5T_NATIVE_INT, space,
+                H5P_DEFAULT, k == 3 ? dcpl : H5P_DEFAULT, H5P_DEFAULT)) < 0) TEST_ERROR
+        mem_type[k] = H5T_NATIVE_INT;
+        wbufs[k] = wbuf[k];
+        rbufs[k] = rbuf[k];
+    } /* end for */
+    be_dset = dset[2];
+
+    /* A block of the dataset, and every other column in memory */
+    if((sel = H5Scopy(space)) < 0) TEST_ERROR
+    start[0] = 3; start[1] = 2;
+    count[0] = 6; count[1] = 4;
+    if(H5Sselect_hyperslab(sel, H5S_SELECT_SET, start, NULL, count, NULL) < 0) TEST_ERROR
+    if((strided = H5Scopy(space)) < 0) TEST_ERROR
+    start[0] = 0; start[1] = 0;
+    stride[0] = 1; stride[1] = 2;
+    count[0] = 6; count[1] = 4;
+    if(H5Sselect_hyperslab(strided, H5S_SELECT_SET, start, stride, count, NULL) < 0) TEST_ERROR
+
+    /* Write the first two datasets in one merged request: all of the first,
+     * and a block of the second from a strided memory selection */
+    mem_space[0] = H5S_ALL; file_space[0] = H5S_ALL;
+    mem_space[1] = strided; file_space[1] = sel;
+    if(H5Dwrite_multi((size_t)2, dset, mem_type, mem_space, file_space, H5P_DEFAULT, wbufs) < 0) TEST_ERROR
+    for(i = 0; i < 12; i++)
+        for(j = 0; j < 10; j++)
+            expect[0][i][j] = wbuf[0][i][j];
+    for(i = 0; i < 6; i++)
+        for(j = 0; j < 4; j++)
+            expect[1][i + 3][j + 2] = wbuf[1][i][j * 2];
+
+    /* Write all four datasets, which needs the general path */
+    mem_space[2] = H5S_ALL; file_space[2] = H5S_ALL;
+    mem_space[3] = sel; file_space[3] = sel;
+    mem_space[1] = H5S_ALL; file_space[1] = H5S_ALL;
+    if(H5Dwrite_multi((size_t)MULTI_IO_NDSETS, dset, mem_type, mem_space, file_space, H5P_DEFAULT, wbufs) < 0) TEST_ERROR
+    for(k = 1; k < MULTI_IO_NDSETS; k++)
+        for(i = 0; i < 12; i++)
+            for(j = 0; j < 10; j++)
+                expect[k][i][j] = (k < 3 || (i >= 3 && i < 9 && j >= 2 && j < 6)) ? wbuf[k][i][j] : 0;
+
+    /* Overlapping writes to the same dataset: the last entry wins */
+    dset[2] = dset[0];
+    mem_space[0] = sel; file_space[0] = sel;
+    mem_space[2] = sel; file_space[2] = sel;
+    wbufs[2] = wbuf[2];
+    if(H5Dwrite_multi((size_t)3, dset, mem_type, mem_space, file_space, H5P_DEFAULT, wbufs) < 0) TEST_ERROR
+    for(i = 3; i < 9; i++)
+        for(j = 2; j < 6; j++)
+            expect[0][i][j] = wbuf[2][i][j];
+
+    /* Read everything back in one merged request, with the first dataset
+     * read twice */
+    HDmemset(rbuf, 0, sizeof(rbuf));
+    dset[2] = dset[0];
+    for(k = 0; k < 3; k++) {
+        mem_space[k] = H5S_ALL;
+        file_space[k] = H5S_ALL;
+    } /* end for */
+    if(H5Dread_multi((size_t)3, dset, mem_type, mem_space, file_space, H5P_DEFAULT, rbufs) < 0) TEST_ERROR
+    for(k = 0; k < 3; k++)
+        for(i = 0; i < 12; i++)
+            for(j = 0; j < 10; j++)
+                if(rbuf[k][i][j] != expect[k == 2 ? 0 : k][i][j]) TEST_ERROR
+    dset[2] = be_dset;
+
+    /* Read everything back through the general path */
+    HDmemset(rbuf, 0, sizeof(rbuf));
+    mem_space[3] = H5S_ALL; file_space[3] = H5S_ALL;
+    if(H5Dread_multi((size_t)MULTI_IO_NDSETS, dset, mem_type, mem_space, file_space, H5P_DEFAULT, rbufs) < 0) TEST_ERROR
+    for(k = 0; k < MULTI_IO_NDSETS; k++)
+        for(i = 0; i < 12; i++)
+            for(j = 0; j < 10; j++)
+                if(rbuf[k][i][j] != expect[k][i][j]) TEST_ERROR
+
+    /* Read a block of the second dataset into a strided memory selection */
+    HDmemset(rbuf, 0, sizeof(rbuf));
+    mem_space[1] = strided; file_space[1] = sel;
+    if(H5Dread_multi((size_t)1, &dset[1], mem_type, &mem_space[1], &file_space[1], H5P_DEFAULT, &rbufs[1]) < 0) TEST_ERROR
+    for(i = 0; i < 12; i++)
+        for(j = 0; j < 10; j++)
+            if(rbuf[1][i][j] != ((i < 6 && j < 8 && (j % 2) == 0) ? expect[1][i + 3][j / 2 + 2] : 0)) TEST_ERROR
+
+    /* Mismatched selections are an error */
+    mem_space[1] = space;
+    H5E_BEGIN_TRY {
+        if(H5Dread_multi((size_t)2, dset, mem_type, mem_space, file_space, H5P_DEFAULT, rbufs) >= 0) TEST_ERROR
+    } H5E_END_TRY;
+
+    for(k = 0; k < MULTI_IO_NDSETS; k++)
+        if(H5Dclose(dset[k]) < 0) TEST_ERROR
+    if(H5Sclose(strided) < 0) TEST_ERROR
+    if(H5Sclose(sel) < 0) TEST_ERROR
+    if(H5Sclose(space) < 0) TEST_ERROR
+    if(H5Pclose(dcpl) < 0) TEST_ERROR
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        if(be_dset >= 0)
+            dset[2] = be_dset;
+        for(k = 0; k < MULTI_IO_NDSETS; k++)
+            H5Dclose(dset[k]);
+        H5Sclose(strided);
+        H5Sclose(sel);
+        H5Sclose(space);
+        H5Pclose(dcpl);
+    } H5E_END_TRY;
+
+    return -1;
+} /* end test_multi_io() */
+
 /* This message derives from H5Z */
 const H5Z_class2_t H5Z_BOGUS[1] = {{
     H5Z_CLASS_T_VERS,       /* H5Z_class_t version */
@@ -8039,6 +8345,680 @@ error:
     return -1;
 } /* end test_zero_dim_dset() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:    test_filter_nthreads
+ *
+ * Purpose:     Tests running the filter pipeline on several chunks in
+ *              parallel, with H5Pset_filter_nthreads(), both with the
+ *              chunks going through the chunk cache and bypassing it.
+ *
+ * Return:      Success: 0
+ *              Failure: -1
+ *
+ *-------------------------------------------------------------------------
+ */
+#define FILTER_NTHREADS_DIM     120
+#define FILTER_NTHREADS_CHUNK   10
+static herr_t
+test_filter_nthreads(hid_t fapl)
+{
+    char        filename[FILENAME_BUF_SIZE];
+    hid_t       fid = -1;       /* File ID */
+    hid_t       dcpl = -1;      /* Dataset creation property list ID */
+    hid_t       dapl = -1;      /* Dataset access property list ID */
+    hid_t       dxpl = -1;      /* Dataset transfer property list ID */
+    hid_t       sid = -1;       /* Dataspace ID */
+    hid_t       dsid = -1;      /* Dataset ID */
+    hsize_t     dims[2] = {FILTER_NTHREADS_DIM, FILTER_NTHREADS_DIM};
+    hsize_t     chunk_dims[2] = {FILTER_NTHREADS_CHUNK, FILTER_NTHREADS_CHUNK};
+    hsize_t     start[2], count[2];
+    unsigned    nthreads;       /* # of filter threads */
+    int        *wbuf = NULL;    /* Buffer for writing data */
+    int        *rbuf = NULL;    /* Buffer for reading data */
+    herr_t      ret;            /* Generic return value */
+    size_t      u;              /* Local index variable */
+    int         i;              /* Local index variable */
+
+    TESTING("filter pipeline with multiple threads");
+
+    h5_fixname(FILENAME[14], fapl, filename, sizeof filename);
+
+    if(NULL == (wbuf = (int *)HDmalloc(sizeof(int) * FILTER_NTHREADS_DIM * FILTER_NTHREADS_DIM))) TEST_ERROR
+    if(NULL == (rbuf = (int *)HDmalloc(sizeof(int) * FILTER_NTHREADS_DIM * FILTER_NTHREADS_DIM))) TEST_ERROR
+    for(u = 0; u < FILTER_NTHREADS_DIM * FILTER_NTHREADS_DIM; u++)
+        wbuf[u] = (int)(u % 97);
+
+    /* Check the DXPL property */
+    if((dxpl = H5Pcreate(H5P_DATASET_XFER)) < 0) FAIL_STACK_ERROR
+    if(H5Pget_filter_nthreads(dxpl, &nthreads) < 0) FAIL_STACK_ERROR
+    if(nthreads != 1) TEST_ERROR
+    H5E_BEGIN_TRY {
+        ret = H5Pset_filter_nthreads(dxpl, 0);
+    } H5E_END_TRY;
+    if(ret >= 0) TEST_ERROR
+    if(H5Pset_filter_nthreads(dxpl, 4) < 0) FAIL_STACK_ERROR
+    if(H5Pget_filter_nthreads(dxpl, &nthreads) < 0) FAIL_STACK_ERROR
+    if(nthreads != 4) TEST_ERROR
+
+    /* Create file */
+    if((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0) FAIL_STACK_ERROR
+
+    /* Create dataset creation property list, with several filters */
+    if((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0) FAIL_STACK_ERROR
+    if(H5Pset_chunk(dcpl, 2, chunk_dims) < 0) FAIL_STACK_ERROR
+    if(H5Pset_shuffle(dcpl) < 0) FAIL_STACK_ERROR
+#ifdef H5_HAVE_FILTER_DEFLATE
+    if(H5Pset_deflate(dcpl, 6) < 0) FAIL_STACK_ERROR
+#endif /* H5_HAVE_FILTER_DEFLATE */
+    if(H5Pset_fletcher32(dcpl) < 0) FAIL_STACK_ERROR
+
+    if((sid = H5Screate_simple(2, dims, NULL)) < 0) FAIL_STACK_ERROR
+
+    /* Use the default chunk cache for the first dataset and disable the
+     * chunk cache for the second one */
+    for(i = 0; i < 2; i++) {
+        char dset_name[16];
+
+        if((dapl = H5Pcreate(H5P_DATASET_ACCESS)) < 0) FAIL_STACK_ERROR
+        if(i == 1)
+            if(H5Pset_chunk_cache(dapl, (size_t)0, (size_t)0, H5D_CHUNK_CACHE_W0_DEFAULT) < 0) FAIL_STACK_ERROR
+
+        HDsnprintf(dset_name, sizeof(dset_name), "dset%d", i);
+        if((dsid = H5Dcreate2(fid, dset_name, H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, dapl)) < 0)
+            FAIL_STACK_ERROR
+
+        /* Write the entire dataset, with several threads */
+        if(H5Dwrite(dsid, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, dxpl, wbuf) < 0) FAIL_STACK_ERROR
+
+        /* Overwrite part of the dataset, with several threads */
+        start[0] = 5; start[1] = 15;
+        count[0] = FILTER_NTHREADS_DIM / 2; count[1] = FILTER_NTHREADS_DIM / 3;
+        if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, start, NULL, count, NULL) < 0) FAIL_STACK_ERROR
+        for(u = 0; u < FILTER_NTHREADS_DIM * FILTER_NTHREADS_DIM; u++)
+            if(u / FILTER_NTHREADS_DIM >= start[0] && u / FILTER_NTHREADS_DIM < start[0] + count[0]
+                    && u % FILTER_NTHREADS_DIM >= start[1] && u % FILTER_NTHREADS_DIM < start[1] + count[1])
+                wbuf[u] = -(int)u;
+        if(H5Dwrite(dsid, H5T_NATIVE_INT, sid, sid, dxpl, wbuf) < 0) FAIL_STACK_ERROR
+        if(H5Sselect_all(sid) < 0) FAIL_STACK_ERROR
+
+        if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+
+        /* Read the data back, with several threads and with one */
+        if((dsid = H5Dopen2(fid, dset_name, dapl)) < 0) FAIL_STACK_ERROR
+        HDmemset(rbuf, 0, sizeof(int) * FILTER_NTHREADS_DIM * FILTER_NTHREADS_DIM);
+        if(H5Dread(dsid, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, dxpl, rbuf) < 0) FAIL_STACK_ERROR
+        if(HDmemcmp(wbuf, rbuf, sizeof(int) * FILTER_NTHREADS_DIM * FILTER_NTHREADS_DIM)) TEST_ERROR
+        HDmemset(rbuf, 0, sizeof(int) * FILTER_NTHREADS_DIM * FILTER_NTHREADS_DIM);
+        if(H5Dread(dsid, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, rbuf) < 0) FAIL_STACK_ERROR
+        if(HDmemcmp(wbuf, rbuf, sizeof(int) * FILTER_NTHREADS_DIM * FILTER_NTHREADS_DIM)) TEST_ERROR
+
+        if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+        if(H5Pclose(dapl) < 0) FAIL_STACK_ERROR
+    } /* end for */
+
+    /* Close everything */
+    if(H5Sclose(sid) < 0) FAIL_STACK_ERROR
+    if(H5Pclose(dxpl) < 0) FAIL_STACK_ERROR
+    if(H5Pclose(dcpl) < 0) FAIL_STACK_ERROR
+    if(H5Fclose(fid) < 0) FAIL_STACK_ERROR
+
+    HDfree(wbuf);
+    HDfree(rbuf);
+
+    PASSED();
+
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Pclose(dcpl);
+        H5Pclose(dapl);
+        H5Pclose(dxpl);
+        H5Dclose(dsid);
+        H5Sclose(sid);
+        H5Fclose(fid);
+    } H5E_END_TRY;
+    if(wbuf)
+        HDfree(wbuf);
+    if(rbuf)
+        HDfree(rbuf);
+    return -1;
+} /* end test_filter_nthreads() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    test_chunk_index
+ *
+ * Purpose:     Tests the chunk index chosen for datasets of different
+ *              shapes: single chunk, fixed array, extensible array and
+ *              v1 B-tree.  The newer indexes are only used when the file
+ *              is created with the latest format.  Each dataset is written,
+ *              extended when possible, re-opened, verified and deleted.
+ *
+ * Return:      Success: 0
+ *              Failure: -1
+ *
+ *-------------------------------------------------------------------------
+ */
+#define CHUNK_INDEX_DIM0        20
+#define CHUNK_INDEX_DIM1        30
+#define CHUNK_INDEX_EXTEND      10
+static herr_t
+test_chunk_index(hid_t fapl, hbool_t new_format)
+{
+    typedef struct {
+        const char *name;               /* Dataset name */
+        hsize_t dims[2];                /* Initial dimensions */
+        hsize_t max_dims[2];            /* Maximum dimensions */
+        hsize_t chunk_dims[2];          /* Chunk dimensions */
+        hbool_t filtered;               /* Whether to use a filter */
+        H5D_chunk_index_t idx_type;     /* Expected index with latest format */
+    } chunk_index_case_t;
+    const chunk_index_case_t cases[] = {
+        {"single", {CHUNK_INDEX_DIM0, CHUNK_INDEX_DIM1}, {CHUNK_INDEX_DIM0, CHUNK_INDEX_DIM1},
+            {CHUNK_INDEX_DIM0, CHUNK_INDEX_DIM1}, FALSE, H5D_CHUNK_IDX_SINGLE},
+        {"single_filtered", {CHUNK_INDEX_DIM0, CHUNK_INDEX_DIM1}, {CHUNK_INDEX_DIM0, CHUNK_INDEX_DIM1},
+            {CHUNK_INDEX_DIM0, CHUNK_INDEX_DIM1}, TRUE, H5D_CHUNK_IDX_SINGLE},
+        {"fixed", {CHUNK_INDEX_DIM0, CHUNK_INDEX_DIM1}, {CHUNK_INDEX_DIM0 + CHUNK_INDEX_EXTEND, CHUNK_INDEX_DIM1 + CHUNK_INDEX_EXTEND},
+            {6, 7}, FALSE, H5D_CHUNK_IDX_FARRAY},
+        {"fixed_filtered", {CHUNK_INDEX_DIM0, CHUNK_INDEX_DIM1}, {CHUNK_INDEX_DIM0, CHUNK_INDEX_DIM1},
+            {6, 7}, TRUE, H5D_CHUNK_IDX_FARRAY},
+        {"extensible0", {CHUNK_INDEX_DIM0, CHUNK_INDEX_DIM1}, {H5S_UNLIMITED, CHUNK_INDEX_DIM1},
+            {3, 7}, FALSE, H5D_CHUNK_IDX_EARRAY},
+        {"extensible1", {CHUNK_INDEX_DIM0, CHUNK_INDEX_DIM1}, {CHUNK_INDEX_DIM0, H5S_UNLIMITED},
+            {6, 4}, TRUE, H5D_CHUNK_IDX_EARRAY},
+        {"btree", {CHUNK_INDEX_DIM0, CHUNK_INDEX_DIM1}, {H5S_UNLIMITED, H5S_UNLIMITED},
+            {6, 7}, FALSE, H5D_CHUNK_IDX_BTREE}
+    };
+    char        filename[FILENAME_BUF_SIZE];
+    hid_t       fid = -1;       /* File ID */
+    hid_t       dcpl = -1;      /* Dataset creation property list ID */
+    hid_t       sid = -1;       /* Dataspace ID */
+    hid_t       dsid = -1;      /* Dataset ID */
+    int        *wbuf = NULL;    /* Buffer for writing data */
+    int        *rbuf = NULL;    /* Buffer for reading data */
+    size_t      buf_size;       /* Size of the data buffers */
+    unsigned    u;              /* Local index variable */
+
+    TESTING("chunk index selection");
+
+    h5_fixname(FILENAME[15], fapl, filename, sizeof filename);
+
+    buf_size = sizeof(int) * (CHUNK_INDEX_DIM0 + CHUNK_INDEX_EXTEND) * (CHUNK_INDEX_DIM1 + CHUNK_INDEX_EXTEND);
+    if(NULL == (wbuf = (int *)HDmalloc(buf_size))) TEST_ERROR
+    if(NULL == (rbuf = (int *)HDmalloc(buf_size))) TEST_ERROR
+
+    if((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0) FAIL_STACK_ERROR
+
+    for(u = 0; u < NELMTS(cases); u++) {
+        const chunk_index_case_t *tc = &cases[u];
+        H5D_chunk_index_t idx_type;     /* Index type of dataset */
+        H5D_chunk_index_t exp_idx_type; /* Expected index type */
+        hsize_t dims[2];                /* Current dimensions */
+        hsize_t v;                      /* Local index variable */
+
+#ifndef H5_HAVE_FILTER_DEFLATE
+        if(tc->filtered)
+            continue;
+#endif /* H5_HAVE_FILTER_DEFLATE */
+
+        exp_idx_type = new_format ? tc->idx_type : H5D_CHUNK_IDX_BTREE;
+
+        if((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0) FAIL_STACK_ERROR
+        if(H5Pset_chunk(dcpl, 2, tc->chunk_dims) < 0) FAIL_STACK_ERROR
+#ifdef H5_HAVE_FILTER_DEFLATE
+        if(tc->filtered && H5Pset_deflate(dcpl, 6) < 0) FAIL_STACK_ERROR
+#endif /* H5_HAVE_FILTER_DEFLATE */
+        if((sid = H5Screate_simple(2, tc->dims, tc->max_dims)) < 0) FAIL_STACK_ERROR
+        if((dsid = H5Dcreate2(fid, tc->name, H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT)) < 0)
+            FAIL_STACK_ERROR
+        if(H5Sclose(sid) < 0) FAIL_STACK_ERROR
+        if(H5Pclose(dcpl) < 0) FAIL_STACK_ERROR
+
+        /* Verify the index chosen */
+        if(H5D__layout_idx_type_test(dsid, &idx_type) < 0) FAIL_STACK_ERROR
+        if(idx_type != exp_idx_type) TEST_ERROR
+
+        /* Write the initial extent, twice so that filtered chunks get
+         * re-allocated */
+        for(v = 0; v < tc->dims[0] * tc->dims[1]; v++)
+            wbuf[v] = (int)(v + u);
+        if(H5Dwrite(dsid, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, wbuf) < 0) FAIL_STACK_ERROR
+        for(v = 0; v < tc->dims[0] * tc->dims[1]; v++)
+            wbuf[v] = (int)((v * 7) % 1000 + u);
+        if(H5Dwrite(dsid, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, wbuf) < 0) FAIL_STACK_ERROR
+
+        /* Extend the dataset as far as it can go, then write it all */
+        dims[0] = MIN(tc->dims[0] + CHUNK_INDEX_EXTEND, tc->max_dims[0]);
+        dims[1] = MIN(tc->dims[1] + CHUNK_INDEX_EXTEND, tc->max_dims[1]);
+        if(dims[0] != tc->dims[0] || dims[1] != tc->dims[1]) {
+            if(H5Dset_extent(dsid, dims) < 0) FAIL_STACK_ERROR
+            for(v = 0; v < dims[0] * dims[1]; v++)
+                wbuf[v] = (int)(v * 3 + u);
+            if(H5Dwrite(dsid, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, wbuf) < 0) FAIL_STACK_ERROR
+        } /* end if */
+        if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+
+        /* Re-open the file, verify the index and the data */
+        if(H5Fclose(fid) < 0) FAIL_STACK_ERROR
+        if((fid = H5Fopen(filename, H5F_ACC_RDWR, fapl)) < 0) FAIL_STACK_ERROR
+        if((dsid = H5Dopen2(fid, tc->name, H5P_DEFAULT)) < 0) FAIL_STACK_ERROR
+        if(H5D__layout_idx_type_test(dsid, &idx_type) < 0) FAIL_STACK_ERROR
+        if(idx_type != exp_idx_type) TEST_ERROR
+        if(H5Dget_storage_size(dsid) == 0) TEST_ERROR
+        HDmemset(rbuf, 0, buf_size);
+        if(H5Dread(dsid, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, rbuf) < 0) FAIL_STACK_ERROR
+        if(HDmemcmp(wbuf, rbuf, sizeof(int) * (size_t)(dims[0] * dims[1]))) TEST_ERROR
+        if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+
+        /* Delete the dataset, releasing the chunks and the index */
+        if(H5Ldelete(fid, tc->name, H5P_DEFAULT) < 0) FAIL_STACK_ERROR
+    } /* end for */
+
+    if(H5Fclose(fid) < 0) FAIL_STACK_ERROR
+
+    HDfree(wbuf);
+    HDfree(rbuf);
+
+    PASSED();
+
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Pclose(dcpl);
+        H5Dclose(dsid);
+        H5Sclose(sid);
+        H5Fclose(fid);
+    } H5E_END_TRY;
+    if(wbuf)
+        HDfree(wbuf);
+    if(rbuf)
+        HDfree(rbuf);
+    return -1;
+} /* end test_chunk_index() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    test_chunk_cache_arc
+ *
+ * Purpose:     Tests the replacement policy & statistics of the raw data
+ *              chunk cache: chunks accessed more than once survive a scan
+ *              through the dataset, and misses on recently evicted chunks
+ *              are counted.  Then tests a chunk cache shared by two
+ *              datasets in the file, with dirty chunks evicted by the other
+ *              dataset and by a second object for the same dataset.
+ *
+ * Return:      Success: 0
+ *              Failure: -1
+ *
+ *-------------------------------------------------------------------------
+ */
+#define CHUNK_ARC_NCHUNKS       100
+#define CHUNK_ARC_CHUNK         256
+#define CHUNK_ARC_DIM           (CHUNK_ARC_NCHUNKS * CHUNK_ARC_CHUNK)
+#define CHUNK_ARC_CACHE_NCHUNKS 10
+static herr_t
+test_chunk_cache_arc(hid_t fapl)
+{
+    char        filename[FILENAME_BUF_SIZE];
+    hid_t       my_fapl = -1;   /* File access property list ID */
+    hid_t       fid = -1;       /* File ID */
+    hid_t       dcpl = -1;      /* Dataset creation property list ID */
+    hid_t       dapl = -1;      /* Dataset access property list ID */
+    hid_t       sid = -1;       /* Dataspace ID */
+    hid_t       msid = -1;      /* Memory dataspace ID */
+    hid_t       dsid[3] = {-1, -1, -1};     /* Dataset IDs */
+    hsize_t     dims[1] = {CHUNK_ARC_DIM};
+    hsize_t     chunk_dims[1] = {CHUNK_ARC_CHUNK};
+    hsize_t     start[1], count[1];
+    size_t      cache_nbytes = CHUNK_ARC_CACHE_NCHUNKS * CHUNK_ARC_CHUNK * sizeof(int);
+    size_t      shared_nbytes;  /* Size of shared chunk cache */
+    H5D_chunk_cache_stats_t stats, stats2;  /* Chunk cache statistics */
+    int        *wbuf = NULL;    /* Buffer for writing data */
+    int         rbuf[CHUNK_ARC_CHUNK];      /* Buffer for reading a chunk */
+    hsize_t     nmisses;        /* # of misses before reading */
+    herr_t      ret;            /* Generic return value */
+    int         i, j, pass;     /* Local index variables */
+
+    TESTING("chunk cache replacement policy and shared chunk cache");
+
+    h5_fixname(FILENAME[16], fapl, filename, sizeof filename);
+
+    if(NULL == (wbuf = (int *)HDmalloc(sizeof(int) * CHUNK_ARC_DIM))) TEST_ERROR
+    for(i = 0; i < CHUNK_ARC_DIM; i++)
+        wbuf[i] = i;
+
+    /* Check the FAPL property */
+    if((my_fapl = H5Pcopy(fapl)) < 0) FAIL_STACK_ERROR
+    if(H5Pget_shared_chunk_cache(my_fapl, &shared_nbytes) < 0) FAIL_STACK_ERROR
+    if(shared_nbytes != 0) TEST_ERROR
+
+    /* Create file, with a chunk cache for each dataset */
+    if((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, my_fapl)) < 0) FAIL_STACK_ERROR
+
+    if((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0) FAIL_STACK_ERROR
+    if(H5Pset_chunk(dcpl, 1, chunk_dims) < 0) FAIL_STACK_ERROR
+    if((dapl = H5Pcreate(H5P_DATASET_ACCESS)) < 0) FAIL_STACK_ERROR
+    if(H5Pset_chunk_cache(dapl, (size_t)7, cache_nbytes, 0.0f) < 0) FAIL_STACK_ERROR
+    if((sid = H5Screate_simple(1, dims, NULL)) < 0) FAIL_STACK_ERROR
+    count[0] = CHUNK_ARC_CHUNK;
+    if((msid = H5Screate_simple(1, count, NULL)) < 0) FAIL_STACK_ERROR
+
+    if((dsid[0] = H5Dcreate2(fid, "dset0", H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, dapl)) < 0) FAIL_STACK_ERROR
+    if(H5Dwrite(dsid[0], H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, wbuf) < 0) FAIL_STACK_ERROR
+
+    /* Check the statistics, which a contiguous dataset doesn't have */
+    if(H5Dget_chunk_cache_stats(dsid[0], &stats) < 0) FAIL_STACK_ERROR
+    if(stats.pool_shared || stats.pool_nbytes_max != cache_nbytes) TEST_ERROR
+    if(stats.nbytes_used > cache_nbytes || stats.pool_nbytes_used != stats.nbytes_used) TEST_ERROR
+    if(stats.ninits == 0 && stats.nhits == 0) TEST_ERROR
+    if(H5Dreset_chunk_cache_stats(dsid[0]) < 0) FAIL_STACK_ERROR
+    if(H5Dget_chunk_cache_stats(dsid[0], &stats) < 0) FAIL_STACK_ERROR
+    if(stats.nhits != 0 || stats.nmisses != 0 || stats.ninits != 0 || stats.nevictions != 0) TEST_ERROR
+    H5E_BEGIN_TRY {
+        ret = H5Dget_chunk_cache_stats(fid, &stats);
+    } H5E_END_TRY;
+    if(ret >= 0) TEST_ERROR
+
+    /* Read the first few chunks twice, so they are frequently used */
+    for(pass = 0; pass < 2; pass++)
+        for(i = 0; i < 4; i++) {
+            start[0] = (hsize_t)(i * CHUNK_ARC_CHUNK);
+            if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, start, NULL, count, NULL) < 0) FAIL_STACK_ERROR
+            if(H5Dread(dsid[0], H5T_NATIVE_INT, msid, sid, H5P_DEFAULT, rbuf) < 0) FAIL_STACK_ERROR
+        } /* end for */
+
+    /* Scan through the rest of the dataset, once */
+    for(i = 4; i < CHUNK_ARC_NCHUNKS; i++) {
+        start[0] = (hsize_t)(i * CHUNK_ARC_CHUNK);
+        if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, start, NULL, count, NULL) < 0) FAIL_STACK_ERROR
+        if(H5Dread(dsid[0], H5T_NATIVE_INT, msid, sid, H5P_DEFAULT, rbuf) < 0) FAIL_STACK_ERROR
+        for(j = 0; j < CHUNK_ARC_CHUNK; j++)
+            if(rbuf[j] != wbuf[i * CHUNK_ARC_CHUNK + j]) TEST_ERROR
+    } /* end for */
+    if(H5Dget_chunk_cache_stats(dsid[0], &stats) < 0) FAIL_STACK_ERROR
+    if(stats.nevictions == 0) TEST_ERROR
+    if(stats.nbytes_used > cache_nbytes) TEST_ERROR
+
+    /* The frequently used chunks should still be cached */
+    nmisses = stats.nmisses;
+    for(i = 0; i < 4; i++) {
+        start[0] = (hsize_t)(i * CHUNK_ARC_CHUNK);
+        if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, start, NULL, count, NULL) < 0) FAIL_STACK_ERROR
+        if(H5Dread(dsid[0], H5T_NATIVE_INT, msid, sid, H5P_DEFAULT, rbuf) < 0) FAIL_STACK_ERROR
+    } /* end for */
+    if(H5Dget_chunk_cache_stats(dsid[0], &stats) < 0) FAIL_STACK_ERROR
+    if(stats.nmisses != nmisses) TEST_ERROR
+
+    /* Reading chunks evicted a little while ago should hit their ghosts */
+    for(i = CHUNK_ARC_NCHUNKS - CHUNK_ARC_CACHE_NCHUNKS; i < CHUNK_ARC_NCHUNKS; i++) {
+        start[0] = (hsize_t)(i * CHUNK_ARC_CHUNK);
+        if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, start, NULL, count, NULL) < 0) FAIL_STACK_ERROR
+        if(H5Dread(dsid[0], H5T_NATIVE_INT, msid, sid, H5P_DEFAULT, rbuf) < 0) FAIL_STACK_ERROR
+        for(j = 0; j < CHUNK_ARC_CHUNK; j++)
+            if(rbuf[j] != wbuf[i * CHUNK_ARC_CHUNK + j]) TEST_ERROR
+    } /* end for */
+    if(H5Dget_chunk_cache_stats(dsid[0], &stats) < 0) FAIL_STACK_ERROR
+    if(stats.nghost_hits == 0) TEST_ERROR
+
+    if(H5Dclose(dsid[0]) < 0) FAIL_STACK_ERROR
+    if(H5Fclose(fid) < 0) FAIL_STACK_ERROR
+
+    /* Re-open the file, with a chunk cache shared by the datasets, which is
+     * smaller than the per-dataset cache */
+    if(H5Pset_shared_chunk_cache(my_fapl, cache_nbytes / 2) < 0) FAIL_STACK_ERROR
+    if(H5Pget_shared_chunk_cache(my_fapl, &shared_nbytes) < 0) FAIL_STACK_ERROR
+    if(shared_nbytes != cache_nbytes / 2) TEST_ERROR
+    if((fid = H5Fopen(filename, H5F_ACC_RDWR, my_fapl)) < 0) FAIL_STACK_ERROR
+
+    if((dsid[0] = H5Dopen2(fid, "dset0", dapl)) < 0) FAIL_STACK_ERROR
+    if((dsid[1] = H5Dcreate2(fid, "dset1", H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, dapl)) < 0) FAIL_STACK_ERROR
+
+    /* Write to both datasets, a chunk at a time.  The second half of "dset0"
+     * is written through a second object for the dataset, which is closed
+     * while its chunks are still cached. */
+    for(i = 0; i < CHUNK_ARC_DIM; i++)
+        wbuf[i] = -i;
+    if((dsid[2] = H5Dopen2(fid, "dset0", dapl)) < 0) FAIL_STACK_ERROR
+    for(i = 0; i < CHUNK_ARC_NCHUNKS; i++) {
+        start[0] = (hsize_t)(i * CHUNK_ARC_CHUNK);
+        if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, start, NULL, count, NULL) < 0) FAIL_STACK_ERROR
+        if(H5Dwrite(dsid[i < CHUNK_ARC_NCHUNKS / 2 ? 0 : 2], H5T_NATIVE_INT, msid, sid, H5P_DEFAULT, wbuf + i * CHUNK_ARC_CHUNK) < 0) FAIL_STACK_ERROR
+        if(H5Dwrite(dsid[1], H5T_NATIVE_INT, msid, sid, H5P_DEFAULT, wbuf + i * CHUNK_ARC_CHUNK) < 0) FAIL_STACK_ERROR
+    } /* end for */
+    if(H5Dclose(dsid[2]) < 0) FAIL_STACK_ERROR
+
+    /* Check the statistics of the shared cache */
+    if(H5Dget_chunk_cache_stats(dsid[0], &stats) < 0) FAIL_STACK_ERROR
+    if(H5Dget_chunk_cache_stats(dsid[1], &stats2) < 0) FAIL_STACK_ERROR
+    if(!stats.pool_shared || !stats2.pool_shared) TEST_ERROR
+    if(stats.pool_nbytes_max != cache_nbytes / 2 || stats2.pool_nbytes_max != cache_nbytes / 2) TEST_ERROR
+    if(stats.pool_nbytes_used != stats2.pool_nbytes_used) TEST_ERROR
+    if(stats.nbytes_used + stats2.nbytes_used != stats.pool_nbytes_used) TEST_ERROR
+    if(stats.pool_nbytes_used > cache_nbytes / 2) TEST_ERROR
+    if(stats.nevictions == 0 || stats2.nevictions == 0) TEST_ERROR
+
+    /* Read the datasets back, through the shared cache */
+    for(i = 0; i < CHUNK_ARC_NCHUNKS; i++) {
+        start[0] = (hsize_t)(i * CHUNK_ARC_CHUNK);
+        if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, start, NULL, count, NULL) < 0) FAIL_STACK_ERROR
+        for(pass = 0; pass < 2; pass++) {
+            HDmemset(rbuf, 0, sizeof(rbuf));
+            if(H5Dread(dsid[pass], H5T_NATIVE_INT, msid, sid, H5P_DEFAULT, rbuf) < 0) FAIL_STACK_ERROR
+            for(j = 0; j < CHUNK_ARC_CHUNK; j++)
+                if(rbuf[j] != wbuf[i * CHUNK_ARC_CHUNK + j]) TEST_ERROR
+        } /* end for */
+    } /* end for */
+
+    if(H5Dclose(dsid[0]) < 0) FAIL_STACK_ERROR
+    if(H5Dclose(dsid[1]) < 0) FAIL_STACK_ERROR
+    if(H5Fclose(fid) < 0) FAIL_STACK_ERROR
+
+    /* Verify the data in the file */
+    if((fid = H5Fopen(filename, H5F_ACC_RDONLY, fapl)) < 0) FAIL_STACK_ERROR
+    for(i = 0; i < 2; i++) {
+        char dset_name[16];
+
+        HDsnprintf(dset_name, sizeof(dset_name), "dset%d", i);
+        if((dsid[i] = H5Dopen2(fid, dset_name, H5P_DEFAULT)) < 0) FAIL_STACK_ERROR
+        HDmemset(wbuf, 0, sizeof(int) * CHUNK_ARC_DIM);
+        if(H5Dread(dsid[i], H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, wbuf) < 0) FAIL_STACK_ERROR
+        for(j = 0; j < CHUNK_ARC_DIM; j++)
+            if(wbuf[j] != -j) TEST_ERROR
+        if(H5Dclose(dsid[i]) < 0) FAIL_STACK_ERROR
+    } /* end for */
+    if(H5Fclose(fid) < 0) FAIL_STACK_ERROR
+
+    /* Close everything */
+    if(H5Sclose(msid) < 0) FAIL_STACK_ERROR
+    if(H5Sclose(sid) < 0) FAIL_STACK_ERROR
+    if(H5Pclose(dapl) < 0) FAIL_STACK_ERROR
+    if(H5Pclose(dcpl) < 0) FAIL_STACK_ERROR
+    if(H5Pclose(my_fapl) < 0) FAIL_STACK_ERROR
+
+    HDfree(wbuf);
+
+    PASSED();
+
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Pclose(dcpl);
+        H5Pclose(dapl);
+        H5Pclose(my_fapl);
+        H5Dclose(dsid[0]);
+        H5Dclose(dsid[1]);
+        H5Dclose(dsid[2]);
+        H5Sclose(msid);
+        H5Sclose(sid);
+        H5Fclose(fid);
+    } H5E_END_TRY;
+    if(wbuf)
+        HDfree(wbuf);
+    return -1;
+} /* end test_chunk_cache_arc() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    test_chunk_prefetch
+ *
+ * Purpose:     Tests reading chunks ahead when a filtered dataset is read
+ *              sequentially, with H5Pset_chunk_prefetch(), and writing
+ *              chunks evicted from the chunk cache behind, with
+ *              H5Pset_chunk_write_behind().
+ *
+ * Return:      Success: 0
+ *              Failure: -1
+ *
+ *-------------------------------------------------------------------------
+ */
+#define CHUNK_PREFETCH_NCHUNKS  40
+#define CHUNK_PREFETCH_CHUNK    512
+#define CHUNK_PREFETCH_DIM      (CHUNK_PREFETCH_NCHUNKS * CHUNK_PREFETCH_CHUNK)
+static herr_t
+test_chunk_prefetch(hid_t fapl)
+{
+    char        filename[FILENAME_BUF_SIZE];
+    hid_t       fid = -1;       /* File ID */
+    hid_t       dcpl = -1;      /* Dataset creation property list ID */
+    hid_t       dapl = -1;      /* Dataset access property list ID */
+    hid_t       sid = -1;       /* Dataspace ID */
+    hid_t       msid = -1;      /* Memory dataspace ID */
+    hid_t       dsid = -1;      /* Dataset ID */
+    hsize_t     dims[1] = {CHUNK_PREFETCH_DIM};
+    hsize_t     chunk_dims[1] = {CHUNK_PREFETCH_CHUNK};
+    hsize_t     start[1], count[1];
+    size_t      nchunks;        /* # of chunks to read ahead/write behind */
+    H5D_chunk_cache_stats_t stats;  /* Chunk cache statistics */
+    int        *wbuf = NULL;    /* Buffer for writing data */
+    int        *rbuf = NULL;    /* Buffer for reading data */
+    int         i, j;           /* Local index variables */
+
+    TESTING("chunk read-ahead and write-behind");
+
+    h5_fixname(FILENAME[17], fapl, filename, sizeof filename);
+
+    if(NULL == (wbuf = (int *)HDmalloc(sizeof(int) * CHUNK_PREFETCH_DIM))) TEST_ERROR
+    if(NULL == (rbuf = (int *)HDmalloc(sizeof(int) * CHUNK_PREFETCH_DIM))) TEST_ERROR
+    for(i = 0; i < CHUNK_PREFETCH_DIM; i++)
+        wbuf[i] = (i * 7) % 1013;
+
+    /* Check the DAPL properties */
+    if((dapl = H5Pcreate(H5P_DATASET_ACCESS)) < 0) FAIL_STACK_ERROR
+    if(H5Pget_chunk_prefetch(dapl, &nchunks) < 0) FAIL_STACK_ERROR
+    if(nchunks != 0) TEST_ERROR
+    if(H5Pget_chunk_write_behind(dapl, &nchunks) < 0) FAIL_STACK_ERROR
+    if(nchunks != 0) TEST_ERROR
+    if(H5Pset_chunk_prefetch(dapl, (size_t)4) < 0) FAIL_STACK_ERROR
+    if(H5Pget_chunk_prefetch(dapl, &nchunks) < 0) FAIL_STACK_ERROR
+    if(nchunks != 4) TEST_ERROR
+    if(H5Pset_chunk_write_behind(dapl, (size_t)3) < 0) FAIL_STACK_ERROR
+    if(H5Pget_chunk_write_behind(dapl, &nchunks) < 0) FAIL_STACK_ERROR
+    if(nchunks != 3) TEST_ERROR
+
+    /* Use a chunk cache that holds only a few chunks */
+    if(H5Pset_chunk_cache(dapl, (size_t)101, 4 * CHUNK_PREFETCH_CHUNK * sizeof(int), 1.0f) < 0) FAIL_STACK_ERROR
+
+    /* Create file */
+    if((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0) FAIL_STACK_ERROR
+
+    /* Create dataset creation property list, with several filters */
+    if((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0) FAIL_STACK_ERROR
+    if(H5Pset_chunk(dcpl, 1, chunk_dims) < 0) FAIL_STACK_ERROR
+    if(H5Pset_shuffle(dcpl) < 0) FAIL_STACK_ERROR
+#ifdef H5_HAVE_FILTER_DEFLATE
+    if(H5Pset_deflate(dcpl, 6) < 0) FAIL_STACK_ERROR
+#endif /* H5_HAVE_FILTER_DEFLATE */
+    if(H5Pset_fletcher32(dcpl) < 0) FAIL_STACK_ERROR
+
+    if((sid = H5Screate_simple(1, dims, NULL)) < 0) FAIL_STACK_ERROR
+    count[0] = CHUNK_PREFETCH_CHUNK;
+    if((msid = H5Screate_simple(1, count, NULL)) < 0) FAIL_STACK_ERROR
+
+    /* Write the whole dataset, evicting chunks as it goes */
+    if((dsid = H5Dcreate2(fid, "dset", H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, dapl)) < 0) FAIL_STACK_ERROR
+    if(H5Dwrite(dsid, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, wbuf) < 0) FAIL_STACK_ERROR
+    if(H5Dget_chunk_cache_stats(dsid, &stats) < 0) FAIL_STACK_ERROR
+    if(stats.nwrite_behinds == 0) TEST_ERROR
+    if(stats.nprefetches != 0) TEST_ERROR
+    if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+
+    /* Read the dataset a chunk at a time, in order */
+    if((dsid = H5Dopen2(fid, "dset", dapl)) < 0) FAIL_STACK_ERROR
+    for(i = 0; i < CHUNK_PREFETCH_NCHUNKS; i++) {
+        start[0] = (hsize_t)(i * CHUNK_PREFETCH_CHUNK);
+        if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, start, NULL, count, NULL) < 0) FAIL_STACK_ERROR
+        HDmemset(rbuf, 0, sizeof(int) * CHUNK_PREFETCH_CHUNK);
+        if(H5Dread(dsid, H5T_NATIVE_INT, msid, sid, H5P_DEFAULT, rbuf) < 0) FAIL_STACK_ERROR
+        for(j = 0; j < CHUNK_PREFETCH_CHUNK; j++)
+            if(rbuf[j] != wbuf[i * CHUNK_PREFETCH_CHUNK + j]) TEST_ERROR
+    } /* end for */
+    if(H5Dget_chunk_cache_stats(dsid, &stats) < 0) FAIL_STACK_ERROR
+    if(stats.nprefetches == 0 || stats.nprefetch_hits == 0) TEST_ERROR
+    if(stats.nprefetch_hits > stats.nprefetches) TEST_ERROR
+
+    /* Overwrite every other chunk, backwards, then read them back backwards */
+    for(i = 0; i < CHUNK_PREFETCH_DIM; i++)
+        if((i / CHUNK_PREFETCH_CHUNK) % 2)
+            wbuf[i] = -wbuf[i];
+    for(i = CHUNK_PREFETCH_NCHUNKS - 1; i >= 0; i -= 2) {
+        start[0] = (hsize_t)(i * CHUNK_PREFETCH_CHUNK);
+        if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, start, NULL, count, NULL) < 0) FAIL_STACK_ERROR
+        if(H5Dwrite(dsid, H5T_NATIVE_INT, msid, sid, H5P_DEFAULT, wbuf + i * CHUNK_PREFETCH_CHUNK) < 0) FAIL_STACK_ERROR
+    } /* end for */
+    for(i = CHUNK_PREFETCH_NCHUNKS - 1; i >= 0; i--) {
+        start[0] = (hsize_t)(i * CHUNK_PREFETCH_CHUNK);
+        if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, start, NULL, count, NULL) < 0) FAIL_STACK_ERROR
+        HDmemset(rbuf, 0, sizeof(int) * CHUNK_PREFETCH_CHUNK);
+        if(H5Dread(dsid, H5T_NATIVE_INT, msid, sid, H5P_DEFAULT, rbuf) < 0) FAIL_STACK_ERROR
+        for(j = 0; j < CHUNK_PREFETCH_CHUNK; j++)
+            if(rbuf[j] != wbuf[i * CHUNK_PREFETCH_CHUNK + j]) TEST_ERROR
+    } /* end for */
+    if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+    if(H5Fclose(fid) < 0) FAIL_STACK_ERROR
+
+    /* Verify the data in the file */
+    if((fid = H5Fopen(filename, H5F_ACC_RDONLY, fapl)) < 0) FAIL_STACK_ERROR
+    if((dsid = H5Dopen2(fid, "dset", H5P_DEFAULT)) < 0) FAIL_STACK_ERROR
+    HDmemset(rbuf, 0, sizeof(int) * CHUNK_PREFETCH_DIM);
+    if(H5Dread(dsid, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, rbuf) < 0) FAIL_STACK_ERROR
+    for(i = 0; i < CHUNK_PREFETCH_DIM; i++)
+        if(rbuf[i] != wbuf[i]) TEST_ERROR
+    if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+    if(H5Fclose(fid) < 0) FAIL_STACK_ERROR
+
+    /* Close everything */
+    if(H5Sclose(msid) < 0) FAIL_STACK_ERROR
+    if(H5Sclose(sid) < 0) FAIL_STACK_ERROR
+    if(H5Pclose(dapl) < 0) FAIL_STACK_ERROR
+    if(H5Pclose(dcpl) < 0) FAIL_STACK_ERROR
+
+    HDfree(wbuf);
+    HDfree(rbuf);
+
+    PASSED();
+
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Pclose(dcpl);
+        H5Pclose(dapl);
+        H5Dclose(dsid);
+        H5Sclose(msid);
+        H5Sclose(sid);
+        H5Fclose(fid);
+    } H5E_END_TRY;
+    if(wbuf)
+        HDfree(wbuf);
+    if(rbuf)
+        HDfree(rbuf);
+    return -1;
+} /* end test_chunk_prefetch() */
+
 
 /*-------------------------------------------------------------------------
  * Function:    test_scatter
@@ -9148,6 +10128,8 @@ main(void)
         nerrors += (test_max_compact(my_fapl) < 0  		? 1 : 0);
         nerrors += (test_conv_buffer(file) < 0		        ? 1 : 0);
         nerrors += (test_tconv(file) < 0			? 1 : 0);
+        nerrors += (test_tconv_inplace(file) < 0		? 1 : 0);
+        nerrors += (test_multi_io(file) < 0		        ? 1 : 0);
         nerrors += (test_filters(file, my_fapl) < 0		? 1 : 0);
         nerrors += (test_onebyte_shuffle(file) < 0 		? 1 : 0);
         nerrors += (test_nbit_int(file) < 0 		        ? 1 : 0);
@@ -9190,6 +10172,10 @@ main(void)
         nerrors += (test_layout_extend(my_fapl) < 0		? 1 : 0);
         nerrors += (test_large_chunk_shrink(my_fapl) < 0        ? 1 : 0);
         nerrors += (test_zero_dim_dset(my_fapl) < 0             ? 1 : 0);
+        nerrors += (test_filter_nthreads(my_fapl) < 0           ? 1 : 0);
+        nerrors += (test_chunk_index(my_fapl, (hbool_t)new_format) < 0 ? 1 : 0);
+        nerrors += (test_chunk_cache_arc(my_fapl) < 0           ? 1 : 0);
+        nerrors += (test_chunk_prefetch(my_fapl) < 0            ? 1 : 0);
 
         if(H5Fclose(file) < 0)
             goto error;
@@ -101,6 +101,9 @@ typedef enum dtype_t {
 /* Constant for size of conversion buffer for int <-> float exception test */
 #define CONVERT_SIZE    4
 
+/* Number of elements for test_conv_packed (not a multiple of the block size) */
+#define PACKED_NELMTS   1000
+
 /* Constants for compound_13 test */
 #define COMPOUND13_ARRAY_SIZE   256
 #define COMPOUND13_ATTR_NAME    "attr"
@@ -3397,6 +3400,114 @@ error:
 } /* end test_compound_18() */
 
 
+/*-------------------------------------------------------------------------
+ * Function:    test_compound_19
+ *
+ * Purpose:     Tests compound conversions which mix members needing no
+ *              conversion (copied directly, with adjacent members
+ *              coalesced), converted members, reordered members and
+ *              dropped members, in both the narrowing and the widening
+ *              direction.
+ *
+ * Return:      Success:        0
+ *              Failure:        number of errors
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+test_compound_19(void)
+{
+    typedef struct src_t {
+        int     a;
+        int     b;
+        short   c;
+        int     d;
+        double  e;
+        int     f;
+    } src_t;
+    typedef struct dst_t {
+        double  e;
+        int     a;
+        int     b;
+        long long c;
+        int     d;
+    } dst_t;
+    const size_t nelmts = 100;
+    src_t       *buf = NULL;            /* Conversion buffer */
+    dst_t       *dbuf;                  /* Conversion buffer, as destination */
+    void        *bkg = NULL;            /* Background buffer */
+    hid_t       src_tid = -1, dst_tid = -1;
+    size_t      u;
+
+    TESTING("compound conversion with copied and converted members");
+
+    /* Source compound datatype */
+    if((src_tid = H5Tcreate(H5T_COMPOUND, sizeof(src_t))) < 0) TEST_ERROR
+    if(H5Tinsert(src_tid, "a", HOFFSET(src_t, a), H5T_NATIVE_INT) < 0) TEST_ERROR
+    if(H5Tinsert(src_tid, "b", HOFFSET(src_t, b), H5T_NATIVE_INT) < 0) TEST_ERROR
+    if(H5Tinsert(src_tid, "c", HOFFSET(src_t, c), H5T_NATIVE_SHORT) < 0) TEST_ERROR
+    if(H5Tinsert(src_tid, "d", HOFFSET(src_t, d), H5T_NATIVE_INT) < 0) TEST_ERROR
+    if(H5Tinsert(src_tid, "e", HOFFSET(src_t, e), H5T_NATIVE_DOUBLE) < 0) TEST_ERROR
+    if(H5Tinsert(src_tid, "f", HOFFSET(src_t, f), H5T_NATIVE_INT) < 0) TEST_ERROR
+
+    /* Destination compound datatype, reordered, without "f" and with a
+     * wider "c" */
+    if((dst_tid = H5Tcreate(H5T_COMPOUND, sizeof(dst_t))) < 0) TEST_ERROR
+    if(H5Tinsert(dst_tid, "e", HOFFSET(dst_t, e), H5T_NATIVE_DOUBLE) < 0) TEST_ERROR
+    if(H5Tinsert(dst_tid, "a", HOFFSET(dst_t, a), H5T_NATIVE_INT) < 0) TEST_ERROR
+    if(H5Tinsert(dst_tid, "b", HOFFSET(dst_t, b), H5T_NATIVE_INT) < 0) TEST_ERROR
+    if(H5Tinsert(dst_tid, "c", HOFFSET(dst_t, c), H5T_NATIVE_LLONG) < 0) TEST_ERROR
+    if(H5Tinsert(dst_tid, "d", HOFFSET(dst_t, d), H5T_NATIVE_INT) < 0) TEST_ERROR
+
+    if(NULL == (buf = (src_t *)HDmalloc(nelmts * MAX(sizeof(src_t), sizeof(dst_t))))) TEST_ERROR
+    if(NULL == (bkg = HDcalloc(nelmts, MAX(sizeof(src_t), sizeof(dst_t))))) TEST_ERROR
+
+    /* Convert source to destination */
+    for(u = 0; u < nelmts; u++) {
+        buf[u].a = (int)u;
+        buf[u].b = (int)u * 2;
+        buf[u].c = (short)(u * 3);
+        buf[u].d = (int)u * 4;
+        buf[u].e = (double)u * 5.0;
+        buf[u].f = -1;
+    } /* end for */
+    if(H5Tconvert(src_tid, dst_tid, nelmts, buf, bkg, H5P_DEFAULT) < 0) TEST_ERROR
+    dbuf = (dst_t *)buf;
+    for(u = 0; u < nelmts; u++)
+        if(dbuf[u].a != (int)u || dbuf[u].b != (int)u * 2 ||
+                dbuf[u].c != (long long)(u * 3) || dbuf[u].d != (int)u * 4 ||
+                !H5_DBL_ABS_EQUAL(dbuf[u].e, (double)u * 5.0))
+            TEST_ERROR
+
+    /* Convert back, into a background buffer providing "f" */
+    for(u = 0; u < nelmts; u++)
+        ((src_t *)bkg)[u].f = (int)u * 6;
+    if(H5Tconvert(dst_tid, src_tid, nelmts, buf, bkg, H5P_DEFAULT) < 0) TEST_ERROR
+    for(u = 0; u < nelmts; u++)
+        if(buf[u].a != (int)u || buf[u].b != (int)u * 2 ||
+                buf[u].c != (short)(u * 3) || buf[u].d != (int)u * 4 ||
+                !H5_DBL_ABS_EQUAL(buf[u].e, (double)u * 5.0) || buf[u].f != (int)u * 6)
+            TEST_ERROR
+
+    if(H5Tclose(src_tid) < 0) TEST_ERROR
+    if(H5Tclose(dst_tid) < 0) TEST_ERROR
+    HDfree(buf);
+    HDfree(bkg);
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Tclose(src_tid);
+        H5Tclose(dst_tid);
+    } H5E_END_TRY;
+    HDfree(buf);
+    HDfree(bkg);
+    return 1;
+} /* end test_compound_19() */
+
+
 /*-------------------------------------------------------------------------
  * Function:    test_query
  *
@@ -6184,6 +6295,100 @@ error:
 } /* end test_int_float_except() */
 
 
+/*-------------------------------------------------------------------------
+ * Function:    test_conv_packed
+ *
+ * Purpose:     Tests hard conversions and byte-order swapping of packed
+ *              buffers with no exception handler, which take the blocked
+ *              conversion path: in-place widening, narrowing with
+ *              clipping to the destination range, and swapping 2, 4 and
+ *              8 byte elements.
+ *
+ * Return:      Success:        0
+ *              Failure:        number of errors
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+test_conv_packed(void)
+{
+    void        *buf = NULL;            /* Conversion buffer */
+    unsigned char *orig = NULL;         /* Copy of the bytes to swap */
+    short       *sbuf;                  /* Buffer, as shorts */
+    long long   *llbuf;                 /* Buffer, as long longs */
+    double      *dbuf;                  /* Buffer, as doubles */
+    float       *fbuf;                  /* Buffer, as floats */
+    unsigned char *bbuf;                /* Buffer, as bytes */
+    hid_t       be_type[3] = {H5T_STD_U16BE, H5T_STD_U32BE, H5T_STD_U64BE};
+    hid_t       le_type[3] = {H5T_STD_U16LE, H5T_STD_U32LE, H5T_STD_U64LE};
+    size_t      size;                   /* Size of swapped element */
+    unsigned    u, v;                   /* Local index variables */
+
+    TESTING("conversions of packed buffers");
+
+    if(NULL == (buf = HDmalloc(PACKED_NELMTS * sizeof(long long)))) TEST_ERROR
+    if(NULL == (orig = (unsigned char *)HDmalloc(PACKED_NELMTS * 8))) TEST_ERROR
+
+    /* Widen short to long long in place */
+    sbuf = (short *)buf;
+    for(u = 0; u < PACKED_NELMTS; u++)
+        sbuf[u] = (short)((int)u - (PACKED_NELMTS / 2));
+    if(H5Tconvert(H5T_NATIVE_SHORT, H5T_NATIVE_LLONG, (size_t)PACKED_NELMTS, buf, NULL, H5P_DEFAULT) < 0) TEST_ERROR
+    llbuf = (long long *)buf;
+    for(u = 0; u < PACKED_NELMTS; u++)
+        if(llbuf[u] != (long long)u - (PACKED_NELMTS / 2)) TEST_ERROR
+
+    /* Narrow long long to short in place, clipping out of range values */
+    for(u = 0; u < PACKED_NELMTS; u++)
+        llbuf[u] = ((long long)u - (PACKED_NELMTS / 2)) * 100;
+    if(H5Tconvert(H5T_NATIVE_LLONG, H5T_NATIVE_SHORT, (size_t)PACKED_NELMTS, buf, NULL, H5P_DEFAULT) < 0) TEST_ERROR
+    for(u = 0; u < PACKED_NELMTS; u++) {
+        long long expect = ((long long)u - (PACKED_NELMTS / 2)) * 100;
+
+        if(expect > SHRT_MAX)
+            expect = SHRT_MAX;
+        else if(expect < SHRT_MIN)
+            expect = SHRT_MIN;
+        if(sbuf[u] != (short)expect) TEST_ERROR
+    } /* end for */
+
+    /* Narrow double to float in place, overflowing to infinity */
+    dbuf = (double *)buf;
+    for(u = 0; u < PACKED_NELMTS; u++)
+        dbuf[u] = (u % 100) ? (double)u * 0.25 : -1.0e300;
+    if(H5Tconvert(H5T_NATIVE_DOUBLE, H5T_NATIVE_FLOAT, (size_t)PACKED_NELMTS, buf, NULL, H5P_DEFAULT) < 0) TEST_ERROR
+    fbuf = (float *)buf;
+    for(u = 0; u < PACKED_NELMTS; u++) {
+        if(u % 100) {
+            if(fbuf[u] != (float)u * 0.25f) TEST_ERROR
+        } /* end if */
+        else if(!(fbuf[u] < -FLT_MAX)) TEST_ERROR
+    } /* end for */
+
+    /* Swap the byte order of 2, 4 and 8 byte elements */
+    bbuf = (unsigned char *)buf;
+    for(u = 0; u < 3; u++) {
+        size = H5Tget_size(be_type[u]);
+        for(v = 0; v < PACKED_NELMTS * size; v++)
+            orig[v] = bbuf[v] = (unsigned char)(v * 7);
+        if(H5Tconvert(be_type[u], le_type[u], (size_t)PACKED_NELMTS, buf, NULL, H5P_DEFAULT) < 0) TEST_ERROR
+        for(v = 0; v < PACKED_NELMTS * size; v++)
+            if(bbuf[v] != orig[(v - (v % size)) + (size - 1 - (v % size))]) TEST_ERROR
+    } /* end for */
+
+    HDfree(buf);
+    HDfree(orig);
+
+    PASSED();
+    return 0;
+
+error:
+    HDfree(buf);
+    HDfree(orig);
+    return 1;
+} /* end test_conv_packed() */
+
+
 /*-------------------------------------------------------------------------
  * Function:    test_set_order
  *
@@ -7438,6 +7643,7 @@ main(void)
     nerrors += test_encode();
     nerrors += test_latest();
     nerrors += test_int_float_except();
+    nerrors += test_conv_packed();
     nerrors += test_named_indirect_reopen(fapl);
     nerrors += test_delete_obj_named(fapl);
     nerrors += test_delete_obj_named_fileid(fapl);
@@ -7470,6 +7676,7 @@ main(void)
     nerrors += test_compound_16();
     nerrors += test_compound_17();
     nerrors += test_compound_18();
+    nerrors += test_compound_19();
     nerrors += test_conv_enum_1();
     nerrors += test_conv_enum_2();
     nerrors += test_conv_bitfield();
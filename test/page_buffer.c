@@ -0,0 +1,401 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * Copyright by the Board of Trustees of the University of Illinois.         *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of HDF5.  The full HDF5 copyright notice, including     *
+ * terms governing use, modification, and redistribution, is contained in    *
+ * the files COPYING and Copyright.html.  COPYING can be found at the root   *
+ * of the source code distribution tree; Copyright.html can be found at the  *
+ * root level of an installed copy of the electronic HDF5 document set and   *
+ * is linked from the top-level documents page.  It can also be found at     *
+ * http://hdfgroup.org/HDF5/doc/Copyright.html.  If you do not have          *
+ * access to either file, you may request a copy from help@hdfgroup.org.     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/*
+ * Purpose:	Tests for paged aggregation of file space and the page
+ *		buffer.
+ */
+
+#include "h5test.h"
+
+const char *FILENAME[] = {
+    "page_buffer",
+    NULL
+};
+
+#define FILENAME_LEN    1024
+
+#define PAGE_SIZE       4096
+#define NUM_SMALL_DSETS 40
+#define SMALL_DSET_SIZE 300             /* # of ints in each small dataset */
+#define LARGE_DSET_SIZE 5000            /* # of ints in the large dataset */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    test_props
+ *
+ * Purpose:     Check setting and retrieving the file space page size and
+ *              the page buffer properties, including invalid values.
+ *
+ * Return:      Success:        0
+ *              Failure:        1
+ *
+ *-------------------------------------------------------------------------
+ */
+static unsigned
+test_props(void)
+{
+    hid_t       fcpl = -1, fapl = -1;
+    hsize_t     fsp_size;
+    size_t      buf_size;
+    unsigned    min_meta_perc, min_raw_perc;
+    herr_t      ret;
+
+    TESTING("file space page size and page buffer properties");
+
+    if((fcpl = H5Pcreate(H5P_FILE_CREATE)) < 0) TEST_ERROR
+    if((fapl = H5Pcreate(H5P_FILE_ACCESS)) < 0) TEST_ERROR
+
+    /* Check the defaults */
+    if(H5Pget_file_space_page_size(fcpl, &fsp_size) < 0) TEST_ERROR
+    if(fsp_size != 0) TEST_ERROR
+    if(H5Pget_page_buffer_size(fapl, &buf_size, &min_meta_perc, &min_raw_perc) < 0) TEST_ERROR
+    if(buf_size != 0 || min_meta_perc != 0 || min_raw_perc != 0) TEST_ERROR
+
+    /* Set and retrieve values */
+    if(H5Pset_file_space_page_size(fcpl, (hsize_t)PAGE_SIZE) < 0) TEST_ERROR
+    if(H5Pget_file_space_page_size(fcpl, &fsp_size) < 0) TEST_ERROR
+    if(fsp_size != PAGE_SIZE) TEST_ERROR
+    if(H5Pset_page_buffer_size(fapl, (size_t)(8 * PAGE_SIZE), 50, 25) < 0) TEST_ERROR
+    if(H5Pget_page_buffer_size(fapl, &buf_size, &min_meta_perc, &min_raw_perc) < 0) TEST_ERROR
+    if(buf_size != 8 * PAGE_SIZE || min_meta_perc != 50 || min_raw_perc != 25) TEST_ERROR
+
+    /* Invalid values */
+    H5E_BEGIN_TRY {
+        ret = H5Pset_file_space_page_size(fcpl, (hsize_t)100);
+    } H5E_END_TRY;
+    if(ret >= 0) TEST_ERROR
+    H5E_BEGIN_TRY {
+        ret = H5Pset_page_buffer_size(fapl, (size_t)PAGE_SIZE, 101, 0);
+    } H5E_END_TRY;
+    if(ret >= 0) TEST_ERROR
+    H5E_BEGIN_TRY {
+        ret = H5Pset_page_buffer_size(fapl, (size_t)PAGE_SIZE, 60, 50);
+    } H5E_END_TRY;
+    if(ret >= 0) TEST_ERROR
+
+    if(H5Pclose(fcpl) < 0) TEST_ERROR
+    if(H5Pclose(fapl) < 0) TEST_ERROR
+
+    PASSED()
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Pclose(fcpl);
+        H5Pclose(fapl);
+    } H5E_END_TRY;
+    return 1;
+} /* end test_props() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    write_datasets
+ *
+ * Purpose:     Create a number of small datasets and one large dataset in
+ *              FID, checking where their storage is placed in the file.
+ *
+ * Return:      Success:        0
+ *              Failure:        -1
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+write_datasets(hid_t fid)
+{
+    hid_t       sid = -1, did = -1;
+    hsize_t     dim;
+    haddr_t     offset;
+    int        *buf = NULL;
+    char        name[32];
+    unsigned    u, v;
+
+    if(NULL == (buf = (int *)HDmalloc(sizeof(int) * LARGE_DSET_SIZE))) TEST_ERROR
+
+    /* Small datasets must not cross a page boundary */
+    dim = SMALL_DSET_SIZE;
+    if((sid = H5Screate_simple(1, &dim, NULL)) < 0) TEST_ERROR
+    for(u = 0; u < NUM_SMALL_DSETS; u++) {
+        for(v = 0; v < SMALL_DSET_SIZE; v++)
+            buf[v] = (int)(u * 1000 + v);
+        HDsnprintf(name, sizeof(name), "small%u", u);
+        if((did = H5Dcreate2(fid, name, H5T_NATIVE_INT, sid, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT)) < 0) TEST_ERROR
+        if(H5Dwrite(did, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, buf) < 0) TEST_ERROR
+        if(HADDR_UNDEF == (offset = H5Dget_offset(did))) TEST_ERROR
+        if((offset % PAGE_SIZE) + SMALL_DSET_SIZE * sizeof(int) > PAGE_SIZE) TEST_ERROR
+        if(H5Dclose(did) < 0) TEST_ERROR
+    } /* end for */
+    if(H5Sclose(sid) < 0) TEST_ERROR
+
+    /* Large datasets start on a page boundary */
+    dim = LARGE_DSET_SIZE;
+    if((sid = H5Screate_simple(1, &dim, NULL)) < 0) TEST_ERROR
+    for(v = 0; v < LARGE_DSET_SIZE; v++)
+        buf[v] = (int)v * 3;
+    if((did = H5Dcreate2(fid, "large", H5T_NATIVE_INT, sid, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT)) < 0) TEST_ERROR
+    if(H5Dwrite(did, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, buf) < 0) TEST_ERROR
+    if(HADDR_UNDEF == (offset = H5Dget_offset(did))) TEST_ERROR
+    if(0 != (offset % PAGE_SIZE)) TEST_ERROR
+    if(H5Dclose(did) < 0) TEST_ERROR
+    if(H5Sclose(sid) < 0) TEST_ERROR
+
+    HDfree(buf);
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Dclose(did);
+        H5Sclose(sid);
+    } H5E_END_TRY;
+    if(buf)
+        HDfree(buf);
+    return -1;
+} /* end write_datasets() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    verify_datasets
+ *
+ * Purpose:     Read back and check the datasets created by
+ *              write_datasets().
+ *
+ * Return:      Success:        0
+ *              Failure:        -1
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+verify_datasets(hid_t fid)
+{
+    hid_t       did = -1;
+    int        *buf = NULL;
+    char        name[32];
+    unsigned    u, v;
+
+    if(NULL == (buf = (int *)HDmalloc(sizeof(int) * LARGE_DSET_SIZE))) TEST_ERROR
+
+    for(u = 0; u < NUM_SMALL_DSETS; u++) {
+        HDsnprintf(name, sizeof(name), "small%u", u);
+        if((did = H5Dopen2(fid, name, H5P_DEFAULT)) < 0) TEST_ERROR
+        if(H5Dread(did, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, buf) < 0) TEST_ERROR
+        for(v = 0; v < SMALL_DSET_SIZE; v++)
+            if(buf[v] != (int)(u * 1000 + v)) TEST_ERROR
+        if(H5Dclose(did) < 0) TEST_ERROR
+    } /* end for */
+
+    if((did = H5Dopen2(fid, "large", H5P_DEFAULT)) < 0) TEST_ERROR
+    if(H5Dread(did, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, buf) < 0) TEST_ERROR
+    for(v = 0; v < LARGE_DSET_SIZE; v++)
+        if(buf[v] != (int)v * 3) TEST_ERROR
+    if(H5Dclose(did) < 0) TEST_ERROR
+
+    HDfree(buf);
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Dclose(did);
+    } H5E_END_TRY;
+    if(buf)
+        HDfree(buf);
+    return -1;
+} /* end verify_datasets() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    test_paged_file
+ *
+ * Purpose:     Write and read a file with paged aggregation through a page
+ *              buffer of NPAGES pages, then check the data after reopening
+ *              the file with and without the page buffer.
+ *
+ * Return:      Success:        0
+ *              Failure:        1
+ *
+ *-------------------------------------------------------------------------
+ */
+static unsigned
+test_paged_file(hid_t fapl, size_t npages)
+{
+    char        filename[FILENAME_LEN];
+    hid_t       fid = -1, fcpl = -1, pb_fapl = -1, fcpl2 = -1;
+    hsize_t     fsp_size;
+    unsigned    accesses[2], hits[2], misses[2], evictions[2], bypasses[2];
+    herr_t      ret;
+
+    if(npages > 1)
+        TESTING("paged file with page buffer")
+    else
+        TESTING("paged file with single page buffer")
+
+    h5_fixname(FILENAME[0], fapl, filename, sizeof(filename));
+
+    if((fcpl = H5Pcreate(H5P_FILE_CREATE)) < 0) TEST_ERROR
+    if(H5Pset_file_space_page_size(fcpl, (hsize_t)PAGE_SIZE) < 0) TEST_ERROR
+    if((pb_fapl = H5Pcopy(fapl)) < 0) TEST_ERROR
+    if(H5Pset_page_buffer_size(pb_fapl, npages * PAGE_SIZE, 0, 0) < 0) TEST_ERROR
+
+    /* Create the file and its datasets, then read them back while the
+     * pages are still held */
+    if((fid = H5Fcreate(filename, H5F_ACC_TRUNC, fcpl, pb_fapl)) < 0) TEST_ERROR
+    if(write_datasets(fid) < 0) TEST_ERROR
+    if(H5Freset_page_buffering_stats(fid) < 0) TEST_ERROR
+    if(verify_datasets(fid) < 0) TEST_ERROR
+    if(H5Fget_page_buffering_stats(fid, accesses, hits, misses, evictions, bypasses) < 0) TEST_ERROR
+    if(accesses[0] + accesses[1] == 0) TEST_ERROR
+    if(npages > 1 && hits[0] + hits[1] == 0) TEST_ERROR
+    if(npages == 1 && evictions[0] + evictions[1] == 0) TEST_ERROR
+    if(H5Fclose(fid) < 0) TEST_ERROR
+
+    /* Reopen with the page buffer */
+    if((fid = H5Fopen(filename, H5F_ACC_RDONLY, pb_fapl)) < 0) TEST_ERROR
+    if(verify_datasets(fid) < 0) TEST_ERROR
+
+    /* The page size is kept in the file */
+    if((fcpl2 = H5Fget_create_plist(fid)) < 0) TEST_ERROR
+    if(H5Pget_file_space_page_size(fcpl2, &fsp_size) < 0) TEST_ERROR
+    if(fsp_size != PAGE_SIZE) TEST_ERROR
+    if(H5Pclose(fcpl2) < 0) TEST_ERROR
+    if(H5Fclose(fid) < 0) TEST_ERROR
+
+    /* Reopen without the page buffer */
+    if((fid = H5Fopen(filename, H5F_ACC_RDWR, fapl)) < 0) TEST_ERROR
+    if(verify_datasets(fid) < 0) TEST_ERROR
+    H5E_BEGIN_TRY {
+        ret = H5Fget_page_buffering_stats(fid, accesses, hits, misses, evictions, bypasses);
+    } H5E_END_TRY;
+    if(ret >= 0) TEST_ERROR
+    if(H5Fclose(fid) < 0) TEST_ERROR
+
+    if(H5Pclose(fcpl) < 0) TEST_ERROR
+    if(H5Pclose(pb_fapl) < 0) TEST_ERROR
+
+    PASSED()
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Pclose(fcpl);
+        H5Pclose(fcpl2);
+        H5Pclose(pb_fapl);
+        H5Fclose(fid);
+    } H5E_END_TRY;
+    return 1;
+} /* end test_paged_file() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    test_unpaged_file
+ *
+ * Purpose:     Check that a page buffer can't be used with a file that
+ *              doesn't use paged aggregation.
+ *
+ * Return:      Success:        0
+ *              Failure:        1
+ *
+ *-------------------------------------------------------------------------
+ */
+static unsigned
+test_unpaged_file(hid_t fapl)
+{
+    char        filename[FILENAME_LEN];
+    hid_t       fid = -1, pb_fapl = -1;
+
+    TESTING("page buffer with file without paging");
+
+    h5_fixname(FILENAME[0], fapl, filename, sizeof(filename));
+
+    if((pb_fapl = H5Pcopy(fapl)) < 0) TEST_ERROR
+    if(H5Pset_page_buffer_size(pb_fapl, (size_t)(4 * PAGE_SIZE), 0, 0) < 0) TEST_ERROR
+
+    /* Creating the file with a page buffer fails */
+    H5E_BEGIN_TRY {
+        fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, pb_fapl);
+    } H5E_END_TRY;
+    if(fid >= 0) TEST_ERROR
+
+    /* So does opening an existing file with one */
+    if((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0) TEST_ERROR
+    if(H5Fclose(fid) < 0) TEST_ERROR
+    H5E_BEGIN_TRY {
+        fid = H5Fopen(filename, H5F_ACC_RDWR, pb_fapl);
+    } H5E_END_TRY;
+    if(fid >= 0) TEST_ERROR
+
+    if(H5Pclose(pb_fapl) < 0) TEST_ERROR
+
+    PASSED()
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Pclose(pb_fapl);
+        H5Fclose(fid);
+    } H5E_END_TRY;
+    return 1;
+} /* end test_unpaged_file() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    main
+ *
+ * Purpose:     Test paged aggregation and the page buffer
+ *
+ * Return:      Success:        exit(EXIT_SUCCESS)
+ *              Failure:        exit(EXIT_FAILURE)
+ *
+ *-------------------------------------------------------------------------
+ */
+int
+main(void)
+{
+    hid_t       fapl = -1;
+    unsigned    nerrors = 0;
+    const char *env_h5_drvr;
+
+    /* Paged aggregation relies on the block aggregators, which the
+     * multi/split drivers don't use */
+    env_h5_drvr = HDgetenv("HDF5_DRIVER");
+    if(env_h5_drvr == NULL)
+        env_h5_drvr = "nomatch";
+    if(!HDstrcmp(env_h5_drvr, "split") || !HDstrcmp(env_h5_drvr, "multi")) {
+        SKIPPED();
+        HDputs("Page buffer tests skipped for split and multi file drivers");
+        HDexit(EXIT_SUCCESS);
+    } /* end if */
+
+    h5_reset();
+    fapl = h5_fileaccess();
+
+    nerrors += test_props();
+    nerrors += test_paged_file(fapl, (size_t)16);
+    nerrors += test_paged_file(fapl, (size_t)1);
+    nerrors += test_unpaged_file(fapl);
+
+    if(nerrors)
+        goto error;
+
+    HDputs("All page buffer tests passed.");
+    h5_cleanup(FILENAME, fapl);
+    HDexit(EXIT_SUCCESS);
+
+error:
+    HDputs("*** TESTS FAILED ***");
+    H5E_BEGIN_TRY {
+        H5Pclose(fapl);
+    } H5E_END_TRY;
+    HDexit(EXIT_FAILURE);
+} /* end main() */
+
@@ -0,0 +1,405 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * Copyright by the Board of Trustees of the University of Illinois.         *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of HDF5.  The full HDF5 copyright notice, including     *
+ * terms governing use, modification, and redistribution, is contained in    *
+ * the files COPYING and Copyright.html.  COPYING can be found at the root   *
+ * of the source code distribution tree; Copyright.html can be found at the  *
+ * root level of an installed copy of the electronic HDF5 document set and   *
+ * is linked from the top-level documents page.  It can also be found at     *
+ * http://hdfgroup.org/HDF5/doc/Copyright.html.  If you do not have          *
+ * access to either file, you may request a copy from help@hdfgroup.org.     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/*
+ * Purpose:	Tests for single-writer/multiple-reader (SWMR) file access:
+ *		the file access flags and a writer process appending to a
+ *		dataset while a reader process polls it.
+ */
+
+#include "h5test.h"
+#include "H5Fprivate.h"		/* File access (read attempt limits) */
+
+const char *FILENAME[] = {
+    "swmr",
+    NULL
+};
+
+#define FILENAME_LEN    1024
+
+#define DSET_NAME       "append"
+#define NCOLS           16              /* # of ints in each record */
+#define CHUNK_RECS      8               /* # of records in a chunk */
+#define RECS_PER_STEP   5               /* # of records appended at a time */
+#define NSTEPS          40              /* # of times records are appended */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    test_flags
+ *
+ * Purpose:     Check the combinations of file access flags that are
+ *              accepted for SWMR access, and the metadata read attempts
+ *              property.
+ *
+ * Return:      Success:        0
+ *              Failure:        1
+ *
+ *-------------------------------------------------------------------------
+ */
+static unsigned
+test_flags(hid_t fapl)
+{
+    char        filename[FILENAME_LEN];
+    hid_t       fapl_latest = -1;
+    hid_t       fapl2 = -1;
+    hid_t       fid = -1, fid2 = -1;
+    unsigned    intent;
+    unsigned    attempts;
+    herr_t      ret;
+
+    TESTING("SWMR file access flags");
+
+    h5_fixname(FILENAME[0], fapl, filename, sizeof filename);
+
+    if((fapl_latest = H5Pcopy(fapl)) < 0) TEST_ERROR
+    if(H5Pset_libver_bounds(fapl_latest, H5F_LIBVER_LATEST, H5F_LIBVER_LATEST) < 0) TEST_ERROR
+
+    /* SWMR writes need the latest file format */
+    H5E_BEGIN_TRY {
+        fid = H5Fcreate(filename, H5F_ACC_TRUNC | H5F_ACC_SWMR_WRITE, H5P_DEFAULT, fapl);
+    } H5E_END_TRY;
+    if(fid >= 0) TEST_ERROR
+
+    if((fid = H5Fcreate(filename, H5F_ACC_TRUNC | H5F_ACC_SWMR_WRITE, H5P_DEFAULT, fapl_latest)) < 0) TEST_ERROR
+    if(H5Fget_intent(fid, &intent) < 0) TEST_ERROR
+    if(intent != (H5F_ACC_RDWR | H5F_ACC_SWMR_WRITE)) TEST_ERROR
+
+    /* The same process can't open the file again in another mode */
+    H5E_BEGIN_TRY {
+        fid2 = H5Fopen(filename, H5F_ACC_RDONLY | H5F_ACC_SWMR_READ, fapl_latest);
+    } H5E_END_TRY;
+    if(fid2 >= 0) TEST_ERROR
+    if(H5Fclose(fid) < 0) TEST_ERROR
+
+    /* The writer must open the file read-write, readers read-only */
+    H5E_BEGIN_TRY {
+        fid = H5Fopen(filename, H5F_ACC_RDONLY | H5F_ACC_SWMR_WRITE, fapl_latest);
+    } H5E_END_TRY;
+    if(fid >= 0) TEST_ERROR
+    H5E_BEGIN_TRY {
+        fid = H5Fopen(filename, H5F_ACC_RDWR | H5F_ACC_SWMR_READ, fapl_latest);
+    } H5E_END_TRY;
+    if(fid >= 0) TEST_ERROR
+
+    if((fid = H5Fopen(filename, H5F_ACC_RDONLY | H5F_ACC_SWMR_READ, fapl)) < 0) TEST_ERROR
+    if(H5Fget_intent(fid, &intent) < 0) TEST_ERROR
+    if(intent != (H5F_ACC_RDONLY | H5F_ACC_SWMR_READ)) TEST_ERROR
+
+    /* SWMR readers retry metadata reads by default */
+    if((fapl2 = H5Fget_access_plist(fid)) < 0) TEST_ERROR
+    if(H5Pget_metadata_read_attempts(fapl2, &attempts) < 0) TEST_ERROR
+    if(attempts != H5F_SWMR_METADATA_READ_ATTEMPTS) TEST_ERROR
+    if(H5Pclose(fapl2) < 0) TEST_ERROR
+    if(H5Fclose(fid) < 0) TEST_ERROR
+
+    /* The metadata read attempts property */
+    if((fapl2 = H5Pcreate(H5P_FILE_ACCESS)) < 0) TEST_ERROR
+    if(H5Pget_metadata_read_attempts(fapl2, &attempts) < 0) TEST_ERROR
+    if(attempts != H5F_METADATA_READ_ATTEMPTS) TEST_ERROR
+    if(H5Pset_metadata_read_attempts(fapl2, 20) < 0) TEST_ERROR
+    if(H5Pget_metadata_read_attempts(fapl2, &attempts) < 0) TEST_ERROR
+    if(attempts != 20) TEST_ERROR
+    H5E_BEGIN_TRY {
+        ret = H5Pset_metadata_read_attempts(fapl2, 0);
+    } H5E_END_TRY;
+    if(ret >= 0) TEST_ERROR
+    H5E_BEGIN_TRY {
+        ret = H5Pset_metadata_read_attempts(fapl2, H5F_MAX_METADATA_READ_ATTEMPTS + 1);
+    } H5E_END_TRY;
+    if(ret >= 0) TEST_ERROR
+    if(H5Pclose(fapl2) < 0) TEST_ERROR
+
+    if(H5Pclose(fapl_latest) < 0) TEST_ERROR
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Fclose(fid);
+        H5Fclose(fid2);
+        H5Pclose(fapl2);
+        H5Pclose(fapl_latest);
+    } H5E_END_TRY;
+    return 1;
+} /* end test_flags() */
+
+#if defined(H5_HAVE_FORK) && defined(H5_HAVE_WAITPID)
+
+/*-------------------------------------------------------------------------
+ * Function:    reader
+ *
+ * Purpose:     The reader process: opens the file when the writer says
+ *              it is ready, then after each step the writer reports,
+ *              refreshes the dataset and checks all the records the
+ *              writer had flushed by then.
+ *
+ * Return:      Success:        0
+ *              Failure:        1
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+reader(const char *filename, hid_t fapl, int rfd)
+{
+    hid_t       fid = -1, did = -1, sid = -1, mid = -1;
+    hsize_t     dims[2];
+    hsize_t     start[2] = {0, 0};
+    hsize_t     count[2] = {0, NCOLS};
+    int         *rbuf = NULL;
+    int         step;
+    unsigned    u, v;
+
+    if(NULL == (rbuf = (int *)HDmalloc(NSTEPS * RECS_PER_STEP * NCOLS * sizeof(int))))
+        goto error;
+
+    /* Wait for the file to be created */
+    if(HDread(rfd, &step, sizeof(step)) != sizeof(step) || step != 0)
+        goto error;
+    if((fid = H5Fopen(filename, H5F_ACC_RDONLY | H5F_ACC_SWMR_READ, fapl)) < 0)
+        goto error;
+    if((did = H5Dopen2(fid, DSET_NAME, H5P_DEFAULT)) < 0)
+        goto error;
+
+    while(HDread(rfd, &step, sizeof(step)) == sizeof(step)) {
+        if(H5Drefresh(did) < 0)
+            goto error;
+
+        /* The writer may have gone on to later steps since */
+        if((sid = H5Dget_space(did)) < 0)
+            goto error;
+        if(H5Sget_simple_extent_dims(sid, dims, NULL) < 0)
+            goto error;
+        if(dims[0] < (hsize_t)step * RECS_PER_STEP || dims[1] != NCOLS)
+            goto error;
+
+        /* Read the records flushed at this step */
+        count[0] = (hsize_t)step * RECS_PER_STEP;
+        if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, start, NULL, count, NULL) < 0)
+            goto error;
+        if((mid = H5Screate_simple(2, count, NULL)) < 0)
+            goto error;
+        if(H5Dread(did, H5T_NATIVE_INT, mid, sid, H5P_DEFAULT, rbuf) < 0)
+            goto error;
+        for(u = 0; u < (unsigned)count[0]; u++)
+            for(v = 0; v < NCOLS; v++)
+                if(rbuf[u * NCOLS + v] != (int)(u * NCOLS + v + 1))
+                    goto error;
+        if(H5Sclose(mid) < 0 || H5Sclose(sid) < 0)
+            goto error;
+        mid = sid = -1;
+    } /* end while */
+
+    if(H5Dclose(did) < 0)
+        goto error;
+    if(H5Fclose(fid) < 0)
+        goto error;
+    HDfree(rbuf);
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Sclose(mid);
+        H5Sclose(sid);
+        H5Dclose(did);
+        H5Fclose(fid);
+    } H5E_END_TRY;
+    if(rbuf)
+        HDfree(rbuf);
+    return 1;
+} /* end reader() */
+#endif /* defined(H5_HAVE_FORK) && defined(H5_HAVE_WAITPID) */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    test_append
+ *
+ * Purpose:     A writer appends records to a chunked dataset, flushing it
+ *              after each step, while a reader in another process checks
+ *              that every record flushed so far can be read back.
+ *
+ * Return:      Success:        0
+ *              Failure:        1
+ *
+ *-------------------------------------------------------------------------
+ */
+static unsigned
+test_append(hid_t fapl, hbool_t swmr_supported)
+{
+#if defined(H5_HAVE_FORK) && defined(H5_HAVE_WAITPID)
+    char        filename[FILENAME_LEN];
+    hid_t       fapl_latest = -1;
+    hid_t       fid = -1, did = -1, sid = -1, dcpl = -1, fsid = -1, mid = -1;
+    hsize_t     dims[2] = {0, NCOLS};
+    hsize_t     max_dims[2] = {H5S_UNLIMITED, NCOLS};
+    hsize_t     chunk_dims[2] = {CHUNK_RECS, NCOLS};
+    hsize_t     start[2] = {0, 0};
+    hsize_t     count[2] = {RECS_PER_STEP, NCOLS};
+    int         wbuf[RECS_PER_STEP * NCOLS];
+    int         pfd[2] = {-1, -1};
+    pid_t       pid = -1;
+    int         status;
+    int         step;
+    unsigned    u;
+#endif /* defined(H5_HAVE_FORK) && defined(H5_HAVE_WAITPID) */
+
+    TESTING("appending to a dataset while it is read");
+
+#if defined(H5_HAVE_FORK) && defined(H5_HAVE_WAITPID)
+    if(!swmr_supported) {
+        SKIPPED();
+        HDputs("    Not supported with the current VFD");
+        return 0;
+    } /* end if */
+
+    h5_fixname(FILENAME[0], fapl, filename, sizeof filename);
+
+    if((fapl_latest = H5Pcopy(fapl)) < 0) TEST_ERROR
+    if(H5Pset_libver_bounds(fapl_latest, H5F_LIBVER_LATEST, H5F_LIBVER_LATEST) < 0) TEST_ERROR
+
+    /* Start the reader before the file is opened here, so it doesn't
+     * inherit the open file */
+    if(HDpipe(pfd) < 0) TEST_ERROR
+    HDfflush(stdout);
+    HDfflush(stderr);
+    if((pid = HDfork()) < 0) TEST_ERROR
+    if(0 == pid) {
+        HDclose(pfd[1]);
+        status = reader(filename, fapl, pfd[0]);
+        HDclose(pfd[0]);
+        HD_exit(status);
+    } /* end if */
+    HDclose(pfd[0]);
+    pfd[0] = -1;
+
+    /* Create the file and an empty, extendible dataset */
+    if((fid = H5Fcreate(filename, H5F_ACC_TRUNC | H5F_ACC_SWMR_WRITE, H5P_DEFAULT, fapl_latest)) < 0) TEST_ERROR
+    if((sid = H5Screate_simple(2, dims, max_dims)) < 0) TEST_ERROR
+    if((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0) TEST_ERROR
+    if(H5Pset_chunk(dcpl, 2, chunk_dims) < 0) TEST_ERROR
+    if((did = H5Dcreate2(fid, DSET_NAME, H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT)) < 0) TEST_ERROR
+    if(H5Sclose(sid) < 0) TEST_ERROR
+    sid = -1;
+    if(H5Fflush(fid, H5F_SCOPE_GLOBAL) < 0) TEST_ERROR
+
+    step = 0;
+    if(HDwrite(pfd[1], &step, sizeof(step)) != sizeof(step)) TEST_ERROR
+
+    /* Append records, telling the reader after each flush */
+    if((mid = H5Screate_simple(2, count, NULL)) < 0) TEST_ERROR
+    for(step = 1; step <= NSTEPS; step++) {
+        start[0] = (hsize_t)(step - 1) * RECS_PER_STEP;
+        dims[0] = (hsize_t)step * RECS_PER_STEP;
+        for(u = 0; u < RECS_PER_STEP * NCOLS; u++)
+            wbuf[u] = (int)(start[0] * NCOLS + u + 1);
+
+        if(H5Dset_extent(did, dims) < 0) TEST_ERROR
+        if((fsid = H5Dget_space(did)) < 0) TEST_ERROR
+        if(H5Sselect_hyperslab(fsid, H5S_SELECT_SET, start, NULL, count, NULL) < 0) TEST_ERROR
+        if(H5Dwrite(did, H5T_NATIVE_INT, mid, fsid, H5P_DEFAULT, wbuf) < 0) TEST_ERROR
+        if(H5Sclose(fsid) < 0) TEST_ERROR
+        fsid = -1;
+        if(H5Dflush(did) < 0) TEST_ERROR
+
+        if(HDwrite(pfd[1], &step, sizeof(step)) != sizeof(step)) TEST_ERROR
+    } /* end for */
+    HDclose(pfd[1]);
+    pfd[1] = -1;
+
+    /* Wait for the reader to finish */
+    if(HDwaitpid(pid, &status, 0) != pid) TEST_ERROR
+    pid = -1;
+    if(!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        H5_FAILED();
+        HDputs("    Reader failed");
+        goto error;
+    } /* end if */
+
+    if(H5Sclose(mid) < 0) TEST_ERROR
+    if(H5Dclose(did) < 0) TEST_ERROR
+    if(H5Pclose(dcpl) < 0) TEST_ERROR
+    if(H5Fclose(fid) < 0) TEST_ERROR
+    if(H5Pclose(fapl_latest) < 0) TEST_ERROR
+
+    PASSED();
+    return 0;
+
+error:
+    if(pfd[1] >= 0)
+        HDclose(pfd[1]);
+    if(pid > 0)
+        HDwaitpid(pid, &status, 0);
+    H5E_BEGIN_TRY {
+        H5Sclose(mid);
+        H5Sclose(fsid);
+        H5Sclose(sid);
+        H5Dclose(did);
+        H5Pclose(dcpl);
+        H5Fclose(fid);
+        H5Pclose(fapl_latest);
+    } H5E_END_TRY;
+    return 1;
+#else /* defined(H5_HAVE_FORK) && defined(H5_HAVE_WAITPID) */
+    SKIPPED();
+    HDputs("    Test skipped due to fork or waitpid not defined.");
+    return 0;
+#endif /* defined(H5_HAVE_FORK) && defined(H5_HAVE_WAITPID) */
+} /* end test_append() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    main
+ *
+ * Purpose:     Test SWMR file access
+ *
+ * Return:      Success:        EXIT_SUCCESS
+ *              Failure:        EXIT_FAILURE
+ *
+ *-------------------------------------------------------------------------
+ */
+int
+main(void)
+{
+    hid_t       fapl = -1;
+    unsigned    nerrors = 0;
+    hbool_t     swmr_supported;
+    const char *env_h5_drvr;
+
+    /* Only the sec2 driver notices a file growing under it */
+    env_h5_drvr = HDgetenv("HDF5_DRIVER");
+    if(env_h5_drvr == NULL)
+        env_h5_drvr = "nomatch";
+    swmr_supported = !HDstrcmp(env_h5_drvr, "nomatch") || !HDstrcmp(env_h5_drvr, "sec2");
+
+    h5_reset();
+    fapl = h5_fileaccess();
+
+    nerrors += test_flags(fapl);
+    nerrors += test_append(fapl, swmr_supported);
+
+    if(nerrors)
+        goto error;
+
+    HDputs("All SWMR tests passed.");
+    h5_cleanup(FILENAME, fapl);
+    HDexit(EXIT_SUCCESS);
+
+error:
+    HDputs("*** TESTS FAILED ***");
+    H5E_BEGIN_TRY {
+        H5Pclose(fapl);
+    } H5E_END_TRY;
+    HDexit(EXIT_FAILURE);
+} /* end main() */
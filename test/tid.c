@@ -728,6 +728,97 @@ out:
     return -1;
 } /* end test_remove_clear_type() */
 
+/* Test that IDs whose slot gets reused by a newer ID stay invalid */
+#define TEST_ID_REUSE_NUM 1000
+static int test_id_reuse(void)
+{
+    H5I_type_t  myType = H5I_BADID;
+    hid_t       ids[TEST_ID_REUSE_NUM];
+    hid_t       old_id, new_id;
+    int         objs[TEST_ID_REUSE_NUM];
+    void        *obj_ptr;
+    int         i;
+    herr_t      ret;
+
+    myType = H5Iregister_type((size_t)64, 0, NULL);
+    CHECK(myType, H5I_BADID, "H5Iregister_type");
+    if(myType == H5I_BADID)
+        goto out;
+
+    /* Register enough IDs to grow the type's ID table */
+    for(i = 0; i < TEST_ID_REUSE_NUM; i++) {
+        ids[i] = H5Iregister(myType, &objs[i]);
+        CHECK(ids[i], H5I_INVALID_HID, "H5Iregister");
+        if(ids[i] == H5I_INVALID_HID)
+            goto out;
+    } /* end for */
+    for(i = 0; i < TEST_ID_REUSE_NUM; i++) {
+        obj_ptr = H5Iobject_verify(ids[i], myType);
+        VERIFY(obj_ptr, &objs[i], "H5Iobject_verify");
+        if(obj_ptr != &objs[i])
+            goto out;
+    } /* end for */
+
+    /* Release an ID and register a new one in its place */
+    old_id = ids[TEST_ID_REUSE_NUM / 2];
+    ret = H5Idec_ref(old_id);
+    VERIFY(ret, 0, "H5Idec_ref");
+    if(ret != 0)
+        goto out;
+    new_id = H5Iregister(myType, &objs[TEST_ID_REUSE_NUM / 2]);
+    CHECK(new_id, H5I_INVALID_HID, "H5Iregister");
+    if(new_id == H5I_INVALID_HID)
+        goto out;
+    ids[TEST_ID_REUSE_NUM / 2] = new_id;
+
+    /* The old ID must not resolve to the new ID's object */
+    if(new_id == old_id) {
+        TestErrPrintf("ID %lld was handed out twice\n", (long long)old_id);
+        goto out;
+    } /* end if */
+    ret = H5Iis_valid(old_id);
+    VERIFY(ret, FALSE, "H5Iis_valid");
+    if(ret != FALSE)
+        goto out;
+    H5E_BEGIN_TRY
+        obj_ptr = H5Iobject_verify(old_id, myType);
+    H5E_END_TRY
+    VERIFY(obj_ptr, NULL, "H5Iobject_verify");
+    if(obj_ptr != NULL)
+        goto out;
+    obj_ptr = H5Iobject_verify(new_id, myType);
+    VERIFY(obj_ptr, &objs[TEST_ID_REUSE_NUM / 2], "H5Iobject_verify");
+    if(obj_ptr != &objs[TEST_ID_REUSE_NUM / 2])
+        goto out;
+
+    /* Release all the IDs */
+    for(i = 0; i < TEST_ID_REUSE_NUM; i++) {
+        ret = H5Idec_ref(ids[i]);
+        VERIFY(ret, 0, "H5Idec_ref");
+        if(ret != 0)
+            goto out;
+    } /* end for */
+    for(i = 0; i < TEST_ID_REUSE_NUM; i++) {
+        ret = H5Iis_valid(ids[i]);
+        VERIFY(ret, FALSE, "H5Iis_valid");
+        if(ret != FALSE)
+            goto out;
+    } /* end for */
+
+    ret = H5Idestroy_type(myType);
+    CHECK(ret, FAIL, "H5Idestroy_type");
+    if(ret < 0)
+        goto out;
+
+    return 0;
+
+out:
+    if(myType != H5I_BADID)
+        H5Idestroy_type(myType);
+
+    return -1;
+}
+
 void test_ids(void)
 {
     /* Set the random # seed */
@@ -739,5 +830,6 @@ void test_ids(void)
 	if (test_get_type() < 0) TestErrPrintf("H5Iget_type test failed\n");
 	if (test_id_type_list() < 0) TestErrPrintf("ID type list test failed\n");
 	if (test_remove_clear_type() < 0) TestErrPrintf("ID remove during H5Iclear_type test failed\n");
+	if (test_id_reuse() < 0) TestErrPrintf("ID reuse test failed\n");
 
 }
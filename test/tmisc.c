@@ -325,6 +325,18 @@ unsigned m13_rdata[MISC13_DIM1][MISC13_DIM2];          /* Data read from dataset
 #define MISC31_PROPNAME         "misc31_prop"
 #define MISC31_DTYPENAME        "dtype"
 
+/* Definitions for misc. test #33 */
+#define MISC33_FILE             "tmisc33.h5"
+#define MISC33_DSETNAME         "dset"
+#define MISC33_DIM              1000
+#define MISC33_CHUNK_DIM        100
+
+/* Totals gathered by test_misc33_cb() */
+typedef struct misc33_totals_t {
+    unsigned nlists;            /* Number of lists visited */
+    size_t free_size[H5_FREE_LIST_FAC + 1];     /* Memory on each kind of list */
+} misc33_totals_t;
+
 /****************************************************************
 **
 **  test_misc1(): test unlinking a dataset from a group and immediately
@@ -5404,6 +5416,141 @@ test_misc32(void)
     
 } /* end test_misc32() */
 
+
+/****************************************************************
+**
+**  test_misc33_cb(): H5iterate_free_lists() callback for
+**                    test_misc33().  Checks that the information
+**                    for a list is consistent and adds it to the
+**                    totals.
+**
+****************************************************************/
+static herr_t
+test_misc33_cb(const H5_free_list_info_t *info, void *_totals)
+{
+    misc33_totals_t *totals = (misc33_totals_t *)_totals;
+
+    if(info->type > H5_FREE_LIST_FAC)
+        return(-1);
+    if(info->type != H5_FREE_LIST_FAC && NULL == info->name)
+        return(-1);
+    if(info->nfree > info->nalloc || info->free_size > info->alloc_size)
+        return(-1);
+    if(info->alloc_size > info->peak_alloc_size)
+        return(-1);
+
+    totals->nlists++;
+    totals->free_size[info->type] += info->free_size;
+
+    return(0);
+} /* end test_misc33_cb() */
+
+
+/****************************************************************
+**
+**  test_misc33_stop_cb(): H5iterate_free_lists() callback that
+**                         stops the iteration at the first list.
+**
+****************************************************************/
+static herr_t
+test_misc33_stop_cb(const H5_free_list_info_t H5_ATTR_UNUSED *info, void *_nlists)
+{
+    (*(unsigned *)_nlists)++;
+
+    return(1);
+} /* end test_misc33_stop_cb() */
+
+
+/****************************************************************
+**
+**  test_misc33(): Test querying the memory use of the library's
+**                 free lists.
+**
+****************************************************************/
+static void
+test_misc33(void)
+{
+    hid_t fid;                  /* File ID */
+    hid_t sid;                  /* Dataspace ID */
+    hid_t dcpl;                 /* Dataset creation property list ID */
+    hid_t did;                  /* Dataset ID */
+    hsize_t dims[1] = {MISC33_DIM};
+    hsize_t chunk_dims[1] = {MISC33_CHUNK_DIM};
+    int *buf;                   /* Data buffer */
+    misc33_totals_t totals;     /* Totals over all the free lists */
+    size_t reg_size, arr_size, blk_size, fac_size;  /* Memory on each kind of list */
+    unsigned nlists;            /* # of lists visited before stopping */
+    int i;                      /* Local index variable */
+    herr_t ret;                 /* Generic return value */
+
+    /* Output message about test being performed */
+    MESSAGE(5, ("Testing free list memory statistics\n"));
+
+    /* Write and read back a chunked dataset, to exercise the free lists */
+    buf = (int *)HDmalloc(MISC33_DIM * sizeof(int));
+    CHECK(buf, NULL, "HDmalloc");
+    for(i = 0; i < MISC33_DIM; i++)
+        buf[i] = i;
+
+    fid = H5Fcreate(MISC33_FILE, H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+    CHECK(fid, FAIL, "H5Fcreate");
+    sid = H5Screate_simple(1, dims, NULL);
+    CHECK(sid, FAIL, "H5Screate_simple");
+    dcpl = H5Pcreate(H5P_DATASET_CREATE);
+    CHECK(dcpl, FAIL, "H5Pcreate");
+    ret = H5Pset_chunk(dcpl, 1, chunk_dims);
+    CHECK(ret, FAIL, "H5Pset_chunk");
+    did = H5Dcreate2(fid, MISC33_DSETNAME, H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT);
+    CHECK(did, FAIL, "H5Dcreate2");
+    ret = H5Dwrite(did, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, buf);
+    CHECK(ret, FAIL, "H5Dwrite");
+    ret = H5Dread(did, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, buf);
+    CHECK(ret, FAIL, "H5Dread");
+    ret = H5Dclose(did);
+    CHECK(ret, FAIL, "H5Dclose");
+    ret = H5Pclose(dcpl);
+    CHECK(ret, FAIL, "H5Pclose");
+    ret = H5Sclose(sid);
+    CHECK(ret, FAIL, "H5Sclose");
+    ret = H5Fclose(fid);
+    CHECK(ret, FAIL, "H5Fclose");
+    HDfree(buf);
+
+    /* Check that the per-list information adds up to the global sizes */
+    HDmemset(&totals, 0, sizeof(totals));
+    ret = H5iterate_free_lists(test_misc33_cb, &totals);
+    VERIFY(ret, 0, "H5iterate_free_lists");
+#ifndef H5_USING_MEMCHECKER
+    CHECK(totals.nlists, 0, "H5iterate_free_lists");
+#endif /* H5_USING_MEMCHECKER */
+    ret = H5get_free_list_sizes(&reg_size, &arr_size, &blk_size, &fac_size);
+    CHECK(ret, FAIL, "H5get_free_list_sizes");
+    VERIFY(reg_size, totals.free_size[H5_FREE_LIST_REG], "H5get_free_list_sizes");
+    VERIFY(arr_size, totals.free_size[H5_FREE_LIST_ARR], "H5get_free_list_sizes");
+    VERIFY(blk_size, totals.free_size[H5_FREE_LIST_BLK], "H5get_free_list_sizes");
+    VERIFY(fac_size, totals.free_size[H5_FREE_LIST_FAC], "H5get_free_list_sizes");
+
+    /* Check that garbage collection empties all the lists */
+    ret = H5garbage_collect();
+    CHECK(ret, FAIL, "H5garbage_collect");
+    HDmemset(&totals, 0, sizeof(totals));
+    ret = H5iterate_free_lists(test_misc33_cb, &totals);
+    VERIFY(ret, 0, "H5iterate_free_lists");
+    for(i = H5_FREE_LIST_REG; i <= H5_FREE_LIST_FAC; i++)
+        VERIFY(totals.free_size[i], 0, "H5iterate_free_lists");
+    ret = H5get_free_list_sizes(&reg_size, &arr_size, &blk_size, &fac_size);
+    CHECK(ret, FAIL, "H5get_free_list_sizes");
+    VERIFY(reg_size + arr_size + blk_size + fac_size, 0, "H5get_free_list_sizes");
+
+    /* Check that a positive return value stops the iteration */
+    nlists = 0;
+    ret = H5iterate_free_lists(test_misc33_stop_cb, &nlists);
+#ifndef H5_USING_MEMCHECKER
+    VERIFY(ret, 1, "H5iterate_free_lists");
+    VERIFY(nlists, 1, "H5iterate_free_lists");
+#endif /* H5_USING_MEMCHECKER */
+} /* end test_misc33() */
+
 
 /****************************************************************
 **
@@ -5452,6 +5599,7 @@ test_misc(void)
     test_misc30();      /* Exercise local heap loading bug where free lists were getting dropped */
     test_misc31();      /* Test Reentering library through deprecated routines after H5close() */
     test_misc32();      /* Test filter memory allocation functions */
+    test_misc33();      /* Test free list memory statistics */
 
 } /* test_misc() */
 
@@ -5509,5 +5657,6 @@ cleanup_misc(void)
     HDremove(MISC29_COPY_FILE);
     HDremove(MISC30_FILE);
     HDremove(MISC31_FILE);
+    HDremove(MISC33_FILE);
 }
 
@@ -66,6 +66,12 @@
 /* Number of random hyperslab tests performed */
 #define NRAND_HYPER 100
 
+/* Number of blocks to select at once */
+#define NBLOCK_LIST 300
+
+/* Number of points to select out of order */
+#define NPOINTS_SORTED 200
+
 /* 5-D dataset with fixed dimensions */
 #define SPACE5_NAME  "Space5"
 #define SPACE5_RANK	5
@@ -12869,6 +12875,518 @@ test_select_hyper_chunk_offset2(void)
     CHECK(status, FAIL, "H5Fclose");
 }   /* test_select_hyper_chunk_offset2() */
 
+/****************************************************************
+**
+**  test_select_hyper_compile_check(): Read a regular hyperslab
+**      selection from the SPACE2 dataset and verify the values.
+**
+****************************************************************/
+static void
+test_select_hyper_compile_check(hid_t dataset, hid_t sid, hid_t xfer_plist,
+    const hsize_t *start, const hsize_t *stride, const hsize_t *count,
+    const hsize_t *block, const hssize_t *offset)
+{
+    hid_t mid;                  /* Memory dataspace ID */
+    hsize_t npoints;            /* Number of elements selected */
+    short *rbuf;                /* Buffer read from disk */
+    short *tbuf;                /* Temporary buffer pointer */
+    hsize_t i0, b0, i1, b1;     /* Local index variables */
+    herr_t ret;                 /* Generic return value */
+
+    npoints = count[0] * block[0] * count[1] * block[1];
+    mid = H5Screate_simple(1, &npoints, NULL);
+    CHECK(mid, FAIL, "H5Screate_simple");
+
+    rbuf = (short *)HDmalloc((size_t)npoints * sizeof(short));
+    CHECK(rbuf, NULL, "HDmalloc");
+
+    /* Read as a smaller type, to go through the type conversion buffer */
+    ret = H5Dread(dataset, H5T_NATIVE_SHORT, mid, sid, xfer_plist, rbuf);
+    CHECK(ret, FAIL, "H5Dread");
+
+    /* Verify the values, which are each element's position in the dataset */
+    tbuf = rbuf;
+    for(i0 = 0; i0 < count[0]; i0++)
+        for(b0 = 0; b0 < block[0]; b0++)
+            for(i1 = 0; i1 < count[1]; i1++)
+                for(b1 = 0; b1 < block[1]; b1++, tbuf++) {
+                    hsize_t row = (hsize_t)((hssize_t)(start[0] + i0 * stride[0] + b0) + offset[0]);
+                    hsize_t col = (hsize_t)((hssize_t)(start[1] + i1 * stride[1] + b1) + offset[1]);
+
+                    if(*tbuf != (short)(row * SPACE2_DIM2 + col))
+                        TestErrPrintf("Error! row=%u, col=%u, value=%d\n", (unsigned)row, (unsigned)col, *tbuf);
+                } /* end for */
+
+    HDfree(rbuf);
+
+    ret = H5Sclose(mid);
+    CHECK(ret, FAIL, "H5Sclose");
+}   /* test_select_hyper_compile_check() */
+
+/****************************************************************
+**
+**  test_select_hyper_compile(): Tests compiling hyperslab
+**      selections into sequence lists for repeated I/O.
+**
+****************************************************************/
+static void
+test_select_hyper_compile(hid_t xfer_plist)
+{
+    hid_t fid1;                 /* HDF5 File IDs */
+    hid_t dataset;              /* Dataset ID */
+    hid_t sid;                  /* Dataspace ID */
+    hsize_t dims[] = {SPACE2_DIM1, SPACE2_DIM2};
+    hsize_t start[] = {2, 3};
+    hsize_t stride[] = {3, 4};
+    hsize_t count[] = {8, 5};
+    hsize_t block[] = {2, 3};
+    hsize_t start2[] = {0, 1};
+    hsize_t stride2[] = {1, 1};
+    hsize_t count2[] = {30, 1};
+    hsize_t block2[] = {1, 20};
+    hssize_t no_offset[] = {0, 0};
+    hssize_t offset[] = {1, 2};
+    int *wbuf;                  /* Buffer written to disk */
+    htri_t status;              /* Compiled status */
+    unsigned u;                 /* Local index variable */
+    herr_t ret;                 /* Generic return value */
+
+    /* Output message about test being performed */
+    MESSAGE(6, ("Testing Compiled Hyperslab Selections\n"));
+
+    /* Write each element's position in the dataset */
+    wbuf = (int *)HDmalloc(sizeof(int) * SPACE2_DIM1 * SPACE2_DIM2);
+    CHECK(wbuf, NULL, "HDmalloc");
+    for(u = 0; u < SPACE2_DIM1 * SPACE2_DIM2; u++)
+        wbuf[u] = (int)u;
+
+    fid1 = H5Fcreate(FILENAME, H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+    CHECK(fid1, FAIL, "H5Fcreate");
+    sid = H5Screate_simple(SPACE2_RANK, dims, NULL);
+    CHECK(sid, FAIL, "H5Screate_simple");
+    dataset = H5Dcreate2(fid1, SPACE2_NAME, H5T_NATIVE_INT, sid, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+    CHECK(dataset, FAIL, "H5Dcreate2");
+    ret = H5Dwrite(dataset, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, xfer_plist, wbuf);
+    CHECK(ret, FAIL, "H5Dwrite");
+
+    /* Compiling an "all" selection does nothing */
+    ret = H5Sselect_compile(sid);
+    CHECK(ret, FAIL, "H5Sselect_compile");
+    status = H5S_get_compiled_status_test(sid);
+    VERIFY(status, FALSE, "H5S_get_compiled_status_test");
+
+    /* Select a regular hyperslab and read it without compiling */
+    ret = H5Sselect_hyperslab(sid, H5S_SELECT_SET, start, stride, count, block);
+    CHECK(ret, FAIL, "H5Sselect_hyperslab");
+    test_select_hyper_compile_check(dataset, sid, xfer_plist, start, stride, count, block, no_offset);
+
+    /* Compile the selection and read it several times */
+    ret = H5Sselect_compile(sid);
+    CHECK(ret, FAIL, "H5Sselect_compile");
+    status = H5S_get_compiled_status_test(sid);
+    VERIFY(status, TRUE, "H5S_get_compiled_status_test");
+    for(u = 0; u < 3; u++)
+        test_select_hyper_compile_check(dataset, sid, xfer_plist, start, stride, count, block, no_offset);
+
+    /* Copies of the dataspace don't share the sequence list */
+    {
+        hid_t sid2 = H5Scopy(sid);
+
+        CHECK(sid2, FAIL, "H5Scopy");
+        status = H5S_get_compiled_status_test(sid2);
+        VERIFY(status, FALSE, "H5S_get_compiled_status_test");
+        test_select_hyper_compile_check(dataset, sid2, xfer_plist, start, stride, count, block, no_offset);
+        ret = H5Sclose(sid2);
+        CHECK(ret, FAIL, "H5Sclose");
+    }
+
+    /* Changing the offset must not reuse the out of date sequence list */
+    ret = H5Soffset_simple(sid, offset);
+    CHECK(ret, FAIL, "H5Soffset_simple");
+    test_select_hyper_compile_check(dataset, sid, xfer_plist, start, stride, count, block, offset);
+
+    /* Recompile at the new offset */
+    ret = H5Sselect_compile(sid);
+    CHECK(ret, FAIL, "H5Sselect_compile");
+    test_select_hyper_compile_check(dataset, sid, xfer_plist, start, stride, count, block, offset);
+    ret = H5Soffset_simple(sid, no_offset);
+    CHECK(ret, FAIL, "H5Soffset_simple");
+    test_select_hyper_compile_check(dataset, sid, xfer_plist, start, stride, count, block, no_offset);
+
+    /* A new selection releases the sequence list */
+    ret = H5Sselect_hyperslab(sid, H5S_SELECT_SET, start2, NULL, count2, block2);
+    CHECK(ret, FAIL, "H5Sselect_hyperslab");
+    status = H5S_get_compiled_status_test(sid);
+    VERIFY(status, FALSE, "H5S_get_compiled_status_test");
+    ret = H5Sselect_compile(sid);
+    CHECK(ret, FAIL, "H5Sselect_compile");
+    test_select_hyper_compile_check(dataset, sid, xfer_plist, start2, stride2, count2, block2, no_offset);
+
+    /* Irregular selections aren't compiled */
+    ret = H5Sselect_hyperslab(sid, H5S_SELECT_OR, start, stride, count, block);
+    CHECK(ret, FAIL, "H5Sselect_hyperslab");
+    ret = H5Sselect_compile(sid);
+    CHECK(ret, FAIL, "H5Sselect_compile");
+    status = H5S_get_compiled_status_test(sid);
+    VERIFY(status, FALSE, "H5S_get_compiled_status_test");
+
+    ret = H5Dclose(dataset);
+    CHECK(ret, FAIL, "H5Dclose");
+    ret = H5Sclose(sid);
+    CHECK(ret, FAIL, "H5Sclose");
+    ret = H5Fclose(fid1);
+    CHECK(ret, FAIL, "H5Fclose");
+
+    HDfree(wbuf);
+}   /* test_select_hyper_compile() */
+
+/****************************************************************
+**
+**  test_select_hyper_blocks_check(): Verify that the selection in
+**      a SPACE2-sized dataspace matches a map of selected elements.
+**
+****************************************************************/
+static void
+test_select_hyper_blocks_check(hid_t sid, const hbool_t *map)
+{
+    hssize_t npoints;           /* Number of elements selected */
+    hssize_t nblocks;           /* Number of blocks selected */
+    hsize_t *blocks;            /* List of blocks selected */
+    hsize_t nmap = 0;           /* Number of elements in map */
+    hsize_t nfound = 0;         /* Number of elements in blocks */
+    hsize_t row, col;           /* Local index variables */
+    hssize_t u;                 /* Local index variable */
+    herr_t ret;                 /* Generic return value */
+
+    for(row = 0; row < SPACE2_DIM1 * SPACE2_DIM2; row++)
+        if(map[row])
+            nmap++;
+
+    npoints = H5Sget_select_npoints(sid);
+    VERIFY(npoints, (hssize_t)nmap, "H5Sget_select_npoints");
+    if(nmap == 0)
+        return;
+
+    nblocks = H5Sget_select_hyper_nblocks(sid);
+    CHECK(nblocks, FAIL, "H5Sget_select_hyper_nblocks");
+    blocks = (hsize_t *)HDmalloc(sizeof(hsize_t) * 4 * (size_t)nblocks);
+    CHECK(blocks, NULL, "HDmalloc");
+    ret = H5Sget_select_hyper_blocklist(sid, (hsize_t)0, (hsize_t)nblocks, blocks);
+    CHECK(ret, FAIL, "H5Sget_select_hyper_blocklist");
+
+    /* The blocks don't overlap, so each selected element is in the map once */
+    for(u = 0; u < nblocks; u++)
+        for(row = blocks[u * 4]; row <= blocks[(u * 4) + 2]; row++)
+            for(col = blocks[(u * 4) + 1]; col <= blocks[(u * 4) + 3]; col++) {
+                if(!map[(row * SPACE2_DIM2) + col])
+                    TestErrPrintf("Error! row=%u, col=%u selected\n", (unsigned)row, (unsigned)col);
+                nfound++;
+            } /* end for */
+    VERIFY(nfound, nmap, "H5Sget_select_hyper_blocklist");
+
+    HDfree(blocks);
+}   /* test_select_hyper_blocks_check() */
+
+/****************************************************************
+**
+**  test_select_hyper_blocks(): Tests selecting a list of blocks
+**      at once with H5Sselect_blocks().
+**
+****************************************************************/
+static void
+test_select_hyper_blocks(void)
+{
+    hid_t sid1, sid2;           /* Dataspace IDs */
+    hsize_t dims[] = {SPACE2_DIM1, SPACE2_DIM2};
+    hsize_t start[2], count[2]; /* Hyperslab parameters */
+    hsize_t *bstart;            /* Start of each block */
+    hsize_t *bblock;            /* Size of each block */
+    hbool_t *blk_map;           /* Map of elements in the blocks */
+    hbool_t *base_map;          /* Map of elements in the base selection */
+    hbool_t *map;               /* Map of elements expected to be selected */
+    hssize_t nblocks1, nblocks2;    /* Number of blocks selected */
+    hsize_t *blocks1, *blocks2; /* Lists of blocks selected */
+    H5S_seloper_t op;           /* Selection operation */
+    size_t u;                   /* Local index variable */
+    hsize_t row, col;           /* Local index variables */
+    herr_t ret;                 /* Generic return value */
+
+    /* Output message about test being performed */
+    MESSAGE(5, ("Testing Hyperslab Selection of Block Lists\n"));
+
+    bstart = (hsize_t *)HDmalloc(sizeof(hsize_t) * 2 * NBLOCK_LIST);
+    CHECK(bstart, NULL, "HDmalloc");
+    bblock = (hsize_t *)HDmalloc(sizeof(hsize_t) * 2 * NBLOCK_LIST);
+    CHECK(bblock, NULL, "HDmalloc");
+    blk_map = (hbool_t *)HDcalloc(SPACE2_DIM1 * SPACE2_DIM2, sizeof(hbool_t));
+    CHECK(blk_map, NULL, "HDcalloc");
+    base_map = (hbool_t *)HDcalloc(SPACE2_DIM1 * SPACE2_DIM2, sizeof(hbool_t));
+    CHECK(base_map, NULL, "HDcalloc");
+    map = (hbool_t *)HDmalloc(sizeof(hbool_t) * SPACE2_DIM1 * SPACE2_DIM2);
+    CHECK(map, NULL, "HDmalloc");
+
+    /* Generate a list of unordered, overlapping blocks, with a few empty ones */
+    HDsrandom(1234);
+    for(u = 0; u < NBLOCK_LIST; u++) {
+        bstart[u * 2] = (hsize_t)HDrandom() % SPACE2_DIM1;
+        bstart[(u * 2) + 1] = (hsize_t)HDrandom() % SPACE2_DIM2;
+        bblock[u * 2] = (u % 17 == 0) ? 0 : (((hsize_t)HDrandom() % (SPACE2_DIM1 - bstart[u * 2])) % 4) + 1;
+        bblock[(u * 2) + 1] = (((hsize_t)HDrandom() % (SPACE2_DIM2 - bstart[(u * 2) + 1])) % 5) + 1;
+        for(row = bstart[u * 2]; row < bstart[u * 2] + bblock[u * 2]; row++)
+            for(col = bstart[(u * 2) + 1]; col < bstart[(u * 2) + 1] + bblock[(u * 2) + 1]; col++)
+                blk_map[(row * SPACE2_DIM2) + col] = TRUE;
+    } /* end for */
+
+    sid1 = H5Screate_simple(SPACE2_RANK, dims, NULL);
+    CHECK(sid1, FAIL, "H5Screate_simple");
+    sid2 = H5Screate_simple(SPACE2_RANK, dims, NULL);
+    CHECK(sid2, FAIL, "H5Screate_simple");
+
+    /* Select the blocks at once, and one at a time */
+    ret = H5Sselect_blocks(sid1, H5S_SELECT_SET, (size_t)NBLOCK_LIST, bstart, bblock);
+    CHECK(ret, FAIL, "H5Sselect_blocks");
+    test_select_hyper_blocks_check(sid1, blk_map);
+
+    ret = H5Sselect_none(sid2);
+    CHECK(ret, FAIL, "H5Sselect_none");
+    for(u = 0; u < NBLOCK_LIST; u++) {
+        ret = H5Sselect_hyperslab(sid2, H5S_SELECT_OR, &bstart[u * 2], NULL, &bblock[u * 2], NULL);
+        CHECK(ret, FAIL, "H5Sselect_hyperslab");
+    } /* end for */
+
+    /* Both selections should have the same blocks */
+    nblocks1 = H5Sget_select_hyper_nblocks(sid1);
+    CHECK(nblocks1, FAIL, "H5Sget_select_hyper_nblocks");
+    nblocks2 = H5Sget_select_hyper_nblocks(sid2);
+    VERIFY(nblocks2, nblocks1, "H5Sget_select_hyper_nblocks");
+    blocks1 = (hsize_t *)HDmalloc(sizeof(hsize_t) * 4 * (size_t)nblocks1);
+    CHECK(blocks1, NULL, "HDmalloc");
+    blocks2 = (hsize_t *)HDmalloc(sizeof(hsize_t) * 4 * (size_t)nblocks1);
+    CHECK(blocks2, NULL, "HDmalloc");
+    ret = H5Sget_select_hyper_blocklist(sid1, (hsize_t)0, (hsize_t)nblocks1, blocks1);
+    CHECK(ret, FAIL, "H5Sget_select_hyper_blocklist");
+    ret = H5Sget_select_hyper_blocklist(sid2, (hsize_t)0, (hsize_t)nblocks1, blocks2);
+    CHECK(ret, FAIL, "H5Sget_select_hyper_blocklist");
+    if(HDmemcmp(blocks1, blocks2, sizeof(hsize_t) * 4 * (size_t)nblocks1))
+        TestErrPrintf("Error! block lists differ\n");
+    HDfree(blocks1);
+    HDfree(blocks2);
+
+    /* Combine the blocks with a hyperslab, using each operation */
+    start[0] = 5; start[1] = 3;
+    count[0] = 12; count[1] = 20;
+    for(row = start[0]; row < start[0] + count[0]; row++)
+        for(col = start[1]; col < start[1] + count[1]; col++)
+            base_map[(row * SPACE2_DIM2) + col] = TRUE;
+    for(op = H5S_SELECT_OR; op <= H5S_SELECT_NOTA; op = (H5S_seloper_t)(op + 1)) {
+        ret = H5Sselect_hyperslab(sid1, H5S_SELECT_SET, start, NULL, count, NULL);
+        CHECK(ret, FAIL, "H5Sselect_hyperslab");
+        ret = H5Sselect_blocks(sid1, op, (size_t)NBLOCK_LIST, bstart, bblock);
+        CHECK(ret, FAIL, "H5Sselect_blocks");
+
+        for(u = 0; u < SPACE2_DIM1 * SPACE2_DIM2; u++)
+            switch(op) {
+                case H5S_SELECT_OR:
+                    map[u] = base_map[u] || blk_map[u];
+                    break;
+                case H5S_SELECT_AND:
+                    map[u] = base_map[u] && blk_map[u];
+                    break;
+                case H5S_SELECT_XOR:
+                    map[u] = base_map[u] != blk_map[u];
+                    break;
+                case H5S_SELECT_NOTB:
+                    map[u] = base_map[u] && !blk_map[u];
+                    break;
+                case H5S_SELECT_NOTA:
+                    map[u] = !base_map[u] && blk_map[u];
+                    break;
+                default:
+                    map[u] = FALSE;
+                    break;
+            } /* end switch */
+        test_select_hyper_blocks_check(sid1, map);
+    } /* end for */
+
+    /* XOR with an "all" selection */
+    ret = H5Sselect_all(sid1);
+    CHECK(ret, FAIL, "H5Sselect_all");
+    ret = H5Sselect_blocks(sid1, H5S_SELECT_XOR, (size_t)NBLOCK_LIST, bstart, bblock);
+    CHECK(ret, FAIL, "H5Sselect_blocks");
+    for(u = 0; u < SPACE2_DIM1 * SPACE2_DIM2; u++)
+        map[u] = !blk_map[u];
+    test_select_hyper_blocks_check(sid1, map);
+
+    /* A single block gives a regular selection */
+    ret = H5Sselect_blocks(sid1, H5S_SELECT_SET, (size_t)1, start, count);
+    CHECK(ret, FAIL, "H5Sselect_blocks");
+    ret = H5Sis_regular_hyperslab(sid1);
+    VERIFY(ret, TRUE, "H5Sis_regular_hyperslab");
+    test_select_hyper_blocks_check(sid1, base_map);
+
+    /* Only empty blocks select nothing */
+    ret = H5Sselect_blocks(sid1, H5S_SELECT_SET, (size_t)1, bstart, bblock);
+    CHECK(ret, FAIL, "H5Sselect_blocks");
+    VERIFY(H5Sget_select_type(sid1), H5S_SEL_NONE, "H5Sget_select_type");
+
+    /* An empty list of blocks is an error */
+    H5E_BEGIN_TRY {
+        ret = H5Sselect_blocks(sid1, H5S_SELECT_SET, (size_t)0, bstart, bblock);
+    } H5E_END_TRY;
+    VERIFY(ret, FAIL, "H5Sselect_blocks");
+
+    ret = H5Sclose(sid1);
+    CHECK(ret, FAIL, "H5Sclose");
+    ret = H5Sclose(sid2);
+    CHECK(ret, FAIL, "H5Sclose");
+
+    HDfree(bstart);
+    HDfree(bblock);
+    HDfree(blk_map);
+    HDfree(base_map);
+    HDfree(map);
+}   /* test_select_hyper_blocks() */
+
+/****************************************************************
+**
+**  test_select_point_sorted(): Tests I/O with point selections
+**      whose points are out of order in the file, with duplicate
+**      points.
+**
+****************************************************************/
+static void
+test_select_point_sorted(hbool_t chunked)
+{
+    hid_t fid1;                 /* HDF5 File IDs */
+    hid_t dataset;              /* Dataset ID */
+    hid_t sid1, sid2;           /* Dataspace IDs */
+    hid_t dcpl;                 /* Dataset creation property list */
+    hid_t dxpl;                 /* Dataset transfer property list */
+    hsize_t dims1[] = {SPACE2_DIM1, SPACE2_DIM2};
+    hsize_t chunk_dims[] = {7, 5};
+    hsize_t dims2[] = {2 * NPOINTS_SORTED};
+    hsize_t start, stride, count;   /* Memory hyperslab parameters */
+    hsize_t *coord;             /* Coordinates of points */
+    int *wbuf;                  /* Buffer written to disk */
+    int *rbuf;                  /* Buffer read from disk */
+    int *expect;                /* Expected dataset contents */
+    long long *lbuf;            /* Buffer read from disk, as a larger type */
+    size_t u;                   /* Local index variable */
+    herr_t ret;                 /* Generic return value */
+
+    /* Output message about test being performed */
+    MESSAGE(5, ("Testing Unordered Point Selection I/O on %s Datasets\n", chunked ? "Chunked" : "Contiguous"));
+
+    coord = (hsize_t *)HDmalloc(sizeof(hsize_t) * 2 * NPOINTS_SORTED);
+    CHECK(coord, NULL, "HDmalloc");
+    wbuf = (int *)HDmalloc(sizeof(int) * 2 * NPOINTS_SORTED);
+    CHECK(wbuf, NULL, "HDmalloc");
+    rbuf = (int *)HDmalloc(sizeof(int) * SPACE2_DIM1 * SPACE2_DIM2);
+    CHECK(rbuf, NULL, "HDmalloc");
+    expect = (int *)HDmalloc(sizeof(int) * SPACE2_DIM1 * SPACE2_DIM2);
+    CHECK(expect, NULL, "HDmalloc");
+    lbuf = (long long *)HDmalloc(sizeof(long long) * 2 * NPOINTS_SORTED);
+    CHECK(lbuf, NULL, "HDmalloc");
+
+    /* Generate points in random order; some points are selected twice */
+    HDsrandom(5678);
+    for(u = 0; u < NPOINTS_SORTED; u++) {
+        if(u > 0 && (u % 10) == 0) {
+            size_t prev = (size_t)HDrandom() % u;
+
+            coord[u * 2] = coord[prev * 2];
+            coord[(u * 2) + 1] = coord[(prev * 2) + 1];
+        } /* end if */
+        else {
+            coord[u * 2] = (hsize_t)HDrandom() % SPACE2_DIM1;
+            coord[(u * 2) + 1] = (hsize_t)HDrandom() % SPACE2_DIM2;
+        } /* end else */
+    } /* end for */
+
+    /* Use a small vector size, so the I/O is done in several batches */
+    dxpl = H5Pcreate(H5P_DATASET_XFER);
+    CHECK(dxpl, FAIL, "H5Pcreate");
+    ret = H5Pset_hyper_vector_size(dxpl, (size_t)7);
+    CHECK(ret, FAIL, "H5Pset_hyper_vector_size");
+
+    fid1 = H5Fcreate(FILENAME, H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+    CHECK(fid1, FAIL, "H5Fcreate");
+    sid1 = H5Screate_simple(SPACE2_RANK, dims1, NULL);
+    CHECK(sid1, FAIL, "H5Screate_simple");
+    dcpl = H5Pcreate(H5P_DATASET_CREATE);
+    CHECK(dcpl, FAIL, "H5Pcreate");
+    if(chunked) {
+        ret = H5Pset_chunk(dcpl, SPACE2_RANK, chunk_dims);
+        CHECK(ret, FAIL, "H5Pset_chunk");
+    } /* end if */
+    dataset = H5Dcreate2(fid1, SPACE2_NAME, H5T_NATIVE_INT, sid1, H5P_DEFAULT, dcpl, H5P_DEFAULT);
+    CHECK(dataset, FAIL, "H5Dcreate2");
+
+    /* Write each element's position in the dataset */
+    for(u = 0; u < SPACE2_DIM1 * SPACE2_DIM2; u++)
+        expect[u] = (int)u;
+    ret = H5Dwrite(dataset, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, dxpl, expect);
+    CHECK(ret, FAIL, "H5Dwrite");
+
+    /* Select the points in the file, and every other element in memory */
+    ret = H5Sselect_elements(sid1, H5S_SELECT_SET, (size_t)NPOINTS_SORTED, coord);
+    CHECK(ret, FAIL, "H5Sselect_elements");
+    sid2 = H5Screate_simple(1, dims2, NULL);
+    CHECK(sid2, FAIL, "H5Screate_simple");
+    start = 1; stride = 2; count = NPOINTS_SORTED;
+    ret = H5Sselect_hyperslab(sid2, H5S_SELECT_SET, &start, &stride, &count, NULL);
+    CHECK(ret, FAIL, "H5Sselect_hyperslab");
+
+    /* Read the points, which should arrive in selection order */
+    for(u = 0; u < 2 * NPOINTS_SORTED; u++)
+        wbuf[u] = -1;
+    ret = H5Dread(dataset, H5T_NATIVE_INT, sid2, sid1, dxpl, wbuf);
+    CHECK(ret, FAIL, "H5Dread");
+    for(u = 0; u < NPOINTS_SORTED; u++) {
+        VERIFY(wbuf[u * 2], -1, "H5Dread");
+        VERIFY(wbuf[(u * 2) + 1], (int)((coord[u * 2] * SPACE2_DIM2) + coord[(u * 2) + 1]), "H5Dread");
+    } /* end for */
+
+    /* Read the points as a larger type, which is converted in place */
+    ret = H5Dread(dataset, H5T_NATIVE_LLONG, sid2, sid1, dxpl, lbuf);
+    CHECK(ret, FAIL, "H5Dread");
+    for(u = 0; u < NPOINTS_SORTED; u++)
+        VERIFY(lbuf[(u * 2) + 1], (long long)((coord[u * 2] * SPACE2_DIM2) + coord[(u * 2) + 1]), "H5Dread");
+
+    /* Write new values to the points; the last write to a point wins */
+    for(u = 0; u < NPOINTS_SORTED; u++) {
+        wbuf[(u * 2) + 1] = -(int)u;
+        expect[(coord[u * 2] * SPACE2_DIM2) + coord[(u * 2) + 1]] = -(int)u;
+    } /* end for */
+    ret = H5Dwrite(dataset, H5T_NATIVE_INT, sid2, sid1, dxpl, wbuf);
+    CHECK(ret, FAIL, "H5Dwrite");
+
+    ret = H5Dread(dataset, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, rbuf);
+    CHECK(ret, FAIL, "H5Dread");
+    for(u = 0; u < SPACE2_DIM1 * SPACE2_DIM2; u++)
+        if(rbuf[u] != expect[u])
+            TestErrPrintf("Error! element %u: value=%d, expected=%d\n", (unsigned)u, rbuf[u], expect[u]);
+
+    ret = H5Dclose(dataset);
+    CHECK(ret, FAIL, "H5Dclose");
+    ret = H5Pclose(dcpl);
+    CHECK(ret, FAIL, "H5Pclose");
+    ret = H5Pclose(dxpl);
+    CHECK(ret, FAIL, "H5Pclose");
+    ret = H5Sclose(sid1);
+    CHECK(ret, FAIL, "H5Sclose");
+    ret = H5Sclose(sid2);
+    CHECK(ret, FAIL, "H5Sclose");
+    ret = H5Fclose(fid1);
+    CHECK(ret, FAIL, "H5Fclose");
+
+    HDfree(coord);
+    HDfree(wbuf);
+    HDfree(rbuf);
+    HDfree(expect);
+    HDfree(lbuf);
+}   /* test_select_point_sorted() */
+
 /****************************************************************
 **
 **  test_select_bounds(): Tests selection bounds on dataspaces,
@@ -13769,6 +14287,13 @@ test_select(void)
     ret = H5Pclose(fapl);
     CHECK(ret, FAIL, "H5Pclose");
 
+    /* Test compiled hyperslab selections */
+    test_select_hyper_compile(H5P_DEFAULT);
+    test_select_hyper_compile(plist_id);
+    test_select_hyper_blocks();
+    test_select_point_sorted(FALSE);
+    test_select_point_sorted(TRUE);
+
     /* Close dataset transfer property list */
     ret = H5Pclose(plist_id);
     CHECK(ret, FAIL, "H5Pclose");
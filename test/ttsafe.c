@@ -119,6 +119,7 @@ int main(int argc, char *argv[])
     AddTest("cancel", tts_cancel, cleanup_cancel, "thread cancellation safety test", NULL);
 #endif /* H5_HAVE_PTHREAD_H */
     AddTest("acreate", tts_acreate, cleanup_acreate, "multi-attribute creation", NULL);
+    AddTest("dread", tts_dread, cleanup_dread, "concurrent raw data reads", NULL);
 
 #else /* H5_HAVE_THREADSAFE */
 
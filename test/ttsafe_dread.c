@@ -0,0 +1,218 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * Copyright by the Board of Trustees of the University of Illinois.         *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of HDF5.  The full HDF5 copyright notice, including     *
+ * terms governing use, modification, and redistribution, is contained in    *
+ * the files COPYING and Copyright.html.  COPYING can be found at the root   *
+ * of the source code distribution tree; Copyright.html can be found at the  *
+ * root level of an installed copy of the electronic HDF5 document set and   *
+ * is linked from the top-level documents page.  It can also be found at     *
+ * http://hdfgroup.org/HDF5/doc/Copyright.html.  If you do not have          *
+ * access to either file, you may request a copy from help@hdfgroup.org.     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/********************************************************************
+ *
+ * Testing for thread safety in H5D raw data reads, which may release
+ * the library's API lock while the file driver waits for the data.
+ * -- Threaded program --
+ * ------------------------------------------------------------------
+ *
+ * Plan: Have several threads read large, overlapping pieces of one
+ *       dataset, too big for the data sieve buffer, while other threads
+ *       create attributes on another dataset in the same file.
+ *
+ * Claim: Every reader gets exactly the data that was written, and every
+ *        attribute is created, if raw data reads don't disturb the
+ *        library state of the threads that run while they wait.
+ *
+ * HDF5 APIs exercised in thread:
+ * H5Dread, H5Screate_simple, H5Sselect_hyperslab, H5Acreate2, H5Awrite,
+ * H5Aclose.
+ *
+ ********************************************************************/
+
+#include "ttsafe.h"
+
+#ifdef H5_HAVE_THREADSAFE
+
+#define FILENAME	"ttsafe_dread.h5"
+#define DATASETNAME	"IntData"
+#define ATTRDSETNAME	"AttrData"
+#define NUM_READERS	8
+#define NUM_CREATORS	4
+#define NUM_ATTRS	8       /* Attributes created by each creator thread */
+#define NUM_READS	8       /* Reads made by each reader thread */
+#define DSET_NELMTS		(256 * 1024)
+
+void *tts_dread_reader(void *);
+void *tts_dread_creator(void *);
+
+typedef struct dread_data_struct {
+    hid_t dataset;
+    int index;
+    int nerrors;
+} ttsafe_dread_data_t;
+
+void tts_dread(void)
+{
+    /* Thread declarations */
+    H5TS_thread_t threads[NUM_READERS + NUM_CREATORS];
+    ttsafe_dread_data_t thread_data[NUM_READERS + NUM_CREATORS];
+
+    /* HDF5 data declarations */
+    hid_t   file, dataset, attr_dataset;
+    hid_t   dataspace, attr_dataspace;
+    hid_t   attribute;
+    char    *attribute_name;
+    hsize_t dims[1];
+
+    /* data declarations */
+    int     *data;
+    int     buffer, ret, i, j;
+
+    /* Create the file and a large contiguous dataset */
+    file = H5Fcreate(FILENAME, H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+    assert(file >= 0);
+
+    dims[0] = DSET_NELMTS;
+    dataspace = H5Screate_simple(1, dims, NULL);
+    assert(dataspace >= 0);
+    dataset = H5Dcreate2(file, DATASETNAME, H5T_NATIVE_INT, dataspace, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+    assert(dataset >= 0);
+
+    data = (int *)HDmalloc(DSET_NELMTS * sizeof(int));
+    assert(data);
+    for(i = 0; i < DSET_NELMTS; i++)
+        data[i] = i;
+    ret = H5Dwrite(dataset, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, data);
+    assert(ret >= 0);
+    HDfree(data);
+
+    /* Create a small dataset for the creator threads to put attributes on */
+    dims[0] = 1;
+    attr_dataspace = H5Screate_simple(1, dims, NULL);
+    assert(attr_dataspace >= 0);
+    attr_dataset = H5Dcreate2(file, ATTRDSETNAME, H5T_NATIVE_INT, attr_dataspace, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+    assert(attr_dataset >= 0);
+
+    /* Start the readers and the attribute creators together */
+    for(i = 0; i < NUM_READERS + NUM_CREATORS; i++) {
+        thread_data[i].dataset = i < NUM_READERS ? dataset : attr_dataset;
+        thread_data[i].index = i < NUM_READERS ? i : i - NUM_READERS;
+        thread_data[i].nerrors = 0;
+        threads[i] = H5TS_create_thread(i < NUM_READERS ? tts_dread_reader : tts_dread_creator, NULL, &thread_data[i]);
+    } /* end for */
+
+    for(i = 0; i < NUM_READERS + NUM_CREATORS; i++)
+        H5TS_wait_for_thread(threads[i]);
+
+    /* Verify the correctness of the test */
+    for(i = 0; i < NUM_READERS + NUM_CREATORS; i++)
+        if(thread_data[i].nerrors)
+            TestErrPrintf("thread %d saw %d errors.  Test failed!\n", i, thread_data[i].nerrors);
+
+    for(i = 0; i < NUM_CREATORS; i++)
+        for(j = 0; j < NUM_ATTRS; j++) {
+            attribute_name = gen_name(i * NUM_ATTRS + j);
+            attribute = H5Aopen(attr_dataset, attribute_name, H5P_DEFAULT);
+            HDfree(attribute_name);
+
+            if(attribute < 0)
+                TestErrPrintf("unable to open appropriate attribute.  Test failed!\n");
+            else {
+                ret = H5Aread(attribute, H5T_NATIVE_INT, &buffer);
+
+                if(ret < 0 || buffer != i * NUM_ATTRS + j)
+                    TestErrPrintf("wrong data values. Test failed!\n");
+
+                H5Aclose(attribute);
+            } /* end else */
+        } /* end for */
+
+    /* close remaining resources */
+    ret = H5Sclose(attr_dataspace);
+    assert(ret >= 0);
+    ret = H5Dclose(attr_dataset);
+    assert(ret >= 0);
+    ret = H5Sclose(dataspace);
+    assert(ret >= 0);
+    ret = H5Dclose(dataset);
+    assert(ret >= 0);
+    ret = H5Fclose(file);
+    assert(ret >= 0);
+}
+
+void *tts_dread_reader(void *client_data)
+{
+    ttsafe_dread_data_t *thread_data = (ttsafe_dread_data_t *)client_data;
+    hid_t   mem_space, file_space;
+    hsize_t start[1], count[1];
+    int     *buf;
+    int     i, j;
+
+    buf = (int *)HDmalloc(DSET_NELMTS * sizeof(int));
+    assert(buf);
+
+    file_space = H5Dget_space(thread_data->dataset);
+    assert(file_space >= 0);
+
+    /* Read overlapping pieces, starting at a different place in each thread */
+    for(i = 0; i < NUM_READS; i++) {
+        start[0] = (hsize_t)(((thread_data->index + i) % NUM_READS) * (DSET_NELMTS / (2 * NUM_READS)));
+        count[0] = DSET_NELMTS / 2;
+
+        mem_space = H5Screate_simple(1, count, NULL);
+        if(mem_space < 0
+                || H5Sselect_hyperslab(file_space, H5S_SELECT_SET, start, NULL, count, NULL) < 0
+                || H5Dread(thread_data->dataset, H5T_NATIVE_INT, mem_space, file_space, H5P_DEFAULT, buf) < 0)
+            thread_data->nerrors++;
+        else
+            for(j = 0; j < (int)count[0]; j++)
+                if(buf[j] != (int)start[0] + j) {
+                    thread_data->nerrors++;
+                    break;
+                } /* end if */
+        H5Sclose(mem_space);
+    } /* end for */
+
+    H5Sclose(file_space);
+    HDfree(buf);
+
+    return NULL;
+}
+
+void *tts_dread_creator(void *client_data)
+{
+    ttsafe_dread_data_t *thread_data = (ttsafe_dread_data_t *)client_data;
+    hid_t   dataspace, attribute;
+    char    *attribute_name;
+    int     value;
+    int     i;
+
+    dataspace = H5Screate(H5S_SCALAR);
+    assert(dataspace >= 0);
+
+    for(i = 0; i < NUM_ATTRS; i++) {
+        value = thread_data->index * NUM_ATTRS + i;
+        attribute_name = gen_name(value);
+        attribute = H5Acreate2(thread_data->dataset, attribute_name, H5T_NATIVE_INT, dataspace, H5P_DEFAULT, H5P_DEFAULT);
+        HDfree(attribute_name);
+        if(attribute < 0 || H5Awrite(attribute, H5T_NATIVE_INT, &value) < 0)
+            thread_data->nerrors++;
+        H5Aclose(attribute);
+    } /* end for */
+
+    H5Sclose(dataspace);
+
+    return NULL;
+}
+
+void cleanup_dread(void)
+{
+    HDunlink(FILENAME);
+}
+
+#endif /*H5_HAVE_THREADSAFE*/
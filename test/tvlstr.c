@@ -37,6 +37,10 @@
 /* Definitions for the VL re-writing test */
 #define REWRITE_NDATASETS       32
 
+/* Definitions for the batched VL string I/O test */
+#define BATCH_NELMTS            10000
+#define BATCH_MAXLEN            40
+
 /* String for testing attributes */
 static const char *string_att = "This is the string for the attribute";
 static char *string_att_write=NULL;
@@ -376,6 +380,176 @@ test_vlstrings_special(void)
     CHECK(ret, FAIL, "H5Fclose");
 }
 
+/****************************************************************
+**
+**  test_vlstrings_batch(): Test reading and writing many short
+**      VL strings, which are spread over several global heap
+**      collections, including nil and empty strings.
+**
+****************************************************************/
+static void
+test_vlstrings_batch(void)
+{
+    char **wdata;               /* Information to write */
+    char **rdata;               /* Information read in */
+    char *wbuf;                 /* Storage for written strings */
+    hid_t		fid1;		/* HDF5 File IDs		*/
+    hid_t		dataset;	/* Dataset ID			*/
+    hid_t		sid1;       /* Dataspace ID			*/
+    hid_t		msid;       /* Memory dataspace ID		*/
+    hid_t		tid1;       /* Datatype ID			*/
+    hid_t		xfer_pid;   /* Dataset transfer property list ID */
+    hsize_t		dims1[] = {BATCH_NELMTS};
+    hsize_t		start, count;   /* Hyperslab selection */
+    hsize_t		size;       /* Number of bytes which will be used */
+    size_t		mem_used = 0;   /* Memory used during allocation */
+    size_t		str_used = 0;   /* Memory needed by the strings */
+    unsigned       i, j;       /* counting variables */
+    herr_t		ret;		/* Generic return value		*/
+
+    /* Output message about test being performed */
+    MESSAGE(5, ("Testing Batched VL String I/O\n"));
+
+    wdata = (char **)HDmalloc(BATCH_NELMTS * sizeof(char *));
+    CHECK(wdata, NULL, "HDmalloc");
+    rdata = (char **)HDmalloc(BATCH_NELMTS * sizeof(char *));
+    CHECK(rdata, NULL, "HDmalloc");
+    wbuf = (char *)HDmalloc(BATCH_NELMTS * (BATCH_MAXLEN + 1));
+    CHECK(wbuf, NULL, "HDmalloc");
+
+    /* Set up strings of varying length, with some nil ones */
+    for(i = 0; i < BATCH_NELMTS; i++) {
+        if(i % 7 == 3)
+            wdata[i] = NULL;
+        else {
+            size_t len = (i * 13) % (BATCH_MAXLEN + 1);
+
+            wdata[i] = wbuf + i * (BATCH_MAXLEN + 1);
+            for(j = 0; j < len; j++)
+                wdata[i][j] = (char)('a' + (i + j) % 26);
+            wdata[i][len] = '\0';
+            str_used += len + 1;
+        } /* end else */
+    } /* end for */
+
+    /* Create file */
+    fid1 = H5Fcreate(DATAFILE, H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+    CHECK(fid1, FAIL, "H5Fcreate");
+
+    /* Create dataspace for datasets */
+    sid1 = H5Screate_simple(SPACE1_RANK, dims1, NULL);
+    CHECK(sid1, FAIL, "H5Screate_simple");
+
+    /* Create a datatype to refer to */
+    tid1 = H5Tcopy(H5T_C_S1);
+    CHECK(tid1, FAIL, "H5Tcopy");
+
+    ret = H5Tset_size(tid1, H5T_VARIABLE);
+    CHECK(ret, FAIL, "H5Tset_size");
+
+    /* Create a dataset */
+    dataset = H5Dcreate2(fid1, "Dataset_batch", tid1, sid1, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+    CHECK(dataset, FAIL, "H5Dcreate2");
+
+    /* Write dataset to disk */
+    ret = H5Dwrite(dataset, tid1, H5S_ALL, H5S_ALL, H5P_DEFAULT, wdata);
+    CHECK(ret, FAIL, "H5Dwrite");
+
+    /* Close Dataset & file, so the strings are read back from disk */
+    ret = H5Dclose(dataset);
+    CHECK(ret, FAIL, "H5Dclose");
+    ret = H5Fclose(fid1);
+    CHECK(ret, FAIL, "H5Fclose");
+
+    fid1 = H5Fopen(DATAFILE, H5F_ACC_RDONLY, H5P_DEFAULT);
+    CHECK(fid1, FAIL, "H5Fopen");
+    dataset = H5Dopen2(fid1, "Dataset_batch", H5P_DEFAULT);
+    CHECK(dataset, FAIL, "H5Dopen2");
+
+    /* Check the size of the VL data */
+    ret = H5Dvlen_get_buf_size(dataset, tid1, sid1, &size);
+    CHECK(ret, FAIL, "H5Dvlen_get_buf_size");
+    VERIFY(size, (hsize_t)str_used, "H5Dvlen_get_buf_size");
+
+    /* Change to the custom memory allocation routines for reading VL string */
+    xfer_pid = H5Pcreate(H5P_DATASET_XFER);
+    CHECK(xfer_pid, FAIL, "H5Pcreate");
+
+    ret = H5Pset_vlen_mem_manager(xfer_pid, test_vlstr_alloc_custom, &mem_used, test_vlstr_free_custom, &mem_used);
+    CHECK(ret, FAIL, "H5Pset_vlen_mem_manager");
+
+    /* Read dataset from disk */
+    ret = H5Dread(dataset, tid1, H5S_ALL, H5S_ALL, xfer_pid, rdata);
+    CHECK(ret, FAIL, "H5Dread");
+
+    /* Make certain the correct amount of memory has been used */
+    VERIFY(mem_used, str_used, "H5Dread");
+
+    /* Compare data read in */
+    for(i = 0; i < BATCH_NELMTS; i++) {
+        if(wdata[i] == NULL || rdata[i] == NULL) {
+            if(wdata[i] != rdata[i])
+                TestErrPrintf("VL data values don't match!, element %u\n", i);
+            continue;
+        } /* end if */
+        if(HDstrcmp(wdata[i], rdata[i]) != 0) {
+            TestErrPrintf("VL data values don't match!, wdata[%u]=%s, rdata[%u]=%s\n", i, wdata[i], i, rdata[i]);
+            continue;
+        } /* end if */
+    } /* end for */
+
+    /* Reclaim the read VL data */
+    ret = H5Dvlen_reclaim(tid1, sid1, xfer_pid, rdata);
+    CHECK(ret, FAIL, "H5Dvlen_reclaim");
+
+    /* Make certain the VL memory has been freed */
+    VERIFY(mem_used, 0, "H5Dvlen_reclaim");
+
+    /* Read a subset of the strings, packed at the start of the buffer */
+    start = 101;
+    count = BATCH_NELMTS / 2;
+    ret = H5Sselect_hyperslab(sid1, H5S_SELECT_SET, &start, NULL, &count, NULL);
+    CHECK(ret, FAIL, "H5Sselect_hyperslab");
+    msid = H5Screate_simple(SPACE1_RANK, &count, NULL);
+    CHECK(msid, FAIL, "H5Screate_simple");
+
+    ret = H5Dread(dataset, tid1, msid, sid1, H5P_DEFAULT, rdata);
+    CHECK(ret, FAIL, "H5Dread");
+
+    for(i = 0; i < (unsigned)count; i++) {
+        const char *w = wdata[i + (unsigned)start];
+
+        if(w == NULL || rdata[i] == NULL) {
+            if(w != rdata[i])
+                TestErrPrintf("VL data values don't match!, element %u\n", i);
+            continue;
+        } /* end if */
+        if(HDstrcmp(w, rdata[i]) != 0)
+            TestErrPrintf("VL data values don't match!, wdata[%u]=%s, rdata[%u]=%s\n", i + (unsigned)start, w, i, rdata[i]);
+    } /* end for */
+
+    ret = H5Dvlen_reclaim(tid1, msid, H5P_DEFAULT, rdata);
+    CHECK(ret, FAIL, "H5Dvlen_reclaim");
+
+    /* Close everything */
+    ret = H5Sclose(msid);
+    CHECK(ret, FAIL, "H5Sclose");
+    ret = H5Pclose(xfer_pid);
+    CHECK(ret, FAIL, "H5Pclose");
+    ret = H5Dclose(dataset);
+    CHECK(ret, FAIL, "H5Dclose");
+    ret = H5Tclose(tid1);
+    CHECK(ret, FAIL, "H5Tclose");
+    ret = H5Sclose(sid1);
+    CHECK(ret, FAIL, "H5Sclose");
+    ret = H5Fclose(fid1);
+    CHECK(ret, FAIL, "H5Fclose");
+
+    HDfree(wbuf);
+    HDfree(rdata);
+    HDfree(wdata);
+}
+
 /****************************************************************
 **
 **  test_vlstring_type(): Test VL string type.
@@ -864,6 +1038,7 @@ test_vlstrings(void)
     /* Test basic VL string datatype */
     test_vlstrings_basic();
     test_vlstrings_special();
+    test_vlstrings_batch();
     test_vlstring_type();
     test_compact_vlstring();
 
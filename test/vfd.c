@@ -34,6 +34,10 @@
 #define DSET1_DIM2   32
 #define DSET3_NAME   "dset3"
 
+/* Extents for the vector I/O test */
+#define VECTOR_NEXTENTS 6
+#define VECTOR_EOA      (200*KB)
+
 /* Macros for Direct VFD */
 #ifdef H5_HAVE_DIRECT
 #define MBOUNDARY    512
@@ -55,6 +59,7 @@ const char *FILENAME[] = {
     "stdio_file",        /*7*/
     "windows_file",      /*8*/
     "new_multi_file_v16",/*9*/
+    "vector_file",       /*10*/
     NULL
 };
 
@@ -1593,6 +1598,147 @@ error:
 }
 
 
+
+/*-------------------------------------------------------------------------
+ * Function:    test_vector_io_fapl
+ *
+ * Purpose:     Writes a list of extents with H5FDwritev() and reads them
+ *              back with H5FDread() and H5FDreadv(), using the driver
+ *              set in FAPL.  The extents include adjacent ones, short and
+ *              long holes between them and (for the read) one past the
+ *              end of the file, which must read back as zeros.
+ *
+ * Return:      Success:        0
+ *              Failure:        -1
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+test_vector_io_fapl(hid_t fapl)
+{
+    H5FD_t      *file = NULL;
+    char        filename[1024];
+    haddr_t     addrs[VECTOR_NEXTENTS] = {0, 100, 400, 100*KB, 100*KB + 200, 150*KB};
+    size_t      sizes[VECTOR_NEXTENTS] = {100, 50, 100, 200, 10, 64};
+    unsigned char wbuf[VECTOR_NEXTENTS][256];
+    unsigned char rbuf[VECTOR_NEXTENTS][256];
+    const void  *wbufs[VECTOR_NEXTENTS];
+    void        *rbufs[VECTOR_NEXTENTS];
+    size_t      u, v;
+
+    h5_fixname(FILENAME[10], fapl, filename, sizeof filename);
+
+    for(u = 0; u < VECTOR_NEXTENTS; u++) {
+        for(v = 0; v < sizes[u]; v++)
+            wbuf[u][v] = (unsigned char)(u * 31 + v);
+        wbufs[u] = wbuf[u];
+        rbufs[u] = rbuf[u];
+    } /* end for */
+
+    if(NULL == (file = H5FDopen(filename, H5F_ACC_RDWR | H5F_ACC_CREAT | H5F_ACC_TRUNC, fapl, HADDR_UNDEF)))
+        TEST_ERROR;
+    if(H5FDset_eoa(file, H5FD_MEM_DRAW, (haddr_t)VECTOR_EOA) < 0)
+        TEST_ERROR;
+
+    /* Write all but the last extent */
+    if(H5FDwritev(file, H5FD_MEM_DRAW, H5P_DEFAULT, (size_t)(VECTOR_NEXTENTS - 1), addrs, sizes, wbufs) < 0)
+        TEST_ERROR;
+
+    /* Check each extent with a plain read */
+    for(u = 0; u < (VECTOR_NEXTENTS - 1); u++) {
+        HDmemset(rbuf[u], 0xff, sizeof(rbuf[u]));
+        if(H5FDread(file, H5FD_MEM_DRAW, H5P_DEFAULT, addrs[u], sizes[u], rbuf[u]) < 0)
+            TEST_ERROR;
+        if(HDmemcmp(rbuf[u], wbuf[u], sizes[u]))
+            TEST_ERROR;
+    } /* end for */
+
+    /* Read everything back with one vector read */
+    HDmemset(rbuf, 0xff, sizeof(rbuf));
+    if(H5FDreadv(file, H5FD_MEM_DRAW, H5P_DEFAULT, (size_t)VECTOR_NEXTENTS, addrs, sizes, rbufs) < 0)
+        TEST_ERROR;
+    for(u = 0; u < (VECTOR_NEXTENTS - 1); u++) {
+        if(HDmemcmp(rbuf[u], wbuf[u], sizes[u]))
+            TEST_ERROR;
+        if(rbuf[u][sizes[u]] != 0xff)
+            TEST_ERROR;
+    } /* end for */
+    for(v = 0; v < sizes[VECTOR_NEXTENTS - 1]; v++)
+        if(rbuf[VECTOR_NEXTENTS - 1][v] != 0)
+            TEST_ERROR;
+
+    /* An empty list is fine, a NULL buffer is not */
+    if(H5FDreadv(file, H5FD_MEM_DRAW, H5P_DEFAULT, (size_t)0, NULL, NULL, NULL) < 0)
+        TEST_ERROR;
+    rbufs[0] = NULL;
+    H5E_BEGIN_TRY {
+        if(H5FDreadv(file, H5FD_MEM_DRAW, H5P_DEFAULT, (size_t)VECTOR_NEXTENTS, addrs, sizes, rbufs) >= 0)
+            TEST_ERROR;
+    } H5E_END_TRY;
+
+    if(H5FDclose(file) < 0)
+        TEST_ERROR;
+    file = NULL;
+
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        if(file)
+            H5FDclose(file);
+    } H5E_END_TRY;
+    return -1;
+}
+
+
+/*-------------------------------------------------------------------------
+ * Function:    test_vector_io
+ *
+ * Purpose:     Tests vector reads and writes with the SEC2 driver, which
+ *              implements them, and the core driver, which falls back to
+ *              one request per extent.
+ *
+ * Return:      Success:        0
+ *              Failure:        -1
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+test_vector_io(void)
+{
+    hid_t        fapl            = -1;
+
+    TESTING("vector I/O through the file driver interface");
+
+    h5_reset();
+
+    /* SEC2 driver */
+    fapl = h5_fileaccess();
+    if(H5Pset_fapl_sec2(fapl) < 0)
+        TEST_ERROR;
+    if(test_vector_io_fapl(fapl) < 0)
+        TEST_ERROR;
+    h5_cleanup(FILENAME, fapl);
+
+    /* Core driver, without a backing store */
+    fapl = h5_fileaccess();
+    if(H5Pset_fapl_core(fapl, (size_t)CORE_INCREMENT, FALSE) < 0)
+        TEST_ERROR;
+    if(test_vector_io_fapl(fapl) < 0)
+        TEST_ERROR;
+    if(H5Pclose(fapl) < 0)
+        TEST_ERROR;
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Pclose(fapl);
+    } H5E_END_TRY;
+    return -1;
+}
+
 
 /*-------------------------------------------------------------------------
  * Function:    main
@@ -1624,6 +1770,7 @@ main(void)
     nerrors += test_log() < 0            ? 1 : 0;
     nerrors += test_stdio() < 0          ? 1 : 0;
     nerrors += test_windows() < 0        ? 1 : 0;
+    nerrors += test_vector_io() < 0      ? 1 : 0;
 
     if(nerrors) {
         printf("***** %d Virtual File Driver TEST%s FAILED! *****\n",
@@ -2637,9 +2637,25 @@ compress_readAll(void)
                 nerrors++;
             }
 
-        /* Writing to the compressed, chunked dataset in parallel should fail */
+        /* Writing to the compressed, chunked dataset collectively should succeed */
+        for(u=0; u<dim;u++)
+            data_orig[u]=dim-u;
+        ret = H5Dwrite(dataset, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, xfer_plist, data_orig);
+        VRFY((ret >= 0), "H5Dwrite succeeded");
+
+        /* Verify data written */
+        ret = H5Dread(dataset, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, xfer_plist, data_read);
+        VRFY((ret >= 0), "H5Dread succeeded");
+        for(u=0; u<dim; u++)
+            if(data_orig[u]!=data_read[u]) {
+                printf("Line #%d: written!=retrieved: data_orig[%u]=%d, data_read[%u]=%d\n",__LINE__,
+                    (unsigned)u,data_orig[u],(unsigned)u,data_read[u]);
+                nerrors++;
+            }
+
+        /* Writing to the compressed, chunked dataset independently should fail */
         H5E_BEGIN_TRY {
-            ret = H5Dwrite(dataset, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, xfer_plist, data_read);
+            ret = H5Dwrite(dataset, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, data_read);
         } H5E_END_TRY;
         VRFY((ret < 0), "H5Dwrite failed");
 
@@ -2658,6 +2674,198 @@ compress_readAll(void)
 }
 #endif /* H5_HAVE_FILTER_DEFLATE */
 
+/*
+ * Example of using the parallel HDF5 library to write a compressed
+ * dataset in an HDF5 file with collective parallel access support.
+ * Each process writes a slab of rows that doesn't line up with the
+ * chunks, so most chunks are shared by several processes, and the
+ * last process (if there is more than one) selects nothing.  The
+ * dataset is written with both linked and multiple chunk IO.
+ */
+#ifdef H5_HAVE_FILTER_DEFLATE
+#define CMP_WRITE_ROWS  5       /* # of rows written by each process */
+#define CMP_WRITE_COLS  24      /* # of columns in dataset */
+void
+compress_writeAll(void)
+{
+    hid_t fid;                  /* HDF5 file ID */
+    hid_t acc_tpl;		/* File access templates */
+    hid_t dcpl;                 /* Dataset creation property list */
+    hid_t xfer_plist;		/* Dataset transfer properties list */
+    hid_t file_dataspace;	/* File dataspace ID */
+    hid_t mem_dataspace;	/* Memory dataspace ID */
+    hid_t dataset;		/* Dataset ID */
+    hsize_t dims[RANK];         /* Dataspace dimensions */
+    hsize_t chunk_dims[RANK];   /* Chunk dimensions */
+    hsize_t start[RANK];        /* for hyperslab setting */
+    hsize_t count[RANK];        /* for hyperslab setting */
+    H5D_mpio_actual_chunk_opt_mode_t actual_chunk_opt_mode;
+    const H5FD_mpio_chunk_opt_t chunk_opts[2] = {H5FD_MPIO_CHUNK_ONE_IO, H5FD_MPIO_CHUNK_MULTI_IO};
+    const char *dset_names[2] = {"compressed_link", "compressed_multi"};
+    int fill = -1;              /* Fill value */
+    int nwriters;               /* # of processes writing */
+    int *data_write = NULL;     /* data buffer */
+    int *data_read = NULL;      /* data buffer */
+    hsize_t i, j;               /* Local index variables */
+    int n;                      /* Local index variable */
+    const char *filename;
+    MPI_Comm comm = MPI_COMM_WORLD;
+    MPI_Info info = MPI_INFO_NULL;
+    int mpi_size, mpi_rank;
+    herr_t ret;         	/* Generic return value */
+
+    filename = GetTestParameters();
+    if(VERBOSE_MED)
+	printf("Collective compressed dataset write test on file %s\n", filename);
+
+    /* Retrieve MPI parameters */
+    MPI_Comm_size(comm,&mpi_size);
+    MPI_Comm_rank(comm,&mpi_rank);
+
+    /* The last process doesn't write anything, unless it is alone */
+    nwriters = (mpi_size > 1) ? mpi_size - 1 : 1;
+
+    /* Leave a few rows at the end that are never written */
+    dims[0] = (hsize_t)(mpi_size * CMP_WRITE_ROWS + 3);
+    dims[1] = CMP_WRITE_COLS;
+    chunk_dims[0] = 4;
+    chunk_dims[1] = 7;
+
+    /* Allocate data buffers */
+    data_write = (int *)HDmalloc((size_t)(dims[0] * dims[1]) * sizeof(int));
+    VRFY((data_write != NULL), "data_write HDmalloc succeeded");
+    data_read = (int *)HDmalloc((size_t)(dims[0] * dims[1]) * sizeof(int));
+    VRFY((data_read != NULL), "data_read HDmalloc succeeded");
+
+    /* Initialize data buffer */
+    for(i = 0; i < dims[0]; i++)
+        for(j = 0; j < dims[1]; j++)
+            data_write[i * dims[1] + j] = (int)(i * dims[1] + j);
+
+    /* setup file access template */
+    acc_tpl = create_faccess_plist(comm, info, facc_type);
+    VRFY((acc_tpl >= 0), "");
+
+    /* create the file collectively */
+    fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, acc_tpl);
+    VRFY((fid >= 0), "H5Fcreate succeeded");
+
+    /* Release file-access template */
+    ret = H5Pclose(acc_tpl);
+    VRFY((ret >= 0), "H5Pclose succeeded");
+
+    /* Create property list for chunking and compression */
+    dcpl = H5Pcreate(H5P_DATASET_CREATE);
+    VRFY((dcpl >= 0), "H5Pcreate succeeded");
+    ret = H5Pset_chunk(dcpl, RANK, chunk_dims);
+    VRFY((ret >= 0), "H5Pset_chunk succeeded");
+    ret = H5Pset_deflate(dcpl, 6);
+    VRFY((ret >= 0), "H5Pset_deflate succeeded");
+    ret = H5Pset_fill_value(dcpl, H5T_NATIVE_INT, &fill);
+    VRFY((ret >= 0), "H5Pset_fill_value succeeded");
+
+    /* Create dataspaces */
+    file_dataspace = H5Screate_simple(RANK, dims, NULL);
+    VRFY((file_dataspace >= 0), "H5Screate_simple succeeded");
+    mem_dataspace = H5Screate_simple(RANK, dims, NULL);
+    VRFY((mem_dataspace >= 0), "H5Screate_simple succeeded");
+
+    /* Select this process's rows, in the file & in memory */
+    if(mpi_rank < nwriters) {
+        start[0] = (hsize_t)(mpi_rank * CMP_WRITE_ROWS);
+        start[1] = 0;
+        count[0] = CMP_WRITE_ROWS;
+        count[1] = dims[1];
+        ret = H5Sselect_hyperslab(file_dataspace, H5S_SELECT_SET, start, NULL, count, NULL);
+        VRFY((ret >= 0), "H5Sselect_hyperslab succeeded");
+        ret = H5Sselect_hyperslab(mem_dataspace, H5S_SELECT_SET, start, NULL, count, NULL);
+        VRFY((ret >= 0), "H5Sselect_hyperslab succeeded");
+    } /* end if */
+    else {
+        ret = H5Sselect_none(file_dataspace);
+        VRFY((ret >= 0), "H5Sselect_none succeeded");
+        ret = H5Sselect_none(mem_dataspace);
+        VRFY((ret >= 0), "H5Sselect_none succeeded");
+    } /* end else */
+
+    for(n = 0; n < 2; n++) {
+        /* Create dataset */
+        dataset = H5Dcreate2(fid, dset_names[n], H5T_NATIVE_INT, file_dataspace, H5P_DEFAULT, dcpl, H5P_DEFAULT);
+        VRFY((dataset >= 0), "H5Dcreate2 succeeded");
+
+        /* Create dataset transfer property list */
+        xfer_plist = H5Pcreate(H5P_DATASET_XFER);
+        VRFY((xfer_plist >= 0), "H5Pcreate succeeded");
+        ret = H5Pset_dxpl_mpio(xfer_plist, H5FD_MPIO_COLLECTIVE);
+        VRFY((ret >= 0), "H5Pset_dxpl_mpio succeeded");
+        if(dxfer_coll_type == DXFER_INDEPENDENT_IO) {
+            ret = H5Pset_dxpl_mpio_collective_opt(xfer_plist, H5FD_MPIO_INDIVIDUAL_IO);
+            VRFY((ret >= 0), "set independent IO collectively succeeded");
+        }
+        ret = H5Pset_dxpl_mpio_chunk_opt(xfer_plist, chunk_opts[n]);
+        VRFY((ret >= 0), "H5Pset_dxpl_mpio_chunk_opt succeeded");
+
+        /* Write this process's rows */
+        ret = H5Dwrite(dataset, H5T_NATIVE_INT, mem_dataspace, file_dataspace, xfer_plist, data_write);
+        VRFY((ret >= 0), "H5Dwrite succeeded");
+
+        /* Check the chunk optimization used */
+        ret = H5Pget_mpio_actual_chunk_opt_mode(xfer_plist, &actual_chunk_opt_mode);
+        VRFY((ret >= 0), "H5Pget_mpio_actual_chunk_opt_mode succeeded");
+        VRFY((actual_chunk_opt_mode == (n == 0 ? H5D_MPIO_LINK_CHUNK : H5D_MPIO_MULTI_CHUNK)),
+            "actual chunk opt mode is correct");
+
+        /* Read back the whole dataset, with every process */
+        HDmemset(data_read, 0, (size_t)(dims[0] * dims[1]) * sizeof(int));
+        ret = H5Dread(dataset, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, xfer_plist, data_read);
+        VRFY((ret >= 0), "H5Dread succeeded");
+
+        /* Verify data read: rows that weren't written hold the fill value */
+        for(i = 0; i < dims[0]; i++)
+            for(j = 0; j < dims[1]; j++) {
+                int expected = (i < (hsize_t)(nwriters * CMP_WRITE_ROWS)) ? data_write[i * dims[1] + j] : fill;
+
+                if(data_read[i * dims[1] + j] != expected) {
+                    if(nerrors++ < MAX_ERR_REPORT)
+                        printf("Line #%d: dataset %s: [%lu][%lu] expected %d, read %d\n", __LINE__,
+                            dset_names[n], (unsigned long)i, (unsigned long)j, expected, data_read[i * dims[1] + j]);
+                }
+            }
+
+        /* Read back this process's rows only */
+        HDmemset(data_read, 0, (size_t)(dims[0] * dims[1]) * sizeof(int));
+        ret = H5Dread(dataset, H5T_NATIVE_INT, mem_dataspace, file_dataspace, xfer_plist, data_read);
+        VRFY((ret >= 0), "H5Dread succeeded");
+        if(mpi_rank < nwriters)
+            for(i = start[0]; i < start[0] + count[0]; i++)
+                for(j = 0; j < dims[1]; j++)
+                    if(data_read[i * dims[1] + j] != data_write[i * dims[1] + j]) {
+                        if(nerrors++ < MAX_ERR_REPORT)
+                            printf("Line #%d: dataset %s: [%lu][%lu] expected %d, read %d\n", __LINE__,
+                                dset_names[n], (unsigned long)i, (unsigned long)j, data_write[i * dims[1] + j], data_read[i * dims[1] + j]);
+                    }
+
+        ret = H5Pclose(xfer_plist);
+        VRFY((ret >= 0), "H5Pclose succeeded");
+        ret = H5Dclose(dataset);
+        VRFY((ret >= 0), "H5Dclose succeeded");
+    } /* end for */
+
+    ret = H5Sclose(file_dataspace);
+    VRFY((ret >= 0), "H5Sclose succeeded");
+    ret = H5Sclose(mem_dataspace);
+    VRFY((ret >= 0), "H5Sclose succeeded");
+    ret = H5Pclose(dcpl);
+    VRFY((ret >= 0), "H5Pclose succeeded");
+    ret = H5Fclose(fid);
+    VRFY((ret >= 0), "H5Fclose succeeded");
+
+    /* release data buffers */
+    if(data_write) HDfree(data_write);
+    if(data_read) HDfree(data_read);
+}
+#endif /* H5_HAVE_FILTER_DEFLATE */
+
 /*
  * Part 4--Non-selection for chunked dataset
  */
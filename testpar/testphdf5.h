@@ -292,6 +292,7 @@ void checker_board_hyperslab_dr_pio_test(ShapeSameTestMethods sstest_type);
 void file_image_daisy_chain_test(void);
 #ifdef H5_HAVE_FILTER_DEFLATE
 void compress_readAll(void);
+void compress_writeAll(void);
 #endif /* H5_HAVE_FILTER_DEFLATE */
 void test_dense_attr(void);
 
@@ -44,6 +44,8 @@ add_test (NAME PERFORM_iopipe COMMAND $<TARGET_FILE:iopipe>)
 
 add_test (NAME PERFORM_overhead COMMAND $<TARGET_FILE:overhead>)
 
+add_test (NAME PERFORM_id_perf COMMAND $<TARGET_FILE:id_perf> 10000 100000)
+
 add_test (NAME PERFORM_perf_meta COMMAND $<TARGET_FILE:perf_meta>)
 
 add_test (NAME PERFORM_zip_perf_help COMMAND $<TARGET_FILE:zip_perf> "-h")
@@ -0,0 +1,159 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * Copyright by the Board of Trustees of the University of Illinois.         *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of HDF5.  The full HDF5 copyright notice, including     *
+ * terms governing use, modification, and redistribution, is contained in    *
+ * the files COPYING and Copyright.html.  COPYING can be found at the root   *
+ * of the source code distribution tree; Copyright.html can be found at the  *
+ * root level of an installed copy of the electronic HDF5 document set and   *
+ * is linked from the top-level documents page.  It can also be found at     *
+ * http://hdfgroup.org/HDF5/doc/Copyright.html.  If you do not have          *
+ * access to either file, you may request a copy from help@hdfgroup.org.     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/*
+ * Purpose:  Measures the cost of registering, looking up and releasing IDs
+ *           while many IDs of the same type are open.
+ */
+
+#include "hdf5.h"
+#include "H5private.h"
+
+#define NIDS_DEFAULT            1000000
+#define NLOOKUPS_DEFAULT        10000000
+
+#define HEADING "%-24s"
+
+
+/*-------------------------------------------------------------------------
+ * Function:  elapsed
+ *
+ * Purpose:  Computes the time between two timestamps.
+ *
+ * Return:  Elapsed seconds
+ *
+ *-------------------------------------------------------------------------
+ */
+static double
+elapsed(const struct timeval *t_start, const struct timeval *t_stop)
+{
+    return ((double)t_stop->tv_sec + (double)t_stop->tv_usec / 1000000.0F) -
+            ((double)t_start->tv_sec + (double)t_start->tv_usec / 1000000.0F);
+}
+
+
+/*-------------------------------------------------------------------------
+ * Function:  print_stats
+ *
+ * Purpose:  Prints the time taken by a number of operations.
+ *
+ * Return:  void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+print_stats(const char *prefix, const struct timeval *t_start,
+    const struct timeval *t_stop, unsigned long nops)
+{
+    double e_time = elapsed(t_start, t_stop);
+
+    printf(HEADING "%lu ops %1.3felapsed %1.1fns/op\n", prefix, nops, e_time,
+            nops ? (e_time * 1000000000.0F) / (double)nops : 0.0F);
+}
+
+
+/*-------------------------------------------------------------------------
+ * Function:  main
+ *
+ * Purpose:  Registers NIDS IDs of an application type, looks up NLOOKUPS
+ *           of them at random, runs NLOOKUPS register/lookup/release
+ *           cycles that recycle IDs while the others stay open, and
+ *           releases them all.
+ *
+ * Usage:    id_perf [NIDS [NLOOKUPS]]
+ *
+ * Return:  Success:  0
+ *          Failure:  1
+ *
+ *-------------------------------------------------------------------------
+ */
+int
+main(int argc, char *argv[])
+{
+    unsigned long nids = NIDS_DEFAULT;
+    unsigned long nlookups = NLOOKUPS_DEFAULT;
+    H5I_type_t type;
+    hid_t *ids = NULL;
+    hid_t id;
+    struct timeval t_start, t_stop;
+    unsigned long u, nfound = 0;
+    static int obj;
+
+    if(argc > 1)
+        nids = HDstrtoul(argv[1], NULL, 0);
+    if(argc > 2)
+        nlookups = HDstrtoul(argv[2], NULL, 0);
+    if(argc > 3 || 0 == nids) {
+        fprintf(stderr, "usage: %s [NIDS [NLOOKUPS]]\n", argv[0]);
+        return 1;
+    }
+
+    if(NULL == (ids = (hid_t *)HDmalloc(nids * sizeof(hid_t))))
+        goto error;
+    if((type = H5Iregister_type((size_t)0, 0, NULL)) < 0)
+        goto error;
+    HDsrandom(1);
+
+    /* Register */
+    HDgettimeofday(&t_start, NULL);
+    for(u = 0; u < nids; u++)
+        if((ids[u] = H5Iregister(type, &obj)) < 0)
+            goto error;
+    HDgettimeofday(&t_stop, NULL);
+    print_stats("register", &t_start, &t_stop, nids);
+
+    /* Random lookups */
+    HDgettimeofday(&t_start, NULL);
+    for(u = 0; u < nlookups; u++)
+        if(H5Iobject_verify(ids[(unsigned long)HDrandom() % nids], type) == &obj)
+            nfound++;
+    HDgettimeofday(&t_stop, NULL);
+    print_stats("lookup", &t_start, &t_stop, nlookups);
+    if(nfound != nlookups)
+        goto error;
+
+    /* Register/lookup/release cycles, with the other IDs open */
+    HDgettimeofday(&t_start, NULL);
+    for(u = 0; u < nlookups; u++) {
+        if((id = H5Iregister(type, &obj)) < 0)
+            goto error;
+        if(H5Iobject_verify(id, type) != &obj)
+            goto error;
+        if(H5Idec_ref(id) != 0)
+            goto error;
+    }
+    HDgettimeofday(&t_stop, NULL);
+    print_stats("register/lookup/release", &t_start, &t_stop, nlookups);
+
+    /* Release */
+    HDgettimeofday(&t_start, NULL);
+    for(u = 0; u < nids; u++)
+        if(H5Idec_ref(ids[u]) != 0)
+            goto error;
+    HDgettimeofday(&t_stop, NULL);
+    print_stats("release", &t_start, &t_stop, nids);
+
+    if(H5Idestroy_type(type) < 0)
+        goto error;
+    HDfree(ids);
+
+    return 0;
+
+error:
+    fprintf(stderr, "%s: failed\n", argv[0]);
+    if(ids)
+        HDfree(ids);
+    return 1;
+}